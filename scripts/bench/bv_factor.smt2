@@ -0,0 +1,11 @@
+; factor a product of two 16 bit primes
+(set-logic QF_BV)
+(declare-const x (_ BitVec 32))
+(declare-const y (_ BitVec 32))
+(assert (bvult x #x00010000))
+(assert (bvult y #x00010000))
+(assert (bvugt x #x00000001))
+(assert (bvugt y #x00000001))
+(assert (bvule x y))
+(assert (= (bvmul x y) #xf454ae33))
+(check-sat)
@@ -0,0 +1,9 @@
+; two counters that are incremented in lock step
+(set-logic HORN)
+(declare-fun inv (Int Int Int) Bool)
+(assert (forall ((n Int)) (=> (>= n 0) (inv 0 0 n))))
+(assert (forall ((x Int) (y Int) (n Int))
+  (=> (and (inv x y n) (< x n)) (inv (+ x 1) (+ y 2) n))))
+(assert (forall ((x Int) (y Int) (n Int))
+  (=> (and (inv x y n) (>= x n) (not (= y (* 2 n)))) false)))
+(check-sat)
@@ -0,0 +1,12 @@
+; bounded knapsack with an exact weight
+(set-logic QF_LIA)
+(declare-const a Int)
+(declare-const b Int)
+(declare-const c Int)
+(declare-const d Int)
+(declare-const e Int)
+(assert (and (<= 0 a 40) (<= 0 b 40) (<= 0 c 40) (<= 0 d 40) (<= 0 e 40)))
+(assert (= (+ (* 31 a) (* 47 b) (* 59 c) (* 73 d) (* 97 e)) 4217))
+(assert (>= (+ (* 3 a) (* 5 b) (* 7 c) (* 9 d) (* 11 e)) 500))
+(assert (distinct a b c d e))
+(check-sat)
@@ -1048,6 +1048,11 @@ def def_API(name, result, params):
                 log_c.write(" }\n")
                 log_c.write("  Au(%s);\n" % sz_e)
                 exe_c.write("in.get_uint_array(%s)" % i)
+            elif ty == UINT64:
+                log_c.write("U(0);")
+                log_c.write(" }\n")
+                log_c.write("  Au(%s);\n" % sz_e)
+                exe_c.write("in.get_uint64_array(%s)" % i)
             else:
                 error ("unsupported parameter for %s, %s" % (name, p))
         elif kind == OUT_MANAGED_ARRAY:
@@ -1691,8 +1696,12 @@ def write_log_h_preamble(log_h):
   log_h.write('#include<atomic>\n')
   log_h.write('extern std::ostream * g_z3_log;\n')
   log_h.write('extern std::atomic<bool>      g_z3_log_enabled;\n')
+  log_h.write('extern bool g_z3_log_binary;\n')
+  log_h.write('void _Z3_log_binary_uint(uint64_t u);\n')
   log_h.write('class z3_log_ctx { bool m_prev; public: z3_log_ctx() { m_prev = g_z3_log && g_z3_log_enabled.exchange(false); } ~z3_log_ctx() { if (g_z3_log) g_z3_log_enabled = m_prev; } bool enabled() const { return m_prev; } };\n')
-  log_h.write('inline void SetR(void * obj) { *g_z3_log << "= " << obj << "\\n"; }\ninline void SetO(void * obj, unsigned pos) { *g_z3_log << "* " << obj << " " << pos << "\\n"; } \ninline void SetAO(void * obj, unsigned pos, unsigned idx) { *g_z3_log << "@ " << obj << " " << pos << " " << idx << "\\n"; }\n')
+  log_h.write('inline void SetR(void * obj) { if (g_z3_log_binary) { g_z3_log->put(\'=\'); _Z3_log_binary_uint(reinterpret_cast<size_t>(obj)); } else *g_z3_log << "= " << obj << "\\n"; }\n')
+  log_h.write('inline void SetO(void * obj, unsigned pos) { if (g_z3_log_binary) { g_z3_log->put(\'*\'); _Z3_log_binary_uint(reinterpret_cast<size_t>(obj)); _Z3_log_binary_uint(pos); } else *g_z3_log << "* " << obj << " " << pos << "\\n"; }\n')
+  log_h.write('inline void SetAO(void * obj, unsigned pos, unsigned idx) { if (g_z3_log_binary) { g_z3_log->put(\'@\'); _Z3_log_binary_uint(reinterpret_cast<size_t>(obj)); _Z3_log_binary_uint(pos); _Z3_log_binary_uint(idx); } else *g_z3_log << "@ " << obj << " " << pos << " " << idx << "\\n"; }\n')
   log_h.write('#define RETURN_Z3(Z3RES) if (_LOG_CTX.enabled()) { SetR(Z3RES); } return Z3RES\n')
   log_h.write('void _Z3_append_log(char const * msg);\n')
 
@@ -0,0 +1,212 @@
+#!/usr/bin/env python
+############################################
+# Copyright (c) 2020 Microsoft Corporation
+#
+# Performance regression suite.
+#
+# Runs the benchmarks listed in a suite file with the z3 executable,
+# records wall time, rlimit count and peak memory of every run and
+# compares them with a stored baseline.
+#
+# Each line of a suite file is a benchmark path, relative to the suite
+# file, followed by options that are passed to z3. Empty lines and
+# lines starting with '#' are ignored.
+#
+# Wall times are compared using Welch's t-test over the runs, the
+# deterministic rlimit count and the peak memory are compared against
+# a relative threshold.
+############################################
+import argparse
+import json
+import math
+import os
+import re
+import subprocess
+import sys
+import time
+
+def read_suite(suite):
+    base = os.path.dirname(os.path.abspath(suite))
+    benchmarks = []
+    with open(suite, 'r') as f:
+        for line in f:
+            line = line.strip()
+            if line == '' or line.startswith('#'):
+                continue
+            words = line.split()
+            benchmarks.append((words[0], os.path.join(base, words[0]), words[1:]))
+    return benchmarks
+
+STAT_RE = re.compile(r':([a-z\-]+)\s+([0-9.]+)')
+
+def run_once(z3, path, options, timeout, memory):
+    cmd = [z3, '-st', '-T:%s' % timeout, '-memory:%s' % memory] + options + [path]
+    start = time.time()
+    p = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    out, _ = p.communicate()
+    wall = time.time() - start
+    out = out.decode('utf-8', 'replace')
+    result = 'error'
+    for line in out.splitlines():
+        line = line.strip()
+        if line in ('sat', 's SATISFIABLE'):
+            result = 'sat'
+            break
+        if line in ('unsat', 's UNSATISFIABLE'):
+            result = 'unsat'
+            break
+        if line in ('unknown', 's UNKNOWN', 'timeout'):
+            result = 'unknown'
+            break
+    stats = {}
+    for k, v in STAT_RE.findall(out):
+        stats[k] = float(v)
+    return { 'result' : result,
+             'wall'   : wall,
+             'rlimit' : int(stats.get('rlimit-count', 0)),
+             'memory' : stats.get('max-memory', 0.0) }
+
+def run_suite(args):
+    results = {}
+    for name, path, options in read_suite(args.suite):
+        if args.filter and args.filter not in name:
+            continue
+        runs = [run_once(args.z3, path, options, args.timeout, args.memory) for i in range(args.runs)]
+        r = { 'result' : runs[0]['result'],
+              'wall'   : [x['wall'] for x in runs],
+              'rlimit' : max(x['rlimit'] for x in runs),
+              'memory' : max(x['memory'] for x in runs) }
+        if any(x['result'] != r['result'] for x in runs):
+            r['result'] = 'inconsistent'
+        results[name] = r
+        print('%-40s %-8s %8.3fs %12d rlimit %8.2fMB' % (name, r['result'], mean(r['wall']), r['rlimit'], r['memory']))
+        sys.stdout.flush()
+    return results
+
+def mean(xs):
+    return sum(xs) / len(xs)
+
+def variance(xs):
+    if len(xs) < 2:
+        return 0.0
+    m = mean(xs)
+    return sum((x - m) * (x - m) for x in xs) / (len(xs) - 1)
+
+def betacf(a, b, x):
+    # continued fraction of the incomplete beta function (modified Lentz)
+    tiny = 1e-30
+    qab, qap, qam = a + b, a + 1.0, a - 1.0
+    c, d = 1.0, 1.0 - qab * x / qap
+    if abs(d) < tiny:
+        d = tiny
+    d = 1.0 / d
+    h = d
+    for m in range(1, 200):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+        d = 1.0 + aa * d
+        d = tiny if abs(d) < tiny else d
+        c = 1.0 + aa / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        h *= d * c
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+        d = 1.0 + aa * d
+        d = tiny if abs(d) < tiny else d
+        c = 1.0 + aa / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-12:
+            break
+    return h
+
+def betai(a, b, x):
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    bt = math.exp(math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) + a * math.log(x) + b * math.log(1.0 - x))
+    if x < (a + 1.0) / (a + b + 2.0):
+        return bt * betacf(a, b, x) / a
+    return 1.0 - bt * betacf(b, a, 1.0 - x) / b
+
+def welch_p_value(xs, ys):
+    """one-sided p-value of the hypothesis mean(ys) > mean(xs)"""
+    vx, vy = variance(xs) / len(xs), variance(ys) / len(ys)
+    diff = mean(ys) - mean(xs)
+    if vx + vy == 0.0:
+        return 0.0 if diff > 0 else 1.0
+    t = diff / math.sqrt(vx + vy)
+    df = (vx + vy) ** 2
+    den = 0.0
+    if vx > 0:
+        den += vx * vx / (len(xs) - 1)
+    if vy > 0:
+        den += vy * vy / (len(ys) - 1)
+    df /= den
+    p = 0.5 * betai(0.5 * df, 0.5, df / (df + t * t))
+    return p if t > 0 else 1.0 - p
+
+def compare(baseline, results, args):
+    regressions = []
+    for name in sorted(results):
+        r = results[name]
+        if name not in baseline:
+            print('%-40s new benchmark' % name)
+            continue
+        b = baseline[name]
+        if r['result'] != b['result']:
+            regressions.append('%s: result %s, baseline %s' % (name, r['result'], b['result']))
+        bw, rw = mean(b['wall']), mean(r['wall'])
+        if rw > bw * (1.0 + args.threshold) and rw - bw > args.min_time:
+            p = welch_p_value(b['wall'], r['wall'])
+            if p < args.alpha:
+                regressions.append('%s: time %.3fs, baseline %.3fs (p = %.4f)' % (name, rw, bw, p))
+        if b['rlimit'] > 0 and r['rlimit'] > b['rlimit'] * (1.0 + args.threshold):
+            regressions.append('%s: rlimit %d, baseline %d' % (name, r['rlimit'], b['rlimit']))
+        if r['memory'] > b['memory'] * (1.0 + args.threshold) and r['memory'] - b['memory'] > args.min_memory:
+            regressions.append('%s: memory %.2fMB, baseline %.2fMB' % (name, r['memory'], b['memory']))
+    return regressions
+
+def main():
+    default_suite = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'bench', 'suite.txt')
+    parser = argparse.ArgumentParser(description='Z3 performance regression suite')
+    parser.add_argument('--z3', required=True, help='z3 executable')
+    parser.add_argument('--suite', default=default_suite, help='suite file (default: %(default)s)')
+    parser.add_argument('--filter', default=None, help='only run benchmarks whose name contains this string')
+    parser.add_argument('--runs', type=int, default=5, help='number of runs of each benchmark')
+    parser.add_argument('--timeout', type=int, default=60, help='timeout in seconds of each run')
+    parser.add_argument('--memory', type=int, default=4096, help='memory limit in megabytes of each run')
+    parser.add_argument('--baseline', default=None, help='results to compare with')
+    parser.add_argument('--save', default=None, help='file where the results are stored')
+    parser.add_argument('--alpha', type=float, default=0.01, help='significance level of time regressions')
+    parser.add_argument('--threshold', type=float, default=0.05, help='relative slowdown that is reported')
+    parser.add_argument('--min-time', type=float, default=0.02, help='absolute slowdown in seconds that is ignored')
+    parser.add_argument('--min-memory', type=float, default=1.0, help='absolute memory increase in megabytes that is ignored')
+    args = parser.parse_args()
+    if args.runs < 2:
+        parser.error('at least two runs are required')
+
+    results = run_suite(args)
+    if args.save:
+        with open(args.save, 'w') as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+    if not args.baseline:
+        return 0
+    if not os.path.exists(args.baseline):
+        print('baseline %s does not exist' % args.baseline)
+        return 1
+    with open(args.baseline, 'r') as f:
+        baseline = json.load(f)
+    regressions = compare(baseline, results, args)
+    for r in regressions:
+        print('REGRESSION %s' % r)
+    if regressions:
+        return 1
+    print('no regressions')
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
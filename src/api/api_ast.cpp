@@ -19,6 +19,7 @@ Revision History:
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
 #include "api/api_util.h"
+#include "api/api_ast_vector.h"
 #include "ast/well_sorted.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -31,6 +32,7 @@ Revision History:
 #include "ast/ast_smt_pp.h"
 #include "ast/ast_smt2_pp.h"
 #include "ast/rewriter/th_rewriter.h"
+#include "util/gparams.h"
 #include "ast/rewriter/var_subst.h"
 #include "ast/rewriter/expr_safe_replace.h"
 #include "ast/rewriter/recfun_replace.h"
@@ -179,6 +181,47 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_ast_vector Z3_API Z3_mk_apps(Z3_context c, unsigned num_leaves, Z3_ast const leaves[], 
+                                    unsigned num_nodes, Z3_func_decl const decls[], unsigned const num_args[], 
+                                    unsigned num_operands, unsigned const operands[]) {
+        Z3_TRY;
+        LOG_Z3_mk_apps(c, num_leaves, leaves, num_nodes, decls, num_args, num_operands, operands);
+        RESET_ERROR_CODE();
+        ast_manager& m = mk_c(c)->m();
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), m);
+        mk_c(c)->save_object(v);
+        ast_ref_vector& nodes = v->m_ast_vector;
+        ptr_buffer<expr> arg_list;
+        unsigned j = 0;
+        for (unsigned i = 0; i < num_nodes; ++i) {
+            arg_list.reset();
+            if (j + num_args[i] > num_operands) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "operands exhausted");
+                RETURN_Z3(nullptr);
+            }
+            for (unsigned k = 0; k < num_args[i]; ++k, ++j) {
+                unsigned idx = operands[j];
+                if (idx < num_leaves) 
+                    arg_list.push_back(to_expr(leaves[idx]));
+                else if (idx - num_leaves < i) 
+                    arg_list.push_back(to_expr(nodes.get(idx - num_leaves)));
+                else {
+                    SET_ERROR_CODE(Z3_INVALID_ARG, "operand refers to a node that is not yet created");
+                    RETURN_Z3(nullptr);
+                }
+            }
+            app* a = m.mk_app(to_func_decl(decls[i]), arg_list.size(), arg_list.c_ptr());
+            nodes.push_back(a);
+            check_sorts(c, a);
+        }
+        if (j != num_operands) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "not all operands are used");
+            RETURN_Z3(nullptr);
+        }
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_ast Z3_API Z3_mk_const(Z3_context c, Z3_symbol s, Z3_sort ty) {
         Z3_TRY;
         LOG_Z3_mk_const(c, s, ty);
@@ -743,8 +786,12 @@ extern "C" {
         params_ref p = to_param_ref(_p);
         unsigned timeout     = p.get_uint("timeout", mk_c(c)->get_timeout());
         bool     use_ctrl_c  = p.get_bool("ctrl_c", false);
-        th_rewriter m_rw(m, p);
-        m_rw.set_solver(alloc(api::seq_expr_solver, m, p));
+        scoped_ptr<th_rewriter> local_rw;
+        if (p.get_uint("result_cache_size", gparams::get_module("rewriter").get_uint("result_cache_size", 0)) == 0) {
+            local_rw = alloc(th_rewriter, m, p);
+            local_rw->set_solver(alloc(api::seq_expr_solver, m, p));
+        }
+        th_rewriter & m_rw = local_rw ? *local_rw : mk_c(c)->simplifier(p);
         expr_ref    result(m);
         cancel_eh<reslimit> eh(m.limit());
         api::context::set_interruptable si(*(mk_c(c)), eh);
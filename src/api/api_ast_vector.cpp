@@ -16,12 +16,14 @@ Revision History:
 
 --*/
 #include<iostream>
+#include<fstream>
 #include "api/z3.h"
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
 #include "api/api_ast_vector.h"
 #include "ast/ast_translation.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_binary.h"
 
 extern "C" {
 
@@ -136,4 +138,33 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    void Z3_API Z3_ast_vector_to_binary_file(Z3_context c, Z3_ast_vector v, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_ast_vector_to_binary_file(c, v, file_name);
+        RESET_ERROR_CODE();
+        std::ofstream out(file_name, std::ios::out | std::ios::binary);
+        if (!out) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        ast_to_binary(out, mk_c(c)->m(), to_ast_vector_ref(v));
+        Z3_CATCH;
+    }
+
+    Z3_ast_vector Z3_API Z3_ast_vector_from_binary_file(Z3_context c, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_ast_vector_from_binary_file(c, file_name);
+        RESET_ERROR_CODE();
+        std::ifstream in(file_name, std::ios::in | std::ios::binary);
+        if (!in) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            RETURN_Z3(nullptr);
+        }
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), mk_c(c)->m());
+        mk_c(c)->save_object(v);
+        binary_to_ast(in, mk_c(c)->m(), v->m_ast_vector);
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
 };
@@ -83,6 +83,7 @@ namespace api {
         m_recfun(m()),
         m_last_result(m()),
         m_ast_trail(m()),
+        m_handle_trail(m()),
         m_pmanager(m_limit) {
 
         m_error_code = Z3_OK;
@@ -104,8 +105,9 @@ namespace api {
         m_seq_fid   = m().mk_family_id("seq");
         m_special_relations_fid   = m().mk_family_id("special_relations");
         m_dt_plugin = static_cast<datatype_decl_plugin*>(m().get_plugin(m_dt_fid));
-    
-        install_tactics(*this);
+
+        // the tactics are installed when they are first used.
+        set_installer(install_tactics);
     }
 
 
@@ -118,6 +120,17 @@ namespace api {
         }
     }
 
+    th_rewriter & context::simplifier(params_ref const & p) {
+        std::ostringstream strm;
+        p.display(strm);
+        if (!m_simplifier || m_simplifier_params != strm.str()) {
+            m_simplifier = alloc(th_rewriter, m(), p);
+            m_simplifier->set_solver(alloc(api::seq_expr_solver, m(), p));
+            m_simplifier_params = strm.str();
+        }
+        return *m_simplifier;
+    }
+
     context::set_interruptable::set_interruptable(context & ctx, event_handler & i):
         m_ctx(ctx) {
         lock_guard lock(ctx.m_mux);
@@ -221,6 +234,8 @@ namespace api {
             ast_ref node(n, m());
             m_last_result.reset();
             m_last_result.push_back(std::move(node));
+            if (!m_handle_lim.empty())
+                m_handle_trail.push_back(n);
         }
         else {
             m_ast_trail.push_back(n);
@@ -228,12 +243,27 @@ namespace api {
     }
 
     void context::save_multiple_ast_trail(ast * n) {
-        if (m_user_ref_count)
+        if (m_user_ref_count) {
             m_last_result.push_back(n);
+            if (!m_handle_lim.empty())
+                m_handle_trail.push_back(n);
+        }
         else
             m_ast_trail.push_back(n);
     }
 
+    void context::push_handle_scope() {
+        m_handle_lim.push_back(m_handle_trail.size());
+    }
+
+    bool context::pop_handle_scope() {
+        if (m_handle_lim.empty())
+            return false;
+        m_handle_trail.shrink(m_handle_lim.back());
+        m_handle_lim.pop_back();
+        return true;
+    }
+
     void context::reset_last_result() {
         if (m_user_ref_count)
             m_last_result.reset();
@@ -388,6 +418,24 @@ extern "C" {
     }
 
 
+    void Z3_API Z3_push_handle_scope(Z3_context c) {
+        Z3_TRY;
+        LOG_Z3_push_handle_scope(c);
+        RESET_ERROR_CODE();
+        mk_c(c)->push_handle_scope();
+        Z3_CATCH;
+    }
+
+    void Z3_API Z3_pop_handle_scope(Z3_context c) {
+        Z3_TRY;
+        LOG_Z3_pop_handle_scope(c);
+        RESET_ERROR_CODE();
+        if (!mk_c(c)->pop_handle_scope()) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "there is no handle scope to pop");
+        }
+        Z3_CATCH;
+    }
+
     void Z3_API Z3_get_version(unsigned * major, 
                                unsigned * minor, 
                                unsigned * build_number, 
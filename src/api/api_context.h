@@ -34,6 +34,7 @@ Revision History:
 #include "ast/recfun_decl_plugin.h"
 #include "ast/special_relations_decl_plugin.h"
 #include "ast/rewriter/seq_rewriter.h"
+#include "ast/rewriter/th_rewriter.h"
 #include "smt/params/smt_params.h"
 #include "smt/smt_kernel.h"
 #include "smt/smt_solver.h"
@@ -94,8 +95,14 @@ namespace api {
         smt_params                 m_fparams;
         // -------------------------------
 
+        // simplifier retained between calls to Z3_simplify when result caching is enabled.
+        scoped_ptr<th_rewriter>    m_simplifier;
+        std::string                m_simplifier_params;
+
         ast_ref_vector             m_last_result; //!< used when m_user_ref_count == true
         ast_ref_vector             m_ast_trail;   //!< used when m_user_ref_count == false
+        ast_ref_vector             m_handle_trail; //!< ASTs kept alive by the open handle scopes
+        unsigned_vector            m_handle_lim;
 
         ref<api::object>           m_last_obj; //!< reference to the last API object returned by the APIs
         u_map<api::object*>        m_allocated_objects; // !< table containing current set of allocated API objects
@@ -143,6 +150,7 @@ namespace api {
         ast_manager & m() const { return *(m_manager.get()); }
 
         context_params & params() { m_params.updt_params(); return m_params; }
+        th_rewriter & simplifier(params_ref const & p);
         scoped_ptr<cmd_context>& cmd() { return m_cmd; }
         bool produce_proofs() const { return m().proofs_enabled(); }
         bool produce_models() const { return m_params.m_model; }
@@ -205,6 +213,10 @@ namespace api {
         // Similar to previous method, but it "adds" n to the result.
         void save_multiple_ast_trail(ast * n);
         
+        // Keep the ASTs exposed until the matching pop_handle_scope alive.
+        void push_handle_scope();
+        bool pop_handle_scope();
+
         // Reset the cache that stores the ASTs exposed in the previous call.
         // This is a NOOP if ref-count is disabled.
         void reset_last_result();
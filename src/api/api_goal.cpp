@@ -16,11 +16,13 @@ Revision History:
 
 --*/
 #include<iostream>
+#include<fstream>
 #include "api/z3.h"
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
 #include "api/api_goal.h"
 #include "ast/ast_translation.h"
+#include "ast/ast_binary.h"
 #include "api/api_model.h"
 
 extern "C" {
@@ -211,4 +213,44 @@ extern "C" {
         Z3_CATCH_RETURN("");
     }
 
+    void Z3_API Z3_goal_to_binary_file(Z3_context c, Z3_goal g, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_goal_to_binary_file(c, g, file_name);
+        RESET_ERROR_CODE();
+        std::ofstream out(file_name, std::ios::out | std::ios::binary);
+        if (!out) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        ast_manager& m = mk_c(c)->m();
+        ast_ref_vector fmls(m);
+        for (unsigned i = 0; i < to_goal_ref(g)->size(); ++i)
+            fmls.push_back(to_goal_ref(g)->form(i));
+        ast_to_binary(out, m, fmls);
+        Z3_CATCH;
+    }
+
+    void Z3_API Z3_goal_from_binary_file(Z3_context c, Z3_goal g, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_goal_from_binary_file(c, g, file_name);
+        RESET_ERROR_CODE();
+        std::ifstream in(file_name, std::ios::in | std::ios::binary);
+        if (!in) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        ast_manager& m = mk_c(c)->m();
+        ast_ref_vector fmls(m);
+        binary_to_ast(in, m, fmls);
+        for (ast* f : fmls) {
+            if (!is_expr(f) || !m.is_bool(to_expr(f))) {
+                SET_ERROR_CODE(Z3_SORT_ERROR, "Boolean expression expected");
+                return;
+            }
+        }
+        for (ast* f : fmls) 
+            to_goal_ref(g)->assert_expr(to_expr(f));
+        Z3_CATCH;
+    }
+
 };
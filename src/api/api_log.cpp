@@ -16,14 +16,135 @@ Revision History:
 
 --*/
 #include<fstream>
+#include<sstream>
 #include "api/z3.h"
 #include "api/api_log_macros.h"
 #include "util/util.h"
 #include "util/z3_version.h"
 #include "util/mutex.h"
+#ifndef SINGLE_THREAD
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#endif
 
 std::ostream * g_z3_log = nullptr;
 std::atomic<bool> g_z3_log_enabled;
+bool g_z3_log_binary = false;
+
+void _Z3_log_binary_uint(uint64_t u) {
+    char buffer[10];
+    unsigned n = 0;
+    while (u >= 0x80) {
+        buffer[n++] = static_cast<char>((u & 0x7F) | 0x80);
+        u >>= 7;
+    }
+    buffer[n++] = static_cast<char>(u);
+    g_z3_log->write(buffer, n);
+}
+
+#ifndef SINGLE_THREAD
+namespace {
+
+    /**
+       \brief stream buffer that hands full buffers to a background thread
+       writing them to the log file. Flushes are ignored, records reach the
+       file when a buffer is full or when the log is closed.
+    */
+    class async_log_buf : public std::streambuf {
+        static const size_t BUFFER_SIZE = 1 << 16;
+        std::ofstream                  m_out;
+        std::mutex                     m_mux;
+        std::condition_variable        m_cv;
+        std::vector<std::vector<char>> m_full;
+        std::vector<char>              m_buffer;
+        bool                           m_done;
+        std::thread                    m_writer;
+
+        void reset_buffer() {
+            m_buffer.resize(BUFFER_SIZE);
+            setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+        }
+
+        void hand_off() {
+            m_buffer.resize(pptr() - pbase());
+            if (!m_buffer.empty()) {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_full.push_back(std::move(m_buffer));
+                m_cv.notify_one();
+            }
+            m_buffer = std::vector<char>();
+            reset_buffer();
+        }
+
+        void write_loop() {
+            std::vector<std::vector<char>> todo;
+            while (true) {
+                bool done;
+                {
+                    std::unique_lock<std::mutex> lock(m_mux);
+                    m_cv.wait(lock, [&]() { return m_done || !m_full.empty(); });
+                    todo.swap(m_full);
+                    done = m_done;
+                }
+                for (auto const& b : todo) 
+                    m_out.write(b.data(), b.size());
+                todo.clear();
+                if (done) 
+                    break;
+            }
+            m_out.flush();
+        }
+
+    protected:
+        int_type overflow(int_type c) override {
+            hand_off();
+            if (c != traits_type::eof()) {
+                *pptr() = traits_type::to_char_type(c);
+                pbump(1);
+            }
+            return traits_type::not_eof(c);
+        }
+
+        int sync() override {
+            return 0;
+        }
+
+    public:
+        async_log_buf(char const * filename): 
+            m_out(filename, std::ios::binary), 
+            m_done(false) {
+            reset_buffer();
+            if (is_open()) 
+                m_writer = std::thread([this]() { write_loop(); });
+        }
+
+        ~async_log_buf() override {
+            if (!m_writer.joinable()) 
+                return;
+            hand_off();
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_done = true;
+                m_cv.notify_one();
+            }
+            m_writer.join();
+        }
+
+        bool is_open() const { return m_out.is_open() && !m_out.fail(); }
+    };
+
+    class async_log_stream : public std::ostream {
+        async_log_buf m_buf;
+    public:
+        async_log_stream(char const * filename): std::ostream(nullptr), m_buf(filename) {
+            rdbuf(&m_buf);
+            if (!m_buf.is_open()) 
+                setstate(std::ios::failbit);
+        }
+    };
+}
+#endif
 
 #ifdef Z3_LOG_SYNC
 static mutex g_log_mux;
@@ -36,6 +157,7 @@ extern "C" {
     void Z3_close_log_unsafe(void) {
         if (g_z3_log != nullptr) {
             g_z3_log_enabled = false;
+            g_z3_log_binary = false;
             dealloc(g_z3_log);
             g_z3_log = nullptr;
         }
@@ -62,6 +184,39 @@ extern "C" {
         return res;
     }
 
+    bool Z3_API Z3_open_binary_log(Z3_string filename, bool async) {
+        bool res = true;
+
+        SCOPED_LOCK();
+        if (g_z3_log != nullptr)
+            Z3_close_log_unsafe();
+#ifndef SINGLE_THREAD
+        if (async)
+            g_z3_log = alloc(async_log_stream, filename);
+        else
+#endif
+            g_z3_log = alloc(std::ofstream, filename, std::ios::binary);
+        if (g_z3_log->bad() || g_z3_log->fail()) {
+            dealloc(g_z3_log);
+            g_z3_log = nullptr;
+            res = false;
+        }
+        else {
+            g_z3_log_binary = true;
+            g_z3_log->put('B');
+            g_z3_log->put('V');
+            std::ostringstream strm;
+            strm << Z3_MAJOR_VERSION << "." << Z3_MINOR_VERSION << "." << Z3_BUILD_NUMBER << "." << Z3_REVISION_NUMBER << " " << __DATE__;
+            std::string version = strm.str();
+            _Z3_log_binary_uint(version.size());
+            g_z3_log->write(version.c_str(), version.size());
+            g_z3_log->flush();
+            g_z3_log_enabled = true;
+        }
+
+        return res;
+    }
+
     void Z3_API Z3_append_log(Z3_string str) {
         if (g_z3_log == nullptr)
             return;
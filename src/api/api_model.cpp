@@ -20,7 +20,9 @@ Revision History:
 #include "api/api_context.h"
 #include "api/api_model.h"
 #include "api/api_ast_vector.h"
+#include "ast/arith_decl_plugin.h"
 #include "ast/array_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
 #include "model/model.h"
 #include "model/model_v2_pp.h"
 #include "model/model_smt2_pp.h"
@@ -174,6 +176,44 @@ extern "C" {
         Z3_CATCH_RETURN(false);
     }
 
+    bool Z3_API Z3_model_eval_uint64(Z3_context c, Z3_model m, unsigned num, Z3_ast const ts[], bool model_completion, uint64_t values[]) {
+        Z3_TRY;
+        LOG_Z3_model_eval_uint64(c, m, num, ts, model_completion, values);
+        RESET_ERROR_CODE();
+        CHECK_NON_NULL(m, false);
+        for (unsigned i = 0; i < num; ++i) {
+            CHECK_IS_EXPR(ts[i], false);
+        }
+        model * _m = to_model_ref(m);
+        params_ref p;
+        ast_manager& mgr = mk_c(c)->m();
+        if (!_m->has_solver()) {
+            _m->set_solver(alloc(api::seq_expr_solver, mgr, p));
+        }
+        arith_util a(mgr);
+        bv_util bv(mgr);
+        model::scoped_model_completion _scm(*_m, model_completion);
+        expr_ref val(mgr);
+        rational r;
+        unsigned sz;
+        bool ok = true;
+        for (unsigned i = 0; i < num; ++i) {
+            val = (*_m)(to_expr(ts[i]));
+            if (mgr.is_true(val))
+                values[i] = 1;
+            else if (mgr.is_false(val))
+                values[i] = 0;
+            else if ((bv.is_numeral(val, r, sz) || a.is_numeral(val, r)) && r.is_uint64())
+                values[i] = r.get_uint64();
+            else {
+                values[i] = 0;
+                ok = false;
+            }
+        }
+        return ok;
+        Z3_CATCH_RETURN(false);
+    }
+
     unsigned Z3_API Z3_model_get_num_sorts(Z3_context c, Z3_model m) {
         Z3_TRY;
         LOG_Z3_model_get_num_sorts(c, m);
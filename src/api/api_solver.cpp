@@ -21,8 +21,10 @@ Revision History:
 #include "util/cancel_eh.h"
 #include "util/file_path.h"
 #include "util/scoped_timer.h"
-#include "util/file_path.h"
+#include "util/thread_pool.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_util.h"
+#include "ast/ast_binary.h"
 #include "api/z3.h"
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
@@ -118,10 +120,22 @@ extern "C" {
     }
 
     void Z3_solver_ref::set_cancel() {
+        {
+            lock_guard lock(m_async.m_mux);
+            if (m_async.m_running) m_async.m_cancel = true;
+        }
         lock_guard lock(m_mux);
         if (m_eh) (*m_eh)(API_INTERRUPT_EH_CALLER);
     }
 
+    Z3_lbool Z3_solver_ref::wait_async() {
+#ifndef SINGLE_THREAD
+        std::unique_lock<std::mutex> lock(m_async.m_mux);
+        m_async.m_cv.wait(lock, [&]() { return !m_async.m_running; });
+#endif
+        return m_async.m_result;
+    }
+
     void Z3_solver_ref::assert_expr(expr * e) {
         if (m_pp) m_pp->assert_expr(e);
         m_solver->assert_expr(e);
@@ -554,7 +568,7 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
-    static Z3_lbool _solver_check(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[]) {
+    static Z3_lbool _solver_check(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[], bool allow_ctrl_c = true) {
         for (unsigned i = 0; i < num_assumptions; i++) {
             if (!is_expr(to_ast(assumptions[i]))) {
                 SET_ERROR_CODE(Z3_INVALID_ARG, "assumption is not an expression");
@@ -567,7 +581,7 @@ extern "C" {
         timeout              = to_solver(s)->m_params.get_uint("timeout", timeout);
         timeout              = sp.timeout() != UINT_MAX ? sp.timeout() : timeout;
         unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
-        bool     use_ctrl_c  = to_solver(s)->m_params.get_bool("ctrl_c", true);
+        bool     use_ctrl_c  = allow_ctrl_c && to_solver(s)->m_params.get_bool("ctrl_c", true);
         cancel_eh<reslimit> eh(mk_c(c)->m().limit());
         to_solver(s)->set_eh(&eh);
         api::context::set_interruptable si(*(mk_c(c)), eh);
@@ -619,6 +633,88 @@ extern "C" {
         Z3_CATCH_RETURN(Z3_L_UNDEF);
     }
     
+    void Z3_API Z3_solver_check_async(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[]) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async(c, s, num_assumptions, assumptions);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        solver_async_check& st = to_solver(s)->m_async;
+        {
+            lock_guard lock(st.m_mux);
+            if (st.m_running) {
+                SET_ERROR_CODE(Z3_INVALID_USAGE, "an asynchronous check is already running");
+                return;
+            }
+            st.m_running = true;
+            st.m_cancel = false;
+            st.m_result = Z3_L_UNDEF;
+        }
+        // the worker owns a copy of the assumptions; they are released before the check is reported complete.
+        ast_ref_vector* asms = alloc(ast_ref_vector, mk_c(c)->m());
+        for (unsigned i = 0; i < num_assumptions; ++i) 
+            asms->push_back(to_ast(assumptions[i]));
+        thread_pool::submit([c, s, asms]() {
+            solver_async_check& st = to_solver(s)->m_async;
+            Z3_lbool r = Z3_L_UNDEF;
+            bool cancel;
+            {
+                lock_guard lock(st.m_mux);
+                cancel = st.m_cancel;
+            }
+            if (!cancel) {
+                try {
+                    r = _solver_check(c, s, asms->size(), reinterpret_cast<Z3_ast const*>(asms->c_ptr()), false);
+                }
+                catch (...) {
+                    r = Z3_L_UNDEF;
+                }
+            }
+            dealloc(asms);
+            Z3_solver_check_handler* h;
+            void* h_ctx;
+            {
+                lock_guard lock(st.m_mux);
+                st.m_result = r;
+                st.m_running = false;
+                h = st.m_handler;
+                h_ctx = st.m_handler_ctx;
+#ifndef SINGLE_THREAD
+                st.m_cv.notify_all();
+#endif
+            }
+            if (h) h(h_ctx, s, r);
+        });
+        Z3_CATCH;
+    }
+
+    bool Z3_API Z3_solver_check_async_done(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async_done(c, s);
+        RESET_ERROR_CODE();
+        solver_async_check& st = to_solver(s)->m_async;
+        lock_guard lock(st.m_mux);
+        return !st.m_running;
+        Z3_CATCH_RETURN(false);
+    }
+
+    Z3_lbool Z3_API Z3_solver_check_async_wait(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async_wait(c, s);
+        RESET_ERROR_CODE();
+        return to_solver(s)->wait_async();
+        Z3_CATCH_RETURN(Z3_L_UNDEF);
+    }
+
+    void Z3_API Z3_solver_set_check_async_handler(Z3_context c, Z3_solver s, void* ctx, Z3_solver_check_handler* h) {
+        Z3_TRY;
+        RESET_ERROR_CODE();
+        solver_async_check& st = to_solver(s)->m_async;
+        lock_guard lock(st.m_mux);
+        st.m_handler = h;
+        st.m_handler_ctx = ctx;
+        Z3_CATCH;
+    }
+
     Z3_model Z3_API Z3_solver_get_model(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_model(c, s);
@@ -718,6 +814,49 @@ extern "C" {
         Z3_CATCH_RETURN("");
     }
 
+    void Z3_API Z3_solver_to_binary_file(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_to_binary_file(c, s, file_name);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        std::ofstream out(file_name, std::ios::out | std::ios::binary);
+        if (!out) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        ast_manager& m = mk_c(c)->m();
+        ast_ref_vector fmls(m);
+        unsigned sz = to_solver_ref(s)->get_num_assertions();
+        for (unsigned i = 0; i < sz; i++) 
+            fmls.push_back(to_solver_ref(s)->get_assertion(i));
+        ast_to_binary(out, m, fmls);
+        Z3_CATCH;
+    }
+
+    void Z3_API Z3_solver_from_binary_file(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_from_binary_file(c, s, file_name);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        std::ifstream in(file_name, std::ios::in | std::ios::binary);
+        if (!in) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        ast_manager& m = mk_c(c)->m();
+        ast_ref_vector fmls(m);
+        binary_to_ast(in, m, fmls);
+        for (ast* f : fmls) {
+            if (!is_expr(f) || !m.is_bool(to_expr(f))) {
+                SET_ERROR_CODE(Z3_SORT_ERROR, "Boolean expression expected");
+                return;
+            }
+        }
+        for (ast* f : fmls) 
+            to_solver_ref(s)->assert_expr(to_expr(f));
+        Z3_CATCH;
+    }
+
 
     Z3_lbool Z3_API Z3_get_implied_equalities(Z3_context c, 
                                               Z3_solver s,
@@ -801,6 +940,167 @@ extern "C" {
         Z3_CATCH_RETURN(Z3_L_UNDEF);        
     }
 
+    Z3_lbool Z3_API Z3_solver_enumerate(Z3_context c, 
+                                        Z3_solver s,
+                                        Z3_ast_vector vars,
+                                        unsigned max_models,
+                                        Z3_ast_vector models) {
+        Z3_TRY;
+        LOG_Z3_solver_enumerate(c, s, vars, max_models, models);
+        ast_manager& m = mk_c(c)->m();
+        RESET_ERROR_CODE();
+        CHECK_SEARCHING(c);
+        init_solver(c, s);
+        expr_ref_vector _vars(m);
+        for (ast* a : to_ast_vector_ref(vars)) {
+            if (!is_expr(a) || !m.is_bool(to_expr(a))) {
+                SET_ERROR_CODE(Z3_INVALID_USAGE, "variable is not a Boolean expression");
+                return Z3_L_UNDEF;
+            }
+            _vars.push_back(to_expr(a));
+        }
+        vector<expr_ref_vector> _models;
+        lbool result = l_undef;
+        unsigned timeout     = to_solver(s)->m_params.get_uint("timeout", mk_c(c)->get_timeout());
+        unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
+        bool     use_ctrl_c  = to_solver(s)->m_params.get_bool("ctrl_c", true);
+        cancel_eh<reslimit> eh(mk_c(c)->m().limit());
+        to_solver(s)->set_eh(&eh);
+        api::context::set_interruptable si(*(mk_c(c)), eh);
+        {
+            scoped_ctrl_c ctrlc(eh, false, use_ctrl_c);
+            scoped_timer timer(timeout, &eh);
+            scoped_rlimit _rlimit(mk_c(c)->m().limit(), rlimit);
+            try {
+                result = to_solver_ref(s)->enumerate(_vars, max_models, _models);
+            }
+            catch (z3_exception & ex) {
+                to_solver(s)->set_eh(nullptr);
+                mk_c(c)->handle_exception(ex);
+                return Z3_L_UNDEF;
+            }
+            catch (...) {
+            }
+        }
+        to_solver(s)->set_eh(nullptr);
+        if (result == l_undef) {
+            to_solver_ref(s)->set_reason_unknown(eh);
+        }
+        for (expr_ref_vector const& cube : _models) {
+            to_ast_vector_ref(models).push_back(mk_and(cube));
+        }
+        return static_cast<Z3_lbool>(result); 
+        Z3_CATCH_RETURN(Z3_L_UNDEF);        
+    }
+
+    Z3_lbool Z3_API Z3_solver_approx_count(Z3_context c, 
+                                           Z3_solver s,
+                                           Z3_ast_vector vars,
+                                           unsigned threshold,
+                                           unsigned iterations,
+                                           Z3_ast * count) {
+        Z3_TRY;
+        LOG_Z3_solver_approx_count(c, s, vars, threshold, iterations, count);
+        if (count) *count = nullptr;
+        ast_manager& m = mk_c(c)->m();
+        RESET_ERROR_CODE();
+        CHECK_SEARCHING(c);
+        init_solver(c, s);
+        expr_ref_vector _vars(m);
+        for (ast* a : to_ast_vector_ref(vars)) {
+            if (!is_expr(a) || !m.is_bool(to_expr(a))) {
+                SET_ERROR_CODE(Z3_INVALID_USAGE, "variable is not a Boolean expression");
+                RETURN_Z3_solver_approx_count Z3_L_UNDEF;
+            }
+            _vars.push_back(to_expr(a));
+        }
+        rational _count;
+        lbool result = l_undef;
+        unsigned timeout     = to_solver(s)->m_params.get_uint("timeout", mk_c(c)->get_timeout());
+        unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
+        bool     use_ctrl_c  = to_solver(s)->m_params.get_bool("ctrl_c", true);
+        cancel_eh<reslimit> eh(mk_c(c)->m().limit());
+        to_solver(s)->set_eh(&eh);
+        api::context::set_interruptable si(*(mk_c(c)), eh);
+        {
+            scoped_ctrl_c ctrlc(eh, false, use_ctrl_c);
+            scoped_timer timer(timeout, &eh);
+            scoped_rlimit _rlimit(mk_c(c)->m().limit(), rlimit);
+            try {
+                result = to_solver_ref(s)->approx_count(_vars, threshold, iterations, _count);
+            }
+            catch (z3_exception & ex) {
+                to_solver(s)->set_eh(nullptr);
+                mk_c(c)->handle_exception(ex);
+                RETURN_Z3_solver_approx_count Z3_L_UNDEF;
+            }
+            catch (...) {
+            }
+        }
+        to_solver(s)->set_eh(nullptr);
+        if (result == l_undef) {
+            to_solver_ref(s)->set_reason_unknown(eh);
+        }
+        else {
+            expr* n = mk_c(c)->autil().mk_int(_count);
+            mk_c(c)->save_ast_trail(n);
+            *count = of_ast(n);
+        }
+        RETURN_Z3_solver_approx_count static_cast<Z3_lbool>(result);
+        Z3_CATCH_RETURN(Z3_L_UNDEF);
+    }
+
+    Z3_lbool Z3_API Z3_solver_get_backbone(Z3_context c, 
+                                           Z3_solver s,
+                                           Z3_ast_vector vars,
+                                           Z3_ast_vector backbone) {
+        Z3_TRY;
+        LOG_Z3_solver_get_backbone(c, s, vars, backbone);
+        ast_manager& m = mk_c(c)->m();
+        RESET_ERROR_CODE();
+        CHECK_SEARCHING(c);
+        init_solver(c, s);
+        expr_ref_vector _vars(m), _backbone(m);
+        for (ast* a : to_ast_vector_ref(vars)) {
+            if (!is_expr(a) || !m.is_bool(to_expr(a))) {
+                SET_ERROR_CODE(Z3_INVALID_USAGE, "variable is not a Boolean expression");
+                return Z3_L_UNDEF;
+            }
+            _vars.push_back(to_expr(a));
+        }
+        lbool result = l_undef;
+        unsigned timeout     = to_solver(s)->m_params.get_uint("timeout", mk_c(c)->get_timeout());
+        unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
+        bool     use_ctrl_c  = to_solver(s)->m_params.get_bool("ctrl_c", true);
+        cancel_eh<reslimit> eh(mk_c(c)->m().limit());
+        to_solver(s)->set_eh(&eh);
+        api::context::set_interruptable si(*(mk_c(c)), eh);
+        {
+            scoped_ctrl_c ctrlc(eh, false, use_ctrl_c);
+            scoped_timer timer(timeout, &eh);
+            scoped_rlimit _rlimit(mk_c(c)->m().limit(), rlimit);
+            try {
+                result = to_solver_ref(s)->get_backbone(_vars, 32, _backbone);
+            }
+            catch (z3_exception & ex) {
+                to_solver(s)->set_eh(nullptr);
+                mk_c(c)->handle_exception(ex);
+                return Z3_L_UNDEF;
+            }
+            catch (...) {
+            }
+        }
+        to_solver(s)->set_eh(nullptr);
+        if (result == l_undef) {
+            to_solver_ref(s)->set_reason_unknown(eh);
+        }
+        for (expr* e : _backbone) {
+            to_ast_vector_ref(backbone).push_back(e);
+        }
+        return static_cast<Z3_lbool>(result); 
+        Z3_CATCH_RETURN(Z3_L_UNDEF);        
+    }
+
     Z3_ast_vector Z3_API Z3_solver_cube(Z3_context c, Z3_solver s, Z3_ast_vector vs, unsigned cutoff) {
         Z3_TRY;
         LOG_Z3_solver_cube(c, s, vs, cutoff);
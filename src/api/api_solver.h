@@ -18,7 +18,11 @@ Revision History:
 #ifndef API_SOLVER_H_
 #define API_SOLVER_H_
 
+#include "api/z3.h"
 #include "util/mutex.h"
+#ifndef SINGLE_THREAD
+#include <condition_variable>
+#endif
 #include "api/api_util.h"
 #include "solver/solver.h"
 
@@ -39,6 +43,22 @@ struct solver2smt2_pp {
 
 };
 
+/**
+   \brief state of an asynchronous check of a solver.
+*/
+struct solver_async_check {
+    mutex                    m_mux;
+#ifndef SINGLE_THREAD
+    std::condition_variable  m_cv;
+#endif
+    bool                     m_running;
+    bool                     m_cancel;
+    Z3_lbool                 m_result;
+    Z3_solver_check_handler* m_handler;
+    void*                    m_handler_ctx;
+    solver_async_check(): m_running(false), m_cancel(false), m_result(Z3_L_UNDEF), m_handler(nullptr), m_handler_ctx(nullptr) {}
+};
+
 struct Z3_solver_ref : public api::object {
     scoped_ptr<solver_factory> m_solver_factory;
     ref<solver>                m_solver;
@@ -47,15 +67,17 @@ struct Z3_solver_ref : public api::object {
     scoped_ptr<solver2smt2_pp> m_pp;
     mutex                      m_mux;
     event_handler*             m_eh;
+    solver_async_check         m_async;
 
     Z3_solver_ref(api::context& c, solver_factory * f): 
         api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr) {}
-    ~Z3_solver_ref() override {}
+    ~Z3_solver_ref() override { wait_async(); }
 
     void assert_expr(expr* e);
     void assert_expr(expr* e, expr* t);
     void set_eh(event_handler* eh);
     void set_cancel();
+    Z3_lbool wait_async();
 
 };
 
@@ -102,6 +102,10 @@ def open_log(fname):
     """Log interaction to a file. This function must be invoked immediately after init(). """
     Z3_open_log(fname)
 
+def open_binary_log(fname, asynchronous=False):
+    """Log interaction to a file using the compact binary format. If `asynchronous` is set, the file is written by a background thread."""
+    Z3_open_binary_log(fname, asynchronous)
+
 def append_log(s):
     """Append user-defined string to interaction log. """
     Z3_append_log(s)
@@ -840,6 +844,42 @@ def FreshFunction(*sig):
 def _to_func_decl_ref(a, ctx):
     return FuncDeclRef(a, ctx)
 
+def Map(f, *args):
+    """Return the list of applications of `f` to the elements of the given lists.
+    All applications are created with a single call to Z3.
+
+    >>> f = Function('f', IntSort(), IntSort(), IntSort())
+    >>> X = IntVector('x', 3)
+    >>> Y = IntVector('y', 3)
+    >>> Map(f, X, Y)
+    [f(x__0, y__0), f(x__1, y__1), f(x__2, y__2)]
+    >>> Map(f, X, [1, 2, 3])
+    [f(x__0, 1), f(x__1, 2), f(x__2, 3)]
+    """
+    if z3_debug():
+        _z3_assert(is_func_decl(f), "Z3 function declaration expected")
+        _z3_assert(len(args) == f.arity() and len(args) > 0, "one list per argument of the function expected")
+        _z3_assert(all(len(a) == len(args[0]) for a in args), "lists of the same length expected")
+    ctx = f.ctx
+    arity = f.arity()
+    n = len(args[0])
+    dom = [ f.domain(j) for j in range(arity) ]
+    num_leaves = n * arity
+    leaves = (Ast * num_leaves)()
+    k = 0
+    for i in range(n):
+        for j in range(arity):
+            a = args[j][i]
+            leaves[k] = (a if is_expr(a) else dom[j].cast(a)).as_ast()
+            k += 1
+    decls = (FuncDecl * n)()
+    for i in range(n):
+        decls[i] = f.as_func_decl()
+    num_args = (ctypes.c_uint * n)(*([arity] * n))
+    operands = (ctypes.c_uint * num_leaves)(*range(num_leaves))
+    v = AstVector(Z3_mk_apps(ctx.ref(), num_leaves, leaves, n, decls, num_args, num_leaves, operands), ctx)
+    return [ v[i] for i in range(n) ]
+
 def RecFunction(name, *sig):
     """Create a new Z3 recursive with the given sorts."""
     sig = _get_args(sig)
@@ -6055,6 +6095,25 @@ class ModelRef(Z3PPObject):
         """
         return self.eval(t, model_completion)
 
+    def eval_uint64(self, ts, model_completion=False):
+        """Evaluate the Boolean, bit-vector and integer expressions `ts` in the model `self` and return their values as a list of Python integers.
+
+        >>> x, y = BitVecs('x y', 16)
+        >>> b = Bool('b')
+        >>> s = Solver()
+        >>> s.add(x == 3, y == x + 4, b)
+        >>> s.check()
+        sat
+        >>> m = s.model()
+        >>> m.eval_uint64([x, y, b, x * y])
+        [3, 7, 1, 21]
+        """
+        _ts, sz = _to_ast_array(ts)
+        r = (ctypes.c_ulonglong * sz)()
+        if Z3_model_eval_uint64(self.ctx.ref(), self.model, sz, _ts, model_completion, r):
+            return [r[i] for i in range(sz)]
+        raise Z3Exception("failed to evaluate expressions as machine integers in the model")
+
     def __len__(self):
         """Return the number of constant and function declarations in the model `self`.
 
@@ -1413,6 +1413,11 @@ typedef enum
 */
 typedef void Z3_error_handler(Z3_context c, Z3_error_code e);
 
+/**
+   \brief Callback invoked when an asynchronous check completes (See #Z3_solver_set_check_async_handler).
+*/
+typedef void Z3_solver_check_handler(void* ctx, Z3_solver s, Z3_lbool r);
+
 /**
    \brief A Goal is essentially a set of formulas.
    Z3 provide APIs for building strategies/tactics for solving and transforming Goals.
@@ -1514,6 +1519,7 @@ extern "C" {
 
             - proof  (Boolean)           Enable proof generation
             - debug_ref_count (Boolean)  Enable debug support for Z3_ast reference counting
+            - ast_arena (Boolean)        Keep AST nodes until the context is destroyed and release them in bulk
             - trace  (Boolean)           Tracing support for VCC
             - trace_file_name (String)   Trace out file for VCC traces
             - timeout (unsigned)         default timeout (in milliseconds) used for solvers
@@ -1634,6 +1640,32 @@ extern "C" {
     */
     void Z3_API Z3_dec_ref(Z3_context c, Z3_ast a);
 
+    /**
+       \brief Open a handle scope.
+       The context \c c should have been created using #Z3_mk_context_rc.
+       Every \c Z3_ast returned by Z3 until the matching #Z3_pop_handle_scope
+       is kept alive by the scope, that is, the user does not need to invoke
+       #Z3_inc_ref and #Z3_dec_ref for it. The references held by the scope are
+       released in bulk when the scope is closed.
+       Scopes can be nested.
+
+       \sa Z3_pop_handle_scope
+
+       def_API('Z3_push_handle_scope', VOID, (_in(CONTEXT),))
+    */
+    void Z3_API Z3_push_handle_scope(Z3_context c);
+
+    /**
+       \brief Close the innermost handle scope and release the references
+       to the ASTs it keeps alive. ASTs that should survive the scope must
+       be protected using #Z3_inc_ref before the scope is closed.
+
+       \sa Z3_push_handle_scope
+
+       def_API('Z3_pop_handle_scope', VOID, (_in(CONTEXT),))
+    */
+    void Z3_API Z3_pop_handle_scope(Z3_context c);
+
     /**
        \brief Set a value of a context parameter.
 
@@ -2169,6 +2201,32 @@ extern "C" {
         unsigned num_args,
         Z3_ast const args[]);
 
+    /**
+       \brief Create a DAG of function applications in a single call.
+
+       The DAG is encoded as a program over operand indices. Indices below
+       \c num_leaves refer to \c leaves. Index \c num_leaves + i refers to the 
+       i'th node created by the call. The i'th node is the application of
+       \c decls[i] to the next \c num_args[i] entries of \c operands. 
+       The \c operands of a node can only refer to leaves and to nodes created before it.
+       The sum of the entries in \c num_args must be \c num_operands.
+
+       The result is a vector containing the \c num_nodes applications in order.
+
+       \sa Z3_mk_app
+
+       def_API('Z3_mk_apps', AST_VECTOR, (_in(CONTEXT), _in(UINT), _in_array(1, AST), _in(UINT), _in_array(3, FUNC_DECL), _in_array(3, UINT), _in(UINT), _in_array(6, UINT)))
+    */
+    Z3_ast_vector Z3_API Z3_mk_apps(
+        Z3_context c,
+        unsigned num_leaves,
+        Z3_ast const leaves[],
+        unsigned num_nodes,
+        Z3_func_decl const decls[],
+        unsigned const num_args[],
+        unsigned num_operands,
+        unsigned const operands[]);
+
     /**
        \brief Declare and create a constant.
 
@@ -5101,6 +5159,24 @@ extern "C" {
     */
     Z3_bool_opt Z3_API Z3_model_eval(Z3_context c, Z3_model m, Z3_ast t, bool model_completion, Z3_ast * v);
 
+    /**
+       \brief Evaluate the terms \c ts[0], ..., \c ts[num-1] in the model \c m and store
+       their values as machine integers in \c values.
+
+       Boolean terms evaluate to 0 or 1. Bit-vector terms of width at most 64 and
+       integer terms whose value is in the range [0, 2^64) evaluate to their value.
+       The function returns \c false if the value of some term is not a numeral of this
+       kind. The corresponding entry of \c values is then set to 0.
+
+       This function is more efficient than calling #Z3_model_eval and
+       #Z3_get_numeral_uint64 for each term.
+
+       \sa Z3_model_eval
+
+       def_API('Z3_model_eval_uint64', BOOL, (_in(CONTEXT), _in(MODEL), _in(UINT), _in_array(2, AST), _in(BOOL), _out_array(2, UINT64)))
+    */
+    bool Z3_API Z3_model_eval_uint64(Z3_context c, Z3_model m, unsigned num, Z3_ast const ts[], bool model_completion, uint64_t values[]);
+
     /**
        \brief Return the interpretation (i.e., assignment) of constant \c a in the model \c m.
        Return \c NULL, if the model does not assign an interpretation for \c a.
@@ -5395,6 +5471,21 @@ extern "C" {
     */
     bool Z3_API Z3_open_log(Z3_string filename);
 
+    /**
+       \brief Log interaction to a file using a compact binary format.
+
+       The binary log is replayed in the same way as the text log. It is
+       buffered and only flushed when a command is logged. If \c async is
+       \c true, the file is written by a background thread and the records
+       reach the file when a buffer is full or when the log is closed.
+
+       \sa Z3_open_log
+       \sa Z3_close_log
+
+       extra_API('Z3_open_binary_log', INT, (_in(STRING), _in(BOOL)))
+    */
+    bool Z3_API Z3_open_binary_log(Z3_string filename, bool async);
+
     /**
        \brief Append user-defined string to interaction log.
 
@@ -5822,6 +5913,25 @@ extern "C" {
     */
     Z3_string Z3_API Z3_goal_to_dimacs_string(Z3_context c, Z3_goal g);
 
+    /**
+       \brief Write the formulas of a goal to a file in binary format.
+
+       \sa Z3_goal_from_binary_file
+       \sa Z3_ast_vector_to_binary_file
+
+       def_API('Z3_goal_to_binary_file', VOID, (_in(CONTEXT), _in(GOAL), _in(STRING)))
+    */
+    void Z3_API Z3_goal_to_binary_file(Z3_context c, Z3_goal g, Z3_string file_name);
+
+    /**
+       \brief Add the formulas written by #Z3_goal_to_binary_file to a goal.
+
+       \sa Z3_goal_to_binary_file
+
+       def_API('Z3_goal_from_binary_file', VOID, (_in(CONTEXT), _in(GOAL), _in(STRING)))
+    */
+    void Z3_API Z3_goal_from_binary_file(Z3_context c, Z3_goal g, Z3_string file_name);
+
     /*@}*/
 
     /** @name Tactics and Probes */
@@ -6269,6 +6379,11 @@ extern "C" {
     /**
        \brief Copy a solver \c s from the context \c source to the context \c target.
 
+       When \c target is \c source, the copy shares the declarations and terms of \c s.
+       Assertions that \c s already preprocessed in a previous check are not preprocessed
+       again by the copy. So a solver with a common background theory can serve as a
+       template for new solvers.
+
        def_API('Z3_solver_translate', SOLVER, (_in(CONTEXT), _in(SOLVER), _in(CONTEXT)))
     */
     Z3_solver Z3_API Z3_solver_translate(Z3_context source, Z3_solver s, Z3_context target);
@@ -6511,6 +6626,55 @@ extern "C" {
     Z3_lbool Z3_API Z3_solver_check_assumptions(Z3_context c, Z3_solver s,
                                                 unsigned num_assumptions, Z3_ast const assumptions[]);
 
+    /**
+       \brief Start checking the assertions in the given solver and optional
+       assumptions on a worker of the process-wide thread pool, and return
+       without waiting for the result.
+
+       When all workers are busy the check is queued, so many queries can be
+       served by a fixed number of threads.
+       Until the check has completed, the context \c c may only be used
+       to invoke #Z3_solver_check_async_done, #Z3_solver_check_async_wait,
+       #Z3_solver_interrupt or #Z3_interrupt. Use a separate context for
+       each query that should run concurrently.
+
+       \sa Z3_solver_check_async_done
+       \sa Z3_solver_check_async_wait
+       \sa Z3_solver_set_check_async_handler
+
+       def_API('Z3_solver_check_async', VOID, (_in(CONTEXT), _in(SOLVER), _in(UINT), _in_array(2, AST)))
+    */
+    void Z3_API Z3_solver_check_async(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[]);
+
+    /**
+       \brief Return \c true if no asynchronous check of \c s is running.
+
+       \sa Z3_solver_check_async
+
+       def_API('Z3_solver_check_async_done', BOOL, (_in(CONTEXT), _in(SOLVER)))
+    */
+    bool Z3_API Z3_solver_check_async_done(Z3_context c, Z3_solver s);
+
+    /**
+       \brief Wait until the asynchronous check of \c s has completed and
+       return its result. The check can be cancelled using #Z3_solver_interrupt,
+       it then returns \c Z3_L_UNDEF.
+
+       \sa Z3_solver_check_async
+
+       def_API('Z3_solver_check_async_wait', INT, (_in(CONTEXT), _in(SOLVER)))
+    */
+    Z3_lbool Z3_API Z3_solver_check_async_wait(Z3_context c, Z3_solver s);
+
+    /**
+       \brief Register a callback that is invoked with \c ctx, \c s and the result
+       when an asynchronous check of \c s completes. The callback runs on the
+       worker thread that performed the check.
+
+       \sa Z3_solver_check_async
+    */
+    void Z3_API Z3_solver_set_check_async_handler(Z3_context c, Z3_solver s, void* ctx, Z3_solver_check_handler* h);
+
     /**
        \brief Retrieve congruence class representatives for terms.
 
@@ -6548,6 +6712,57 @@ extern "C" {
                                                Z3_ast_vector consequences);
 
 
+    /**
+       \brief enumerate the assignments to the Boolean expressions in \c vars that extend to models
+       of the assertions in the solver. Each assignment is added to \c models as the conjunction
+       of the literals over \c vars. At most \c max_models assignments are retrieved, all of
+       them if \c max_models is 0.
+
+       The assignments are enumerated without adding blocking clauses to the solver:
+       every check assumes a prefix of an assignment that was already found with its
+       last literal negated.
+
+       def_API('Z3_solver_enumerate', INT, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR), _in(UINT), _in(AST_VECTOR)))
+     */
+
+    Z3_lbool Z3_API Z3_solver_enumerate(Z3_context c,
+                                        Z3_solver s,
+                                        Z3_ast_vector vars,
+                                        unsigned max_models,
+                                        Z3_ast_vector models);
+
+    /**
+       \brief estimate the number of assignments to the Boolean expressions in \c vars that
+       extend to models of the assertions in the solver. The estimate is stored as an integer
+       numeral in \c count. The count is exact when it is at most \c threshold; larger counts
+       are estimated from cells selected by random XOR constraints over \c vars, and
+       \c count is the median of \c iterations estimates.
+
+       def_API('Z3_solver_approx_count', INT, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR), _in(UINT), _in(UINT), _out(AST)))
+     */
+
+    Z3_lbool Z3_API Z3_solver_approx_count(Z3_context c,
+                                           Z3_solver s,
+                                           Z3_ast_vector vars,
+                                           unsigned threshold,
+                                           unsigned iterations,
+                                           Z3_ast * count);
+
+    /**
+       \brief retrieve the backbone of the solver over the Boolean expressions in \c vars:
+       the literals over \c vars that are true in every model of the assertions.
+       The literals are tested in chunks, and each model found on the way removes
+       all the candidate literals it falsifies.
+
+       def_API('Z3_solver_get_backbone', INT, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR), _in(AST_VECTOR)))
+     */
+
+    Z3_lbool Z3_API Z3_solver_get_backbone(Z3_context c,
+                                           Z3_solver s,
+                                           Z3_ast_vector vars,
+                                           Z3_ast_vector backbone);
+
+
     /**
        \brief extract a next cube for a solver. The last cube is the constant \c true or \c false.
        The number of (non-constant) cubes is by default 1. For the sat solver cubing is controlled
@@ -6637,6 +6852,25 @@ extern "C" {
     */
     Z3_string Z3_API Z3_solver_to_dimacs_string(Z3_context c, Z3_solver s, bool include_names);
 
+    /**
+       \brief Write the solver assertions to a file in binary format.
+
+       \sa Z3_solver_from_binary_file
+       \sa Z3_ast_vector_to_binary_file
+
+       def_API('Z3_solver_to_binary_file', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_to_binary_file(Z3_context c, Z3_solver s, Z3_string file_name);
+
+    /**
+       \brief Add the assertions written by #Z3_solver_to_binary_file to a solver.
+
+       \sa Z3_solver_to_binary_file
+
+       def_API('Z3_solver_from_binary_file', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_from_binary_file(Z3_context c, Z3_solver s, Z3_string file_name);
+
     /*@}*/
 
     /** @name Statistics */
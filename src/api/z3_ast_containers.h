@@ -105,6 +105,26 @@ extern "C" {
     */
     Z3_string Z3_API Z3_ast_vector_to_string(Z3_context c, Z3_ast_vector v);
 
+    /**
+       \brief Write the AST vector to a file in binary format.
+       Shared subterms are written once. The file can be read back using
+       #Z3_ast_vector_from_binary_file, also in a different context.
+
+       \sa Z3_ast_vector_from_binary_file
+
+       def_API('Z3_ast_vector_to_binary_file', VOID, (_in(CONTEXT), _in(AST_VECTOR), _in(STRING)))
+    */
+    void Z3_API Z3_ast_vector_to_binary_file(Z3_context c, Z3_ast_vector v, Z3_string file_name);
+
+    /**
+       \brief Read an AST vector written by #Z3_ast_vector_to_binary_file.
+
+       \sa Z3_ast_vector_to_binary_file
+
+       def_API('Z3_ast_vector_from_binary_file', AST_VECTOR, (_in(CONTEXT), _in(STRING)))
+    */
+    Z3_ast_vector Z3_API Z3_ast_vector_from_binary_file(Z3_context c, Z3_string file_name);
+
     /*@}*/
 
     /** @name AST maps */
@@ -17,18 +17,58 @@ Notes:
     
 --*/
 #include<iostream>
+#include<cstring>
 #include "util/symbol.h"
 struct ll_escaped { char const * m_str; ll_escaped(char const * str):m_str(str) {} };
 static std::ostream & operator<<(std::ostream & out, ll_escaped const & d);
 
-static void __declspec(noinline) R()  { *g_z3_log << "R\n"; g_z3_log->flush(); }
-static void __declspec(noinline) P(void * obj)  { *g_z3_log << "P " << obj << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) I(int64_t i)   { *g_z3_log << "I " << i << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) U(uint64_t u)   { *g_z3_log << "U " << u << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) D(double d)   { *g_z3_log << "D " << d << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) S(Z3_string str) { *g_z3_log << "S \"" << ll_escaped(str) << "\"\n"; g_z3_log->flush(); }
+// In binary logs a record is its tag followed by the arguments encoded
+// as LEB128 integers, zigzag encoded when signed, and length prefixed strings.
+// The stream is only flushed when a command is logged.
+static void Bs(char const * str) {
+    size_t len = strlen(str);
+    _Z3_log_binary_uint(len);
+    g_z3_log->write(str, len);
+}
+
+static void __declspec(noinline) R()  {
+    if (g_z3_log_binary) { g_z3_log->put('R'); return; }
+    *g_z3_log << "R\n"; g_z3_log->flush();
+}
+static void __declspec(noinline) P(void * obj)  {
+    if (g_z3_log_binary) { g_z3_log->put('P'); _Z3_log_binary_uint(reinterpret_cast<size_t>(obj)); return; }
+    *g_z3_log << "P " << obj << "\n"; g_z3_log->flush();
+}
+static void __declspec(noinline) I(int64_t i)   {
+    if (g_z3_log_binary) { g_z3_log->put('I'); _Z3_log_binary_uint((static_cast<uint64_t>(i) << 1) ^ static_cast<uint64_t>(i >> 63)); return; }
+    *g_z3_log << "I " << i << "\n"; g_z3_log->flush();
+}
+static void __declspec(noinline) U(uint64_t u)   {
+    if (g_z3_log_binary) { g_z3_log->put('U'); _Z3_log_binary_uint(u); return; }
+    *g_z3_log << "U " << u << "\n"; g_z3_log->flush();
+}
+static void __declspec(noinline) D(double d)   {
+    if (g_z3_log_binary) { g_z3_log->put('D'); g_z3_log->write(reinterpret_cast<char const*>(&d), sizeof(d)); return; }
+    *g_z3_log << "D " << d << "\n"; g_z3_log->flush();
+}
+static void __declspec(noinline) S(Z3_string str) {
+    if (g_z3_log_binary) { g_z3_log->put('S'); Bs(str); return; }
+    *g_z3_log << "S \"" << ll_escaped(str) << "\"\n"; g_z3_log->flush();
+}
 static void __declspec(noinline) Sy(Z3_symbol sym) { 
     symbol s = symbol::c_api_ext2symbol(sym);
+    if (g_z3_log_binary) {
+        if (s.is_null()) {
+            g_z3_log->put('N');
+        }
+        else if (s.is_numerical()) {
+            g_z3_log->put('#'); _Z3_log_binary_uint(s.get_num());
+        }
+        else {
+            g_z3_log->put('$'); Bs(s.bare_str());
+        }
+        return;
+    }
     if (s.is_null()) {
         *g_z3_log << "N\n";
     }
@@ -40,12 +80,30 @@ static void __declspec(noinline) Sy(Z3_symbol sym) {
     }
     g_z3_log->flush();
 }
-static void __declspec(noinline) Ap(unsigned sz) { *g_z3_log << "p " << sz << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) Au(unsigned sz) { *g_z3_log << "u " << sz << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) Ai(unsigned sz) { *g_z3_log << "i " << sz << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) Asy(unsigned sz) { *g_z3_log << "s " << sz << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) C(unsigned id)   { *g_z3_log << "C " << id << "\n"; g_z3_log->flush(); }
-void __declspec(noinline) _Z3_append_log(char const * msg) { *g_z3_log << "M \"" << ll_escaped(msg) << "\"\n"; g_z3_log->flush(); }
+static void __declspec(noinline) Ap(unsigned sz) {
+    if (g_z3_log_binary) { g_z3_log->put('p'); _Z3_log_binary_uint(sz); return; }
+    *g_z3_log << "p " << sz << "\n"; g_z3_log->flush();
+}
+static void __declspec(noinline) Au(unsigned sz) {
+    if (g_z3_log_binary) { g_z3_log->put('u'); _Z3_log_binary_uint(sz); return; }
+    *g_z3_log << "u " << sz << "\n"; g_z3_log->flush();
+}
+static void __declspec(noinline) Ai(unsigned sz) {
+    if (g_z3_log_binary) { g_z3_log->put('i'); _Z3_log_binary_uint(sz); return; }
+    *g_z3_log << "i " << sz << "\n"; g_z3_log->flush();
+}
+static void __declspec(noinline) Asy(unsigned sz) {
+    if (g_z3_log_binary) { g_z3_log->put('s'); _Z3_log_binary_uint(sz); return; }
+    *g_z3_log << "s " << sz << "\n"; g_z3_log->flush();
+}
+static void __declspec(noinline) C(unsigned id)   {
+    if (g_z3_log_binary) { g_z3_log->put('C'); _Z3_log_binary_uint(id); g_z3_log->flush(); return; }
+    *g_z3_log << "C " << id << "\n"; g_z3_log->flush();
+}
+void __declspec(noinline) _Z3_append_log(char const * msg) {
+    if (g_z3_log_binary) { g_z3_log->put('M'); Bs(msg); g_z3_log->flush(); return; }
+    *g_z3_log << "M \"" << ll_escaped(msg) << "\"\n"; g_z3_log->flush();
+}
 
 static std::ostream & operator<<(std::ostream & out, ll_escaped const & d) {
     char const * s = d.m_str;
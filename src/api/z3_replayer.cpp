@@ -22,6 +22,7 @@ Notes:
 #include "util/stream_buffer.h"
 #include "util/symbol.h"
 #include "util/trace.h"
+#include<cstring>
 #include<sstream>
 #include<vector>
 
@@ -38,6 +39,7 @@ struct z3_replayer::imp {
     std::istream &           m_stream;
     int                      m_curr;  // current char;
     int                      m_line;  // line
+    bool                     m_binary; // true if the log uses the binary format of Z3_open_binary_log
     svector<char>            m_string;
     symbol                   m_id;
     int64_t                  m_int64;
@@ -109,13 +111,15 @@ struct z3_replayer::imp {
     vector<ptr_vector<void> >   m_obj_arrays;
     vector<svector<Z3_symbol> > m_sym_arrays;
     vector<unsigned_vector>     m_unsigned_arrays;
+    vector<svector<uint64_t> >  m_uint64_arrays;
     vector<svector<int> >       m_int_arrays;
 
     imp(z3_replayer & o, std::istream & in):
         m_owner(o),
         m_stream(in),
         m_curr(0),
-        m_line(1) {
+        m_line(1),
+        m_binary(false) {
         next();
     }
 
@@ -164,7 +168,49 @@ struct z3_replayer::imp {
     void new_line() { m_line++; }
     void next() { m_curr = m_stream.get(); }
 
+    unsigned char read_byte() {
+        int c = curr();
+        if (c == EOF)
+            throw z3_replayer_exception("unexpected end of file");
+        next();
+        return static_cast<unsigned char>(c);
+    }
+
+    uint64_t read_binary_uint() {
+        uint64_t r = 0;
+        unsigned shift = 0;
+        while (true) {
+            unsigned char c = read_byte();
+            if (shift >= 64)
+                throw z3_replayer_exception("invalid unsigned");
+            r |= static_cast<uint64_t>(c & 0x7F) << shift;
+            if ((c & 0x80) == 0)
+                return r;
+            shift += 7;
+        }
+    }
+
+    void read_binary_string() {
+        uint64_t len = read_binary_uint();
+        m_string.reset();
+        for (uint64_t i = 0; i < len; ++i)
+            m_string.push_back(static_cast<char>(read_byte()));
+        m_string.push_back(0);
+    }
+
+    template<typename T>
+    void read_binary_bytes(T& v) {
+        char buffer[sizeof(T)];
+        for (unsigned i = 0; i < sizeof(T); ++i)
+            buffer[i] = static_cast<char>(read_byte());
+        memcpy(&v, buffer, sizeof(T));
+    }
+
     void read_string_core(char delimiter) {
+        if (m_binary) {
+            read_binary_string();
+            return;
+        }
         if (curr() != delimiter)
             throw z3_replayer_exception("invalid string/symbol");
         m_string.reset();
@@ -220,6 +266,11 @@ struct z3_replayer::imp {
     }
 
     void read_int64() {
+        if (m_binary) {
+            uint64_t u = read_binary_uint();
+            m_int64 = static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
+            return;
+        }
         if (!(curr() == '-' || ('0' <= curr() && curr() <= '9')))
             throw z3_replayer_exception("invalid integer");
         bool sign = false;
@@ -245,6 +296,10 @@ struct z3_replayer::imp {
     }
 
     void read_uint64() {
+        if (m_binary) {
+            m_uint64 = read_binary_uint();
+            return;
+        }
         if (!('0' <= curr() && curr() <= '9'))
             throw z3_replayer_exception("invalid unsigned");
         m_uint64 = 0;
@@ -272,6 +327,10 @@ struct z3_replayer::imp {
 #endif
 
     void read_float() {
+        if (m_binary) {
+            read_binary_bytes(m_float);
+            return;
+        }
         m_string.reset();
         while (is_double_char()) {
             m_string.push_back(curr());
@@ -285,6 +344,10 @@ struct z3_replayer::imp {
     }
 
     void read_double() {
+        if (m_binary) {
+            read_binary_bytes(m_double);
+            return;
+        }
         m_string.reset();
         while (is_double_char()) {
             m_string.push_back(curr());
@@ -298,6 +361,10 @@ struct z3_replayer::imp {
     }
 
     void read_ptr() {
+        if (m_binary) {
+            m_ptr = static_cast<size_t>(read_binary_uint());
+            return;
+        }
         if (!(('0' <= curr() && curr() <= '9') || ('A' <= curr() && curr() <= 'F') || ('a' <= curr() && curr() <= 'f'))) {
             TRACE("invalid_ptr", tout << "curr: " << curr() << "\n";);
             throw z3_replayer_exception("invalid ptr");
@@ -326,13 +393,15 @@ struct z3_replayer::imp {
     }
 
     void skip_blank() {
+        if (m_binary)
+            return;
         while (true) {
             int c = curr();
             if (c == '\n') {
                 new_line();
                 next();
             }
-            else if (c == ' ' || c == '\t') {
+            else if (c == ' ' || c == '\t' || c == '\r') {
                 next();
             }
             else {
@@ -355,9 +424,12 @@ struct z3_replayer::imp {
             aidx = m_unsigned_arrays.size();
             nk   = UINT_ARRAY;
             m_unsigned_arrays.push_back(unsigned_vector());
+            m_uint64_arrays.push_back(svector<uint64_t>());
             unsigned_vector & v = m_unsigned_arrays.back();
+            svector<uint64_t> & v64 = m_uint64_arrays.back();
             for (unsigned i = asz - sz; i < asz; i++) {
                 v.push_back(static_cast<unsigned>(m_args[i].m_uint));
+                v64.push_back(m_args[i].m_uint);
             }
         }
         else if (k == INT64) {
@@ -419,6 +491,11 @@ struct z3_replayer::imp {
             if (c == EOF)
                 return;
             switch (c) {
+            case 'B':
+                // the rest of the log uses the binary format
+                next();
+                m_binary = true;
+                break;
             case 'V':
                 // version
                 next(); skip_blank(); read_string();
@@ -631,6 +708,12 @@ struct z3_replayer::imp {
         return m_unsigned_arrays[idx].c_ptr();
     }
 
+    uint64_t * get_uint64_array(unsigned pos) const {
+        check_arg(pos, UINT_ARRAY);
+        unsigned idx = static_cast<unsigned>(m_args[pos].m_uint);
+        return m_uint64_arrays[idx].c_ptr();
+    }
+
     int * get_int_array(unsigned pos) const {
         check_arg(pos, INT_ARRAY);
         unsigned idx = static_cast<unsigned>(m_args[pos].m_uint);
@@ -707,6 +790,7 @@ struct z3_replayer::imp {
         m_obj_arrays.reset();
         m_sym_arrays.reset();
         m_unsigned_arrays.reset();
+        m_uint64_arrays.reset();
         m_int_arrays.reset();
     }
 
@@ -774,6 +858,10 @@ int * z3_replayer::get_int_array(unsigned pos) const {
     return m_imp->get_int_array(pos);
 }
 
+uint64_t * z3_replayer::get_uint64_array(unsigned pos) const {
+    return m_imp->get_uint64_array(pos);
+}
+
 bool * z3_replayer::get_bool_array(unsigned pos) const {
     return m_imp->get_bool_array(pos);
 }
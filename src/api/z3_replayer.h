@@ -50,6 +50,7 @@ public:
     void * get_obj(unsigned pos) const;
 
     unsigned * get_uint_array(unsigned pos) const;
+    uint64_t * get_uint64_array(unsigned pos) const;
     int * get_int_array(unsigned pos) const;
     bool * get_bool_array(unsigned pos) const;
     Z3_symbol * get_symbol_array(unsigned pos) const;
@@ -144,7 +144,7 @@ void act_cache::insert(expr * k, unsigned offset, expr * v) {
     unsigned static counter = 0;
     counter++;
     if (counter % 100000 == 0)
-        verbose_stream() << "[act-cache] counter: " << counter << " used_slots: " << m_table.used_slots() << " capacity: " << m_table.capacity() << " size: " << m_table.size() << " collisions: " << m_table.collisions() << "\n";
+        verbose_stream() << "[act-cache] counter: " << counter << " capacity: " << m_table.capacity() << " size: " << m_table.size() << "\n";
 #endif
 
 #ifdef Z3DEBUG
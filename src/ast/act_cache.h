@@ -21,10 +21,9 @@ Notes:
 #define ACT_CACHE_H_
 
 #include "ast/ast.h"
-#include "util/obj_hashtable.h"
-#include "util/chashtable.h"
+#include "util/swiss_table.h"
 
-class act_cache {
+class act_cache : public memory_cache {
     ast_manager &        m_manager;
     typedef std::pair<expr*, unsigned> entry_t;
     struct entry_hash {
@@ -32,7 +31,7 @@ class act_cache {
             return e.first->hash() + e.second;
         }
     };
-    typedef cmap<entry_t, expr*, entry_hash, default_eq<entry_t> > map;
+    typedef swiss_map<entry_t, expr*, entry_hash, default_eq<entry_t> > map;
     map                  m_table;
     svector<entry_t>     m_queue; // recently created queue
     unsigned             m_qhead;
@@ -58,7 +57,8 @@ public:
     unsigned capacity() const { return m_table.capacity(); }
     bool empty() const { return m_table.empty(); }
     bool check_invariant() const;
-    
+    void shrink() override { cleanup(); }
+
 };
 
 #endif
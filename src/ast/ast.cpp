@@ -600,7 +600,7 @@ unsigned get_node_hash(ast const * n) {
     return 0;
 }
 
-void ast_table::push_erase(ast * n) {
+void ast_table::segment::push_erase(ast * n) {
     // It uses two important properties:
     // 1. n is known to be in the table.
     // 2. operator== can be used instead of compare_nodes (big savings)
@@ -640,7 +640,7 @@ void ast_table::push_erase(ast * n) {
     }
 }
 
-ast* ast_table::pop_erase() {
+ast* ast_table::segment::pop_erase() {
     cell* c = m_tofree_cell;
     if (c == nullptr) {
         return nullptr;
@@ -1435,6 +1435,8 @@ void ast_manager::update_fresh_id(ast_manager const& m) {
 void ast_manager::init() {
     m_int_real_coercions = true;
     m_debug_ref_count = false;
+    m_arena_mode = false;
+    m_concurrent_mux = nullptr;
     m_fresh_id = 0;
     m_expr_id_gen.reset(0);
     m_decl_id_gen.reset(c_first_decl_id);
@@ -1488,6 +1490,7 @@ ast_manager::~ast_manager() {
     dec_ref(m_true);
     dec_ref(m_false);
     dec_ref(m_undef_proof);
+    m_plugin_factories.reset();
     for (decl_plugin* p : m_plugins) {
         if (p)
             p->finalize();
@@ -1497,6 +1500,8 @@ ast_manager::~ast_manager() {
             dealloc(p);
     }
     m_plugins.reset();
+    if (m_arena_mode) 
+        release_arena();
     while (!m_ast_table.empty()) {
         DEBUG_CODE(IF_VERBOSE(0, verbose_stream() << "ast_manager LEAKED: " << m_ast_table.size() << std::endl););
         ptr_vector<ast> roots;
@@ -1556,6 +1561,7 @@ ast_manager::~ast_manager() {
     }
     if (m_format_manager != nullptr)
         dealloc(m_format_manager);
+    dealloc(m_concurrent_mux);
     if (m_trace_stream_owner) {
         std::fstream & tmp = * m_trace_stream;
         tmp << "[eof]\n";
@@ -1565,6 +1571,33 @@ ast_manager::~ast_manager() {
     }
 }
 
+/**
+   \brief release all nodes without following reference counts.
+   Nodes carved from allocator chunks are freed when m_alloc is destroyed,
+   only declaration infos and large nodes are released individually.
+*/
+void ast_manager::release_arena() {
+    for (ast * n : m_ast_table) {
+        switch (n->get_kind()) {
+        case AST_SORT:
+            if (to_sort(n)->m_info != nullptr) 
+                dealloc(to_sort(n)->get_info());
+            break;
+        case AST_FUNC_DECL:
+            if (to_func_decl(n)->m_info != nullptr) 
+                dealloc(to_func_decl(n)->get_info());
+            break;
+        default:
+            break;
+        }
+        unsigned sz = ::get_node_size(n);
+        if (!small_object_allocator::is_chunk_allocated(sz))
+            deallocate_node(n, sz);
+    }
+    m_ast_table.reset();
+    m_lambda_defs.reset();
+}
+
 void ast_manager::compact_memory() {
     m_alloc.consolidate();
     unsigned capacity = m_ast_table.capacity();
@@ -1644,6 +1677,13 @@ void ast_manager::copy_families_plugins(ast_manager const & from) {
               if (m_family_manager.has_family(fid)) tout << get_family_id(fid_name) << "\n";);
         TRACE("copy_families_plugins", tout << "target fid: " << get_family_id(fid_name) << "\n";);
         SASSERT(fid == get_family_id(fid_name));
+        decl_plugin_factory f = from.m_plugin_factories.get(fid, nullptr);
+        if (f && !has_plugin(fid)) {
+            // the plugin was not used in the source, so there is nothing to inherit.
+            m_plugins.setx(fid, nullptr, nullptr);
+            m_plugin_factories.setx(fid, f, nullptr);
+            continue;
+        }
         if (from.has_plugin(fid) && !has_plugin(fid)) {
             decl_plugin * new_p = from.get_plugin(fid)->mk_fresh();
             register_plugin(fid, new_p);
@@ -1689,8 +1729,26 @@ void ast_manager::register_plugin(symbol const & s, decl_plugin * plugin) {
     register_plugin(id, plugin);
 }
 
-decl_plugin * ast_manager::get_plugin(family_id fid) const {
-    return m_plugins.get(fid, 0);
+void ast_manager::register_plugin_factory(symbol const & s, decl_plugin_factory f) {
+    family_id id = m_family_manager.mk_family_id(s);
+    SASSERT(!has_plugin(id));
+    // reserve the slot so that creating the plugin does not move m_plugins.
+    m_plugins.setx(id, nullptr, nullptr);
+    m_plugin_factories.setx(id, f, nullptr);
+}
+
+decl_plugin * ast_manager::mk_plugin(family_id fid) const {
+    concurrent_guard _guard(*this);
+    decl_plugin_factory f = m_plugin_factories.get(fid, nullptr);
+    if (!f)
+        return m_plugins.get(fid, nullptr);
+    ast_manager & m = const_cast<ast_manager&>(*this);
+    m.m_plugin_factories[fid] = nullptr;
+    decl_plugin * p = f();
+    p->set_manager(&m, fid);
+    // publish the plugin only after it is initialized.
+    m.m_plugins[fid] = p;
+    return p;
 }
 
 
@@ -1755,6 +1813,7 @@ quantifier* ast_manager::is_lambda_def(func_decl* f) {
 
 void ast_manager::register_plugin(family_id id, decl_plugin * plugin) {
     SASSERT(m_plugins.get(id, 0) == 0);
+    m_plugin_factories.setx(id, nullptr, nullptr);
     m_plugins.setx(id, plugin, 0);
     plugin->set_manager(this, id);
 }
@@ -1794,7 +1853,14 @@ static void track_id(ast_manager& m, ast* n, unsigned id) {
 }
 #endif
 
+void ast_manager::enable_concurrent_mode() {
+    m_arena_mode = true;
+    if (!m_concurrent_mux)
+        m_concurrent_mux = alloc(recursive_mutex);
+}
+
 ast * ast_manager::register_node_core(ast * n) {
+    concurrent_guard _g(*this);
     unsigned h = get_node_hash(n);
     n->m_hash = h;
 #ifdef Z3DEBUG
@@ -1988,6 +2054,7 @@ void ast_manager::delete_node(ast * n) {
 
 
 sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters) {
+    concurrent_guard _g(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_sort(k, num_parameters, parameters);
@@ -1996,6 +2063,7 @@ sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters,
 
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned arity, sort * const * domain, sort * range) {
+    concurrent_guard _g(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, arity, domain, range);
@@ -2004,6 +2072,7 @@ func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_p
 
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned num_args, expr * const * args, sort * range) {
+    concurrent_guard _g(*this);
     decl_plugin * p = get_plugin(fid);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, num_args, args, range);
@@ -2348,6 +2417,7 @@ app * ast_manager::mk_app(func_decl * decl, unsigned num_args, expr * const * ar
 
 func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const & suffix, unsigned arity,
                                             sort * const * domain, sort * range, bool skolem) {
+    concurrent_guard _g(*this);
     func_decl_info info(null_family_id, null_decl_kind);
     info.m_skolem = skolem;
     SASSERT(skolem == info.is_skolem());
@@ -2374,6 +2444,7 @@ func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const
 }
 
 sort * ast_manager::mk_fresh_sort(char const * prefix) {
+    concurrent_guard _g(*this);
     string_buffer<32> buffer;
     buffer << prefix << "!" << m_fresh_id;
     m_fresh_id++;
@@ -2381,6 +2452,7 @@ sort * ast_manager::mk_fresh_sort(char const * prefix) {
 }
 
 symbol ast_manager::mk_fresh_var_name(char const * prefix) {
+    concurrent_guard _g(*this);
     string_buffer<32> buffer;
     buffer << (prefix ? prefix : "var") << "!" << m_fresh_id;
     m_fresh_id++;
@@ -38,6 +38,7 @@ Revision History:
 #include "util/ref_pair_vector.h"
 #include "util/ref_buffer.h"
 #include "util/obj_mark.h"
+#include "util/obj_dense_map.h"
 #include "util/obj_hashtable.h"
 #include "util/id_gen.h"
 #include "util/map.h"
@@ -47,6 +48,7 @@ Revision History:
 #include "util/z3_exception.h"
 #include "util/dependency.h"
 #include "util/rlimit.h"
+#include "util/mutex.h"
 
 #define RECYCLE_FREE_AST_INDICES
 
@@ -966,10 +968,121 @@ struct ast_eq_proc {
 
 class ast_translation;
 
-class ast_table : public chashtable<ast*, obj_ptr_hash<ast>, ast_eq_proc> {
+/**
+   \brief Hash-consing table of an ast_manager.
+
+   The table is split into segments selected by the high bits of the hash.
+   Each segment grows independently, so growing copies a fraction of the
+   nodes and the memory of the old and new tables of one segment coexist,
+   instead of pausing on and doubling the whole table.
+*/
+class ast_table {
+    class segment : public chashtable<ast*, obj_ptr_hash<ast>, ast_eq_proc> {
+    public:
+        void push_erase(ast * n);
+        ast* pop_erase();
+        bool has_erased() const { return m_tofree_cell != nullptr; }
+    };
+
+    static const unsigned LOG_SEGMENTS = 6;
+    static const unsigned NUM_SEGMENTS = 1 << LOG_SEGMENTS;
+    segment         m_segments[NUM_SEGMENTS];
+    unsigned_vector m_erased; // segments with pending erased cells
+
+    static unsigned get_segment(ast const * n) { return n->hash() >> (32 - LOG_SEGMENTS); }
+    segment & seg(ast const * n) { return m_segments[get_segment(n)]; }
+    segment const & seg(ast const * n) const { return m_segments[get_segment(n)]; }
+
 public:
-    void push_erase(ast * n);
-    ast* pop_erase();
+    bool contains(ast * n) const { return seg(n).contains(n); }
+    void insert(ast * n) { seg(n).insert(n); }
+    ast * insert_if_not_there(ast * n) { return seg(n).insert_if_not_there(n); }
+
+    /**
+       \brief remove n, which is in the table. The cells of erased nodes
+       are recycled by pop_erase, which returns the erased nodes in turn.
+    */
+    void push_erase(ast * n) {
+        unsigned i = get_segment(n);
+        if (!m_segments[i].has_erased())
+            m_erased.push_back(i);
+        m_segments[i].push_erase(n);
+    }
+
+    ast* pop_erase() {
+        while (!m_erased.empty()) {
+            ast* n = m_segments[m_erased.back()].pop_erase();
+            if (n)
+                return n;
+            m_erased.pop_back();
+        }
+        return nullptr;
+    }
+
+    unsigned size() const {
+        unsigned r = 0;
+        for (segment const& s : m_segments)
+            r += s.size();
+        return r;
+    }
+
+    bool empty() const {
+        for (segment const& s : m_segments)
+            if (!s.empty())
+                return false;
+        return true;
+    }
+
+    unsigned capacity() const {
+        unsigned r = 0;
+        for (segment const& s : m_segments)
+            r += s.capacity();
+        return r;
+    }
+
+    void reset() {
+        for (segment& s : m_segments)
+            s.reset();
+        m_erased.reset();
+    }
+
+    void finalize() {
+        for (segment& s : m_segments)
+            s.finalize();
+        m_erased.finalize();
+    }
+
+    void swap(ast_table & other) {
+        for (unsigned i = 0; i < NUM_SEGMENTS; ++i)
+            m_segments[i].swap(other.m_segments[i]);
+        m_erased.swap(other.m_erased);
+    }
+
+    class iterator {
+        segment const * m_seg;
+        segment const * m_end;
+        segment::iterator m_it;
+        void move_to_used() {
+            while (m_seg != m_end && m_it == segment::iterator()) {
+                ++m_seg;
+                if (m_seg != m_end)
+                    m_it = m_seg->begin();
+            }
+        }
+    public:
+        iterator(segment const * s, segment const * end): m_seg(s), m_end(end) {
+            if (m_seg != m_end)
+                m_it = m_seg->begin();
+            move_to_used();
+        }
+        ast * operator*() const { return *m_it; }
+        iterator & operator++() { ++m_it; move_to_used(); return *this; }
+        bool operator==(iterator const & other) const { return m_seg == other.m_seg && m_it == other.m_it; }
+        bool operator!=(iterator const & other) const { return !(*this == other); }
+    };
+
+    iterator begin() const { return iterator(m_segments, m_segments + NUM_SEGMENTS); }
+    iterator end() const { return iterator(m_segments + NUM_SEGMENTS, m_segments + NUM_SEGMENTS); }
 };
 
 // -----------------------------------
@@ -1473,6 +1586,8 @@ enum proof_gen_mode {
 //
 // -----------------------------------
 
+typedef decl_plugin * (*decl_plugin_factory)();
+
 class ast_manager {
     friend class basic_decl_plugin;
 protected:
@@ -1496,6 +1611,7 @@ protected:
 
     struct expr_dependency_config : public config {
         typedef expr *                   value;
+        static const bool hash_cons      = true;
     };
 
     typedef dependency_manager<expr_dependency_config> expr_dependency_manager;
@@ -1528,6 +1644,7 @@ protected:
     expr_dependency_manager   m_expr_dependency_manager;
     expr_dependency_array_manager m_expr_dependency_array_manager;
     ptr_vector<decl_plugin>   m_plugins;
+    svector<decl_plugin_factory> m_plugin_factories; // plugins that are created on first use
     proof_gen_mode            m_proof_mode;
     bool                      m_int_real_coercions; // If true, use hack that automatically introduces to_int/to_real when needed.
     family_id                 m_basic_family_id;
@@ -1547,6 +1664,18 @@ protected:
     proof *                   m_undef_proof;
     unsigned                  m_fresh_id;
     bool                      m_debug_ref_count;
+    bool                      m_arena_mode;
+    recursive_mutex *         m_concurrent_mux;
+
+    /**
+       \brief serialize node creation when concurrent mode is enabled.
+    */
+    class concurrent_guard {
+        recursive_mutex * m_mux;
+    public:
+        concurrent_guard(ast_manager const & m): m_mux(m.m_concurrent_mux) { if (m_mux) m_mux->lock(); }
+        ~concurrent_guard() { if (m_mux) m_mux->unlock(); }
+    };
     u_map<unsigned>           m_debug_free_indices;
     std::fstream*             m_trace_stream;
     bool                      m_trace_stream_owner;
@@ -1562,6 +1691,7 @@ protected:
 
     void check_args(func_decl* f, unsigned n, expr* const* es);
 
+    decl_plugin * mk_plugin(family_id fid) const;
 
 public:
     ast_manager(proof_gen_mode = PGM_DISABLED, char const * trace_file = nullptr, bool is_format_manager = false);
@@ -1628,9 +1758,18 @@ public:
 
     void register_plugin(family_id id, decl_plugin * plugin);
 
-    decl_plugin * get_plugin(family_id fid) const;
+    /**
+       \brief Register a plugin that is created by \c f the first time it is retrieved.
+       The family identifier is created immediately.
+    */
+    void register_plugin_factory(symbol const & s, decl_plugin_factory f);
+
+    decl_plugin * get_plugin(family_id fid) const {
+        decl_plugin * p = m_plugins.get(fid, nullptr);
+        return p ? p : mk_plugin(fid);
+    }
 
-    bool has_plugin(family_id fid) const { return get_plugin(fid) != nullptr; }
+    bool has_plugin(family_id fid) const { return m_plugins.get(fid, nullptr) || m_plugin_factories.get(fid, nullptr); }
 
     bool has_plugin(symbol const & s) const { return m_family_manager.has_family(s) && has_plugin(m_family_manager.get_family_id(s)); }
 
@@ -1677,6 +1816,27 @@ public:
 
     void debug_ref_count() { m_debug_ref_count = true; }
 
+    /**
+       \brief In arena mode nodes are not reclaimed when their reference count drops to zero.
+       They remain in the hash-consing table and are released in bulk
+       when the manager is destroyed. This is useful for short-lived managers
+       where reclaiming individual nodes is wasted work.
+    */
+    void enable_arena_mode() { m_arena_mode = true; }
+    bool arena_mode() const { return m_arena_mode; }
+
+    /**
+       \brief Allow terms to be created from several threads at the same time.
+       Allocation, hash-consing and plugin declaration caches are serialized by
+       a manager-wide lock. Concurrent mode implies arena mode: reference counts
+       are not synchronized, so nodes are only released when the manager is destroyed.
+
+       Only term construction is thread-safe. Traversals that use ast marks,
+       such as rewriters and solvers, must still run on separate managers.
+    */
+    void enable_concurrent_mode();
+    bool concurrent_mode() const { return m_concurrent_mux != nullptr; }
+
     void inc_ref(ast* n) {
         if (n) {
             n->inc_ref();
@@ -1686,7 +1846,7 @@ public:
     void dec_ref(ast* n) {
         if (n) {
             n->dec_ref();
-            if (n->get_ref_count() == 0)
+            if (n->get_ref_count() == 0 && !m_arena_mode)
                 delete_node(n);
         }
     }
@@ -1723,11 +1883,15 @@ protected:
 
     void delete_node(ast * n);
 
+    void release_arena();
+
     void * allocate_node(unsigned size) {
+        concurrent_guard _g(*this);
         return m_alloc.allocate(size);
     }
 
     void deallocate_node(ast * n, unsigned sz) {
+        concurrent_guard _g(*this);
         m_alloc.deallocate(sz, n);
     }
 
@@ -2491,6 +2655,9 @@ typedef app_ref_buffer                proof_ref_buffer;
 
 typedef obj_mark<expr> expr_mark;
 
+// marks of traversals that are reset many times
+typedef obj_mark<expr, stamp_vector> expr_stamp_mark;
+
 class expr_sparse_mark {
     obj_hashtable<expr> m_marked;
 public:
@@ -2501,6 +2668,9 @@ public:
     void reset() { m_marked.reset(); }
 };
 
+template<typename Value>
+using expr_dense_map = obj_dense_map<expr, Value>;
+
 template<unsigned IDX>
 class ast_fast_mark {
     ptr_buffer<ast> m_to_unmark;
@@ -2626,8 +2796,8 @@ typedef ast_ref_fast_mark2   expr_ref_fast_mark2;
 */
 class ast_mark {
     struct decl2uint { unsigned operator()(decl const & d) const { return d.get_decl_id(); } };
-    obj_mark<expr>                        m_expr_marks;
-    obj_mark<decl, bit_vector, decl2uint> m_decl_marks;
+    obj_mark<expr, stamp_vector>            m_expr_marks;
+    obj_mark<decl, stamp_vector, decl2uint> m_decl_marks;
 public:
     virtual ~ast_mark() {}
     bool is_marked(ast * n) const;
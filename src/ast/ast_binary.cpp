@@ -0,0 +1,608 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.cpp
+
+Abstract:
+
+    Compact binary serialization of ASTs.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2020-06-02
+
+--*/
+
+#include <cstring>
+#include "util/map.h"
+#include "util/obj_hashtable.h"
+#include "ast/ast_binary.h"
+
+namespace {
+
+    // version 1 of the format.
+    const char s_magic[] = { 'Z', '3', 'B', 1 };
+
+    enum record_kind {
+        R_SORT = 1,
+        R_DECL,
+        R_APP,
+        R_VAR,
+        R_QUANTIFIER,
+        R_ROOTS
+    };
+
+    enum symbol_kind {
+        S_NULL = 0,
+        S_NUM,
+        S_NEW,
+        S_REF  // S_REF + i refers to the i'th string symbol
+    };
+
+    enum sort_size_kind {
+        SZ_FINITE,
+        SZ_VERY_BIG,
+        SZ_INFINITE
+    };
+
+    enum info_flags {
+        F_LEFT_ASSOC  = 1 << 0,
+        F_RIGHT_ASSOC = 1 << 1,
+        F_FLAT_ASSOC  = 1 << 2,
+        F_COMM        = 1 << 3,
+        F_CHAINABLE   = 1 << 4,
+        F_PAIRWISE    = 1 << 5,
+        F_INJECTIVE   = 1 << 6,
+        F_IDEMPOTENT  = 1 << 7,
+        F_SKOLEM      = 1 << 8,
+        F_LAMBDA      = 1 << 9,
+        F_PRIVATE     = 1 << 10
+    };
+
+    class writer {
+        typedef map<symbol, unsigned, symbol_hash_proc, symbol_eq_proc> symbol2id;
+        ast_manager &          m;
+        std::ostream &         m_out;
+        obj_map<ast, unsigned> m_ids;
+        symbol2id              m_symbols;
+        ptr_vector<ast>        m_todo;
+
+        void write_byte(unsigned char c) {
+            m_out.put(static_cast<char>(c));
+        }
+
+        void write_unsigned(uint64_t n) {
+            while (n >= 0x80) {
+                write_byte(static_cast<unsigned char>((n & 0x7f) | 0x80));
+                n >>= 7;
+            }
+            write_byte(static_cast<unsigned char>(n));
+        }
+
+        void write_int(int64_t n) {
+            // zig-zag encoding keeps small negative numbers short.
+            write_unsigned((static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63));
+        }
+
+        void write_string(char const * s, size_t len) {
+            write_unsigned(len);
+            m_out.write(s, len);
+        }
+
+        void write_string(std::string const & s) {
+            write_string(s.c_str(), s.size());
+        }
+
+        void write_symbol(symbol const & s) {
+            if (s.is_null()) {
+                write_unsigned(S_NULL);
+            }
+            else if (s.is_numerical()) {
+                write_unsigned(S_NUM);
+                write_unsigned(s.get_num());
+            }
+            else {
+                unsigned id;
+                if (m_symbols.find(s, id)) {
+                    write_unsigned(S_REF + id);
+                }
+                else {
+                    m_symbols.insert(s, m_symbols.size());
+                    write_unsigned(S_NEW);
+                    write_string(s.bare_str(), strlen(s.bare_str()));
+                }
+            }
+        }
+
+        void write_family(family_id fid) {
+            write_symbol(fid == null_family_id ? symbol::null : m.get_family_name(fid));
+        }
+
+        void write_ref(ast * n) {
+            SASSERT(m_ids.contains(n));
+            write_unsigned(m_ids[n]);
+        }
+
+        void write_parameter(parameter const & p) {
+            write_unsigned(p.get_kind());
+            switch (p.get_kind()) {
+            case parameter::PARAM_INT:
+                write_int(p.get_int());
+                break;
+            case parameter::PARAM_AST:
+                write_ref(p.get_ast());
+                break;
+            case parameter::PARAM_SYMBOL:
+                write_symbol(p.get_symbol());
+                break;
+            case parameter::PARAM_RATIONAL:
+                write_string(p.get_rational().to_string());
+                break;
+            case parameter::PARAM_DOUBLE: {
+                double d = p.get_double();
+                uint64_t bits;
+                static_assert(sizeof(bits) == sizeof(d), "unexpected size of double");
+                memcpy(&bits, &d, sizeof(d));
+                for (unsigned i = 0; i < 8; ++i, bits >>= 8)
+                    write_byte(static_cast<unsigned char>(bits & 0xff));
+                break;
+            }
+            default:
+                throw default_exception("binary serialization does not support plugin specific parameters");
+            }
+        }
+
+        void write_parameters(decl const * d) {
+            write_unsigned(d->get_num_parameters());
+            for (unsigned i = 0; i < d->get_num_parameters(); ++i)
+                write_parameter(d->get_parameter(i));
+        }
+
+        void write_sort(sort * s) {
+            write_unsigned(R_SORT);
+            write_symbol(s->get_name());
+            sort_info * si = s->get_info();
+            if (!si) {
+                write_family(null_family_id);
+                return;
+            }
+            write_family(si->get_family_id());
+            write_unsigned(si->get_decl_kind());
+            sort_size const & sz = si->get_num_elements();
+            if (sz.is_finite()) {
+                write_unsigned(SZ_FINITE);
+                write_unsigned(sz.size());
+            }
+            else {
+                write_unsigned(sz.is_very_big() ? SZ_VERY_BIG : SZ_INFINITE);
+            }
+            write_unsigned(si->private_parameters() ? F_PRIVATE : 0);
+            write_parameters(s);
+        }
+
+        void write_decl(func_decl * f) {
+            write_unsigned(R_DECL);
+            write_symbol(f->get_name());
+            write_unsigned(f->get_arity());
+            for (sort * s : *f)
+                write_ref(s);
+            write_ref(f->get_range());
+            func_decl_info * fi = f->get_info();
+            if (!fi) {
+                write_unsigned(0);
+                return;
+            }
+            write_unsigned(1);
+            write_family(fi->get_family_id());
+            write_unsigned(fi->get_decl_kind());
+            unsigned flags = 0;
+            if (fi->is_left_associative())  flags |= F_LEFT_ASSOC;
+            if (fi->is_right_associative()) flags |= F_RIGHT_ASSOC;
+            if (fi->is_flat_associative())  flags |= F_FLAT_ASSOC;
+            if (fi->is_commutative())       flags |= F_COMM;
+            if (fi->is_chainable())         flags |= F_CHAINABLE;
+            if (fi->is_pairwise())          flags |= F_PAIRWISE;
+            if (fi->is_injective())         flags |= F_INJECTIVE;
+            if (fi->is_idempotent())        flags |= F_IDEMPOTENT;
+            if (fi->is_skolem())            flags |= F_SKOLEM;
+            if (fi->is_lambda())            flags |= F_LAMBDA;
+            write_unsigned(flags);
+            write_parameters(f);
+        }
+
+        void write_app(app * a) {
+            write_unsigned(R_APP);
+            write_ref(a->get_decl());
+            write_unsigned(a->get_num_args());
+            for (expr * arg : *a)
+                write_ref(arg);
+        }
+
+        void write_var(var * v) {
+            write_unsigned(R_VAR);
+            write_unsigned(v->get_idx());
+            write_ref(v->get_sort());
+        }
+
+        void write_quantifier(quantifier * q) {
+            write_unsigned(R_QUANTIFIER);
+            write_unsigned(q->get_kind());
+            write_int(q->get_weight());
+            write_symbol(q->get_qid());
+            write_symbol(q->get_skid());
+            write_unsigned(q->get_num_decls());
+            for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+                write_symbol(q->get_decl_name(i));
+                write_ref(q->get_decl_sort(i));
+            }
+            write_ref(q->get_expr());
+            write_unsigned(q->get_num_patterns());
+            for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                write_ref(q->get_pattern(i));
+            write_unsigned(q->get_num_no_patterns());
+            for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                write_ref(q->get_no_pattern(i));
+        }
+
+        void visit(ast * n) {
+            if (!m_ids.contains(n))
+                m_todo.push_back(n);
+        }
+
+        void visit_parameters(decl * d) {
+            for (unsigned i = 0; i < d->get_num_parameters(); ++i)
+                if (d->get_parameter(i).is_ast())
+                    visit(d->get_parameter(i).get_ast());
+        }
+
+        void push_children(ast * n) {
+            switch (n->get_kind()) {
+            case AST_SORT:
+                visit_parameters(to_sort(n));
+                break;
+            case AST_FUNC_DECL: {
+                func_decl * f = to_func_decl(n);
+                visit_parameters(f);
+                for (sort * s : *f)
+                    visit(s);
+                visit(f->get_range());
+                break;
+            }
+            case AST_APP: {
+                app * a = to_app(n);
+                visit(a->get_decl());
+                for (expr * arg : *a)
+                    visit(arg);
+                break;
+            }
+            case AST_VAR:
+                visit(to_var(n)->get_sort());
+                break;
+            case AST_QUANTIFIER: {
+                quantifier * q = to_quantifier(n);
+                for (unsigned i = 0; i < q->get_num_decls(); ++i)
+                    visit(q->get_decl_sort(i));
+                visit(q->get_expr());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    visit(q->get_pattern(i));
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    visit(q->get_no_pattern(i));
+                break;
+            }
+            }
+        }
+
+        void write_node(ast * n) {
+            switch (n->get_kind()) {
+            case AST_SORT:       write_sort(to_sort(n)); break;
+            case AST_FUNC_DECL:  write_decl(to_func_decl(n)); break;
+            case AST_APP:        write_app(to_app(n)); break;
+            case AST_VAR:        write_var(to_var(n)); break;
+            case AST_QUANTIFIER: write_quantifier(to_quantifier(n)); break;
+            }
+            m_ids.insert(n, m_ids.size());
+        }
+
+        void process(ast * root) {
+            visit(root);
+            while (!m_todo.empty()) {
+                ast * n = m_todo.back();
+                if (m_ids.contains(n)) {
+                    m_todo.pop_back();
+                    continue;
+                }
+                unsigned sz = m_todo.size();
+                push_children(n);
+                if (sz == m_todo.size()) {
+                    m_todo.pop_back();
+                    write_node(n);
+                }
+            }
+        }
+
+    public:
+        writer(std::ostream & out, ast_manager & m): m(m), m_out(out) {}
+
+        void operator()(unsigned num_roots, ast * const * roots) {
+            m_out.write(s_magic, sizeof(s_magic));
+            for (unsigned i = 0; i < num_roots; ++i)
+                process(roots[i]);
+            write_unsigned(R_ROOTS);
+            write_unsigned(num_roots);
+            for (unsigned i = 0; i < num_roots; ++i)
+                write_ref(roots[i]);
+        }
+    };
+
+    class reader {
+        ast_manager &    m;
+        std::istream &   m_in;
+        ast_ref_vector   m_nodes;
+        svector<symbol>  m_symbols;
+        family_id        m_user_sort_fid;
+
+        void error(char const * msg) {
+            throw default_exception(std::string("invalid binary AST input: ") + msg);
+        }
+
+        unsigned char read_byte() {
+            int c = m_in.get();
+            if (c == EOF)
+                error("unexpected end of input");
+            return static_cast<unsigned char>(c);
+        }
+
+        uint64_t read_u64() {
+            uint64_t r = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                unsigned char c = read_byte();
+                r |= static_cast<uint64_t>(c & 0x7f) << shift;
+                if (!(c & 0x80))
+                    return r;
+            }
+            error("number too large");
+            return 0;
+        }
+
+        unsigned read_unsigned() {
+            uint64_t r = read_u64();
+            if (r > UINT_MAX)
+                error("number too large");
+            return static_cast<unsigned>(r);
+        }
+
+        int read_int() {
+            uint64_t r = read_u64();
+            int64_t v = static_cast<int64_t>(r >> 1) ^ -static_cast<int64_t>(r & 1);
+            if (v < INT_MIN || v > INT_MAX)
+                error("number too large");
+            return static_cast<int>(v);
+        }
+
+        std::string read_string() {
+            unsigned len = read_unsigned();
+            std::string s(len, ' ');
+            if (len > 0 && !m_in.read(&s[0], len))
+                error("unexpected end of input");
+            return s;
+        }
+
+        symbol read_symbol() {
+            unsigned k = read_unsigned();
+            switch (k) {
+            case S_NULL:
+                return symbol::null;
+            case S_NUM:
+                return symbol(read_unsigned());
+            case S_NEW: {
+                symbol s(read_string().c_str());
+                m_symbols.push_back(s);
+                return s;
+            }
+            default:
+                if (k - S_REF >= m_symbols.size())
+                    error("invalid symbol reference");
+                return m_symbols[k - S_REF];
+            }
+        }
+
+        family_id read_family() {
+            symbol name = read_symbol();
+            if (name.is_null())
+                return null_family_id;
+            family_id fid = m.get_family_id(name);
+            if (fid == null_family_id)
+                error("unknown theory");
+            return fid;
+        }
+
+        ast * read_ast() {
+            unsigned id = read_unsigned();
+            if (id >= m_nodes.size())
+                error("invalid node reference");
+            return m_nodes.get(id);
+        }
+
+        sort * read_sort_ref() {
+            ast * n = read_ast();
+            if (!is_sort(n))
+                error("sort expected");
+            return to_sort(n);
+        }
+
+        expr * read_expr_ref() {
+            ast * n = read_ast();
+            if (!is_expr(n))
+                error("expression expected");
+            return to_expr(n);
+        }
+
+        parameter read_parameter() {
+            switch (read_unsigned()) {
+            case parameter::PARAM_INT:
+                return parameter(read_int());
+            case parameter::PARAM_AST:
+                return parameter(read_ast());
+            case parameter::PARAM_SYMBOL:
+                return parameter(read_symbol());
+            case parameter::PARAM_RATIONAL:
+                return parameter(rational(read_string().c_str()));
+            case parameter::PARAM_DOUBLE: {
+                uint64_t bits = 0;
+                for (unsigned i = 0; i < 8; ++i)
+                    bits |= static_cast<uint64_t>(read_byte()) << (8*i);
+                double d;
+                memcpy(&d, &bits, sizeof(d));
+                return parameter(d);
+            }
+            default:
+                error("invalid parameter");
+                return parameter();
+            }
+        }
+
+        void read_parameters(vector<parameter> & ps) {
+            unsigned n = read_unsigned();
+            for (unsigned i = 0; i < n; ++i)
+                ps.push_back(read_parameter());
+        }
+
+        sort * read_sort() {
+            symbol name = read_symbol();
+            family_id fid = read_family();
+            if (fid == null_family_id)
+                return m.mk_uninterpreted_sort(name);
+            decl_kind k = read_unsigned();
+            sort_size sz;
+            switch (read_unsigned()) {
+            case SZ_FINITE:   sz = sort_size::mk_finite(read_u64()); break;
+            case SZ_VERY_BIG: sz = sort_size::mk_very_big(); break;
+            case SZ_INFINITE: sz = sort_size::mk_infinite(); break;
+            default: error("invalid sort size");
+            }
+            unsigned flags = read_unsigned();
+            vector<parameter> ps;
+            read_parameters(ps);
+            if (fid == m_user_sort_fid) {
+                // user sort kinds are local to the manager.
+                return m.mk_uninterpreted_sort(name, ps.size(), ps.c_ptr());
+            }
+            return m.mk_sort(name, sort_info(fid, k, sz, ps.size(), ps.c_ptr(), (flags & F_PRIVATE) != 0));
+        }
+
+        func_decl * read_decl() {
+            symbol name = read_symbol();
+            unsigned arity = read_unsigned();
+            ptr_buffer<sort> domain;
+            for (unsigned i = 0; i < arity; ++i)
+                domain.push_back(read_sort_ref());
+            sort * range = read_sort_ref();
+            if (read_unsigned() == 0)
+                return m.mk_func_decl(name, arity, domain.c_ptr(), range);
+            family_id fid = read_family();
+            decl_kind k = read_unsigned();
+            unsigned flags = read_unsigned();
+            vector<parameter> ps;
+            read_parameters(ps);
+            func_decl_info info(fid, k, ps.size(), ps.c_ptr());
+            info.set_left_associative((flags & F_LEFT_ASSOC) != 0);
+            info.set_right_associative((flags & F_RIGHT_ASSOC) != 0);
+            info.set_flat_associative((flags & F_FLAT_ASSOC) != 0);
+            info.set_commutative((flags & F_COMM) != 0);
+            info.set_chainable((flags & F_CHAINABLE) != 0);
+            info.set_pairwise((flags & F_PAIRWISE) != 0);
+            info.set_injective((flags & F_INJECTIVE) != 0);
+            info.set_idempotent((flags & F_IDEMPOTENT) != 0);
+            info.set_skolem((flags & F_SKOLEM) != 0);
+            info.set_lambda((flags & F_LAMBDA) != 0);
+            return m.mk_func_decl(name, arity, domain.c_ptr(), range, info);
+        }
+
+        app * read_app() {
+            ast * d = read_ast();
+            if (!is_func_decl(d))
+                error("declaration expected");
+            unsigned n = read_unsigned();
+            ptr_buffer<expr> args;
+            for (unsigned i = 0; i < n; ++i)
+                args.push_back(read_expr_ref());
+            return m.mk_app(to_func_decl(d), n, args.c_ptr());
+        }
+
+        var * read_var() {
+            unsigned idx = read_unsigned();
+            return m.mk_var(idx, read_sort_ref());
+        }
+
+        void read_exprs(ptr_buffer<expr> & es) {
+            unsigned n = read_unsigned();
+            for (unsigned i = 0; i < n; ++i)
+                es.push_back(read_expr_ref());
+        }
+
+        quantifier * read_quantifier() {
+            unsigned k = read_unsigned();
+            if (k != forall_k && k != exists_k && k != lambda_k)
+                error("invalid quantifier kind");
+            int weight = read_int();
+            symbol qid = read_symbol();
+            symbol skid = read_symbol();
+            unsigned n = read_unsigned();
+            buffer<symbol> names;
+            ptr_buffer<sort> sorts;
+            for (unsigned i = 0; i < n; ++i) {
+                names.push_back(read_symbol());
+                sorts.push_back(read_sort_ref());
+            }
+            expr * body = read_expr_ref();
+            ptr_buffer<expr> patterns, no_patterns;
+            read_exprs(patterns);
+            read_exprs(no_patterns);
+            if (k == lambda_k)
+                return m.mk_lambda(n, sorts.c_ptr(), names.c_ptr(), body);
+            return m.mk_quantifier(static_cast<quantifier_kind>(k), n, sorts.c_ptr(), names.c_ptr(), body,
+                                   weight, qid, skid,
+                                   patterns.size(), patterns.c_ptr(),
+                                   no_patterns.size(), no_patterns.c_ptr());
+        }
+
+    public:
+        reader(std::istream & in, ast_manager & m):
+            m(m), m_in(in), m_nodes(m), m_user_sort_fid(m.get_user_sort_family_id()) {}
+
+        void operator()(ast_ref_vector & result) {
+            char magic[sizeof(s_magic)];
+            if (!m_in.read(magic, sizeof(magic)) || memcmp(magic, s_magic, sizeof(magic)) != 0)
+                error("bad header");
+            while (true) {
+                switch (read_unsigned()) {
+                case R_SORT:       m_nodes.push_back(read_sort()); break;
+                case R_DECL:       m_nodes.push_back(read_decl()); break;
+                case R_APP:        m_nodes.push_back(read_app()); break;
+                case R_VAR:        m_nodes.push_back(read_var()); break;
+                case R_QUANTIFIER: m_nodes.push_back(read_quantifier()); break;
+                case R_ROOTS: {
+                    unsigned n = read_unsigned();
+                    for (unsigned i = 0; i < n; ++i)
+                        result.push_back(read_ast());
+                    return;
+                }
+                default:
+                    error("invalid record");
+                }
+            }
+        }
+    };
+}
+
+void ast_to_binary(std::ostream & out, ast_manager & m, unsigned num_roots, ast * const * roots) {
+    writer w(out, m);
+    w(num_roots, roots);
+}
+
+void binary_to_ast(std::istream & in, ast_manager & m, ast_ref_vector & result) {
+    reader r(in, m);
+    r(result);
+}
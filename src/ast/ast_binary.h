@@ -0,0 +1,52 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.h
+
+Abstract:
+
+    Compact binary serialization of ASTs.
+
+    The format is a DAG: every sort, declaration and term is written
+    once, after its children, and later occurrences refer to it by
+    index. Integers are written as variable length (LEB128) numbers
+    and symbols are written once and then referenced by index.
+
+    Theory declarations are reconstructed from their family name, kind
+    and parameters, in the same way as ast_translation. Datatype
+    definitions are not part of the format: a manager reading datatype
+    terms must already contain the definitions. Plugin specific
+    (PARAM_EXTERNAL) parameters, such as floating point numerals and
+    irrational algebraic numbers, are not supported.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2020-06-02
+
+--*/
+#ifndef AST_BINARY_H_
+#define AST_BINARY_H_
+
+#include <iostream>
+#include "ast/ast.h"
+
+/**
+   \brief Write the DAG rooted at \c roots to \c out.
+   Throws default_exception if a node cannot be serialized.
+*/
+void ast_to_binary(std::ostream & out, ast_manager & m, unsigned num_roots, ast * const * roots);
+
+inline void ast_to_binary(std::ostream & out, ast_manager & m, ast_ref_vector const & roots) {
+    ast_to_binary(out, m, roots.size(), roots.c_ptr());
+}
+
+/**
+   \brief Read roots previously written using ast_to_binary and
+   append them to \c result.
+   Throws default_exception on malformed input.
+*/
+void binary_to_ast(std::istream & in, ast_manager & m, ast_ref_vector & result);
+
+#endif /* AST_BINARY_H_ */
@@ -0,0 +1,197 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    expr_fold.h
+
+Abstract:
+
+    Bottom-up evaluation of expression DAGs.
+
+    Proc computes the value of an expression from the values of its
+    children:
+
+        T operator()(expr * e, unsigned num_children, T const * children);
+
+    The children of an application are its arguments and the children
+    of a quantifier are its body followed by its patterns and
+    no-patterns (only the body if IgnorePatterns holds). Values are
+    memoized by expression id until reset(), so shared subterms are
+    evaluated once. The traversal uses an explicit stack and does not
+    depend on the depth of the expression.
+
+    fold_parallel evaluates the expressions of the same height
+    concurrently. It is only sound for functors that do not create
+    expressions, update reference counts or throw exceptions.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/thread_pool.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EXPR_FOLD_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define EXPR_FOLD_PREFETCH(p) ((void)0)
+#endif
+
+template<typename T, typename Proc, bool IgnorePatterns = false>
+class expr_fold {
+    Proc&                    m_proc;
+    expr_dense_map<T>        m_cache;
+    svector<std::pair<expr*, unsigned>> m_todo;
+    vector<T>                m_values;
+
+    static unsigned num_children(expr * e) {
+        switch (e->get_kind()) {
+        case AST_APP:
+            return to_app(e)->get_num_args();
+        case AST_QUANTIFIER:
+            return IgnorePatterns ? 1 : to_quantifier(e)->get_num_children();
+        default:
+            return 0;
+        }
+    }
+
+    static expr * get_child(expr * e, unsigned i) {
+        return is_app(e) ? to_app(e)->get_arg(i) : to_quantifier(e)->get_child(i);
+    }
+
+    void process(expr * e) {
+        unsigned n = num_children(e);
+        m_values.reset();
+        for (unsigned i = 0; i < n; ++i)
+            m_values.push_back(m_cache.find(get_child(e, i)));
+        T r = m_proc(e, n, m_values.c_ptr());
+        m_cache.insert(e, r);
+    }
+
+    /**
+       \brief push the children of e that are not cached. Return true if there are none.
+    */
+    bool visit_children(expr * e, unsigned& i) {
+        unsigned n = num_children(e);
+        for (; i < n; ++i) {
+            expr * c = get_child(e, i);
+            if (i + 1 < n)
+                EXPR_FOLD_PREFETCH(get_child(e, i + 1));
+            if (!m_cache.contains(c)) {
+                ++i;
+                m_todo.push_back(std::make_pair(c, 0u));
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    expr_fold(Proc& p): m_proc(p) {}
+
+    T operator()(expr * e) {
+        if (m_cache.contains(e))
+            return m_cache.find(e);
+        m_todo.push_back(std::make_pair(e, 0u));
+        while (!m_todo.empty()) {
+            unsigned sz = m_todo.size();
+            expr * curr = m_todo.back().first;
+            unsigned i = m_todo.back().second;
+            bool done = m_cache.contains(curr) || visit_children(curr, i);
+            m_todo[sz - 1].second = i;
+            if (!done)
+                continue;
+            if (!m_cache.contains(curr))
+                process(curr);
+            m_todo.pop_back();
+        }
+        return m_cache.find(e);
+    }
+
+    /**
+       \brief evaluate es[0], ..., es[n-1] using up to num_threads threads.
+       Heights with few expressions are evaluated sequentially.
+    */
+    void fold_parallel(unsigned n, expr * const * es, vector<T>& result, unsigned num_threads) {
+        static const unsigned MIN_LEVEL_SIZE = 1024;
+        // order the expressions that are not cached by height
+        ptr_vector<expr> nodes;
+        unsigned_vector heights;
+        expr_dense_map<unsigned> pos;
+        for (unsigned j = 0; j < n; ++j) {
+            if (m_cache.contains(es[j]) || pos.contains(es[j]))
+                continue;
+            m_todo.push_back(std::make_pair(es[j], 0u));
+            while (!m_todo.empty()) {
+                expr * curr = m_todo.back().first;
+                unsigned i = m_todo.back().second;
+                unsigned nc = num_children(curr);
+                bool pushed = false;
+                for (; i < nc && !pushed; ++i) {
+                    expr * c = get_child(curr, i);
+                    if (!m_cache.contains(c) && !pos.contains(c)) {
+                        m_todo.back().second = i + 1;
+                        m_todo.push_back(std::make_pair(c, 0u));
+                        pushed = true;
+                    }
+                }
+                if (pushed)
+                    continue;
+                m_todo.pop_back();
+                if (pos.contains(curr))
+                    continue;
+                unsigned h = 0;
+                for (unsigned k = 0; k < nc; ++k) {
+                    unsigned const* p = pos.find_core(get_child(curr, k));
+                    if (p)
+                        h = std::max(h, heights[*p] + 1);
+                }
+                pos.insert(curr, nodes.size());
+                nodes.push_back(curr);
+                heights.push_back(h);
+            }
+        }
+        unsigned max_h = 0;
+        for (unsigned h : heights)
+            max_h = std::max(max_h, h);
+        vector<ptr_vector<expr>> levels(nodes.empty() ? 0 : max_h + 1);
+        for (unsigned i = 0; i < nodes.size(); ++i)
+            levels[heights[i]].push_back(nodes[i]);
+
+        vector<T> values(nodes.size());
+        auto eval = [&](expr * e, vector<T>& args) {
+            unsigned nc = num_children(e);
+            args.reset();
+            for (unsigned k = 0; k < nc; ++k) {
+                expr * c = get_child(e, k);
+                unsigned const* p = pos.find_core(c);
+                args.push_back(p ? values[*p] : m_cache.find(c));
+            }
+            values[pos.find(e)] = m_proc(e, nc, args.c_ptr());
+        };
+        for (ptr_vector<expr> const& level : levels) {
+            unsigned k = std::min(num_threads, level.size() / MIN_LEVEL_SIZE);
+            if (k <= 1) {
+                for (expr * e : level)
+                    eval(e, m_values);
+                continue;
+            }
+            thread_pool::run(k, [&](unsigned t) {
+                vector<T> args;
+                for (unsigned i = t; i < level.size(); i += k)
+                    eval(level[i], args);
+            });
+        }
+        for (unsigned i = 0; i < nodes.size(); ++i)
+            m_cache.insert(nodes[i], values[i]);
+        result.reset();
+        for (unsigned j = 0; j < n; ++j)
+            result.push_back(m_cache.find(es[j]));
+    }
+
+    bool is_cached(expr * e) const { return m_cache.contains(e); }
+
+    void reset() { m_cache.reset(); m_todo.reset(); }
+
+    void finalize() { m_cache.finalize(); m_todo.finalize(); m_values.finalize(); }
+};
@@ -122,6 +122,11 @@ void for_each_expr(ForEachProc & proc, expr_mark & visited, expr * n) {
     for_each_expr_core<ForEachProc, expr_mark, true, false>(proc, visited, n);
 }
 
+template<typename ForEachProc>
+void for_each_expr(ForEachProc & proc, expr_stamp_mark & visited, expr * n) {
+    for_each_expr_core<ForEachProc, expr_stamp_mark, true, false>(proc, visited, n);
+}
+
 template<typename ForEachProc>
 void for_each_expr(ForEachProc & proc, expr * n) {
     expr_mark visited;
@@ -40,6 +40,7 @@ fpa2bv_converter::fpa2bv_converter(ast_manager & m) :
     m_mpf_manager(m_util.fm()),
     m_mpz_manager(m_mpf_manager.mpz_manager()),
     m_hi_fp_unspecified(true),
+    m_cache_pinned(m),
     m_extra_assertions(m) {
     m_plugin = static_cast<fpa_decl_plugin*>(m.get_plugin(m.mk_family_id("fpa")));
 }
@@ -3685,7 +3686,34 @@ void fpa2bv_converter::mk_unbias(expr * e, expr_ref & result) {
     result = m_bv_util.mk_concat(n_leading, rest);
 }
 
+/**
+   \brief unpack e into sign, significand, unbiased exponent and leading zeros.
+   The result only depends on e and normalize and is shared by all
+   operations over e.
+*/
 void fpa2bv_converter::unpack(expr * e, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & lz, bool normalize) {
+    unpacked u;
+    if (m_unpack_cache[normalize].find(e, u)) {
+        sgn = u.m_sgn;
+        sig = u.m_sig;
+        exp = u.m_exp;
+        lz  = u.m_lz;
+        return;
+    }
+    unpack_core(e, sgn, sig, exp, lz, normalize);
+    u.m_sgn = sgn;
+    u.m_sig = sig;
+    u.m_exp = exp;
+    u.m_lz  = lz;
+    m_cache_pinned.push_back(e);
+    m_cache_pinned.push_back(sgn);
+    m_cache_pinned.push_back(sig);
+    m_cache_pinned.push_back(exp);
+    m_cache_pinned.push_back(lz);
+    m_unpack_cache[normalize].insert(e, u);
+}
+
+void fpa2bv_converter::unpack_core(expr * e, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & lz, bool normalize) {
     SASSERT(m_util.is_fp(e));
     SASSERT(to_app(e)->get_num_args() == 3);
 
@@ -3883,7 +3911,29 @@ expr_ref fpa2bv_converter::mk_rounding_decision(expr * rm, expr * sgn, expr * la
     return res;
 }
 
+/**
+   \brief round (sgn, sig, exp) to the format s. Operations that produce the
+   same unrounded result with the same rounding mode share the rounding circuit.
+*/
 void fpa2bv_converter::round(sort * s, expr_ref & rm, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & result) {
+    round_key k = { s, rm, sgn, sig, exp };
+    expr * r = nullptr;
+    if (m_round_cache.find(k, r)) {
+        result = r;
+        return;
+    }
+    m_cache_pinned.push_back(s);
+    m_cache_pinned.push_back(rm);
+    m_cache_pinned.push_back(sgn);
+    m_cache_pinned.push_back(sig);
+    m_cache_pinned.push_back(exp);
+    expr_ref rm1(rm), sgn1(sgn), sig1(sig), exp1(exp);
+    round_core(s, rm1, sgn1, sig1, exp1, result);
+    m_cache_pinned.push_back(result);
+    m_round_cache.insert(k, result);
+}
+
+void fpa2bv_converter::round_core(sort * s, expr_ref & rm, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & result) {
     unsigned ebits = m_util.get_ebits(s);
     unsigned sbits = m_util.get_sbits(s);
 
@@ -4209,6 +4259,10 @@ void fpa2bv_converter::reset() {
     }
     m_uf2bvuf.reset();
     m_min_max_ufs.reset();
+    m_unpack_cache[0].reset();
+    m_unpack_cache[1].reset();
+    m_round_cache.reset();
+    m_cache_pinned.reset();
     m_extra_assertions.reset();
 }
 
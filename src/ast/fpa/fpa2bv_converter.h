@@ -21,6 +21,7 @@ Notes:
 
 #include "ast/ast.h"
 #include "util/obj_hashtable.h"
+#include "util/map.h"
 #include "util/ref_util.h"
 #include "ast/fpa_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -55,6 +56,26 @@ protected:
     uf2bvuf_t                  m_uf2bvuf;
     special_t                  m_min_max_ufs;
 
+    // sub-circuits shared between operations over the same operands
+    struct unpacked {
+        expr * m_sgn, * m_sig, * m_exp, * m_lz;
+    };
+    struct round_key {
+        sort * m_sort;
+        expr * m_rm, * m_sgn, * m_sig, * m_exp;
+        bool operator==(round_key const & o) const {
+            return m_sort == o.m_sort && m_rm == o.m_rm && m_sgn == o.m_sgn && m_sig == o.m_sig && m_exp == o.m_exp;
+        }
+    };
+    struct round_key_hash {
+        unsigned operator()(round_key const & k) const {
+            return mk_mix(mk_mix(k.m_sort->get_id(), k.m_rm->get_id(), k.m_sgn->get_id()), k.m_sig->get_id(), k.m_exp->get_id());
+        }
+    };
+    obj_map<expr, unpacked>    m_unpack_cache[2];
+    map<round_key, expr*, round_key_hash, default_eq<round_key> > m_round_cache;
+    ast_ref_vector             m_cache_pinned;
+
     friend class fpa2bv_model_converter;
     friend class bv2fpa_converter;
 
@@ -99,12 +120,12 @@ public:
     void mk_add(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_sub(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_neg(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
-    void mk_mul(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
-    void mk_div(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
-    void mk_rem(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+    virtual void mk_mul(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+    virtual void mk_div(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+    virtual void mk_rem(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_abs(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
-    void mk_fma(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
-    void mk_sqrt(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+    virtual void mk_fma(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+    virtual void mk_sqrt(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_round_to_integral(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_abs(sort * s, expr_ref & x, expr_ref & result);
 
@@ -188,7 +209,9 @@ protected:
     void mk_unbias(expr * e, expr_ref & result);
 
     void unpack(expr * e, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & lz, bool normalize);
+    void unpack_core(expr * e, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & lz, bool normalize);
     void round(sort * s, expr_ref & rm, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & result);
+    void round_core(sort * s, expr_ref & rm, expr_ref & sgn, expr_ref & sig, expr_ref & exp, expr_ref & result);
     expr_ref mk_rounding_decision(expr * rm, expr * sgn, expr * last, expr * round, expr * sticky);
 
     void add_core(unsigned sbits, unsigned ebits,
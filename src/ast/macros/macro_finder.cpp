@@ -272,7 +272,16 @@ macro_finder::macro_finder(ast_manager & m, macro_manager & mm):
 macro_finder::~macro_finder() {
 }
 
-bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const& deps,  expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps) {
+/**
+   \brief A formula that was expanded and tested in the previous round can only
+   change if it contains the head of a macro found in that round.
+*/
+bool macro_finder::is_checked(bool_vector const& checked, unsigned i, expr * e) {
+    return i < checked.size() && checked[i] && !m_new_heads(e);
+}
+
+bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const& deps, bool_vector const& checked,
+                                 expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps, bool_vector& new_checked) {
     TRACE("macro_finder", tout << "starting expand_macros:\n";
           m_macro_manager.display(tout););
     bool found_new_macro = false;
@@ -283,6 +292,15 @@ bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector
         expr * n       = exprs[i];
         proof * pr     = m.proofs_enabled() ? prs[i] : nullptr;
         expr_dependency * dep = deps.get(i, nullptr);
+        if (is_checked(checked, i, n)) {
+            new_exprs.push_back(n);
+            if (m.proofs_enabled())
+                new_prs.push_back(pr);
+            if (deps_valid)
+                new_deps.push_back(dep);
+            new_checked.push_back(true);
+            continue;
+        }
         expr_ref new_n(m), def(m);
         proof_ref new_pr(m);
         expr_dependency_ref new_dep(m);
@@ -307,7 +325,10 @@ bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector
                 new_prs.push_back(new_pr);
             if (deps_valid)
                 new_deps.push_back(new_dep);
+            new_checked.push_back(true);
         }
+        // formulas introduced for arithmetic and pseudo-macros are tested in the next round.
+        new_checked.resize(new_exprs.size(), false);
         SASSERT(exprs.size() != deps.size() || new_exprs.size() == new_deps.size());
         // SASSERT(!m.proofs_enabled() || new_exprs.size() == new_prs.size());
 
@@ -320,23 +341,31 @@ void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector con
     expr_ref_vector   _new_exprs(m);
     proof_ref_vector  _new_prs(m);
     expr_dependency_ref_vector _new_deps(m);
+    bool_vector _new_checked;
     unsigned num = exprs.size();
-    if (expand_macros(exprs, prs, deps, _new_exprs, _new_prs, _new_deps)) {
+    unsigned num_macros = m_macro_manager.get_num_macros();
+    m_new_heads.reset();
+    if (expand_macros(exprs, prs, deps, bool_vector(), _new_exprs, _new_prs, _new_deps, _new_checked)) {
         for (unsigned i = 0; i < num; ++i) {
             expr_ref_vector  old_exprs(m);
             proof_ref_vector old_prs(m);
             expr_dependency_ref_vector old_deps(m);
+            bool_vector old_checked;
             _new_exprs.swap(old_exprs);
             _new_prs.swap(old_prs);
             _new_deps.swap(old_deps);
+            _new_checked.swap(old_checked);
             SASSERT(_new_exprs.empty());
             SASSERT(_new_prs.empty());
             SASSERT(_new_deps.empty());
-            if (!expand_macros(old_exprs, old_prs, old_deps,
-                               _new_exprs, _new_prs, _new_deps))
+            m_new_heads.set_heads(m_macro_manager, num_macros);
+            num_macros = m_macro_manager.get_num_macros();
+            if (!expand_macros(old_exprs, old_prs, old_deps, old_checked,
+                               _new_exprs, _new_prs, _new_deps, _new_checked))
                 break;
         }
     }
+    m_new_heads.reset();
     new_exprs.append(_new_exprs);
     new_prs.append(_new_prs);
     new_deps.append(_new_deps);
@@ -344,13 +373,19 @@ void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector con
 
 
 
-bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vector<justified_expr>& new_fmls) {
+bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, bool_vector const& checked,
+                                 vector<justified_expr>& new_fmls, bool_vector& new_checked) {
     TRACE("macro_finder", tout << "starting expand_macros:\n";
           m_macro_manager.display(tout););
     bool found_new_macro = false;
     for (unsigned i = 0; i < num; i++) {
         expr * n       = fmls[i].get_fml();
         proof * pr     = m.proofs_enabled() ? fmls[i].get_proof() : nullptr;
+        if (is_checked(checked, i, n)) {
+            new_fmls.push_back(fmls[i]);
+            new_checked.push_back(true);
+            continue;
+        }
         expr_ref new_n(m), def(m);
         proof_ref new_pr(m);
         expr_dependency_ref new_dep(m);
@@ -371,7 +406,9 @@ bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vect
         }
         else {
             new_fmls.push_back(justified_expr(m, new_n, new_pr));
+            new_checked.push_back(true);
         }
+        new_checked.resize(new_fmls.size(), false);
     }
     return found_new_macro;
 }
@@ -379,15 +416,23 @@ bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vect
 void macro_finder::operator()(unsigned n, justified_expr const* fmls, vector<justified_expr>& new_fmls) {
     TRACE("macro_finder", tout << "processing macros...\n";);
     vector<justified_expr> _new_fmls;
-    if (expand_macros(n, fmls, _new_fmls)) {
+    bool_vector _new_checked;
+    unsigned num_macros = m_macro_manager.get_num_macros();
+    m_new_heads.reset();
+    if (expand_macros(n, fmls, bool_vector(), _new_fmls, _new_checked)) {
         while (true) {
             vector<justified_expr> old_fmls;
+            bool_vector old_checked;
             _new_fmls.swap(old_fmls);
+            _new_checked.swap(old_checked);
             SASSERT(_new_fmls.empty());
-            if (!expand_macros(old_fmls.size(), old_fmls.c_ptr(), _new_fmls))
+            m_new_heads.set_heads(m_macro_manager, num_macros);
+            num_macros = m_macro_manager.get_num_macros();
+            if (!expand_macros(old_fmls.size(), old_fmls.c_ptr(), old_checked, _new_fmls, _new_checked))
                 break;
         }
     }
+    m_new_heads.reset();
     new_fmls.append(_new_fmls);
 }
 
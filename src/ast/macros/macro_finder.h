@@ -31,9 +31,16 @@ class macro_finder {
     macro_manager &             m_macro_manager;
     macro_util &                m_util;
     arith_util                  m_autil;
+    macro_head_finder           m_new_heads; // heads of the macros found in the previous round
+
+    // checked[i] is true if exprs[i] was expanded and tested for macros in the previous round.
+    bool is_checked(bool_vector const& checked, unsigned i, expr * e);
     bool expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const & deps, 
-                       expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector& new_deps);
-    bool expand_macros(unsigned n, justified_expr const * fmls, vector<justified_expr>& new_fmls);
+                       bool_vector const& checked,
+                       expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector& new_deps,
+                       bool_vector& new_checked);
+    bool expand_macros(unsigned n, justified_expr const * fmls, bool_vector const& checked,
+                       vector<justified_expr>& new_fmls, bool_vector& new_checked);
     bool is_arith_macro(expr * n, proof * pr, expr_ref_vector & new_exprs, proof_ref_vector & new_prs);
     bool is_arith_macro(expr * n, proof * pr, vector<justified_expr>& new_fmls);
     bool is_arith_macro(expr * n, proof * pr, bool deps_valid, expr_dependency * dep, expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps);
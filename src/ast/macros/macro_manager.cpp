@@ -120,7 +120,7 @@ bool macro_manager::insert(func_decl * f, quantifier * q, proof * pr, expr_depen
     TRACE("macro_insert", tout << "trying to create macro: " << f->get_name() << "\n" << mk_pp(q, m) << "\n";);
 
     // if we already have a macro for f then return false;
-    if (m_decls.contains(f)) {
+    if (m_decl2macro.contains(f)) {
         TRACE("macro_insert", tout << "we already have a macro for: " << f->get_name() << "\n";);
         return false;
     }
@@ -393,3 +393,51 @@ void macro_manager::expand_macros(expr * n, proof * pr, expr_dependency * dep, e
     SASSERT(!dep || new_dep);
 }
 
+void macro_head_finder::set_heads(macro_manager const & mm, unsigned first) {
+    reset();
+    for (unsigned i = first; i < mm.get_num_macros(); ++i)
+        m_heads.insert(mm.get_macro_func_decl(i));
+}
+
+bool macro_head_finder::visit(expr * e, bool & occ) {
+    if (!m_visited.is_marked(e)) {
+        m_todo.push_back(e);
+        return false;
+    }
+    occ |= m_occurs.is_marked(e);
+    return true;
+}
+
+bool macro_head_finder::operator()(expr * e) {
+    if (m_heads.empty())
+        return false;
+    m_todo.push_back(e);
+    while (!m_todo.empty()) {
+        expr * t = m_todo.back();
+        if (m_visited.is_marked(t)) {
+            m_todo.pop_back();
+            continue;
+        }
+        bool occ = false, visited = true;
+        if (is_app(t)) {
+            occ = m_heads.contains(to_app(t)->get_decl());
+            for (expr * arg : *to_app(t))
+                visited &= visit(arg, occ);
+        }
+        else if (is_quantifier(t)) {
+            quantifier * q = to_quantifier(t);
+            visited &= visit(q->get_expr(), occ);
+            for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                visited &= visit(q->get_pattern(i), occ);
+            for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                visited &= visit(q->get_no_pattern(i), occ);
+        }
+        if (!visited)
+            continue;
+        m_todo.pop_back();
+        m_visited.mark(t, true);
+        if (occ)
+            m_occurs.mark(t, true);
+    }
+    return m_occurs.is_marked(e);
+}
@@ -79,7 +79,7 @@ public:
     bool is_forbidden(func_decl * d) const { return m_forbidden_set.contains(d); }
     obj_hashtable<func_decl> const & get_forbidden_set() const { return m_forbidden_set; }
     void display(std::ostream & out);
-    bool contains(func_decl* d) const { return m_decls.contains(d); }
+    bool contains(func_decl* d) const { return m_decl2macro.contains(d); }
     unsigned get_num_macros() const { return m_decls.size(); }
     unsigned get_first_macro_last_level() const { return m_scopes.empty() ? 0 : m_scopes.back().m_decls_lim; }
     func_decl * get_macro_func_decl(unsigned i) const { return m_decls.get(i); }
@@ -91,5 +91,23 @@ public:
 
 };
 
+/**
+   \brief Test whether formulas contain applications of the heads of a range of macros.
+   The result for shared subterms is cached across the tested formulas.
+*/
+class macro_head_finder {
+    obj_hashtable<func_decl> m_heads;
+    expr_mark                m_visited;
+    expr_mark                m_occurs;
+    ptr_vector<expr>         m_todo;
+    bool visit(expr * e, bool & occ);
+public:
+    void reset() { m_heads.reset(); m_visited.reset(); m_occurs.reset(); }
+    // use the heads of the macros of mm from the index first on.
+    void set_heads(macro_manager const & mm, unsigned first);
+    bool empty() const { return m_heads.empty(); }
+    bool operator()(expr * e);
+};
+
 #endif /* MACRO_MANAGER_H_ */
 
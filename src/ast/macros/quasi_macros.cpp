@@ -28,13 +28,14 @@ quasi_macros::quasi_macros(ast_manager & m, macro_manager & mm) :
   m_rewriter(m),
   m_new_vars(m),
   m_new_eqs(m),
-  m_new_qsorts(m) {
+  m_new_qsorts(m),
+  m_last(m) {
 }
 
 quasi_macros::~quasi_macros() {
 }
 
-void quasi_macros::find_occurrences(expr * e) {
+void quasi_macros::find_occurrences(expr * e, int delta) {
     unsigned j;
     m_todo.reset();
     m_todo.push_back(e);
@@ -65,7 +66,7 @@ void quasi_macros::find_occurrences(expr * e) {
                     func_decl * f = to_app(cur)->get_decl();
                     m_occurrences.insert_if_not_there(f, 0);
                     occurrences_map::iterator it = m_occurrences.find_iterator(f);
-                    it->m_value++;
+                    it->m_value += delta;
                 }
                 j = to_app(cur)->get_num_args();
                 while (j)
@@ -253,17 +254,32 @@ bool quasi_macros::quasi_macro_to_macro(quantifier * q, app * a, expr * t, quant
     return true;
 }
 
+/**
+   \brief The formulas are the result of the previous call, so the
+   occurrences maintained by apply_macros are valid for them.
+*/
+bool quasi_macros::is_last(unsigned n, expr * const * exprs) const {
+    if (n != m_last.size())
+        return false;
+    for (unsigned i = 0; i < n; ++i)
+        if (exprs[i] != m_last.get(i))
+            return false;
+    return true;
+}
+
 bool quasi_macros::find_macros(unsigned n, expr * const * exprs) {
     TRACE("quasi_macros", tout << "Finding quasi-macros in: " << std::endl;
                           for (unsigned i = 0 ; i < n ; i++)
                               tout << i << ": " << mk_pp(exprs[i], m) << std::endl; );
     bool res = false;
-    m_occurrences.reset();
-
+    unsigned num_macros = m_macro_manager.get_num_macros();
 
     // Find out how many non-ground appearances for each uninterpreted function there are
-    for (unsigned i = 0 ; i < n ; i++)
-        find_occurrences(exprs[i]);
+    if (!is_last(n, exprs)) {
+        m_occurrences.reset();
+        for (unsigned i = 0 ; i < n ; i++)
+            find_occurrences(exprs[i]);
+    }
 
     TRACE("quasi_macros",
         tout << "Occurrences: " << std::endl;
@@ -287,6 +303,7 @@ bool quasi_macros::find_macros(unsigned n, expr * const * exprs) {
                 res = true;
         }
     }
+    m_new_heads.set_heads(m_macro_manager, num_macros);
 
     return res;
 }
@@ -297,6 +314,7 @@ bool quasi_macros::find_macros(unsigned n, justified_expr const * exprs) {
                               tout << i << ": " << mk_pp(exprs[i].get_fml(), m) << std::endl; );
     bool res = false;
     m_occurrences.reset();
+    m_last.reset();
 
 
     // Find out how many non-ground appearances for each uninterpreted function there are
@@ -331,7 +349,12 @@ bool quasi_macros::find_macros(unsigned n, justified_expr const * exprs) {
 
 void quasi_macros::apply_macros(expr_ref_vector & exprs, proof_ref_vector & prs, expr_dependency_ref_vector& deps) {
     unsigned n = exprs.size();
+    // formulas without the new heads were already rewritten when they were produced
+    bool all = !is_last(n, exprs.c_ptr());
+    SASSERT(all || n == m_last.size());
     for (unsigned i = 0 ; i < n ; i++ ) {
+        if (!all && !m_new_heads(exprs.get(i)))
+            continue;
         expr_ref r(m), rr(m);
         proof_ref pr(m), prr(m);
         expr_dependency_ref dep(m);
@@ -339,10 +362,21 @@ void quasi_macros::apply_macros(expr_ref_vector & exprs, proof_ref_vector & prs,
         m_macro_manager.expand_macros(exprs.get(i), p, deps.get(i), r, pr, dep);
         m_rewriter(r, rr, prr);
         if (pr) pr = m.mk_modus_ponens(pr, prr);
+        if (!all) {
+            find_occurrences(exprs.get(i), -1);
+            find_occurrences(rr);
+        }
         exprs[i] = rr;
         prs[i] = pr;
         deps[i] = dep;
     }
+    if (all) {
+        m_occurrences.reset();
+        for (expr * e : exprs)
+            find_occurrences(e);
+    }
+    m_last.reset();
+    m_last.append(exprs);
 }
 
 bool quasi_macros::operator()(expr_ref_vector & exprs, proof_ref_vector & prs, expr_dependency_ref_vector & deps) {
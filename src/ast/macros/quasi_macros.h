@@ -41,8 +41,10 @@ class quasi_macros {
     expr_ref_vector           m_new_eqs;
     sort_ref_vector           m_new_qsorts;
     std::stringstream         m_new_name;
-    expr_mark                 m_visited_once;
-    expr_mark                 m_visited_more;
+    expr_stamp_mark           m_visited_once;
+    expr_stamp_mark           m_visited_more;
+    macro_head_finder         m_new_heads;  // heads of the macros found by the last call to find_macros
+    expr_ref_vector           m_last;       // formulas produced by the last apply_macros, m_occurrences is up to date for them
 
     bool is_unique(func_decl * f) const;
     bool is_non_ground_uninterp(expr const * e) const;
@@ -52,7 +54,8 @@ class quasi_macros {
     bool is_quasi_macro(expr * e, app_ref & a, expr_ref &v) const;
     bool quasi_macro_to_macro(quantifier * q, app * a, expr * t, quantifier_ref & macro);
 
-    void find_occurrences(expr * e);
+    void find_occurrences(expr * e, int delta = 1);
+    bool is_last(unsigned n, expr * const * exprs) const;
     bool find_macros(unsigned n, expr * const * exprs);
     bool find_macros(unsigned n, justified_expr const* expr);
     void apply_macros(expr_ref_vector & exprs, proof_ref_vector & prs, expr_dependency_ref_vector& deps);
@@ -60,8 +60,8 @@ void num_occurs::process(expr * t, expr_fast_mark1 & visited) {
 }
 
 void num_occurs::validate() {
-    for (auto & kv : m_num_occurs) {
-        VERIFY(0 < kv.m_key->get_ref_count());
+    for (expr* e : m_num_occurs.keys()) {
+        VERIFY(0 < e->get_ref_count());
     }
 }
 
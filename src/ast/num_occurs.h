@@ -29,7 +29,7 @@ class num_occurs {
 protected:
     bool m_ignore_ref_count1;
     bool m_ignore_quantifiers;
-    obj_map<expr, unsigned>        m_num_occurs;
+    expr_dense_map<unsigned>       m_num_occurs;
 
     void process(expr * t, expr_fast_mark1 & visited);
 public:
@@ -45,10 +45,7 @@ public:
     void operator()(unsigned num, expr * const * ts);
 
     unsigned get_num_occs(expr * n) const { 
-        unsigned val;
-        if (m_num_occurs.find(n, val))
-            return val;
-        return 0;
+        return m_num_occurs.get(n, 0);
     }
 };
 
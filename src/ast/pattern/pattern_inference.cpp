@@ -113,7 +113,9 @@ pattern_inference_cfg::pattern_inference_cfg(ast_manager & m, pattern_inference_
     m_pattern_weight_lt(m_candidates_info),
     m_collect(m, *this),
     m_contains_subpattern(*this),
-    m_database(m) {
+    m_database(m),
+    m_cached_patterns(m),
+    m_cached_bodies(m) {
     if (params.m_pi_arith == AP_NO)
         register_forbidden_family(m_afid);
 }
@@ -573,6 +575,90 @@ void pattern_inference_cfg::mk_patterns(unsigned num_bindings,
 }
 
 
+/**
+   \brief Infer patterns for the body of a quantifier without patterns.
+   min_weight is set to the least weight of the quantifier when arithmetic patterns are used.
+*/
+void pattern_inference_cfg::infer_patterns(quantifier * q, expr * new_body, unsigned num_no_patterns, expr * const * new_no_patterns,
+                                           app_ref_buffer & new_patterns, int & weight, int & min_weight) {
+    if (m_params.m_pi_arith == AP_CONSERVATIVE)
+        m_forbidden.push_back(m_afid);
+
+    mk_patterns(q->get_num_decls(), new_body, num_no_patterns, new_no_patterns, new_patterns);
+
+    if (new_patterns.empty() && num_no_patterns > 0) {
+        if (new_patterns.empty()) {
+            mk_patterns(q->get_num_decls(), new_body, 0, nullptr, new_patterns);
+            if (m_params.m_pi_warnings && !new_patterns.empty()) {
+                warning_msg("ignoring nopats annotation because Z3 couldn't find any other pattern (quantifier id: %s)", q->get_qid().str().c_str());
+            }
+        }
+    }
+
+    if (m_params.m_pi_arith == AP_CONSERVATIVE) {
+        m_forbidden.pop_back();
+        if (new_patterns.empty()) {
+            flet<bool> l1(m_block_loop_patterns, false); // allow looping patterns
+            mk_patterns(q->get_num_decls(), new_body, num_no_patterns, new_no_patterns, new_patterns);
+            if (!new_patterns.empty()) {
+                min_weight = static_cast<int>(m_params.m_pi_arith_weight);
+                weight = std::max(weight, min_weight);
+                if (m_params.m_pi_warnings) {
+                    warning_msg("using arith. in pattern (quantifier id: %s), the weight was increased to %d (this value can be modified using PI_ARITH_WEIGHT=<val>).",
+                                q->get_qid().str().c_str(), weight);
+                }
+            }
+        }
+    }
+
+    if (m_params.m_pi_arith != AP_NO && new_patterns.empty()) {
+        if (new_patterns.empty()) {
+            flet<bool> l1(m_nested_arith_only, false); // try to find a non-nested arith pattern
+            flet<bool> l2(m_block_loop_patterns, false); // allow looping patterns
+            mk_patterns(q->get_num_decls(), new_body, num_no_patterns, new_no_patterns, new_patterns);
+            if (!new_patterns.empty()) {
+                min_weight = static_cast<int>(m_params.m_pi_non_nested_arith_weight);
+                weight = std::max(weight, min_weight);
+                if (m_params.m_pi_warnings) {
+                    warning_msg("using non nested arith. pattern (quantifier id: %s), the weight was increased to %d (this value can be modified using PI_NON_NESTED_ARITH_WEIGHT=<val>).",
+                                q->get_qid().str().c_str(), weight);
+                }
+                // verbose_stream() << mk_pp(q, m) << "\n";
+            }
+        }
+    }
+}
+
+/**
+   \brief The inferred patterns only depend on the body and the number of bound
+   variables, so quantifiers that only differ in their names, identifiers and
+   weights share them.
+*/
+bool pattern_inference_cfg::find_cached_patterns(quantifier * q, expr * new_body, unsigned num_no_patterns, app_ref_buffer & new_patterns, int & min_weight) {
+    cached_patterns c;
+    if (num_no_patterns > 0 || !m_pattern_cache.find(new_body, c) || c.m_num_decls != q->get_num_decls())
+        return false;
+    for (unsigned i = c.m_begin; i < c.m_end; ++i)
+        new_patterns.push_back(m_cached_patterns.get(i));
+    min_weight = c.m_min_weight;
+    TRACE("pattern_inference", tout << "cached patterns for:\n" << mk_pp(q, m) << "\n";);
+    return true;
+}
+
+void pattern_inference_cfg::cache_patterns(quantifier * q, expr * new_body, unsigned num_no_patterns, app_ref_buffer const & new_patterns, int min_weight) {
+    if (num_no_patterns > 0 || m_pattern_cache.contains(new_body))
+        return;
+    cached_patterns c;
+    c.m_num_decls  = q->get_num_decls();
+    c.m_begin      = m_cached_patterns.size();
+    for (app * p : new_patterns)
+        m_cached_patterns.push_back(p);
+    c.m_end        = m_cached_patterns.size();
+    c.m_min_weight = min_weight;
+    m_cached_bodies.push_back(new_body);
+    m_pattern_cache.insert(new_body, c);
+}
+
 bool pattern_inference_cfg::reduce_quantifier(
     quantifier * q, 
     expr * new_body, 
@@ -588,7 +674,9 @@ bool pattern_inference_cfg::reduce_quantifier(
 
     int weight = q->get_weight();
 
-    if (m_params.m_pi_use_database) {
+    unsigned num_decls = 0;
+    bool database_miss = m_database_misses.find(q->get_expr(), num_decls) && num_decls == q->get_num_decls();
+    if (m_params.m_pi_use_database && !database_miss) {
         app_ref_vector new_patterns(m);
         m_database.initialize(g_pattern_database);
         unsigned new_weight;
@@ -609,6 +697,10 @@ bool pattern_inference_cfg::reduce_quantifier(
                 result_pr = m.mk_rewrite(q, result);
             return true;
         }
+        if (!m_database_misses.contains(q->get_expr())) {
+            m_cached_bodies.push_back(q->get_expr());
+            m_database_misses.insert(q->get_expr(), q->get_num_decls());
+        }
     }
 
     if (q->get_num_patterns() > 0) {
@@ -620,52 +712,14 @@ bool pattern_inference_cfg::reduce_quantifier(
 
     SASSERT(q->get_num_patterns() == 0);
 
-    if (m_params.m_pi_arith == AP_CONSERVATIVE)
-        m_forbidden.push_back(m_afid);
-
     app_ref_buffer new_patterns(m);
     unsigned num_no_patterns = q->get_num_no_patterns();
-    mk_patterns(q->get_num_decls(), new_body, num_no_patterns, new_no_patterns, new_patterns);
-
-    if (new_patterns.empty() && num_no_patterns > 0) {
-        if (new_patterns.empty()) {
-            mk_patterns(q->get_num_decls(), new_body, 0, nullptr, new_patterns);
-            if (m_params.m_pi_warnings && !new_patterns.empty()) {
-                warning_msg("ignoring nopats annotation because Z3 couldn't find any other pattern (quantifier id: %s)", q->get_qid().str().c_str());
-            }
-        }
-    }
-
-    if (m_params.m_pi_arith == AP_CONSERVATIVE) {
-        m_forbidden.pop_back();
-        if (new_patterns.empty()) {
-            flet<bool> l1(m_block_loop_patterns, false); // allow looping patterns
-            mk_patterns(q->get_num_decls(), new_body, num_no_patterns, new_no_patterns, new_patterns);
-            if (!new_patterns.empty()) {
-                weight = std::max(weight, static_cast<int>(m_params.m_pi_arith_weight));
-                if (m_params.m_pi_warnings) {
-                    warning_msg("using arith. in pattern (quantifier id: %s), the weight was increased to %d (this value can be modified using PI_ARITH_WEIGHT=<val>).",
-                                q->get_qid().str().c_str(), weight);
-                }
-            }
-        }
-    }
-
-    if (m_params.m_pi_arith != AP_NO && new_patterns.empty()) {
-        if (new_patterns.empty()) {
-            flet<bool> l1(m_nested_arith_only, false); // try to find a non-nested arith pattern
-            flet<bool> l2(m_block_loop_patterns, false); // allow looping patterns
-            mk_patterns(q->get_num_decls(), new_body, num_no_patterns, new_no_patterns, new_patterns);
-            if (!new_patterns.empty()) {
-                weight = std::max(weight, static_cast<int>(m_params.m_pi_non_nested_arith_weight));
-                if (m_params.m_pi_warnings) {
-                    warning_msg("using non nested arith. pattern (quantifier id: %s), the weight was increased to %d (this value can be modified using PI_NON_NESTED_ARITH_WEIGHT=<val>).",
-                                q->get_qid().str().c_str(), weight);
-                }
-                // verbose_stream() << mk_pp(q, m) << "\n";
-            }
-        }
+    int min_weight = INT_MIN;
+    if (!find_cached_patterns(q, new_body, num_no_patterns, new_patterns, min_weight)) {
+        infer_patterns(q, new_body, num_no_patterns, new_no_patterns, new_patterns, weight, min_weight);
+        cache_patterns(q, new_body, num_no_patterns, new_patterns, min_weight);
     }
+    weight = std::max(weight, min_weight);
 
     quantifier_ref new_q(m.update_quantifier(q, new_patterns.size(), (expr**) new_patterns.c_ptr(), new_body), m);
     if (weight != q->get_weight())
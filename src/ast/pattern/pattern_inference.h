@@ -192,6 +192,23 @@ class pattern_inference_cfg :  public default_rewriter_cfg {
     ptr_vector<pre_pattern>      m_pre_patterns;
     expr_pattern_match           m_database;
 
+    struct cached_patterns {
+        unsigned m_num_decls;
+        unsigned m_begin, m_end;    // range in m_cached_patterns
+        int      m_min_weight;
+        cached_patterns(): m_num_decls(0), m_begin(0), m_end(0), m_min_weight(0) {}
+    };
+    obj_map<expr, cached_patterns> m_pattern_cache; // body -> patterns inferred for it
+    obj_map<expr, unsigned>      m_database_misses; // bodies that do not match the database -> number of bound variables
+    app_ref_vector               m_cached_patterns;
+    expr_ref_vector              m_cached_bodies;
+
+    void reset_pattern_cache() { m_pattern_cache.reset(); m_database_misses.reset(); m_cached_patterns.reset(); m_cached_bodies.reset(); }
+    bool find_cached_patterns(quantifier * q, expr * new_body, unsigned num_no_patterns, app_ref_buffer & new_patterns, int & min_weight);
+    void cache_patterns(quantifier * q, expr * new_body, unsigned num_no_patterns, app_ref_buffer const & new_patterns, int min_weight);
+    void infer_patterns(quantifier * q, expr * new_body, unsigned num_no_patterns, expr * const * new_no_patterns,
+                        app_ref_buffer & new_patterns, int & weight, int & min_weight);
+
     void candidates2unary_patterns(ptr_vector<app> const & candidate_patterns,
                                    ptr_vector<app> & remaining_candidate_patterns,
                                    app_ref_buffer & result);
@@ -221,6 +238,7 @@ public:
     void register_forbidden_family(family_id fid) {
         SASSERT(fid != m_bfid);
         m_forbidden.push_back(fid);
+        reset_pattern_cache();
     }
 
     /**
@@ -229,6 +247,7 @@ public:
     */
     void register_preferred(func_decl * f) {
         m_preferred.insert(f);
+        reset_pattern_cache();
     }
 
     bool reduce_quantifier(quantifier * old_q, 
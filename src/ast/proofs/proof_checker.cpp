@@ -83,7 +83,7 @@ void proof_checker::hyp_decl_plugin::get_sort_names(svector<builtin_name> & sort
     }
 }
 
-proof_checker::proof_checker(ast_manager& m) : m(m), m_todo(m), m_marked(), m_pinned(m), m_nil(m),
+proof_checker::proof_checker(ast_manager& m) : m(m), m_todo(m), m_marked(), m_pinned(m), m_max_hypotheses(1000000), m_nil(m),
                                                m_dump_lemmas(false), m_logic("AUFLIRA"), m_proof_lemma_id(0) {
     symbol fam_name("proof_hypothesis");
     if (!m.has_plugin(fam_name)) {
@@ -1079,6 +1079,12 @@ void proof_checker::get_hypotheses(proof* p, expr_ref_vector& ante) {
     ptr_vector<proof> stack;
     expr* h = nullptr, *hyp = nullptr;
 
+    if (m_hypotheses.size() > m_max_hypotheses) {
+        TRACE("proof_checker", tout << "flushing hypotheses cache of size " << m_hypotheses.size() << "\n";);
+        m_hypotheses.reset();
+        m_pinned.reset();
+    }
+
     stack.push_back(p);
     while (!stack.empty()) {
         p = stack.back();
@@ -25,9 +25,10 @@ Revision History:
 class proof_checker {
     ast_manager&     m;
     proof_ref_vector m_todo;
-    expr_mark        m_marked;
+    expr_stamp_mark  m_marked;
     expr_ref_vector  m_pinned;
-    obj_map<expr, expr*> m_hypotheses;
+    obj_map<expr, expr*> m_hypotheses;   // cache of the hypotheses of sub-proofs
+    unsigned         m_max_hypotheses;   // bound on the size of m_hypotheses
     family_id        m_hyp_fid;
     // family_id        m_spc_fid;
     app_ref          m_nil;
@@ -70,6 +71,12 @@ class proof_checker {
 public:
     proof_checker(ast_manager& m);
     void set_dump_lemmas(char const * logic = "AUFLIA") { m_dump_lemmas = true; m_logic = logic; } 
+    /**
+       \brief bound the number of sub-proofs whose hypotheses are cached.
+       The cache is flushed between steps when the bound is exceeded, so large
+       proofs are checked in bounded memory at the cost of recomputing hypotheses.
+    */
+    void set_max_hypotheses(unsigned n) { m_max_hypotheses = n; }
     bool check(proof* p, expr_ref_vector& side_conditions);
 private:
     bool check1(proof* p, expr_ref_vector& side_conditions);
@@ -20,28 +20,23 @@ Revision History:
 #define RECURSE_EXPR_H_
 
 #include "ast/ast.h"
-#include "util/obj_hashtable.h"
+#include "ast/expr_fold.h"
 
 template<typename T, typename Visitor, bool IgnorePatterns=false, bool CallDestructors=true>
 class recurse_expr : public Visitor {
-    obj_map<expr, T>                          m_cache;
-    ptr_vector<expr>                          m_todo;
-    vector<T, CallDestructors>                m_results1;
-    vector<T, CallDestructors>                m_results2;
-
-    bool is_cached(expr * n) const { T c; return m_cache.find(n, c); }
-    T get_cached(expr * n) const { return m_cache.find(n); }
-    void cache_result(expr * n, T c) { m_cache.insert(n, c); }
-    
-    void visit(expr * n, bool & visited);
-    bool visit_children(expr * n);
-    void process(expr * n);
-    
+    struct proc {
+        Visitor& m_visitor;
+        proc(Visitor& v): m_visitor(v) {}
+        T operator()(expr * n, unsigned num_children, T const * children);
+    };
+    proc                                 m_proc;
+    expr_fold<T, proc, IgnorePatterns>   m_fold;
+
 public:
-    recurse_expr(Visitor const & v = Visitor()):Visitor(v) {}
-    T operator()(expr * n);
-    void reset() { m_cache.reset(); m_todo.reset(); }
-    void finalize() { m_cache.finalize(); m_todo.finalize(); }
+    recurse_expr(Visitor const & v = Visitor()):Visitor(v), m_proc(*this), m_fold(m_proc) {}
+    T operator()(expr * n) { return m_fold(n); }
+    void reset() { m_fold.reset(); }
+    void finalize() { m_fold.finalize(); }
 };
 
 #endif /* RECURSE_EXPR_H_ */
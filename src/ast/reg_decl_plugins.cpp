@@ -29,35 +29,31 @@ Revision History:
 #include "ast/fpa_decl_plugin.h"
 #include "ast/special_relations_decl_plugin.h"
 
-void reg_decl_plugins(ast_manager & m) {
-    if (!m.get_plugin(m.mk_family_id(symbol("arith")))) {
-        m.register_plugin(symbol("arith"), alloc(arith_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("bv")))) {
-        m.register_plugin(symbol("bv"), alloc(bv_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("array")))) {
-        m.register_plugin(symbol("array"), alloc(array_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("datatype")))) {
-        m.register_plugin(symbol("datatype"), alloc(datatype_decl_plugin));    
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("recfun")))) {
-        m.register_plugin(symbol("recfun"), alloc(recfun::decl::plugin));    
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("datalog_relation")))) {
-        m.register_plugin(symbol("datalog_relation"), alloc(datalog::dl_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("seq")))) {
-        m.register_plugin(symbol("seq"), alloc(seq_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("fpa")))) {
-        m.register_plugin(symbol("fpa"), alloc(fpa_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("pb")))) {
-        m.register_plugin(symbol("pb"), alloc(pb_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("special_relations")))) {
-        m.register_plugin(symbol("special_relations"), alloc(special_relations_decl_plugin));
+template<typename P>
+static decl_plugin * mk_plugin() {
+    return alloc(P);
+}
+
+/**
+   \brief The plugins are created when they are first used,
+   so that creating a manager does not pay for unused theories.
+*/
+static void reg_plugin(ast_manager & m, char const * name, decl_plugin_factory f) {
+    symbol s(name);
+    if (!m.has_plugin(s)) {
+        m.register_plugin_factory(s, f);
     }
 }
+
+void reg_decl_plugins(ast_manager & m) {
+    reg_plugin(m, "arith", mk_plugin<arith_decl_plugin>);
+    reg_plugin(m, "bv", mk_plugin<bv_decl_plugin>);
+    reg_plugin(m, "array", mk_plugin<array_decl_plugin>);
+    reg_plugin(m, "datatype", mk_plugin<datatype_decl_plugin>);
+    reg_plugin(m, "recfun", mk_plugin<recfun::decl::plugin>);
+    reg_plugin(m, "datalog_relation", mk_plugin<datalog::dl_decl_plugin>);
+    reg_plugin(m, "seq", mk_plugin<seq_decl_plugin>);
+    reg_plugin(m, "fpa", mk_plugin<fpa_decl_plugin>);
+    reg_plugin(m, "pb", mk_plugin<pb_decl_plugin>);
+    reg_plugin(m, "special_relations", mk_plugin<special_relations_decl_plugin>);
+}
@@ -22,6 +22,8 @@ Notes:
 #include "ast/rewriter/rewriter_def.h"
 #include "ast/rewriter/bool_rewriter.h"
 #include "util/ref_util.h"
+#include "util/obj_pair_hashtable.h"
+#include "util/statistics.h"
 #include "ast/ast_smt2_pp.h"
 
 struct blaster_cfg {
@@ -97,6 +99,17 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
     func_decl_ref_vector                     m_newbits;
     unsigned_vector                          m_newbits_lim;
 
+    // blasted multipliers, dividers and shifters indexed by the bits of their operands.
+    // udiv and urem share one circuit, and multiplication is commutative.
+    // The cache is kept across rewrites and entries are removed when their scope is popped.
+    enum cached_op { CACHE_MUL, CACHE_UDIV, CACHE_UREM, CACHE_SHL, CACHE_LSHR, CACHE_ASHR, CACHE_NUM_OPS };
+    obj_pair_map<expr, expr, expr*>          m_op_cache[CACHE_NUM_OPS];
+    expr_ref_vector                          m_op_cache_pinned; // arguments and result of each entry
+    unsigned_vector                          m_op_cache_trail;  // the op of each entry
+    unsigned_vector                          m_op_cache_lim;
+    unsigned                                 m_num_blasted_ops;
+    unsigned                                 m_num_reused_ops;
+
     bool                                     m_blast_mul;
     bool                                     m_blast_add;
     bool                                     m_blast_quant;
@@ -123,7 +136,10 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
         m_bindings(m),
         m_keys(m),
         m_values(m),
-        m_newbits(m) {
+        m_newbits(m),
+        m_op_cache_pinned(m),
+        m_num_blasted_ops(0),
+        m_num_reused_ops(0) {
         updt_params(p);
     }
 
@@ -138,6 +154,7 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
         m_blast_full     = p.get_bool("blast_full", false);
         m_blast_quant    = p.get_bool("blast_quant", false);
         m_blaster.set_max_memory(m_max_memory);
+        m_blaster.set_wtm_min_size(p.get_uint("blast_mul_wallace_size", UINT_MAX));
     }
 
     bool rewrite_patterns() const { return true; }
@@ -165,6 +182,7 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
     void push() {
         m_keyval_lim.push_back(m_keys.size());
         m_newbits_lim.push_back(m_newbits.size());
+        m_op_cache_lim.push_back(m_op_cache_trail.size());
     }
 
     unsigned get_num_scopes() const {
@@ -187,6 +205,9 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
             lim = m_newbits_lim[new_sz];
             m_newbits.shrink(lim);
             m_newbits_lim.shrink(new_sz);
+
+            pop_op_cache(m_op_cache_lim[new_sz]);
+            m_op_cache_lim.shrink(new_sz);
         }
     }
 
@@ -256,19 +277,85 @@ void OP(expr * arg1, expr * arg2, expr_ref & result) {                  \
     result = mk_mkbv(m_out);                                            \
 }
 
-    MK_BIN_REDUCE(reduce_shl, mk_shl);
-    MK_BIN_REDUCE(reduce_ashr, mk_ashr);
-    MK_BIN_REDUCE(reduce_lshr, mk_lshr);
-    MK_BIN_REDUCE(reduce_udiv, mk_udiv);
-    MK_BIN_REDUCE(reduce_urem, mk_urem);
     MK_BIN_REDUCE(reduce_sdiv, mk_sdiv);
     MK_BIN_REDUCE(reduce_srem, mk_srem);
     MK_BIN_REDUCE(reduce_smod, mk_smod);
     MK_BIN_REDUCE(reduce_ext_rotate_left, mk_ext_rotate_left);
     MK_BIN_REDUCE(reduce_ext_rotate_right, mk_ext_rotate_right);
 
-#define MK_BIN_AC_REDUCE(OP, BIN_OP, BB_OP)                             \
-MK_BIN_REDUCE(BIN_OP, BB_OP);                                           \
+    void pop_op_cache(unsigned lim) {
+        for (unsigned i = m_op_cache_trail.size(); i-- > lim; ) 
+            m_op_cache[m_op_cache_trail[i]].erase(m_op_cache_pinned.get(3*i), m_op_cache_pinned.get(3*i + 1));
+        m_op_cache_trail.shrink(lim);
+        m_op_cache_pinned.shrink(3*lim);
+    }
+
+    void cache_op(cached_op k, expr * arg1, expr * arg2, expr * r) {
+        m_op_cache[k].insert(arg1, arg2, r);
+        m_op_cache_trail.push_back(k);
+        m_op_cache_pinned.push_back(arg1);
+        m_op_cache_pinned.push_back(arg2);
+        m_op_cache_pinned.push_back(r);
+    }
+
+    bool find_op(cached_op k, expr * arg1, expr * arg2, expr_ref & result) {
+        expr * r = nullptr;
+        if (!m_op_cache[k].find(arg1, arg2, r))
+            return false;
+        result = r;
+        ++m_num_reused_ops;
+        return true;
+    }
+
+    void collect_statistics(statistics & st) const {
+        st.update("bit-blast blasted ops", m_num_blasted_ops);
+        st.update("bit-blast reused ops", m_num_reused_ops);
+    }
+
+#define MK_CACHED_BIN_REDUCE(OP, BB_OP, K)                              \
+void OP(expr * arg1, expr * arg2, expr_ref & result) {                  \
+    if (find_op(K, arg1, arg2, result))                                 \
+        return;                                                         \
+    ++m_num_blasted_ops;                                                \
+    m_in1.reset(); m_in2.reset();                                       \
+    get_bits(arg1, m_in1);                                              \
+    get_bits(arg2, m_in2);                                              \
+    m_out.reset();                                                      \
+    m_blaster.BB_OP(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), m_out); \
+    result = mk_mkbv(m_out);                                            \
+    cache_op(K, arg1, arg2, result);                                    \
+}
+
+    MK_CACHED_BIN_REDUCE(reduce_shl, mk_shl, CACHE_SHL);
+    MK_CACHED_BIN_REDUCE(reduce_ashr, mk_ashr, CACHE_ASHR);
+    MK_CACHED_BIN_REDUCE(reduce_lshr, mk_lshr, CACHE_LSHR);
+    MK_CACHED_BIN_REDUCE(reduce_ordered_mul, mk_multiplier, CACHE_MUL);
+
+    void reduce_bin_mul(expr * arg1, expr * arg2, expr_ref & result) {
+        if (arg1->get_id() > arg2->get_id())
+            std::swap(arg1, arg2);
+        reduce_ordered_mul(arg1, arg2, result);
+    }
+
+    void reduce_udiv_urem(expr * arg1, expr * arg2, bool is_div, expr_ref & result) {
+        if (find_op(is_div ? CACHE_UDIV : CACHE_UREM, arg1, arg2, result))
+            return;
+        ++m_num_blasted_ops;
+        m_in1.reset(); m_in2.reset();
+        get_bits(arg1, m_in1);
+        get_bits(arg2, m_in2);
+        expr_ref_vector q_bits(m()), r_bits(m());
+        m_blaster.mk_udiv_urem(m_in1.size(), m_in1.c_ptr(), m_in2.c_ptr(), q_bits, r_bits);
+        expr_ref q(mk_mkbv(q_bits), m()), rem(mk_mkbv(r_bits), m());
+        cache_op(CACHE_UDIV, arg1, arg2, q);
+        cache_op(CACHE_UREM, arg1, arg2, rem);
+        result = is_div ? q : rem;
+    }
+
+    void reduce_udiv(expr * arg1, expr * arg2, expr_ref & result) { reduce_udiv_urem(arg1, arg2, true, result); }
+    void reduce_urem(expr * arg1, expr * arg2, expr_ref & result) { reduce_udiv_urem(arg1, arg2, false, result); }
+
+#define MK_AC_REDUCE(OP, BIN_OP)                                        \
 void OP(unsigned num_args, expr * const * args, expr_ref & result) {    \
     SASSERT(num_args > 0);                                              \
     result = args[0];                                                   \
@@ -279,8 +366,12 @@ void OP(unsigned num_args, expr * const * args, expr_ref & result) {    \
     }                                                                   \
 }
 
+#define MK_BIN_AC_REDUCE(OP, BIN_OP, BB_OP)                             \
+MK_BIN_REDUCE(BIN_OP, BB_OP);                                           \
+MK_AC_REDUCE(OP, BIN_OP)
+
     MK_BIN_AC_REDUCE(reduce_add, reduce_bin_add, mk_adder);
-    MK_BIN_AC_REDUCE(reduce_mul, reduce_bin_mul, mk_multiplier);
+    MK_AC_REDUCE(reduce_mul, reduce_bin_mul);
 
     MK_BIN_AC_REDUCE(reduce_or, reduce_bin_or, mk_or);
     MK_BIN_AC_REDUCE(reduce_xor, reduce_bin_xor, mk_xor);
@@ -680,6 +771,7 @@ struct bit_blaster_rewriter::imp : public rewriter_tpl<blaster_rewriter_cfg> {
     void start_rewrite() { m_cfg.start_rewrite(); }
     void end_rewrite(obj_map<func_decl, expr*>& const2bits, ptr_vector<func_decl> & newbits) { m_cfg.end_rewrite(const2bits, newbits); }
     unsigned get_num_scopes() const { return m_cfg.get_num_scopes(); }
+    void collect_statistics(statistics & st) const { m_cfg.collect_statistics(st); }
 };
 
 bit_blaster_rewriter::bit_blaster_rewriter(ast_manager & m, params_ref const & p):
@@ -715,6 +807,10 @@ void bit_blaster_rewriter::cleanup() {
     m_imp->cleanup();
 }
 
+void bit_blaster_rewriter::collect_statistics(statistics & st) const {
+    m_imp->collect_statistics(st);
+}
+
 obj_map<func_decl, expr*> const & bit_blaster_rewriter::const2bits() const {
     return m_imp->m_cfg.m_const2bits;
 }
@@ -22,6 +22,7 @@ Notes:
 #include "ast/ast.h"
 #include "util/obj_hashtable.h"
 #include "util/params.h"
+#include "util/statistics.h"
 
 class bit_blaster_rewriter {
     struct imp;
@@ -39,6 +40,7 @@ public:
     void push();
     void pop(unsigned num_scopes);
     unsigned get_num_scopes() const;
+    void collect_statistics(statistics & st) const;
 private:
     obj_map<func_decl, expr*> const& const2bits() const;     
 
@@ -38,6 +38,7 @@ protected:
     unsigned long long m_max_memory;
     bool               m_use_wtm; /* Wallace Tree Multiplier */
     bool               m_use_bcm; /* Booth Multiplier for constants */
+    unsigned           m_wtm_min_size; /* use the Wallace Tree Multiplier from this width on */
     void checkpoint();
 
 public:
@@ -45,13 +46,16 @@ public:
         Cfg(cfg),
         m_max_memory(max_memory),
         m_use_wtm(use_wtm),
-        m_use_bcm(use_bcm) {
+        m_use_bcm(use_bcm),
+        m_wtm_min_size(UINT_MAX) {
     }
 
     void set_max_memory(unsigned long long max_memory) {
         m_max_memory = max_memory;
     }
 
+    void set_wtm_min_size(unsigned sz) { m_wtm_min_size = sz; }
+
     
     // Cfg required API
     ast_manager & m() const { return Cfg::m(); }
@@ -72,28 +72,9 @@ bool bit_blaster_tpl<Cfg>::is_minus_one(unsigned sz, expr * const * bits) const
 // hack to avoid GCC compilation error.
 static void _num2bits(ast_manager & m, rational const & v, unsigned sz, expr_ref_vector & out_bits) {
     SASSERT(v.is_nonneg());
-    rational aux = v;
-    rational two(2), base32(1ull << 32ull, rational::ui64());
+    // read the bits of v directly instead of dividing it repeatedly.
     for (unsigned i = 0; i < sz; i++) {
-        if (i + 32 < sz) {
-            unsigned u = (aux % base32).get_unsigned();
-            for (unsigned j = 0; j < 32; ++j) {
-                if (0 != (u & (1 << j))) {
-                    out_bits.push_back(m.mk_true());
-                }
-                else {
-                    out_bits.push_back(m.mk_false());
-                }
-            }
-            aux = div(aux, base32);
-            i += 31;
-            continue;
-        }
-        else if ((aux % two).is_zero())
-            out_bits.push_back(m.mk_false());
-        else
-            out_bits.push_back(m.mk_true());
-        aux = div(aux, two);
+        out_bits.push_back(v.get_bit(i) ? m.mk_true() : m.mk_false());
     }
 }
 
@@ -196,7 +177,7 @@ void bit_blaster_tpl<Cfg>::mk_multiplier(unsigned sz, expr * const * a_bits, exp
         return;
     }
     out_bits.reset();
-    if (!m_use_wtm) {
+    if (!m_use_wtm && sz < m_wtm_min_size) {
 #if 0
     static unsigned counter = 0;
     counter++;
@@ -54,9 +54,86 @@ void bv_rewriter::get_param_descrs(param_descrs & r) {
 #endif
 }
 
+#define BV_U64_CACHE_SIZE 1024
+
+app * bv_rewriter::mk_u64_numeral(uint64_t v, unsigned sz) {
+    if (m_u64_cache.empty()) {
+        m_u64_cache.resize(BV_U64_CACHE_SIZE);
+        m_u64_cache_val.resize(BV_U64_CACHE_SIZE, 0);
+        m_u64_cache_sz.resize(BV_U64_CACHE_SIZE, 0);
+    }
+    unsigned idx = static_cast<unsigned>(v ^ (v >> 29) ^ (sz * 0x9e3779b9u)) & (BV_U64_CACHE_SIZE - 1);
+    app * r = m_u64_cache.get(idx);
+    if (r && m_u64_cache_val[idx] == v && m_u64_cache_sz[idx] == sz)
+        return r;
+    r = m_util.mk_numeral(v, sz);
+    m_u64_cache.set(idx, r);
+    m_u64_cache_val[idx] = v;
+    m_u64_cache_sz[idx]  = sz;
+    return r;
+}
+
+/**
+   \brief Fold applications whose arguments are numerals of width at most 64 
+   using machine arithmetic instead of rationals.
+*/
+br_status bv_rewriter::mk_u64_fold(func_decl * f, unsigned num_args, expr * const * args, expr_ref & result) {
+    decl_kind k = f->get_decl_kind();
+    switch (k) {
+    case OP_BADD: case OP_BSUB: case OP_BMUL: case OP_BNEG:
+    case OP_BAND: case OP_BOR: case OP_BXOR: case OP_BNOT:
+    case OP_ULEQ: case OP_UGEQ: case OP_ULT: case OP_UGT:
+    case OP_SLEQ: case OP_SGEQ: case OP_SLT: case OP_SGT:
+    case OP_BSHL: case OP_BLSHR: case OP_BASHR:
+        break;
+    default:
+        return BR_FAILED;
+    }
+    if (num_args == 0 || num_args > 8)
+        return BR_FAILED;
+    uint64_t v[8];
+    unsigned sz = 0;
+    numeral r;
+    for (unsigned i = 0; i < num_args; ++i) {
+        if (!m_util.is_numeral(args[i], r, sz) || sz > 64)
+            return BR_FAILED;
+        v[i] = r.get_uint64();
+    }
+    uint64_t mask = sz == 64 ? ~0ull : (1ull << sz) - 1;
+    auto sgn = [&](uint64_t x) { return sz == 64 ? static_cast<int64_t>(x) : static_cast<int64_t>(x << (64 - sz)) >> (64 - sz); };
+    uint64_t u = v[0];
+    switch (k) {
+    case OP_BADD: for (unsigned i = 1; i < num_args; ++i) u += v[i]; break;
+    case OP_BSUB: for (unsigned i = 1; i < num_args; ++i) u -= v[i]; break;
+    case OP_BMUL: for (unsigned i = 1; i < num_args; ++i) u *= v[i]; break;
+    case OP_BAND: for (unsigned i = 1; i < num_args; ++i) u &= v[i]; break;
+    case OP_BOR:  for (unsigned i = 1; i < num_args; ++i) u |= v[i]; break;
+    case OP_BXOR: for (unsigned i = 1; i < num_args; ++i) u ^= v[i]; break;
+    case OP_BNEG: u = 0 - u; break;
+    case OP_BNOT: u = ~u; break;
+    case OP_BSHL:  u = v[1] >= sz ? 0 : u << v[1]; break;
+    case OP_BLSHR: u = v[1] >= sz ? 0 : u >> v[1]; break;
+    case OP_BASHR: u = static_cast<uint64_t>(v[1] >= sz ? (sgn(u) < 0 ? -1 : 0) : sgn(u) >> v[1]); break;
+    case OP_ULEQ: result = m().mk_bool_val(v[0] <= v[1]); return BR_DONE;
+    case OP_UGEQ: result = m().mk_bool_val(v[0] >= v[1]); return BR_DONE;
+    case OP_ULT:  result = m().mk_bool_val(v[0] < v[1]); return BR_DONE;
+    case OP_UGT:  result = m().mk_bool_val(v[0] > v[1]); return BR_DONE;
+    case OP_SLEQ: result = m().mk_bool_val(sgn(v[0]) <= sgn(v[1])); return BR_DONE;
+    case OP_SGEQ: result = m().mk_bool_val(sgn(v[0]) >= sgn(v[1])); return BR_DONE;
+    case OP_SLT:  result = m().mk_bool_val(sgn(v[0]) < sgn(v[1])); return BR_DONE;
+    case OP_SGT:  result = m().mk_bool_val(sgn(v[0]) > sgn(v[1])); return BR_DONE;
+    default: UNREACHABLE(); return BR_FAILED;
+    }
+    result = mk_u64_numeral(u & mask, sz);
+    return BR_DONE;
+}
+
 br_status bv_rewriter::mk_app_core(func_decl * f, unsigned num_args, expr * const * args, expr_ref & result) {
     SASSERT(f->get_family_id() == get_fid());
 
+    if (num_args > 0 && m_util.is_numeral(args[0]) && mk_u64_fold(f, num_args, args, result) == BR_DONE)
+        return BR_DONE;
+
     switch(f->get_decl_kind()) {
     case OP_BIT0: SASSERT(num_args == 0); result = m_util.mk_numeral(0, 1); return BR_DONE;
     case OP_BIT1: SASSERT(num_args == 0); result = m_util.mk_numeral(1, 1); return BR_DONE;
@@ -62,9 +62,15 @@ class bv_rewriter : public poly_rewriter<bv_rewriter_core> {
     bool       m_extract_prop;
     bool       m_bvnot_simpl;
     bool       m_le_extra;
+    app_ref_vector    m_u64_cache;      // direct mapped cache of numerals of width at most 64
+    svector<uint64_t> m_u64_cache_val;
+    unsigned_vector   m_u64_cache_sz;
 
     bool is_zero_bit(expr * x, unsigned idx);
 
+    app * mk_u64_numeral(uint64_t v, unsigned sz);
+    br_status mk_u64_fold(func_decl * f, unsigned num_args, expr * const * args, expr_ref & result);
+
     br_status mk_ule(expr * a, expr * b, expr_ref & result);
     br_status mk_uge(expr * a, expr * b, expr_ref & result);
     br_status mk_ult(expr * a, expr * b, expr_ref & result);
@@ -155,7 +161,8 @@ public:
     bv_rewriter(ast_manager & m, params_ref const & p = params_ref()):
         poly_rewriter<bv_rewriter_core>(m, p),
         m_mk_extract(m_util),
-        m_autil(m) {
+        m_autil(m),
+        m_u64_cache(m) {
         updt_local_params(p);
     }
 
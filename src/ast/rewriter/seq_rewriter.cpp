@@ -42,6 +42,7 @@ expr_ref sym_expr::accept(expr* e) {
     unsigned r1, r2, r3;
     switch (m_ty) {
     case t_pred:         
+    case t_set:
         result = subst(m_t, 1, &e);
         break;    
     case t_not:
@@ -72,6 +73,7 @@ std::ostream& sym_expr::display(std::ostream& out) const {
     case t_range: return out << m_t << ":" << m_s;
     case t_pred: return out << m_t;
     case t_not: return m_expr->display(out << "not ");
+    case t_set: return out << m_set;
     }
     return out << "expression type not recognized";
 }
@@ -93,6 +95,68 @@ public:
     sym_expr_boolean_algebra(ast_manager& m, expr_solver& s): 
         m(m), m_solver(s), m_var(m) {}
 
+    /**
+       \brief extract the character class of x if x is built from
+       constant characters and ranges.
+    */
+    bool get_set(T x, char_set& s) {
+        seq_util u(m);
+        unsigned lo, hi;
+        if (x->is_char() && u.is_const_char(x->get_char(), lo)) {
+            s = char_set(lo, lo);
+            return true;
+        }
+        if (x->is_range() && u.is_const_char(x->get_lo(), lo) && u.is_const_char(x->get_hi(), hi)) {
+            s = char_set(lo, hi);
+            return true;
+        }
+        if (x->is_set()) {
+            s = x->get_set();
+            return true;
+        }
+        if (x->is_not() && get_set(x->get_arg(), s)) {
+            s = s.complement(u.max_char());
+            return true;
+        }
+        if (x->is_pred() && !x->is_range() && !x->is_not() && (m.is_true(x->get_pred()) || m.is_false(x->get_pred()))) {
+            s = m.is_true(x->get_pred()) ? char_set(0, u.max_char()) : char_set();
+            return true;
+        }
+        return false;
+    }
+
+    T mk_set(char_set const& s, sort* srt) {
+        seq_util u(m);
+        unsigned ch;
+        expr_ref fml(m);
+        if (s.empty() || s.is_full(u.max_char()) || !u.is_char(srt)) {
+            fml = m.mk_bool_val(!s.empty());
+            return sym_expr::mk_pred(fml, srt);
+        }
+        if (s.is_char(ch)) {
+            fml = u.mk_char(ch);
+            return sym_expr::mk_char(fml);
+        }
+        if (s.num_ranges() == 1) {
+            expr_ref lo(u.mk_char(s[0].first), m), hi(u.mk_char(s[0].second), m);
+            return sym_expr::mk_range(lo, hi);
+        }
+        expr_ref v(m.mk_var(0, srt), m);
+        expr_ref_vector ors(m);
+        for (auto const& r : s) {
+            if (r.first == r.second)
+                ors.push_back(m.mk_eq(v, u.mk_char(r.first)));
+            else
+                ors.push_back(m.mk_and(u.mk_le(u.mk_char(r.first), v), u.mk_le(v, u.mk_char(r.second))));
+        }
+        fml = ::mk_or(ors);
+        return sym_expr::mk_set(fml, srt, s);
+    }
+
+    sort* char_sort(T x, T y) {
+        return m.is_bool(x->get_sort()) ? y->get_sort() : x->get_sort();
+    }
+
     T mk_false() override {
         expr_ref fml(m.mk_false(), m);
         return sym_expr::mk_pred(fml, m.mk_bool_sort()); // use of Bool sort for bound variable is arbitrary
@@ -103,6 +167,10 @@ public:
     }
     T mk_and(T x, T y) override {
         seq_util u(m);
+        char_set s1, s2;
+        if (get_set(x, s1) && get_set(y, s2)) {
+            return mk_set(s1 & s2, char_sort(x, y));
+        }
         if (x->is_char() && y->is_char()) {
             if (x->get_char() == y->get_char()) {
                 return x;
@@ -159,6 +227,10 @@ public:
     }
 
     T mk_or(T x, T y) override {
+        char_set s1, s2;
+        if (get_set(x, s1) && get_set(y, s2)) {
+            return mk_set(s1 | s2, char_sort(x, y));
+        }
         if (x->is_char() && y->is_char() &&
             x->get_char() == y->get_char()) {
             return x;
@@ -206,6 +278,10 @@ public:
     lbool is_sat(T x) override {
         unsigned lo, hi;
         seq_util u(m);
+        char_set s;
+        if (get_set(x, s)) {
+            return s.empty() ? l_false : l_true;
+        }
 
         if (x->is_char()) {
             return l_true;
@@ -230,6 +306,11 @@ public:
     }
 
     T mk_not(T x) override {
+        seq_util u(m);
+        char_set s;
+        if (get_set(x, s) && u.is_char(x->get_sort())) {
+            return mk_set(s.complement(u.max_char()), x->get_sort());
+        }
         return sym_expr::mk_not(m, x);    
     }
 
@@ -736,7 +817,8 @@ br_status seq_rewriter::mk_seq_concat(expr* a, expr* b, expr_ref& result) {
     bool isc1 = m_util.str.is_string(a, s1) && m_coalesce_chars;
     bool isc2 = m_util.str.is_string(b, s2) && m_coalesce_chars;
     if (isc1 && isc2) {
-        result = m_util.str.mk_string(s1 + s2);
+        s1 += s2;
+        result = m_util.str.mk_string(s1);
         return BR_DONE;
     }
     if (m_util.str.is_concat(a, c, d)) {
@@ -752,7 +834,8 @@ br_status seq_rewriter::mk_seq_concat(expr* a, expr* b, expr_ref& result) {
         return BR_DONE;
     }
     if (isc1 && m_util.str.is_concat(b, c, d) && m_util.str.is_string(c, s2)) {
-        result = m_util.str.mk_concat(m_util.str.mk_string(s1 + s2), d);
+        s1 += s2;
+        result = m_util.str.mk_concat(m_util.str.mk_string(s1), d);
         return BR_DONE;
     }
     return BR_FAILED;
@@ -2825,19 +2908,6 @@ br_status seq_rewriter::mk_re_opt(expr* a, expr_ref& result) {
     return BR_REWRITE1;
 }
 
-void seq_rewriter::intersect(unsigned lo, unsigned hi, svector<std::pair<unsigned, unsigned>>& ranges) {
-    unsigned j = 0;
-    for (unsigned i = 0; i < ranges.size(); ++i) {
-        unsigned lo1 = ranges[i].first;
-        unsigned hi1 = ranges[i].second;        
-        if (hi < lo1) 
-            break;
-        if (hi1 >= lo) 
-            ranges[j++] = std::make_pair(std::max(lo1, lo), std::min(hi1, hi));
-    }
-    ranges.shrink(j);
-}
-
 /**
  * Simplify cond using special case rewriting for character equations
  * When elem is uninterpreted compute the simplification of Exists elem . cond
@@ -2849,36 +2919,24 @@ void seq_rewriter::elim_condition(expr* elem, expr_ref& cond) {
     expr* lhs = nullptr, *rhs = nullptr, *e1 = nullptr; 
     if (u().is_char(elem)) {
         unsigned ch = 0;
-        svector<std::pair<unsigned, unsigned>> ranges, ranges1;
-        ranges.push_back(std::make_pair(0, zstring::max_char()));
+        unsigned max_char = u().max_char();
+        char_set ranges(0, max_char);
         auto exclude_char = [&](unsigned ch) {
-            if (ch == 0) {
-                intersect(1, zstring::max_char(), ranges);
-            }
-            else if (ch == zstring::max_char()) {
-                intersect(0, ch-1, ranges);
-            }
-            else {
-                ranges1.reset();
-                ranges1.append(ranges);
-                intersect(0, ch - 1, ranges);
-                intersect(ch + 1, zstring::max_char(), ranges1);
-                ranges.append(ranges1);
-            }
+            ranges = ranges & char_set(ch, ch).complement(max_char);
         };
         bool all_ranges = true;
         for (expr* e : conds) {
             if (m().is_eq(e, lhs, rhs) && elem == lhs && u().is_const_char(rhs, ch)) {
-                intersect(ch, ch, ranges);                
+                ranges = ranges & char_set(ch, ch);
             }
             else if (m().is_eq(e, lhs, rhs) && elem == rhs && u().is_const_char(lhs, ch)) {
-                intersect(ch, ch, ranges);
+                ranges = ranges & char_set(ch, ch);
             }
             else if (u().is_char_le(e, lhs, rhs) && elem == lhs && u().is_const_char(rhs, ch)) {
-                intersect(0, ch, ranges);
+                ranges = ranges & char_set(0, ch);
             }
             else if (u().is_char_le(e, lhs, rhs) && elem == rhs && u().is_const_char(lhs, ch)) {
-                intersect(ch, zstring::max_char(), ranges);
+                ranges = ranges & char_set(ch, max_char);
             }
             else if (m().is_not(e, e1) && m().is_eq(e1, lhs, rhs) && elem == lhs && u().is_const_char(rhs, ch)) {
                 exclude_char(ch);
@@ -2888,17 +2946,11 @@ void seq_rewriter::elim_condition(expr* elem, expr_ref& cond) {
             }
             else if (m().is_not(e, e1) && u().is_char_le(e1, lhs, rhs) && elem == lhs && u().is_const_char(rhs, ch)) {
                 // not (e <= ch)
-                if (ch == zstring::max_char()) 
-                    ranges.reset();
-                else 
-                    intersect(ch+1, zstring::max_char(), ranges);
+                ranges = ranges & char_set(0, ch).complement(max_char);
             }
             else if (m().is_not(e, e1) && u().is_char_le(e1, lhs, rhs) && elem == rhs && u().is_const_char(lhs, ch)) {
                 // not (ch <= e)
-                if (ch == 0) 
-                    ranges.reset();
-                else                 
-                    intersect(0, ch-1, ranges);
+                ranges = ranges & char_set(ch, max_char).complement(max_char);
             }
             // TBD: case for negation of range (not (and (<= lo e) (<= e hi)))
             else {
@@ -3484,10 +3536,10 @@ bool seq_rewriter::is_string(unsigned n, expr* const* es, zstring& s) const {
     unsigned ch;
     for (unsigned i = 0; i < n; ++i) {
         if (m_util.str.is_string(es[i], s1)) {
-            s = s + s1;
+            s += s1;
         }
         else if (m_util.str.is_unit(es[i], e) && m_util.is_const_char(e, ch)) {
-            s = s + zstring(ch);
+            s += ch;
         }
         else {
             return false;
@@ -26,6 +26,7 @@ Notes:
 #include "util/params.h"
 #include "util/lbool.h"
 #include "util/sign.h"
+#include "util/char_set.h"
 #include "math/automata/automaton.h"
 #include "math/automata/symbolic_automata.h"
 
@@ -42,7 +43,8 @@ class sym_expr {
         t_char,
         t_pred,
         t_not,
-        t_range
+        t_range,
+        t_set
     };
     ty        m_ty;
     sort*     m_sort;
@@ -50,6 +52,7 @@ class sym_expr {
     expr_ref  m_t;
     expr_ref  m_s;
     unsigned  m_ref;
+    char_set  m_set;
     sym_expr(ty ty, expr_ref& t, expr_ref& s, sort* srt, sym_expr* e) : 
         m_ty(ty), m_sort(srt), m_expr(e), m_t(t), m_s(s), m_ref(0) {}
 public:
@@ -60,6 +63,10 @@ public:
     static sym_expr* mk_pred(expr_ref& t, sort* s) { return alloc(sym_expr, t_pred, t, t, s, nullptr); }
     static sym_expr* mk_range(expr_ref& lo, expr_ref& hi) { return alloc(sym_expr, t_range, lo, hi, lo.get_manager().get_sort(hi), nullptr); }
     static sym_expr* mk_not(ast_manager& m, sym_expr* e) { expr_ref f(m); e->inc_ref(); return alloc(sym_expr, t_not, f, f, e->get_sort(), e); }
+    /**
+       \brief character class s, where t is the membership predicate over variable 0.
+    */
+    static sym_expr* mk_set(expr_ref& t, sort* srt, char_set const& s) { sym_expr* r = alloc(sym_expr, t_set, t, t, srt, nullptr); r->m_set = s; return r; }
     void inc_ref() { ++m_ref;  }
     void dec_ref() { --m_ref; if (m_ref == 0) dealloc(this); }
     std::ostream& display(std::ostream& out) const;
@@ -67,12 +74,14 @@ public:
     bool is_pred() const { return !is_char(); }
     bool is_range() const { return m_ty == t_range; }
     bool is_not() const { return m_ty == t_not; }
+    bool is_set() const { return m_ty == t_set; }
     sort* get_sort() const { return m_sort; }
     expr* get_char() const { SASSERT(is_char()); return m_t; }
     expr* get_pred() const { SASSERT(is_pred()); return m_t; }
     expr* get_lo() const { SASSERT(is_range()); return m_t; }
     expr* get_hi() const { SASSERT(is_range()); return m_s; }
     sym_expr* get_arg() const { SASSERT(is_not()); return m_expr; }
+    char_set const& get_set() const { SASSERT(is_set()); return m_set; }
 };
 
 class sym_expr_manager {
@@ -221,7 +230,6 @@ class seq_rewriter {
     class seq_util::str const& str() const { return u().str; }
 
     void get_cofactors(expr* r, expr_ref_vector& conds, expr_ref_pair_vector& result);
-    void intersect(unsigned lo, unsigned hi, svector<std::pair<unsigned, unsigned>>& ranges);
 
 public:
     seq_rewriter(ast_manager & m, params_ref const & p = params_ref()):
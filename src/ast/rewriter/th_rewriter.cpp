@@ -16,6 +16,7 @@ Author:
 Notes:
 
 --*/
+#include "util/statistics.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/rewriter/rewriter_params.hpp"
 #include "ast/rewriter/bool_rewriter.h"
@@ -35,6 +36,11 @@ Notes:
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 #include "ast/well_sorted.h"
+#include "ast/ast_translation.h"
+#include "ast/for_each_expr.h"
+#include "util/mutex.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
 
 namespace {
 struct th_rewriter_cfg : public default_rewriter_cfg {
@@ -793,9 +799,91 @@ template class rewriter_tpl<th_rewriter_cfg>;
 
 struct th_rewriter::imp : public rewriter_tpl<th_rewriter_cfg> {
     th_rewriter_cfg m_cfg;
+
+    // Bounded cache of top-level results. Unlike the rewriter cache it
+    // survives between calls, and it is flushed whenever the rewriter is
+    // reset or reconfigured. Slots are recycled using the clock algorithm.
+    expr_ref_vector          m_result_keys;
+    expr_ref_vector          m_result_values;
+    svector<bool>            m_result_used;
+    obj_map<expr, unsigned>  m_result_pos;
+    unsigned                 m_result_capacity;
+    unsigned                 m_result_clock;
+    unsigned                 m_result_hits;
+    unsigned                 m_result_misses;
+
     imp(ast_manager & m, params_ref const & p):
         rewriter_tpl<th_rewriter_cfg>(m, m.proofs_enabled(), m_cfg),
-        m_cfg(m, p) {
+        m_cfg(m, p),
+        m_result_keys(m),
+        m_result_values(m),
+        m_result_capacity(0),
+        m_result_clock(0),
+        m_result_hits(0),
+        m_result_misses(0) {
+        updt_result_cache(p);
+    }
+
+    void updt_result_cache(params_ref const & p) {
+        reset_result_cache();
+        m_result_capacity = m().proofs_enabled() ? 0 : rewriter_params(p).result_cache_size();
+    }
+
+    void reset_result_cache() {
+        m_result_keys.reset();
+        m_result_values.reset();
+        m_result_used.reset();
+        m_result_pos.reset();
+        m_result_clock = 0;
+    }
+
+    // results under a substitution are not retained, since a cache hit
+    // would not record the dependencies of the substitution.
+    bool use_result_cache() const {
+        return m_result_capacity > 0 && !m_cfg.m_subst;
+    }
+
+    bool find_result(expr * t, expr_ref & result) {
+        if (!use_result_cache())
+            return false;
+        unsigned pos;
+        if (m_result_pos.find(t, pos)) {
+            m_result_used[pos] = true;
+            result = m_result_values.get(pos);
+            ++m_result_hits;
+            return true;
+        }
+        ++m_result_misses;
+        return false;
+    }
+
+    void insert_result(expr * t, expr * r) {
+        if (!use_result_cache())
+            return;
+        if (m_result_keys.size() < m_result_capacity) {
+            m_result_pos.insert(t, m_result_keys.size());
+            m_result_keys.push_back(t);
+            m_result_values.push_back(r);
+            m_result_used.push_back(false);
+            return;
+        }
+        while (m_result_used[m_result_clock]) {
+            m_result_used[m_result_clock] = false;
+            m_result_clock = (m_result_clock + 1) % m_result_capacity;
+        }
+        unsigned pos = m_result_clock;
+        m_result_clock = (m_result_clock + 1) % m_result_capacity;
+        m_result_pos.erase(m_result_keys.get(pos));
+        m_result_pos.insert(t, pos);
+        m_result_keys.set(pos, t);
+        m_result_values.set(pos, r);
+    }
+
+    void rewrite(expr * t, expr_ref & result) {
+        if (find_result(t, result))
+            return;
+        operator()(t, result);
+        insert_result(t, result);
     }
     expr_ref mk_app(func_decl* f, unsigned sz, expr* const* args) {
         return m_cfg.mk_app(f, sz, args);
@@ -818,6 +906,7 @@ ast_manager & th_rewriter::m() const {
 void th_rewriter::updt_params(params_ref const & p) {
     m_params = p;
     m_imp->cfg().updt_params(p);
+    m_imp->updt_result_cache(p);
 }
 
 void th_rewriter::get_param_descrs(param_descrs & r) {
@@ -850,16 +939,22 @@ void th_rewriter::cleanup() {
 void th_rewriter::reset() {
     m_imp->reset();
     m_imp->cfg().reset();
+    m_imp->reset_result_cache();
+}
+
+void th_rewriter::collect_statistics(statistics & st) const {
+    st.update("rewriter result cache hits", m_imp->m_result_hits);
+    st.update("rewriter result cache misses", m_imp->m_result_misses);
 }
 
 void th_rewriter::operator()(expr_ref & term) {
     expr_ref result(term.get_manager());
-    m_imp->operator()(term, result);
+    m_imp->rewrite(term, result);
     term = std::move(result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result) {
-    m_imp->operator()(t, result);
+    m_imp->rewrite(t, result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr) {
@@ -872,6 +967,7 @@ expr_ref th_rewriter::operator()(expr * n, unsigned num_bindings, expr * const *
 
 void th_rewriter::set_substitution(expr_substitution * s) {
     m_imp->reset(); // reset the cache
+    m_imp->reset_result_cache();
     m_imp->cfg().set_substitution(s);
 }
 
@@ -903,3 +999,81 @@ bool th_rewriter::reduce_quantifier(quantifier * old_q,
                                     proof_ref & result_pr) {
     return m_imp->cfg().reduce_quantifier(old_q, new_body, new_patterns, new_no_patterns, result, result_pr);
 }
+
+unsigned parallel_rewrite(ast_manager & m, params_ref const & p, unsigned num_threads, unsigned grain_size, expr_ref_vector & es) {
+    SASSERT(!m.proofs_enabled());
+    unsigned_vector limits;
+    unsigned sz = 0;
+    for (unsigned i = 0; i < es.size(); ++i) {
+        sz += get_num_exprs(es.get(i));
+        if (sz >= grain_size || i + 1 == es.size()) {
+            limits.push_back(i + 1);
+            sz = 0;
+        }
+    }
+    unsigned num_chunks = limits.size();
+    if (num_threads <= 1 || num_chunks <= 1) {
+        th_rewriter rw(m, p);
+        expr_ref r(m);
+        for (unsigned i = 0; i < es.size(); ++i) {
+            rw(es.get(i), r);
+            es.set(i, r);
+        }
+        return rw.get_num_steps();
+    }
+
+    // the copies are made and translated back sequentially,
+    // since translation updates reference counts in both managers.
+    scoped_ptr_vector<ast_manager>     managers;
+    scoped_ptr_vector<expr_ref_vector> chunks;
+    scoped_ptr_vector<th_rewriter>     rewriters;
+    scoped_limits sl(m.limit());
+    for (unsigned c = 0, i = 0; c < num_chunks; ++c) {
+        ast_manager* lm = alloc(ast_manager, m, true);
+        managers.push_back(lm);
+        sl.push_child(&lm->limit());
+        ast_translation tr(m, *lm);
+        expr_ref_vector* chunk = alloc(expr_ref_vector, *lm);
+        chunks.push_back(chunk);
+        for (; i < limits[c]; ++i)
+            chunk->push_back(tr(es.get(i)));
+        rewriters.push_back(alloc(th_rewriter, *lm, p));
+    }
+
+    mutex mux;
+    std::string ex_msg;
+    bool failed = false;
+    unsigned k = std::min(num_threads, num_chunks);
+    thread_pool::run(k, [&](unsigned t) {
+        try {
+            for (unsigned c = t; c < num_chunks; c += k) {
+                expr_ref_vector& chunk = *chunks[c];
+                expr_ref r(chunk.get_manager());
+                for (unsigned i = 0; i < chunk.size(); ++i) {
+                    (*rewriters[c])(chunk.get(i), r);
+                    chunk.set(i, r);
+                }
+            }
+        }
+        catch (z3_exception & ex) {
+            lock_guard lock(mux);
+            if (!failed)
+                ex_msg = ex.msg();
+            failed = true;
+            for (ast_manager* lm : managers)
+                lm->limit().cancel();
+        }
+    });
+    if (failed)
+        throw rewriter_exception(std::move(ex_msg));
+
+    unsigned steps = 0;
+    for (unsigned c = 0, i = 0; c < num_chunks; ++c) {
+        ast_translation tr(*managers[c], m);
+        expr_ref_vector& chunk = *chunks[c];
+        for (unsigned j = 0; j < chunk.size(); ++j, ++i)
+            es.set(i, tr(chunk.get(j)));
+        steps += rewriters[c]->get_num_steps();
+    }
+    return steps;
+}
@@ -24,6 +24,7 @@ Notes:
 #include "util/params.h"
 
 class expr_substitution;
+class statistics;
 
 class expr_solver;
 
@@ -41,6 +42,7 @@ public:
     static void get_param_descrs(param_descrs & r);
     unsigned get_cache_size() const;
     unsigned get_num_steps() const;
+    void collect_statistics(statistics & st) const;
    
     void operator()(expr_ref& term);
     void operator()(expr * t, expr_ref & result);
@@ -72,4 +74,14 @@ public:
 
 };
 
+/**
+   \brief rewrite the formulas of es using up to num_threads threads.
+   Consecutive formulas are grouped into chunks of at least grain_size
+   sub-expressions. Each chunk is copied to a private ast_manager,
+   rewritten there and copied back, so shared subterms of different
+   chunks are rewritten once per chunk. Proofs and dependencies are not
+   tracked. Return the number of rewrite steps.
+*/
+unsigned parallel_rewrite(ast_manager & m, params_ref const & p, unsigned num_threads, unsigned grain_size, expr_ref_vector & es);
+
 #endif
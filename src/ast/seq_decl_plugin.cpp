@@ -167,10 +167,10 @@ zstring::zstring(char const* s) {
     while (*s) {
         unsigned ch = 0;
         if (is_escape_char(s, ch)) {
-            m_buffer.push_back(ch);
+            push_back(ch);
         }
         else {
-            m_buffer.push_back(*s);
+            push_back(*s);
             ++s;
         }
     }
@@ -183,12 +183,12 @@ zstring::zstring(unsigned num_bits, bool const* ch) {
     for (unsigned i = 0; i < num_bits; ++i) {
         n |= (((unsigned)ch[i]) << i);
     }
-    m_buffer.push_back(n);
+    push_back(n);
     SASSERT(well_formed());
 }
 
 bool zstring::well_formed() const {
-    for (unsigned ch : m_buffer) {
+    for (unsigned ch : m_wide) {
         if (ch > max_char())
             return false;
     }
@@ -196,15 +196,49 @@ bool zstring::well_formed() const {
 }
 
 zstring::zstring(unsigned ch) {
-    m_buffer.push_back(ch);
+    push_back(ch);
 }
 
 zstring& zstring::operator=(zstring const& other) {
-    m_buffer.reset();
-    m_buffer.append(other.m_buffer);
+    m_narrow.reset();
+    m_narrow.append(other.m_narrow);
+    m_wide = other.m_wide;
+    m_is_wide = other.m_is_wide;
     return *this;
 }
 
+void zstring::widen() {
+    SASSERT(!m_is_wide);
+    m_wide.reset();
+    for (unsigned char ch : m_narrow)
+        m_wide.push_back(ch);
+    m_narrow.reset();
+    m_is_wide = true;
+}
+
+void zstring::push_back(unsigned ch) {
+    if (!m_is_wide && ch < 256) {
+        m_narrow.push_back(static_cast<unsigned char>(ch));
+        return;
+    }
+    if (!m_is_wide)
+        widen();
+    m_wide.push_back(ch);
+}
+
+/**
+   \brief append the characters other[lo], ..., other[hi-1].
+*/
+void zstring::append(zstring const& other, unsigned lo, unsigned hi) {
+    SASSERT(lo <= hi && hi <= other.length());
+    if (!m_is_wide && !other.m_is_wide) {
+        m_narrow.append(hi - lo, other.m_narrow.c_ptr() + lo);
+        return;
+    }
+    for (unsigned i = lo; i < hi; ++i)
+        push_back(other[i]);
+}
+
 zstring zstring::replace(zstring const& src, zstring const& dst) const {
     zstring result;
     if (length() < src.length()) {
@@ -217,15 +251,15 @@ zstring zstring::replace(zstring const& src, zstring const& dst) const {
     for (unsigned i = 0; i < length(); ++i) {
         bool eq = !found && i + src.length() <= length();
         for (unsigned j = 0; eq && j < src.length(); ++j) {
-            eq = m_buffer[i+j] == src[j];
+            eq = (*this)[i+j] == src[j];
         }
         if (eq) {
-            result.m_buffer.append(dst.m_buffer);
+            result += dst;
             found = true;
             i += src.length() - 1;
         }
         else {
-            result.m_buffer.push_back(m_buffer[i]);
+            result.push_back((*this)[i]);
         }
     }
     return result;
@@ -241,8 +275,8 @@ std::string zstring::encode() const {
     char buffer[100];
     unsigned offset = 0;
 #define _flush() if (offset > 0) { buffer[offset] = 0; strm << buffer; offset = 0; }
-    for (unsigned i = 0; i < m_buffer.size(); ++i) {
-        unsigned ch = m_buffer[i];
+    for (unsigned i = 0; i < length(); ++i) {
+        unsigned ch = (*this)[i];
         if (0 <= ch && ch < 32) {
             _flush();
             strm << esc_table[ch];
@@ -274,7 +308,7 @@ bool zstring::suffixof(zstring const& other) const {
     if (length() > other.length()) return false;
     bool suffix = true;
     for (unsigned i = 0; suffix && i < length(); ++i) {
-        suffix = m_buffer[length()-i-1] == other[other.length()-i-1];
+        suffix = (*this)[length()-i-1] == other[other.length()-i-1];
     }
     return suffix;
 }
@@ -283,7 +317,7 @@ bool zstring::prefixof(zstring const& other) const {
     if (length() > other.length()) return false;
     bool prefix = true;
     for (unsigned i = 0; prefix && i < length(); ++i) {
-        prefix = m_buffer[i] == other[i];
+        prefix = (*this)[i] == other[i];
     }
     return prefix;
 }
@@ -295,7 +329,7 @@ bool zstring::contains(zstring const& other) const {
     for (unsigned i = 0; !cont && i <= last; ++i) {
         cont = true;
         for (unsigned j = 0; cont && j < other.length(); ++j) {
-            cont = other[j] == m_buffer[j+i];
+            cont = other[j] == (*this)[j+i];
         }
     }
     return cont;
@@ -310,7 +344,7 @@ int zstring::indexofu(zstring const& other, unsigned offset) const {
     for (unsigned i = offset; i <= last; ++i) {
         bool prefix = true;
         for (unsigned j = 0; prefix && j < other.length(); ++j) {
-            prefix = m_buffer[i + j] == other[j];
+            prefix = (*this)[i + j] == other[j];
         }
         if (prefix) {
             return static_cast<int>(i);
@@ -325,7 +359,7 @@ int zstring::last_indexof(zstring const& other) const {
     for (unsigned last = length() - other.length(); last-- > 0; ) {
         bool suffix = true;
         for (unsigned j = 0; suffix && j < other.length(); ++j) {
-            suffix = m_buffer[last + j] == other[j];
+            suffix = (*this)[last + j] == other[j];
         }
         if (suffix) {
             return static_cast<int>(last);
@@ -337,16 +371,16 @@ int zstring::last_indexof(zstring const& other) const {
 zstring zstring::extract(unsigned offset, unsigned len) const {
     zstring result;
     if (offset + len < offset) return result;
-    int last = std::min(offset+len, length());
-    for (int i = offset; i < last; ++i) {
-        result.m_buffer.push_back(m_buffer[i]);
+    unsigned last = std::min(offset+len, length());
+    if (offset < last) {
+        result.append(*this, offset, last);
     }
     return result;
 }
 
 zstring zstring::operator+(zstring const& other) const {
     zstring result(*this);
-    result.m_buffer.append(other.m_buffer);
+    result += other;
     return result;
 }
 
@@ -355,8 +389,11 @@ bool zstring::operator==(const zstring& other) const {
     if (length() != other.length()) {
         return false;
     }
+    if (!m_is_wide && !other.m_is_wide) {
+        return memcmp(m_narrow.c_ptr(), other.m_narrow.c_ptr(), length()) == 0;
+    }
     for (unsigned i = 0; i < length(); ++i) {
-        if (m_buffer[i] != other[i]) {
+        if ((*this)[i] != other[i]) {
             return false;
         }
     }
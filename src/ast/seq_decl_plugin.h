@@ -110,24 +110,36 @@ enum seq_op_kind {
 };
 
 
+/**
+   \brief strings of unicode characters.
+
+   Characters are stored one byte each as long as they are all below 256,
+   which covers string constants of most benchmarks. The first character
+   above 255 moves the string to a vector of unsigned.
+*/
 class zstring {
 private:
-    buffer<unsigned> m_buffer;
+    buffer<unsigned char, false> m_narrow;
+    svector<unsigned>            m_wide;
+    bool                         m_is_wide { false };
     bool well_formed() const;
+    void widen();
+    void push_back(unsigned ch);
+    void append(zstring const& other, unsigned lo, unsigned hi);
 public:
     static unsigned max_char() { return 196607; }
     zstring() {}
     zstring(char const* s);
-    zstring(unsigned sz, unsigned const* s) { m_buffer.append(sz, s); SASSERT(well_formed()); }
-    zstring(zstring const& other): m_buffer(other.m_buffer) {}
+    zstring(unsigned sz, unsigned const* s) { for (unsigned i = 0; i < sz; ++i) push_back(s[i]); SASSERT(well_formed()); }
+    zstring(zstring const& other): m_narrow(other.m_narrow), m_wide(other.m_wide), m_is_wide(other.m_is_wide) {}
     zstring(unsigned num_bits, bool const* ch);
     zstring(unsigned ch);
     zstring& operator=(zstring const& other);
     zstring replace(zstring const& src, zstring const& dst) const;
     std::string encode() const;
-    unsigned length() const { return m_buffer.size(); }
-    unsigned operator[](unsigned i) const { return m_buffer[i]; }
-    bool empty() const { return m_buffer.empty(); }
+    unsigned length() const { return m_is_wide ? m_wide.size() : m_narrow.size(); }
+    unsigned operator[](unsigned i) const { return m_is_wide ? m_wide[i] : m_narrow[i]; }
+    bool empty() const { return length() == 0; }
     bool suffixof(zstring const& other) const;
     bool prefixof(zstring const& other) const;
     bool contains(zstring const& other) const;
@@ -135,6 +147,8 @@ public:
     int  last_indexof(zstring const& other) const;
     zstring extract(unsigned lo, unsigned hi) const;
     zstring operator+(zstring const& other) const;
+    zstring& operator+=(zstring const& other) { append(other, 0, other.length()); return *this; }
+    zstring& operator+=(unsigned ch) { push_back(ch); return *this; }
     bool operator==(const zstring& other) const;
     bool operator!=(const zstring& other) const;
 
@@ -253,6 +267,7 @@ public:
     bool is_char_le(expr const* e) const { return bv().is_bv_ule(e) && is_char(to_app(e)->get_arg(0)); }
 #endif
     app* mk_char(unsigned ch) const;
+    unsigned max_char() const { return Z3_USE_UNICODE ? zstring::max_char() : 255; }
     app* mk_le(expr* ch1, expr* ch2) const;
     app* mk_lt(expr* ch1, expr* ch2) const;
 
@@ -474,6 +474,7 @@ cmd_context::cmd_context(bool main_ctx, ast_manager * m, symbol const & l):
     m_numeral_as_real(false),
     m_ignore_check(false),
     m_processing_pareto(false),
+    m_streamed_assertions(false),
     m_exit_on_error(false),
     m_manager(m),
     m_own_manager(m == nullptr),
@@ -522,6 +523,8 @@ opt_wrapper* cmd_context::get_opt() {
 }
 
 void cmd_context::set_opt(opt_wrapper* opt) {
+    if (m_streamed_assertions)
+        throw cmd_exception("objective functions are not supported after assertions were streamed (stream_assertions=true)");
     m_opt = opt;
     for (unsigned i = 0; i < m_scopes.size(); ++i) {
         m_opt->push();
@@ -1262,6 +1265,7 @@ void cmd_context::insert_aux_pdecl(pdecl * p) {
 
 void cmd_context::reset(bool finalize) {    
     m_processing_pareto = false;
+    m_streamed_assertions = false;
     m_logic = symbol::null;
     m_check_sat_result = nullptr;
     m_numeral_as_real = false;
@@ -1305,12 +1309,27 @@ void cmd_context::reset(bool finalize) {
     SASSERT(!m_own_manager || !has_manager());
 }
 
+/**
+   \brief In streaming mode assertions are owned by the solver only.
+   This saves a copy of every assertion on large flat benchmarks, at
+   the cost of get-assertions and of objective functions, which need the
+   assertions retained in the command context.
+*/
+bool cmd_context::stream_assertions() const {
+    return m_params.m_stream_assertions && m_solver && !m_opt && !m_interactive_mode;
+}
+
 void cmd_context::assert_expr(expr * t) {
     scoped_rlimit no_limit(m().limit(), 0);
     m_processing_pareto = false;
     if (!m_check_logic(t))
         throw cmd_exception(m_check_logic.get_last_error());
     m_check_sat_result = nullptr;
+    if (stream_assertions()) {
+        m_streamed_assertions = true;
+        m_solver->assert_expr(t);
+        return;
+    }
     m().inc_ref(t);
     m_assertions.push_back(t);
     if (produce_unsat_cores())
@@ -1330,9 +1349,14 @@ void cmd_context::assert_expr(symbol const & name, expr * t) {
     scoped_rlimit no_limit(m().limit(), 0);
 
     m_check_sat_result = nullptr;
+    app * ans  = m().mk_skolem_const(name, m().mk_bool_sort());
+    if (stream_assertions()) {
+        m_streamed_assertions = true;
+        m_solver->assert_expr(t, ans);
+        return;
+    }
     m().inc_ref(t);
     m_assertions.push_back(t);
-    app * ans  = m().mk_skolem_const(name, m().mk_bool_sort());
     m().inc_ref(ans);
     m_assertion_names.push_back(ans);
     if (m_solver)
@@ -193,6 +193,7 @@ protected:
     bool                         m_numeral_as_real;
     bool                         m_ignore_check;      // used by the API to disable check-sat() commands when parsing SMT 2.0 files.
     bool                         m_processing_pareto; // used when re-entering check-sat for pareto front.
+    bool                         m_streamed_assertions; // some assertions were passed to the solver without being retained.
     bool                         m_exit_on_error;
 
     static std::ostringstream    g_error_stream;
@@ -431,6 +432,7 @@ public:
     void display_statistics(bool show_total_time = false, double total_time = 0.0);
     void display_dimacs();
     void reset(bool finalize = false);
+    bool stream_assertions() const;
     void assert_expr(expr * t);
     void assert_expr(symbol const & name, expr * t);
     void push_assert_string(std::string const & s) { SASSERT(m_interactive_mode); m_assertion_strings.push_back(s); }
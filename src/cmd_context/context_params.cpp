@@ -32,6 +32,8 @@ context_params::context_params() {
     m_proof          = false;
     m_trace          = false;
     m_debug_ref_count = false;
+    m_ast_arena = false;
+    m_stream_assertions = false;
     m_smtlib2_compliant = false;
     m_well_sorted_check = false;
     m_timeout = UINT_MAX;
@@ -125,6 +127,12 @@ void context_params::set(char const * param, char const * value) {
     else if (p == "debug_ref_count") {
         set_bool(m_debug_ref_count, param, value);
     }
+    else if (p == "ast_arena") {
+        set_bool(m_ast_arena, param, value);
+    }
+    else if (p == "stream_assertions") {
+        set_bool(m_stream_assertions, param, value);
+    }
     else if (p == "smtlib2_compliant") {
         set_bool(m_smtlib2_compliant, param, value);
     }
@@ -157,6 +165,8 @@ void context_params::updt_params(params_ref const & p) {
     m_dot_proof_file    = p.get_str("dot_proof_file", "proof.dot");
     m_unsat_core        |= p.get_bool("unsat_core", m_unsat_core);
     m_debug_ref_count   = p.get_bool("debug_ref_count", m_debug_ref_count);
+    m_ast_arena         = p.get_bool("ast_arena", m_ast_arena);
+    m_stream_assertions = p.get_bool("stream_assertions", m_stream_assertions);
     m_smtlib2_compliant = p.get_bool("smtlib2_compliant", m_smtlib2_compliant);
     m_statistics        = p.get_bool("stats", m_statistics);
 }
@@ -173,6 +183,8 @@ void context_params::collect_param_descrs(param_descrs & d) {
     d.insert("trace_file_name", CPK_STRING, "trace out file name (see option 'trace')", "z3.log");
     d.insert("dot_proof_file", CPK_STRING, "file in which to output graphical proofs", "proof.dot");
     d.insert("debug_ref_count", CPK_BOOL, "debug support for AST reference counting", "false");
+    d.insert("ast_arena", CPK_BOOL, "keep AST nodes until the context is destroyed and release them in bulk, for short-lived contexts", "false");
+    d.insert("stream_assertions", CPK_BOOL, "pass SMT-LIB2 assertions directly to the solver without retaining them in the command context; reduces memory on large benchmarks, but get-assertions and objective functions are not available", "false");
     d.insert("smtlib2_compliant", CPK_BOOL, "enable/disable SMT-LIB 2.0 compliance", "false");
     d.insert("stats", CPK_BOOL, "enable/disable statistics", "false");
     // statistics are hidden as they are controlled by the /st option.
@@ -211,6 +223,8 @@ ast_manager * context_params::mk_ast_manager() {
         r->enable_int_real_coercions(false);
     if (m_debug_ref_count)
         r->debug_ref_count();
+    if (m_ast_arena)
+        r->enable_arena_mode();
     return r;
 }
 
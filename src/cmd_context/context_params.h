@@ -35,6 +35,7 @@ public:
     std::string m_dot_proof_file;
     bool        m_interpolants;
     bool        m_debug_ref_count;
+    bool        m_ast_arena;
     bool        m_trace;
     std::string m_trace_file_name;
     bool        m_well_sorted_check;
@@ -42,6 +43,7 @@ public:
     bool        m_model_validate;
     bool        m_dump_models;
     bool        m_unsat_core;
+    bool        m_stream_assertions;
     bool        m_smtlib2_compliant; // it must be here because it enable/disable the use of coercions in the ast_manager.
     unsigned    m_timeout;
     bool        m_statistics;
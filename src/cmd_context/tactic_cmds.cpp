@@ -23,6 +23,7 @@ Notes:
 #include "util/scoped_timer.h"
 #include "util/scoped_ctrl_c.h"
 #include "util/cancel_eh.h"
+#include "util/event_trace.h"
 #include "model/model_smt2_pp.h"
 #include "ast/ast_smt2_pp.h"
 #include "tactic/tactic.h"
@@ -89,6 +90,7 @@ void help_tactic(cmd_context & ctx) {
     buf << "- (or-else <tactic>+) tries the given tactics in sequence until one of them succeeds (i.e., the first that doesn't fail).\n";
     buf << "- (par-or <tactic>+) executes the given tactics in parallel until one of them succeeds (i.e., the first that doesn't fail).\n";
     buf << "- (par-then <tactic1> <tactic2>) executes tactic1 and then tactic2 to every subgoal produced by tactic1. All subgoals are processed in parallel.\n";
+    buf << "- (par-components <tactic>) splits the goal into groups of assertions that share no uninterpreted symbols and executes tactic on every group in parallel.\n";
     buf << "- (try-for <tactic> <num>) executes the given tactic for at most <num> milliseconds, it fails if the execution takes more than <num> milliseconds.\n";
     buf << "- (if <probe> <tactic> <tactic>) if <probe> evaluates to true, then execute the first tactic. Otherwise execute the second.\n";
     buf << "- (when <probe> <tactic>) shorthand for (if <probe> <tactic> skip).\n";
@@ -461,6 +463,15 @@ static tactic * mk_par_then(cmd_context & ctx, sexpr * n) {
     return par_and_then(args.size(), args.c_ptr());
 }
 
+static tactic * mk_par_components(cmd_context & ctx, sexpr * n) {
+    SASSERT(n->is_composite());
+    unsigned num_children = n->get_num_children();
+    if (num_children != 2)
+        throw cmd_exception("invalid par-components combinator, one argument expected", n->get_line(), n->get_pos());
+    tactic * t = sexpr2tactic(ctx, n->get_child(1));
+    return par_components(t);
+}
+
 static tactic * mk_try_for(cmd_context & ctx, sexpr * n) {
     SASSERT(n->is_composite());
     unsigned num_children = n->get_num_children();
@@ -656,8 +667,12 @@ static tactic * mk_skip_if_failed(cmd_context & ctx, sexpr * n) {
 tactic * sexpr2tactic(cmd_context & ctx, sexpr * n) {
     if (n->is_symbol()) {
         tactic_cmd * cmd = ctx.find_tactic_cmd(n->get_symbol());
-        if (cmd != nullptr)
-            return cmd->mk(ctx.m());
+        if (cmd != nullptr) {
+            tactic * t = cmd->mk(ctx.m());
+            if (event_trace::enabled())
+                t = annotate_tactic(n->get_symbol().str().c_str(), t);
+            return t;
+        }
         sexpr * decl = ctx.find_user_tactic(n->get_symbol());
         if (decl != nullptr)
             return sexpr2tactic(ctx, decl);
@@ -681,6 +696,8 @@ tactic * sexpr2tactic(cmd_context & ctx, sexpr * n) {
             return mk_par(ctx, n);
         else if (cmd_name == "par-then")
             return mk_par_then(ctx, n);
+        else if (cmd_name == "par-components")
+            return mk_par_components(ctx, n);
         else if (cmd_name == "try-for")
             return mk_try_for(ctx, n);
         else if (cmd_name == "repeat")
@@ -37,13 +37,22 @@ void tactic_manager::insert(probe_info * p) {
     m_probes.push_back(p);
 }
 
+void tactic_manager::install() const {
+    tactic_manager & m = const_cast<tactic_manager&>(*this);
+    installer f = m_installer;
+    m.m_installer = nullptr;
+    f(m);
+}
+
 tactic_cmd * tactic_manager::find_tactic_cmd(symbol const & s) const {
+    init();
     tactic_cmd * c = nullptr;
     m_name2tactic.find(s, c);
     return c;
 }
 
 probe_info * tactic_manager::find_probe(symbol const & s) const {
+    init();
     probe_info * p = nullptr;
     m_name2probe.find(s, p);
     return p;
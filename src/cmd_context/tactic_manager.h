@@ -22,33 +22,45 @@ Notes:
 #include "util/dictionary.h"
 
 class tactic_manager {
+public:
+    typedef void (*installer)(tactic_manager & m);
 protected:
     dictionary<tactic_cmd*>  m_name2tactic;
     dictionary<probe_info*>  m_name2probe;
     ptr_vector<tactic_cmd>   m_tactics;
     ptr_vector<probe_info>   m_probes;
+    installer                m_installer;
     void finalize_tactic_cmds();
     void finalize_probes();
+    void install() const;
+    void init() const { if (m_installer) install(); }
 public:
+    tactic_manager(): m_installer(nullptr) {}
     ~tactic_manager();
 
+    /**
+       \brief Register a procedure that inserts the tactics and probes.
+       It is invoked the first time the tactics or probes are accessed.
+    */
+    void set_installer(installer f) { m_installer = f; }
+
     void insert(tactic_cmd * c);
     void insert(probe_info * p);
     tactic_cmd * find_tactic_cmd(symbol const & s) const; 
     probe_info * find_probe(symbol const & s) const; 
 
-    unsigned num_tactics() const { return m_tactics.size(); }
-    unsigned num_probes() const { return m_probes.size(); }
-    tactic_cmd * get_tactic(unsigned i) const { return m_tactics[i]; }
-    probe_info * get_probe(unsigned i) const { return m_probes[i]; }
+    unsigned num_tactics() const { init(); return m_tactics.size(); }
+    unsigned num_probes() const { init(); return m_probes.size(); }
+    tactic_cmd * get_tactic(unsigned i) const { init(); return m_tactics[i]; }
+    probe_info * get_probe(unsigned i) const { init(); return m_probes[i]; }
     
     typedef ptr_vector<tactic_cmd>::const_iterator tactic_cmd_iterator;
-    tactic_cmd_iterator begin_tactic_cmds() const { return m_tactics.begin(); }
-    tactic_cmd_iterator end_tactic_cmds() const { return m_tactics.end(); }
+    tactic_cmd_iterator begin_tactic_cmds() const { init(); return m_tactics.begin(); }
+    tactic_cmd_iterator end_tactic_cmds() const { init(); return m_tactics.end(); }
 
     typedef ptr_vector<probe_info>::const_iterator probe_iterator;
-    probe_iterator begin_probes() const { return m_probes.begin(); }
-    probe_iterator end_probes() const { return m_probes.end(); }
+    probe_iterator begin_probes() const { init(); return m_probes.begin(); }
+    probe_iterator end_probes() const { init(); return m_probes.end(); }
 };
 
 #endif
@@ -111,6 +111,7 @@ namespace dd {
     bool bdd_manager::check_result(op_entry*& e1, op_entry const* e2, BDD a, BDD b, BDD c) {
         if (e1 != e2) {
             SASSERT(e2->m_result != null_bdd);
+            m_stats.m_num_cache_hits++;
             push_entry(e1);
             e1 = nullptr;
             return true;            
@@ -119,6 +120,7 @@ namespace dd {
             e1->m_bdd1 = a;
             e1->m_bdd2 = b;
             e1->m_op = c;
+            m_stats.m_num_cache_misses++;
             SASSERT(e1->m_result == null_bdd);
             return false;        
         }
@@ -142,6 +144,8 @@ namespace dd {
             if (a == b) return false_bdd;
             if (is_false(a)) return b;
             if (is_false(b)) return a;
+            if (is_true(a)) return mk_not_rec(b);
+            if (is_true(b)) return mk_not_rec(a);
             break;
         default:
             UNREACHABLE();
@@ -746,6 +750,7 @@ namespace dd {
     }
 
     void bdd_manager::gc() {
+        m_stats.m_num_gc++;
         m_free_nodes.reset();
         IF_VERBOSE(13, verbose_stream() << "(bdd :gc " << m_nodes.size() << ")\n";);
         bool_vector reachable(m_nodes.size(), false);
@@ -879,6 +884,14 @@ namespace dd {
         return ok;
     }
 
+    void bdd_manager::collect_statistics(statistics& st) const {
+        st.update("bdd cache hits", m_stats.m_num_cache_hits);
+        st.update("bdd cache misses", m_stats.m_num_cache_misses);
+        st.update("bdd gc", m_stats.m_num_gc);
+        st.update("bdd nodes", m_nodes.size() - m_free_nodes.size());
+        st.update("bdd cache size", m_op_cache.size());
+    }
+
     std::ostream& bdd_manager::display(std::ostream& out) {
         m_reorder_rc.reserve(m_nodes.size());
         for (unsigned i = 0; i < m_nodes.size(); ++i) {
@@ -22,6 +22,7 @@ Revision History:
 #include "util/vector.h"
 #include "util/map.h"
 #include "util/small_object_allocator.h"
+#include "util/statistics.h"
 
 namespace dd {
 
@@ -102,7 +103,7 @@ namespace dd {
 
         struct eq_entry {
             bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_bdd1 == b->m_bdd2 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
+                return a->m_bdd1 == b->m_bdd1 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
             }
         };
 
@@ -131,6 +132,15 @@ namespace dd {
         cost_metric                m_cost_metric;
         BDD                        m_cost_bdd;
 
+        struct stats {
+            unsigned m_num_cache_hits;
+            unsigned m_num_cache_misses;
+            unsigned m_num_gc;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+        stats                      m_stats;
+
         BDD make_node(unsigned level, BDD l, BDD r);
         bool is_new_node() const { return m_is_new_node; }
 
@@ -224,6 +234,9 @@ namespace dd {
         std::ostream& display(std::ostream& out, bdd const& b);
 
         void gc();
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics() { m_stats.reset(); }
         void try_reorder();
         void try_cnf_reorder(bdd const& b);
     };
@@ -234,13 +247,14 @@ namespace dd {
         bdd_manager* m;
         bdd(unsigned root, bdd_manager* m): root(root), m(m) { m->inc_ref(root); }
     public:
-        bdd(bdd & other): root(other.root), m(other.m) { m->inc_ref(root); }
+        bdd(bdd const & other): root(other.root), m(other.m) { m->inc_ref(root); }
         bdd(bdd && other): root(0), m(other.m) { std::swap(root, other.root); }
         bdd& operator=(bdd const& other);
         ~bdd() { m->dec_ref(root); }
         bdd lo() const { return bdd(m->lo(root), m); }
         bdd hi() const { return bdd(m->hi(root), m); }
         unsigned var() const { return m->var(root); }
+        unsigned index() const { return root; }
 
         bool is_true() const { return root == bdd_manager::true_bdd; }
         bool is_false() const { return root == bdd_manager::false_bdd; }        
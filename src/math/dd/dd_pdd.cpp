@@ -143,6 +143,7 @@ namespace dd {
     bool pdd_manager::check_result(op_entry*& e1, op_entry const* e2, PDD a, PDD b, PDD c) {
         if (e1 != e2) {
             SASSERT(e2->m_result != null_pdd);
+            m_stats.m_num_cache_hits++;
             push_entry(e1);
             e1 = nullptr;
             return true;            
@@ -151,6 +152,7 @@ namespace dd {
             e1->m_pdd1 = a;
             e1->m_pdd2 = b;
             e1->m_op = c;
+            m_stats.m_num_cache_misses++;
             SASSERT(e1->m_result == null_pdd);
             return false;        
         }
@@ -825,6 +827,50 @@ namespace dd {
         reserve_var(i);
         return pdd(m_var2pdd[i], this);        
     }
+
+    pdd pdd_manager::translate(pdd const& p) {
+        pdd_manager& src = p.m;
+        if (&src == this)
+            return p;
+        SASSERT(src.m_semantics == m_semantics);
+        SASSERT(src.m_level2var.size() <= m_level2var.size());
+        DEBUG_CODE(for (unsigned l = 0; l < src.m_level2var.size(); ++l) SASSERT(m_level2var[l] == src.m_level2var[l]););
+        scoped_push _sp(*this);
+        u_map<PDD> cache;
+        svector<PDD> todo;
+        todo.push_back(p.root);
+        while (!todo.empty()) {
+            PDD r = todo.back();
+            if (cache.contains(r)) {
+                todo.pop_back();
+                continue;
+            }
+            PDD n = null_pdd;
+            if (src.is_val(r)) {
+                n = imk_val(src.val(r));
+            }
+            else {
+                PDD l = null_pdd, h = null_pdd;
+                bool ready = true;
+                if (!cache.find(src.lo(r), l)) {
+                    todo.push_back(src.lo(r));
+                    ready = false;
+                }
+                if (!cache.find(src.hi(r), h)) {
+                    todo.push_back(src.hi(r));
+                    ready = false;
+                }
+                if (!ready)
+                    continue;
+                n = make_node(src.level(r), l, h);
+            }
+            // keep translated nodes alive during garbage collection
+            push(n);
+            cache.insert(r, n);
+            todo.pop_back();
+        }
+        return pdd(cache.find(p.root), this);
+    }
     
     unsigned pdd_manager::dag_size(pdd const& b) {
         init_mark();
@@ -990,6 +1036,7 @@ namespace dd {
     }
 
     void pdd_manager::gc() {
+        m_stats.m_num_gc++;
         init_dmark();
         m_free_nodes.reset();
         SASSERT(well_formed());
@@ -1130,6 +1177,14 @@ namespace dd {
         return oklo && okhi;
     }
 
+    void pdd_manager::collect_statistics(statistics& st) const {
+        st.update("pdd cache hits", m_stats.m_num_cache_hits);
+        st.update("pdd cache misses", m_stats.m_num_cache_misses);
+        st.update("pdd gc", m_stats.m_num_gc);
+        st.update("pdd nodes", m_nodes.size() - m_free_nodes.size());
+        st.update("pdd cache size", m_op_cache.size());
+    }
+
     std::ostream& pdd_manager::display(std::ostream& out) {
         for (unsigned i = 0; i < m_nodes.size(); ++i) {
             node const& n = m_nodes[i];
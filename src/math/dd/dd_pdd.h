@@ -34,6 +34,7 @@ Author:
 #include "util/vector.h"
 #include "util/map.h"
 #include "util/small_object_allocator.h"
+#include "util/statistics.h"
 #include "util/rational.h"
 
 namespace dd {
@@ -135,7 +136,7 @@ namespace dd {
 
         struct eq_entry {
             bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_pdd1 == b->m_pdd2 && a->m_pdd2 == b->m_pdd2 && a->m_op == b->m_op;
+                return a->m_pdd1 == b->m_pdd1 && a->m_pdd2 == b->m_pdd2 && a->m_op == b->m_op;
             }
         };
 
@@ -165,6 +166,15 @@ namespace dd {
         unsigned_vector            m_free_values;
         rational                   m_freeze_value;
 
+        struct stats {
+            unsigned m_num_cache_hits;
+            unsigned m_num_cache_misses;
+            unsigned m_num_gc;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+        stats                      m_stats;
+
         void reset_op_cache();
         void init_nodes(unsigned_vector const& l2v);
         void init_vars(unsigned_vector const& l2v);
@@ -260,6 +270,7 @@ namespace dd {
 
         void reset(unsigned_vector const& level2var);
         void set_max_num_nodes(unsigned n) { m_max_num_nodes = n; }
+        unsigned get_max_num_nodes() const { return m_max_num_nodes; }
         unsigned_vector const& get_level2var() const { return m_level2var; }
 
         pdd mk_var(unsigned i);
@@ -280,6 +291,12 @@ namespace dd {
         pdd reduce(pdd const& a, pdd const& b);
         pdd subst_val(pdd const& a, vector<std::pair<unsigned, rational>> const& s);
 
+        /**
+           \brief copy p, which belongs to a manager with the same variable order.
+           The manager of p is only read.
+        */
+        pdd translate(pdd const& p);
+
         bool is_linear(PDD p) { return degree(p) == 1; }
         bool is_linear(pdd const& p);
 
@@ -307,6 +324,9 @@ namespace dd {
         std::ostream& display(std::ostream& out, pdd const& b);
 
         void gc();
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics() { m_stats.reset(); }
     };
 
     class pdd {
@@ -14,6 +14,7 @@
 #include "math/grobner/pdd_solver.h"
 #include "math/grobner/pdd_simplifier.h"
 #include "util/uint_set.h"
+#include "util/thread_pool.h"
 #include <math.h>
 
 
@@ -183,12 +184,19 @@ namespace dd {
             }
         };
 
+        vector<pdd> reduced;
+        bool is_reduced = reduce_parallel(set, eq, reduced);
         scoped_update sr(set);
         for (; sr.i < sr.sz; ++sr.i) {
             equation& target = *set[sr.i];
             bool changed_leading_term = false;
             bool simplified = true;
-            simplified = !done() && try_simplify_using(target, eq, changed_leading_term); 
+            if (done())
+                simplified = false;
+            else if (is_reduced)
+                simplified = try_simplify_using(target, eq, reduced[sr.i], changed_leading_term);
+            else
+                simplified = try_simplify_using(target, eq, changed_leading_term); 
             
             if (simplified && is_trivial(target)) {
                 retire(&target);
@@ -221,6 +229,16 @@ namespace dd {
         m_stats.incr_simplified();
         pdd t = src.poly();
         pdd r = dst.poly().reduce(t);
+        return try_simplify_using(dst, src, r, changed_leading_term);
+    }
+
+    /*
+      update target to r, the reduction of target by source.
+     */
+    bool solver::try_simplify_using(equation& dst, equation const& src, pdd const& r, bool& changed_leading_term) {
+        if (&src == &dst) {
+            return false;
+        }
         if (r == dst.poly()){
             return false;
         }
@@ -230,7 +248,7 @@ namespace dd {
         }
         TRACE("dd.solver", 
               tout << "reduce: " << dst.poly() << "\n";
-              tout << "using:  " << t << "\n";
+              tout << "using:  " << src.poly() << "\n";
               tout << "to:     " << r << "\n";);
         changed_leading_term = dst.state() == processed && m.different_leading_term(r, dst.poly());
         dst = r;
@@ -239,6 +257,63 @@ namespace dd {
         return true;
     }
 
+    /*
+      Reduce the polynomials of set by eq using m_config.m_threads threads.
+      pdd managers are not thread safe, so each thread copies the polynomials
+      it reduces into its own manager and only reads m. The reductions are
+      copied back into m after all threads have finished.
+      Return false if the set is too small or a thread failed; the caller
+      then reduces the set sequentially.
+     */
+    bool solver::reduce_parallel(equation_vector const& set, equation const& eq, vector<pdd>& reduced) {
+        static const unsigned MIN_EQS_PER_THREAD = 16;
+        unsigned k = std::min(m_config.m_threads, set.size() / MIN_EQS_PER_THREAD);
+        if (k <= 1 || done()) {
+            return false;
+        }
+        unsigned_vector const& l2v = m.get_level2var();
+        while (m_workers.size() < k) {
+            m_workers.push_back(alloc(pdd_manager, 0, m.get_semantics()));
+        }
+        for (unsigned t = 0; t < k; ++t) {
+            pdd_manager& w = *m_workers[t];
+            if (!(w.get_level2var() == l2v)) {
+                w.reset(l2v);
+            }
+            w.set_max_num_nodes(m.get_max_num_nodes());
+        }
+        vector<vector<pdd>> results(k);
+        bool_vector changed(set.size(), false);
+        bool_vector failed(k, false);
+        thread_pool::run(k, [&](unsigned t) {
+            pdd_manager& w = *m_workers[t];
+            try {
+                pdd q = w.translate(eq.poly());
+                for (unsigned i = t; i < set.size() && !m_limit.get_cancel_flag(); i += k) {
+                    pdd p = w.translate(set[i]->poly());
+                    pdd r = w.reduce(p, q);
+                    changed[i] = r != p;
+                    results[t].push_back(r);
+                }
+            }
+            catch (pdd_manager::mem_out) {
+                failed[t] = true;
+            }
+            catch (z3_exception&) {
+                failed[t] = true;
+            }
+        });
+        if (canceled() || failed.contains(true)) {
+            return false;
+        }
+        reduced.reset();
+        for (unsigned i = 0; i < set.size(); ++i) {
+            m_stats.incr_simplified();
+            reduced.push_back(changed[i] ? m.translate(results[i % k][i / k]) : set[i]->poly());
+        }
+        return true;
+    }
+
     void solver::simplify_using(equation & dst, equation const& src, bool& changed_leading_term) {
         if (&src == &dst) return;        
         m_stats.incr_simplified();
@@ -423,6 +498,7 @@ namespace dd {
         st.update("dd.solver.to_simplify", m_to_simplify.size());
         st.update("dd.solver.degree", m_stats.m_max_expr_degree);
         st.update("dd.solver.size", m_stats.m_max_expr_size);
+        m.collect_statistics(st);
     }
             
     std::ostream& solver::display(std::ostream & out, const equation & eq) const {
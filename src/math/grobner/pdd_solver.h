@@ -23,6 +23,7 @@
 #include "util/obj_hashtable.h"
 #include "util/region.h"
 #include "util/rlimit.h"
+#include "util/scoped_ptr_vector.h"
 #include "util/statistics.h"
 #include "math/dd/dd_pdd.h"
 
@@ -59,6 +60,7 @@ public:
         unsigned m_expr_size_growth;
         unsigned m_expr_degree_growth;
         unsigned m_number_of_conflicts_to_report;
+        unsigned m_threads;
         config() :
             m_eqs_threshold(UINT_MAX),
             m_expr_size_limit(UINT_MAX),
@@ -70,7 +72,8 @@ public:
             m_eqs_growth(10),
             m_expr_size_growth(10),
             m_expr_degree_growth(5),
-            m_number_of_conflicts_to_report(1)
+            m_number_of_conflicts_to_report(1),
+            m_threads(1)
         {}
     };
 
@@ -121,6 +124,7 @@ private:
     equation_vector                              m_all_eqs;
     equation*                                    m_conflict;   
     bool                                         m_too_complex;
+    scoped_ptr_vector<pdd_manager>               m_workers;    // managers of the threads used by reduce_parallel
 public:
     solver(reslimit& lim, pdd_manager& m);
     ~solver();
@@ -160,6 +164,8 @@ private:
     void simplify_using(equation_vector& set, equation const& eq);
     void simplify_using(equation & dst, equation const& src, bool& changed_leading_term);
     bool try_simplify_using(equation& target, equation const& source, bool& changed_leading_term);
+    bool try_simplify_using(equation& target, equation const& source, pdd const& r, bool& changed_leading_term);
+    bool reduce_parallel(equation_vector const& set, equation const& eq, vector<pdd>& reduced);
 
     bool is_trivial(equation const& eq) const { return eq.poly().is_zero(); }    
     bool is_simpler(equation const& eq1, equation const& eq2) { return m.lm_lt(eq1.poly(), eq2.poly()); }
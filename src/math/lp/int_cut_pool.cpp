@@ -0,0 +1,145 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    int_cut_pool.cpp
+
+Abstract:
+
+    Pool of Gomory and HNF cuts.
+
+Author:
+    Nikolaj Bjorner (nbjorner)
+    Lev Nachmanson (levnach)
+
+Revision History:
+--*/
+
+#include "math/lp/int_solver.h"
+#include "math/lp/lar_solver.h"
+#include "math/lp/int_cut_pool.h"
+
+namespace lp {
+
+    // cuts that were not produced during this many calls are retired
+#define CUT_POOL_MAX_AGE 1000
+
+    int_cut_pool::int_cut_pool(int_solver& lia): lia(lia), lra(lia.lra), m_num_calls(0) {}
+
+    void int_cut_pool::normalize(lar_term const& t, mpq const& k, bool upper, explanation const& ex, cut& c) const {
+        c.m_coeffs.reset();
+        for (auto const& p : t)
+            c.m_coeffs.push_back(std::make_pair(p.column().index(), p.coeff()));
+        std::sort(c.m_coeffs.begin(), c.m_coeffs.end(),
+                  [](std::pair<unsigned, mpq> const& a, std::pair<unsigned, mpq> const& b) { return a.first < b.first; });
+        c.m_k = k;
+        c.m_upper = upper;
+        c.m_ex.reset();
+        for (auto const& e : ex)
+            c.m_ex.push_back(e.ci());
+        std::sort(c.m_ex.begin(), c.m_ex.end());
+        c.m_hash = k.hash() + upper;
+        c.m_max_column = 0;
+        for (auto const& p : c.m_coeffs) {
+            c.m_hash = combine_hash(c.m_hash, combine_hash(p.first, p.second.hash()));
+            c.m_max_column = std::max(c.m_max_column, p.first);
+        }
+        c.m_max_ci = c.m_ex.empty() ? 0 : c.m_ex.back();
+        c.m_activity = 1;
+        c.m_last_use = m_num_calls;
+    }
+
+    bool int_cut_pool::same_cut(cut const& a, cut const& b) const {
+        return a.m_hash == b.m_hash && a.m_upper == b.m_upper && a.m_k == b.m_k && a.m_coeffs == b.m_coeffs;
+    }
+
+    bool int_cut_pool::is_violated(cut const& c) const {
+        impq v;
+        for (auto const& p : c.m_coeffs)
+            v += p.second * lia.get_value(p.first);
+        return c.m_upper ? v > impq(c.m_k) : v < impq(c.m_k);
+    }
+
+    bool int_cut_pool::is_justified(cut const& c) const {
+        for (constraint_index ci : c.m_ex)
+            if (!lra.constraints().is_active(ci))
+                return false;
+        return true;
+    }
+
+    /**
+       \brief remove the cuts that refer to popped columns or constraints and the cuts that
+       were not used recently.
+    */
+    void int_cut_pool::remove_stale_cuts() {
+        unsigned columns_mark = lra.columns_mark();
+        unsigned constraints_mark = lra.constraints_mark();
+        lra.reset_pop_marks();
+        unsigned j = 0;
+        for (unsigned i = 0; i < m_cuts.size(); ++i) {
+            cut& c = m_cuts[i];
+            if (c.m_max_column >= columns_mark || (!c.m_ex.empty() && c.m_max_ci >= constraints_mark))
+                continue;
+            if (m_num_calls - c.m_last_use > CUT_POOL_MAX_AGE)
+                continue;
+            if (i != j)
+                m_cuts[j] = c;
+            ++j;
+        }
+        m_cuts.shrink(j);
+    }
+
+    lia_move int_cut_pool::operator()() {
+        ++m_num_calls;
+        remove_stale_cuts();
+        for (cut& c : m_cuts) {
+            if (!is_violated(c) || !is_justified(c))
+                continue;
+            lia.m_t.clear();
+            for (auto const& p : c.m_coeffs)
+                lia.m_t.add_monomial(p.second, p.first);
+            lia.m_k = c.m_k;
+            lia.m_upper = c.m_upper;
+            lia.m_ex->clear();
+            for (constraint_index ci : c.m_ex)
+                lia.m_ex->push_back(ci);
+            c.m_activity++;
+            c.m_last_use = m_num_calls;
+            lia.settings().stats().m_cut_pool_reuses++;
+            TRACE("int_cut_pool", tout << "reuse cut of activity " << c.m_activity << "\n";);
+            return lia_move::cut;
+        }
+        return lia_move::undef;
+    }
+
+    void int_cut_pool::add(lar_term const& t, mpq const& k, bool upper, explanation const& ex) {
+        unsigned max_size = lia.settings().m_int_cut_pool_size;
+        if (max_size == 0)
+            return;
+        cut c;
+        normalize(t, k, upper, ex, c);
+        for (cut& d : m_cuts) {
+            if (same_cut(c, d)) {
+                // keep the justification that holds now
+                d.m_ex.swap(c.m_ex);
+                d.m_max_ci = c.m_max_ci;
+                d.m_activity++;
+                d.m_last_use = m_num_calls;
+                return;
+            }
+        }
+        if (m_cuts.size() < max_size) {
+            m_cuts.push_back(c);
+            return;
+        }
+        unsigned worst = 0;
+        for (unsigned i = 1; i < m_cuts.size(); ++i) {
+            cut const& d = m_cuts[i];
+            cut const& w = m_cuts[worst];
+            if (d.m_activity < w.m_activity || (d.m_activity == w.m_activity && d.m_last_use < w.m_last_use))
+                worst = i;
+        }
+        m_cuts[worst] = c;
+    }
+}
@@ -0,0 +1,66 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    int_cut_pool.h
+
+Abstract:
+
+    Pool of Gomory and HNF cuts.
+
+    Cuts produced by the integer solver are kept in a normalized form
+    together with the constraints that justify them. When the search
+    returns to a state where a stored cut is violated and its
+    justification holds, the cut is returned again instead of being
+    recomputed. Cuts that are not used for a while are retired, and
+    when the pool is full the cut with the lowest activity is replaced.
+
+    A cut refers to columns and constraints of the lar_solver. Once
+    one of them is popped the index may be reused, so such cuts are
+    removed, based on the pop marks maintained by lar_solver.
+
+Author:
+    Nikolaj Bjorner (nbjorner)
+    Lev Nachmanson (levnach)
+
+Revision History:
+--*/
+#pragma once
+
+#include "math/lp/lia_move.h"
+#include "math/lp/lar_term.h"
+#include "math/lp/explanation.h"
+
+namespace lp {
+    class int_solver;
+    class lar_solver;
+    class int_cut_pool {
+        struct cut {
+            vector<std::pair<unsigned, mpq>> m_coeffs; // sorted by column
+            mpq                       m_k;
+            bool                      m_upper;
+            svector<constraint_index> m_ex;
+            unsigned                  m_hash;
+            unsigned                  m_max_column;
+            unsigned                  m_max_ci;
+            unsigned                  m_activity;  // number of times the cut was produced
+            unsigned                  m_last_use;  // value of m_num_calls when the cut was last produced
+        };
+        class int_solver& lia;
+        class lar_solver& lra;
+        vector<cut>        m_cuts;
+        unsigned           m_num_calls;
+
+        void normalize(lar_term const& t, mpq const& k, bool upper, explanation const& ex, cut& c) const;
+        bool same_cut(cut const& a, cut const& b) const;
+        bool is_violated(cut const& c) const;
+        bool is_justified(cut const& c) const;
+        void remove_stale_cuts();
+    public:
+        int_cut_pool(int_solver& lia);
+        lia_move operator()();
+        void add(lar_term const& t, mpq const& k, bool upper, explanation const& ex);
+        unsigned size() const { return m_cuts.size(); }
+    };
+}
@@ -119,7 +119,8 @@ int_solver::int_solver(lar_solver& lar_slv) :
     m_patcher(*this),
     m_number_of_calls(0),
     m_hnf_cutter(*this),
-    m_hnf_cut_period(settings().hnf_cut_period()) {
+    m_hnf_cut_period(settings().hnf_cut_period()),
+    m_cut_pool(*this) {
     lra.set_int_solver(this);
 }
 
@@ -162,12 +163,19 @@ lia_move int_solver::check(lp::explanation * e) {
     ++m_number_of_calls;
     if (r == lia_move::undef && m_patcher.should_apply()) r = m_patcher();
     if (r == lia_move::undef && should_find_cube()) r = cube();
-    if (r == lia_move::undef && should_hnf_cut()) r = hnf_cut();
-    if (r == lia_move::undef && should_gomory_cut()) r = gc();
+    if (r == lia_move::undef && settings().m_int_cut_pool_size > 0) r = m_cut_pool();
+    if (r == lia_move::undef && should_hnf_cut()) r = add_to_cut_pool(hnf_cut());
+    if (r == lia_move::undef && should_gomory_cut()) r = add_to_cut_pool(gc());
     if (r == lia_move::undef) r = branch();
     return r;
 }
 
+lia_move int_solver::add_to_cut_pool(lia_move r) {
+    if (r == lia_move::cut) 
+        m_cut_pool.add(m_t, m_k, m_upper, *m_ex);
+    return r;
+}
+
 std::ostream& int_solver::display_inf_rows(std::ostream& out) const {
     unsigned num = lra.A_r().column_count();
     for (unsigned v = 0; v < num; v++) {
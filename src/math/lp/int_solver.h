@@ -25,6 +25,7 @@ Revision History:
 #include "math/lp/lar_constraints.h"
 #include "math/lp/hnf_cutter.h"
 #include "math/lp/int_gcd_test.h"
+#include "math/lp/int_cut_pool.h"
 #include "math/lp/lia_move.h"
 #include "math/lp/explanation.h"
 
@@ -39,6 +40,7 @@ class int_solver {
     friend class int_branch;
     friend class int_gcd_test;
     friend class hnf_cutter;
+    friend class int_cut_pool;
 
     class patcher {
         int_solver&         lia;
@@ -68,6 +70,7 @@ class int_solver {
     bool                m_upper;           // we have a cut m_t*x <= k if m_upper is true nad m_t*x >= k otherwise
     hnf_cutter          m_hnf_cutter;
     unsigned            m_hnf_cut_period;
+    int_cut_pool        m_cut_pool;
 
 public:
     int_solver(lar_solver& lp);
@@ -101,6 +104,7 @@ private:
     bool should_find_cube();
     bool should_gomory_cut();
     bool should_hnf_cut();
+    lia_move add_to_cut_pool(lia_move r);
 
     lp_settings& settings();
     const lp_settings& settings() const;
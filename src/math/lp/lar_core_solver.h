@@ -227,7 +227,28 @@ public:
     }
 
     
+    // The factorization of cs represents the basis before the pop. Without the tableau it is
+    // still valid if the pop restores the same basis and the number of rows did not change.
+    template <typename T, typename X>
+    void reuse_or_delete_factorization(lp_core_solver_base<T, X> & cs, vector<unsigned> const & basis_before_pop) {
+        auto & f = cs.m_factorization;
+        if (f == nullptr)
+            return;
+        if (!settings().use_tableau() && f->get_status() == LU_status::OK &&
+            f->m_dim == cs.m_A.row_count() && cs.m_basis == basis_before_pop) {
+            ++settings().stats().m_reused_factorizations;
+            return;
+        }
+        delete f;
+        f = nullptr;
+    }
+    
     void pop(unsigned k) {
+        vector<unsigned> r_basis, d_basis;
+        if (m_r_solver.m_factorization != nullptr)
+            r_basis = m_r_basis;
+        if (m_d_solver.m_factorization != nullptr)
+            d_basis = m_d_basis;
         // rationals
         if (!settings().use_tableau()) 
             m_r_A.pop(k);
@@ -235,8 +256,6 @@ public:
         m_r_upper_bounds.pop(k);
         m_column_types.pop(k);
         
-        delete m_r_solver.m_factorization;
-        m_r_solver.m_factorization = nullptr;
         m_r_x.resize(m_r_A.column_count());
         m_r_solver.m_costs.resize(m_r_A.column_count());
         m_r_solver.m_d.resize(m_r_A.column_count());
@@ -244,11 +263,10 @@ public:
             pop_markowitz_counts(k);
         m_d_A.pop(k);
         // doubles
-        delete m_d_solver.m_factorization;
-        m_d_solver.m_factorization = nullptr;
-        
         m_d_x.resize(m_d_A.column_count());
         pop_basis(k);
+        reuse_or_delete_factorization(m_r_solver, r_basis);
+        reuse_or_delete_factorization(m_d_solver, d_basis);
         m_stacked_simplex_strategy.pop(k);
         settings().simplex_strategy() = m_stacked_simplex_strategy;
         lp_assert(m_r_solver.basis_heading_is_correct());
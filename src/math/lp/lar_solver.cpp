@@ -1,3 +1,6 @@
+#include <mutex>
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
 #include "math/lp/lar_solver.h"
 /*
   Copyright (c) 2017 Microsoft Corporation
@@ -25,7 +28,9 @@ lar_solver::lar_solver() : m_status(lp_status::UNKNOWN),
                            m_need_register_terms(false),
                            m_var_register(false),
                            m_term_register(true),
-                           m_constraints(*this)
+                           m_constraints(*this),
+                           m_columns_mark(0),
+                           m_constraints_mark(0)
 {}
     
 void lar_solver::set_track_pivoted_rows(bool v) {
@@ -253,10 +258,60 @@ void lar_solver::propagate_bounds_on_terms(lp_bound_propagator & bp) {
     }
 }
 
+#define PARALLEL_BOUND_PROPAGATION_MIN_ROWS 256
+
+// Rows are analyzed by several threads, each collecting the candidate bounds of a
+// contiguous block of rows. The candidates are then passed to bp block by block,
+// in the same order as in the sequential loop, so bp ends up with the same bounds.
+bool lar_solver::propagate_bounds_for_touched_rows_parallel(lp_bound_propagator & bp) {
+#ifdef SINGLE_THREAD
+    return false;
+#else
+    unsigned num_threads = settings().bound_propagation_threads;
+    unsigned num_rows = m_rows_with_changed_bounds.size();
+    if (num_threads <= 1 || num_rows < PARALLEL_BOUND_PROPAGATION_MIN_ROWS)
+        return false;
+    num_threads = std::min(num_threads, num_rows / (PARALLEL_BOUND_PROPAGATION_MIN_ROWS / 2));
+    unsigned_vector rows;
+    for (unsigned i : m_rows_with_changed_bounds)
+        rows.push_back(i);
+    scoped_ptr_vector<lp_bound_recorder> recorders;
+    for (unsigned t = 0; t < num_threads; ++t)
+        recorders.push_back(alloc(lp_bound_recorder, *this));
+    std::mutex mux;
+    bool has_exception = false;
+    std::string ex_msg;
+    unsigned block = (num_rows + num_threads - 1) / num_threads;
+    auto worker_thread = [&](unsigned t) {
+        try {
+            unsigned end = std::min(num_rows, (t + 1) * block);
+            for (unsigned k = t * block; k < end; ++k)
+                analyze_new_bounds_on_row_tableau(rows[k], *recorders[t]);
+        }
+        catch (z3_exception & ex) {
+            std::lock_guard<std::mutex> lock(mux);
+            has_exception = true;
+            ex_msg = ex.msg();
+        }
+    };
+    thread_pool::run(num_threads, worker_thread);
+    if (has_exception)
+        throw default_exception(std::move(ex_msg));
+    for (lp_bound_recorder * r : recorders)
+        r->replay(bp);
+    return true;
+#endif
+}
+
 // goes over touched rows and tries to induce bounds
 void lar_solver::propagate_bounds_for_touched_rows(lp_bound_propagator & bp) {
     if (!use_tableau())
         return; // todo: consider to remove the restriction
+
+    if (propagate_bounds_for_touched_rows_parallel(bp)) {
+        m_rows_with_changed_bounds.clear();
+        return;
+    }
     
     for (unsigned i : m_rows_with_changed_bounds) {
         calculate_implied_bounds_for_row(i, bp);
@@ -369,6 +424,8 @@ void lar_solver::pop(unsigned k) {
         
         
     m_constraints.pop(k);
+    m_columns_mark = std::min(m_columns_mark, n);
+    m_constraints_mark = std::min(m_constraints_mark, m_constraints.size());
     m_term_count.pop(k);
     for (unsigned i = m_term_count; i < m_terms.size(); i++) {
         if (m_need_register_terms)
@@ -87,6 +87,10 @@ class lar_solver : public column_namer {
     var_register                                        m_term_register;
     stacked_vector<ul_pair>                             m_columns_to_ul_pairs;
     constraint_set                                      m_constraints;
+    // the least number of columns and constraints since the last reset_pop_marks,
+    // indices at or above the marks may have been reused after a pop
+    unsigned                                            m_columns_mark;
+    unsigned                                            m_constraints_mark;
     // the set of column indices j such that bounds have changed for j
     u_set                                               m_columns_with_changed_bound;
     u_set                                               m_rows_with_changed_bounds;
@@ -288,6 +292,7 @@ public:
     void random_update(unsigned sz, var_index const * vars);
     void propagate_bounds_on_terms(lp_bound_propagator & bp);
     void propagate_bounds_for_touched_rows(lp_bound_propagator & bp);    
+    bool propagate_bounds_for_touched_rows_parallel(lp_bound_propagator & bp);
     bool is_fixed(column_index const& j) const { return column_is_fixed(j); }
     inline column_index to_column_index(unsigned v) const { return column_index(external_to_column_index(v)); }
     bool external_is_used(unsigned) const;
@@ -422,6 +427,9 @@ public:
     inline lar_term const& term(unsigned i) const { return *m_terms[i]; }
     inline void set_int_solver(int_solver * int_slv) { m_int_solver = int_slv; }
     inline int_solver * get_int_solver() { return m_int_solver; }
+    unsigned columns_mark() const { return m_columns_mark; }
+    unsigned constraints_mark() const { return m_constraints_mark; }
+    void reset_pop_marks() { m_columns_mark = column_count(); m_constraints_mark = m_constraints.size(); }
     inline const lar_term & get_term(tv const& t) const { lp_assert(t.is_term()); return *m_terms[t.id()]; }
     lp_status find_feasible_solution();   
     void move_non_basic_columns_to_bounds();
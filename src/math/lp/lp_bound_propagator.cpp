@@ -5,7 +5,9 @@
 #include "math/lp/lar_solver.h"
 namespace lp {
 lp_bound_propagator::lp_bound_propagator(lar_solver & ls):
-    m_lar_solver(ls) {}
+    m_lar_solver(ls), m_record_only(false) {}
+lp_bound_propagator::lp_bound_propagator(lar_solver & ls, bool record_only):
+    m_lar_solver(ls), m_record_only(record_only) {}
 column_type lp_bound_propagator::get_column_type(unsigned j) const {
     return m_lar_solver.get_column_type(j);
 }
@@ -16,6 +18,10 @@ const impq & lp_bound_propagator::get_upper_bound(unsigned j) const {
     return m_lar_solver.get_upper_bound(j);
 }
 void lp_bound_propagator::try_add_bound(mpq const& v, unsigned j, bool is_low, bool coeff_before_j_is_pos, unsigned row_or_term_index, bool strict) {
+    if (m_record_only) {
+        m_ibounds.push_back(implied_bound(v, j, is_low, coeff_before_j_is_pos, row_or_term_index, strict));
+        return;
+    }
     j = m_lar_solver.adjust_column_index_to_term_index(j);    
 
     lconstraint_kind kind = is_low? GE : LE;
@@ -51,4 +57,9 @@ void lp_bound_propagator::try_add_bound(mpq const& v, unsigned j, bool is_low, b
         }
      }
 }
+
+void lp_bound_recorder::replay(lp_bound_propagator & bp) const {
+    for (implied_bound const& ib : m_ibounds) 
+        bp.try_add_bound(ib.m_bound, ib.m_j, ib.m_is_lower_bound, ib.m_coeff_before_j_is_pos, ib.m_row_or_term_index, ib.m_strict);
+}
 }
@@ -10,8 +10,11 @@ class lp_bound_propagator {
     std::unordered_map<unsigned, unsigned> m_improved_lower_bounds; // these maps map a column index to the corresponding index in ibounds
     std::unordered_map<unsigned, unsigned> m_improved_upper_bounds;
     lar_solver & m_lar_solver;
+    bool m_record_only; // keep every candidate bound in m_ibounds, see lp_bound_recorder
 public:
     vector<implied_bound> m_ibounds;
+protected:
+    lp_bound_propagator(lar_solver & ls, bool record_only);
 public:
     lp_bound_propagator(lar_solver & ls);
     column_type get_column_type(unsigned) const;
@@ -24,4 +27,14 @@ public:
     unsigned number_of_found_bounds() const { return m_ibounds.size(); }
     virtual void consume(mpq const& v, lp::constraint_index j) = 0;
 };
+
+// Collects the candidate bounds of a set of rows without filtering or merging them.
+// The bounds are passed later, in order, to another propagator using replay.
+// Used by the parallel bound propagation, it only reads the state of the lar_solver.
+class lp_bound_recorder : public lp_bound_propagator {
+public:
+    lp_bound_recorder(lar_solver & ls) : lp_bound_propagator(ls, true) {}
+    void consume(mpq const& v, lp::constraint_index j) override { UNREACHABLE(); }
+    void replay(lp_bound_propagator & bp) const;
+};
 }
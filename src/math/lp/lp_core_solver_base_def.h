@@ -633,10 +633,11 @@ pivot_column_tableau(unsigned j, unsigned piv_row_index) {
         m_A.m_rows[piv_row_index][column[0].m_offset].m_offset = 0;
         m_A.m_rows[c.var()][c.m_offset].m_offset = pivot_col_cell_index;
     }
+    m_A.set_pivot_row(piv_row_index, j);
     while (column.size() > 1) {
         auto & c = column.back();
         lp_assert(c.var() != piv_row_index);
-        if(! m_A.pivot_row_to_row_given_cell(piv_row_index, c, j)) {
+        if(! m_A.pivot_row_to_row_given_cell(c)) {
             return false;
         }
         if (m_pivoted_rows!= nullptr)
@@ -94,6 +94,7 @@ struct statistics {
     unsigned m_total_iterations;
     unsigned m_iters_with_no_cost_growing;
     unsigned m_num_factorizations;
+    unsigned m_reused_factorizations;
     unsigned m_num_of_implied_bounds;
     unsigned m_need_to_solve_inf;
     unsigned m_max_cols;
@@ -112,6 +113,7 @@ struct statistics {
     unsigned m_cross_nested_forms;
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
+    unsigned m_cut_pool_reuses;
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
 };
@@ -187,10 +189,12 @@ public:
     double           density_threshold;
     bool             use_breakpoints_in_feasibility_search;
     unsigned         max_row_length_for_bound_propagation;
+    unsigned         bound_propagation_threads;
     bool             backup_costs;
     unsigned         column_number_threshold_for_using_lu_in_lar_solver;
     unsigned         m_int_gomory_cut_period;
     unsigned         m_int_find_cube_period;
+    unsigned         m_int_cut_pool_size;
 private:
     unsigned         m_hnf_cut_period;
 public:
@@ -260,10 +264,12 @@ public:
                     density_threshold(0.7),
                     use_breakpoints_in_feasibility_search(false),
                     max_row_length_for_bound_propagation(300),
+                    bound_propagation_threads(1),
                     backup_costs(true),
                     column_number_threshold_for_using_lu_in_lar_solver(4000),
                     m_int_gomory_cut_period(4),
                     m_int_find_cube_period(4),
+                    m_int_cut_pool_size(0),
                     m_hnf_cut_period(4),
                     m_int_run_gcd_test(true),
                     m_int_pivot_fixed_vars_from_basis(false),
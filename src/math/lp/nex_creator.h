@@ -9,6 +9,7 @@
 #include <map>
 #include <set>
 #include "util/map.h"
+#include "util/small_object_allocator.h"
 #include "math/lp/nex.h"
 namespace nla {
 
@@ -28,6 +29,7 @@ struct occ {
 // sort them, and delete them
 
 class nex_creator {
+    small_object_allocator                       m_alloc;
     ptr_vector<nex>                              m_allocated;
     std::unordered_map<lpvar, occ>               m_occurences_map;
     std::unordered_map<lpvar, unsigned>          m_powers;
@@ -58,11 +60,30 @@ private:
     const svector<unsigned>& active_vars_weights() const { return m_active_vars_weights; }
 
     nex_mul* mk_mul(const vector<nex_pow>& v) {
-        auto r = alloc(nex_mul, rational::zero(), v);
+        return mk_nex<nex_mul>(rational::zero(), v);
+    }
+
+    // the nodes are allocated from free lists that are reused after pop and clear.
+    template <typename T, typename...Args>
+    T* mk_nex(Args&&... args) {
+        T* r = new (m_alloc.allocate(sizeof(T))) T(std::forward<Args>(args)...);
         add_to_allocated(r);
         return r;
     }
 
+    void del_nex(nex* e) {
+        size_t sz = 0;
+        switch (e->type()) {
+        case expr_type::SCALAR: sz = sizeof(nex_scalar); break;
+        case expr_type::VAR:    sz = sizeof(nex_var); break;
+        case expr_type::SUM:    sz = sizeof(nex_sum); break;
+        case expr_type::MUL:    sz = sizeof(nex_mul); break;
+        default: UNREACHABLE(); break;
+        }
+        e->~nex();
+        m_alloc.deallocate(sz, e);
+    }
+
     void mul_args() { }
 
     template <typename K>
@@ -140,18 +161,18 @@ public:
     // because of 'rational' (and m_children in nex_mul unless we get rid of this)
     void pop(unsigned sz) {
         for (unsigned j = sz; j < m_allocated.size(); j++)
-            dealloc(m_allocated[j]);
+            del_nex(m_allocated[j]);
         m_allocated.resize(sz);
         TRACE("grobner_stats_d", tout << "m_allocated.size() = " << m_allocated.size() << "\n";);
     }
 
     void clear() {
         for (auto e : m_allocated)
-            dealloc(e);
+            del_nex(e);
         m_allocated.clear();
     }
 
-    nex_creator() : m_mk_mul(*this) {}
+    nex_creator() : m_alloc("nex"), m_mk_mul(*this) {}
 
     ~nex_creator() {
         clear();
@@ -170,9 +191,7 @@ public:
         void operator*=(nex const* n) { m_args.push_back(nex_pow(n, 1)); }
         bool empty() const { return m_args.empty(); }
         nex_mul* mk() {
-            auto r = alloc(nex_mul, m_coeff, m_args);
-            c.add_to_allocated(r); 
-            return r;  
+            return c.mk_nex<nex_mul>(m_coeff, m_args);
         }
         nex* mk_reduced() {
             if (m_args.empty()) return c.mk_scalar(m_coeff);
@@ -201,9 +220,7 @@ public:
     }
 
     nex_sum* mk_sum(const ptr_vector<nex>& v) {  
-        auto r = alloc(nex_sum, v);
-        add_to_allocated(r);
-        return r;
+        return mk_nex<nex_sum>(v);
     }
     
     template <typename K, typename...Args>
@@ -215,15 +232,11 @@ public:
     }
 
     nex_var* mk_var(lpvar j) {
-        auto r = alloc(nex_var, j);
-        add_to_allocated(r);
-        return r;
+        return mk_nex<nex_var>(j);
     }
     
     nex_mul* mk_mul() {
-        auto r = alloc(nex_mul);
-        add_to_allocated(r);
-        return r;
+        return mk_nex<nex_mul>();
     }
 
     template <typename K, typename...Args>
@@ -235,9 +248,7 @@ public:
     }
     
     nex_scalar* mk_scalar(const rational& v) {
-        auto r = alloc(nex_scalar, v);
-        add_to_allocated(r);
-        return r;
+        return mk_nex<nex_scalar>(v);
     }
 
     nex * mk_div(const nex& a, lpvar j);
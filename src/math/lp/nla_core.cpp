@@ -822,14 +822,58 @@ void core::erase_from_to_refine(lpvar j) {
 }
 
 
+bool core::same_monics_as_last_refine() const {
+    unsigned i = 0, sz = m_refine_monics.size();
+    for (auto const& m : m_emons) {
+        if (i + 2 + m.vars().size() > sz || m_refine_monics[i] != m.var() || m_refine_monics[i + 1] != m.vars().size())
+            return false;
+        i += 2;
+        for (lpvar j : m.vars()) 
+            if (m_refine_monics[i++] != j)
+                return false;
+    }
+    return i == sz;
+}
+
 void core::init_to_refine() {
     TRACE("nla_solver_details", tout << "emons:" << pp_emons(*this, m_emons););
+    unsigned num_vars = m_lar_solver.number_of_vars();
     m_to_refine.clear();
-    m_to_refine.resize(m_lar_solver.number_of_vars());
+    m_to_refine.resize(num_vars);
+    bool incremental = m_refine_values.size() == num_vars && same_monics_as_last_refine();
+    if (!incremental) {
+        m_refine_monics.reset();
+        for (auto const& m : m_emons) {
+            m_refine_monics.push_back(m.var());
+            m_refine_monics.push_back(m.vars().size());
+            m_refine_monics.append(m.vars());
+        }
+        m_refine_values.reset();
+        for (lpvar j = 0; j < num_vars; ++j)
+            m_refine_values.push_back(val(j));
+        m_refine_status.reset();
+        m_refine_status.resize(num_vars, false);
+    }
+    else {
+        m_refine_changed.reset();
+        m_refine_changed.resize(num_vars, false);
+        for (lpvar j = 0; j < num_vars; ++j) {
+            if (m_refine_values[j] != val(j)) {
+                m_refine_values[j] = val(j);
+                m_refine_changed[j] = true;
+            }
+        }
+    }
     unsigned r = random(), sz = m_emons.number_of_monics();
     for (unsigned k = 0; k < sz; k++) {
         auto const & m = *(m_emons.begin() + (k + r)% sz);
-        if (!check_monic(m)) 
+        bool changed = !incremental || m_refine_changed[m.var()];
+        for (unsigned i = 0; !changed && i < m.vars().size(); ++i)
+            changed = m_refine_changed[m.vars()[i]];
+        if (changed)
+            m_refine_status[m.var()] = !check_monic(m);
+        SASSERT(m_refine_status[m.var()] == !check_monic(m));
+        if (m_refine_status[m.var()]) 
             insert_to_refine(m.var());
     }
     
@@ -1414,8 +1458,11 @@ lbool core::check(vector<lemma>& l_vec) {
 
     set_use_nra_model(false);    
 
-    if (l_vec.empty() && !done() && m_nla_settings.propagate_bounds()) 
+    if (l_vec.empty() && !done() && m_nla_settings.propagate_bounds()) {
         m_monomial_bounds();
+        if (!l_vec.empty())
+            m_stats.m_bounds_checks++;
+    }
     
     if (l_vec.empty() && !done() && need_run_horner()) 
         m_horner.horner_lemmas();
@@ -1567,6 +1614,7 @@ void core::configure_grobner() {
     cfg.m_expr_size_growth = m_nla_settings.grobner_expr_size_growth();
     cfg.m_expr_degree_growth = m_nla_settings.grobner_expr_degree_growth();
     cfg.m_number_of_conflicts_to_report = m_nla_settings.grobner_number_of_conflicts_to_report();
+    cfg.m_threads = m_nla_settings.grobner_threads();
     m_pdd_grobner.set(cfg);
     m_pdd_grobner.adjust_cfg();
     m_pdd_manager.set_max_num_nodes(10000); // or something proportional to the number of initial nodes.
@@ -1841,6 +1889,7 @@ void core::collect_statistics(::statistics & st) {
     st.update("arith-nla-explanations", m_stats.m_nla_explanations);
     st.update("arith-nla-lemmas", m_stats.m_nla_lemmas);
     st.update("arith-nra-calls", m_stats.m_nra_calls);    
+    st.update("arith-nla-bounds-checks", m_stats.m_bounds_checks);
 }
 
 
@@ -143,12 +143,20 @@ class core {
         unsigned m_nla_explanations;
         unsigned m_nla_lemmas;
         unsigned m_nra_calls;
+        unsigned m_bounds_checks;   // checks decided by bound propagation on monomials
         stats() { reset(); }
         void reset() {
             memset(this, 0, sizeof(*this));
         }
     };
     stats                    m_stats;
+    // the monics with their variables, and the values of the variables, at the last
+    // init_to_refine: a monic whose variables kept their values keeps its status.
+    unsigned_vector          m_refine_monics;
+    vector<rational>         m_refine_values;
+    svector<bool>            m_refine_changed;
+    svector<bool>            m_refine_status;
+    bool same_monics_as_last_refine() const;
     friend class new_lemma;
 public:
     var_eqs<emonics>         m_evars;
@@ -29,7 +29,9 @@ class nla_settings {
     unsigned m_grobner_number_of_conflicts_to_report;
     unsigned m_grobner_quota;
     unsigned m_grobner_frequency;
+    unsigned m_grobner_threads;
     bool     m_run_nra;
+    bool     m_nra_incremental;
     // propagate bounds
     bool     m_bp;
 public:
@@ -44,7 +46,9 @@ public:
                      m_grobner_subs_fixed(false),
                      m_grobner_quota(0),
                      m_grobner_frequency(4),
+                     m_grobner_threads(1),
                      m_run_nra(false),
+                     m_nra_incremental(false),
                      m_bp(false)
     {}
     bool propagate_bounds() const { return m_bp; }
@@ -74,6 +78,8 @@ public:
 
     bool run_nra() const { return m_run_nra; }
     bool& run_nra() { return m_run_nra; }    
+    bool nra_incremental() const { return m_nra_incremental; }
+    bool& nra_incremental() { return m_nra_incremental; }
 
     unsigned grobner_row_length_limit() const { return m_grobner_row_length_limit; }
     unsigned& grobner_row_length_limit() { return m_grobner_row_length_limit; }
@@ -96,6 +102,9 @@ public:
     unsigned & grobner_number_of_conflicts_to_report() { return m_grobner_number_of_conflicts_to_report; }
 
     unsigned& grobner_quota() { return m_grobner_quota; }
+
+    unsigned grobner_threads() const { return m_grobner_threads; }
+    unsigned& grobner_threads() { return m_grobner_threads; }
     
 };
 }
@@ -25,6 +25,9 @@ struct solver::imp {
     u_map<polynomial::var>    m_lp2nl;  // map from lar_solver variables to nlsat::solver variables        
     lp::u_set                 m_term_set;
     scoped_ptr<nlsat::solver> m_nlsat;
+    bool                      m_incremental;  // m_nlsat is reused across checks
+    nlsat::literal_vector     m_assumptions;  // constraints and definitions of the current incremental check
+    u_map<unsigned>           m_lit2ci;       // map from assumption literals to lar_solver constraints
     scoped_ptr<scoped_anum>   m_zero;
     mutable variable_map_type m_variable_values; // current model        
     nla::core&                m_nla_core;    
@@ -32,6 +35,7 @@ struct solver::imp {
         s(s), 
         m_limit(lim),
         m_params(p),
+        m_incremental(false),
         m_nla_core(nla_core) {}
 
     bool need_check() {
@@ -47,15 +51,25 @@ struct solver::imp {
        to identify equalities in the model that should be assumed
        with the remaining solver.
            
+       In incremental mode the nlsat solver is reused across checks.
+       The constraints and definitions are then passed as assumptions, 
+       so the lemmas that nlsat learns from the polynomials alone, 
+       and its cached root isolations, are kept for the next check.
+
        TBD: use partial model from lra_solver to prime the state of nlsat_solver.
-       TBD: explore more incremental ways of applying nlsat (using assumptions)
     */
     lbool check() {        
         SASSERT(need_check());
-        m_nlsat = alloc(nlsat::solver, m_limit, m_params, false);
-        m_zero = alloc(scoped_anum, am());
+        bool incremental = m_nla_core.m_nla_settings.nra_incremental();
+        if (!m_nlsat || !incremental || !m_incremental) {
+            m_nlsat = alloc(nlsat::solver, m_limit, m_params, incremental);
+            m_zero = alloc(scoped_anum, am());
+            m_lp2nl.reset();
+            m_incremental = incremental;
+        }
         m_term_set.clear();
-        m_lp2nl.reset();
+        m_assumptions.reset();
+        m_lit2ci.reset();
         vector<nlsat::assumption, false> core;
 
         // add linear inequalities from lra_solver
@@ -74,7 +88,7 @@ struct solver::imp {
 
         lbool r = l_undef;
         try {
-            r = m_nlsat->check(); 
+            r = m_incremental ? m_nlsat->check(m_assumptions) : m_nlsat->check(); 
         }
         catch (z3_exception&) {
             if (m_limit.get_cancel_flag()) {
@@ -91,11 +105,23 @@ struct solver::imp {
             break;
         case l_false: {
             lp::explanation ex;
-            m_nlsat->get_core(core);
-            for (auto c : core) {
-                unsigned idx = static_cast<unsigned>(static_cast<imp*>(c) - this);
-                ex.push_back(idx);
-                TRACE("arith", tout << "ex: " << idx << "\n";);
+            if (m_incremental) {
+                // m_assumptions contains the core
+                unsigned idx;
+                for (nlsat::literal lit : m_assumptions) {
+                    if (m_lit2ci.find(lit.index(), idx)) {
+                        ex.push_back(idx);
+                        TRACE("arith", tout << "ex: " << idx << "\n";);
+                    }
+                }
+            }
+            else {
+                m_nlsat->get_core(core);
+                for (auto c : core) {
+                    unsigned idx = static_cast<unsigned>(static_cast<imp*>(c) - this);
+                    ex.push_back(idx);
+                    TRACE("arith", tout << "ex: " << idx << "\n";);
+                }
             }
             nla::new_lemma lemma(m_nla_core, __FUNCTION__);
             lemma &= ex;
@@ -124,7 +150,17 @@ struct solver::imp {
         polynomial::polynomial* ps[1] = { p };
         bool even[1] = { false };
         nlsat::literal lit = m_nlsat->mk_ineq_literal(nlsat::atom::kind::EQ, 1, ps, even);
-        m_nlsat->mk_clause(1, &lit, nullptr);
+        add_definition(lit);
+    }
+
+    /**
+       \brief assert a definition, that holds independently of the lar_solver constraints.
+    */
+    void add_definition(nlsat::literal lit) {
+        if (m_incremental)
+            m_assumptions.push_back(lit);
+        else
+            m_nlsat->mk_clause(1, &lit, nullptr);
     }
 
     void add_constraint(unsigned idx) {
@@ -169,7 +205,13 @@ struct solver::imp {
         default:
             lp_assert(false); // unreachable
         }
-        m_nlsat->mk_clause(1, &lit, a);
+        if (m_incremental) {
+            m_lit2ci.insert(lit.index(), idx);
+            m_assumptions.push_back(lit);
+        }
+        else {
+            m_nlsat->mk_clause(1, &lit, a);
+        }
     }               
 
     bool is_int(lp::var_index v) {
@@ -179,18 +221,20 @@ struct solver::imp {
 
     polynomial::var lp2nl(lp::var_index v) {
         polynomial::var r;
-        if (!m_lp2nl.find(v, r)) {
+        // variables of previous incremental checks are reused unless
+        // the lar_solver column was recreated with a different type.
+        if (!m_lp2nl.find(v, r) || m_nlsat->is_int(r) != is_int(v)) {
             r = m_nlsat->mk_var(is_int(v));
             m_lp2nl.insert(v, r);
             TRACE("arith", tout << "j" << v << " := x" << r << "\n";);
+        }
 #if 1
-            if (!m_term_set.contains(v) && s.column_corresponds_to_term(v)) {
-                if (v >= m_term_set.size())
-                    m_term_set.resize(v + 1);
-                m_term_set.insert(v);
-            }
-#endif
+        if (!m_term_set.contains(v) && s.column_corresponds_to_term(v)) {
+            if (v >= m_term_set.size())
+                m_term_set.resize(v + 1);
+            m_term_set.insert(v);
         }
+#endif
         return r;
     }
     //
@@ -217,7 +261,7 @@ struct solver::imp {
         polynomial::polynomial* ps[1] = { p };
         bool is_even[1] = { false };
         nlsat::literal lit = m_nlsat->mk_ineq_literal(nlsat::atom::kind::EQ, 1, ps, is_even);                
-        m_nlsat->mk_clause(1, &lit, nullptr);
+        add_definition(lit);
     }
 
     nlsat::anum const& value(lp::var_index v) const {
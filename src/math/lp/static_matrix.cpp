@@ -78,6 +78,12 @@ template void static_matrix<mpq, numeric_pair<mpq> >::set(unsigned int, unsigned
 template bool lp::static_matrix<double, double>::pivot_row_to_row_given_cell(unsigned int, column_cell &, unsigned int);
 template bool lp::static_matrix<lp::mpq, lp::mpq>::pivot_row_to_row_given_cell(unsigned int, column_cell& , unsigned int);
 template bool lp::static_matrix<lp::mpq, lp::numeric_pair<lp::mpq> >::pivot_row_to_row_given_cell(unsigned int, column_cell&, unsigned int);
+template void lp::static_matrix<double, double>::set_pivot_row(unsigned int, unsigned int);
+template void lp::static_matrix<lp::mpq, lp::mpq>::set_pivot_row(unsigned int, unsigned int);
+template void lp::static_matrix<lp::mpq, lp::numeric_pair<lp::mpq> >::set_pivot_row(unsigned int, unsigned int);
+template bool lp::static_matrix<double, double>::pivot_row_to_row_given_cell(column_cell &);
+template bool lp::static_matrix<lp::mpq, lp::mpq>::pivot_row_to_row_given_cell(column_cell &);
+template bool lp::static_matrix<lp::mpq, lp::numeric_pair<lp::mpq> >::pivot_row_to_row_given_cell(column_cell &);
 template void lp::static_matrix<lp::mpq, lp::numeric_pair<lp::mpq> >::remove_element(vector<lp::row_cell<lp::mpq>, true, unsigned int>&, lp::row_cell<lp::mpq>&);
 
 }
@@ -75,6 +75,10 @@ public:
     typedef vector<column_cell> column_strip;
     vector<int> m_vector_of_row_offsets;
     indexed_vector<T> m_work_vector;
+    // the pivot row without the pivot column, kept as separate index and coefficient
+    // arrays since it is read once for every other row of the pivot column
+    svector<unsigned> m_pivot_row_vars;
+    vector<T> m_pivot_row_coeffs;
     vector<row_strip<T>> m_rows;
     vector<column_strip> m_columns;
     // starting inner classes
@@ -298,6 +302,10 @@ public:
 
     // pivot row i to row ii
     bool pivot_row_to_row_given_cell(unsigned i, column_cell& c, unsigned);
+    // copy row i minus the cell of pivot_col to m_pivot_row_vars and m_pivot_row_coeffs
+    void set_pivot_row(unsigned i, unsigned pivot_col);
+    // pivot the row given by set_pivot_row to row c.var()
+    bool pivot_row_to_row_given_cell(column_cell& c);
     void scan_row_ii_to_offset_vector(const row_strip<T> & rvals);
 
     void transpose_rows(unsigned i, unsigned ii) {
@@ -41,9 +41,28 @@ template <typename T, typename X> void static_matrix<T, X>::scan_row_ii_to_offse
 }
 
 
+inline void add_mul(double & r, double a, double b) { r += a * b; }
+inline void add_mul(mpq & r, mpq const & a, mpq const & b) { r.addmul(a, b); }
+
 template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_given_cell(unsigned i, column_cell & c, unsigned pivot_col) {
+    lp_assert(i < row_count() && c.var() < column_count() && i != c.var());
+    set_pivot_row(i, pivot_col);
+    return pivot_row_to_row_given_cell(c);
+}
+
+template <typename T, typename X> void static_matrix<T, X>::set_pivot_row(unsigned i, unsigned pivot_col) {
+    m_pivot_row_vars.reset();
+    m_pivot_row_coeffs.reset();
+    for (const auto & iv : m_rows[i]) {
+        if (iv.var() == pivot_col) continue;
+        lp_assert(!is_zero(iv.m_value));
+        m_pivot_row_vars.push_back(iv.var());
+        m_pivot_row_coeffs.push_back(iv.m_value);
+    }
+}
+
+template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_given_cell(column_cell & c) {
     unsigned ii = c.var();
-    lp_assert(i < row_count() && ii < column_count() && i != ii);
     T alpha = -get_val(c);
     lp_assert(!is_zero(alpha));
     auto & rowii = m_rows[ii];
@@ -51,17 +70,15 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
     scan_row_ii_to_offset_vector(rowii);
     unsigned prev_size_ii = rowii.size();
     // run over the pivot row and update row ii
-    for (const auto & iv : m_rows[i]) {
-        unsigned j = iv.var();
-        if (j == pivot_col) continue;
-        T alv = alpha * iv.m_value;
-        lp_assert(!is_zero(iv.m_value));
+    unsigned sz = m_pivot_row_vars.size();
+    for (unsigned k = 0; k < sz; k++) {
+        unsigned j = m_pivot_row_vars[k];
         int j_offs = m_vector_of_row_offsets[j];
         if (j_offs == -1) { // it is a new element
-            add_new_element(ii, j, alv);
+            add_new_element(ii, j, alpha * m_pivot_row_coeffs[k]);
         }
         else {
-            rowii[j_offs].m_value += alv;
+            add_mul(rowii[j_offs].m_value, alpha, m_pivot_row_coeffs[k]);
         }
     }
     // clean the work vector
@@ -93,8 +93,16 @@ namespace polynomial {
         polynomial_ref_vector    m_cached_polys;
         svector<char>            m_in_cache;
         small_object_allocator & m_allocator;
+        unsigned                 m_max_entries;
+        unsigned                 m_psc_chain_hits;
+        unsigned                 m_psc_chain_misses;
+        unsigned                 m_factor_hits;
+        unsigned                 m_factor_misses;
 
-        imp(manager & _m):m(_m), m_poly_table(poly_hash_proc(m), poly_eq_proc(m)), m_cached_polys(m), m_allocator(m.allocator()) {
+        imp(manager & _m, unsigned max_entries):
+            m(_m), m_poly_table(poly_hash_proc(m), poly_eq_proc(m)), m_cached_polys(m), m_allocator(m.allocator()),
+            m_max_entries(max_entries),
+            m_psc_chain_hits(0), m_psc_chain_misses(0), m_factor_hits(0), m_factor_misses(0) {
         }
         
         ~imp() {
@@ -151,18 +159,22 @@ namespace polynomial {
         void psc_chain(polynomial * p, polynomial * q, var x, polynomial_ref_vector & S) {
             p = mk_unique(p);
             q = mk_unique(q);
+            if (m_psc_chain_cache.size() > m_max_entries)
+                reset_psc_chain_cache();
             unsigned h = hash_u_u(pid(p), pid(q));
             psc_chain_entry * entry = new (m_allocator.allocate(sizeof(psc_chain_entry))) psc_chain_entry(p, q, x, h);
             psc_chain_entry * old_entry = m_psc_chain_cache.insert_if_not_there(entry); 
             if (entry != old_entry) {
                 entry->~psc_chain_entry();
                 m_allocator.deallocate(sizeof(psc_chain_entry), entry);
+                m_psc_chain_hits++;
                 S.reset();
                 for (unsigned i = 0; i < old_entry->m_result_sz; i++) {
                     S.push_back(old_entry->m_result[i]);
                 }
             }
             else {
+                m_psc_chain_misses++;
                 m.psc_chain(p, q, x, S);
                 unsigned sz = S.size();
                 entry->m_result_sz = sz;
@@ -178,18 +190,22 @@ namespace polynomial {
         void factor(polynomial * p, polynomial_ref_vector & distinct_factors) {
             distinct_factors.reset();
             p = mk_unique(p);
+            if (m_factor_cache.size() > m_max_entries)
+                reset_factor_cache();
             unsigned h = hash_u(pid(p));
             factor_entry * entry = new (m_allocator.allocate(sizeof(factor_entry))) factor_entry(p, h);
             factor_entry * old_entry = m_factor_cache.insert_if_not_there(entry); 
             if (entry != old_entry) {
                 entry->~factor_entry();
                 m_allocator.deallocate(sizeof(factor_entry), entry);
+                m_factor_hits++;
                 distinct_factors.reset();
                 for (unsigned i = 0; i < old_entry->m_result_sz; i++) {
                     distinct_factors.push_back(old_entry->m_result[i]);
                 }
             }
             else {
+                m_factor_misses++;
                 factors fs(m);
                 m.factor(p, fs);
                 unsigned sz = fs.distinct_factors();
@@ -205,7 +221,7 @@ namespace polynomial {
     };
 
     cache::cache(manager & m) {
-        m_imp = alloc(imp, m);
+        m_imp = alloc(imp, m, UINT_MAX);
     }
 
     cache::~cache() {
@@ -230,7 +246,19 @@ namespace polynomial {
     
     void cache::reset() {
         manager & _m = m();
+        unsigned max_entries = m_imp->m_max_entries;
         dealloc(m_imp);
-        m_imp = alloc(imp, _m);
+        m_imp = alloc(imp, _m, max_entries);
+    }
+
+    void cache::set_max_entries(unsigned n) {
+        m_imp->m_max_entries = n;
+    }
+
+    void cache::collect_statistics(statistics & st) const {
+        st.update("polynomial psc chain cache hits", m_imp->m_psc_chain_hits);
+        st.update("polynomial psc chain cache misses", m_imp->m_psc_chain_misses);
+        st.update("polynomial factor cache hits", m_imp->m_factor_hits);
+        st.update("polynomial factor cache misses", m_imp->m_factor_misses);
     }
 };
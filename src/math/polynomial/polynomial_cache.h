@@ -20,6 +20,7 @@ Notes:
 #define POLYNOMIAL_CACHE_H_
 
 #include "math/polynomial/polynomial.h"
+#include "util/statistics.h"
 
 namespace polynomial {
 
@@ -38,6 +39,12 @@ namespace polynomial {
         void psc_chain(polynomial const * p, polynomial const * q, var x, polynomial_ref_vector & S);
         void factor(polynomial const * p, polynomial_ref_vector & distinct_factors);
         void reset();
+        /**
+           \brief bound the number of psc chains and factorizations kept in the cache.
+           The results of an operation are dropped when its cache exceeds the bound.
+        */
+        void set_max_entries(unsigned n);
+        void collect_statistics(statistics & st) const;
     };
 };
 
@@ -26,6 +26,7 @@ Notes:
 #include "math/polynomial/polynomial_primes.h"
 #include "util/buffer.h"
 #include "util/common_msgs.h"
+#include <cmath>
 
 namespace upolynomial {
 
@@ -718,6 +719,85 @@ namespace upolynomial {
         R.swap(C2);
     }
 
+    static uint64_t word_inv(uint64_t a, uint64_t p) {
+        SASSERT(a != 0 && a < p);
+        int64_t t = 0, new_t = 1;
+        int64_t r = p, new_r = a;
+        while (new_r != 0) {
+            int64_t q = r / new_r;
+            int64_t tmp = t - q * new_t;
+            t = new_t; new_t = tmp;
+            tmp = r - q * new_r;
+            r = new_r; new_r = tmp;
+        }
+        SASSERT(r == 1);
+        return t < 0 ? t + p : t;
+    }
+
+    static void word_mk_monic(svector<uint64_t> & a, uint64_t p) {
+        SASSERT(!a.empty() && a.back() != 0);
+        uint64_t c = word_inv(a.back(), p);
+        if (c == 1)
+            return;
+        for (uint64_t & x : a)
+            x = (x * c) % p;
+    }
+
+    // a := a mod b, where b is monic
+    static void word_rem(svector<uint64_t> & a, svector<uint64_t> const & b, uint64_t p) {
+        SASSERT(!b.empty() && b.back() == 1);
+        unsigned sz_b = b.size();
+        while (a.size() >= sz_b) {
+            uint64_t c = p - a.back();
+            if (c != p) {
+                uint64_t * a_i = a.c_ptr() + (a.size() - sz_b);
+                for (unsigned i = 0; i + 1 < sz_b; i++)
+                    a_i[i] = (a_i[i] + c * b[i]) % p;
+            }
+            a.pop_back();
+        }
+        while (!a.empty() && a.back() == 0)
+            a.pop_back();
+    }
+
+    /**
+       \brief result := monic gcd of u and v in Zp, where p < 2^32 is the current prime.
+
+       The Euclidean algorithm of euclid_gcd is run on coefficients in [0, p) stored in
+       machine words, since the products of two coefficients do not overflow 64 bits.
+    */
+    void core_manager::word_zp_gcd(uint64_t p, numeral_vector const & u, numeral_vector const & v, numeral_vector & result) {
+        SASSERT(modular() && m().m().get_uint64(m().p()) == p);
+        SASSERT(p < (1ull << 32));
+        SASSERT(!u.empty() && !v.empty());
+        svector<uint64_t> & A = m_mgcd_word_tmp1;
+        svector<uint64_t> & B = m_mgcd_word_tmp2;
+        auto to_word = [&](numeral_vector const & s, svector<uint64_t> & r) {
+            r.reset();
+            for (numeral const & c : s) {
+                int64_t w = m().m().get_int64(c);
+                r.push_back(w < 0 ? w + p : w);
+            }
+        };
+        to_word(u, A);
+        to_word(v, B);
+        if (A.size() < B.size())
+            A.swap(B);
+        word_mk_monic(B, p);
+        while (!B.empty()) {
+            checkpoint();
+            word_rem(A, B, p);
+            A.swap(B);
+            if (!B.empty())
+                word_mk_monic(B, p);
+        }
+        unsigned sz = A.size();
+        result.reserve(sz);
+        for (unsigned i = 0; i < sz; i++)
+            m().set(result[i], A[i]);
+        set_size(sz, result);
+    }
+
     void core_manager::mod_gcd(unsigned sz_u, numeral const * u,
                                unsigned sz_v, numeral const * v,
                                numeral_vector & result) {
@@ -760,9 +840,9 @@ namespace upolynomial {
                     TRACE("mgcd", tout << "bad prime, leading coefficient vanished\n";);
                     continue; // bad prime
                 }
-                euclid_gcd(u_Zp.size(), u_Zp.c_ptr(), v_Zp.size(), v_Zp.c_ptr(), q);
+                // the big primes fit in 32 bits, so the gcd in Zp is computed on machine words
+                word_zp_gcd(polynomial::g_big_primes[i], u_Zp, v_Zp, q);
                 // normalize so that lc_g is leading coefficient of q
-                mk_monic(q.size(), q.c_ptr());
                 scoped_numeral c(m());
                 m().set(c, lc_g);
                 mul(q, c);
@@ -1728,8 +1808,68 @@ namespace upolynomial {
         }
     }
 
+    /**
+       \brief Try to evaluate the sign of p(b) using floating point arithmetic.
+
+       The coefficients of p and the numerator of b must be exactly representable
+       as doubles. The rounding error of the Horner scheme is bounded by
+       2 * gamma_{2n} * sum |a_i| |b|^i (Higham, Accuracy and Stability of Numerical
+       Algorithms, 5.1) where the unit roundoff is taken as 2^-52 so that the bound
+       holds in any rounding mode. Return false if the value is within the error bound.
+    */
+    static bool fast_eval_sign_at(unsynch_mpz_manager & m, unsigned sz, mpz const * p, mpbq const & b, sign & s) {
+        static const int64_t max_exact = static_cast<int64_t>(1) << 53;
+        auto to_double = [&](mpz const & a, double & r) {
+            if (!m.is_int64(a))
+                return false;
+            int64_t v = m.get_int64(a);
+            if (v > max_exact || v < -max_exact)
+                return false;
+            r = static_cast<double>(v);
+            return true;
+        };
+        double c;
+        if (b.k() > 1000 || !to_double(b.numerator(), c))
+            return false;
+        double x  = std::ldexp(c, -static_cast<int>(b.k()));
+        double ax = std::fabs(x);
+        double r, a;
+        if (!to_double(p[sz-1], r))
+            return false;
+        double e = std::fabs(r);
+        for (unsigned i = sz - 1; i-- > 0; ) {
+            if (!to_double(p[i], a))
+                return false;
+            r = r * x + a;
+            e = e * ax + std::fabs(a);
+        }
+        unsigned n     = sz - 1;
+        double u       = std::ldexp(1.0, -52);
+        double gamma   = 2 * n * u / (1 - 2 * n * u);
+        // absolute error of operations whose result is subnormal
+        double eta     = sz * std::ldexp(1.0, -1074) * std::pow(std::max(1.0, ax), n);
+        double err     = 2 * gamma * e + eta;
+        if (!std::isfinite(r) || !std::isfinite(err) || std::fabs(r) <= err)
+            return false;
+        s = r > 0 ? sign_pos : sign_neg;
+        return true;
+    }
+
     // Evaluate the sign of p(b)
     sign manager::eval_sign_at(unsigned sz, numeral const * p, mpbq const & b) {
+        if (sz == 0)
+            return sign_zero;
+        if (sz == 1)
+            return sign_of(p[0]);
+        sign s;
+        if (!m().modular() && fast_eval_sign_at(m().m(), sz, p, b, s)) {
+            SASSERT(s == eval_sign_at_exact(sz, p, b));
+            return s;
+        }
+        return eval_sign_at_exact(sz, p, b);
+    }
+
+    sign manager::eval_sign_at_exact(unsigned sz, numeral const * p, mpbq const & b) {
         // Actually, given b = c/2^k, we compute the sign of (2^k)^n*p(b)
         // Original Horner Sequence
         //     ((a_n * b + a_{n-1})*b + a_{n-2})*b + a_{n-3} ...
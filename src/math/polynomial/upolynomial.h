@@ -113,6 +113,8 @@ namespace upolynomial {
         numeral_vector    m_CRA_tmp;
         #define UPOLYNOMIAL_MGCD_TMPS 6
         numeral_vector    m_mgcd_tmp[UPOLYNOMIAL_MGCD_TMPS]; 
+        svector<uint64_t> m_mgcd_word_tmp1;
+        svector<uint64_t> m_mgcd_word_tmp2;
         numeral_vector    m_sqf_tmp1;
         numeral_vector    m_sqf_tmp2;
         numeral_vector    m_pw_tmp;
@@ -126,6 +128,7 @@ namespace upolynomial {
         void flip_sign_if_lm_neg(numeral_vector & buffer);
 
         void mod_gcd(unsigned sz_u, numeral const * u, unsigned sz_v, numeral const * v, numeral_vector & result);
+        void word_zp_gcd(uint64_t p, numeral_vector const & u, numeral_vector const & v, numeral_vector & result);
         void CRA_combine_images(numeral_vector const & q, numeral const & p, numeral_vector & C, numeral & bound);
 
     public:
@@ -734,8 +737,12 @@ namespace upolynomial {
         
         /**
            \brief Evaluate the sign of p(b) 
+
+           Small coefficients and points are first evaluated using floating point
+           arithmetic, and eval_sign_at_exact is used when the result is too close to zero.
         */
         sign eval_sign_at(unsigned sz, numeral const * p, mpbq const & b);
+        sign eval_sign_at_exact(unsigned sz, numeral const * p, mpbq const & b);
         
         /**
            \brief Evaluate the sign of p(b)
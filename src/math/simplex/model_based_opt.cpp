@@ -156,6 +156,24 @@ namespace opt {
     model_based_opt::model_based_opt() {
         m_rows.push_back(row());
     }
+
+    void model_based_opt::reset() {
+        objective().reset();
+        m_retired_rows.reset();
+        for (unsigned i = m_rows.size(); i-- > 1; ) {
+            row& r = m_rows[i];
+            r.reset();
+            r.m_mod.reset();
+            r.m_type = t_le;
+            r.m_alive = false;
+            m_retired_rows.push_back(i);
+        }
+        for (unsigned_vector& row_ids : m_var2row_ids) {
+            row_ids.reset();
+        }
+        m_var2value.reset();
+        m_var2is_int.reset();
+    }
         
     bool model_based_opt::invariant() {
         for (unsigned i = 0; i < m_rows.size(); ++i) {
@@ -754,7 +772,7 @@ namespace opt {
         for (auto const& r : m_rows) {
             display(out, r);
         }
-        for (unsigned i = 0; i < m_var2row_ids.size(); ++i) {
+        for (unsigned i = 0; i < m_var2value.size(); ++i) {
             unsigned_vector const& rows = m_var2row_ids[i];
             out << i << ": ";
             for (auto const& r : rows) {
@@ -811,7 +829,8 @@ namespace opt {
         m_var2value.push_back(value);
         m_var2is_int.push_back(is_int);
         SASSERT(value.is_int() || !is_int);
-        m_var2row_ids.push_back(unsigned_vector());
+        if (v == m_var2row_ids.size())
+            m_var2row_ids.push_back(unsigned_vector());
         return v;
     }
 
@@ -158,6 +158,10 @@ namespace opt {
 
         model_based_opt();
 
+        // remove all variables and constraints.
+        // The storage of rows is kept for the next constraint system.
+        void reset();
+
         // add a fresh variable with value 'value'.
         unsigned add_var(rational const& value, bool is_int = false);
 
@@ -22,6 +22,7 @@ Revision History:
 #include "ast/ast_util.h"
 #include "model/func_interp.h"
 #include "ast/array_decl_plugin.h"
+#include "ast/arith_decl_plugin.h"
 
 func_entry::func_entry(ast_manager & m, unsigned arity, expr * const * args, expr * result):
     m_args_are_values(true),
@@ -75,8 +76,11 @@ func_interp::func_interp(ast_manager & m, unsigned arity):
     m_arity(arity),
     m_else(nullptr),
     m_args_are_values(true),
+    m_args_are_unique_values(true),
     m_interp(nullptr),
-    m_array_interp(nullptr) {
+    m_array_interp(nullptr),
+    m_index_lim(0),
+    m_arith_fid(null_family_id) {
 }
 
 func_interp::~func_interp() {
@@ -176,13 +180,58 @@ bool func_interp::is_constant() const {
    args_are_values to true if for all entries e e.args_are_values() is true.
 */
 func_entry * func_interp::get_entry(expr * const * args) const {
-    for (func_entry* curr : m_entries) {
+    if (m_entries.size() <= 8) {
+        for (func_entry* curr : m_entries) {
+            if (curr->eq_args(m(), m_arity, args))
+                return curr;
+        }
+        return nullptr;
+    }
+    update_index();
+    unsigned idx;
+    if (!m_hash2entry.find(args_hash(args), idx))
+        return nullptr;
+    for (; idx != UINT_MAX; idx = m_next_entry[idx]) {
+        func_entry * curr = m_entries[idx];
         if (curr->eq_args(m(), m_arity, args))
             return curr;
     }
     return nullptr;
 }
 
+/**
+   \brief Hash of arguments that is compatible with ast_manager::are_equal.
+   Irrational algebraic numbers can be equal without being the same term,
+   so they all have the same hash.
+*/
+unsigned func_interp::args_hash(expr * const * args) const {
+    if (m_arith_fid == null_family_id)
+        m_arith_fid = m().mk_family_id("arith");
+    unsigned h = m_arity;
+    for (unsigned i = 0; i < m_arity; i++) {
+        expr * a = args[i];
+        bool is_alg = is_app_of(a, m_arith_fid, OP_IRRATIONAL_ALGEBRAIC_NUM);
+        h = combine_hash(h, is_alg ? 17 : a->get_id());
+    }
+    return h;
+}
+
+void func_interp::update_index() const {
+    for (; m_index_lim < m_entries.size(); ++m_index_lim) {
+        unsigned h = args_hash(m_entries[m_index_lim]->get_args());
+        unsigned prev = UINT_MAX;
+        m_hash2entry.find(h, prev);
+        m_next_entry.push_back(prev);
+        m_hash2entry.insert(h, m_index_lim);
+    }
+}
+
+void func_interp::reset_index() {
+    m_hash2entry.reset();
+    m_next_entry.reset();
+    m_index_lim = 0;
+}
+
 void func_interp::insert_entry(expr * const * args, expr * r) {
     reset_interp_cache();
     func_entry * entry = get_entry(args);
@@ -212,6 +261,8 @@ void func_interp::insert_new_entry(expr * const * args, expr * r) {
     func_entry * new_entry = func_entry::mk(m(), m_arity, args, r);
     if (!new_entry->args_are_values())
         m_args_are_values = false;
+    for (unsigned i = 0; m_args_are_unique_values && i < m_arity; i++) 
+        m_args_are_unique_values = m().is_unique_value(args[i]);
     m_entries.push_back(new_entry);
 }
 
@@ -269,6 +320,7 @@ void func_interp::compress() {
     }
     if (j < m_entries.size()) {
         reset_interp_cache();
+        reset_index();
         m_entries.shrink(j);
     }
     // other compression, if else is a default branch.
@@ -280,6 +332,7 @@ void func_interp::compress() {
         }
         m_entries.reset();
         reset_interp_cache();
+        reset_index();
         m().inc_ref(new_else);
         m().dec_ref(m_else);
         m_else = new_else;
@@ -290,6 +343,7 @@ void func_interp::compress() {
         }
         m_entries.reset();
         reset_interp_cache();
+        reset_index();
         expr_ref new_else(m().mk_var(0, m().get_sort(m_else)), m());
         m().inc_ref(new_else);
         m().dec_ref(m_else);
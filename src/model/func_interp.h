@@ -32,6 +32,7 @@ Revision History:
 
 #include "ast/ast.h"
 #include "ast/ast_translation.h"
+#include "util/map.h"
 
 class func_interp;
 
@@ -70,13 +71,24 @@ class func_interp {
     ptr_vector<func_entry> m_entries;
     expr *                 m_else;
     bool                   m_args_are_values; //!< true if forall e in m_entries e.args_are_values() == true
+    bool                   m_args_are_unique_values; //!< true if all arguments of the entries are unique values
 
     expr *                 m_interp; //!< cache for representing the whole interpretation as a single expression (it uses ite terms).
 
     expr *                 m_array_interp; // <! interp with lambda abstraction
 
+    // index of the entries by the hash of their arguments, built when there are many entries.
+    mutable u_map<unsigned> m_hash2entry;  // hash -> last entry with the hash
+    mutable unsigned_vector m_next_entry;   // entry -> previous entry with the same hash
+    mutable unsigned        m_index_lim;    // entries below this index are in m_hash2entry
+    mutable family_id       m_arith_fid;
+
     void reset_interp_cache();
 
+    unsigned args_hash(expr * const * args) const;
+    void update_index() const;
+    void reset_index();
+
     expr * get_interp_core() const;
 
     expr_ref get_array_interp_core(func_decl * f) const;
@@ -97,6 +109,9 @@ public:
     bool is_constant() const;
     // Return true if all arguments of the function graph are values.
     bool args_are_values() const { return m_args_are_values; }
+    // Return true if all arguments of the function graph are unique values.
+    // Then an application to unique values that has no entry evaluates to the else value.
+    bool args_are_unique_values() const { return m_args_are_unique_values; }
 
     expr * get_else() const { return m_else; }
     void set_else(expr * e);
@@ -0,0 +1,335 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    model_compiled_evaluator.cpp
+
+Abstract:
+
+    Evaluate a fixed expression in many models.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2020-06-05
+
+--*/
+
+#include "model/model_compiled_evaluator.h"
+#include "model/model_evaluator.h"
+
+static inline uint64_t mask(unsigned w) {
+    return w >= 64 ? ~0ull : (1ull << w) - 1;
+}
+
+static inline int64_t to_signed(uint64_t v, unsigned w) {
+    return w >= 64 ? static_cast<int64_t>(v) : static_cast<int64_t>(v << (64 - w)) >> (64 - w);
+}
+
+compiled_model_evaluator::compiled_model_evaluator(ast_manager& m):
+    m(m),
+    m_bv(m),
+    m_expr(m),
+    m_compiled(false),
+    m_vars(m) {
+}
+
+void compiled_model_evaluator::mk_instr(opcode op, unsigned width, unsigned num_args, unsigned const* args, uint64_t imm) {
+    instr i;
+    i.m_op = op;
+    i.m_width = width;
+    i.m_args = m_args.size();
+    i.m_num_args = num_args;
+    i.m_imm = imm;
+    m_args.append(num_args, args);
+    m_tape.push_back(i);
+}
+
+bool compiled_model_evaluator::compile(expr* e) {
+    m_expr = e;
+    m_compiled = false;
+    m_tape.reset();
+    m_args.reset();
+    m_vars.reset();
+    obj_map<expr, unsigned> expr2reg;
+    ptr_vector<expr> todo;
+    todo.push_back(e);
+    while (!todo.empty()) {
+        expr* t = todo.back();
+        if (expr2reg.contains(t)) {
+            todo.pop_back();
+            continue;
+        }
+        if (!is_app(t))
+            return false;
+        bool visited = true;
+        for (expr* arg : *to_app(t)) {
+            if (!expr2reg.contains(arg)) {
+                todo.push_back(arg);
+                visited = false;
+            }
+        }
+        if (!visited)
+            continue;
+        todo.pop_back();
+        if (!compile_app(to_app(t), expr2reg))
+            return false;
+        expr2reg.insert(t, m_tape.size() - 1);
+    }
+    m_regs.resize(m_tape.size());
+    m_compiled = true;
+    return true;
+}
+
+bool compiled_model_evaluator::compile_app(app* a, obj_map<expr, unsigned> const& expr2reg) {
+    sort* s = m.get_sort(a);
+    unsigned w = 0;
+    if (m_bv.is_bv_sort(s)) {
+        w = m_bv.get_bv_size(s);
+        if (w > 64)
+            return false;
+    }
+    else if (!m.is_bool(s))
+        return false;
+
+    unsigned_vector args;
+    for (expr* arg : *a)
+        args.push_back(expr2reg[arg]);
+    unsigned n = args.size();
+    unsigned const* as = args.c_ptr();
+    unsigned swapped[2] = { n == 2 ? args[1] : 0, n == 2 ? args[0] : 0 };
+
+    if (is_uninterp_const(a)) {
+        mk_instr(EV_VAR, w, 0, nullptr, m_vars.size());
+        m_vars.push_back(a->get_decl());
+        return true;
+    }
+    if (a->get_family_id() == m.get_basic_family_id()) {
+        switch (a->get_decl_kind()) {
+        case OP_TRUE:     mk_instr(EV_CONST, 0, 0, nullptr, 1); return true;
+        case OP_FALSE:    mk_instr(EV_CONST, 0, 0, nullptr, 0); return true;
+        case OP_NOT:      mk_instr(EV_NOT, 0, n, as); return true;
+        case OP_AND:      mk_instr(EV_AND, 0, n, as); return true;
+        case OP_OR:       mk_instr(EV_OR, 0, n, as); return true;
+        case OP_XOR:      mk_instr(EV_XOR, 0, n, as); return true;
+        case OP_ITE:      mk_instr(EV_ITE, w, n, as); return true;
+        case OP_EQ:       mk_instr(EV_EQ, 0, n, as); return true;
+        case OP_DISTINCT: mk_instr(EV_DISTINCT, 0, n, as); return true;
+        case OP_IMPLIES: {
+            mk_instr(EV_NOT, 0, 1, as);
+            unsigned args2[2] = { m_tape.size() - 1, args[1] };
+            mk_instr(EV_OR, 0, 2, args2);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+    if (a->get_family_id() != m_bv.get_fid())
+        return false;
+    switch (a->get_decl_kind()) {
+    case OP_BV_NUM: {
+        rational r;
+        unsigned sz;
+        VERIFY(m_bv.is_numeral(a, r, sz));
+        mk_instr(EV_CONST, w, 0, nullptr, r.get_uint64());
+        return true;
+    }
+    case OP_BNOT: mk_instr(EV_BNOT, w, n, as); return true;
+    case OP_BAND: mk_instr(EV_BAND, w, n, as); return true;
+    case OP_BOR:  mk_instr(EV_BOR, w, n, as); return true;
+    case OP_BXOR: mk_instr(EV_BXOR, w, n, as); return true;
+    case OP_BNEG: mk_instr(EV_BNEG, w, n, as); return true;
+    case OP_BADD: mk_instr(EV_BADD, w, n, as); return true;
+    case OP_BSUB: mk_instr(EV_BSUB, w, n, as); return true;
+    case OP_BMUL: mk_instr(EV_BMUL, w, n, as); return true;
+    case OP_BSHL: mk_instr(EV_SHL, w, n, as); return true;
+    case OP_BLSHR: mk_instr(EV_LSHR, w, n, as); return true;
+    case OP_BASHR: mk_instr(EV_ASHR, w, n, as); return true;
+    case OP_ULEQ: mk_instr(EV_ULE, 0, n, as, m_tape[args[0]].m_width); return true;
+    case OP_UGEQ: mk_instr(EV_ULE, 0, n, swapped, m_tape[args[0]].m_width); return true;
+    case OP_ULT:  mk_instr(EV_ULT, 0, n, as, m_tape[args[0]].m_width); return true;
+    case OP_UGT:  mk_instr(EV_ULT, 0, n, swapped, m_tape[args[0]].m_width); return true;
+    case OP_SLEQ: mk_instr(EV_SLE, 0, n, as, m_tape[args[0]].m_width); return true;
+    case OP_SGEQ: mk_instr(EV_SLE, 0, n, swapped, m_tape[args[0]].m_width); return true;
+    case OP_SLT:  mk_instr(EV_SLT, 0, n, as, m_tape[args[0]].m_width); return true;
+    case OP_SGT:  mk_instr(EV_SLT, 0, n, swapped, m_tape[args[0]].m_width); return true;
+    case OP_CONCAT: mk_instr(EV_CONCAT, w, n, as); return true;
+    case OP_EXTRACT: mk_instr(EV_EXTRACT, w, n, as, m_bv.get_extract_low(a)); return true;
+    case OP_ZERO_EXT: mk_instr(EV_ZERO_EXT, w, n, as); return true;
+    case OP_SIGN_EXT: mk_instr(EV_SIGN_EXT, w, n, as); return true;
+    default:
+        return false;
+    }
+}
+
+/**
+   \brief load the values of the constants from the model.
+   Return false if some constant is not assigned to a numeral.
+*/
+bool compiled_model_evaluator::load_vars(model& mdl) {
+    rational r;
+    unsigned sz;
+    for (instr const& i : m_tape) {
+        if (i.m_op != EV_VAR)
+            continue;
+        unsigned idx = &i - m_tape.c_ptr();
+        expr* v = mdl.get_const_interp(m_vars.get(static_cast<unsigned>(i.m_imm)));
+        if (!v)
+            return false;
+        if (m.is_true(v))
+            m_regs[idx] = 1;
+        else if (m.is_false(v))
+            m_regs[idx] = 0;
+        else if (m_bv.is_numeral(v, r, sz) && r.is_uint64())
+            m_regs[idx] = r.get_uint64();
+        else
+            return false;
+    }
+    return true;
+}
+
+void compiled_model_evaluator::run() {
+    uint64_t* regs = m_regs.c_ptr();
+    unsigned const* all_args = m_args.c_ptr();
+    unsigned sz = m_tape.size();
+    for (unsigned k = 0; k < sz; ++k) {
+        instr const& i = m_tape[k];
+        unsigned const* args = all_args + i.m_args;
+        unsigned n = i.m_num_args;
+        unsigned w = i.m_width;
+        uint64_t r = 0;
+        switch (i.m_op) {
+        case EV_CONST:
+            r = i.m_imm;
+            break;
+        case EV_VAR:
+            continue;
+        case EV_NOT:
+            r = !regs[args[0]];
+            break;
+        case EV_AND:
+            r = 1;
+            for (unsigned j = 0; r && j < n; ++j) r = regs[args[j]];
+            break;
+        case EV_OR:
+            r = 0;
+            for (unsigned j = 0; !r && j < n; ++j) r = regs[args[j]];
+            break;
+        case EV_XOR:
+            r = 0;
+            for (unsigned j = 0; j < n; ++j) r ^= regs[args[j]];
+            break;
+        case EV_ITE:
+            r = regs[args[0]] ? regs[args[1]] : regs[args[2]];
+            break;
+        case EV_EQ:
+            r = regs[args[0]] == regs[args[1]];
+            break;
+        case EV_DISTINCT:
+            r = 1;
+            for (unsigned j = 0; r && j < n; ++j)
+                for (unsigned l = j + 1; r && l < n; ++l)
+                    r = regs[args[j]] != regs[args[l]];
+            break;
+        case EV_BNOT:
+            r = ~regs[args[0]];
+            break;
+        case EV_BAND:
+            r = ~0ull;
+            for (unsigned j = 0; j < n; ++j) r &= regs[args[j]];
+            break;
+        case EV_BOR:
+            r = 0;
+            for (unsigned j = 0; j < n; ++j) r |= regs[args[j]];
+            break;
+        case EV_BXOR:
+            r = 0;
+            for (unsigned j = 0; j < n; ++j) r ^= regs[args[j]];
+            break;
+        case EV_BNEG:
+            r = 0 - regs[args[0]];
+            break;
+        case EV_BADD:
+            r = 0;
+            for (unsigned j = 0; j < n; ++j) r += regs[args[j]];
+            break;
+        case EV_BSUB:
+            r = regs[args[0]];
+            for (unsigned j = 1; j < n; ++j) r -= regs[args[j]];
+            break;
+        case EV_BMUL:
+            r = 1;
+            for (unsigned j = 0; j < n; ++j) r *= regs[args[j]];
+            break;
+        case EV_ULE:
+            r = regs[args[0]] <= regs[args[1]];
+            break;
+        case EV_ULT:
+            r = regs[args[0]] < regs[args[1]];
+            break;
+        case EV_SLE:
+            r = to_signed(regs[args[0]], static_cast<unsigned>(i.m_imm)) <= to_signed(regs[args[1]], static_cast<unsigned>(i.m_imm));
+            break;
+        case EV_SLT:
+            r = to_signed(regs[args[0]], static_cast<unsigned>(i.m_imm)) < to_signed(regs[args[1]], static_cast<unsigned>(i.m_imm));
+            break;
+        case EV_CONCAT:
+            r = 0;
+            for (unsigned j = 0; j < n; ++j) {
+                unsigned wj = m_tape[args[j]].m_width;
+                r = (wj >= 64 ? 0 : r << wj) | regs[args[j]];
+            }
+            break;
+        case EV_EXTRACT:
+            r = regs[args[0]] >> i.m_imm;
+            break;
+        case EV_ZERO_EXT:
+            r = regs[args[0]];
+            break;
+        case EV_SIGN_EXT:
+            r = static_cast<uint64_t>(to_signed(regs[args[0]], m_tape[args[0]].m_width));
+            break;
+        case EV_SHL: {
+            uint64_t sh = regs[args[1]];
+            r = sh >= w ? 0 : regs[args[0]] << sh;
+            break;
+        }
+        case EV_LSHR: {
+            uint64_t sh = regs[args[1]];
+            r = sh >= w ? 0 : regs[args[0]] >> sh;
+            break;
+        }
+        case EV_ASHR: {
+            uint64_t sh = regs[args[1]];
+            int64_t v = to_signed(regs[args[0]], w);
+            r = static_cast<uint64_t>(sh >= w ? (v < 0 ? -1 : 0) : v >> sh);
+            break;
+        }
+        }
+        regs[k] = w == 0 ? r : (r & mask(w));
+    }
+}
+
+expr_ref compiled_model_evaluator::result() const {
+    instr const& i = m_tape.back();
+    uint64_t v = m_regs.back();
+    if (m.is_bool(m_expr))
+        return expr_ref(v ? m.mk_true() : m.mk_false(), m);
+    return expr_ref(m_bv.mk_numeral(rational(v, rational::ui64()), i.m_width), m);
+}
+
+expr_ref compiled_model_evaluator::operator()(model& mdl) {
+    if (m_compiled && load_vars(mdl)) {
+        run();
+        return result();
+    }
+    model_evaluator ev(mdl);
+    ev.set_model_completion(true);
+    return ev(m_expr);
+}
+
+void compiled_model_evaluator::operator()(unsigned n, model* const* models, expr_ref_vector& result) {
+    for (unsigned i = 0; i < n; ++i)
+        result.push_back((*this)(*models[i]));
+}
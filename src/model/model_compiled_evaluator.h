@@ -0,0 +1,87 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    model_compiled_evaluator.h
+
+Abstract:
+
+    Evaluate a fixed expression in many models.
+
+    The expression DAG is compiled once into a flat tape of
+    instructions. Booleans and bit-vectors of width at most 64 are
+    evaluated as machine words. Expressions outside this fragment,
+    and models that do not assign numerals to the constants of the
+    expression, are evaluated using model_evaluator with model
+    completion.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2020-06-05
+
+--*/
+#ifndef MODEL_COMPILED_EVALUATOR_H_
+#define MODEL_COMPILED_EVALUATOR_H_
+
+#include "ast/ast.h"
+#include "ast/bv_decl_plugin.h"
+#include "model/model.h"
+
+class compiled_model_evaluator {
+    enum opcode {
+        EV_CONST, EV_VAR,
+        EV_NOT, EV_AND, EV_OR, EV_XOR, EV_ITE, EV_EQ, EV_DISTINCT,
+        EV_BNOT, EV_BAND, EV_BOR, EV_BXOR, EV_BNEG, EV_BADD, EV_BSUB, EV_BMUL,
+        EV_ULE, EV_ULT, EV_SLE, EV_SLT,
+        EV_CONCAT, EV_EXTRACT, EV_ZERO_EXT, EV_SIGN_EXT,
+        EV_SHL, EV_LSHR, EV_ASHR
+    };
+
+    struct instr {
+        opcode   m_op;
+        unsigned m_width;       // 0 for Booleans
+        unsigned m_args;        // offset of the arguments in m_args
+        unsigned m_num_args;
+        uint64_t m_imm;         // constant value, variable index, low bit of extract or width of compared arguments
+    };
+
+    ast_manager&         m;
+    bv_util              m_bv;
+    expr_ref             m_expr;
+    bool                 m_compiled;
+    svector<instr>       m_tape;
+    unsigned_vector      m_args;
+    func_decl_ref_vector m_vars;
+    svector<uint64_t>    m_regs;
+
+    void mk_instr(opcode op, unsigned width, unsigned num_args, unsigned const* args, uint64_t imm = 0);
+    bool compile_app(app* e, obj_map<expr, unsigned> const& expr2reg);
+    bool load_vars(model& mdl);
+    void run();
+    expr_ref result() const;
+
+public:
+    compiled_model_evaluator(ast_manager& m);
+
+    /**
+       \brief compile e for evaluation. Return false if e is outside the fragment
+       that is evaluated using machine words. It is then evaluated using
+       model_evaluator.
+    */
+    bool compile(expr* e);
+
+    bool is_compiled() const { return m_compiled; }
+
+    /**
+       \brief evaluate the compiled expression in mdl with model completion.
+    */
+    expr_ref operator()(model& mdl);
+
+    /**
+       \brief evaluate the compiled expression in each of the models.
+    */
+    void operator()(unsigned n, model* const* models, expr_ref_vector& result);
+};
+
+#endif /* MODEL_COMPILED_EVALUATOR_H_ */
@@ -131,6 +131,19 @@ struct evaluator_cfg : public default_rewriter_cfg {
             return true;
         }
 
+        // distinct unique values are different, so no entry applies
+        // and the ground else value is the result.
+        expr * else_value = fi->get_else();
+        if (else_value && is_ground(else_value) && fi->args_are_unique_values()) {
+            bool actuals_are_unique = true;
+            for (unsigned i = 0; actuals_are_unique && i < num; i++)
+                actuals_are_unique = m.is_unique_value(args[i]);
+            if (actuals_are_unique) {
+                result = else_value;
+                return true;
+            }
+        }
+
         return false;
     }
 
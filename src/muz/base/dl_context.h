@@ -260,6 +260,7 @@ namespace datalog {
         symbol print_aig() const;
         symbol tab_selection() const;
         unsigned similarity_compressor_threshold() const;
+        unsigned join_threads() const;
         unsigned soft_timeout() const;
         unsigned initial_restart_timeout() const;
         bool generate_explanations() const;
@@ -1247,6 +1247,7 @@ private:
 
         string_vector rel_files;
         get_file_names(path, "rel", true, rel_files);
+        get_file_names(path, "csv", true, rel_files);
         string_vector::iterator rit = rel_files.begin();
         string_vector::iterator rend = rel_files.end();
         for(; rit!=rend; ++rit) {
@@ -1328,9 +1329,14 @@ private:
         }
         const char * ptr = full_line;
 
+        // numbers are separated by spaces, tabs, or a comma as in csv files.
         bool last = false;
         do {
-            while(*ptr==' ') { ptr++; }
+            while(*ptr==' ' || *ptr=='\t') { ptr++; }
+            if(*ptr==',' && !args.empty()) { 
+                ptr++; 
+                while(*ptr==' ' || *ptr=='\t') { ptr++; }
+            }
             if(*ptr==0) {
                 break;
             }
@@ -1339,9 +1345,9 @@ private:
                 throw default_exception(default_exception::fmt(), "number expected on line %d in file %s", 
                     m_current_line, m_current_file.c_str());
             }
-            if(*ptr!=' ' && *ptr!=0) {
+            if(*ptr!=' ' && *ptr!='\t' && *ptr!=',' && *ptr!=0) {
                 throw default_exception(default_exception::fmt(), 
-                                        "' ' expected to separate numbers on line %d in file %s, got '%s'", 
+                                        "' ', tab or ',' expected to separate numbers on line %d in file %s, got '%s'", 
                                         m_current_line, m_current_file.c_str(), ptr);
             }
             args.push_back(num);
@@ -0,0 +1,399 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    dl_bdd_table.cpp
+
+Abstract:
+
+    Tables represented by binary decision diagrams.
+
+Revision History:
+
+--*/
+
+#include "muz/rel/dl_bdd_table.h"
+#include <functional>
+#include "muz/rel/dl_relation_manager.h"
+
+namespace datalog {
+
+    bdd_table_plugin::bdd_table_plugin(relation_manager & manager)
+        : table_plugin(symbol("bdd"), manager),
+          m_bdd(MAX_COLS * MAX_BITS) {}
+
+    unsigned bdd_table_plugin::num_bits(table_sort sz) {
+        unsigned n = 0;
+        while (n < 64 && (static_cast<table_sort>(1) << n) < sz) {
+            ++n;
+        }
+        return n;
+    }
+
+    bool bdd_table_plugin::can_handle_signature(const table_signature & sig) {
+        if (sig.functional_columns() != 0 || sig.size() > MAX_COLS) {
+            return false;
+        }
+        for (unsigned i = 0; i < sig.size(); ++i) {
+            if (num_bits(sig[i]) > MAX_BITS) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    table_base * bdd_table_plugin::mk_empty(const table_signature & s) {
+        SASSERT(can_handle_signature(s));
+        return alloc(bdd_table, *this, s);
+    }
+
+    dd::bdd bdd_table_plugin::mk_value(unsigned col, unsigned num_bits, table_element value) {
+        dd::bdd r = m_bdd.mk_true();
+        for (unsigned b = 0; b < num_bits; ++b) {
+            r &= ((value >> b) & 1) ? m_bdd.mk_var(var(col, b)) : m_bdd.mk_nvar(var(col, b));
+        }
+        return r;
+    }
+
+    dd::bdd bdd_table_plugin::mk_eq(unsigned col1, unsigned num_bits1, unsigned col2, unsigned num_bits2) {
+        dd::bdd r = m_bdd.mk_true();
+        for (unsigned b = 0; b < std::max(num_bits1, num_bits2); ++b) {
+            if (b >= num_bits1)
+                r &= m_bdd.mk_nvar(var(col2, b));
+            else if (b >= num_bits2)
+                r &= m_bdd.mk_nvar(var(col1, b));
+            else
+                r &= !(m_bdd.mk_var(var(col1, b)) ^ m_bdd.mk_var(var(col2, b)));
+        }
+        return r;
+    }
+
+    dd::bdd bdd_table_plugin::mk_rename_rec(dd::bdd const& b, unsigned_vector const& col_map,
+                                            u_map<unsigned>& cache, vector<dd::bdd>& results) {
+        if (b.is_true() || b.is_false()) {
+            return b;
+        }
+        unsigned idx = 0;
+        if (cache.find(b.index(), idx)) {
+            return results[idx];
+        }
+        unsigned v = b.var();
+        dd::bdd lo = mk_rename_rec(b.lo(), col_map, cache, results);
+        dd::bdd hi = mk_rename_rec(b.hi(), col_map, cache, results);
+        dd::bdd r = m_bdd.mk_ite(m_bdd.mk_var(var(col_map[var2col(v)], var2bit(v))), hi, lo);
+        cache.insert(b.index(), results.size());
+        results.push_back(r);
+        return r;
+    }
+
+    dd::bdd bdd_table_plugin::mk_rename(dd::bdd const& b, unsigned_vector const& col_map) {
+        bool is_id = true;
+        for (unsigned i = 0; is_id && i < col_map.size(); ++i) {
+            is_id = col_map[i] == i;
+        }
+        if (is_id) {
+            return b;
+        }
+        u_map<unsigned> cache;
+        vector<dd::bdd> results;
+        return mk_rename_rec(b, col_map, cache, results);
+    }
+
+    class bdd_table_plugin::join_fn : public convenient_table_join_fn {
+    public:
+        join_fn(const table_signature & t1_sig, const table_signature & t2_sig, unsigned col_cnt, const unsigned * cols1, const unsigned * cols2)
+            : convenient_table_join_fn(t1_sig, t2_sig, col_cnt, cols1, cols2) {}
+
+        table_base * operator()(const table_base & _t1, const table_base & _t2) override {
+            const bdd_table & t1 = static_cast<const bdd_table &>(_t1);
+            const bdd_table & t2 = static_cast<const bdd_table &>(_t2);
+            bdd_table_plugin & p = t1.get_plugin();
+            bdd_table * res = static_cast<bdd_table *>(p.mk_empty(get_result_signature()));
+            unsigned n1 = t1.num_columns();
+            unsigned_vector col_map;
+            for (unsigned i = 0; i < t2.num_columns(); ++i) {
+                col_map.push_back(n1 + i);
+            }
+            dd::bdd r = t1.m_bdd;
+            r &= p.mk_rename(t2.m_bdd, col_map);
+            for (unsigned k = 0; k < m_cols1.size() && !r.is_false(); ++k) {
+                unsigned c1 = m_cols1[k], c2 = m_cols2[k];
+                r &= p.mk_eq(c1, t1.m_num_bits[c1], n1 + c2, t2.m_num_bits[c2]);
+            }
+            res->m_bdd = r;
+            return res;
+        }
+    };
+
+    table_join_fn * bdd_table_plugin::mk_join_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) {
+        if (t1.get_kind() != get_kind() || t2.get_kind() != get_kind() ||
+            t1.num_columns() + t2.num_columns() > MAX_COLS) {
+            return nullptr;
+        }
+        return alloc(join_fn, t1.get_signature(), t2.get_signature(), col_cnt, cols1, cols2);
+    }
+
+    class bdd_table_plugin::union_fn : public table_union_fn {
+    public:
+        void operator()(table_base & _tgt, const table_base & _src, table_base * _delta) override {
+            bdd_table & tgt = static_cast<bdd_table &>(_tgt);
+            const bdd_table & src = static_cast<const bdd_table &>(_src);
+            bdd_table * delta = static_cast<bdd_table *>(_delta);
+            if (delta) {
+                dd::bdd added = !tgt.m_bdd;
+                added &= src.m_bdd;
+                delta->m_bdd |= added;
+            }
+            tgt.m_bdd |= src.m_bdd;
+        }
+    };
+
+    table_union_fn * bdd_table_plugin::mk_union_fn(const table_base & tgt, const table_base & src,
+            const table_base * delta) {
+        if (tgt.get_kind() != get_kind() || src.get_kind() != get_kind() ||
+            (delta && delta->get_kind() != get_kind())) {
+            return nullptr;
+        }
+        return alloc(union_fn);
+    }
+
+    class bdd_table_plugin::project_fn : public convenient_table_project_fn {
+    public:
+        project_fn(const table_signature & orig_sig, unsigned col_cnt, const unsigned * removed_cols)
+            : convenient_table_project_fn(orig_sig, col_cnt, removed_cols) {}
+
+        table_base * operator()(const table_base & _t) override {
+            const bdd_table & t = static_cast<const bdd_table &>(_t);
+            bdd_table_plugin & p = t.get_plugin();
+            bdd_table * res = static_cast<bdd_table *>(p.mk_empty(get_result_signature()));
+            unsigned_vector vars, col_map;
+            unsigned r = 0;
+            for (unsigned col = 0; col < t.num_columns(); ++col) {
+                if (r < m_removed_cols.size() && m_removed_cols[r] == col) {
+                    ++r;
+                    for (unsigned b = 0; b < t.m_num_bits[col]; ++b) {
+                        vars.push_back(var(col, b));
+                    }
+                    col_map.push_back(col);
+                }
+                else {
+                    col_map.push_back(col - r);
+                }
+            }
+            dd::bdd e = p.m_bdd.mk_exists(vars.size(), vars.c_ptr(), t.m_bdd);
+            res->m_bdd = p.mk_rename(e, col_map);
+            return res;
+        }
+    };
+
+    table_transformer_fn * bdd_table_plugin::mk_project_fn(const table_base & t, unsigned col_cnt,
+            const unsigned * removed_cols) {
+        if (t.get_kind() != get_kind()) {
+            return nullptr;
+        }
+        return alloc(project_fn, t.get_signature(), col_cnt, removed_cols);
+    }
+
+    class bdd_table_plugin::rename_fn : public convenient_table_rename_fn {
+    public:
+        rename_fn(const table_signature & orig_sig, unsigned cycle_len, const unsigned * cycle)
+            : convenient_table_rename_fn(orig_sig, cycle_len, cycle) {}
+
+        table_base * operator()(const table_base & _t) override {
+            const bdd_table & t = static_cast<const bdd_table &>(_t);
+            bdd_table_plugin & p = t.get_plugin();
+            bdd_table * res = static_cast<bdd_table *>(p.mk_empty(get_result_signature()));
+            // column m_cycle[i] moves to m_cycle[i-1], and m_cycle[0] to the last column of the cycle
+            unsigned_vector col_map;
+            for (unsigned col = 0; col < t.num_columns(); ++col) {
+                col_map.push_back(col);
+            }
+            unsigned n = m_cycle.size();
+            for (unsigned i = 0; i < n; ++i) {
+                col_map[m_cycle[i]] = m_cycle[(i + n - 1) % n];
+            }
+            res->m_bdd = p.mk_rename(t.m_bdd, col_map);
+            return res;
+        }
+    };
+
+    table_transformer_fn * bdd_table_plugin::mk_rename_fn(const table_base & t, unsigned permutation_cycle_len,
+            const unsigned * permutation_cycle) {
+        if (t.get_kind() != get_kind()) {
+            return nullptr;
+        }
+        return alloc(rename_fn, t.get_signature(), permutation_cycle_len, permutation_cycle);
+    }
+
+    class bdd_table_plugin::filter_equal_fn : public table_mutator_fn {
+        table_element m_value;
+        unsigned      m_col;
+    public:
+        filter_equal_fn(table_element value, unsigned col) : m_value(value), m_col(col) {}
+
+        void operator()(table_base & _t) override {
+            bdd_table & t = static_cast<bdd_table &>(_t);
+            t.m_bdd &= t.get_plugin().mk_value(m_col, t.m_num_bits[m_col], m_value);
+        }
+    };
+
+    table_mutator_fn * bdd_table_plugin::mk_filter_equal_fn(const table_base & t, const table_element & value,
+            unsigned col) {
+        if (t.get_kind() != get_kind()) {
+            return nullptr;
+        }
+        return alloc(filter_equal_fn, value, col);
+    }
+
+    class bdd_table_plugin::filter_identical_fn : public table_mutator_fn {
+        unsigned_vector m_cols;
+    public:
+        filter_identical_fn(unsigned col_cnt, const unsigned * cols) : m_cols(col_cnt, cols) {}
+
+        void operator()(table_base & _t) override {
+            bdd_table & t = static_cast<bdd_table &>(_t);
+            bdd_table_plugin & p = t.get_plugin();
+            for (unsigned i = 1; i < m_cols.size(); ++i) {
+                t.m_bdd &= p.mk_eq(m_cols[0], t.m_num_bits[m_cols[0]], m_cols[i], t.m_num_bits[m_cols[i]]);
+            }
+        }
+    };
+
+    table_mutator_fn * bdd_table_plugin::mk_filter_identical_fn(const table_base & t, unsigned col_cnt,
+            const unsigned * identical_cols) {
+        if (t.get_kind() != get_kind()) {
+            return nullptr;
+        }
+        return alloc(filter_identical_fn, col_cnt, identical_cols);
+    }
+
+    // -----------------------------------
+    //
+    // bdd_table
+    //
+    // -----------------------------------
+
+    class bdd_table::our_iterator_core : public iterator_core {
+        vector<table_fact> m_facts;
+        unsigned           m_index;
+
+        class our_row : public row_interface {
+            const our_iterator_core & m_parent;
+        public:
+            our_row(const bdd_table & t, const our_iterator_core & parent) : row_interface(t), m_parent(parent) {}
+
+            void get_fact(table_fact & result) const override {
+                result = m_parent.m_facts[m_parent.m_index];
+            }
+            table_element operator[](unsigned col) const override {
+                return m_parent.m_facts[m_parent.m_index][col];
+            }
+        };
+
+        our_row m_row_obj;
+
+    public:
+        our_iterator_core(const bdd_table & t, bool finished) : m_index(0), m_row_obj(t, *this) {
+            if (!finished) {
+                table_fact f;
+                f.resize(t.num_columns(), 0);
+                t.collect_facts(t.m_bdd, 0, f, m_facts);
+            }
+        }
+
+        bool is_finished() const override {
+            return m_index == m_facts.size();
+        }
+
+        row_interface & operator*() override {
+            SASSERT(!is_finished());
+            return m_row_obj;
+        }
+        void operator++() override {
+            SASSERT(!is_finished());
+            ++m_index;
+        }
+    };
+
+    bdd_table::bdd_table(bdd_table_plugin & plugin, const table_signature & sig)
+        : table_base(plugin, sig), m_bdd(plugin.m_bdd.mk_false()) {
+        for (unsigned col = 0; col < sig.size(); ++col) {
+            m_num_bits.push_back(bdd_table_plugin::num_bits(sig[col]));
+            for (unsigned b = 0; b < m_num_bits.back(); ++b) {
+                m_vars.push_back(bdd_table_plugin::var(col, b));
+            }
+        }
+        std::sort(m_vars.begin(), m_vars.end(), std::greater<unsigned>());
+    }
+
+    dd::bdd bdd_table::mk_fact(const table_element * f) const {
+        bdd_table_plugin & p = get_plugin();
+        dd::bdd r = p.m_bdd.mk_true();
+        for (unsigned col = 0; col < m_num_bits.size(); ++col) {
+            r &= p.mk_value(col, m_num_bits[col], f[col]);
+        }
+        return r;
+    }
+
+    /**
+       \brief enumerate the facts of b, where the columns of f hold the values of
+       the variables m_vars[0], ..., m_vars[i-1]. The variables of the manager
+       are not reordered, so the variables of b follow the order of m_vars,
+       largest variable first.
+    */
+    void bdd_table::collect_facts(dd::bdd const& b, unsigned i, table_fact & f, vector<table_fact> & facts) const {
+        if (b.is_false()) {
+            return;
+        }
+        if (i == m_vars.size()) {
+            SASSERT(b.is_true());
+            facts.push_back(f);
+            return;
+        }
+        unsigned v = m_vars[i];
+        unsigned col = bdd_table_plugin::var2col(v);
+        table_element mask = static_cast<table_element>(1) << bdd_table_plugin::var2bit(v);
+        SASSERT(b.is_true() || b.var() <= v);
+        bool is_free = b.is_true() || b.var() != v;
+        f[col] &= ~mask;
+        collect_facts(is_free ? b : b.lo(), i + 1, f, facts);
+        f[col] |= mask;
+        collect_facts(is_free ? b : b.hi(), i + 1, f, facts);
+        f[col] &= ~mask;
+    }
+
+    void bdd_table::add_fact(const table_fact & f) {
+        m_bdd |= mk_fact(f.c_ptr());
+    }
+
+    void bdd_table::remove_fact(const table_element* fact) {
+        m_bdd &= !mk_fact(fact);
+    }
+
+    bool bdd_table::contains_fact(const table_fact & f) const {
+        dd::bdd r = mk_fact(f.c_ptr());
+        r &= m_bdd;
+        return !r.is_false();
+    }
+
+    void bdd_table::reset() {
+        m_bdd = get_plugin().m_bdd.mk_false();
+    }
+
+    table_base * bdd_table::clone() const {
+        bdd_table * res = static_cast<bdd_table *>(get_plugin().mk_empty(get_signature()));
+        res->m_bdd = m_bdd;
+        return res;
+    }
+
+    table_base::iterator bdd_table::begin() const {
+        return mk_iterator(alloc(our_iterator_core, *this, false));
+    }
+
+    table_base::iterator bdd_table::end() const {
+        return mk_iterator(alloc(our_iterator_core, *this, true));
+    }
+
+};
@@ -0,0 +1,129 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    dl_bdd_table.h
+
+Abstract:
+
+    Tables represented by binary decision diagrams.
+
+    Column c of a table is encoded by the bits of its values. The BDD
+    variables of all columns are interleaved, most significant bits at the
+    root (the manager puts the variables with the largest index at the root),
+    so that bit b of every column is next to bit b of the other columns.
+    Renaming of columns therefore keeps the bit position and only changes
+    the column of a variable.
+
+    All tables of the plugin share one bdd_manager, whose operation cache
+    is shared by the joins, unions and projections of all tables.
+
+Revision History:
+
+--*/
+
+#pragma once
+
+#include "muz/rel/dl_base.h"
+#include "math/dd/dd_bdd.h"
+
+namespace datalog {
+
+    class bdd_table;
+
+    class bdd_table_plugin : public table_plugin {
+        friend class bdd_table;
+        class join_fn;
+        class union_fn;
+        class project_fn;
+        class rename_fn;
+        class filter_equal_fn;
+        class filter_identical_fn;
+
+        static const unsigned MAX_COLS = 32;
+        static const unsigned MAX_BITS = 32;
+
+        dd::bdd_manager m_bdd;
+
+        dd::bdd mk_rename_rec(dd::bdd const& b, unsigned_vector const& col_map,
+                              u_map<unsigned>& cache, vector<dd::bdd>& results);
+
+    public:
+        typedef bdd_table table;
+
+        bdd_table_plugin(relation_manager & manager);
+
+        /**
+           \brief BDD variable of bit b of column c.
+        */
+        static unsigned var(unsigned col, unsigned bit) { return bit * MAX_COLS + col; }
+        static unsigned var2col(unsigned v) { return v % MAX_COLS; }
+        static unsigned var2bit(unsigned v) { return v / MAX_COLS; }
+
+        /**
+           \brief number of bits used for the values of a column with domain size sz.
+        */
+        static unsigned num_bits(table_sort sz);
+
+        dd::bdd mk_value(unsigned col, unsigned num_bits, table_element value);
+        dd::bdd mk_eq(unsigned col1, unsigned num_bits1, unsigned col2, unsigned num_bits2);
+
+        /**
+           \brief move column c of b to column col_map[c].
+        */
+        dd::bdd mk_rename(dd::bdd const& b, unsigned_vector const& col_map);
+
+        bool can_handle_signature(const table_signature & s) override;
+
+        table_base * mk_empty(const table_signature & s) override;
+
+        table_join_fn * mk_join_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) override;
+        table_union_fn * mk_union_fn(const table_base & tgt, const table_base & src,
+            const table_base * delta) override;
+        table_transformer_fn * mk_project_fn(const table_base & t, unsigned col_cnt,
+            const unsigned * removed_cols) override;
+        table_transformer_fn * mk_rename_fn(const table_base & t, unsigned permutation_cycle_len,
+            const unsigned * permutation_cycle) override;
+        table_mutator_fn * mk_filter_equal_fn(const table_base & t, const table_element & value,
+            unsigned col) override;
+        table_mutator_fn * mk_filter_identical_fn(const table_base & t, unsigned col_cnt,
+            const unsigned * identical_cols) override;
+    };
+
+    class bdd_table : public table_base {
+        friend class bdd_table_plugin;
+        friend class bdd_table_plugin::join_fn;
+        friend class bdd_table_plugin::union_fn;
+        friend class bdd_table_plugin::project_fn;
+        friend class bdd_table_plugin::rename_fn;
+        friend class bdd_table_plugin::filter_equal_fn;
+        friend class bdd_table_plugin::filter_identical_fn;
+
+        class our_iterator_core;
+
+        dd::bdd         m_bdd;
+        unsigned_vector m_num_bits;   // number of bits of each column
+        unsigned_vector m_vars;       // BDD variables of the columns, in decreasing order
+
+        bdd_table(bdd_table_plugin & plugin, const table_signature & sig);
+
+        dd::bdd mk_fact(const table_element * f) const;
+        void collect_facts(dd::bdd const& b, unsigned i, table_fact & f, vector<table_fact> & facts) const;
+    public:
+        bdd_table_plugin & get_plugin() const
+        { return static_cast<bdd_table_plugin &>(table_base::get_plugin()); }
+
+        void add_fact(const table_fact & f) override;
+        void remove_fact(const table_element* fact) override;
+        bool contains_fact(const table_fact & f) const override;
+        void reset() override;
+        table_base * clone() const override;
+        bool empty() const override { return m_bdd.is_false(); }
+
+        iterator begin() const override;
+        iterator end() const override;
+    };
+
+};
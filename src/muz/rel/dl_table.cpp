@@ -21,6 +21,7 @@ Revision History:
 #include "muz/base/dl_util.h"
 #include "muz/rel/dl_table.h"
 #include "muz/rel/dl_relation_manager.h"
+#include "util/thread_pool.h"
 
 namespace datalog {
 
@@ -292,5 +293,394 @@ namespace datalog {
     table_base::iterator bitvector_table::end() const {
         return mk_iterator(alloc(bv_iterator, *this, true));
     }
+
+    // -----------------------------------
+    //
+    // column_table
+    //
+    // -----------------------------------
+
+    bool column_table_plugin::can_handle_signature(const table_signature & sig) {
+        return sig.functional_columns() == 0;
+    }
+
+    table_base * column_table_plugin::mk_empty(const table_signature & s) {
+        SASSERT(can_handle_signature(s));
+        return alloc(column_table, *this, s);
+    }
+
+    class column_table_plugin::join_fn : public convenient_table_join_fn {
+
+        // order the rows of t by the values of the columns cols
+        static void sort_rows(const column_table & t, const unsigned_vector & cols, unsigned_vector & rows) {
+            rows.reset();
+            for (unsigned i = 0; i < t.m_num_rows; ++i) {
+                rows.push_back(i);
+            }
+            std::sort(rows.begin(), rows.end(), [&](unsigned i, unsigned j) {
+                    for (unsigned c : cols) {
+                        table_element a = t.m_columns[c][i], b = t.m_columns[c][j];
+                        if (a != b) return a < b;
+                    }
+                    return i < j;
+                });
+        }
+
+        int compare_keys(const column_table & t1, unsigned i, const column_table & t2, unsigned j) const {
+            for (unsigned k = 0; k < m_cols1.size(); ++k) {
+                table_element a = t1.m_columns[m_cols1[k]][i], b = t2.m_columns[m_cols2[k]][j];
+                if (a != b) return a < b ? -1 : 1;
+            }
+            return 0;
+        }
+
+        // a pair of blocks of rows with the same key, and the first result row of their product
+        struct block {
+            unsigned m_begin1, m_end1, m_begin2, m_end2, m_offset;
+        };
+
+        static const unsigned PARALLEL_MIN_ROWS = 1 << 16;
+        unsigned m_num_threads;
+
+        void emit(const column_table & t1, unsigned_vector const & rows1,
+                  const column_table & t2, unsigned_vector const & rows2,
+                  block const & bl, column_table & res) const {
+            unsigned n1 = t1.m_columns.size(), n2 = t2.m_columns.size();
+            // write the product of the two blocks one column at a time
+            for (unsigned col = 0; col < n1; ++col) {
+                column_table::column const & src = t1.m_columns[col];
+                table_element * dst = res.m_columns[col].c_ptr() + bl.m_offset;
+                for (unsigned a = bl.m_begin1; a < bl.m_end1; ++a) {
+                    for (unsigned b = bl.m_begin2; b < bl.m_end2; ++b) {
+                        *dst++ = src[rows1[a]];
+                    }
+                }
+            }
+            for (unsigned col = 0; col < n2; ++col) {
+                column_table::column const & src = t2.m_columns[col];
+                table_element * dst = res.m_columns[n1 + col].c_ptr() + bl.m_offset;
+                for (unsigned a = bl.m_begin1; a < bl.m_end1; ++a) {
+                    for (unsigned b = bl.m_begin2; b < bl.m_end2; ++b) {
+                        *dst++ = src[rows2[b]];
+                    }
+                }
+            }
+        }
+
+    public:
+        join_fn(const table_signature & t1_sig, const table_signature & t2_sig, unsigned col_cnt, const unsigned * cols1, const unsigned * cols2, unsigned num_threads) 
+            : convenient_table_join_fn(t1_sig, t2_sig, col_cnt, cols1, cols2), m_num_threads(num_threads) {}
+
+        table_base * operator()(const table_base & _t1, const table_base & _t2) override {
+            const column_table & t1 = static_cast<const column_table &>(_t1);
+            const column_table & t2 = static_cast<const column_table &>(_t2);
+            column_table * res = static_cast<column_table *>(t1.get_plugin().mk_empty(get_result_signature()));
+            t1.normalize();
+            t2.normalize();
+            unsigned_vector rows1, rows2;
+            if (m_num_threads > 1 && t1.m_num_rows + t2.m_num_rows >= PARALLEL_MIN_ROWS) {
+                thread_pool::run(2, [&](unsigned k) {
+                        if (k == 0) sort_rows(t1, m_cols1, rows1);
+                        else sort_rows(t2, m_cols2, rows2);
+                    });
+            }
+            else {
+                sort_rows(t1, m_cols1, rows1);
+                sort_rows(t2, m_cols2, rows2);
+            }
+
+            svector<block> blocks;
+            unsigned num_rows = 0;
+            unsigned i = 0, j = 0;
+            while (i < rows1.size() && j < rows2.size()) {
+                int c = compare_keys(t1, rows1[i], t2, rows2[j]);
+                if (c < 0) {
+                    ++i;
+                    continue;
+                }
+                if (c > 0) {
+                    ++j;
+                    continue;
+                }
+                unsigned i_end = i + 1, j_end = j + 1;
+                while (i_end < rows1.size() && compare_keys(t1, rows1[i_end], t2, rows2[j]) == 0) ++i_end;
+                while (j_end < rows2.size() && compare_keys(t1, rows1[i], t2, rows2[j_end]) == 0) ++j_end;
+                blocks.push_back({ i, i_end, j, j_end, num_rows });
+                num_rows += (i_end - i) * (j_end - j);
+                i = i_end;
+                j = j_end;
+            }
+
+            for (column_table::column & c : res->m_columns) {
+                c.resize(num_rows);
+            }
+            res->m_num_rows = num_rows;
+            // the blocks are split into ranges with about the same number of result rows.
+            // Every block is written at its own offset, so the result does not depend
+            // on the number of threads.
+            unsigned num_threads = std::min(m_num_threads, num_rows / PARALLEL_MIN_ROWS);
+            if (num_threads <= 1) {
+                for (block const & bl : blocks) {
+                    emit(t1, rows1, t2, rows2, bl, *res);
+                }
+                return res;
+            }
+            unsigned_vector starts;
+            for (unsigned k = 0, b = 0; k <= num_threads; ++k) {
+                uint64_t limit = static_cast<uint64_t>(num_rows) * k / num_threads;
+                while (b < blocks.size() && blocks[b].m_offset < limit) ++b;
+                starts.push_back(k == num_threads ? blocks.size() : b);
+            }
+            thread_pool::run(num_threads, [&](unsigned k) {
+                    for (unsigned b = starts[k]; b < starts[k + 1]; ++b) {
+                        emit(t1, rows1, t2, rows2, blocks[b], *res);
+                    }
+                });
+            return res;
+        }
+    };
+
+    table_join_fn * column_table_plugin::mk_join_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) {
+        if (t1.get_kind() != get_kind() || t2.get_kind() != get_kind()) {
+            return nullptr;
+        }
+        return alloc(join_fn, t1.get_signature(), t2.get_signature(), col_cnt, cols1, cols2,
+                     get_manager().get_context().join_threads());
+    }
+
+    class column_table_plugin::union_fn : public table_union_fn {
+    public:
+        void operator()(table_base & _tgt, const table_base & _src, table_base * _delta) override {
+            column_table & tgt = static_cast<column_table &>(_tgt);
+            const column_table & src = static_cast<const column_table &>(_src);
+            column_table * delta = static_cast<column_table *>(_delta);
+            tgt.normalize();
+            src.normalize();
+            unsigned i = 0, n = tgt.m_num_rows;
+            for (unsigned j = 0; j < src.m_num_rows; ++j) {
+                while (i < n && tgt.compare_row(i, src, j) < 0) ++i;
+                if (i < n && tgt.compare_row(i, src, j) == 0) {
+                    continue;
+                }
+                tgt.push_row(src, j);
+                if (delta) {
+                    delta->push_row(src, j);
+                }
+            }
+        }
+    };
+
+    table_union_fn * column_table_plugin::mk_union_fn(const table_base & tgt, const table_base & src, 
+            const table_base * delta) {
+        if (tgt.get_kind() != get_kind() || src.get_kind() != get_kind() ||
+            (delta && delta->get_kind() != get_kind())) {
+            return nullptr;
+        }
+        return alloc(union_fn);
+    }
+
+    class column_table_plugin::project_fn : public convenient_table_project_fn {
+    public:
+        project_fn(const table_signature & orig_sig, unsigned col_cnt, const unsigned * removed_cols) 
+            : convenient_table_project_fn(orig_sig, col_cnt, removed_cols) {}
+
+        table_base * operator()(const table_base & _t) override {
+            const column_table & t = static_cast<const column_table &>(_t);
+            column_table * res = static_cast<column_table *>(t.get_plugin().mk_empty(get_result_signature()));
+            unsigned r = 0, k = 0;
+            for (unsigned col = 0; col < t.m_columns.size(); ++col) {
+                if (r < m_removed_cols.size() && m_removed_cols[r] == col) {
+                    ++r;
+                    continue;
+                }
+                res->m_columns[k++] = t.m_columns[col];
+            }
+            res->m_num_rows = t.m_num_rows;
+            return res;
+        }
+    };
+
+    table_transformer_fn * column_table_plugin::mk_project_fn(const table_base & t, unsigned col_cnt, 
+            const unsigned * removed_cols) {
+        if (t.get_kind() != get_kind()) {
+            return nullptr;
+        }
+        return alloc(project_fn, t.get_signature(), col_cnt, removed_cols);
+    }
+
+    class column_table::our_iterator_core : public iterator_core {
+        const column_table & m_parent;
+        unsigned m_row;
+
+        class our_row : public row_interface {
+            const our_iterator_core & m_parent;
+        public:
+            our_row(const our_iterator_core & parent) : row_interface(parent.m_parent), m_parent(parent) {}
+
+            table_element operator[](unsigned col) const override {
+                return m_parent.m_parent.m_columns[col][m_parent.m_row];
+            }
+        };
+
+        our_row m_row_obj;
+
+    public:
+        our_iterator_core(const column_table & t, bool finished) : 
+            m_parent(t), m_row(finished ? t.m_num_rows : 0), m_row_obj(*this) {}
+
+        bool is_finished() const override {
+            return m_row == m_parent.m_num_rows;
+        }
+
+        row_interface & operator*() override {
+            SASSERT(!is_finished());
+            return m_row_obj;
+        }
+        void operator++() override {
+            SASSERT(!is_finished());
+            ++m_row;
+        }
+    };
+
+    column_table::column_table(column_table_plugin & plugin, const table_signature & sig)
+        : table_base(plugin, sig), m_columns(sig.size()), m_num_rows(0), m_num_sorted(0) {}
+
+    int column_table::compare_row(unsigned i, const column_table & other, unsigned j) const {
+        for (unsigned col = 0; col < m_columns.size(); ++col) {
+            table_element a = m_columns[col][i], b = other.m_columns[col][j];
+            if (a != b) return a < b ? -1 : 1;
+        }
+        return 0;
+    }
+
+    int column_table::compare_fact(unsigned i, const table_element * f) const {
+        for (unsigned col = 0; col < m_columns.size(); ++col) {
+            table_element a = m_columns[col][i];
+            if (a != f[col]) return a < f[col] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    bool column_table::find_fact(const table_element * f, unsigned & row) const {
+        normalize();
+        unsigned lo = 0, hi = m_num_rows;
+        while (lo < hi) {
+            unsigned mid = lo + (hi - lo) / 2;
+            int c = compare_fact(mid, f);
+            if (c == 0) {
+                row = mid;
+                return true;
+            }
+            if (c < 0) 
+                lo = mid + 1;
+            else 
+                hi = mid;
+        }
+        return false;
+    }
+
+    void column_table::push_row(const column_table & src, unsigned row) {
+        for (unsigned col = 0; col < m_columns.size(); ++col) {
+            m_columns[col].push_back(src.m_columns[col][row]);
+        }
+        if (m_num_sorted == m_num_rows && (m_num_rows == 0 || compare_row(m_num_rows - 1, src, row) < 0)) {
+            ++m_num_sorted;
+        }
+        ++m_num_rows;
+    }
+
+    /**
+       \brief sort the rows added since the last normalization, 
+       merge them with the sorted rows and remove duplicates.
+    */
+    void column_table::normalize() const {
+        if (m_num_sorted == m_num_rows) {
+            return;
+        }
+        unsigned_vector added;
+        for (unsigned i = m_num_sorted; i < m_num_rows; ++i) {
+            added.push_back(i);
+        }
+        std::sort(added.begin(), added.end(), [&](unsigned i, unsigned j) { return compare_row(i, *this, j) < 0; });
+        unsigned_vector order;
+        unsigned i = 0, k = 0;
+        while (i < m_num_sorted || k < added.size()) {
+            unsigned r;
+            if (k == added.size() || (i < m_num_sorted && compare_row(i, *this, added[k]) <= 0)) 
+                r = i++;
+            else 
+                r = added[k++];
+            if (order.empty() || compare_row(order.back(), *this, r) != 0) {
+                order.push_back(r);
+            }
+        }
+        column tmp;
+        for (column & c : m_columns) {
+            tmp.reset();
+            for (unsigned r : order) {
+                tmp.push_back(c[r]);
+            }
+            c.swap(tmp);
+        }
+        m_num_rows = m_num_sorted = order.size();
+    }
+
+    void column_table::add_fact(const table_fact & f) {
+        SASSERT(f.size() == m_columns.size());
+        bool in_order = m_num_sorted == m_num_rows && (m_num_rows == 0 || compare_fact(m_num_rows - 1, f.c_ptr()) < 0);
+        for (unsigned col = 0; col < m_columns.size(); ++col) {
+            m_columns[col].push_back(f[col]);
+        }
+        ++m_num_rows;
+        if (in_order) {
+            m_num_sorted = m_num_rows;
+        }
+    }
+
+    void column_table::remove_fact(const table_element* fact) {
+        unsigned row = 0;
+        if (!find_fact(fact, row)) {
+            return;
+        }
+        for (column & c : m_columns) {
+            for (unsigned i = row + 1; i < c.size(); ++i) {
+                c[i - 1] = c[i];
+            }
+            c.pop_back();
+        }
+        --m_num_rows;
+        --m_num_sorted;
+    }
+
+    bool column_table::contains_fact(const table_fact & f) const {
+        unsigned row = 0;
+        return find_fact(f.c_ptr(), row);
+    }
+
+    void column_table::reset() {
+        for (column & c : m_columns) {
+            c.reset();
+        }
+        m_num_rows = m_num_sorted = 0;
+    }
+
+    table_base * column_table::clone() const {
+        column_table * res = static_cast<column_table *>(get_plugin().mk_empty(get_signature()));
+        res->m_columns = m_columns;
+        res->m_num_rows = m_num_rows;
+        res->m_num_sorted = m_num_sorted;
+        return res;
+    }
+
+    table_base::iterator column_table::begin() const {
+        normalize();
+        return mk_iterator(alloc(our_iterator_core, *this, false));
+    }
+
+    table_base::iterator column_table::end() const {
+        normalize();
+        return mk_iterator(alloc(our_iterator_core, *this, true));
+    }
 };
 
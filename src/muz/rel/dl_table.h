@@ -144,7 +144,85 @@ namespace datalog {
         iterator end() const override;
     };
 
+    // -----------------------------------
+    //
+    // column_table
+    //
+    // -----------------------------------
+
+    class column_table;
+
+    class column_table_plugin : public table_plugin {
+        friend class column_table;
+    protected:
+        class join_fn;
+        class union_fn;
+        class project_fn;
+    public:
+        typedef column_table table;
+
+        column_table_plugin(relation_manager & manager) 
+            : table_plugin(symbol("column"), manager) {}
+
+        bool can_handle_signature(const table_signature & s) override;
+
+        table_base * mk_empty(const table_signature & s) override;
+
+        table_join_fn * mk_join_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) override;
+        table_union_fn * mk_union_fn(const table_base & tgt, const table_base & src, 
+            const table_base * delta) override;
+        table_transformer_fn * mk_project_fn(const table_base & t, unsigned col_cnt, 
+            const unsigned * removed_cols) override;
+    };
 
+    /**
+       \brief table that stores each column in its own vector.
+
+       The rows are sorted lexicographically and distinct, except for the rows
+       added since the table was last normalized. Joins sort the rows of both
+       tables by the joined columns and merge them, and unions merge the sorted
+       rows of both tables, so neither builds an index.
+    */
+    class column_table : public table_base {
+        friend class column_table_plugin;
+        friend class column_table_plugin::join_fn;
+        friend class column_table_plugin::union_fn;
+        friend class column_table_plugin::project_fn;
+
+        class our_iterator_core;
+
+        typedef svector<table_element> column;
+
+        mutable vector<column> m_columns;
+        mutable unsigned       m_num_rows;
+        mutable unsigned       m_num_sorted;  // rows below m_num_sorted are sorted and distinct
+
+        column_table(column_table_plugin & plugin, const table_signature & sig);
+
+        int compare_row(unsigned i, const column_table & other, unsigned j) const;
+        int compare_fact(unsigned i, const table_element * f) const;
+        bool find_fact(const table_element * f, unsigned & row) const;
+        void push_row(const column_table & src, unsigned row);
+        void normalize() const;
+    public:
+        column_table_plugin & get_plugin() const 
+        { return static_cast<column_table_plugin &>(table_base::get_plugin()); }
+
+        void add_fact(const table_fact & f) override;
+        void remove_fact(const table_element* fact) override;
+        bool contains_fact(const table_fact & f) const override;
+        void reset() override;
+        table_base * clone() const override;
+        bool empty() const override { return m_num_rows == 0; }
+
+        iterator begin() const override;
+        iterator end() const override;
+
+        unsigned get_size_estimate_rows() const override { return m_num_rows; }
+        unsigned get_size_estimate_bytes() const override { return m_num_rows*get_signature().size()*8; }
+        bool knows_exact_size() const override { return m_num_sorted == m_num_rows; }
+    };
     
 };
 
@@ -37,6 +37,7 @@ Revision History:
 #include "muz/rel/dl_lazy_table.h"
 #include "muz/rel/dl_sparse_table.h"
 #include "muz/rel/dl_table.h"
+#include "muz/rel/dl_bdd_table.h"
 #include "muz/rel/dl_table_relation.h"
 #include "muz/rel/aig_exporter.h"
 #include "muz/rel/dl_mk_simple_joins.h"
@@ -107,6 +108,8 @@ namespace datalog {
         rm.register_plugin(alloc(sparse_table_plugin, rm));
         rm.register_plugin(alloc(hashtable_table_plugin, rm));
         rm.register_plugin(alloc(bitvector_table_plugin, rm));
+        rm.register_plugin(alloc(column_table_plugin, rm));
+        rm.register_plugin(alloc(bdd_table_plugin, rm));
         rm.register_plugin(lazy_table_plugin::mk_sparse(rm));
 
         // register plugins for builtin relations
@@ -752,6 +752,9 @@ void pred_transformer::collect_statistics(statistics& st) const
     st.update("SPACER num ctp blocked", m_stats.m_num_ctp_blocked);
     st.update("SPACER num is_invariant", m_stats.m_num_is_invariant);
     st.update("SPACER num lemma jumped", m_stats.m_num_lemma_level_jump);
+    // -- number of projections reused from the mbp cache
+    st.update("SPACER num mbp cache hits", m_stats.m_num_mbp_cache_hits);
+    st.update("SPACER num mbp cache misses", m_stats.m_num_mbp_cache_misses);
 
     // -- time in rule initialization
     st.update ("time.spacer.init_rules.pt.init", m_initialize_watch.get_seconds ());
@@ -1326,7 +1329,56 @@ bool pred_transformer::is_qblocked (pob &n) {
 void pred_transformer::mbp(app_ref_vector &vars, expr_ref &fml, model &mdl,
                            bool reduce_all_selects, bool force) {
     scoped_watch _t_(m_mbp_watch);
+    unsigned cache_size = ctx.mbp_cache_size();
+    if (cache_size == 0) {
+        qe_project(m, vars, fml, mdl, reduce_all_selects, use_native_mbp(), !force);
+        return;
+    }
+
+    // -- a projection of fml is an implicant of the projected formula,
+    // -- so a cached projection can be reused whenever it is true in mdl
+    unsigned idx = 0;
+    if (m_mbp_cache.find(fml, idx)) {
+        mbp_entry const& e = m_mbp_entries[idx];
+        model::scoped_model_completion _sc_(mdl, false);
+        if (e.m_reduce_all_selects == reduce_all_selects && e.m_force == force &&
+            e.m_vars.size() == vars.size() &&
+            std::equal(vars.begin(), vars.end(), e.m_vars.begin()) &&
+            mdl.is_true(e.m_result)) {
+            m_stats.m_num_mbp_cache_hits++;
+            fml = e.m_result;
+            vars.reset();
+            return;
+        }
+    }
+    m_stats.m_num_mbp_cache_misses++;
+
+    mbp_entry e(m);
+    e.m_fml = fml;
+    e.m_vars.append(vars);
+    e.m_reduce_all_selects = reduce_all_selects;
+    e.m_force = force;
     qe_project(m, vars, fml, mdl, reduce_all_selects, use_native_mbp(), !force);
+    // -- only complete projections are cached
+    if (!vars.empty())
+        return;
+
+    e.m_result = fml;
+    if (m_mbp_cache.find(e.m_fml, idx)) {
+        mbp_entry &old = m_mbp_entries[idx];
+        old.m_vars.reset();
+        old.m_vars.append(e.m_vars);
+        old.m_result = e.m_result;
+        old.m_reduce_all_selects = reduce_all_selects;
+        old.m_force = force;
+        return;
+    }
+    if (m_mbp_entries.size() >= cache_size) {
+        m_mbp_cache.reset();
+        m_mbp_entries.reset();
+    }
+    m_mbp_cache.insert(e.m_fml, m_mbp_entries.size());
+    m_mbp_entries.push_back(e);
 }
 
 //
@@ -1985,62 +2037,61 @@ bool pred_transformer::frames::add_lemma(lemma *new_lemma)
         return true;
     }
 
-    unsigned i = 0;
-    for (auto *old_lemma : m_lemmas) {
-        if (old_lemma->get_expr() == new_lemma->get_expr()) {
-            m_pt.get_context().new_lemma_eh(m_pt, new_lemma);
-
-            // register existing lemma with the pob
-            if (new_lemma->has_pob()) {
-                pob_ref &pob = new_lemma->get_pob();
-                if (!pob->lemmas().contains(old_lemma))
-                    pob->add_lemma(old_lemma);
-            }
+    lemma *old_lemma = nullptr;
+    if (m_expr2lemma.find(new_lemma->get_expr(), old_lemma)) {
+        m_pt.get_context().new_lemma_eh(m_pt, new_lemma);
 
-            // extend bindings if needed
+        // register existing lemma with the pob
+        if (new_lemma->has_pob()) {
+            pob_ref &pob = new_lemma->get_pob();
+            if (!pob->lemmas().contains(old_lemma))
+                pob->add_lemma(old_lemma);
+        }
+
+        // extend bindings if needed
+        if (!new_lemma->get_bindings().empty()) {
+            old_lemma->add_binding(new_lemma->get_bindings());
+        }
+        // if the lemma is at a higher level, skip it,
+        if (old_lemma->level() >= new_lemma->level()) {
+            TRACE("spacer", tout << "Already at a higher level: "
+                  << pp_level(old_lemma->level()) << "\n";);
+            // but, since the instances might be new, assert the
+            // instances that have been copied into m_lemmas[i]
             if (!new_lemma->get_bindings().empty()) {
-                old_lemma->add_binding(new_lemma->get_bindings());
+                m_pt.add_lemma_core(old_lemma, true);
             }
-            // if the lemma is at a higher level, skip it,
-            if (old_lemma->level() >= new_lemma->level()) {
-                TRACE("spacer", tout << "Already at a higher level: "
-                      << pp_level(old_lemma->level()) << "\n";);
-                // but, since the instances might be new, assert the
-                // instances that have been copied into m_lemmas[i]
-                if (!new_lemma->get_bindings().empty()) {
-                    m_pt.add_lemma_core(old_lemma, true);
-                }
-                if (is_infty_level(old_lemma->level())) {
-                    old_lemma->bump();
-                    if (old_lemma->get_bumped() >= 100) {
-                        IF_VERBOSE(1, verbose_stream() << "Adding lemma to oo "
-                                   << old_lemma->get_bumped() << " "
-                                   << mk_pp(old_lemma->get_expr(),
-                                            m_pt.get_ast_manager()) << "\n";);
-                        throw default_exception("Stuck on a lemma");
-                    }
+            if (is_infty_level(old_lemma->level())) {
+                old_lemma->bump();
+                if (old_lemma->get_bumped() >= 100) {
+                    IF_VERBOSE(1, verbose_stream() << "Adding lemma to oo "
+                               << old_lemma->get_bumped() << " "
+                               << mk_pp(old_lemma->get_expr(),
+                                        m_pt.get_ast_manager()) << "\n";);
+                    throw default_exception("Stuck on a lemma");
                 }
-                // no new lemma added
-                return false;
             }
+            // no new lemma added
+            return false;
+        }
 
-            // update level of the existing lemma
-            old_lemma->set_level(new_lemma->level());
-            // assert lemma in the solver
-            m_pt.add_lemma_core(old_lemma, false);
-            // move the lemma to its new place to maintain sortedness
-            unsigned sz = m_lemmas.size();
-            for (unsigned j = i;
-                 (j + 1) < sz && m_lt(m_lemmas[j + 1], m_lemmas[j]); ++j) {
-                m_lemmas.swap (j, j+1);
-            }
-            return true;
+        // update level of the existing lemma
+        unsigned i = find_lemma(old_lemma);
+        old_lemma->set_level(new_lemma->level());
+        // assert lemma in the solver
+        m_pt.add_lemma_core(old_lemma, false);
+        // move the lemma to its new place to maintain sortedness
+        unsigned sz = m_lemmas.size();
+        for (unsigned j = i;
+             (j + 1) < sz && m_lt(m_lemmas[j + 1], m_lemmas[j]); ++j) {
+            m_lemmas.swap (j, j+1);
         }
-        i++;
+        return true;
     }
 
     // new_lemma is really new
     m_lemmas.push_back(new_lemma);
+    m_expr2lemma.insert(new_lemma->get_expr(), new_lemma);
     // XXX because m_lemmas is reduced, keep secondary vector of all lemmas
     // XXX so that pob can refer to its lemmas without creating reference cycles
     m_pinned_lemmas.push_back(new_lemma);
@@ -2056,6 +2107,19 @@ bool pred_transformer::frames::add_lemma(lemma *new_lemma)
 }
 
 
+/// position of an active lemma in m_lemmas
+unsigned pred_transformer::frames::find_lemma(lemma *l)
+{
+    if (m_sorted) {
+        auto it = std::lower_bound(m_lemmas.c_ptr(), m_lemmas.c_ptr() + m_lemmas.size(), l, m_lt);
+        if (it != m_lemmas.c_ptr() + m_lemmas.size() && *it == l)
+            return static_cast<unsigned>(it - m_lemmas.c_ptr());
+    }
+    unsigned i = 0;
+    while (m_lemmas.get(i) != l) ++i;
+    return i;
+}
+
 void pred_transformer::frames::propagate_to_infinity (unsigned level)
 {
     for (unsigned i = 0, sz = m_lemmas.size (); i < sz; ++i)
@@ -2205,6 +2269,9 @@ void pred_transformer::frames::simplify_formulas ()
     if (new_lemmas.size() < m_lemmas.size()) {
         m_lemmas.reset();
         m_lemmas.append(new_lemmas);
+        m_expr2lemma.reset();
+        for (lemma *l : m_lemmas)
+            m_expr2lemma.insert(l->get_expr(), l);
         m_sorted = false;
         sort();
     }
@@ -2343,6 +2410,7 @@ void context::updt_params() {
     m_simplify_formulas_pre = m_params.spacer_simplify_lemmas_pre();
     m_simplify_formulas_post = m_params.spacer_simplify_lemmas_post();
     m_use_native_mbp = m_params.spacer_native_mbp ();
+    m_mbp_cache_size = m_params.spacer_mbp_cache_size ();
     m_instantiate = m_params.spacer_q3_instantiate ();
     m_use_qlemmas = m_params.spacer_q3();
     m_weak_abs = m_params.spacer_weak_abs();
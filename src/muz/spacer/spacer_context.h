@@ -212,6 +212,8 @@ class pred_transformer {
         unsigned m_num_is_invariant; // num of times lemmas are pushed
         unsigned m_num_lemma_level_jump; // lemma learned at higher level than expected
         unsigned m_num_reach_queries;
+        unsigned m_num_mbp_cache_hits; // num of mbp calls answered from the cache
+        unsigned m_num_mbp_cache_misses;
 
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
@@ -225,12 +227,14 @@ class pred_transformer {
         lemma_ref_vector m_pinned_lemmas;  // all created lemmas
         lemma_ref_vector m_lemmas;         // active lemmas
         lemma_ref_vector m_bg_invs;        // background (assumed) invariants
+        obj_map<expr, lemma*> m_expr2lemma; // active lemma of each lemma formula
         unsigned m_size;                   // num of frames
 
         bool m_sorted;                     // true if m_lemmas is sorted by m_lt
         lemma_lt_proc m_lt;                // sort order for m_lemmas
 
         void sort ();
+        unsigned find_lemma(lemma *l);
 
     public:
         frames (pred_transformer &pt) : m_pt (pt),
@@ -411,6 +415,19 @@ class pred_transformer {
     stopwatch                    m_mbp_watch;
     bool                         m_has_quantified_frame; // True when a quantified lemma is in the frame
 
+    /// a projection computed by mbp(), reused while it holds in the model
+    struct mbp_entry {
+        expr_ref       m_fml;
+        app_ref_vector m_vars;
+        expr_ref       m_result;
+        bool           m_reduce_all_selects;
+        bool           m_force;
+        mbp_entry(ast_manager &m) : m_fml(m), m_vars(m), m_result(m),
+            m_reduce_all_selects(false), m_force(false) {}
+    };
+    obj_map<expr, unsigned>      m_mbp_cache;       // formula to index in m_mbp_entries
+    vector<mbp_entry>            m_mbp_entries;
+
     void init_sig();
     app_ref mk_extend_lit();
     void ensure_level(unsigned level);
@@ -955,6 +972,7 @@ class context {
     model_converter_ref  m_mc;
     proof_converter_ref  m_pc;
     bool                 m_use_native_mbp;
+    unsigned             m_mbp_cache_size;
     bool                 m_instantiate;
     bool                 m_use_qlemmas;
     bool                 m_weak_abs;
@@ -1071,6 +1089,7 @@ public:
     const fp_params &get_params() const { return m_params; }
     bool use_eq_prop() const {return m_use_eq_prop;}
     bool use_native_mbp() const {return m_use_native_mbp;}
+    unsigned mbp_cache_size() const {return m_mbp_cache_size;}
     bool use_ground_pob() const {return m_ground_pob;}
     bool use_instantiate() const {return m_instantiate;}
     bool weak_abs() const {return m_weak_abs;}
@@ -19,6 +19,7 @@ Revision History:
 --*/
 #include "nlsat/nlsat_evaluator.h"
 #include "nlsat/nlsat_solver.h"
+#include "util/map.h"
 
 namespace nlsat {
 
@@ -359,6 +360,24 @@ namespace nlsat {
 
         sign_table m_sign_table_tmp;
 
+        /**
+           \brief roots of univariate polynomials and the signs of the polynomials between them.
+           They do not depend on the assignment, so they are isolated once per polynomial.
+           The polynomials are referenced by the cache, so their ids are not reused.
+        */
+        struct root_cache_entry {
+            unsigned m_first_root;
+            unsigned m_num_roots;
+            unsigned m_first_sign;
+            unsigned m_num_signs;
+        };
+        static const unsigned MAX_ROOT_CACHE_SIZE = 10000;
+        polynomial_ref_vector        m_cached_polys;
+        u_map<root_cache_entry>      m_root_cache;
+        scoped_anum_vector           m_cached_roots;
+        svector<sign>                m_cached_signs;
+        svector<sign>                m_signs_tmp;
+
         imp(solver& s, assignment const & x2v, pmanager & pm, small_object_allocator & allocator):
             m_solver(s),
             m_assignment(x2v),
@@ -369,7 +388,55 @@ namespace nlsat {
             m_tmp_values(m_am),
             m_add_roots_tmp(m_am),
             m_inf_tmp(m_am),
-            m_sign_table_tmp(m_am) {
+            m_sign_table_tmp(m_am),
+            m_cached_polys(pm),
+            m_cached_roots(m_am) {
+        }
+
+        void reset_root_cache() {
+            m_root_cache.reset();
+            m_cached_roots.reset();
+            m_cached_signs.reset();
+            m_cached_polys.reset();
+        }
+
+        /**
+           \brief isolate the roots of p, viewed as a polynomial in x, and the signs of p between them
+           if signs is not null. All variables of p but x must be assigned.
+        */
+        void isolate_roots(poly * p, var x, scoped_anum_vector & roots, svector<sign> * signs) {
+            if (!polynomial::manager::is_univariate(p) || max_var(p) != x) {
+                if (signs)
+                    m_am.isolate_roots(polynomial_ref(p, m_pm), undef_var_assignment(m_assignment, x), roots, *signs);
+                else
+                    m_am.isolate_roots(polynomial_ref(p, m_pm), undef_var_assignment(m_assignment, x), roots);
+                return;
+            }
+            unsigned id = polynomial::manager::id(p);
+            root_cache_entry e;
+            if (m_root_cache.find(id, e)) {
+                for (unsigned i = 0; i < e.m_num_roots; ++i) 
+                    roots.push_back(m_cached_roots[e.m_first_root + i]);
+                for (unsigned i = 0; signs && i < e.m_num_signs; ++i) 
+                    signs->push_back(m_cached_signs[e.m_first_sign + i]);
+                return;
+            }
+            if (!signs) {
+                m_signs_tmp.reset();
+                signs = &m_signs_tmp;
+            }
+            m_am.isolate_roots(polynomial_ref(p, m_pm), undef_var_assignment(m_assignment, x), roots, *signs);
+            if (m_root_cache.size() >= MAX_ROOT_CACHE_SIZE)
+                reset_root_cache();
+            e.m_first_root = m_cached_roots.size();
+            e.m_num_roots = roots.size();
+            e.m_first_sign = m_cached_signs.size();
+            e.m_num_signs = signs->size();
+            for (unsigned i = 0; i < roots.size(); ++i)
+                m_cached_roots.push_back(roots[i]);
+            m_cached_signs.append(*signs);
+            m_cached_polys.push_back(p);
+            m_root_cache.insert(id, e);
         }
 
         var max_var(poly const * p) const {
@@ -422,7 +489,7 @@ namespace nlsat {
             atom::kind k = a->get_kind();
             scoped_anum_vector & roots = m_tmp_values;
             roots.reset();
-            m_am.isolate_roots(polynomial_ref(a->p(), m_pm), undef_var_assignment(m_assignment, a->x()), roots);
+            isolate_roots(a->p(), a->x(), roots, nullptr);
             TRACE("nlsat_evaluator",
                   m_solver.display(tout << (neg?"!":""), *a); tout << "\n";
                   if (roots.empty()) {
@@ -464,7 +531,7 @@ namespace nlsat {
                 TRACE("nlsat_evaluator", tout << "x: " << x << " max_var(p): " << m_pm.max_var(p) << "\n";);
                 // Note: I added undef_var_assignment in the following statement, to allow us to obtain the infeasible interval sets
                 // even when the maximal variable is assigned. I need this feature to minimize conflict cores.
-                m_am.isolate_roots(polynomial_ref(p, m_pm), undef_var_assignment(m_assignment, x), roots, signs);
+                isolate_roots(p, x, roots, &signs);
                 t.add(roots, signs);
             }
         }
@@ -603,7 +670,7 @@ namespace nlsat {
             var x = a->max_var();
             // Note: I added undef_var_assignment in the following statement, to allow us to obtain the infeasible interval sets
             // even when the maximal variable is assigned. I need this feature to minimize conflict cores.
-            m_am.isolate_roots(polynomial_ref(a->p(), m_pm), undef_var_assignment(m_assignment, x), roots);
+            isolate_roots(a->p(), x, roots, nullptr);
             interval_set_ref result(m_ism);
 
             if (i > roots.size()) {
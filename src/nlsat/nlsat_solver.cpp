@@ -76,6 +76,7 @@ namespace nlsat {
             typedef small_object_allocator   allocator;
             typedef void *                   value;
             static const bool ref_count =    false;
+            static const bool hash_cons =    false;
         };
         typedef dependency_manager<dconfig>  assumption_manager;
         typedef assumption_manager::dependency * _assumption_set;
@@ -276,6 +277,7 @@ namespace nlsat {
             m_explain.set_simplify_cores(m_simplify_cores);
             m_explain.set_minimize_cores(min_cores);
             m_explain.set_factor(p.factor());
+            m_cache.set_max_entries(p.cache_size());
             m_am.updt_params(p.p);
         }
 
@@ -2222,6 +2224,7 @@ namespace nlsat {
             st.update("nlsat decisions", m_decisions);
             st.update("nlsat stages", m_stages);
             st.update("nlsat irrational assignments", m_irrational_assignments);
+            m_cache.collect_statistics(st);
         }
 
         void reset_statistics() {
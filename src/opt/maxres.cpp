@@ -64,6 +64,14 @@ Notes:
 #include "opt/opt_params.hpp"
 #include "opt/maxsmt.h"
 #include "opt/maxres.h"
+#include "opt/totalizer.h"
+#include "opt/pb_sls.h"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
+#ifndef SINGLE_THREAD
+#include <mutex>
+#endif
 
 using namespace opt;
 
@@ -77,6 +85,8 @@ private:
     struct stats {
         unsigned m_num_cores;
         unsigned m_num_cs;
+        unsigned m_num_totalizers;
+        unsigned m_num_sls_improvements;
         stats() { reset(); }
         void reset() {
             memset(this, 0, sizeof(*this));
@@ -104,6 +114,13 @@ private:
     bool             m_maximize_assignment;    // maximize assignment to find MCS
     unsigned         m_max_correction_set_size;// maximal set of correction set that is tolerated.
     bool             m_wmax;                   // Block upper bound using wmax
+    bool             m_use_totalizer;          // relax cores using incremental totalizers (OLL)
+    bool             m_enable_sls;             // improve new models using local search
+    bool             m_warm_start;             // seed the upper bound from the initial model
+    bool             m_in_sls;
+    expr_ref_vector  m_sls_hard;               // hard constraints before relaxation
+    scoped_ptr_vector<totalizer> m_totalizers;
+    obj_map<expr, std::pair<unsigned, unsigned>> m_asm2bound; // !o_k |-> (totalizer, k)
                                                // this option is disabled if SAT core is used.
     bool             m_pivot_on_cs;            // prefer smaller correction set to core.
     bool             m_dump_benchmarks;        // display benchmarks (into wcnf format)
@@ -133,7 +150,12 @@ public:
         m_max_core_size(3),
         m_maximize_assignment(false),
         m_max_correction_set_size(3),
-        m_pivot_on_cs(true)       
+        m_pivot_on_cs(true),
+        m_use_totalizer(false),
+        m_enable_sls(false),
+        m_warm_start(false),
+        m_in_sls(false),
+        m_sls_hard(m)
     {
         switch(st) {
         case s_primal:
@@ -353,6 +375,16 @@ public:
     void collect_statistics(statistics& st) const override {
         st.update("maxres-cores", m_stats.m_num_cores);
         st.update("maxres-correction-sets", m_stats.m_num_cs);
+        if (m_use_totalizer) {
+            unsigned num_clauses = 0;
+            for (totalizer* t : m_totalizers)
+                num_clauses += t->num_clauses();
+            st.update("maxres-totalizers", m_stats.m_num_totalizers);
+            st.update("maxres-totalizer-clauses", num_clauses);
+        }
+        if (m_enable_sls) {
+            st.update("maxres-sls-improvements", m_stats.m_num_sls_improvements);
+        }
     }
 
     struct weighted_core {
@@ -517,7 +549,10 @@ public:
         SASSERT(!core.empty());
         TRACE("opt", display_vec(tout << "minimized core: ", core););
         IF_VERBOSE(10, display_vec(verbose_stream() << "core: ", core););        
-        max_resolve(core, w);
+        if (m_use_totalizer)
+            totalizer_resolve(core, w);
+        else
+            max_resolve(core, w);
         fml = mk_not(m, mk_and(m, core.size(), core.c_ptr()));
         add(fml);
         // save small cores such that lex-combinations of maxres can reuse these cores.
@@ -678,6 +713,53 @@ public:
         }
     }
 
+    //
+    // OLL relaxation of a core.
+    //
+    // The core forces some of its literals to be false. It is relaxed by 
+    // the soft constraint !o_2 of a totalizer over the negated core literals,
+    // that is, at most one literal of the core is false. 
+    // When !o_k of a totalizer occurs in a core, the bound of the totalizer 
+    // is relaxed to !o_{k+1} by extending the existing encoding.
+    // 
+    void totalizer_resolve(exprs const& core, rational const& w) {
+        std::pair<unsigned, unsigned> b;
+        for (expr* a : core) {
+            if (m_asm2bound.find(a, b) && b.second < m_totalizers[b.first]->size()) {
+                new_bound_assumption(b.first, b.second + 1, w);
+            }
+        }
+        if (core.size() > 1) {
+            expr_ref_vector lits(m);
+            for (expr* a : core) {
+                lits.push_back(mk_not(m, a));
+            }
+            m_totalizers.push_back(alloc(totalizer, m, m_c.fm(), lits));
+            ++m_stats.m_num_totalizers;
+            new_bound_assumption(m_totalizers.size() - 1, 2, w);
+        }
+    }
+
+    void new_bound_assumption(unsigned idx, unsigned k, rational const& w) {
+        totalizer& t = *m_totalizers[idx];
+        expr_ref o(t.at_least(k), m);
+        for (expr* c : t.clauses()) {
+            add(c);
+            m_defs.push_back(c);
+        }
+        t.reset_clauses();
+        pb_util pb(m);
+        expr_ref value(pb.mk_at_least_k(t.size(), t.literals().c_ptr(), k), m);
+        update_model(o, value);
+        expr_ref asum(mk_not(m, o), m);
+        if (m_asm2bound.contains(asum) && m_asms.contains(asum)) {
+            m_asm2weight.insert(asum, get_weight(asum) + w);
+            return;
+        }
+        m_asm2bound.insert(asum, std::make_pair(idx, k));
+        new_assumption(asum, w);
+    }
+
     // cs is a correction set (a complement of a (maximal) satisfying assignment).
     void cs_max_resolve(exprs const& cs, rational const& w) {
         if (cs.empty()) return;
@@ -756,10 +838,18 @@ public:
             return;
         }
 
-        if (!m_c.verify_model(m_index, mdl.get(), upper)) {
+        if (!update_upper(mdl, upper)) {
             return;
         }
 
+        sls_improve();
+    }
+
+    bool update_upper(model_ref & mdl, rational const& upper) {
+        if (!m_c.verify_model(m_index, mdl.get(), upper)) {
+            return false;
+        }
+
         m_model = mdl;
         m_c.model_updated(mdl.get());
 
@@ -776,6 +866,76 @@ public:
         trace();
 
         add_upper_bound_block();
+        return true;
+    }
+
+    // 
+    // Weighted local search seeded by the current model. 
+    // The hard constraints that local search does not handle are abstracted
+    // by literals, so the result is only used if it satisfies the hard 
+    // constraints that were asserted before relaxation.
+    // 
+    void sls_improve() {
+        if (!m_enable_sls || m_in_sls || m_lower == m_upper) {
+            return;
+        }
+        flet<bool> _in_sls(m_in_sls, true);
+        smt::pb_sls sls(m);
+        sls.set_model(m_model);
+        for (expr* f : m_sls_hard) {
+            sls.add(f);
+        }
+        for (soft const& s : m_soft) {
+            sls.add(s.s, s.weight);
+        }
+        if (sls() != l_true || !m.inc()) {
+            return;
+        }
+        model_ref sls_mdl;
+        sls.get_model(sls_mdl);
+        model_ref mdl = m_model->copy();
+        for (unsigned i = 0; i < sls_mdl->get_num_constants(); ++i) {
+            func_decl* d = sls_mdl->get_constant(i);
+            mdl->register_decl(d, sls_mdl->get_const_interp(d));
+        }
+        mdl->set_model_completion(true);
+        for (expr* f : m_sls_hard) {
+            if (!mdl->is_true(f)) {
+                return;
+            }
+        }
+        rational upper(0);
+        for (soft const& s : m_soft) {
+            if (!mdl->is_true(s.s)) {
+                upper += s.weight;
+            }
+        }
+        IF_VERBOSE(3, verbose_stream() << "(opt.maxres sls upper: " << upper << ")\n";);
+        if (upper < m_upper && update_upper(mdl, upper)) {
+            ++m_stats.m_num_sls_improvements;
+        }
+    }
+
+    /**
+       \brief use the cost of the initial model as upper bound.
+       With warm starting, the initial model satisfies the soft constraints 
+       of the previous solution that are still present.
+     */
+    void seed_upper() {
+        rational upper(0);
+        for (soft const& s : m_soft) {
+            if (!m_model->is_true(s.s)) {
+                upper += s.weight;
+            }
+        }
+        if (upper >= m_upper) {
+            return;
+        }
+        IF_VERBOSE(3, verbose_stream() << "(opt.maxres warm start upper: " << upper << ")\n";);
+        for (soft& s : m_soft) {
+            s.set_value(m_model->is_true(s.s));
+        }
+        m_upper = upper;
     }
 
     void add_upper_bound_block() {
@@ -814,12 +974,19 @@ public:
         m_max_correction_set_size = p.maxres_max_correction_set_size();
         m_pivot_on_cs =             p.maxres_pivot_on_correction_set();
         m_wmax =                    p.maxres_wmax();
+        m_use_totalizer =           p.maxres_totalizer();
+        m_enable_sls =              p.enable_sls();
+        m_warm_start =              p.warm_start();
         m_dump_benchmarks =         p.dump_benchmarks();
     }
 
     lbool init_local() {
         m_lower.reset();
         m_trail.reset();
+        m_sls_hard.reset();
+        if (m_enable_sls) {
+            s().get_assertions(m_sls_hard);
+        }
         lbool is_sat = l_true;
         obj_map<expr, rational> new_soft;
         is_sat = find_mutexes(new_soft);
@@ -829,6 +996,11 @@ public:
         for (auto const& kv : new_soft) {
             add_soft(kv.m_key, kv.m_value);
         }
+        m_totalizers.reset();
+        m_asm2bound.reset();
+        if (m_warm_start && m_model) {
+            seed_upper();
+        }
         m_max_upper = m_upper;
         m_found_feasible_optimum = false;
         m_last_index = 0;
@@ -905,3 +1077,232 @@ opt::maxsmt_solver_base* opt::mk_primal_dual_maxres(
     return alloc(maxres, c, id, ws, soft, maxres::s_primal_dual);
 }
 
+
+#ifdef SINGLE_THREAD
+
+opt::maxsmt_solver_base* opt::mk_maxres_portfolio(
+    maxsat_context& c, unsigned id, weights_t& ws, expr_ref_vector const& soft, unsigned num_threads) {
+    return mk_maxres(c, id, ws, soft);
+}
+
+#else
+
+/**
+   Portfolio of maxres solvers.
+
+   Each worker runs maxres with a different configuration on a copy of
+   the hard and soft constraints in its own ast_manager. Workers report
+   improved models through model_updated; the best model is translated
+   to the main manager and passed on to the optimization context, so all
+   workers contribute to the anytime upper bound. The first worker that
+   finishes the search determines the optimum and cancels the others.
+*/
+class maxres_portfolio : public maxsmt_solver_base {
+
+    struct worker;
+
+    class worker_context : public maxsat_context {
+        maxres_portfolio&            m_owner;
+        worker&                      m_worker;
+        params_ref&                  m_params;
+        ref<generic_model_converter> m_fm;
+        symbol                       m_engine;
+    public:
+        worker_context(maxres_portfolio& o, worker& w):
+            m_owner(o), m_worker(w), m_params(w.m_params),
+            m_fm(alloc(generic_model_converter, *w.m_manager, "maxres-portfolio")),
+            m_engine("maxres") {}
+        generic_model_converter& fm() override { return *m_fm.get(); }
+        bool sat_enabled() const override { return m_owner.m_c.sat_enabled(); }
+        solver& get_solver() override { return *m_worker.m_solver.get(); }
+        ast_manager& get_manager() const override { return *m_worker.m_manager; }
+        params_ref& params() override { return m_params; }
+        void enable_sls(bool force) override { }
+        symbol const& maxsat_engine() const override { return m_engine; }
+        void get_base_model(model_ref& _m) override { _m = m_worker.m_model; }
+        smt::context& smt_context() override {
+            throw default_exception("maxres portfolio does not support wmax");
+        }
+        unsigned num_objectives() override { return 1; }
+        bool verify_model(unsigned id, model* mdl, rational const& v) override { return true; }
+        void set_model(model_ref& _m) override { m_worker.m_model = _m; }
+        void model_updated(model* mdl) override { m_owner.update_model(m_worker, mdl); }
+    };
+
+    struct worker {
+        scoped_ptr<ast_manager>         m_manager;
+        params_ref                      m_params;
+        ref<solver>                     m_solver;
+        model_ref                       m_model;
+        expr_ref_vector                 m_softs;
+        scoped_ptr<worker_context>      m_context;
+        scoped_ptr<maxsmt_solver_base>  m_maxres;
+
+        worker(maxres_portfolio& o, unsigned id, expr_ref_vector const& fmls):
+            m_manager(alloc(ast_manager, o.m, true)),
+            m_softs(*m_manager) {
+            ast_manager& m = *m_manager;
+            ast_translation tr(o.m, m);
+            m_params.copy(o.m_params);
+            o.configure(id, m_params);
+            if (o.m_c.sat_enabled())
+                m_solver = mk_inc_sat_solver(m, m_params);
+            else
+                m_solver = mk_smt_solver(m, m_params, symbol::null);
+            for (expr* f : fmls)
+                m_solver->assert_expr(tr(f));
+            m_model = o.m_model->translate(tr);
+            vector<rational> ws;
+            for (soft const& s : o.m_soft) {
+                m_softs.push_back(tr(s.s.get()));
+                ws.push_back(s.weight);
+            }
+            m_context = alloc(worker_context, o, *this);
+            m_maxres = mk_maxres(*m_context, 0, ws, m_softs);
+            m_maxres->updt_params(m_params);
+        }
+    };
+
+    unsigned                   m_index;
+    unsigned                   m_num_threads;
+    std::mutex                 m_mux;
+    statistics                 m_stats;
+
+    /**
+       \brief configuration of worker id. Worker 0 uses the configuration
+       of the sequential solver.
+    */
+    void configure(unsigned id, params_ref& p) {
+        p.set_uint("random_seed", p.get_uint("random_seed", 0) + id);
+        p.set_bool("maxres.wmax", false);
+        switch (id % 4) {
+        case 1:
+            p.set_bool("maxres.hill_climb", !p.get_bool("maxres.hill_climb", true));
+            break;
+        case 2:
+            p.set_bool("maxres.maximize_assignment", true);
+            break;
+        case 3:
+            p.set_uint("maxres.max_num_cores", 1);
+            p.set_bool("maxres.pivot_on_correction_set", false);
+            break;
+        default:
+            break;
+        }
+    }
+
+    /**
+       \brief record the model mdl of worker w if it improves the upper bound.
+    */
+    void update_model(worker& w, model* mdl) {
+        mdl->set_model_completion(true);
+        rational upper(0);
+        for (unsigned i = 0; i < m_soft.size(); ++i) {
+            if (!mdl->is_true(w.m_softs.get(i)))
+                upper += m_soft[i].weight;
+        }
+        std::lock_guard<std::mutex> lock(m_mux);
+        if (upper >= m_upper)
+            return;
+        ast_translation tr(*w.m_manager, m);
+        model_ref md = mdl->translate(tr);
+        if (!m_c.verify_model(m_index, md.get(), upper))
+            return;
+        m_upper = upper;
+        m_model = md;
+        for (soft& s : m_soft)
+            s.set_value(m_model->is_true(s.s));
+        m_c.model_updated(m_model.get());
+        trace_bounds("maxres-portfolio");
+    }
+
+public:
+    maxres_portfolio(maxsat_context& c, unsigned index, weights_t& ws, expr_ref_vector const& soft, unsigned num_threads):
+        maxsmt_solver_base(c, ws, soft),
+        m_index(index),
+        m_num_threads(num_threads) {
+    }
+
+    ~maxres_portfolio() override {}
+
+    lbool operator()() override {
+        init();
+        if (m.has_trace_stream())
+            throw default_exception("trace streams have to be off in parallel mode");
+        expr_ref_vector fmls(m);
+        s().get_assertions(fmls);
+        scoped_ptr_vector<worker> workers;
+        scoped_limits sl(m.limit());
+        for (unsigned i = 0; i < m_num_threads; ++i) {
+            workers.push_back(alloc(worker, *this, i, fmls));
+            sl.push_child(&(workers.back()->m_manager->limit()));
+        }
+        lbool result = l_undef;
+        unsigned finished_id = UINT_MAX;
+        std::string ex_msg;
+        thread_pool::run(m_num_threads, [&](unsigned i) {
+            worker& w = *workers[i];
+            lbool r = l_undef;
+            try {
+                r = (*w.m_maxres)();
+            }
+            catch (z3_exception& ex) {
+                std::lock_guard<std::mutex> lock(m_mux);
+                if (ex_msg.empty())
+                    ex_msg = ex.msg();
+                return;
+            }
+            IF_VERBOSE(1, verbose_stream() << "(opt.maxres-portfolio :worker " << i << " :result " << r << ")\n";);
+            if (r == l_undef)
+                return;
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                if (finished_id != UINT_MAX)
+                    return;
+                finished_id = i;
+                result = r;
+            }
+            for (worker* o : workers)
+                if (o != &w)
+                    o->m_manager->limit().cancel();
+        });
+
+        m_stats.reset();
+        for (worker* w : workers)
+            w->m_maxres->collect_statistics(m_stats);
+
+        if (finished_id == UINT_MAX) {
+            for (worker* w : workers)
+                if (w->m_maxres->get_lower() > m_lower)
+                    m_lower = w->m_maxres->get_lower();
+            if (m_lower > m_upper)
+                m_lower = m_upper;
+            if (!ex_msg.empty() && m.inc())
+                throw default_exception(std::move(ex_msg));
+            return l_undef;
+        }
+        worker& w = *workers[finished_id];
+        if (result == l_true) {
+            if (w.m_maxres->get_upper() < m_upper) {
+                model_ref mdl;
+                svector<symbol> labels;
+                w.m_maxres->get_model(mdl, labels);
+                if (mdl)
+                    update_model(w, mdl.get());
+            }
+            m_lower = std::min(w.m_maxres->get_lower(), m_upper);
+        }
+        return result;
+    }
+
+    void collect_statistics(statistics& st) const override {
+        st.copy(m_stats);
+    }
+};
+
+opt::maxsmt_solver_base* opt::mk_maxres_portfolio(
+    maxsat_context& c, unsigned id, weights_t& ws, expr_ref_vector const& soft, unsigned num_threads) {
+    return alloc(maxres_portfolio, c, id, ws, soft, num_threads);
+}
+
+#endif
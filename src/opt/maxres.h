@@ -26,6 +26,11 @@ namespace opt {
 
     maxsmt_solver_base* mk_primal_dual_maxres(maxsat_context& c, unsigned id, weights_t & ws, expr_ref_vector const& soft);
 
+    /**
+       \brief portfolio of num_threads maxres solvers with different configurations.
+    */
+    maxsmt_solver_base* mk_maxres_portfolio(maxsat_context& c, unsigned id, weights_t & ws, expr_ref_vector const& soft, unsigned num_threads);
+
 };
 
 #endif
@@ -239,7 +239,10 @@ namespace opt {
             m_msolver = mk_maxlex(m_c, m_index, m_weights, m_soft_constraints);
         }
         else if (m_soft_constraints.empty() || maxsat_engine == symbol("maxres") || maxsat_engine == symbol::null) {            
-            m_msolver = mk_maxres(m_c, m_index, m_weights, m_soft_constraints);
+            if (optp.maxres_threads() > 1 && m_c.num_objectives() == 1 && !m_soft_constraints.empty())
+                m_msolver = mk_maxres_portfolio(m_c, m_index, m_weights, m_soft_constraints, optp.maxres_threads());
+            else
+                m_msolver = mk_maxres(m_c, m_index, m_weights, m_soft_constraints);
         }
         else if (maxsat_engine == symbol("pd-maxres")) {            
             m_msolver = mk_primal_dual_maxres(m_c, m_index, m_weights, m_soft_constraints);
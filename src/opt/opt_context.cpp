@@ -135,7 +135,10 @@ namespace opt {
         m_model_fixed(),
         m_objective_refs(m),
         m_core(m),
+        m_warm_softs(m),
         m_enable_sat(false),
+        m_enable_sls(false),
+        m_warm_start(false),
         m_is_clausal(false),
         m_pp_neat(false),
         m_unknown("unknown")
@@ -316,6 +319,9 @@ namespace opt {
             }
             return is_sat;
         }
+        if (m_warm_start) {
+            warm_start(asms);
+        }
         s.assert_expr(asms);
         IF_VERBOSE(1, verbose_stream() << "(optimize:sat)\n");
         TRACE("opt", model_smt2_pp(tout, m, *m_model, 0););
@@ -350,9 +356,74 @@ namespace opt {
         }
         }
         if (is_sat == l_true) validate_model();
+        if (is_sat == l_true && m_warm_start) save_warm_start();
         return adjust_unknown(is_sat);
     }
 
+    /**
+       \brief find an initial model that satisfies the soft constraints 
+       that were satisfied by the previous solution and are still present.
+       Soft constraints are identified by their (hash-consed) internal terms, so
+       unchanged soft constraints are recognized across calls. Soft constraints 
+       in unsatisfiable cores are dropped, and the model of the first call is 
+       retained if no warm start model is found. The MaxSAT solvers use the
+       cost of the initial model as upper bound.
+    */
+    void context::warm_start(expr_ref_vector const& asms) {
+        obj_hashtable<expr> softs;
+        for (objective const& obj : m_objectives) {
+            if (obj.m_type == O_MAXSMT) {
+                for (expr* t : obj.m_terms) softs.insert(t);
+            }
+        }
+        solver& s = get_solver();
+        expr_ref_vector proxies(m);
+        for (expr* t : m_warm_softs) {
+            if (!softs.contains(t)) continue;
+            app_ref p(m.mk_fresh_const("warm", m.mk_bool_sort()), m);
+            m_fm->hide(p);
+            s.assert_expr(m.mk_implies(p, t));
+            proxies.push_back(p);
+        }
+        m_warm_softs.reset();
+        for (unsigned round = 0; round < 10 && !proxies.empty() && m.inc(); ++round) {
+            expr_ref_vector _asms(asms);
+            _asms.append(proxies);
+            lbool is_sat = s.check_sat(_asms.size(), _asms.c_ptr());
+            if (is_sat == l_true) {
+                IF_VERBOSE(1, verbose_stream() << "(optimize:warm-start " << proxies.size() << ")\n");
+                s.get_model(m_model);
+                s.get_labels(m_labels);
+                model_updated(m_model.get());
+                return;
+            }
+            if (is_sat != l_false) {
+                return;
+            }
+            expr_ref_vector core(m);
+            s.get_unsat_core(core);
+            unsigned j = 0;
+            for (expr* p : proxies) {
+                if (!core.contains(p)) proxies[j++] = p;
+            }
+            if (j == proxies.size()) {
+                return;
+            }
+            proxies.shrink(j);
+        }
+    }
+
+    void context::save_warm_start() {
+        m_warm_softs.reset();
+        if (!m_model) return;
+        for (objective const& obj : m_objectives) {
+            if (obj.m_type != O_MAXSMT) continue;
+            for (expr* t : obj.m_terms) {
+                if (m_model->is_true(t)) m_warm_softs.push_back(t);
+            }
+        }
+    }
+
     lbool context::adjust_unknown(lbool r) {
         if (r == l_true && m_opt_solver.get() && m_opt_solver->was_unknown()) {
             r = l_undef;
@@ -604,7 +675,11 @@ namespace opt {
 
     lbool context::execute_pareto() {        
         if (!m_pareto) {
-            set_pareto(alloc(gia_pareto, m, *this, m_solver.get(), m_params));
+            unsigned num_threads = opt_params(m_params).pareto_threads();
+            if (num_threads > 1)
+                set_pareto(alloc(par_pareto, m, *this, m_solver.get(), m_params, num_threads));
+            else
+                set_pareto(alloc(gia_pareto, m, *this, m_solver.get(), m_params));
         }
         lbool is_sat = (*(m_pareto.get()))();
         if (is_sat != l_true) {
@@ -1516,6 +1591,7 @@ namespace opt {
         opt_params _p(p);
         m_enable_sat = _p.enable_sat();
         m_enable_sls = _p.enable_sls();
+        m_warm_start = _p.warm_start();
         m_maxsat_engine = _p.maxsat_engine();
         m_pp_neat = _p.pp_neat();
     }
@@ -169,9 +169,11 @@ namespace opt {
         obj_map<func_decl, expr*>    m_objective_orig;
         func_decl_ref_vector         m_objective_refs;
         expr_ref_vector              m_core;
+        expr_ref_vector              m_warm_softs;  // soft constraints satisfied by the previous solution
         tactic_ref                   m_simplify;
         bool                         m_enable_sat;
         bool                         m_enable_sls;
+        bool                         m_warm_start;
         bool                         m_is_clausal;
         bool                         m_pp_neat;
         symbol                       m_maxsat_engine;
@@ -300,6 +302,8 @@ namespace opt {
         void set_simplify(tactic *simplify);
         void set_pareto(pareto_base* p);        
         void clear_state();
+        void warm_start(expr_ref_vector const& asms);
+        void save_warm_start();
 
         bool is_numeral(expr* e, rational& n) const;
 
@@ -21,7 +21,13 @@ Notes:
 #include "opt/opt_pareto.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
+#include "ast/ast_translation.h"
 #include "model/model_smt2_pp.h"
+#include "smt/smt_solver.h"
+#include "util/thread_pool.h"
+#ifndef SINGLE_THREAD
+#include <mutex>
+#endif
 
 namespace opt {
 
@@ -109,5 +115,181 @@ namespace opt {
         return is_sat;
     }
 
+    // ---------------------------------
+    // Parallel GIA
+
+    struct par_pareto::worker {
+        scoped_ptr<ast_manager> m_manager;
+        ref<solver>             m_solver;
+        unsigned                m_shared_lim;   // number of shared constraints asserted to m_solver
+        bool                    m_done;
+        worker(ast_manager& m, expr_ref_vector const& fmls, params_ref const& p):
+            m_manager(alloc(ast_manager, m, true)),
+            m_shared_lim(0),
+            m_done(false) {
+            ast_translation tr(m, *m_manager);
+            m_solver = mk_smt_solver(*m_manager, p, symbol::null);
+            for (expr* f : fmls) 
+                m_solver->assert_expr(tr(f));
+        }
+    };
+
+    par_pareto::par_pareto(ast_manager & m, pareto_callback& cb, solver* s, params_ref & p, unsigned num_threads):
+        pareto_base(m, cb, s, p),
+        m_num_threads(num_threads),
+        m_shared(m),
+        m_head(0),
+        m_done(false) {
+    }
+
+    par_pareto::~par_pareto() {}
+
+    lbool par_pareto::operator()() {
+        if (m_head == m_queue.size() && !m_done) {
+            find_points();
+        }
+        if (m_head < m_queue.size()) {
+            m_model = m_queue[m_head++];
+            m_labels.reset();
+            return l_true;
+        }
+        return m_done && m.inc() ? l_false : l_undef;
+    }
+
+    void par_pareto::init_workers() {
+        if (!m_workers.empty())
+            return;
+        if (m.has_trace_stream())
+            throw default_exception("trace streams have to be off in parallel mode");
+        expr_ref_vector fmls(m);
+        m_solver->get_assertions(fmls);
+        for (unsigned i = 0; i < m_num_threads; ++i) {
+            params_ref p(m_params);
+            p.set_uint("random_seed", p.get_uint("random_seed", 0) + i);
+            m_workers.push_back(alloc(worker, m, fmls, p));
+        }
+    }
+
+#ifdef SINGLE_THREAD
+
+    void par_pareto::find_points() {
+        throw default_exception("parallel pareto is not available in single threaded mode");
+    }
+
+#else
+
+    void par_pareto::find_points() {
+        init_workers();
+        unsigned num_objectives = cb.num_objectives();
+        std::mutex mux;
+        std::string ex_msg;
+        scoped_limits sl(m.limit());
+        for (worker* w : m_workers) 
+            sl.push_child(&(w->m_manager->limit()));
+
+        // the following functions access m and cb, and are called with mux held.
+        auto sync = [&](worker& w) {
+            ast_translation tr(m, *w.m_manager);
+            for (unsigned j = w.m_shared_lim; j < m_shared.size(); ++j) 
+                w.m_solver->assert_expr(tr(m_shared.get(j)));
+            w.m_shared_lim = m_shared.size();
+        };
+        auto to_main = [&](worker& w, model_ref& mdl) {
+            ast_translation tr(*w.m_manager, m);
+            model_ref r = mdl->translate(tr);
+            r->set_model_completion(true);
+            return r;
+        };
+        auto mk_dominates = [&](worker& w, model_ref& mdl, int obj) {
+            model_ref md = to_main(w, mdl);
+            expr_ref_vector fmls(m), gt(m);
+            for (unsigned j = 0; j < num_objectives; ++j) {
+                fmls.push_back(cb.mk_ge(j, md));
+                gt.push_back(cb.mk_gt(j, md));
+            }
+            fmls.push_back(obj < 0 ? mk_or(gt) : expr_ref(gt.get(obj), m));
+            ast_translation tr(m, *w.m_manager);
+            return expr_ref(tr(mk_and(fmls).get()), *w.m_manager);
+        };
+        auto add_point = [&](worker& w, model_ref& mdl) {
+            model_ref md = to_main(w, mdl);
+            expr_ref_vector le(m);
+            for (unsigned j = 0; j < num_objectives; ++j) 
+                le.push_back(cb.mk_le(j, md));
+            expr_ref fml(m.mk_not(mk_and(le)), m);
+            if (!m_points.contains(fml)) {
+                IF_VERBOSE(1, verbose_stream() << "(opt.pareto :point " << m_queue.size() << ")\n";);
+                m_points.insert(fml);
+                m_shared.push_back(fml);
+                m_queue.push_back(md);
+            }
+        };
+
+        auto run = [&](unsigned i) {
+            worker& w = *m_workers[i];
+            solver& s = *w.m_solver;
+            try {
+                {
+                    std::lock_guard<std::mutex> lock(mux);
+                    sync(w);
+                }
+                lbool is_sat = s.check_sat(0, nullptr);
+                if (is_sat == l_false) 
+                    w.m_done = true;
+                if (is_sat != l_true) 
+                    return;
+                model_ref mdl;
+                s.get_model(mdl);
+                int obj = (i > 0 && num_objectives > 1) ? static_cast<int>(i % num_objectives) : -1;
+                {
+                    solver::scoped_push _s(s);
+                    while (is_sat == l_true) {
+                        if (!w.m_manager->inc()) 
+                            return;
+                        expr_ref fml(*w.m_manager);
+                        {
+                            std::lock_guard<std::mutex> lock(mux);
+                            fml = mk_dominates(w, mdl, obj);
+                        }
+                        if (obj >= 0) 
+                            s.push();
+                        s.assert_expr(fml);
+                        is_sat = s.check_sat(0, nullptr);
+                        if (is_sat == l_true) 
+                            s.get_model(mdl);
+                        else if (is_sat == l_false && obj >= 0) {
+                            // objective obj cannot be improved further, continue with plain GIA
+                            s.pop(1);
+                            obj = -1;
+                            is_sat = l_true;
+                        }
+                    }
+                }
+                if (is_sat == l_undef) 
+                    return;
+                std::lock_guard<std::mutex> lock(mux);
+                add_point(w, mdl);
+                sync(w);
+            }
+            catch (z3_exception& ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (ex_msg.empty()) 
+                    ex_msg = ex.msg();
+            }
+        };
+
+        unsigned sz = m_queue.size();
+        while (sz == m_queue.size() && !m_done && m.inc()) {
+            ex_msg.clear();
+            thread_pool::run(m_workers.size(), run);
+            for (worker* w : m_workers) 
+                m_done |= w->m_done;
+            if (sz == m_queue.size() && !ex_msg.empty())
+                throw default_exception(std::move(ex_msg));
+        }
+    }
+
+#endif
+
 }
 
@@ -22,6 +22,8 @@ Notes:
 
 #include "solver/solver.h"
 #include "model/model.h"
+#include "util/obj_hashtable.h"
+#include "util/scoped_ptr_vector.h"
 
 namespace opt {
    
@@ -105,6 +107,40 @@ namespace opt {
 
         lbool operator()() override;
     };
+
+    /**
+       \brief Pareto points computed in parallel.
+
+       Each worker runs GIA on a copy of the solver in its own ast_manager.
+       Worker i > 0 first improves objective i modulo the number of objectives
+       as long as possible, so that the workers start from different regions
+       of the objective space. The constraints that exclude the points dominated
+       by a Pareto point are shared with all workers, and points with the same
+       objective values are reported once.
+       Points found in the same round are queued and returned by subsequent calls.
+    */
+    class par_pareto : public pareto_base {
+        struct worker;
+        scoped_ptr_vector<worker> m_workers;
+        unsigned                  m_num_threads;
+        expr_ref_vector           m_shared;   // not dominated by the points found so far
+        obj_hashtable<expr>       m_points;
+        vector<model_ref>         m_queue;
+        unsigned                  m_head;
+        bool                      m_done;
+
+        void init_workers();
+        void find_points();
+    public:
+        par_pareto(ast_manager & m, 
+                   pareto_callback& cb, 
+                   solver* s, 
+                   params_ref & p,
+                   unsigned num_threads);
+        ~par_pareto() override;
+
+        lbool operator()() override;
+    };
 }
 
 #endif
@@ -0,0 +1,97 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    totalizer.cpp
+
+Abstract:
+   
+    Incremental totalizer encoding of cardinality constraints.
+
+Notes:
+
+--*/
+
+#include "ast/ast_util.h"
+#include "opt/totalizer.h"
+
+namespace opt {
+
+    totalizer::totalizer(ast_manager& m, generic_model_converter& fm, expr_ref_vector const& literals):
+        m(m),
+        m_fm(fm),
+        m_literals(literals),
+        m_root(nullptr),
+        m_clauses(m),
+        m_num_clauses(0) {
+        SASSERT(!literals.empty());
+        m_root = mk_tree(0, literals.size());
+    }
+
+    totalizer::~totalizer() {
+        for (node* n : m_nodes)
+            dealloc(n);
+    }
+
+    totalizer::node* totalizer::mk_tree(unsigned lo, unsigned hi) {
+        SASSERT(lo < hi);
+        node* n;
+        if (lo + 1 == hi) {
+            n = alloc(node, m, nullptr, nullptr);
+            n->m_outputs.push_back(m_literals.get(lo));
+        }
+        else {
+            unsigned mid = (lo + hi) / 2;
+            node* l = mk_tree(lo, mid);
+            node* r = mk_tree(mid, hi);
+            n = alloc(node, m, l, r);
+        }
+        m_nodes.push_back(n);
+        return n;
+    }
+
+    /**
+       \brief create the outputs o_1, ..., o_k of n.
+       The clause (l_i & r_j) => o_{i+j} is added for every pair of outputs of 
+       the children where i + j exceeds the previous bound of n. 
+    */
+    void totalizer::extend(node* n, unsigned k) {
+        k = std::min(k, n->m_size);
+        unsigned old_k = n->m_outputs.size();
+        if (k <= old_k)
+            return;
+        node* l = n->m_left;
+        node* r = n->m_right;
+        SASSERT(l && r);
+        extend(l, k);
+        extend(r, k);
+        for (unsigned j = old_k; j < k; ++j) {
+            app* o = m.mk_fresh_const("t", m.mk_bool_sort());
+            m_fm.hide(o);
+            n->m_outputs.push_back(o);
+        }
+        unsigned kl = l->m_outputs.size();
+        unsigned kr = r->m_outputs.size();
+        for (unsigned i = 0; i <= kl; ++i) {
+            for (unsigned j = 0; j <= kr; ++j) {
+                unsigned t = i + j;
+                if (t <= old_k || t > k)
+                    continue;
+                expr_ref_vector cls(m);
+                if (i > 0) cls.push_back(mk_not(m, l->m_outputs.get(i - 1)));
+                if (j > 0) cls.push_back(mk_not(m, r->m_outputs.get(j - 1)));
+                cls.push_back(n->m_outputs.get(t - 1));
+                m_clauses.push_back(mk_or(cls));
+                ++m_num_clauses;
+            }
+        }
+    }
+
+    expr* totalizer::at_least(unsigned k) {
+        SASSERT(0 < k && k <= size());
+        extend(m_root, k);
+        return m_root->m_outputs.get(k - 1);
+    }
+
+};
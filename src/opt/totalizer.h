@@ -0,0 +1,76 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    totalizer.h
+
+Abstract:
+   
+    Incremental totalizer encoding of cardinality constraints.
+
+    The totalizer is a binary tree over the input literals. Node n
+    has outputs o_1, ..., o_k such that o_j is implied by "at least
+    j inputs below n are true". Outputs are only created up to the
+    bound that has been requested so far, and extending the bound
+    adds the clauses for the new outputs without touching the
+    existing ones. This is the encoding used by the OLL algorithm,
+    where the bound of a totalizer is increased each time its
+    assumption appears in a core.
+
+Notes:
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "tactic/generic_model_converter.h"
+
+namespace opt {
+
+    class totalizer {
+        struct node {
+            node*           m_left;
+            node*           m_right;
+            expr_ref_vector m_outputs;   // m_outputs[j] is o_{j+1}
+            unsigned        m_size;      // number of inputs below the node
+            node(ast_manager& m, node* l, node* r):
+                m_left(l), m_right(r), m_outputs(m), 
+                m_size(l ? l->m_size + r->m_size : 1) {}
+        };
+
+        ast_manager&             m;
+        generic_model_converter& m_fm;
+        expr_ref_vector          m_literals;
+        ptr_vector<node>         m_nodes;
+        node*                    m_root;
+        expr_ref_vector          m_clauses;
+        unsigned                 m_num_clauses;
+
+        node* mk_tree(unsigned lo, unsigned hi);
+        void extend(node* n, unsigned k);
+
+    public:
+        totalizer(ast_manager& m, generic_model_converter& fm, expr_ref_vector const& literals);
+        ~totalizer();
+
+        unsigned size() const { return m_literals.size(); }
+        expr_ref_vector const& literals() const { return m_literals; }
+
+        /**
+           \brief return o_k of the root, which holds if at least k literals are true.
+           The clauses that are required for o_k and were not created before are 
+           added to clauses().
+        */
+        expr* at_least(unsigned k);
+
+        /**
+           \brief clauses created since the last call to reset_clauses().
+        */
+        expr_ref_vector const& clauses() const { return m_clauses; }
+        void reset_clauses() { m_clauses.reset(); }
+
+        unsigned num_clauses() const { return m_num_clauses; }
+    };
+
+};
@@ -36,7 +36,7 @@ namespace smt2 {
             m_bpos++;
         }
         else {
-            m_stream.read(m_buffer, SCANNER_BUFFER_SIZE);
+            m_stream.read(m_buffer.begin(), SCANNER_BUFFER_SIZE);
             m_bend = static_cast<unsigned>(m_stream.gcount());
             m_bpos = 0;
             if (m_bpos == m_bend) {
@@ -50,6 +50,15 @@ namespace smt2 {
         m_spos++;
     }
 
+    void scanner::set_id() {
+        SASSERT(!m_string.empty() && m_string.back() == 0);
+        unsigned h = string_hash(m_string.begin(), m_string.size() - 1, 17);
+        symbol & s = m_symbol_cache[h & (SCANNER_SYMBOL_CACHE_SIZE - 1)];
+        if (s.is_null() || strcmp(s.bare_str(), m_string.begin()) != 0)
+            s = symbol(m_string.begin());
+        m_id = s;
+    }
+
     void scanner::read_comment() {
         SASSERT(curr() == ';');
         next();
@@ -102,7 +111,7 @@ namespace smt2 {
             else if (c == '|' && !escape) {
                 next();
                 m_string.push_back(0);
-                m_id = m_string.begin();
+                set_id();
                 TRACE("scanner", tout << "new quoted symbol: " << m_id << "\n";);
                 return SYMBOL_TOKEN;
             }
@@ -122,14 +131,14 @@ namespace smt2 {
             }
             else {
                 m_string.push_back(0);
-                m_id = m_string.begin();
+                set_id();
                 TRACE("scanner", tout << "new symbol: " << m_id << "\n";);
                 return SYMBOL_TOKEN;
             }
         }
         if (!m_string.empty()) {
             m_string.push_back(0);
-            m_id = m_string.begin();
+            set_id();
             return SYMBOL_TOKEN;
         }
         return EOF_TOKEN;
@@ -283,6 +292,9 @@ namespace smt2 {
         m_stream(stream),
         m_cache_input(false) {
 
+        m_buffer.resize(SCANNER_BUFFER_SIZE);
+        m_symbol_cache.resize(SCANNER_SYMBOL_CACHE_SIZE);
+
         m_smtlib2_compliant = ctx.params().m_smtlib2_compliant;
 
         for (int i = 0; i < 256; ++i) {
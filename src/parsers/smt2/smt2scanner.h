@@ -44,8 +44,8 @@ namespace smt2 {
         unsigned           m_bv_size;
         // end of data
         signed char        m_normalized[256];
-#define SCANNER_BUFFER_SIZE 1024
-        char               m_buffer[SCANNER_BUFFER_SIZE];
+#define SCANNER_BUFFER_SIZE (1 << 16)
+        svector<char>      m_buffer;
         unsigned           m_bpos;
         unsigned           m_bend;
         svector<char>      m_string;
@@ -56,10 +56,17 @@ namespace smt2 {
         svector<char>      m_cache_result;
         
         bool               m_smtlib2_compliant;
+
+        // direct mapped cache in front of the global symbol table.
+        // Identifiers repeat heavily in large benchmarks, and a hit
+        // avoids the locked lookup in the shared table.
+#define SCANNER_SYMBOL_CACHE_SIZE 1024
+        svector<symbol>    m_symbol_cache;
         
         char curr() const { return m_curr; }
         void new_line() { m_line++; m_spos = 0; }
         void next();
+        void set_id();
         
     public:
         
@@ -39,6 +39,7 @@ namespace qe {
         ast_manager&      m;
         arith_util        a;
         bool              m_check_purified;  // check that variables are properly pure 
+        opt::model_based_opt m_mbo;          // reused across projections to keep its row storage
 
         void insert_mul(expr* x, rational const& v, obj_map<expr, rational>& ts) {
             // TRACE("qe", tout << "Adding variable " << mk_pp(x, m) << " " << v << "\n";);
@@ -313,7 +314,8 @@ namespace qe {
             TRACE("qe", tout << model;);
             eval.set_model_completion(true);
 
-            opt::model_based_opt mbo;
+            opt::model_based_opt& mbo = m_mbo;
+            mbo.reset();
             obj_map<expr, unsigned> tids;
             expr_ref_vector pinned(m);
             unsigned j = 0;
@@ -64,6 +64,35 @@ namespace qel {
         return false;
     }
 
+    /**
+       \brief collect the indices of the free variables of e, shifted by offset,
+       in the same way as occurs_var tests them.
+    */
+    static void collect_var_idxs(expr* e, unsigned offset, uint_set& idxs) {
+        if (is_ground(e)) return;
+        ptr_buffer<expr> todo;
+        todo.push_back(e);
+        ast_mark mark;
+        while (!todo.empty()) {
+            expr* e = todo.back();
+            todo.pop_back();
+            if (mark.is_marked(e)) continue;
+            mark.mark(e, true);
+            if (is_ground(e)) continue;
+            if (is_var(e)) {
+                unsigned idx = to_var(e)->get_idx();
+                if (idx >= offset) idxs.insert(idx - offset);
+            }
+            else if (is_app(e)) {
+                todo.append(to_app(e)->get_num_args(), to_app(e)->get_args());
+            }
+            else if (is_quantifier(e)) {
+                quantifier* q = to_quantifier(e);
+                collect_var_idxs(q->get_expr(), offset + q->get_num_decls(), idxs);
+            }
+        }
+    }
+
     class eq_der {
         ast_manager &   m;
         arith_util      a;
@@ -615,36 +644,63 @@ namespace qel {
             }
         }
 
-        bool is_unconstrained(var* x, expr* t, unsigned i, expr_ref_vector const& conjs) {
+        /**
+           x is unconstrained in the disequality x != t if it does not occur in t
+           and the disequality is the only conjunct it occurs in.
+         */
+        bool is_unconstrained(var* x, expr* t, unsigned_vector const& num_occs) {
             sort* s = m.get_sort(x);
             if (!m.is_fully_interp(s) || !s->get_num_elements().is_infinite()) return false;
-            bool occ = occurs_var(x->get_idx(), t);
-            for (unsigned j = 0; !occ && j < conjs.size(); ++j) {
-                occ = (i != j) && occurs_var(x->get_idx(), conjs[j]);
-            }
-            return !occ;
+            SASSERT(num_occs.get(x->get_idx(), 0) > 0);
+            return num_occs[x->get_idx()] == 1 && !occurs_var(x->get_idx(), t);
         }
 
-        bool remove_unconstrained(expr_ref_vector& conjs) {
-            bool reduced = false, change = true;
+        bool is_unconstrained_diseq(expr* c, unsigned_vector const& num_occs) {
             expr *r = nullptr, *l = nullptr, *ne = nullptr;
-            while (change) {
-                change = false;
-                for (unsigned i = 0; i < conjs.size(); ++i) {
-                    if (m.is_not(conjs[i].get(), ne) && m.is_eq(ne, l, r)) {
-                        TRACE("qe_lite", tout << mk_pp(conjs[i].get(), m) << " " << is_variable(l) << " " << is_variable(r) << "\n";);
-                        if (is_variable(l) && ::is_var(l) && is_unconstrained(::to_var(l), r, i, conjs)) {
-                            conjs[i] = m.mk_true();
-                            reduced = true;
-                            change = true;
-                        }
-                        else if (is_variable(r) && ::is_var(r) && is_unconstrained(::to_var(r), l, i, conjs)) {
-                            conjs[i] = m.mk_true();
-                            reduced = true;
-                            change = true;
-                        }
-                    }
+            if (!m.is_not(c, ne) || !m.is_eq(ne, l, r))
+                return false;
+            TRACE("qe_lite", tout << mk_pp(c, m) << " " << is_variable(l) << " " << is_variable(r) << "\n";);
+            return 
+                (is_variable(l) && ::is_var(l) && is_unconstrained(::to_var(l), r, num_occs)) ||
+                (is_variable(r) && ::is_var(r) && is_unconstrained(::to_var(r), l, num_occs));
+        }
+
+        /**
+           Remove disequalities over unconstrained variables.
+           The conjuncts are indexed by the variables they contain, removing a
+           disequality only revisits the conjuncts of variables that become
+           single occurrences.
+         */
+        bool remove_unconstrained(expr_ref_vector& conjs) {
+            bool reduced = false;
+            vector<unsigned_vector> conj2vars, var2conjs;
+            unsigned_vector num_occs, todo;
+            for (unsigned i = 0; i < conjs.size(); ++i) {
+                uint_set idxs;
+                collect_var_idxs(conjs.get(i), 0, idxs);
+                conj2vars.push_back(unsigned_vector());
+                for (unsigned idx : idxs) {
+                    conj2vars.back().push_back(idx);
+                    var2conjs.reserve(idx + 1);
+                    num_occs.reserve(idx + 1, 0);
+                    var2conjs[idx].push_back(i);
+                    num_occs[idx]++;
+                }
+            }
+            for (unsigned i = conjs.size(); i-- > 0; ) 
+                todo.push_back(i);
+            while (!todo.empty()) {
+                unsigned i = todo.back();
+                todo.pop_back();
+                if (!is_unconstrained_diseq(conjs.get(i), num_occs)) 
+                    continue;
+                conjs[i] = m.mk_true();
+                reduced = true;
+                for (unsigned idx : conj2vars[i]) {
+                    if (--num_occs[idx] == 1) 
+                        todo.append(var2conjs[idx]);
                 }
+                conj2vars[i].reset();
             }
             return reduced;
         }
@@ -754,21 +810,39 @@ namespace qel {
         is_variable_proc*        m_is_variable;
         ptr_vector<expr>         m_todo;
         expr_mark                m_visited;
+        obj_map<expr, unsigned>  m_num_occs;  // number of conjuncts a variable occurs in
+        bool                     m_num_occs_valid;
 
         bool is_variable(expr * e) const {
             return (*m_is_variable)(e);
         }
 
-        void mark_all(expr* e) {
-            for_each_expr(*this, m_visited, e);
+        struct occs_proc {
+            ar_der& d;
+            int     m_delta;
+            occs_proc(ar_der& d, int delta): d(d), m_delta(delta) {}
+            void operator()(expr* e) {
+                if (!d.is_variable(e)) return;
+                auto& n = d.m_num_occs.insert_if_not_there(e, 0);
+                n += m_delta;
+            }
+        };
+
+        void update_occs(expr* e, int delta) {
+            occs_proc proc(*this, delta);
+            expr_mark visited;
+            for_each_expr(proc, visited, e);
         }
 
-        void mark_all(expr_ref_vector const& fmls, unsigned j) {
-            for (unsigned i = 0; i < fmls.size(); ++i) {
-                if (i != j) {
-                    mark_all(fmls[i]);
-                }
-            }
+        void init_occs(expr_ref_vector const& fmls) {
+            m_num_occs.reset();
+            for (expr* f : fmls) 
+                update_occs(f, 1);
+            m_num_occs_valid = true;
+        }
+
+        void mark_all(expr* e) {
+            for_each_expr(*this, m_visited, e);
         }
 
         /**
@@ -844,10 +918,6 @@ namespace qel {
                     to_app(a1)->get_num_args() == to_app(a2)->get_num_args()) {
                     expr* e1 = to_app(a1)->get_arg(0);
                     expr* e2 = to_app(a2)->get_arg(0);
-                    m_visited.reset();
-                    mark_all(conjs, i);
-                    mark_all(e1);
-                    mark_all(e2);
                     for (unsigned j = 1; j < to_app(a1)->get_num_args(); ++j) {
                         expr* x = to_app(a1)->get_arg(j);
                         expr* y = to_app(a2)->get_arg(j);
@@ -857,11 +927,27 @@ namespace qel {
                         if (x != y) {
                             return false;
                         }
-                        if (m_visited.is_marked(x)) {
+                    }
+                    // the indices may only occur in the i'th conjunct
+                    if (!m_num_occs_valid) 
+                        init_occs(conjs);
+                    for (unsigned j = 1; j < to_app(a1)->get_num_args(); ++j) {
+                        unsigned n = 0;
+                        if (!m_num_occs.find(to_app(a1)->get_arg(j), n) || n != 1) {
+                            return false;
+                        }
+                    }
+                    m_visited.reset();
+                    mark_all(e1);
+                    mark_all(e2);
+                    for (unsigned j = 1; j < to_app(a1)->get_num_args(); ++j) {
+                        if (m_visited.is_marked(to_app(a1)->get_arg(j))) {
                             return false;
                         }
                     }
+                    update_occs(conjs.get(i), -1);
                     conjs[i] = m.mk_not(m.mk_eq(e1, e2));
+                    update_occs(conjs.get(i), 1);
                     return true;
                 }
             }
@@ -874,14 +960,17 @@ namespace qel {
 
     public:
 
-        ar_der(ast_manager& m): m(m), a(m), m_is_variable(nullptr) {}
+        ar_der(ast_manager& m): m(m), a(m), m_is_variable(nullptr), m_num_occs_valid(false) {}
 
         void operator()(expr_ref_vector& fmls) {
+            m_num_occs_valid = false;
             for (unsigned i = 0; i < fmls.size(); ++i) {
                 checkpoint();
-                solve_select(fmls, i, fmls[i].get());
+                if (solve_select(fmls, i, fmls[i].get())) 
+                    m_num_occs_valid = false;
                 solve_neq_select(fmls, i, fmls[i].get());
             }
+            m_num_occs.reset();
         }
 
         void operator()(expr* e) {}
@@ -170,6 +170,9 @@ namespace qe {
         void set_root(term &r) {m_root = &r;}
         term &get_next() const {return *m_next;}
         void add_parent(term* p) { m_parents.push_back(p); }
+        unsigned get_num_parents() const { return m_parents.size(); }
+        void shrink_parents(unsigned sz) { m_parents.shrink(sz); }
+        void del_last_parent(term* p) { SASSERT(m_parents.back() == p); m_parents.pop_back(); }
 
         unsigned get_class_size() const {return m_class_size;}
 
@@ -180,6 +183,13 @@ namespace qe {
             b.m_class_size = 0;
         }
 
+        // -- inverse of merge_eq_class
+        void unmerge_eq_class(term &b, unsigned b_size) {
+            std::swap(this->m_next, b.m_next);
+            m_class_size -= b_size;
+            b.m_class_size = b_size;
+        }
+
         // -- make this term the root of its equivalence class
         void mk_root() {
             if (is_root()) return;
@@ -313,6 +323,8 @@ namespace qe {
 
         m_terms.push_back(t);
         m_app2term.insert(a->get_id(), t);
+        if (!m_scopes.empty())
+            m_trail.push_back(undo(undo::new_term_k, t));
         return t;
     }
 
@@ -386,10 +398,24 @@ namespace qe {
             std::swap(a, b);
         }
 
+        bool track = !m_scopes.empty();
+        if (track) {
+            undo u(undo::merge_k, a);
+            u.m_b = b;
+            u.m_b_size = b->get_class_size();
+            u.m_num_parents = a->get_num_parents();
+            u.m_erased_lim = m_cg_erased.size();
+            u.m_inserted_lim = m_cg_inserted.size();
+            m_trail.push_back(u);
+        }
+
         // Remove parents of b from the cg table.
         for (term* p : term::parents(b)) {
             if (!p->is_marked()) {
                 p->set_mark(true);
+                term* q = nullptr;
+                if (track && m_cg_table.find(p, q))
+                    m_cg_erased.push_back(q);
                 m_cg_table.erase(p);
             }
         }
@@ -406,6 +432,8 @@ namespace qe {
         for (term* p : term::parents(b)) {
             if (p->is_marked()) {
                 term* p_old = m_cg_table.insert_if_not_there(p);
+                if (track && p_old == p)
+                    m_cg_inserted.push_back(p);
                 p->set_mark(false);
                 a->add_parent(p);
                 // propagate new equalities.
@@ -417,6 +445,79 @@ namespace qe {
         SASSERT(marks_are_clear());
     }
 
+    void term_graph::push() {
+        SASSERT(m_merge.empty());
+        scope s;
+        s.m_trail_lim = m_trail.size();
+        s.m_lits_lim = m_lits.size();
+        m_scopes.push_back(s);
+    }
+
+    void term_graph::pop(unsigned num_scopes) {
+        if (num_scopes == 0)
+            return;
+        SASSERT(num_scopes <= m_scopes.size());
+        scope s = m_scopes[m_scopes.size() - num_scopes];
+        m_scopes.shrink(m_scopes.size() - num_scopes);
+        m_term2app.reset();
+        m_pinned.reset();
+        dealloc(m_projector);
+        m_projector = nullptr;
+        for (unsigned i = m_trail.size(); i-- > s.m_trail_lim; ) {
+            undo const& u = m_trail[i];
+            switch (u.m_kind) {
+            case undo::new_term_k:
+                undo_new_term(*u.m_a);
+                break;
+            case undo::merge_k:
+                undo_merge(u);
+                break;
+            case undo::root_k:
+                u.m_a->mk_root();
+                break;
+            }
+        }
+        m_trail.shrink(s.m_trail_lim);
+        m_lits.shrink(s.m_lits_lim);
+        // solved marks are a function of the remaining literals
+        m_is_var.reset_solved();
+        expr* v = nullptr;
+        for (expr* lit : m_lits)
+            if (is_pure_def(lit, v))
+                m_is_var.mark_solved(v);
+        SASSERT(marks_are_clear());
+    }
+
+    void term_graph::undo_new_term(term& t) {
+        SASSERT(m_terms.back() == &t);
+        for (unsigned i = t.get_num_args(); i-- > 0; ) {
+            term* ch = get_term(::to_app(t.get_expr())->get_arg(i));
+            ch->get_root().del_last_parent(&t);
+        }
+        m_app2term.erase(t.get_id());
+        m_terms.pop_back();
+        dealloc(&t);
+    }
+
+    void term_graph::undo_merge(undo const& u) {
+        term* a = u.m_a;
+        term* b = u.m_b;
+        // remove entries that were inserted under the merged roots
+        for (unsigned i = m_cg_inserted.size(); i-- > u.m_inserted_lim; )
+            m_cg_table.erase(m_cg_inserted[i]);
+        m_cg_inserted.shrink(u.m_inserted_lim);
+        a->shrink_parents(u.m_num_parents);
+        a->unmerge_eq_class(*b, u.m_b_size);
+        b->set_root(*b);
+        for (term *it = &b->get_next(); it != b; it = &it->get_next()) {
+            it->set_root(*b);
+        }
+        // restore entries that were removed before the merge
+        for (unsigned i = m_cg_erased.size(); i-- > u.m_erased_lim; )
+            m_cg_table.insert(m_cg_erased[i]);
+        m_cg_erased.shrink(u.m_erased_lim);
+    }
+
     expr* term_graph::mk_app_core (expr *e) {
         if (is_app(e)) {
             expr_ref_buffer kids(m);
@@ -524,6 +625,8 @@ namespace qe {
 
         // -- if found something better, make it the new root
         if (r != &t) {
+            if (!m_scopes.empty())
+                m_trail.push_back(undo(undo::root_k, &t));
             r->mk_root();
         }
     }
@@ -577,6 +680,10 @@ namespace qe {
         m_terms.reset();
         m_lits.reset();
         m_cg_table.reset();
+        m_trail.reset();
+        m_scopes.reset();
+        m_cg_erased.reset();
+        m_cg_inserted.reset();
     }
 
     class term_graph::projector {
@@ -45,6 +45,24 @@ namespace qe {
             void reset() {m_decls.reset(); m_solved.reset(); m_exclude = true;}
         };
 
+        // undo information for push/pop
+        struct undo {
+            enum kind { new_term_k, merge_k, root_k };
+            kind     m_kind;
+            term*    m_a;
+            term*    m_b;
+            unsigned m_b_size;
+            unsigned m_num_parents;
+            unsigned m_erased_lim;
+            unsigned m_inserted_lim;
+            undo(kind k, term* a):
+                m_kind(k), m_a(a), m_b(nullptr), m_b_size(0), m_num_parents(0), m_erased_lim(0), m_inserted_lim(0) {}
+        };
+        struct scope {
+            unsigned m_trail_lim;
+            unsigned m_lits_lim;
+        };
+
         struct term_hash { unsigned operator()(term const* t) const; };
         struct term_eq { bool operator()(term const* a, term const* b) const; };
         ast_manager &     m;
@@ -57,10 +75,16 @@ namespace qe {
         plugin_manager<qe::solve_plugin> m_plugins;
         ptr_hashtable<term, term_hash, term_eq> m_cg_table;
         vector<std::pair<term*,term*>> m_merge;
+        svector<undo>     m_trail;
+        svector<scope>    m_scopes;
+        ptr_vector<term>  m_cg_erased;   // cg-table entries removed by merges since the first scope
+        ptr_vector<term>  m_cg_inserted; // cg-table entries added by merges since the first scope
 
         term_graph::is_variable_proc m_is_var;
         void merge(term &t1, term &t2);
         void merge_flush();
+        void undo_new_term(term& t);
+        void undo_merge(undo const& u);
 
         term *mk_term(expr *t);
         term *get_term(expr *t);
@@ -102,6 +126,19 @@ namespace qe {
 
         void reset();
 
+        /**
+         * Create a backtracking point. Literals added after push are
+         * retracted by pop, together with the terms and merges they
+         * introduced, so consecutive projections over literal sets that
+         * share a prefix reuse the closure of the prefix.
+         * Projections and to_lits may be used between push and pop;
+         * the roots they pick are restored by pop. Without push the
+         * graph is single-use as before.
+         */
+        void push();
+        void pop(unsigned num_scopes);
+        unsigned get_num_scopes() const { return m_scopes.size(); }
+
         // deprecate?
         void to_lits(expr_ref_vector &lits, bool all_equalities = false);
         expr_ref to_expr();
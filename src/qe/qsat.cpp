@@ -39,6 +39,9 @@ Notes:
 #include "qe/qe_mbp.h"
 #include "qe/qe.h"
 #include "ast/rewriter/label_rewriter.h"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
 
 namespace qe {
 
@@ -1242,6 +1245,7 @@ namespace qe {
             m_was_sat(false),
             m_gt(m)
         {
+            m_params.append(p);
         }
         
         ~qsat() override {
@@ -1249,9 +1253,102 @@ namespace qe {
         }
         
         void updt_params(params_ref const & p) override {
+            m_params.append(p);
         }
         
         void collect_param_descrs(param_descrs & r) override {
+            r.insert("qe_threads", CPK_UINT, "(default: 1) number of threads used to eliminate quantifiers from the disjuncts of a goal independently (qe2 only).");
+        }
+
+        /**
+           \brief eliminate quantifiers from the disjuncts of fml, or of the body of fml when it
+           is an existential quantifier, in parallel.
+           The disjuncts are distributed round-robin over the workers, each of which
+           uses its own manager. The results are disjoined in the order of the disjuncts,
+           so the answer does not depend on the scheduling of the workers.
+        */
+        bool elim_parallel(goal_ref const & in, expr * fml, goal_ref_buffer & result) {
+#ifdef SINGLE_THREAD
+            return false;
+#else
+            unsigned num_threads = m_params.get_uint("qe_threads", 1);
+            if (num_threads <= 1 || in->proofs_enabled() || in->unsat_core_enabled() || m.has_trace_stream())
+                return false;
+            quantifier * q = nullptr;
+            expr * body = fml;
+            if (::is_exists(fml)) {
+                q = to_quantifier(fml);
+                body = q->get_expr();
+            }
+            if (!m.is_or(body) || to_app(body)->get_num_args() < 2)
+                return false;
+            expr_ref_vector disjs(m);
+            for (expr * arg : *to_app(body)) 
+                disjs.push_back(q ? m.update_quantifier(q, arg) : arg);
+            unsigned num_workers = std::min(num_threads, disjs.size());
+
+            scoped_ptr_vector<ast_manager> managers;
+            scoped_ptr_vector<expr_ref_vector> inputs, outputs;
+            scoped_limits scl(m.limit());
+            for (unsigned w = 0; w < num_workers; ++w) {
+                ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
+                managers.push_back(new_m);
+                inputs.push_back(alloc(expr_ref_vector, *new_m));
+                outputs.push_back(alloc(expr_ref_vector, *new_m));
+                scl.push_child(&new_m->limit());
+            }
+            for (unsigned i = 0; i < disjs.size(); ++i) {
+                unsigned w = i % num_workers;
+                ast_translation tr(m, *managers[w]);
+                inputs[w]->push_back(tr(disjs.get(i)));
+            }
+
+            std::mutex mux;
+            std::string ex_msg;
+            bool failed = false;
+            auto worker_thread = [&](unsigned w) {
+                ast_manager & wm = *managers[w];
+                try {
+                    tactic_ref t = alloc(qsat, wm, m_params, qsat_qe);
+                    for (expr * d : *inputs[w]) {
+                        goal_ref g = alloc(goal, wm, false, false, false);
+                        g->assert_expr(d);
+                        goal_ref_buffer r;
+                        (*t)(g, r);
+                        expr_ref_vector fmls(wm);
+                        for (goal * rg : r) 
+                            for (unsigned j = 0; j < rg->size(); ++j) 
+                                fmls.push_back(rg->form(j));
+                        outputs[w]->push_back(mk_and(fmls));
+                    }
+                }
+                catch (z3_exception & ex) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    if (!failed) {
+                        failed = true;
+                        ex_msg = ex.msg();
+                    }
+                    for (unsigned j = 0; j < num_workers; ++j) 
+                        if (j != w) 
+                            managers[j]->limit().cancel();
+                }
+            };
+            thread_pool::run(num_workers, worker_thread);
+            if (failed)
+                throw tactic_exception(std::move(ex_msg));
+
+            expr_ref_vector answers(m);
+            for (unsigned i = 0; i < disjs.size(); ++i) {
+                unsigned w = i % num_workers;
+                ast_translation tr(*managers[w], m, false);
+                answers.push_back(tr(outputs[w]->get(i / num_workers)));
+            }
+            in->reset();
+            in->inc_depth();
+            in->assert_expr(mk_or(answers));
+            result.push_back(in.get());
+            return true;
+#endif
         }
         
         void operator()(/* in */  goal_ref const & in, 
@@ -1280,6 +1377,9 @@ namespace qe {
                 result.push_back(in.get());
                 return;
             }
+
+            if (m_mode == qsat_qe && elim_parallel(in, fml, result))
+                return;
                 
             reset();
             if (m_mode != qsat_sat) {
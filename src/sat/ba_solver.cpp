@@ -23,6 +23,7 @@ Revision History:
 #include "util/mpz.h"
 #include "sat/sat_simplifier_params.hpp"
 #include "sat/sat_xor_finder.h"
+#include "math/simplex/bit_matrix.h"
 
 
 namespace sat {
@@ -129,7 +130,8 @@ namespace sat {
     // card
 
     ba_solver::card::card(unsigned id, literal lit, literal_vector const& lits, unsigned k):
-        pb_base(card_t, id, lit, lits.size(), get_obj_size(lits.size()), k) {        
+        pb_base(card_t, id, lit, lits.size(), get_obj_size(lits.size()), k),
+        m_search(0) {
         for (unsigned i = 0; i < size(); ++i) {
             m_lits[i] = lits[i];
         }
@@ -1393,6 +1395,7 @@ namespace sat {
 #if 1
                 // code review by Elffers:
                 ineq.weaken(i);
+                ++m_stats.m_num_weakenings;
                 --i;
                 --sz;                
 #else
@@ -1421,6 +1424,7 @@ namespace sat {
             if (q != 0 && !is_false(wl.second)) {
                 m_coeffs[v] = wl.first - q;
                 m_bound -= q;
+                ++m_stats.m_num_weakenings;
                 SASSERT(m_bound > 0);
             }
         }        
@@ -1662,11 +1666,13 @@ namespace sat {
         }
         if (!m_overflow && create_asserting_lemma()) {
             active2lemma();
+            ++m_stats.m_num_rs_lemmas;
             return l_true;
         }
         
     bail_out:
         TRACE("ba", tout << "bail " << m_overflow << "\n";);
+        ++m_stats.m_num_rs_fallbacks;
         if (m_overflow) {
             ++m_stats.m_num_overflow;
             m_overflow = false;
@@ -1754,12 +1760,37 @@ namespace sat {
         return true;
     }
 
+    /*
+      \brief saturate the current resolvent: 
+      coefficients larger than the bound are replaced by the bound.
+     */
+    void ba_solver::saturate() {
+        int64_t bound64 = m_bound;
+        bool saturated = false;
+        for (bool_var v : m_active_vars) {
+            int64_t c = get_coeff(v);
+            if (c > bound64) {
+                m_coeffs[v] = bound64;
+                saturated = true;
+            }
+            else if (c < -bound64) {
+                m_coeffs[v] = -bound64;
+                saturated = true;
+            }
+        }
+        if (saturated) {
+            ++m_stats.m_num_saturations;
+        }
+    }
+
     /*
       \brief compute a cut for current resolvent.
      */
 
     void ba_solver::cut() {
 
+        saturate();
+
         // bypass cut if there is a unit coefficient
         for (bool_var v : m_active_vars) {
             if (1 == get_abs_coeff(v)) return;
@@ -1773,16 +1804,6 @@ namespace sat {
             if (coeff == 0) {
                 continue;
             }
-            if (m_bound < coeff) {
-                int64_t bound64 = m_bound;
-                if (get_coeff(v) > 0) {
-                    m_coeffs[v] = bound64;
-                }
-                else {
-                    m_coeffs[v] = -bound64;
-                }
-                coeff = m_bound;
-            }
             SASSERT(0 < coeff && coeff <= m_bound);
             if (g == 0) {
                 g = coeff;
@@ -2842,14 +2863,21 @@ namespace sat {
         VERIFY(index <= bound);
         VERIFY(c[index] == alit);
         
-        // find a literal to swap with:
-        for (unsigned i = bound + 1; i < sz; ++i) {
+        // find a literal to swap with.
+        // The search is circular, starting after the position of the
+        // previous swap, so that false literals at the beginning of the
+        // unwatched literals of large constraints are not visited repeatedly.
+        unsigned start = c.search_start();
+        if (start <= bound || start >= sz) start = bound + 1;
+        for (unsigned n = bound + 1, i = start; n < sz; ++n) {
             literal lit2 = c[i];
             if (value(lit2) != l_false) {
                 c.swap(index, i);
                 watch_literal(lit2, c);
+                c.set_search_start(i + 1);
                 return l_undef;
             }
+            if (++i == sz) i = bound + 1;
         }
 
         // conflict
@@ -3000,6 +3028,7 @@ namespace sat {
             unit_strengthen();
             extract_xor();
             merge_xor();
+            gauss_jordan();
             cleanup_clauses();
             cleanup_constraints();
             update_pure();
@@ -3830,6 +3859,97 @@ namespace sat {
         }
     }
 
+    /**
+       \brief Gauss-Jordan elimination over the xor constraints.
+       Rows of the reduced matrix with one variable are units and rows with
+       two variables are equivalences. They are added as unit and binary clauses
+       so that the equivalences are used by the equivalence elimination of the solver.
+    */
+    void ba_solver::gauss_jordan() {
+        ptr_vector<xr> xors;
+        for (constraint* c : m_constraints) {
+            if (c->is_xr() && !c->was_removed() && c->lit() == null_literal)
+                xors.push_back(&c->to_xr());
+        }
+        if (xors.size() < 2 || s().inconsistent())
+            return;
+        unsigned_vector var2col, col2var;
+        for (xr* x : xors) {
+            for (literal l : *x) {
+                bool_var v = l.var();
+                if (value(v) != l_undef)
+                    continue;
+                var2col.reserve(v + 1, UINT_MAX);
+                if (var2col[v] == UINT_MAX) {
+                    var2col[v] = col2var.size();
+                    col2var.push_back(v);
+                }
+            }
+        }
+        unsigned rhs = col2var.size();
+        if (static_cast<uint64_t>(xors.size()) * (rhs + 1) > (1ull << 26))
+            return;
+        bit_matrix bm;
+        bm.reset(rhs + 1);
+        for (xr* x : xors) {
+            auto row = bm.add_row();
+            // l_1 xor ... xor l_n is true
+            bool odd = true;
+            for (literal l : *x) {
+                if (value(l) != l_undef)
+                    odd ^= value(l) == l_true;
+                else {
+                    odd ^= l.sign();
+                    unsigned col = var2col[l.var()];
+                    row.set(col, !row[col]);
+                }
+            }
+            row.set(rhs, odd);
+        }
+        bm.solve();
+        TRACE("ba", tout << bm << "\n";);
+        unsigned_vector cols;
+        for (auto const& r : bm) {
+            cols.reset();
+            for (unsigned c : r) {
+                if (c == rhs)
+                    break;
+                cols.push_back(c);
+                if (cols.size() > 2)
+                    break;
+            }
+            bool odd = r[rhs];
+            if (cols.empty() && odd) {
+                IF_VERBOSE(10, verbose_stream() << "(ba.gauss conflict)\n");
+                s().set_conflict(justification(0));
+                return;
+            }
+            if (cols.size() == 1) {
+                literal lit(col2var[cols[0]], !odd);
+                if (value(lit) == l_undef) {
+                    ++m_stats.m_num_gauss_units;
+                    s().assign_scoped(lit);
+                }
+                else if (value(lit) == l_false) {
+                    s().set_conflict(justification(0));
+                    return;
+                }
+            }
+            else if (cols.size() == 2) {
+                // v1 <=> v2 xor odd
+                literal l1(col2var[cols[0]], false), l2(col2var[cols[1]], odd);
+                bool found = false;
+                for (watched const& w : get_wlist(l1))
+                    found |= w.is_binary_clause() && w.get_literal() == l2;
+                if (!found) {
+                    ++m_stats.m_num_gauss_eqs;
+                    s().mk_clause(l1, ~l2);
+                    s().mk_clause(~l1, l2);
+                }
+            }
+        }
+    }
+
     void ba_solver::extract_xor() {
         xor_finder xf(s());
         std::function<void (literal_vector const&)> f = [this](literal_vector const& l) { add_xr(l, false); };
@@ -4468,6 +4588,12 @@ namespace sat {
         st.update("ba overflow", m_stats.m_num_overflow);
         st.update("ba big strengthenings", m_stats.m_num_big_strengthenings);
         st.update("ba lemmas", m_stats.m_num_lemmas);
+        st.update("ba saturations", m_stats.m_num_saturations);
+        st.update("ba weakenings", m_stats.m_num_weakenings);
+        st.update("ba rounding lemmas", m_stats.m_num_rs_lemmas);
+        st.update("ba rounding fallbacks", m_stats.m_num_rs_fallbacks);
+        st.update("ba gauss units", m_stats.m_num_gauss_units);
+        st.update("ba gauss equivalences", m_stats.m_num_gauss_eqs);
         st.update("ba subsumes", m_stats.m_num_bin_subsumes + m_stats.m_num_clause_subsumes + m_stats.m_num_pb_subsumes);
     }
 
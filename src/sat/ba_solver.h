@@ -49,6 +49,12 @@ namespace sat {
             unsigned m_num_gc;
             unsigned m_num_overflow;
             unsigned m_num_lemmas;
+            unsigned m_num_saturations;
+            unsigned m_num_weakenings;
+            unsigned m_num_rs_lemmas;
+            unsigned m_num_rs_fallbacks;
+            unsigned m_num_gauss_units;
+            unsigned m_num_gauss_eqs;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -141,6 +147,7 @@ namespace sat {
         };
 
         class card : public pb_base {
+            unsigned       m_search;      // where the next search for an unwatched non-false literal starts
             literal        m_lits[0];
         public:
             static size_t get_obj_size(unsigned num_lits) { return sizeof(card) + num_lits * sizeof(literal); }
@@ -156,6 +163,8 @@ namespace sat {
             literal get_lit(unsigned i) const override { return m_lits[i]; }
             void set_lit(unsigned i, literal l) override { m_lits[i] = l; }
             unsigned get_coeff(unsigned i) const override { return 1; }
+            unsigned search_start() const { return m_search; }
+            void set_search_start(unsigned i) { m_search = i; }
         };
 
         
@@ -394,6 +403,7 @@ namespace sat {
         void simplify(xr& x);
         void extract_xor();
         void merge_xor();
+        void gauss_jordan();
         bool clausify(xr& x);
         void flush_roots(xr& x);
         lbool eval(xr const& x) const;
@@ -480,6 +490,7 @@ namespace sat {
         void process_antecedent(literal l) { process_antecedent(l, 1); }
         void process_card(card& c, unsigned offset);
         void cut();
+        void saturate();
         bool create_asserting_lemma();
 
         // validation utilities
@@ -24,16 +24,41 @@ Revision History:
 namespace {
 struct lex_error {};
 
+/**
+   \brief Input buffer that reads the stream in large blocks instead of
+   one character at a time. DIMACS files for industrial instances
+   are routinely hundreds of megabytes, and the per-character
+   istream::get() dominated parsing time.
+*/
 class stream_buffer {
+    static const unsigned BLOCK_SIZE = 1 << 16;
     std::istream & m_stream;
+    char           m_block[BLOCK_SIZE];
+    char const *   m_pos;
+    char const *   m_end;
     int            m_val;
     unsigned       m_line;
+
+    void fill() {
+        m_stream.read(m_block, BLOCK_SIZE);
+        m_pos = m_block;
+        m_end = m_block + m_stream.gcount();
+    }
+
+    void next() {
+        if (m_pos == m_end) 
+            fill();
+        m_val = m_pos == m_end ? EOF : static_cast<unsigned char>(*m_pos++);
+    }
+
 public:
     
     stream_buffer(std::istream & s):
         m_stream(s),
+        m_pos(m_block),
+        m_end(m_block),
         m_line(0) {
-        m_val = m_stream.get();
+        next();
     }
 
     int  operator *() const { 
@@ -41,7 +66,7 @@ public:
     }
 
     void operator ++() { 
-        m_val = m_stream.get();
+        next();
         if (m_val == '\n') ++m_line;
     }
 
@@ -115,6 +140,37 @@ void read_clause(Buffer & in, std::ostream& err, sat::solver & solver, sat::lite
     }
 }
 
+/**
+   \brief Process a 'p cnf <vars> <clauses>' header.
+   The variables are created up front so that the solver's per-variable
+   tables are sized once instead of growing while clauses are read.
+   Headers that are not of this shape are skipped.
+*/
+template<typename Buffer>
+void read_header(Buffer & in, std::ostream& err, sat::solver & solver) {
+    ++in;
+    skip_whitespace(in);
+    if (*in != 'c') {
+        skip_line(in);
+        return;
+    }
+    ++in;
+    if (*in != 'n') {
+        skip_line(in);
+        return;
+    }
+    ++in;
+    if (*in != 'f') {
+        skip_line(in);
+        return;
+    }
+    ++in;
+    int num_vars = parse_int(in, err);
+    skip_line(in);
+    while (num_vars > 0 && static_cast<unsigned>(num_vars) >= solver.num_vars())
+        solver.mk_var();
+}
+
 template<typename Buffer>
 bool parse_dimacs_core(Buffer & in, std::ostream& err, sat::solver & solver) {
     sat::literal_vector lits;
@@ -124,7 +180,10 @@ bool parse_dimacs_core(Buffer & in, std::ostream& err, sat::solver & solver) {
             if (*in == EOF) {
                 break;
             }
-            else if (*in == 'c' || *in == 'p') {
+            else if (*in == 'p') {
+                read_header(in, err, solver);
+            }
+            else if (*in == 'c') {
                 skip_line(in);
             }
             else {
@@ -142,6 +201,6 @@ bool parse_dimacs_core(Buffer & in, std::ostream& err, sat::solver & solver) {
 }
 
 bool parse_dimacs(std::istream & in, std::ostream& err, sat::solver & solver) {
-    stream_buffer _in(in);
-    return parse_dimacs_core(_in, err, solver);
+    scoped_ptr<stream_buffer> _in = alloc(stream_buffer, in);
+    return parse_dimacs_core(*_in, err, solver);
 }
@@ -22,10 +22,10 @@
 
 namespace sat {
         
-    aig_cuts::aig_cuts() {
-        m_cut_set1.init(m_region, m_config.m_max_cutset_size + 1, UINT_MAX);
-        m_cut_set2.init(m_region, m_config.m_max_cutset_size + 1, UINT_MAX);
-        m_empty_cuts.init(m_region, m_config.m_max_cutset_size + 1, UINT_MAX);
+    aig_cuts::aig_cuts(): m_cut_allocator(m_region) {
+        m_cut_set1.init(m_cut_allocator, m_config.m_max_cutset_size + 1, UINT_MAX);
+        m_cut_set2.init(m_cut_allocator, m_config.m_max_cutset_size + 1, UINT_MAX);
+        m_empty_cuts.init(m_cut_allocator, m_config.m_max_cutset_size + 1, UINT_MAX);
         m_num_cut_calls = 0;
         m_num_cuts = 0;
     }
@@ -451,7 +451,7 @@ namespace sat {
         SASSERT(m_aig[id][0].is_valid());
         auto& cut_set = m_cuts[id];
         reset(cut_set);
-        cut_set.init(m_region, m_config.m_max_cutset_size + 1, id);
+        cut_set.init(m_cut_allocator, m_config.m_max_cutset_size + 1, id);
         push_back(cut_set, cut(id));
     }
 
@@ -102,6 +102,7 @@ namespace sat {
         vector<svector<node>> m_aig;    
         literal_vector        m_literals;
         region                m_region;
+        cut_allocator         m_cut_allocator;
         cut_set               m_cut_set1, m_cut_set2, m_empty_cuts;
         vector<cut_set>       m_cuts;
         unsigned_vector       m_max_cutset_size;
@@ -44,7 +44,6 @@ namespace sat {
         unsigned           m_id;
         unsigned           m_size;
         unsigned           m_capacity;
-        var_approx_set     m_approx;
         unsigned           m_strengthened:1;
         unsigned           m_removed:1;
         unsigned           m_learned:1;
@@ -54,6 +53,7 @@ namespace sat {
         unsigned           m_inact_rounds:8;
         unsigned           m_glue:8;
         unsigned           m_psm:8;  // transient field used during gc
+        var_approx_set     m_approx; // 64-bit signature of the variables, used to filter subsumption candidates
         literal            m_lits[0];
 
         static size_t get_obj_size(unsigned num_lits) { return sizeof(clause) + num_lits * sizeof(literal); }
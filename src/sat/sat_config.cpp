@@ -49,6 +49,8 @@ namespace sat {
         m_slow_glue_avg = p.restart_emaslowglue();
         m_restart_margin = p.restart_margin();
         m_restart_fast = p.restart_fast();
+        m_bandit = p.bandit();
+        m_bandit_epoch = p.bandit_epoch();
         s = p.phase();
         if (s == symbol("always_false")) 
             m_phase = PS_ALWAYS_FALSE;
@@ -100,9 +102,13 @@ namespace sat {
         m_local_search_dbg_flips = p.local_search_dbg_flips();
         m_binspr            = p.binspr();
         m_binspr            = false;     // prevent adventurous users from trying feature that isn't ready
+        m_vivify            = p.vivify();
+        m_vivify_glue       = p.vivify_glue();
+        m_vivify_limit      = p.vivify_limit();
         m_anf_simplify      = p.anf();
         m_anf_delay         = p.anf_delay();
         m_anf_exlin         = p.anf_exlin();
+        m_symmetry          = p.symmetry();
         m_cut_simplify      = p.cut();
         m_cut_delay         = p.cut_delay();
         m_cut_aig           = p.cut_aig();
@@ -112,6 +118,9 @@ namespace sat {
         m_cut_dont_cares    = p.cut_dont_cares();
         m_cut_redundancies  = p.cut_redundancies();
         m_cut_force         = p.cut_force();
+        m_cut_sweep         = p.cut_sweep();
+        m_cut_sweep_calls   = p.cut_sweep_calls();
+        m_cut_sweep_conflicts = p.cut_sweep_conflicts();
         m_lookahead_simplify = p.lookahead_simplify();
         m_lookahead_double = p.lookahead_double();
         m_lookahead_simplify_bca = p.lookahead_simplify_bca();
@@ -171,6 +180,8 @@ namespace sat {
             m_gc_strategy = GC_PSM;
         else if (s == symbol("psm_glue"))
             m_gc_strategy = GC_PSM_GLUE;
+        else if (s == symbol("tiered"))
+            m_gc_strategy = GC_TIERED;
         else 
             throw sat_param_exception("invalid gc strategy");
         m_gc_initial      = p.gc_initial();
@@ -179,6 +190,9 @@ namespace sat {
         m_gc_k            = std::min(255u, p.gc_k());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
+        m_gc_tier1_glue   = p.gc_tier1_glue();
+        m_gc_tier2_glue   = p.gc_tier2_glue();
+        m_gc_max_memory   = p.gc_max_memory();
 
         m_force_cleanup   = p.force_cleanup();
 
@@ -191,7 +205,7 @@ namespace sat {
         m_drat_check_unsat  = p.drat_check_unsat();
         m_drat_check_sat  = p.drat_check_sat();
         m_drat_file       = p.drat_file();
-        m_drat            = (m_drat_check_unsat || m_drat_file != symbol("") || m_drat_check_sat) && p.threads() == 1;
+        m_drat            = (m_drat_check_unsat || m_drat_file.is_non_empty_string() || m_drat_check_sat) && p.threads() == 1;
         m_drat_binary     = p.drat_binary();
         m_drat_activity   = p.drat_activity();
         m_dyn_sub_res     = p.dyn_sub_res();
@@ -44,7 +44,8 @@ namespace sat {
         GC_PSM,
         GC_GLUE,
         GC_GLUE_PSM,
-        GC_PSM_GLUE
+        GC_PSM_GLUE,
+        GC_TIERED
     };
 
     enum branching_heuristic {
@@ -100,6 +101,8 @@ namespace sat {
         double             m_restart_factor; // for geometric case
         double             m_restart_margin; // for ema
         unsigned           m_restart_max;
+        bool               m_bandit;
+        unsigned           m_bandit_epoch;
         unsigned           m_activity_scale;
         double             m_fast_glue_avg;
         double             m_slow_glue_avg;
@@ -118,6 +121,9 @@ namespace sat {
         local_search_mode  m_local_search_mode;
         bool               m_local_search_dbg_flips;
         bool               m_binspr;
+        bool               m_vivify;
+        unsigned           m_vivify_glue;
+        unsigned           m_vivify_limit;
         bool               m_cut_simplify;
         unsigned           m_cut_delay;
         bool               m_cut_aig;
@@ -127,9 +133,13 @@ namespace sat {
         bool               m_cut_dont_cares;
         bool               m_cut_redundancies;
         bool               m_cut_force;
+        bool               m_cut_sweep;
+        unsigned           m_cut_sweep_calls;
+        unsigned           m_cut_sweep_conflicts;
         bool               m_anf_simplify;
         unsigned           m_anf_delay;
         bool               m_anf_exlin;
+        bool               m_symmetry;
         bool               m_lookahead_simplify;
         bool               m_lookahead_simplify_bca;
         cutoff_t           m_lookahead_cube_cutoff;
@@ -160,6 +170,9 @@ namespace sat {
         unsigned           m_gc_k;
         bool               m_gc_burst;
         bool               m_gc_defrag;
+        unsigned           m_gc_tier1_glue;
+        unsigned           m_gc_tier2_glue;
+        unsigned           m_gc_max_memory;
 
         bool               m_force_cleanup;
 
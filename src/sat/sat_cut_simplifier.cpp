@@ -283,6 +283,7 @@ namespace sat {
         cuts2equiv(cuts);
         cuts2implies(cuts);
         simulate_eqs();
+        sweep_eqs();
     }
 
     void cut_simplifier::cuts2equiv(vector<cut_set> const& cuts) {
@@ -506,6 +507,113 @@ namespace sat {
         IF_VERBOSE(2, verbose_stream() << "(sat.cut-simplifier num simulated eqs " << num_eqs << ")\n");
     }
 
+    /**
+     * SAT sweeping: literals that have the same values under random simulation
+     * of the AIG form candidate classes. Candidates are compared with the
+     * representatives of their class using a copy of the solver. 
+     * Models returned by the copy are recorded as additional patterns 
+     * that separate literals without further SAT calls.
+     * The effort is bounded by the number of SAT calls and conflicts per call.
+     * Equivalences proved by the copy are not certified, so sweeping is 
+     * disabled when producing DRAT proofs.
+     */
+    void cut_simplifier::sweep_eqs() {
+        if (!s.m_config.m_cut_sweep || s.m_config.m_drat || s.inconsistent()) 
+            return;
+        auto var2val = m_aig_cuts.simulate(4);
+        params_ref p;
+        p.set_bool("cut", false);
+        p.set_uint("inprocess.max", 0);
+        p.set_bool("drat.check_unsat", false);
+        p.set_sym("drat.file", symbol());
+        p.set_uint("max_conflicts", s.m_config.m_cut_sweep_conflicts);
+        solver sw(p, s.rlimit());
+        sw.copy(s, false);
+
+        unsigned max_calls = s.m_config.m_cut_sweep_calls;
+        unsigned num_calls = 0, num_cex = 0, num_eqs = 0, num_units = 0;
+        svector<uint64_t> cex(s.num_vars(), (uint64_t)0);
+        literal_vector asms;
+        auto cex_val = [&](literal l) { return l.sign() ? ~cex[l.var()] : cex[l.var()]; };
+        auto cex_mask = [&]() { return num_cex == 64 ? ~0ull : (1ull << num_cex) - 1; };
+        // return true if the conjunction of a, b is unsatisfiable.
+        auto refute = [&](literal a, literal b) {
+            asms.reset();
+            asms.push_back(a);
+            if (b != null_literal) asms.push_back(b);
+            ++num_calls;
+            lbool r = sw.check(asms.size(), asms.c_ptr());
+            if (r == l_true && num_cex < 64) {
+                model const& mdl = sw.get_model();
+                for (unsigned v = 0; v < cex.size() && v < mdl.size(); ++v) 
+                    if (mdl[v] == l_true) 
+                        cex[v] |= (1ull << num_cex);
+                ++num_cex;
+            }
+            sw.pop_to_base_level();
+            return r == l_false;
+        };
+
+        union_find_default_ctx ctx;
+        union_find<> uf(ctx);
+        for (unsigned i = 2*s.num_vars(); i--> 0; ) uf.mk_var();
+        u64_map<unsigned> sig2class;
+        vector<literal_vector> classes;
+        for (unsigned i = 0; i < var2val.size() && num_calls < max_calls && !s.inconsistent(); ++i) {
+            if (s.was_eliminated(i) || s.value(i) != l_undef) 
+                continue;
+            // normalize the signature such that the first pattern is false.
+            uint64_t sig = var2val[i].m_t;
+            literal u(i, false);
+            if (sig & 1) {
+                sig = ~sig;
+                u.neg();
+            }
+            if (sig == 0) {
+                // u is false in all simulations
+                if (0 == (cex_val(u) & cex_mask()) && refute(u, null_literal)) {
+                    literal nu = ~u;
+                    s.assign_unit(nu);
+                    sw.mk_clause(1, &nu);
+                    ++num_units;
+                    continue;
+                }
+            }
+            unsigned idx = 0;
+            if (!sig2class.find(sig, idx)) {
+                idx = classes.size();
+                classes.push_back(literal_vector());
+                sig2class.insert(sig, idx);
+            }
+            bool merged = false;
+            for (literal r : classes[idx]) {
+                if (num_calls + 2 > max_calls)
+                    break;
+                if (0 != ((cex_val(r) ^ cex_val(u)) & cex_mask()))
+                    continue;
+                if (refute(r, ~u) && refute(~r, u)) {
+                    IF_VERBOSE(10, verbose_stream() << "swept " << r << " == " << u << "\n");
+                    uf.merge(r.index(), u.index());
+                    uf.merge((~r).index(), (~u).index());
+                    sw.mk_clause(~r, u);
+                    sw.mk_clause(r, ~u);
+                    merged = true;
+                    ++num_eqs;
+                    break;
+                }
+            }
+            if (!merged) 
+                classes[idx].push_back(u);
+        }
+        m_stats.m_num_sweep_calls += num_calls;
+        m_stats.m_num_sweep_eqs += num_eqs;
+        m_stats.m_num_sweep_units += num_units;
+        m_stats.m_num_units += num_units;
+        IF_VERBOSE(2, verbose_stream() << "(sat.cut-simplifier :sweep-calls " << num_calls << " :sweep-eqs " << num_eqs << " :sweep-units " << num_units << ")\n");
+        if (num_eqs > 0 && !s.inconsistent()) 
+            uf2equiv(uf);
+    }
+
     void cut_simplifier::track_binary(bin_rel const& p) {
         if (!s.m_config.m_drat) 
             return;
@@ -738,6 +846,9 @@ namespace sat {
         st.update("sat-cut.xxors", m_stats.m_xxors);
         st.update("sat-cut.xluts", m_stats.m_xluts);
         st.update("sat-cut.dc-reduce", m_stats.m_num_dont_care_reductions);
+        st.update("sat-cut.sweep-calls", m_stats.m_num_sweep_calls);
+        st.update("sat-cut.sweep-eqs", m_stats.m_num_sweep_eqs);
+        st.update("sat-cut.sweep-units", m_stats.m_num_sweep_units);
     }
 
     void cut_simplifier::validate_unit(literal lit) {
@@ -30,6 +30,7 @@ namespace sat {
             unsigned m_num_eqs, m_num_units, m_num_cuts, m_num_xors, m_num_ands, m_num_ites;
             unsigned m_xxors, m_xands, m_xites, m_xluts;                         // extrated gates
             unsigned m_num_calls, m_num_dont_care_reductions, m_num_learned_implies;
+            unsigned m_num_sweep_calls, m_num_sweep_eqs, m_num_sweep_units;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -124,6 +125,7 @@ namespace sat {
         void clauses2aig();
         void aig2clauses();
         void simulate_eqs();
+        void sweep_eqs();
         void cuts2equiv(vector<cut_set> const& cuts);
         void cuts2implies(vector<cut_set> const& cuts);
         void uf2equiv(union_find<> const& uf);
@@ -81,12 +81,13 @@ namespace sat {
     void cut_set::push_back(on_update_t& on_add, cut const& c) {
         SASSERT(m_max_size > 0);
         if (!m_cuts) {
-            m_cuts = new (*m_region) cut[m_max_size];
+            m_cuts = m_alloc->allocate(m_max_size);
         }
         if (m_size == m_max_size) {
+            cut* new_cuts = m_alloc->allocate(2 * m_max_size);
+            std::copy(m_cuts, m_cuts + m_size, new_cuts);
+            m_alloc->deallocate(m_cuts, m_max_size);
             m_max_size *= 2;
-            cut* new_cuts = new (*m_region) cut[m_max_size];
-            std::uninitialized_copy(m_cuts, m_cuts + m_size, new_cuts);
             m_cuts = new_cuts;
         }
         if (m_var != UINT_MAX && on_add) on_add(m_var, c);
@@ -107,18 +108,33 @@ namespace sat {
         m_cuts[idx] = m_cuts[--m_size]; 
     }
 
-    void cut_set::init(region& r, unsigned max_sz, unsigned v) { 
+    void cut_set::init(cut_allocator& a, unsigned max_sz, unsigned v) { 
         m_var = v;
         m_size = 0;
-        SASSERT(!m_region || m_cuts);
-        VERIFY(!m_region || m_max_size > 0);
-        if (!m_region) {
+        SASSERT(!m_alloc || m_cuts);
+        VERIFY(!m_alloc || m_max_size > 0);
+        if (!m_alloc) {
             m_max_size = 2; // max_sz;
-            m_region = &r;
+            m_alloc = &a;
             m_cuts = nullptr;
         }
     }
 
+    cut* cut_allocator::allocate(unsigned sz) {
+        SASSERT(is_power_of_two(sz));
+        ptr_vector<cut>& fl = m_free[log2(sz)];
+        if (fl.empty()) 
+            return new (m_region) cut[sz];
+        cut* c = fl.back();
+        fl.pop_back();
+        return c;
+    }
+
+    void cut_allocator::deallocate(cut* c, unsigned sz) {
+        SASSERT(is_power_of_two(sz));
+        m_free[log2(sz)].push_back(c);
+    }
+
     /**
        \brief shift table 'a' by adding elements from 'c'.
        a.shift_table(c)
@@ -241,16 +257,31 @@ namespace sat {
         if (sz == 1 && t == 2) {
             return env[m_elems[0]];
         }
-        for (unsigned i = 0; i < 64; ++i) {
-            unsigned offset = 0;
-            for (unsigned j = 0; j < sz; ++j) {
-                offset |= (((env[m_elems[j]].m_t >> i) & 0x1) << j);
-            }
-            v.m_t |= ((t >> offset) & 0x1) << i;
-            v.m_f |= ((n >> offset) & 0x1) << i;
-        }
+        v.m_t = eval_table(t, env);
+        v.m_f = (n == t) ? v.m_t : eval_table(n, env);
         return v;
     }
+
+    /**
+       Evaluate the function with truth table 't' on all 64 assignments at once.
+       The table is expanded into one word per row, all ones or all zeros, and 
+       the rows are then combined pairwise by multiplexing on the inputs, 
+       starting from the least significant input. This takes 2^size word 
+       operations instead of 64 * size bit operations.
+    */
+    uint64_t cut::eval_table(uint64_t t, cut_eval const& env) const {
+        uint64_t rows[64];
+        unsigned n = 1u << size();
+        for (unsigned i = 0; i < n; ++i) 
+            rows[i] = 0ull - ((t >> i) & 1ull);
+        for (unsigned j = 0; j < size(); ++j) {
+            uint64_t x = env[m_elems[j]].m_t;
+            n /= 2;
+            for (unsigned i = 0; i < n; ++i) 
+                rows[i] = (x & rows[2*i + 1]) | (~x & rows[2*i]);
+        }
+        return rows[0];
+    }
     
     std::ostream& cut::display(std::ostream& out) const {
         out << "{";
@@ -125,6 +125,8 @@ namespace sat {
 
         uint64_t shift_table(cut const& other) const;
 
+        uint64_t eval_table(uint64_t t, cut_eval const& env) const;
+
         bool merge(cut const& a, cut const& b) {
             unsigned i = 0, j = 0;
             unsigned x = a[i];
@@ -174,17 +176,33 @@ namespace sat {
         static std::string table2string(unsigned num_input, uint64_t table);
     };
 
+    /**
+       \brief allocate cut arrays for cut sets from a region.
+       The sizes of the arrays are powers of two. An array that is released
+       when a cut set grows is kept on a free list and reused by the next
+       cut set that grows to the same size, instead of remaining as dead
+       memory in the region.
+    */
+    class cut_allocator {
+        region&         m_region;
+        ptr_vector<cut> m_free[32];
+    public:
+        cut_allocator(region& r): m_region(r) {}
+        cut* allocate(unsigned sz);
+        void deallocate(cut* c, unsigned sz);
+    };
+
     class cut_set {
         unsigned m_var;
-        region*  m_region;
+        cut_allocator* m_alloc;
         unsigned m_size;
         unsigned m_max_size;
         cut *    m_cuts;
     public:
         typedef std::function<void(unsigned v, cut const& c)> on_update_t;
 
-        cut_set(): m_var(UINT_MAX), m_region(nullptr), m_size(0), m_max_size(0), m_cuts(nullptr) {}
-        void init(region& r, unsigned max_sz, unsigned v);
+        cut_set(): m_var(UINT_MAX), m_alloc(nullptr), m_size(0), m_max_size(0), m_cuts(nullptr) {}
+        void init(cut_allocator& a, unsigned max_sz, unsigned v);
         bool insert(on_update_t& on_add, on_update_t& on_del, cut const& c);
         bool no_duplicates() const;
         unsigned var() const { return m_var; }
@@ -85,14 +85,25 @@ namespace sat {
         return false;
     }
 
+    /**
+     * Select a variable with positive reward with probability proportional to its score.
+     * The candidates and their scores are gathered in one pass over the unsat variables,
+     * so the selection pass runs over contiguous arrays instead of looking up
+     * the rewards of all unsat variables a second time.
+     */
     bool_var ddfw::pick_var() {
         double sum_pos = 0;
         unsigned n = 1;
         bool_var v0 = null_bool_var;
+        m_cand_vars.reset();
+        m_cand_scores.reset();
         for (bool_var v : m_unsat_vars) {
             int r = reward(v);
             if (r > 0) {                
-                sum_pos += score(r);
+                double s = score(r);
+                sum_pos += s;
+                m_cand_vars.push_back(v);
+                m_cand_scores.push_back(s);
             }
             else if (r == 0 && sum_pos == 0 && (m_rand() % (n++)) == 0) {
                 v0 = v;
@@ -100,14 +111,13 @@ namespace sat {
         }
         if (sum_pos > 0) {
             double lim_pos = ((double) m_rand() / (1.0 + m_rand.max_value())) * sum_pos;                
-            for (bool_var v : m_unsat_vars) {
-                int r = reward(v);
-                if (r > 0) {
-                    lim_pos -= score(r);
-                    if (lim_pos <= 0) {
-                        if (m_par) update_reward_avg(v);
-                        return v;
-                    }
+            unsigned sz = m_cand_vars.size();
+            for (unsigned i = 0; i < sz; ++i) {
+                lim_pos -= m_cand_scores[i];
+                if (lim_pos <= 0) {
+                    bool_var v = m_cand_vars[i];
+                    if (m_par) update_reward_avg(v);
+                    return v;
                 }
             }
         }
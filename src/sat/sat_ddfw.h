@@ -90,6 +90,8 @@ namespace sat {
 
         indexed_uint_set m_unsat;
         indexed_uint_set m_unsat_vars;  // set of variables that are in unsat clauses
+        bool_var_vector  m_cand_vars;   // variables with positive reward considered by pick_var
+        svector<double>  m_cand_scores; // their scores, stored contiguously
         random_gen       m_rand;
         unsigned         m_num_non_binary_clauses;
         unsigned         m_restart_count, m_reinit_count, m_parsync_count;
@@ -36,7 +36,7 @@ namespace sat {
         m_check(false),
         m_activity(false)
     {
-        if (s.get_config().m_drat && s.get_config().m_drat_file != symbol()) {
+        if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
             m_out = alloc(std::ofstream, s.get_config().m_drat_file.str().c_str(), mode);
             if (s.get_config().m_drat_binary) {
@@ -46,6 +46,7 @@ namespace sat {
     }
 
     drat::~drat() {
+        flush();
         if (m_out) m_out->flush();
         if (m_bout) m_bout->flush();
         dealloc(m_out);
@@ -78,6 +79,24 @@ namespace sat {
         }
     }
 
+    /**
+       \brief proof steps are collected in a buffer that is written to the
+       output stream in large blocks, instead of one stream write per step.
+    */
+    void drat::write(char const* data, unsigned len) {
+        for (unsigned i = 0; i < len; ++i) 
+            m_buffer.push_back(data[i]);
+        if (m_buffer.size() >= (1 << 16)) 
+            flush();
+    }
+
+    void drat::flush() {
+        std::ostream* out = m_out ? m_out : m_bout;
+        if (out && !m_buffer.empty()) 
+            out->write(m_buffer.c_ptr(), m_buffer.size());
+        m_buffer.reset();
+    }
+
     void drat::dump(unsigned n, literal const* c, status st) {
         if (st == status::asserted || st == status::external) {
             return;
@@ -112,16 +131,17 @@ namespace sat {
 	    len += static_cast<unsigned>(lastd - d);            
 	    buffer[len++] = ' ';
 	    if (len + 50 > sizeof(buffer)) {
-	        m_out->write(buffer, len);
+	        write(buffer, len);
 	        len = 0;
             }
         }        
 	buffer[len++] = '0';
 	buffer[len++] = '\n';
-	m_out->write(buffer, len);               
+	write(buffer, len);
     }
 
     void drat::dump_activity() {
+        flush();
         (*m_out) << "c a ";
         for (unsigned v = 0; v < s.num_vars(); ++v) {
             (*m_out) << s.m_activity[v] << " ";
@@ -151,14 +171,14 @@ namespace sat {
                 if (v) ch |= 128;
                 buffer[len++] = ch;
                 if (len == sizeof(buffer)) {
-                    m_bout->write(buffer, len);
+                    write(buffer, len);
                     len = 0;
                 }
             }
             while (v);
         }
         buffer[len++] = 0;
-        m_bout->write(buffer, len);
+        write(buffer, len);
     }
 
     bool drat::is_cleaned(clause& c) const {
@@ -667,8 +687,10 @@ namespace sat {
 
     void drat::add() {
         ++m_num_add;
-        if (m_out) (*m_out) << "0\n";
+        if (m_out) write("0\n", 2);
         if (m_bout) bdump(0, nullptr, status::learned);
+        // the empty clause completes the proof
+        flush();
         if (m_check_unsat) {
             SASSERT(m_inconsistent);
         }
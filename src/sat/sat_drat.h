@@ -48,6 +48,7 @@ namespace sat {
         clause_allocator        m_alloc;
         std::ostream*           m_out;
         std::ostream*           m_bout;
+        svector<char>           m_buffer;       // pending output to m_out or m_bout
         ptr_vector<clause>      m_proof;
         svector<status>         m_status;        
         literal_vector          m_units;
@@ -57,6 +58,8 @@ namespace sat {
         unsigned                m_num_add, m_num_del;
         bool                    m_check_unsat, m_check_sat, m_check, m_activity;
 
+        void write(char const* data, unsigned len);
+        void flush();
         void dump_activity();
         void dump(unsigned n, literal const* c, status st);
         void bdump(unsigned n, literal const* c, status st);
@@ -149,34 +149,70 @@ namespace sat {
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        literal lits[2] = { l1, l2 };
+        share_lits(s, 2, lits);
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
         if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        unsigned n = c.size();
+        IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  c << "\n";);
+        share_lits(s, c.size(), c.begin());
+    }
+
+    void parallel::share_lits(solver& s, unsigned n, literal const* lits) {
         unsigned owner = s.m_par_id;
-        IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
+        worker_stats& w = m_workers[owner];
+        if (!m_mux.try_lock()) {
+            // the pool is busy: queue the clause locally instead of waiting.
+            if (w.m_pending.size() + n + 1 > s_max_pending) {
+                ++w.m_dropped;
+                return;
+            }
+            w.m_pending.push_back(n);
+            for (unsigned i = 0; i < n; ++i) {
+                w.m_pending.push_back(lits[i].index());
+            }
+            return;
+        }
+        flush_pending(owner);
+        m_pool.begin_add_vector(owner, n);
         for (unsigned i = 0; i < n; ++i) {
-            m_pool.add_vector_elem(c[i].index());
+            m_pool.add_vector_elem(lits[i].index());
         }
-        m_pool.end_add_vector();        
+        m_pool.end_add_vector();
+        ++w.m_shared;
+        m_mux.unlock();
+    }
+
+    /**
+       \brief move clauses queued by owner into the shared pool.
+       Assumes m_mux is held.
+     */
+    void parallel::flush_pending(unsigned owner) {
+        worker_stats& w = m_workers[owner];
+        unsigned_vector const& p = w.m_pending;
+        for (unsigned i = 0; i < p.size(); i += p[i] + 1) {
+            unsigned n = p[i];
+            m_pool.begin_add_vector(owner, n);
+            for (unsigned j = 1; j <= n; ++j) {
+                m_pool.add_vector_elem(p[i + j]);
+            }
+            m_pool.end_add_vector();
+            ++w.m_shared;
+        }
+        w.m_pending.reset();
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
-        _get_clauses(s);        
+        // clauses remain in the pool if it is busy, 
+        // they are retrieved on the next attempt.
+        if (!m_mux.try_lock()) return;
+        flush_pending(s.m_par_id);
+        _get_clauses(s);
+        m_mux.unlock();
     }
 
     void parallel::_get_clauses(solver& s) {
@@ -195,6 +231,7 @@ namespace sat {
             SASSERT(n >= 2);
             if (usable_clause) {
                 s.mk_clause_core(m_lits.size(), m_lits.c_ptr(), true);
+                ++m_workers[owner].m_imported;
             }
         }        
     }
@@ -277,5 +314,19 @@ namespace sat {
         return copied;
     }
     
+    void parallel::collect_statistics(statistics& st) const {
+        unsigned shared = 0, imported = 0, dropped = 0;
+        for (unsigned i = 0; i < m_workers.size(); ++i) {
+            worker_stats const& w = m_workers[i];
+            IF_VERBOSE(2, verbose_stream() << "(sat-parallel :worker " << i << " :shared " << w.m_shared 
+                       << " :imported " << w.m_imported << " :dropped " << w.m_dropped << ")\n";);
+            shared += w.m_shared;
+            imported += w.m_imported;
+            dropped += w.m_dropped;
+        }
+        st.update("sat par shared", shared);
+        st.update("sat par imported", imported);
+        st.update("sat par dropped", dropped);
+    }
+    
 };
-
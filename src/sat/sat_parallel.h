@@ -25,6 +25,7 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/mutex.h"
+#include "util/statistics.h"
 
 namespace sat {
 
@@ -50,7 +51,23 @@ namespace sat {
             bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
         };
 
+        // per worker exchange state.
+        // clauses are exported without waiting for the pool lock:
+        // if it is contended they are queued in m_pending and
+        // flushed the next time the worker obtains the lock.
+        struct worker_stats {
+            unsigned_vector m_pending;
+            unsigned        m_shared;
+            unsigned        m_imported;
+            unsigned        m_dropped;
+            worker_stats(): m_shared(0), m_imported(0), m_dropped(0) {}
+        };
+
+        static const unsigned s_max_pending = 1 << 12;
+
         bool enable_add(clause const& c) const;
+        void share_lits(solver& s, unsigned n, literal const* lits);
+        void flush_pending(unsigned owner);
         void _get_clauses(solver& s);
         void _from_solver(solver& s);
         bool _to_solver(solver& s);
@@ -62,6 +79,7 @@ namespace sat {
         index_set      m_unit_set;
         literal_vector m_lits;
         vector_pool    m_pool;
+        vector<worker_stats> m_workers;
         mutex          m_mux;
 
         // for exchange with local search:
@@ -85,7 +103,7 @@ namespace sat {
         void push_child(reslimit& rl);
 
         // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); m_workers.reset(); m_workers.resize(num_owners); }
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
@@ -110,6 +128,8 @@ namespace sat {
         void to_solver(i_local_search& s);
         
         bool copy_solver(solver& s);
+
+        void collect_statistics(statistics& st) const;
     };
 
 };
@@ -431,9 +431,9 @@ namespace sat {
             clause & c2 = it.curr();
             CTRACE("sat_simplifier", c2.was_removed(), tout << "clause has been removed:\n" << c2 << "\n";);
             SASSERT(!c2.was_removed());
-            if (&c2 != &c1 &&
+            if (approx_subset(c1.approx(), c2.approx()) &&
                 c1.size() <= c2.size() &&
-                approx_subset(c1.approx(), c2.approx())) {
+                &c2 != &c1) {
                 m_sub_counter -= c1.size() + c2.size();
                 literal l;
                 if (subsumes1(c1, c2, l)) {
@@ -540,9 +540,9 @@ namespace sat {
         for (; !it.at_end(); it.next()) {
             clause & c2 = it.curr();
             SASSERT(!c2.was_removed());
-            if (&c2 != &c1 &&
+            if (approx_subset(c1.approx(), c2.approx()) &&
                 c1.size() <= c2.size() &&
-                approx_subset(c1.approx(), c2.approx())) {
+                &c2 != &c1) {
                 m_sub_counter -= c1.size() + c2.size();
                 if (subsumes0(c1, c2)) {
                     out.push_back(&c2);
@@ -1894,6 +1894,79 @@ namespace sat {
         }
     }
 
+    /**
+       \brief Find a definition l <=> a_1 & ... & a_n among the clauses of l.
+       It consists of the clause (l or ~a_1 or ... or ~a_n) in def and the binary clauses
+       (~l or a_i) in bins. Mark the clauses of the definition in in_def and in_bins.
+    */
+    bool simplifier::find_and_gate(literal l, clause_wrapper_vector const & def, clause_wrapper_vector const & bins,
+                                   svector<bool> & in_def, svector<bool> & in_bins) {
+        literal not_l = ~l;
+        for (clause_wrapper const & b : bins) {
+            if (b.is_binary())
+                mark_visited(b[0] == not_l ? b[1] : b[0]);
+        }
+        bool found = false;
+        for (unsigned i = 0; !found && i < def.size(); ++i) {
+            clause_wrapper const & c = def[i];
+            m_elim_counter -= c.size();
+            found = true;
+            for (unsigned k = 0; found && k < c.size(); ++k)
+                found = c[k] == l || is_marked(~c[k]);
+            if (found)
+                in_def[i] = true;
+        }
+        for (unsigned j = 0; j < bins.size(); ++j) {
+            clause_wrapper const & b = bins[j];
+            if (!b.is_binary())
+                continue;
+            literal a = b[0] == not_l ? b[1] : b[0];
+            unmark_visited(a);
+            if (found)
+                in_bins[j] = true;
+        }
+        if (!found)
+            return false;
+        // keep only the binary clauses that occur in the definition clause.
+        for (unsigned i = 0; i < def.size(); ++i) {
+            if (!in_def[i])
+                continue;
+            for (unsigned k = 0; k < def[i].size(); ++k)
+                mark_visited(def[i][k]);
+        }
+        for (unsigned j = 0; j < bins.size(); ++j) {
+            if (in_bins[j]) {
+                clause_wrapper const & b = bins[j];
+                literal a = b[0] == not_l ? b[1] : b[0];
+                in_bins[j] = is_marked(~a);
+            }
+        }
+        for (unsigned i = 0; i < def.size(); ++i) {
+            if (!in_def[i])
+                continue;
+            for (unsigned k = 0; k < def[i].size(); ++k)
+                unmark_visited(def[i][k]);
+        }
+        return true;
+    }
+
+    /**
+       \brief Find an AND (or OR) gate that defines v.
+       Resolvents of two clauses of the gate are tautologies and the resolvents of
+       two clauses outside of the gate are implied by the other resolvents,
+       so only the resolvents of gate clauses with non-gate clauses are needed.
+    */
+    bool simplifier::find_gate(bool_var v) {
+        m_pos_gate.reset();
+        m_neg_gate.reset();
+        m_pos_gate.resize(m_pos_cls.size(), false);
+        m_neg_gate.resize(m_neg_cls.size(), false);
+        literal pos_l(v, false);
+        return
+            find_and_gate(pos_l, m_pos_cls, m_neg_cls, m_pos_gate, m_neg_gate) ||
+            find_and_gate(~pos_l, m_neg_cls, m_pos_cls, m_neg_gate, m_pos_gate);
+    }
+
     bool simplifier::try_eliminate(bool_var v) {
         TRACE("sat_simplifier", tout << "processing: " << v << "\n";);
         if (value(v) != l_undef)
@@ -1940,12 +2013,17 @@ namespace sat {
         m_neg_cls.reset();
         collect_clauses(pos_l, m_pos_cls);
         collect_clauses(neg_l, m_neg_cls);
+        bool gate = find_gate(v);
 
         TRACE("sat_simplifier", tout << "collecting number of after_clauses\n";);
         unsigned before_clauses = num_pos + num_neg;
         unsigned after_clauses  = 0;
-        for (clause_wrapper& c1 : m_pos_cls) {
-            for (clause_wrapper& c2 : m_neg_cls) {
+        for (unsigned i = 0; i < m_pos_cls.size(); ++i) {
+            clause_wrapper& c1 = m_pos_cls[i];
+            for (unsigned j = 0; j < m_neg_cls.size(); ++j) {
+                clause_wrapper& c2 = m_neg_cls[j];
+                if (gate && m_pos_gate[i] == m_neg_gate[j])
+                    continue;
                 m_new_cls.reset();
                 if (resolve(c1, c2, pos_l, m_new_cls)) {
                     TRACE("sat_simplifier", tout << c1 << "\n" << c2 << "\n-->\n";
@@ -1965,6 +2043,8 @@ namespace sat {
 
         // eliminate variable
         ++s.m_stats.m_elim_var_res;
+        if (gate)
+            ++m_num_elim_gates;
         VERIFY(!is_external(v));
         model_converter::entry & mc_entry = s.m_mc.mk(model_converter::ELIM_VAR, v);
         save_clauses(mc_entry, m_pos_cls);
@@ -1972,8 +2052,12 @@ namespace sat {
         s.set_eliminated(v, true);
         m_elim_counter -= num_pos * num_neg + before_lits;
 
-        for (auto & c1 : m_pos_cls) {
-            for (auto & c2 : m_neg_cls) {
+        for (unsigned i = 0; i < m_pos_cls.size(); ++i) {
+            clause_wrapper& c1 = m_pos_cls[i];
+            for (unsigned j = 0; j < m_neg_cls.size(); ++j) {
+                clause_wrapper& c2 = m_neg_cls[j];
+                if (gate && m_pos_gate[i] == m_neg_gate[j])
+                    continue;
                 m_new_cls.reset();
                 if (!resolve(c1, c2, pos_l, m_new_cls))
                     continue;                
@@ -2068,6 +2152,8 @@ namespace sat {
         m_pos_cls.finalize();
         m_neg_cls.finalize();
         m_new_cls.finalize();
+        m_pos_gate.finalize();
+        m_neg_gate.finalize();
     }
 
     void simplifier::updt_params(params_ref const & _p) {
@@ -2114,6 +2200,7 @@ namespace sat {
         st.update("sat abce", m_num_abce);
         st.update("sat bca",  m_num_bca);
         st.update("sat ate",  m_num_ate);
+        st.update("sat elim gates", m_num_elim_gates);
     }
 
     void simplifier::reset_statistics() {
@@ -2125,6 +2212,7 @@ namespace sat {
         m_num_sub_res = 0;
         m_num_elim_lits = 0;
         m_num_elim_vars = 0;
+        m_num_elim_gates = 0;
         m_num_bca = 0;
         m_num_ate = 0;
     }
@@ -110,6 +110,7 @@ namespace sat {
         unsigned               m_num_ate;
         unsigned               m_num_subsumed;
         unsigned               m_num_elim_vars;
+        unsigned               m_num_elim_gates;
         unsigned               m_num_sub_res;
         unsigned               m_num_elim_lits;
 
@@ -193,6 +194,11 @@ namespace sat {
         clause_wrapper_vector m_pos_cls;
         clause_wrapper_vector m_neg_cls;
         literal_vector m_new_cls;
+        svector<bool>  m_pos_gate; // m_pos_gate[i] if m_pos_cls[i] belongs to a definition of the eliminated variable
+        svector<bool>  m_neg_gate;
+        bool find_and_gate(literal l, clause_wrapper_vector const & def, clause_wrapper_vector const & bins,
+                           svector<bool> & in_def, svector<bool> & in_bins);
+        bool find_gate(bool_var v);
         bool resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r);
         void save_clauses(model_converter::entry & mc_entry, clause_wrapper_vector const & cs);
         void add_non_learned_binary_clause(literal l1, literal l2);
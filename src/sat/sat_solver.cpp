@@ -26,6 +26,8 @@ Revision History:
 #include "util/trace.h"
 #include "util/max_cliques.h"
 #include "util/gparams.h"
+#include "util/thread_pool.h"
+#include "util/event_trace.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_integrity_checker.h"
 #include "sat/sat_lookahead.h"
@@ -33,6 +35,8 @@ Revision History:
 #include "sat/sat_prob.h"
 #include "sat/sat_anf_simplifier.h"
 #include "sat/sat_cut_simplifier.h"
+#include "sat/sat_vivifier.h"
+#include "sat/sat_symmetry.h"
 #if defined(_MSC_VER) && !defined(_M_ARM) && !defined(_M_ARM64)
 # include <xmmintrin.h>
 #endif
@@ -85,6 +89,7 @@ namespace sat {
         m_ext                     = nullptr;
         m_cuber                   = nullptr;
         m_local_search            = nullptr;
+        m_prev_core_valid         = false;
         m_mc.set_solver(this);
     }
 
@@ -1128,6 +1133,28 @@ namespace sat {
         lh.display_lookahead_scores(out);
     }
 
+    /**
+       \brief produce up to max_cubes cubes in one call.
+       l_undef: the cubes are appended to cubes, and cubing can be resumed by further calls.
+       l_false: the search space outside of the appended cubes is unsatisfiable.
+       l_true:  a model was found.
+       An empty cube covers the remaining search space and ends the batch.
+    */
+    lbool solver::cubes(bool_var_vector& vars, vector<literal_vector>& cubes, unsigned max_cubes, unsigned backtrack_level) {
+        literal_vector lits;
+        lbool r = l_undef;
+        for (unsigned n = 0; n < max_cubes; ++n) {
+            r = cube(vars, lits, backtrack_level);
+            backtrack_level = UINT_MAX;
+            if (r != l_undef) 
+                break;
+            cubes.push_back(lits);
+            if (lits.empty()) 
+                break;
+        }
+        return r;
+    }
+
     lbool solver::cube(bool_var_vector& vars, literal_vector& lits, unsigned backtrack_level) {
         bool is_first = !m_cuber;
         if (is_first) {
@@ -1214,6 +1241,14 @@ namespace sat {
             init_assumptions(num_lits, lits);
             propagate(false);
             if (check_inconsistent()) return l_false;
+            if (m_config.m_symmetry && num_lits == 0 && m_user_scope_literals.empty() && 
+                !m_ext && !m_config.m_drat && m_mc.empty()) {
+                symmetry_breaker sb(*this);
+                sb();
+                sb.collect_statistics(m_aux_stats);
+                propagate(false);
+                if (check_inconsistent()) return l_false;
+            }
             if (m_config.m_force_cleanup) do_cleanup(true);
 
             if (m_config.m_gc_burst) {
@@ -1439,17 +1474,12 @@ namespace sat {
             return l_undef;
         }
 
-        vector<std::thread> threads(num_threads);
-        for (int i = 0; i < num_threads; ++i) {
-            threads[i] = std::thread([&, i]() { worker_thread(i); });
-        }
-        for (auto & th : threads) {
-            th.join();
-        }
+        thread_pool::run(num_threads, worker_thread);
         
         if (IS_AUX_SOLVER(finished_id)) {
             m_stats = par.get_solver(finished_id).m_stats;
         }
+        par.collect_statistics(m_aux_stats);
         if (result == l_true && IS_AUX_SOLVER(finished_id)) {
             set_model(par.get_solver(finished_id).get_model(), true);
         }
@@ -1819,6 +1849,14 @@ namespace sat {
         m_force_conflict_analysis = false;
         m_restart_threshold       = m_config.m_restart_initial;
         m_luby_idx                = 1;
+        m_bandit_pulls.reset();
+        m_bandit_reward.reset();
+        m_bandit_pulls.resize(4, 0);
+        m_bandit_reward.resize(4, 0.0);
+        m_bandit_arm              = 0;
+        m_bandit_start            = 0;
+        m_bandit_next             = 0;
+        m_bandit_glue_sum         = 0;
         m_gc_threshold            = m_config.m_gc_initial;
         m_defrag_threshold        = 2;
         m_restarts                = 0;
@@ -1889,6 +1927,12 @@ namespace sat {
         CASSERT("sat_simplify_bug", check_invariant());
         m_asymm_branch(false);
 
+        if (m_config.m_vivify && !m_learned.empty() && !inconsistent()) {
+            vivifier viv(*this);
+            viv();
+            viv.collect_statistics(m_aux_stats);
+        }
+
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
         if (m_ext) {
@@ -2174,12 +2218,68 @@ namespace sat {
             log_stats();
         }
         TRACE("sat", tout << "restart " << restart_level(to_base) << "\n";);
+        if (event_trace::enabled())
+            event_trace::event("sat.restart")("restarts", m_restarts)("conflicts", m_stats.m_conflict)("decisions", m_stats.m_decision)("level", m_scope_lvl);
         IF_VERBOSE(30, display_status(verbose_stream()););
         TRACE("sat", tout << "restart " << restart_level(to_base) << "\n";);
         pop_reinit(restart_level(to_base));
+        if (m_config.m_bandit) 
+            update_bandit();
         set_next_restart();
     }
 
+    /**
+       \brief select the branching heuristic and restart strategy using UCB1.
+       Every arm is used for an epoch of m_bandit_epoch conflicts. The reward of an epoch
+       is 2/(1 + average glue of the lemmas learned in the epoch), which is in (0, 1]
+       and increases as the lemmas get stronger.
+    */
+    void solver::update_bandit() {
+        if (m_stats.m_conflict < m_bandit_next)
+            return;
+        unsigned n = m_stats.m_conflict - m_bandit_start;
+        if (m_bandit_next > 0 && n > 0) {
+            m_bandit_reward[m_bandit_arm] += 2.0 * n / (n + m_bandit_glue_sum);
+            m_bandit_pulls[m_bandit_arm]++;
+        }
+        unsigned total = 0;
+        for (unsigned p : m_bandit_pulls) 
+            total += p;
+        unsigned best = 0;
+        double best_score = -1;
+        for (unsigned arm = 0; arm < m_bandit_pulls.size(); ++arm) {
+            unsigned p = m_bandit_pulls[arm];
+            if (p == 0) {
+                best = arm;
+                break;
+            }
+            double score = m_bandit_reward[arm] / p + sqrt(2.0 * log(static_cast<double>(total)) / p);
+            if (score > best_score) {
+                best = arm;
+                best_score = score;
+            }
+        }
+        TRACE("sat", tout << "bandit arm " << m_bandit_arm << " -> " << best << "\n";);
+        if (best != m_bandit_arm || m_bandit_next == 0) {
+            set_bandit_arm(best);
+        }
+        m_bandit_start = m_stats.m_conflict;
+        m_bandit_next = m_stats.m_conflict + m_config.m_bandit_epoch;
+        m_bandit_glue_sum = 0;
+    }
+
+    /**
+       arm 0: vsids, ema; arm 1: chb, ema; arm 2: vsids, luby; arm 3: chb, luby
+    */
+    void solver::set_bandit_arm(unsigned arm) {
+        if (arm != m_bandit_arm)
+            m_stats.m_bandit_switches++;
+        m_bandit_arm = arm;
+        m_config.m_branching_heuristic = (arm & 1) ? BH_CHB : BH_VSIDS;
+        m_config.m_restart = (arm & 2) ? RS_LUBY : RS_EMA;
+        IF_VERBOSE(2, verbose_stream() << "(sat.bandit :arm " << arm << " :conflicts " << m_stats.m_conflict << ")\n";);
+    }
+
     unsigned solver::restart_level(bool to_base) {
         if (to_base || scope_lvl() == search_lvl()) {
             return scope_lvl() - search_lvl();
@@ -2200,11 +2300,15 @@ namespace sat {
             while (n < scope_lvl() - search_lvl());
             return n;
 #endif
-            // pop trail from bottom
+            // pop trail from bottom:
+            // the decisions of levels search_lvl() .. n - 1 are more active than
+            // the next decision and would be re-made in the same order, so the
+            // levels are kept and only the levels above n are popped.
             unsigned n = search_lvl();
             for (; n < scope_lvl() && m_case_split_queue.more_active(scope_literal(n).var(), next); ++n) {
             }
-            return n - search_lvl();
+            m_stats.m_restart_reused_levels += n - search_lvl();
+            return scope_lvl() - n;
         }
     }
 
@@ -2243,7 +2347,10 @@ namespace sat {
 
     bool solver::should_gc() const {
         return 
-            m_conflicts_since_gc > m_gc_threshold &&
+            (m_conflicts_since_gc > m_gc_threshold || 
+             (m_config.m_gc_max_memory > 0 && 
+              m_conflicts_since_gc > m_config.m_gc_increment &&
+              cls_allocator().get_allocation_size() > megabytes_to_bytes(m_config.m_gc_max_memory))) &&
             (m_config.m_gc_strategy != GC_DYN_PSM || at_base_lvl());
     }
 
@@ -2268,6 +2375,9 @@ namespace sat {
         case GC_PSM_GLUE:
             gc_psm_glue();
             break;
+        case GC_TIERED:
+            gc_tiered();
+            break;
         case GC_DYN_PSM:
             if (!m_assumptions.empty()) {
                 gc_glue_psm();
@@ -2282,6 +2392,8 @@ namespace sat {
             break;
         }
         if (m_ext) m_ext->gc();
+        if (event_trace::enabled())
+            event_trace::event("sat.gc")("conflicts", m_stats.m_conflict)("deleted", m_stats.m_gc_clause - gc)("learned", m_learned.size());
         if (gc > 0 && should_defrag()) {
             defrag_clauses();
         }
@@ -2421,6 +2533,45 @@ namespace sat {
         return !jst.is_clause() || cls_allocator().get_clause(jst.get_clause_offset()) != &c;
     }
 
+    /**
+       \brief Three-tier management of learned clauses:
+       - core:  clauses with glue <= gc.tier1_glue are never deleted.
+       - tier2: clauses with glue <= gc.tier2_glue are kept as long as they
+                were used in conflict analysis since the previous gc.
+       - local: all other clauses are sorted by (glue, size), and the second half is deleted.
+    */
+    void solver::gc_tiered() {
+        unsigned sz = m_learned.size();
+        unsigned j = 0;
+        clause_vector local;
+        for (clause* cp : m_learned) {
+            clause& c = *cp;
+            bool used = c.was_used();
+            c.unmark_used();
+            if (c.glue() <= m_config.m_gc_tier1_glue || (used && c.glue() <= m_config.m_gc_tier2_glue)) 
+                m_learned[j++] = cp;
+            else 
+                local.push_back(cp);
+        }
+        unsigned kept = j;
+        std::stable_sort(local.begin(), local.end(), glue_lt());
+        unsigned half = local.size() / 2;
+        for (unsigned i = 0; i < local.size(); ++i) {
+            clause& c = *local[i];
+            if (i >= half && can_delete(c)) {
+                detach_clause(c);
+                del_clause(c);
+            }
+            else {
+                m_learned[j++] = &c;
+            }
+        }
+        m_stats.m_gc_clause += sz - j;
+        m_learned.shrink(j);
+        IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-gc :strategy tiered :kept " << kept 
+                   << " :local " << local.size() << " :deleted " << (sz - j) << ")\n";);
+    }
+
     /**
        \brief Use gc based on dynamic psm. Clauses are initially frozen.
     */
@@ -2679,6 +2830,7 @@ namespace sat {
                 break;
             case justification::CLAUSE: {
                 clause & c = get_clause(js);
+                c.mark_used();
                 unsigned i = 0;
                 if (consequent != null_literal) {
                     SASSERT(c[0] == consequent || c[1] == consequent);
@@ -2775,6 +2927,9 @@ namespace sat {
         
         unsigned glue = num_diff_levels(m_lemma.size(), m_lemma.c_ptr());        
         m_fast_glue_avg.update(glue);
+        m_bandit_glue_sum += glue;
+        if (event_trace::enabled())
+            event_trace::event("sat.conflict")("conflicts", m_stats.m_conflict)("lbd", glue)("size", m_lemma.size())("level", m_conflict_lvl);
         m_slow_glue_avg.update(glue);
     
         // compute whether to use backtracking or backjumping
@@ -2801,6 +2956,13 @@ namespace sat {
         updt_phase_counters();
     }
 
+    /**
+       \brief decide between non-chronological backjumping and chronological backtracking.
+       When the backjump would undo more than backtrack.scopes scopes (after the first
+       backtrack.conflicts conflicts), the solver only undoes the scopes above the 
+       level of the asserting literal, so that the trail below it is kept.
+       Extensions are notified through pop_reinit in both cases.
+     */
     bool solver::use_backjumping(unsigned num_scopes) {
         return 
             num_scopes > 0 && 
@@ -2949,15 +3111,38 @@ namespace sat {
                 m_core.reset();
                 m_core.append(m_min_core);
             }
+            if (prev_core_applies() && m_prev_core.size() < m_core.size()) {
+                IF_VERBOSE(2, verbose_stream() << "(sat.reusing core " << m_prev_core.size() << " " << m_core.size() << ")\n";);
+                m_core.reset();
+                m_core.append(m_prev_core);
+            }
             // TBD:
             // apply optional clause minimization by detecting subsumed literals.
             // initial experiment suggests it has no effect.
             m_mus(); // ignore return value on cancelation.
             set_model(m_mus.get_model(), !m_mus.get_model().empty());
             IF_VERBOSE(2, verbose_stream() << "(sat.core: " << m_core << ")\n";);
+            m_prev_core.reset();
+            m_prev_core.append(m_core);
+            m_prev_core_valid = true;
         }
     }
 
+    /**
+       \brief a core of a previous call remains a core as long as no clauses
+       were removed since. It applies to the current call if all its literals
+       are current assumptions or negated user scope literals.
+    */
+    bool solver::prev_core_applies() const {
+        if (!m_prev_core_valid)
+            return false;
+        for (literal lit : m_prev_core) {
+            if (!is_assumption(lit) && !m_user_scope_literals.contains(~lit))
+                return false;
+        }
+        return true;
+    }
+
 
     unsigned solver::get_max_lvl(literal not_l, justification js, bool& unique_max) {
         unique_max = true;
@@ -3865,6 +4050,7 @@ namespace sat {
 
     void solver::user_pop(unsigned num_scopes) {
         pop_to_base_level();
+        m_prev_core_valid = false;
         TRACE("sat", display(tout););
         while (num_scopes > 0) {
             literal lit = m_user_scope_literals.back();
@@ -4910,6 +5096,8 @@ namespace sat {
         st.update("sat propagations 3ary", m_ter_propagate);
         st.update("sat propagations nary", m_propagate);
         st.update("sat restarts", m_restart);
+        st.update("sat restart reused levels", m_restart_reused_levels);
+        st.update("sat bandit switches", m_bandit_switches);
         st.update("sat minimized lits", m_minimized_lits);
         st.update("sat subs resolution dyn", m_dyn_sub_res);
         st.update("sat blocked correction sets", m_blocked_corr_sets);
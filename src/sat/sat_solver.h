@@ -74,6 +74,8 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_restart_reused_levels;
+        unsigned m_bandit_switches;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -218,9 +220,11 @@ namespace sat {
         friend class elim_vars;
         friend class scoped_detach;
         friend class xor_finder;
+        friend class symmetry_breaker;
         friend class aig_finder;
         friend class lut_finder;
         friend class npn3_finder;
+        friend class vivifier;
     public:
         solver(params_ref const & p, reslimit& l);
         ~solver() override;
@@ -452,6 +456,7 @@ namespace sat {
         void set_activity(bool_var v, unsigned act);
 
         lbool  cube(bool_var_vector& vars, literal_vector& lits, unsigned backtrack_level);
+        lbool  cubes(bool_var_vector& vars, vector<literal_vector>& cubes, unsigned max_cubes, unsigned backtrack_level);
         
         void display_lookahead_scores(std::ostream& out);
 
@@ -465,6 +470,13 @@ namespace sat {
         unsigned m_simplifications;
         unsigned m_restart_threshold;
         unsigned m_luby_idx;
+        // multi-armed bandit over branching heuristic and restart strategy.
+        unsigned_vector m_bandit_pulls;
+        svector<double> m_bandit_reward;
+        unsigned m_bandit_arm;
+        unsigned m_bandit_start;     // conflicts at the start of the epoch of the current arm
+        unsigned m_bandit_next;      // conflicts at the end of the epoch
+        double   m_bandit_glue_sum;  // sum of the glue of the lemmas learned in the epoch
         unsigned m_conflicts_since_gc;
         unsigned m_gc_threshold;
         unsigned m_defrag_threshold;
@@ -480,6 +492,9 @@ namespace sat {
         
         literal_vector m_min_core;
         bool           m_min_core_valid;
+        literal_vector m_prev_core;       // minimized core of a previous check, valid until clauses are removed by user_pop
+        bool           m_prev_core_valid;
+        bool           prev_core_applies() const;
         void init_reason_unknown() { m_reason_unknown = "no reason given"; }
         void init_assumptions(unsigned num_lits, literal const* lits);
         void reassert_min_core();
@@ -504,6 +519,8 @@ namespace sat {
         bool should_cancel();
         bool should_restart() const;
         void set_next_restart();
+        void update_bandit();
+        void set_bandit_arm(unsigned arm);
         void update_activity(bool_var v, double p);
         bool reached_max_conflicts();
         void sort_watch_lits();
@@ -530,6 +547,7 @@ namespace sat {
         void save_psm();
         void gc_half(char const * st_name);
         void gc_dyn_psm();
+        void gc_tiered();
         bool activate_frozen_clause(clause & c);
         unsigned psm(clause const & c) const;
         bool can_delete(clause const & c) const;
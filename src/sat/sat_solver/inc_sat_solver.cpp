@@ -331,6 +331,7 @@ public:
     }
     void collect_statistics(statistics & st) const override {
         if (m_preprocess) m_preprocess->collect_statistics(st);
+        if (m_bb_rewriter) m_bb_rewriter->collect_statistics(st);
         m_solver.collect_statistics(st);
     }
     void get_unsat_core(expr_ref_vector & r) override {
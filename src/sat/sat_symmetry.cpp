@@ -0,0 +1,137 @@
+/*++
+  Copyright (c) 2020 Microsoft Corporation
+
+  Module Name:
+
+   sat_symmetry.cpp
+
+  Abstract:
+
+    Symmetry breaking for interchangeable variables.
+
+  --*/
+
+#include "util/hash.h"
+#include "sat/sat_symmetry.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    symmetry_breaker::symmetry_breaker(solver& s):
+        s(s),
+        m_budget(10000000),
+        m_num_breakers(0) {
+    }
+
+    void symmetry_breaker::add_clause(unsigned sz, literal const* lits) {
+        unsigned idx = m_clauses.size();
+        m_clauses.push_back(literal_vector(sz, lits));
+        literal_vector& c = m_clauses.back();
+        std::sort(c.begin(), c.end());
+        for (literal l : c)
+            m_occs[l.index()].push_back(idx);
+        m_budget -= sz;
+    }
+
+    void symmetry_breaker::init_clauses() {
+        m_occs.reset();
+        m_occs.resize(2 * s.num_vars());
+        for (clause* cp : s.m_clauses) {
+            if (!cp->was_removed())
+                add_clause(cp->size(), cp->begin());
+        }
+        unsigned l_idx = 0;
+        for (watch_list const& wlist : s.m_watches) {
+            literal l = ~to_literal(l_idx++);
+            for (watched const& w : wlist) {
+                if (w.is_binary_non_learned_clause() && l.index() < w.get_literal().index()) {
+                    literal lits[2] = { l, w.get_literal() };
+                    add_clause(2, lits);
+                }
+            }
+        }
+    }
+
+    /**
+       \brief signature of the occurrences of l that is invariant under renaming.
+    */
+    uint64_t symmetry_breaker::signature(literal l) const {
+        unsigned_vector const& occs = m_occs[l.index()];
+        uint64_t sum = 0, sum2 = 0;
+        for (unsigned idx : occs) {
+            uint64_t sz = m_clauses[idx].size();
+            sum += sz;
+            sum2 += sz * sz;
+        }
+        return (static_cast<uint64_t>(occs.size()) << 40) ^ (sum << 20) ^ sum2;
+    }
+
+    literal symmetry_breaker::swap(literal l, bool_var x, bool_var y) const {
+        if (l.var() == x) return literal(y, l.sign());
+        if (l.var() == y) return literal(x, l.sign());
+        return l;
+    }
+
+    /**
+       \brief check if the sorted clause c occurs among the clauses of l.
+    */
+    bool symmetry_breaker::contains(literal l, literal_vector const& c) {
+        for (unsigned idx : m_occs[l.index()]) {
+            literal_vector const& d = m_clauses[idx];
+            m_budget -= d.size();
+            if (d == c)
+                return true;
+        }
+        return false;
+    }
+
+    bool symmetry_breaker::is_symmetric(bool_var x, bool_var y) {
+        literal lits[4] = { literal(x, false), literal(x, true), literal(y, false), literal(y, true) };
+        for (literal l : lits) {
+            if (m_occs[l.index()].size() != m_occs[swap(l, x, y).index()].size())
+                return false;
+        }
+        for (literal l : lits) {
+            for (unsigned idx : m_occs[l.index()]) {
+                if (m_budget < 0)
+                    return false;
+                m_image.reset();
+                for (literal l2 : m_clauses[idx])
+                    m_image.push_back(swap(l2, x, y));
+                std::sort(m_image.begin(), m_image.end());
+                if (m_image != m_clauses[idx] && !contains(swap(l, x, y), m_image))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void symmetry_breaker::operator()() {
+        init_clauses();
+        typedef std::pair<std::pair<uint64_t, uint64_t>, bool_var> key;
+        svector<key> keys;
+        for (bool_var v = 0; v < s.num_vars(); ++v) {
+            if (s.value(v) != l_undef || s.was_eliminated(v))
+                continue;
+            literal l(v, false);
+            if (m_occs[l.index()].empty() && m_occs[(~l).index()].empty())
+                continue;
+            keys.push_back(key(std::make_pair(signature(l), signature(~l)), v));
+        }
+        std::sort(keys.begin(), keys.end());
+        for (unsigned i = 0; i + 1 < keys.size() && m_budget >= 0; ++i) {
+            if (keys[i].first != keys[i + 1].first)
+                continue;
+            bool_var x = keys[i].second, y = keys[i + 1].second;
+            if (is_symmetric(x, y)) {
+                ++m_num_breakers;
+                s.mk_clause(literal(x, true), literal(y, false));
+            }
+        }
+        IF_VERBOSE(2, verbose_stream() << "(sat.symmetry :breakers " << m_num_breakers << ")\n";);
+    }
+
+    void symmetry_breaker::collect_statistics(statistics& st) const {
+        st.update("sat symmetry breakers", m_num_breakers);
+    }
+}
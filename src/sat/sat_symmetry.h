@@ -0,0 +1,59 @@
+/*++
+  Copyright (c) 2020 Microsoft Corporation
+
+  Module Name:
+
+   sat_symmetry.h
+
+  Abstract:
+
+    Symmetry breaking for interchangeable variables.
+
+    Variables x < y are interchangeable if swapping x and y maps the
+    irredundant clauses to themselves. For each such pair the lex-leader
+    clause (~x or y) is added. All lex-leader clauses use the order of
+    the variable indices, so they are satisfied together by the least
+    model of every orbit.
+
+    Candidate pairs are variables with the same occurrence signature.
+    A candidate is accepted only after the swap is checked against all
+    clauses of the two variables.
+
+  Notes:
+
+    The breaking clauses remove models. They are only added when there
+    are no assumptions, user scopes, extensions, proofs or eliminated
+    variables.
+
+  --*/
+
+#pragma once
+
+#include "util/statistics.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+
+    class solver;
+
+    class symmetry_breaker {
+        solver&                  s;
+        vector<literal_vector>   m_clauses;  // irredundant clauses with sorted literals
+        vector<unsigned_vector>  m_occs;     // literal index -> clauses containing the literal
+        literal_vector           m_image;
+        int64_t                  m_budget;
+        unsigned                 m_num_breakers;
+
+        void init_clauses();
+        void add_clause(unsigned sz, literal const* lits);
+        uint64_t signature(literal l) const;
+        literal swap(literal l, bool_var x, bool_var y) const;
+        bool contains(literal l, literal_vector const& c);
+        bool is_symmetric(bool_var x, bool_var y);
+
+    public:
+        symmetry_breaker(solver& s);
+        void operator()();
+        void collect_statistics(statistics& st) const;
+    };
+}
@@ -122,7 +122,7 @@ namespace sat {
 
     typedef approx_set_tpl<literal, literal2unsigned, unsigned> literal_approx_set;
 
-    typedef approx_set_tpl<bool_var, u2u, unsigned> var_approx_set;
+    typedef approx_set_tpl<bool_var, u2u, unsigned long long> var_approx_set;
 
     class solver;
     class parallel;
@@ -0,0 +1,149 @@
+/*++
+  Copyright (c) 2020 Microsoft Corporation
+
+  Module Name:
+
+   sat_vivifier.cpp
+
+  Abstract:
+   
+    Vivification of learned clauses.
+
+  Author:
+
+    Nikolaj Bjorner 2020-06-01
+
+  --*/
+
+#include "sat/sat_vivifier.h"
+#include "sat/sat_solver.h"
+#include "util/stopwatch.h"
+
+namespace sat {
+
+    struct vivifier::report {
+        vivifier& v;
+        stopwatch m_watch;
+        report(vivifier& v): v(v) { m_watch.start(); }
+        ~report() {
+            m_watch.stop();
+            IF_VERBOSE(2, verbose_stream() << " (sat-vivify :clauses " << v.m_num_clauses 
+                       << " :shrunk " << v.m_num_shrunk 
+                       << " :elim-literals " << v.m_num_elim_lits 
+                       << m_watch << ")\n";);
+        }
+    };
+
+    struct glue_lt {
+        bool operator()(clause const* c1, clause const* c2) const { 
+            return c1->glue() < c2->glue() || (c1->glue() == c2->glue() && c1->size() < c2->size());
+        }
+    };
+
+    vivifier::vivifier(solver& s): 
+        s(s), 
+        m_max_glue(s.get_config().m_vivify_glue),
+        m_budget(s.get_config().m_vivify_limit),
+        m_num_clauses(0),
+        m_num_shrunk(0),
+        m_num_elim_lits(0) {}
+
+    void vivifier::operator()() {
+        s.propagate(false);
+        if (s.inconsistent())
+            return;
+        report _rpt(*this);
+        clause_vector& clauses = s.m_learned;
+        // process clauses from the most useful tier first.
+        std::stable_sort(clauses.begin(), clauses.end(), glue_lt());
+        unsigned j = 0, sz = clauses.size();
+        unsigned i = 0;
+        for (; i < sz && m_budget > 0 && !s.inconsistent(); ++i) {
+            clause& c = *clauses[i];
+            if (c.was_removed() || c.frozen() || c.glue() > m_max_glue) {
+                clauses[j++] = &c;
+                continue;
+            }
+            s.checkpoint();
+            if (process(c)) 
+                clauses[j++] = &c;
+        }
+        for (; i < sz; ++i) 
+            clauses[j++] = clauses[i];
+        clauses.shrink(j);
+    }
+
+    /**
+       \brief vivify c. Return false if c was removed from the clause database.
+    */
+    bool vivifier::process(clause& c) {
+        SASSERT(s.at_base_lvl());
+        for (literal l : c) {
+            if (s.value(l) == l_true) {
+                s.detach_clause(c);
+                s.del_clause(c);
+                return false;
+            }
+        }
+        ++m_num_clauses;
+        scoped_detach scoped_d(s, c);
+        unsigned sz = c.size(), j = 0;
+        unsigned trail_sz = s.m_trail.size();
+        bool shrunk = false;
+        s.push();
+        for (unsigned i = 0; i < sz; ++i) {
+            literal l = c[i];
+            lbool v = s.value(l);
+            if (v == l_false) {
+                shrunk = true;
+                continue;
+            }
+            std::swap(c[i], c[j++]);
+            if (v == l_true) {
+                shrunk = j < sz;
+                break;
+            }
+            s.assign_scoped(~l);
+            s.propagate_core(false);
+            if (s.inconsistent()) {
+                shrunk = j < sz;
+                break;
+            }
+        }
+        m_budget -= s.m_trail.size() - trail_sz;
+        s.pop(1);
+        if (!shrunk) 
+            return true;
+        return shrink(scoped_d, c, j);
+    }
+
+    bool vivifier::shrink(scoped_detach& scoped_d, clause& c, unsigned new_sz) {
+        unsigned old_sz = c.size();
+        m_num_elim_lits += old_sz - new_sz;
+        ++m_num_shrunk;
+        switch (new_sz) {
+        case 0:
+            s.set_conflict();
+            return false;
+        case 1:
+            s.assign_unit(c[0]);
+            s.propagate_core(false);
+            scoped_d.del_clause();
+            return false;
+        case 2:
+            VERIFY(s.value(c[0]) == l_undef && s.value(c[1]) == l_undef);
+            s.mk_bin_clause(c[0], c[1], true);
+            if (s.m_trail.size() > s.m_qhead) s.propagate_core(false);
+            scoped_d.del_clause();
+            return false;
+        default:
+            s.shrink(c, old_sz, new_sz);
+            return true;
+        }
+    }
+
+    void vivifier::collect_statistics(statistics& st) const {
+        st.update("sat vivify clauses", m_num_shrunk);
+        st.update("sat vivify elim literals", m_num_elim_lits);
+    }
+};
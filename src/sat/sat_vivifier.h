@@ -0,0 +1,53 @@
+/*++
+  Copyright (c) 2020 Microsoft Corporation
+
+  Module Name:
+
+   sat_vivifier.h
+
+  Abstract:
+   
+    Vivification of learned clauses.
+
+    For a learned clause l1 \/ ... \/ ln, assign ~l1, ~l2, ... in turn
+    and propagate. The clause is shortened when
+    - propagation produces a conflict after ~l1 .. ~li: keep l1 .. li.
+    - some lj is propagated to true: keep the literals assigned so far and lj.
+    - some lj is propagated to false: lj is removed.
+
+  Author:
+
+    Nikolaj Bjorner 2020-06-01
+
+  --*/
+#pragma once
+
+#include "util/statistics.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+
+    class solver;
+    class scoped_detach;
+
+    class vivifier {
+        struct report;
+
+        solver&   s;
+        unsigned  m_max_glue;
+        int64_t   m_budget;
+
+        // stats
+        unsigned  m_num_clauses;
+        unsigned  m_num_shrunk;
+        unsigned  m_num_elim_lits;
+
+        bool process(clause& c);
+        bool shrink(scoped_detach& scoped_d, clause& c, unsigned new_sz);
+
+    public:
+        vivifier(solver& s);
+        void operator()();
+        void collect_statistics(statistics& st) const;
+    };
+};
@@ -34,10 +34,20 @@ namespace sat {
        For binary clauses: we use a bit to store whether the binary clause was learned or not.
        
        Remark: there are no clause objects for binary clauses.
+
+       When SAT_PACKED_WATCH is defined (on x86-64), watched elements are
+       packed to 12 bytes instead of being padded to 16. Unaligned loads of
+       m_val1 are cheap on this architecture and the denser watch lists
+       reduce cache misses in propagate_core.
     */
 
     class extension;
 
+#if defined(SAT_PACKED_WATCH) && (defined(__x86_64__) || defined(_M_X64))
+#define SAT_PACK_WATCHED 1
+#pragma pack(push, 4)
+#endif
+
     class watched {
     public:
         enum kind {
@@ -117,6 +127,11 @@ namespace sat {
         bool operator!=(watched const & w) const { return !operator==(w); }
     };
 
+#ifdef SAT_PACK_WATCHED
+#pragma pack(pop)
+    static_assert(sizeof(watched) == sizeof(size_t) + sizeof(unsigned), "packed watch entries");
+#endif
+
     static_assert(0 <= watched::BINARY && watched::BINARY <= 3, "");
     static_assert(0 <= watched::TERNARY && watched::TERNARY <= 3, "");
     static_assert(0 <= watched::CLAUSE && watched::CLAUSE <= 3, "");
@@ -70,6 +70,8 @@ struct goal2sat::imp {
     bool                        m_default_external;
     bool                        m_xor_solver;
     bool                        m_is_lemma;
+    unsigned                    m_num_frames;
+    sat::literal_vector         m_lits;   // buffer for the arguments of xor and cardinality constraints
     
     imp(ast_manager & _m, params_ref const & p, sat::solver_core & s, atom2bool_var & map, dep2asm_map& dep2asm, bool default_external):
         m(_m),
@@ -82,7 +84,8 @@ struct goal2sat::imp {
         m_trail(m),
         m_interpreted_atoms(m),
         m_default_external(default_external),
-        m_is_lemma(false) {
+        m_is_lemma(false),
+        m_num_frames(0) {
         updt_params(p);
         m_true = sat::null_literal;
         m_aig = s.get_cut_simplifier();
@@ -420,7 +423,8 @@ struct goal2sat::imp {
             convert_iff2(t, root, sign);
             return;
         }
-        sat::literal_vector lits;
+        sat::literal_vector& lits = m_lits;
+        lits.reset();
         sat::bool_var v = m_solver.add_var(true);
         lits.push_back(sat::literal(v, true));
         convert_pb_args(num, lits);
@@ -454,6 +458,7 @@ struct goal2sat::imp {
     }
 
     typedef std::pair<unsigned, sat::literal> wliteral;
+    svector<wliteral> m_wlits;
 
     void check_unsigned(rational const& c) {
         if (!c.is_unsigned()) {
@@ -470,9 +475,9 @@ struct goal2sat::imp {
     }
 
     void convert_pb_args(app* t, svector<wliteral>& wlits) {
-        sat::literal_vector lits;
-        convert_pb_args(t->get_num_args(), lits);
-        convert_to_wlits(t, lits, wlits);        
+        m_lits.reset();
+        convert_pb_args(t->get_num_args(), m_lits);
+        convert_to_wlits(t, m_lits, wlits);        
     }
 
     void push_result(bool root, sat::literal lit, unsigned num_args) {
@@ -489,7 +494,8 @@ struct goal2sat::imp {
     void convert_pb_ge(app* t, bool root, bool sign) {
         rational k = pb.get_k(t);
         check_unsigned(k);                
-        svector<wliteral> wlits;
+        svector<wliteral>& wlits = m_wlits;
+        wlits.reset();
         convert_pb_args(t, wlits);
         if (root && m_solver.num_user_scopes() == 0) {
             m_result_stack.reset();
@@ -515,7 +521,8 @@ struct goal2sat::imp {
     void convert_pb_le(app* t, bool root, bool sign) {
         rational k = pb.get_k(t);
         k.neg();
-        svector<wliteral> wlits;
+        svector<wliteral>& wlits = m_wlits;
+        wlits.reset();
         convert_pb_args(t, wlits);
         for (wliteral& wl : wlits) {
             wl.second.neg();
@@ -546,7 +553,8 @@ struct goal2sat::imp {
     void convert_pb_eq(app* t, bool root, bool sign) {
         rational k = pb.get_k(t);
         SASSERT(k.is_unsigned());
-        svector<wliteral> wlits;
+        svector<wliteral>& wlits = m_wlits;
+        wlits.reset();
         convert_pb_args(t, wlits);
         bool base_assert = (root && !sign && m_solver.num_user_scopes() == 0);
         sat::bool_var v1 = base_assert ? sat::null_bool_var : m_solver.add_var(true);
@@ -577,7 +585,8 @@ struct goal2sat::imp {
 
     void convert_at_least_k(app* t, rational const& k, bool root, bool sign) {
         SASSERT(k.is_unsigned());
-        sat::literal_vector lits;
+        sat::literal_vector& lits = m_lits;
+        lits.reset();
         convert_pb_args(t->get_num_args(), lits);
         unsigned k2 = k.get_unsigned();
         if (root && m_solver.num_user_scopes() == 0) {
@@ -601,7 +610,8 @@ struct goal2sat::imp {
 
     void convert_at_most_k(app* t, rational const& k, bool root, bool sign) {
         SASSERT(k.is_unsigned());
-        sat::literal_vector lits;
+        sat::literal_vector& lits = m_lits;
+        lits.reset();
         convert_pb_args(t->get_num_args(), lits);
         for (sat::literal& l : lits) {
             l.neg();
@@ -627,7 +637,8 @@ struct goal2sat::imp {
 
     void convert_eq_k(app* t, rational const& k, bool root, bool sign) {
         SASSERT(k.is_unsigned());
-        sat::literal_vector lits;
+        sat::literal_vector& lits = m_lits;
+        lits.reset();
         convert_pb_args(t->get_num_args(), lits);
         sat::bool_var v1 = (root && !sign) ? sat::null_bool_var : m_solver.add_var(true);
         sat::bool_var v2 = (root && !sign) ? sat::null_bool_var : m_solver.add_var(true);
@@ -781,7 +792,8 @@ struct goal2sat::imp {
         loop:
             if (!m.inc())
                 throw tactic_exception(m.limit().get_cancel_msg());
-            if (memory::get_allocation_size() > m_max_memory)
+            // reading the allocation size takes a global lock, so check it periodically
+            if ((++m_num_frames & 0x3FF) == 0 && memory::get_allocation_size() > m_max_memory)
                 throw tactic_exception(TACTIC_MAX_MEMORY_MSG);
             frame & fr = m_frame_stack.back();
             app * t    = fr.m_t;
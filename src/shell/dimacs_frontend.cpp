@@ -48,6 +48,8 @@ static void display_statistics() {
         std::cerr.flush();
         
         g_solver->collect_statistics(g_st);
+        get_memory_statistics(g_st);
+        get_rlimit_statistics(g_solver->rlimit(), g_st);
         g_st.update("total time", ((static_cast<double>(end_time) - static_cast<double>(g_start_time)) / CLOCKS_PER_SEC));
         g_st.display_smt2(std::cout);
     }
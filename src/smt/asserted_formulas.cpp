@@ -38,10 +38,13 @@ asserted_formulas::asserted_formulas(ast_manager & m, smt_params & sp, params_re
     m_defined_names(m),
     m_static_features(m),
     m_qhead(0),
+    m_reduced_lim(0),
     m_macro_manager(m),
     m_bv_sharing(m),
     m_inconsistent(false),
     m_has_quantifiers(false),
+    m_assert_cache_trail(m),
+    m_num_assert_cache_hits(0),
     m_reduce_asserted_formulas(*this),
     m_distribute_forall(*this),
     m_pattern_inference(*this),
@@ -155,13 +158,25 @@ void asserted_formulas::assert_expr(expr * e, proof * _in_pr) {
     if (m_smt_params.m_preprocess) {
         TRACE("assert_expr_bug", tout << r << "\n";);
         set_eliminate_and(false); // do not eliminate and before nnf.
-        m_rewriter(e, r, pr);
+        expr* cached = nullptr;
         if (m.proofs_enabled()) {
+            m_rewriter(e, r, pr);
             if (e == r)
                 pr = in_pr;
             else
                 pr = m.mk_modus_ponens(in_pr, pr);
         }
+        else if (m_assert_cache.find(e, cached)) {
+            r = cached;
+            ++m_num_assert_cache_hits;
+        }
+        else {
+            // the trail keeps e alive when r no longer refers to it.
+            m_assert_cache_trail.push_back(e);
+            m_rewriter(e, r, pr);
+            m_assert_cache.insert(e, r);
+            m_assert_cache_trail.push_back(r);
+        }
         TRACE("assert_expr_bug", tout << "after...\n" << r << "\n";);
     }
 
@@ -175,6 +190,15 @@ void asserted_formulas::assert_expr(expr * e) {
     assert_expr(e, m.proofs_enabled() ? m.mk_asserted(e) : nullptr);
 }
 
+void asserted_formulas::assert_reduced(expr * e, proof * pr) {
+    SASSERT(m_reduced_lim == m_formulas.size());
+    if (inconsistent())
+        return;
+    m_has_quantifiers |= ::has_quantifiers(e);
+    m_formulas.push_back(justified_expr(m, e, pr));
+    m_reduced_lim = m_formulas.size();
+}
+
 void asserted_formulas::get_assertions(ptr_vector<expr> & result) const {
     for (justified_expr const& je : m_formulas) result.push_back(je.get_fml());
 }
@@ -188,6 +212,7 @@ void asserted_formulas::push_scope() {
     m_scopes.push_back(scope());
     scope & s = m_scopes.back();
     s.m_formulas_lim = m_formulas.size();
+    s.m_assert_cache_lim = m_assert_cache_trail.size();
     SASSERT(inconsistent() || s.m_formulas_lim == m_qhead || m.limit().get_cancel_flag());
     s.m_inconsistent_old = m_inconsistent;
     m_defined_names.push();
@@ -210,6 +235,10 @@ void asserted_formulas::pop_scope(unsigned num_scopes) {
     m_scoped_substitution.pop(num_scopes);
     m_formulas.shrink(s.m_formulas_lim);
     m_qhead    = s.m_formulas_lim;
+    m_reduced_lim = std::min(m_reduced_lim, m_qhead);
+    for (unsigned i = m_assert_cache_trail.size(); i > s.m_assert_cache_lim; i -= 2) 
+        m_assert_cache.remove(m_assert_cache_trail.get(i - 2));
+    m_assert_cache_trail.shrink(s.m_assert_cache_lim);
     m_scopes.shrink(new_lvl);
     flush_cache();
     TRACE("asserted_formulas_scopes", tout << "after pop " << num_scopes << "\n";);
@@ -218,10 +247,13 @@ void asserted_formulas::pop_scope(unsigned num_scopes) {
 void asserted_formulas::reset() {
     m_defined_names.reset();
     m_qhead = 0;
+    m_reduced_lim = 0;
     m_formulas.reset();
     m_macro_manager.reset();
     m_bv_sharing.reset();
     m_rewriter.reset();
+    m_assert_cache.reset();
+    m_assert_cache_trail.reset();
     m_inconsistent = false;
 }
 
@@ -333,6 +365,7 @@ void asserted_formulas::display_ll(std::ostream & out, ast_mark & pp_visited) co
 }
 
 void asserted_formulas::collect_statistics(statistics & st) const {
+    st.update("preprocess cache hits", m_num_assert_cache_hits);
 }
 
 
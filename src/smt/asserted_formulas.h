@@ -52,6 +52,7 @@ class asserted_formulas {
     static_features             m_static_features;
     vector<justified_expr>      m_formulas;
     unsigned                    m_qhead;
+    unsigned                    m_reduced_lim;     // formulas below this index are already simplified.
     bool                        m_elim_and;
     macro_manager               m_macro_manager;
     scoped_ptr<macro_finder>    m_macro_finder;  
@@ -60,9 +61,18 @@ class asserted_formulas {
     bool                        m_has_quantifiers;
     struct scope {
         unsigned                m_formulas_lim;
+        unsigned                m_assert_cache_lim;
         bool                    m_inconsistent_old;
     };
     svector<scope>              m_scopes;
+    // Preprocessed form of asserted expressions. The rewriter cache is
+    // flushed on every pop, so expressions that are re-asserted after a
+    // pop would otherwise be simplified again. m_assert_cache_trail holds
+    // (expression, result) pairs; entries added in a scope are removed
+    // when it is popped.
+    obj_map<expr, expr*>        m_assert_cache;
+    expr_ref_vector             m_assert_cache_trail;
+    unsigned                    m_num_assert_cache_hits;
     obj_map<expr, unsigned>     m_expr2depth;
 
     class simplify_fmls {
@@ -242,6 +252,12 @@ public:
     void setup();
     void assert_expr(expr * e, proof * in_pr);
     void assert_expr(expr * e);
+    /**
+       \brief Add a formula that was already simplified by another instance,
+       so that it is not simplified again.
+    */
+    void assert_reduced(expr * e, proof * pr);
+    unsigned get_reduced_lim() const { return m_reduced_lim; }
     void reset();
     void push_scope();
     void pop_scope(unsigned num_scopes);
@@ -23,7 +23,7 @@ Revision History:
 #include "util/map.h"
 #include "smt/smt_enode.h"
 
-class cached_var_subst {
+class cached_var_subst : public memory_cache {
     struct key {
         quantifier * m_qa;
         unsigned     m_num_bindings;
@@ -47,6 +47,7 @@ public:
     cached_var_subst(ast_manager & m);
     void operator()(quantifier * qa, unsigned num_bindings, smt::enode * const * bindings, expr_ref & result);
     void reset();
+    void shrink() override { reset(); }
 };
 
 #endif /* CACHED_VAR_SUBST_H_ */
@@ -1495,7 +1495,9 @@ private:
         int_vector    m_parent;
         heap<hp_lt>   m_heap;
         unsigned      m_num_edges;
-        dfs_state(char_vector& mark): m_heap(1024, hp_lt(m_delta, mark)), m_num_edges(0) {}
+        unsigned_vector m_visited_ts;  // m_visited_ts[v] == m_ts iff v is in m_visited
+        unsigned      m_ts;
+        dfs_state(char_vector& mark): m_heap(1024, hp_lt(m_delta, mark)), m_num_edges(0), m_ts(0) {}
 
         void re_init(unsigned sz) {
             m_delta.resize(sz, numeral(0));
@@ -1503,20 +1505,25 @@ private:
             m_visited.reset();
             m_num_edges = 0;
             m_heap.set_bounds(sz);
+            m_visited_ts.resize(sz, 0);
+            if (++m_ts == 0) {
+                m_visited_ts.fill(0);
+                m_ts = 1;
+            }
             SASSERT(m_heap.empty());
         }
 
         void add_size(unsigned n) { m_num_edges += n; }
         unsigned get_size() const { return m_num_edges; }
 
-        bool contains(dl_var v) const { 
-            // TBD can be done better using custom marking.
-            for (unsigned i = 0; i < m_visited.size(); ++i) {
-                if (v == m_visited[i]) {
-                    return true;
-                }
+        void mark_visited() {
+            for (dl_var v : m_visited) {
+                m_visited_ts[v] = m_ts;
             }
-            return false;
+        }
+
+        bool contains(dl_var v) const { 
+            return m_visited_ts[v] == m_ts;
         }
     };
 
@@ -1533,8 +1540,11 @@ private:
         return state.m_delta[n] + set_gamma(e, gamma);
     }
 
+    // The search stops after budget steps. The nodes processed until then
+    // have their final distances, so the edges found by find_subsumed remain
+    // implied, but some implied edges may be missed.
     template<bool is_fw>
-    void find_relevant(dfs_state& state, edge_id id) {
+    void find_relevant(dfs_state& state, edge_id id, unsigned budget) {
         SASSERT(state.m_visited.empty());
         SASSERT(state.m_heap.empty());
         numeral delta;
@@ -1556,13 +1566,15 @@ private:
         state.m_heap.insert(source);
         state.m_heap.insert(target);
         unsigned num_relevant = 1;
+        unsigned cost = 0;
         TRACE("diff_logic", display(tout); );
                 
-        while (!state.m_heap.empty() && num_relevant > 0) {
+        while (!state.m_heap.empty() && num_relevant > 0 && cost < budget) {
                       
             ++m_stats.m_implied_literal_cost;
 
             source = state.m_heap.erase_min();
+            cost += 1 + edges[source].size();
             source_mark = static_cast<dl_prop_search_mark>(m_mark[source]);
             SASSERT(source_mark == DL_PROP_RELEVANT || source_mark == DL_PROP_IRRELEVANT);
             state.m_visited.push_back(source);
@@ -1655,6 +1667,7 @@ private:
                 state.m_visited.resize(sz);
             }
         }
+        state.mark_visited();
 
         TRACE("diff_logic", {
                 tout << (is_fw?"is_fw":"is_bw") << ": ";
@@ -1709,10 +1722,10 @@ private:
     }
 
 public:
-    void find_subsumed(edge_id id, svector<edge_id>& subsumed) {
+    void find_subsumed(edge_id id, svector<edge_id>& subsumed, unsigned budget = UINT_MAX) {
         fix_sizes();
-        find_relevant<true>(m_fw, id);        
-        find_relevant<false>(m_bw, id);
+        find_relevant<true>(m_fw, id, budget);        
+        find_relevant<false>(m_bw, id, budget);
         find_subsumed(id, m_bw, m_fw, subsumed);
         m_fw.m_visited.reset();
         m_bw.m_visited.reset();
@@ -20,16 +20,19 @@ Revision History:
 
 namespace smt {
 
-    fingerprint::fingerprint(region & r, void * d, unsigned d_h, expr* def, unsigned n, enode * const * args):
+    fingerprint::fingerprint(void * d, unsigned d_h, expr* def, unsigned n, enode * const * args):
         m_data(d), 
-        m_data_hash(d_h),
         m_def(def),
-        m_num_args(n), 
-        m_args(nullptr) {
-        m_args = new (r) enode*[n];
+        m_data_hash(d_h),
+        m_num_args(n) {
         memcpy(m_args, args, sizeof(enode*) * n);
     }
 
+    fingerprint * fingerprint::mk(region & r, void * d, unsigned d_h, expr* def, unsigned n, enode * const * args) {
+        void * mem = r.allocate(get_obj_size(n));
+        return new (mem) fingerprint(d, d_h, def, n, args);
+    }
+
     bool fingerprint_set::fingerprint_eq_proc::operator()(fingerprint const * f1, fingerprint const * f2) const {
         if (f1->get_data() != f2->get_data()) 
             return false;
@@ -43,13 +46,8 @@ namespace smt {
     }
 
     fingerprint * fingerprint_set::mk_dummy(void * data, unsigned data_hash, unsigned num_args, enode * const * args) {
-        m_tmp.reset();
-        m_tmp.append(num_args, args);
-        m_dummy.m_data      = data;
-        m_dummy.m_data_hash = data_hash;
-        m_dummy.m_num_args  = num_args;
-        m_dummy.m_args      = m_tmp.c_ptr();
-        return &m_dummy;
+        m_tmp.reserve(fingerprint::get_obj_size(num_args));
+        return new (m_tmp.c_ptr()) fingerprint(data, data_hash, nullptr, num_args, args);
     }
 
     std::ostream& operator<<(std::ostream& out, fingerprint const& f) {
@@ -63,6 +61,8 @@ namespace smt {
 
     
     fingerprint * fingerprint_set::insert(void * data, unsigned data_hash, unsigned num_args, enode * const * args, expr* def) {
+        if (is_full())
+            return nullptr;
         fingerprint * d = mk_dummy(data, data_hash, num_args, args);
         if (m_set.contains(d)) 
             return nullptr;
@@ -78,7 +78,7 @@ namespace smt {
             return nullptr;
         }
         TRACE("fingerprint_bug", tout << "2) inserting: " << *d;);
-        fingerprint * f = new (m_region) fingerprint(m_region, data, data_hash, def, num_args, d->m_args);
+        fingerprint * f = fingerprint::mk(m_region, data, data_hash, def, num_args, d->m_args);
         m_fingerprints.push_back(f);
         m_defs.push_back(def);
         m_set.insert(f);
@@ -24,23 +24,28 @@ Revision History:
 
 namespace smt {
 
+    /**
+       \brief A fingerprint and its arguments are stored in a single block of memory.
+    */
     class fingerprint {
     protected:
         void *        m_data;
-        unsigned      m_data_hash;
         expr*         m_def;
+        unsigned      m_data_hash;
         unsigned      m_num_args;
-        enode * *     m_args;
+        enode *       m_args[0];
 
         friend class fingerprint_set;
-        fingerprint() {}
+        fingerprint(void * d, unsigned d_hash, expr* def, unsigned n, enode * const * args);
     public:
-        fingerprint(region & r, void * d, unsigned d_hash, expr* def, unsigned n, enode * const * args);
+        static unsigned get_obj_size(unsigned n) { return sizeof(fingerprint) + n * sizeof(enode *); }
+        static fingerprint * mk(region & r, void * d, unsigned d_hash, expr* def, unsigned n, enode * const * args);
         void * get_data() const { return m_data; }
         expr * get_def() const { return m_def; }
         unsigned get_data_hash() const { return m_data_hash; }
         unsigned get_num_args() const { return m_num_args;  }
         enode * const * get_args() const { return m_args; }
+        enode * * get_args() { return m_args; }
         enode * get_arg(unsigned idx) const { SASSERT(idx < m_num_args); return m_args[idx]; }
         enode * const * begin() const { return m_args; }
         enode * const * end() const { return begin() + get_num_args(); }
@@ -68,15 +73,21 @@ namespace smt {
         ptr_vector<fingerprint>  m_fingerprints;
         expr_ref_vector          m_defs;
         unsigned_vector          m_scopes;
-        ptr_vector<enode>        m_tmp;
-        fingerprint              m_dummy;
+        svector<char>            m_tmp;      // storage for the fingerprint used for lookups
+        unsigned                 m_max_size;
 
         fingerprint * mk_dummy(void * data, unsigned data_hash, unsigned num_args, enode * const * args);
 
     public:
-        fingerprint_set(ast_manager& m, region & r): m_region(r), m_defs(m) {}
+        fingerprint_set(ast_manager& m, region & r): m_region(r), m_defs(m), m_max_size(UINT_MAX) {}
         fingerprint * insert(void * data, unsigned data_hash, unsigned num_args, enode * const * args, expr* def);
         unsigned size() const { return m_fingerprints.size(); }
+        /**
+           \brief Bound the number of fingerprints. insert returns nullptr once the bound is 
+           reached, so that no further instances are created.
+        */
+        void set_max_size(unsigned n) { m_max_size = n; }
+        bool is_full() const { return size() >= m_max_size; }
         bool contains(void * data, unsigned data_hash, unsigned num_args, enode * const * args);
         void reset();
         void push_scope();
@@ -17,8 +17,11 @@ Revision History:
 
 --*/
 #include <algorithm>
+#include <mutex>
 
 #include "util/pool.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
 #include "util/trail.h"
 #include "util/stopwatch.h"
 #include "ast/ast_pp.h"
@@ -55,6 +58,13 @@ using namespace smt;
 
 #define IS_CGR_SUPPORT true
 
+// Dispatch the instructions of the code tree interpreter using computed gotos
+// (a gcc/clang extension) instead of jumping back to the switch statement.
+// Each instruction then ends with its own indirect jump, which is easier to predict.
+#if defined(__GNUC__) && !defined(_TRACE) && !defined(_PROFILE_MAM)
+#define _MAM_COMPUTED_GOTO
+#endif
+
 namespace {
     // ------------------------------------
     //
@@ -398,6 +408,7 @@ namespace {
         func_decl *                m_root_lbl;
         unsigned                   m_num_args; //!< we need this information to avoid the nary *,+ crash bug
         bool                       m_filter_candidates;
+        bool                       m_has_get_cgr; //!< true if the tree looks up congruence roots (not thread safe).
         unsigned                   m_num_regs;
         unsigned                   m_num_choices;
         instruction *              m_root;
@@ -487,6 +498,7 @@ namespace {
             m_root_lbl(lbl),
             m_num_args(num_args),
             m_filter_candidates(filter_candidates),
+            m_has_get_cgr(false),
             m_num_regs(num_args + 1),
             m_num_choices(0),
             m_root(nullptr) {
@@ -537,6 +549,10 @@ namespace {
             return m_filter_candidates;
         }
 
+        bool has_get_cgr() const {
+            return m_has_get_cgr;
+        }
+
         const instruction * get_root() const {
             return m_root;
         }
@@ -1096,6 +1112,7 @@ namespace {
             unsigned oreg        = m_tree->m_num_regs;
             m_tree->m_num_regs  += 1;
             m_seq.push_back(m_ct_manager.mk_get_cgr(n->get_decl(), oreg, num_args, iregs.c_ptr()));
+            m_tree->m_has_get_cgr = true;
             return oreg;
         }
 
@@ -1880,6 +1897,20 @@ namespace {
 
         pool<enode_vector>  m_pool;
 
+        struct delayed_match {
+            quantifier *    m_qa;
+            app *           m_pat;
+            unsigned        m_num_bindings;
+            unsigned        m_bindings_idx; // position of the bindings in m_delayed_bindings
+            unsigned        m_max_generation;
+            unsigned        m_min_top_generation;
+            unsigned        m_max_top_generation;
+        };
+
+        bool                   m_delay_matches;
+        svector<delayed_match> m_delayed;
+        enode_vector           m_delayed_bindings;
+
         enode_vector * mk_enode_vector() {
             enode_vector * r = m_pool.mk();
             r->reset();
@@ -2007,7 +2038,8 @@ namespace {
             m_context(ctx),
             m(ctx.get_manager()),
             m_mam(ma),
-            m_use_filters(use_filters) {
+            m_use_filters(use_filters),
+            m_delay_matches(false) {
             m_args.resize(INIT_ARGS_SIZE);
         }
 
@@ -2029,7 +2061,7 @@ namespace {
                 for (enode* app : t->get_candidates()) {
                     TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_owner(), m) << "\n";);
                     if (!app->is_marked() && app->is_cgr()) {
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
+                        if (limits_exceeded() || !execute_core(t, app))
                             return;
                         app->set_mark();
                     }
@@ -2044,16 +2076,80 @@ namespace {
                     TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_owner(), m) << "\n";);
                     if (app->is_cgr()) {
                         TRACE("trigger_bug", tout << "is_cgr\n";);
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
+                        if (limits_exceeded() || !execute_core(t, app))
                             return;
                     }
                 }
             }
         }
 
+        /**
+           \brief Execute \c t on a precomputed list of candidates.
+           Used by the parallel matcher: the candidates are already filtered and
+           with delayed matches the interpreter only reads the shared state of the context.
+        */
+        void execute(code_tree * t, enode_vector const & candidates) {
+            init(t);
+            for (enode * app : candidates) {
+                if (limits_exceeded() || !execute_core(t, app))
+                    return;
+            }
+        }
+
+        /**
+           \brief When delayed matches are enabled, matches are buffered instead of being
+           passed to the mam. They are added later using add_delayed_instances.
+        */
+        void set_delay_matches(bool f) { m_delay_matches = f; }
+
+        unsigned get_num_delayed() const { return m_delayed.size(); }
+
+        void add_delayed_instances(unsigned begin, unsigned end) {
+            vector<std::tuple<enode *, enode *>> used_enodes;
+            for (unsigned i = begin; i < end; ++i) {
+                delayed_match const & d = m_delayed[i];
+                m_context.add_instance(d.m_qa, d.m_pat, d.m_num_bindings, m_delayed_bindings.c_ptr() + d.m_bindings_idx, nullptr,
+                                       d.m_max_generation, d.m_min_top_generation, d.m_max_top_generation, used_enodes);
+            }
+        }
+
+        void reset_delayed() {
+            m_delayed.reset();
+            m_delayed_bindings.reset();
+        }
+
         // init(t) must be invoked before execute_core
         bool execute_core(code_tree * t, enode * n);
 
+    private:
+        // context::get_cancel_flag and resource_limits_exceeded update counters of the
+        // context, delayed matches run outside of the main thread and only poll the limit.
+        bool canceled() {
+            return m_delay_matches ? m.limit().get_cancel_flag() : m_context.get_cancel_flag();
+        }
+
+        bool limits_exceeded() {
+            return m_delay_matches ? m.limit().get_cancel_flag() : m_context.resource_limits_exceeded();
+        }
+
+        void on_match(quantifier * qa, app * pat, unsigned num_bindings) {
+            if (!m_delay_matches) {
+                m_mam.on_match(qa, pat, num_bindings, m_bindings.begin(), m_max_generation, m_used_enodes);
+                return;
+            }
+            delayed_match d;
+            d.m_qa = qa;
+            d.m_pat = pat;
+            d.m_num_bindings = num_bindings;
+            d.m_bindings_idx = m_delayed_bindings.size();
+            d.m_max_generation = m_max_generation;
+            get_min_max_top_generation(d.m_min_top_generation, d.m_max_top_generation);
+            m_delayed_bindings.append(num_bindings, m_bindings.begin());
+            m_delayed.push_back(d);
+        }
+
+    public:
+
         // Return the min, max generation of the enodes in m_pattern_instances.
 
         void get_min_max_top_generation(unsigned& min, unsigned& max) {
@@ -2319,6 +2415,56 @@ namespace {
         m_top            = 0;
 
 
+#ifdef _MAM_COMPUTED_GOTO
+        // indexed by opcode
+        static void * const s_dispatch[] = {
+            &&lbl_INIT1,
+            &&lbl_INIT2,
+            &&lbl_INIT3,
+            &&lbl_INIT4,
+            &&lbl_INIT5,
+            &&lbl_INIT6,
+            &&lbl_INITN,
+            &&lbl_BIND1,
+            &&lbl_BIND2,
+            &&lbl_BIND3,
+            &&lbl_BIND4,
+            &&lbl_BIND5,
+            &&lbl_BIND6,
+            &&lbl_BINDN,
+            &&lbl_YIELD1,
+            &&lbl_YIELD2,
+            &&lbl_YIELD3,
+            &&lbl_YIELD4,
+            &&lbl_YIELD5,
+            &&lbl_YIELD6,
+            &&lbl_YIELDN,
+            &&lbl_COMPARE,
+            &&lbl_CHECK,
+            &&lbl_FILTER,
+            &&lbl_CFILTER,
+            &&lbl_PFILTER,
+            &&lbl_CHOOSE,
+            &&lbl_NOOP,
+            &&lbl_CONTINUE,
+            &&lbl_GET_ENODE,
+            &&lbl_GET_CGR1,
+            &&lbl_GET_CGR2,
+            &&lbl_GET_CGR3,
+            &&lbl_GET_CGR4,
+            &&lbl_GET_CGR5,
+            &&lbl_GET_CGR6,
+            &&lbl_GET_CGRN,
+            &&lbl_IS_CGR
+        };
+        static_assert(sizeof(s_dispatch) / sizeof(s_dispatch[0]) == IS_CGR + 1, "dispatch table must cover all opcodes");
+#define MAM_LABEL(op) lbl_##op:
+#define MAM_DISPATCH() goto *s_dispatch[m_pc->m_opcode]
+#else
+#define MAM_LABEL(op)
+#define MAM_DISPATCH() goto main_loop
+#endif
+
     main_loop:
 
         TRACE("mam_int", display_pc_info(tout););
@@ -2326,24 +2472,24 @@ namespace {
         const_cast<instruction*>(m_pc)->m_counter++;
 #endif
         switch (m_pc->m_opcode) {
-        case INIT1:
+        case INIT1: MAM_LABEL(INIT1)
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 1)
                 goto backtrack;
             m_registers[1] = m_app->get_arg(0);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case INIT2:
+        case INIT2: MAM_LABEL(INIT2)
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 2)
                 goto backtrack;
             m_registers[1] = m_app->get_arg(0);
             m_registers[2] = m_app->get_arg(1);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case INIT3:
+        case INIT3: MAM_LABEL(INIT3)
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 3)
                 goto backtrack;
@@ -2351,9 +2497,9 @@ namespace {
             m_registers[2] = m_app->get_arg(1);
             m_registers[3] = m_app->get_arg(2);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case INIT4:
+        case INIT4: MAM_LABEL(INIT4)
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 4)
                 goto backtrack;
@@ -2362,9 +2508,9 @@ namespace {
             m_registers[3] = m_app->get_arg(2);
             m_registers[4] = m_app->get_arg(3);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case INIT5:
+        case INIT5: MAM_LABEL(INIT5)
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 5)
                 goto backtrack;
@@ -2374,9 +2520,9 @@ namespace {
             m_registers[4] = m_app->get_arg(3);
             m_registers[5] = m_app->get_arg(4);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case INIT6:
+        case INIT6: MAM_LABEL(INIT6)
             m_app          = m_registers[0];
             if (m_app->get_num_args() != 6)
                 goto backtrack;
@@ -2387,9 +2533,9 @@ namespace {
             m_registers[5] = m_app->get_arg(4);
             m_registers[6] = m_app->get_arg(5);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case INITN:
+        case INITN: MAM_LABEL(INITN)
             m_app      = m_registers[0];
             m_num_args = m_app->get_num_args();
             if (m_num_args != static_cast<const initn *>(m_pc)->m_num_args)
@@ -2397,9 +2543,9 @@ namespace {
             for (unsigned i = 0; i < m_num_args; i++)
                 m_registers[i+1] = m_app->get_arg(i);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case COMPARE:
+        case COMPARE: MAM_LABEL(COMPARE)
             m_n1 = m_registers[static_cast<const compare *>(m_pc)->m_reg1];
             m_n2 = m_registers[static_cast<const compare *>(m_pc)->m_reg2];
             SASSERT(m_n1 != 0);
@@ -2414,9 +2560,9 @@ namespace {
             }
 
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case CHECK:
+        case CHECK: MAM_LABEL(CHECK)
             m_n1 = m_registers[static_cast<const check *>(m_pc)->m_reg];
             m_n2 = static_cast<const check *>(m_pc)->m_enode;
             SASSERT(m_n1 != 0);
@@ -2430,40 +2576,40 @@ namespace {
             }
 
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
             /* CFILTER AND FILTER are handled differently by the compiler
                The compiler will never merge two CFILTERs with different m_lbl_set fields.
                Essentially, CFILTER is used to combine CHECK statements, and FILTER for BIND
             */
-        case CFILTER:
-        case FILTER:
+        case CFILTER: MAM_LABEL(CFILTER)
+        case FILTER: MAM_LABEL(FILTER)
             m_n1 = m_registers[static_cast<const filter *>(m_pc)->m_reg]->get_root();
             if (static_cast<const filter *>(m_pc)->m_lbl_set.empty_intersection(m_n1->get_lbls()))
                 goto backtrack;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case PFILTER:
+        case PFILTER: MAM_LABEL(PFILTER)
             m_n1 = m_registers[static_cast<const filter *>(m_pc)->m_reg]->get_root();
             if (static_cast<const filter *>(m_pc)->m_lbl_set.empty_intersection(m_n1->get_plbls()))
                 goto backtrack;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case CHOOSE:
+        case CHOOSE: MAM_LABEL(CHOOSE)
             m_backtrack_stack[m_top].m_instr                = m_pc;
             m_backtrack_stack[m_top].m_old_max_generation   = m_max_generation;
             m_backtrack_stack[m_top].m_old_used_enodes_size = m_used_enodes.size();
             m_top++;
             m_pc = m_pc->m_next;
-            goto main_loop;
-        case NOOP:
+            MAM_DISPATCH();
+        case NOOP: MAM_LABEL(NOOP)
             SASSERT(static_cast<const choose *>(m_pc)->m_alt == 0);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case BIND1:
+        case BIND1: MAM_LABEL(BIND1)
 #define BIND_COMMON()                                                                                                   \
                  m_n1   = m_registers[static_cast<const bind *>(m_pc)->m_ireg];                                         \
                  SASSERT(m_n1 != 0);                                                                                    \
@@ -2483,33 +2629,33 @@ namespace {
             BIND_COMMON();
             m_registers[m_oreg] = m_app->get_arg(0);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case BIND2:
+        case BIND2: MAM_LABEL(BIND2)
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case BIND3:
+        case BIND3: MAM_LABEL(BIND3)
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case BIND4:
+        case BIND4: MAM_LABEL(BIND4)
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case BIND5:
+        case BIND5: MAM_LABEL(BIND5)
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
@@ -2517,9 +2663,9 @@ namespace {
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case BIND6:
+        case BIND6: MAM_LABEL(BIND6)
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
@@ -2528,45 +2674,43 @@ namespace {
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_registers[m_oreg+5] = m_app->get_arg(5);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case BINDN:
+        case BINDN: MAM_LABEL(BINDN)
             BIND_COMMON();
             m_num_args = static_cast<const bind *>(m_pc)->m_num_args;
             for (unsigned i = 0; i < m_num_args; i++)
                 m_registers[m_oreg+i] = m_app->get_arg(i);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case YIELD1:
+        case YIELD1: MAM_LABEL(YIELD1)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
 #define ON_MATCH(NUM)                                                   \
             m_max_generation = std::max(m_max_generation, get_max_generation(NUM, m_bindings.begin())); \
-            if (m_context.get_cancel_flag()) {                          \
+            if (canceled()) {                                           \
                 return false;                                           \
             }                                                           \
-            m_mam.on_match(static_cast<const yield *>(m_pc)->m_qa,                                      \
-                           static_cast<const yield *>(m_pc)->m_pat,                                     \
-                           NUM,                                                                         \
-                           m_bindings.begin(),                                                          \
-                           m_max_generation, m_used_enodes)
+            on_match(static_cast<const yield *>(m_pc)->m_qa,            \
+                     static_cast<const yield *>(m_pc)->m_pat,           \
+                     NUM)
             ON_MATCH(1);
             goto backtrack;
 
-        case YIELD2:
+        case YIELD2: MAM_LABEL(YIELD2)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[1]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
             ON_MATCH(2);
             goto backtrack;
 
-        case YIELD3:
+        case YIELD3: MAM_LABEL(YIELD3)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[2]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[1]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
             ON_MATCH(3);
             goto backtrack;
 
-        case YIELD4:
+        case YIELD4: MAM_LABEL(YIELD4)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[3]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[2]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[1]];
@@ -2574,7 +2718,7 @@ namespace {
             ON_MATCH(4);
             goto backtrack;
 
-        case YIELD5:
+        case YIELD5: MAM_LABEL(YIELD5)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[4]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[3]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[2]];
@@ -2583,7 +2727,7 @@ namespace {
             ON_MATCH(5);
             goto backtrack;
 
-        case YIELD6:
+        case YIELD6: MAM_LABEL(YIELD6)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[5]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[4]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[3]];
@@ -2593,19 +2737,19 @@ namespace {
             ON_MATCH(6);
             goto backtrack;
 
-        case YIELDN:
+        case YIELDN: MAM_LABEL(YIELDN)
             m_num_args = static_cast<const yield *>(m_pc)->m_num_bindings;
             for (unsigned i = 0; i < m_num_args; i++)
                 m_bindings[i] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[m_num_args - i - 1]];
             ON_MATCH(m_num_args);
             goto backtrack;
 
-        case GET_ENODE:
+        case GET_ENODE: MAM_LABEL(GET_ENODE)
             m_registers[static_cast<const get_enode_instr *>(m_pc)->m_oreg] = static_cast<const get_enode_instr *>(m_pc)->m_enode;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case GET_CGR1:
+        case GET_CGR1: MAM_LABEL(GET_CGR1)
 #define GET_CGR_COMMON()                                                                                                                                                \
             m_n1 = m_context.get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.c_ptr());              \
             if (m_n1 == 0 || !m_context.is_relevant(m_n1))                                                                                                              \
@@ -2618,7 +2762,7 @@ namespace {
             }                                                                                                                                                           \
             m_registers[static_cast<const get_cgr *>(m_pc)->m_oreg] = m_n1;                                                                                             \
             m_pc = m_pc->m_next;                                                                                                                                        \
-            goto main_loop;
+            MAM_DISPATCH();
 
 #define SET_VAR(IDX)                                                    \
             m_args[IDX] = m_registers[static_cast<const get_cgr *>(m_pc)->m_iregs[IDX]]; \
@@ -2632,25 +2776,25 @@ namespace {
             SET_VAR(0);
             GET_CGR_COMMON();
 
-        case GET_CGR2:
+        case GET_CGR2: MAM_LABEL(GET_CGR2)
             SET_VAR(0);
             SET_VAR(1);
             GET_CGR_COMMON();
 
-        case GET_CGR3:
+        case GET_CGR3: MAM_LABEL(GET_CGR3)
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
             GET_CGR_COMMON();
 
-        case GET_CGR4:
+        case GET_CGR4: MAM_LABEL(GET_CGR4)
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
             SET_VAR(3);
             GET_CGR_COMMON();
 
-        case GET_CGR5:
+        case GET_CGR5: MAM_LABEL(GET_CGR5)
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
@@ -2658,7 +2802,7 @@ namespace {
             SET_VAR(4);
             GET_CGR_COMMON();
 
-        case GET_CGR6:
+        case GET_CGR6: MAM_LABEL(GET_CGR6)
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
@@ -2667,20 +2811,20 @@ namespace {
             SET_VAR(5);
             GET_CGR_COMMON();
 
-        case GET_CGRN:
+        case GET_CGRN: MAM_LABEL(GET_CGRN)
             m_num_args = static_cast<const get_cgr *>(m_pc)->m_num_args;
             m_args.reserve(m_num_args, 0);
             for (unsigned i = 0; i < m_num_args; i++)
                 m_args[i] = m_registers[static_cast<const get_cgr *>(m_pc)->m_iregs[i]];
             GET_CGR_COMMON();
 
-        case IS_CGR:
+        case IS_CGR: MAM_LABEL(IS_CGR)
             if (!exec_is_cgr(static_cast<const is_cgr *>(m_pc)))
                 goto backtrack;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
-        case CONTINUE:
+        case CONTINUE: MAM_LABEL(CONTINUE)
             m_num_args = static_cast<const cont *>(m_pc)->m_num_args;
             m_oreg     = static_cast<const cont *>(m_pc)->m_oreg;
             m_app = init_continue(static_cast<const cont *>(m_pc), m_num_args);
@@ -2691,7 +2835,7 @@ namespace {
             for (unsigned i = 0; i < m_num_args; i++)
                 m_registers[m_oreg+i] = m_app->get_arg(i);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
         }
 
@@ -2718,7 +2862,7 @@ namespace {
 
         if (since_last_check++ > 100) {
             since_last_check = 0;
-            if (m_context.resource_limits_exceeded()) {
+            if (limits_exceeded()) {
                 // Soft timeout...
                 // Cleanup before exiting
                 while (m_top != 0) {
@@ -2740,7 +2884,7 @@ namespace {
             TRACE("mam_int", tout << "alt: " << m_pc << "\n";);
             SASSERT(m_pc != 0);
             m_top--;
-            goto main_loop;
+            MAM_DISPATCH();
         case BIND1:
 #define BBIND_COMMON() m_b   = static_cast<const bind*>(bp.m_instr);                                                            \
                        m_n1  = m_registers[m_b->m_ireg];                                                                        \
@@ -2756,14 +2900,14 @@ namespace {
             BBIND_COMMON();
             m_registers[m_oreg] = m_app->get_arg(0);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
         case BIND2:
             BBIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_pc = m_b->m_next;
-                goto main_loop;
+                MAM_DISPATCH();
 
         case BIND3:
             BBIND_COMMON();
@@ -2771,7 +2915,7 @@ namespace {
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
         case BIND4:
             BBIND_COMMON();
@@ -2780,7 +2924,7 @@ namespace {
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
         case BIND5:
             BBIND_COMMON();
@@ -2790,7 +2934,7 @@ namespace {
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
         case BIND6:
             BBIND_COMMON();
@@ -2801,7 +2945,7 @@ namespace {
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_registers[m_oreg+5] = m_app->get_arg(5);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
         case BINDN:
             BBIND_COMMON();
@@ -2809,7 +2953,7 @@ namespace {
             for (unsigned i = 0; i < m_num_args; i++)
                 m_registers[m_oreg+i] = m_app->get_arg(i);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_DISPATCH();
 
         case CONTINUE:
             ++bp.m_it;
@@ -2836,7 +2980,7 @@ namespace {
                     for (unsigned i = 0; i < m_num_args; i++)
                         m_registers[m_oreg+i] = m_app->get_arg(i);
                     m_pc = c->m_next;
-                    goto main_loop;
+                    MAM_DISPATCH();
                 }
             }
             // continue failed
@@ -2851,6 +2995,9 @@ namespace {
         return false;
     } // end of execute_core
 
+#undef MAM_LABEL
+#undef MAM_DISPATCH
+
 #if 0
     void display_trees(std::ostream & out, const ptr_vector<code_tree> & trees) {
         unsigned lbl = 0;
@@ -3101,6 +3248,8 @@ namespace {
         code_tree_manager           m_ct_manager;
         compiler                    m_compiler;
         interpreter                 m_interpreter;
+        scoped_ptr_vector<interpreter> m_workers;      // interpreters used by parallel matching
+        vector<enode_vector>        m_worker_candidates;
         code_tree_map               m_trees;
 
         ptr_vector<code_tree>       m_tmp_trees;
@@ -3892,8 +4041,101 @@ namespace {
             }
         }
 
+#define PARALLEL_MATCH_THRESHOLD 1024
+
+        /**
+           \brief Return true if the trees in m_to_match can be matched in parallel.
+           GET_CGR instructions access the congruence table of the context, and
+           logging requires the equalities used by each match, so trees using them
+           are matched sequentially.
+        */
+        bool use_parallel_match() {
+#ifdef SINGLE_THREAD
+            return false;
+#else
+            if (m_context.get_fparams().m_qi_match_threads <= 1 || m.has_trace_stream() || m_to_match.size() < 2)
+                return false;
+            unsigned num_candidates = 0;
+            for (code_tree * t : m_to_match) {
+                if (t->has_get_cgr())
+                    return false;
+                num_candidates += t->get_candidates().size();
+            }
+            return num_candidates >= PARALLEL_MATCH_THRESHOLD;
+#endif
+        }
+
+        /**
+           \brief Match the trees in m_to_match using several interpreters.
+           Workers only read the E-graph and buffer their matches, which are then
+           added in the order of m_to_match, so the instances produced do not depend
+           on the scheduling of the threads.
+        */
+        void parallel_match() {
+            unsigned num_trees   = m_to_match.size();
+            unsigned num_workers = std::min(num_trees, m_context.get_fparams().m_qi_match_threads);
+            m_worker_candidates.reset();
+            m_worker_candidates.resize(num_trees);
+            for (unsigned i = 0; i < num_trees; ++i) {
+                code_tree * t = m_to_match[i];
+                enode_vector & cands = m_worker_candidates[i];
+                for (enode * app : t->get_candidates()) {
+                    if (!app->is_cgr() || (t->filter_candidates() && app->is_marked()))
+                        continue;
+                    if (t->filter_candidates())
+                        app->set_mark();
+                    cands.push_back(app);
+                }
+                if (t->filter_candidates())
+                    for (enode * app : cands)
+                        app->unset_mark();
+            }
+            while (m_workers.size() < num_workers)
+                m_workers.push_back(alloc(interpreter, m_context, *this, m_use_filters));
+            for (unsigned w = 0; w < num_workers; ++w) {
+                m_workers[w]->set_delay_matches(true);
+                m_workers[w]->reset_delayed();
+            }
+            // tree i is matched by worker i % num_workers, delayed[i] is the end of its matches.
+            unsigned_vector delayed(num_trees, 0u);
+            std::mutex mux;
+            bool has_exception = false;
+            std::string ex_msg;
+            auto worker_thread = [&](unsigned w) {
+                try {
+                    interpreter & intp = *m_workers[w];
+                    for (unsigned i = w; i < num_trees; i += num_workers) {
+                        intp.execute(m_to_match[i], m_worker_candidates[i]);
+                        delayed[i] = intp.get_num_delayed();
+                    }
+                }
+                catch (z3_exception & ex) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    has_exception = true;
+                    ex_msg = ex.msg();
+                }
+            };
+            thread_pool::run(num_workers, worker_thread);
+            if (has_exception)
+                throw default_exception(std::move(ex_msg));
+            for (unsigned i = 0; i < num_trees; ++i) {
+                unsigned begin = i < num_workers ? 0 : delayed[i - num_workers];
+                m_workers[i % num_workers]->add_delayed_instances(begin, delayed[i]);
+            }
+            for (unsigned w = 0; w < num_workers; ++w) {
+                m_workers[w]->reset_delayed();
+                m_workers[w]->set_delay_matches(false);
+            }
+        }
+
         void match() override {
             TRACE("trigger_bug", tout << "match\n"; display(tout););
+            if (use_parallel_match()) {
+                parallel_match();
+                for (code_tree * t : m_to_match)
+                    t->reset_candidates();
+                m_to_match.reset();
+            }
             for (code_tree* t : m_to_match) {
                 SASSERT(t->has_candidates());
                 m_interpreter.execute(t);
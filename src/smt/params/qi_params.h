@@ -41,6 +41,8 @@ struct qi_params {
     bool               m_qi_lazy_quick_checker;
     bool               m_qi_promote_unsat;
     unsigned           m_qi_max_instances;
+    unsigned           m_qi_max_fingerprints;
+    unsigned           m_qi_match_threads;
     bool               m_qi_lazy_instantiation;
     bool               m_qi_conservative_final_check;
 
@@ -90,6 +92,8 @@ struct qi_params {
         m_qi_lazy_quick_checker(true),
         m_qi_promote_unsat(true),
         m_qi_max_instances(UINT_MAX),
+        m_qi_max_fingerprints(UINT_MAX),
+        m_qi_match_threads(1),
         m_qi_lazy_instantiation(false),
         m_qi_conservative_final_check(false),
         m_mbqi(true), // enabled by default
@@ -27,12 +27,21 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_relevancy_lvl = p.relevancy();
     m_ematching   = p.ematching();
     m_induction   = p.induction();
+    m_fp_lazy_encoding = p.fp_lazy_encoding();
     m_clause_proof = p.clause_proof();
     m_phase_selection = static_cast<phase_selection>(p.phase_selection());
-    if (m_phase_selection > PS_THEORY) throw default_exception("illegal phase selection numeral");
+    if (m_phase_selection > PS_TARGET) throw default_exception("illegal phase selection numeral");
+    m_phase_persist = p.phase_persist();
+    m_phase_timing = p.phase_timing();
+    m_rephase_base = p.rephase_base();
     m_restart_strategy = static_cast<restart_strategy>(p.restart_strategy());
-    if (m_restart_strategy > RS_ARITHMETIC) throw default_exception("illegal restart strategy numeral");
+    if (m_restart_strategy > RS_EMA) throw default_exception("illegal restart strategy numeral");
     m_restart_factor = p.restart_factor();
+    m_restart_margin = p.restart_margin();
+    m_restart_blocking = p.restart_blocking();
+    m_lemma_gc_core_glue = p.lemma_gc_core_glue();
+    m_lemma_gc_tier2_glue = p.lemma_gc_tier2_glue();
+    m_lemma_gc_max_memory = p.lemma_gc_max_memory();
     m_case_split_strategy = static_cast<case_split_strategy>(p.case_split());
     m_theory_case_split = p.theory_case_split();
     m_theory_aware_branching = p.theory_aware_branching();
@@ -43,6 +52,8 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_restart_max   = p.restart_max();
     m_threads       = p.threads();
     m_threads_max_conflicts  = p.threads_max_conflicts();
+    m_threads_int_split = p.threads_int_split();
+    m_solve_components = p.solve_components();
     m_core_validate = p.core_validate();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
@@ -103,16 +114,22 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_phase_selection);
     DISPLAY_PARAM(m_phase_caching_on);
     DISPLAY_PARAM(m_phase_caching_off);
+    DISPLAY_PARAM(m_phase_persist);
+    DISPLAY_PARAM(m_phase_timing);
+    DISPLAY_PARAM(m_rephase_base);
     DISPLAY_PARAM(m_minimize_lemmas);
     DISPLAY_PARAM(m_max_conflicts);
     DISPLAY_PARAM(m_threads);
     DISPLAY_PARAM(m_threads_max_conflicts);
+    DISPLAY_PARAM(m_threads_int_split);
+    DISPLAY_PARAM(m_solve_components);
     DISPLAY_PARAM(m_simplify_clauses);
     DISPLAY_PARAM(m_tick);
     DISPLAY_PARAM(m_display_features);
     DISPLAY_PARAM(m_new_core2th_eq);
     DISPLAY_PARAM(m_ematching);
     DISPLAY_PARAM(m_induction);
+    DISPLAY_PARAM(m_fp_lazy_encoding);
     DISPLAY_PARAM(m_clause_proof);
 
     DISPLAY_PARAM(m_case_split_strategy);
@@ -127,6 +144,8 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_restart_strategy);
     DISPLAY_PARAM(m_restart_initial);
     DISPLAY_PARAM(m_restart_factor);
+    DISPLAY_PARAM(m_restart_margin);
+    DISPLAY_PARAM(m_restart_blocking);
     DISPLAY_PARAM(m_restart_adaptive);
     DISPLAY_PARAM(m_agility_factor);
     DISPLAY_PARAM(m_restart_agility_threshold);
@@ -136,6 +155,9 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_recent_lemmas_size);
     DISPLAY_PARAM(m_lemma_gc_initial);
     DISPLAY_PARAM(m_lemma_gc_factor);
+    DISPLAY_PARAM(m_lemma_gc_core_glue);
+    DISPLAY_PARAM(m_lemma_gc_tier2_glue);
+    DISPLAY_PARAM(m_lemma_gc_max_memory);
     DISPLAY_PARAM(m_new_old_ratio);
     DISPLAY_PARAM(m_new_clause_activity);
     DISPLAY_PARAM(m_old_clause_activity);
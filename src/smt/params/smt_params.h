@@ -40,7 +40,8 @@ enum phase_selection {
     PS_CACHING_CONSERVATIVE2, // similar to the previous one, but alternated default config from time to time.
     PS_RANDOM,
     PS_OCCURRENCE,
-    PS_THEORY
+    PS_THEORY,
+    PS_TARGET
 };
 
 enum restart_strategy {
@@ -48,7 +49,8 @@ enum restart_strategy {
     RS_IN_OUT_GEOMETRIC,
     RS_LUBY,
     RS_FIXED,
-    RS_ARITHMETIC
+    RS_ARITHMETIC,
+    RS_EMA
 };
 
 enum lemma_gc_strategy {
@@ -71,7 +73,8 @@ enum case_split_strategy {
     CS_RELEVANCY, // case split based on relevancy
     CS_RELEVANCY_ACTIVITY, // case split based on relevancy and activity
     CS_RELEVANCY_GOAL, // based on relevancy and the current goal
-    CS_ACTIVITY_THEORY_AWARE_BRANCHING // activity-based case split, but theory solvers can manipulate activity
+    CS_ACTIVITY_THEORY_AWARE_BRANCHING, // activity-based case split, but theory solvers can manipulate activity
+    CS_CHB // case split based on the conflict history of variables
 };
 
 struct smt_params : public preprocessor_params,
@@ -100,17 +103,23 @@ struct smt_params : public preprocessor_params,
     phase_selection  m_phase_selection;
     unsigned         m_phase_caching_on;
     unsigned         m_phase_caching_off;
+    bool             m_phase_persist;
+    bool             m_phase_timing;
+    unsigned         m_rephase_base;
     bool             m_minimize_lemmas;
     unsigned         m_max_conflicts;
     unsigned         m_restart_max;
     unsigned         m_threads;
     unsigned         m_threads_max_conflicts;
+    bool             m_threads_int_split;
+    bool             m_solve_components;
     bool             m_simplify_clauses;
     unsigned         m_tick;
     bool             m_display_features;
     bool             m_new_core2th_eq;
     bool             m_ematching;
     bool             m_induction;
+    bool             m_fp_lazy_encoding;
     bool             m_clause_proof;
 
     // -----------------------------------
@@ -147,6 +156,8 @@ struct smt_params : public preprocessor_params,
     restart_strategy m_restart_strategy;
     unsigned         m_restart_initial;
     double           m_restart_factor;
+    double           m_restart_margin;      // for ema: restart when fast glue average > margin * slow glue average
+    double           m_restart_blocking;    // for ema: block restarts when trail > blocking * average trail
     bool             m_restart_adaptive;
     double           m_agility_factor;
     double           m_restart_agility_threshold;
@@ -161,6 +172,9 @@ struct smt_params : public preprocessor_params,
     unsigned          m_recent_lemmas_size;
     unsigned          m_lemma_gc_initial;
     double            m_lemma_gc_factor;
+    unsigned          m_lemma_gc_core_glue;   //!< lemmas with at most this glue are not deleted.
+    unsigned          m_lemma_gc_tier2_glue;  //!< lemmas with at most this glue survive one more gc.
+    unsigned          m_lemma_gc_max_memory;  //!< megabytes, 0 if gc is not triggered by memory.
     unsigned          m_new_old_ratio;     //!< the ratio of new and old clauses.
     unsigned          m_new_clause_activity;
     unsigned          m_old_clause_activity;
@@ -254,16 +268,22 @@ struct smt_params : public preprocessor_params,
         m_phase_selection(PS_CACHING_CONSERVATIVE),
         m_phase_caching_on(400),
         m_phase_caching_off(100),
+        m_phase_persist(false),
+        m_phase_timing(false),
+        m_rephase_base(1000),
         m_minimize_lemmas(true),
         m_max_conflicts(UINT_MAX),
         m_threads(1),
         m_threads_max_conflicts(UINT_MAX),
+        m_threads_int_split(false),
+        m_solve_components(false),
         m_simplify_clauses(true),
         m_tick(1000),
         m_display_features(false),
         m_new_core2th_eq(true),
         m_ematching(true),
         m_induction(false),
+        m_fp_lazy_encoding(false),
         m_clause_proof(false),
         m_case_split_strategy(CS_ACTIVITY_DELAY_NEW),
         m_rel_case_split_order(0),
@@ -276,6 +296,8 @@ struct smt_params : public preprocessor_params,
         m_restart_strategy(RS_IN_OUT_GEOMETRIC),
         m_restart_initial(100),
         m_restart_factor(1.1),
+        m_restart_margin(1.1),
+        m_restart_blocking(1.4),
         m_restart_adaptive(true),
         m_agility_factor(0.9999),
         m_restart_agility_threshold(0.18),
@@ -284,6 +306,9 @@ struct smt_params : public preprocessor_params,
         m_recent_lemmas_size(100),
         m_lemma_gc_initial(5000),
         m_lemma_gc_factor(1.1),
+        m_lemma_gc_core_glue(2),
+        m_lemma_gc_tier2_glue(6),
+        m_lemma_gc_max_memory(0),
         m_new_old_ratio(16),
         m_new_clause_activity(10),
         m_old_clause_activity(500),
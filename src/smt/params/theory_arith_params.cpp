@@ -38,6 +38,7 @@ void theory_arith_params::updt_params(params_ref const & _p) {
     m_arith_reflect = p.arith_reflect();
     m_arith_eager_eq_axioms = p.arith_eager_eq_axioms();
     m_arith_auto_config_simplex = p.arith_auto_config_simplex();
+    m_arith_dl_implied_budget = p.arith_dl_implied_budget();
 
     arith_rewriter_params ap(_p);
     m_arith_eq2ineq = ap.eq2ineq();
@@ -80,6 +81,7 @@ void theory_arith_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_arith_pivot_strategy);
     DISPLAY_PARAM(m_arith_add_binary_bounds);
     DISPLAY_PARAM(m_arith_propagation_strategy);
+    DISPLAY_PARAM(m_arith_dl_implied_budget);
     DISPLAY_PARAM(m_arith_eq_bounds);
     DISPLAY_PARAM(m_arith_lazy_adapter);
     DISPLAY_PARAM(m_arith_fixnum);
@@ -87,6 +87,7 @@ struct theory_arith_params {
     // used in diff-logic
     bool                    m_arith_add_binary_bounds;
     arith_prop_strategy     m_arith_propagation_strategy;
+    unsigned                m_arith_dl_implied_budget;
 
     // used arith_eq_adapter
     bool                    m_arith_eq_bounds;
@@ -142,6 +143,7 @@ struct theory_arith_params {
         m_arith_pivot_strategy(ARITH_PIVOT_SMALLEST),
         m_arith_add_binary_bounds(false),
         m_arith_propagation_strategy(ARITH_PROP_PROPORTIONAL),
+        m_arith_dl_implied_budget(0),
         m_arith_eq_bounds(false),
         m_arith_lazy_adapter(false),
         m_arith_fixnum(false),
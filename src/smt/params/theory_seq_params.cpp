@@ -23,4 +23,5 @@ void theory_seq_params::updt_params(params_ref const & _p) {
     m_seq_validate = p.seq_validate();
     m_seq_use_derivatives = p.seq_use_derivatives();
     m_seq_use_unicode = p.seq_use_unicode();
+    m_seq_length_first = p.seq_length_first();
 }
@@ -27,13 +27,18 @@ struct theory_seq_params {
     bool m_seq_validate;
     bool m_seq_use_derivatives;
     bool m_seq_use_unicode;
+    /*
+     * Check the length abstraction of the constraints before solving word equations
+     */
+    bool m_seq_length_first;
 
 
     theory_seq_params(params_ref const & p = params_ref()):
         m_split_w_len(false),
         m_seq_validate(false),
         m_seq_use_derivatives(false),
-        m_seq_use_unicode(false)
+        m_seq_use_unicode(false),
+        m_seq_length_first(false)
     {
         updt_params(p);
     }
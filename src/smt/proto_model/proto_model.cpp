@@ -221,6 +221,10 @@ void proto_model::cleanup() {
     for (unsigned i = 0; i < m_const_decls.size(); ++i) {
         func_decl* d = m_const_decls[i];
         expr* e = m_interp[d];
+        // most constants are assigned to numerals or other interpreted constants, 
+        // which cleanup_expr leaves unchanged.
+        if (is_app(e) && to_app(e)->get_num_args() == 0 && !is_uninterp_const(e) && !m_aux_decls.contains(to_app(e)->get_decl()))
+            continue;
         expr* r = cleanup_expr(trail, e, found_aux_fs);
         if (e != r) {
             register_decl(d, r);
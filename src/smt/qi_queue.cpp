@@ -18,6 +18,7 @@ Revision History:
 --*/
 #include "util/warning.h"
 #include "util/stats.h"
+#include "util/event_trace.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/rewriter/var_subst.h"
@@ -149,6 +150,8 @@ namespace smt {
 
     void qi_queue::instantiate() {
         unsigned since_last_check = 0;
+        unsigned num_instances = m_stats.m_num_instances;
+        unsigned num_delayed = m_delayed_entries.size();
         for (entry & curr : m_new_entries) {
             if (m_context.get_cancel_flag()) {
                 break;
@@ -177,6 +180,8 @@ namespace smt {
                 since_last_check = 0;
             }
         }
+        if (event_trace::enabled() && !m_new_entries.empty())
+            event_trace::event("smt.instances")("new", m_new_entries.size())("instances", m_stats.m_num_instances - num_instances)("delayed", m_delayed_entries.size() - num_delayed);
         m_new_entries.reset();
         TRACE("new_entries_bug", tout << "[qi:instantiate]\n";);
     }
@@ -192,6 +197,30 @@ namespace smt {
         }
     }
 
+    bool qi_queue::is_true_at_base(expr * lit) {
+        bool sign = m.is_not(lit, lit);
+        if (!m_context.b_internalized(lit))
+            return false;
+        literal l(m_context.get_bool_var(lit), sign);
+        return m_context.get_assignment(l) == l_true && m_context.get_assign_level(l) <= m_context.get_base_level();
+    }
+
+    /**
+       \brief The instance is subsumed if one of its disjuncts holds at the base level.
+       Adding it would only satisfy a clause that is already satisfied in every branch.
+       Without relevancy its terms may still be needed for E-matching, so it is kept.
+    */
+    bool qi_queue::is_subsumed(expr * instance) {
+        if (m_context.get_fparams().m_relevancy_lvl == 0)
+            return false;
+        if (!m.is_or(instance))
+            return is_true_at_base(instance);
+        for (expr * arg : *to_app(instance))
+            if (is_true_at_base(arg))
+                return true;
+        return false;
+    }
+
     void qi_queue::instantiate(entry & ent) {
         fingerprint * f          = ent.m_qb;
         quantifier * q           = static_cast<quantifier*>(f->get_data());
@@ -226,6 +255,15 @@ namespace smt {
 
             return;
         }
+        if (!f->get_def() && is_subsumed(s_instance)) {
+            TRACE("qi_queue", tout << "instance subsumed at base level:\n" << s_instance << "\n";);
+            m_stats.m_num_subsumed_instances++;
+            if (m.has_trace_stream()) {
+                display_instance_profile(f, q, num_bindings, bindings, pr ? pr->get_id() : 0, generation);
+                m.trace_stream() << "[end-of-instance]\n";
+            }
+            return;
+        }
         TRACE("qi_queue", tout << "simplified instance:\n" << s_instance << "\n";);
         quantifier_stat * stat = m_qm.get_stat(q);
         stat->inc_num_instances();
@@ -457,6 +495,7 @@ namespace smt {
     void qi_queue::collect_statistics(::statistics & st) const {
         st.update("quant instantiations", m_stats.m_num_instances);
         st.update("lazy quant instantiations", m_stats.m_num_lazy_instances);
+        st.update("quant instantiations subsumed", m_stats.m_num_subsumed_instances);
         st.update("missed quant instantiations", m_delayed_entries.size());
         float min, max;
         get_min_max_costs(min, max);
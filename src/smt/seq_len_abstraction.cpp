@@ -0,0 +1,220 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    seq_len_abstraction.cpp
+
+Abstract:
+
+    Length abstraction of string constraints.
+
+    The asserted formulas are abstracted to arithmetic: str.len(s) is
+    replaced by an integer L(s) where L(s ++ t) = L(s) + L(t), string
+    atoms are replaced by Boolean constants that imply the length
+    constraints of the atoms, and other terms that depend on strings are
+    replaced by fresh constants. The abstraction is implied by the
+    assertions, so the assertions are unsatisfiable if the abstraction
+    is. It is checked once per search, before word equations are solved,
+    by an arithmetic solver with a bounded number of conflicts.
+
+--*/
+
+#include "ast/ast_pp.h"
+#include "smt/smt_context.h"
+#include "smt/smt_kernel.h"
+#include "smt/theory_seq.h"
+
+using namespace smt;
+
+namespace {
+
+    class len_abstraction {
+        ast_manager&          m;
+        seq_util&             u;
+        arith_util&           a;
+        expr_ref_vector       m_trail;
+        expr_ref_vector       m_axioms;
+        obj_map<expr, bool>   m_has_seq;
+        obj_map<expr, expr*>  m_cache;    // abstraction of Boolean and arithmetic terms
+        obj_map<expr, expr*>  m_len;      // L(s) of sequence terms s
+
+        bool has_seq(expr* e) {
+            bool r = false;
+            if (m_has_seq.find(e, r))
+                return r;
+            if (is_quantifier(e))
+                r = true;
+            else if (is_app(e)) {
+                sort* s = m.get_sort(e);
+                r = u.is_seq(s) || u.is_re(s) || to_app(e)->get_family_id() == u.get_family_id();
+                for (expr* arg : *to_app(e))
+                    r = r || has_seq(arg);
+            }
+            m_has_seq.insert(e, r);
+            return r;
+        }
+
+        expr* fresh(char const* prefix, sort* s) {
+            expr* r = m.mk_fresh_const(prefix, s);
+            m_trail.push_back(r);
+            return r;
+        }
+
+        expr* save(obj_map<expr, expr*>& cache, expr* e, expr* r) {
+            m_trail.push_back(r);
+            cache.insert(e, r);
+            return r;
+        }
+
+        expr* len(expr* s) {
+            expr* r = nullptr, *s1 = nullptr, *s2 = nullptr, *s3 = nullptr, *c = nullptr;
+            zstring str;
+            if (m_len.find(s, r))
+                return r;
+            if (u.str.is_concat(s)) {
+                expr_ref_vector args(m);
+                for (expr* arg : *to_app(s))
+                    args.push_back(len(arg));
+                r = a.mk_add(args.size(), args.c_ptr());
+            }
+            else if (u.str.is_string(s, str))
+                r = a.mk_int(str.length());
+            else if (u.str.is_empty(s))
+                r = a.mk_int(0);
+            else if (u.str.is_unit(s))
+                r = a.mk_int(1);
+            else if (m.is_ite(s, c, s1, s2))
+                r = m.mk_ite(abstract(c), len(s1), len(s2));
+            else {
+                r = fresh("len", a.mk_int());
+                m_axioms.push_back(a.mk_ge(r, a.mk_int(0)));
+                if (u.str.is_extract(s, s1, s2, s3))
+                    m_axioms.push_back(a.mk_le(r, len(s1)));
+                else if (u.str.is_at(s, s1, s2)) {
+                    m_axioms.push_back(a.mk_le(r, len(s1)));
+                    m_axioms.push_back(a.mk_le(r, a.mk_int(1)));
+                }
+            }
+            return save(m_len, s, r);
+        }
+
+        expr* abstract_arith(expr* e) {
+            expr* r = nullptr, *s = nullptr, *t = nullptr, *i = nullptr, *c = nullptr;
+            if (!has_seq(e))
+                return e;
+            if (m_cache.find(e, r))
+                return r;
+            if (u.str.is_length(e, s))
+                r = len(s);
+            else if (m.is_ite(e, c, s, t))
+                r = m.mk_ite(abstract(c), abstract_arith(s), abstract_arith(t));
+            else if (is_app(e) && to_app(e)->get_family_id() == a.get_family_id()) {
+                expr_ref_vector args(m);
+                for (expr* arg : *to_app(e))
+                    args.push_back(abstract_arith(arg));
+                r = m.mk_app(to_app(e)->get_decl(), args.size(), args.c_ptr());
+            }
+            else {
+                r = fresh("seq.int", m.get_sort(e));
+                if (u.str.is_stoi(e))
+                    m_axioms.push_back(a.mk_ge(r, a.mk_int(-1)));
+                else if (u.str.is_index(e, s, t) || u.str.is_index(e, s, t, i)) {
+                    m_axioms.push_back(a.mk_ge(r, a.mk_int(-1)));
+                    m_axioms.push_back(a.mk_le(r, len(s)));
+                }
+            }
+            return save(m_cache, e, r);
+        }
+
+        /**
+           \brief p => c for a fresh Boolean constant p.
+        */
+        expr* implies(expr* c) {
+            expr* p = fresh("seq.atom", m.mk_bool_sort());
+            if (c)
+                m_axioms.push_back(m.mk_implies(p, c));
+            return p;
+        }
+
+        bool is_connective(expr* e) {
+            return m.is_and(e) || m.is_or(e) || m.is_not(e) || m.is_implies(e) || m.is_xor(e) ||
+                (m.is_ite(e) && m.is_bool(e));
+        }
+
+    public:
+        len_abstraction(ast_manager& m, seq_util& u, arith_util& a):
+            m(m), u(u), a(a), m_trail(m), m_axioms(m) {}
+
+        expr_ref_vector const& axioms() const { return m_axioms; }
+
+        /**
+           \brief abstraction of the Boolean formula e.
+        */
+        expr* abstract(expr* e) {
+            expr* r = nullptr, *s = nullptr, *t = nullptr;
+            if (!has_seq(e))
+                return e;
+            if (m_cache.find(e, r))
+                return r;
+            if (is_connective(e)) {
+                expr_ref_vector args(m);
+                for (expr* arg : *to_app(e))
+                    args.push_back(abstract(arg));
+                r = m.mk_app(to_app(e)->get_decl(), args.size(), args.c_ptr());
+            }
+            else if (m.is_eq(e, s, t) && u.is_seq(m.get_sort(s)))
+                r = implies(m.mk_eq(len(s), len(t)));
+            else if (m.is_eq(e, s, t) && m.is_bool(s))
+                r = m.mk_eq(abstract(s), abstract(t));
+            else if ((m.is_eq(e, s, t) || a.is_le(e, s, t) || a.is_ge(e, s, t) || a.is_lt(e, s, t) || a.is_gt(e, s, t)) &&
+                     a.is_int_real(s))
+                r = m.mk_app(to_app(e)->get_decl(), abstract_arith(s), abstract_arith(t));
+            else if (u.str.is_prefix(e, s, t) || u.str.is_suffix(e, s, t))
+                r = implies(a.mk_le(len(s), len(t)));
+            else if (u.str.is_contains(e, s, t))
+                r = implies(a.mk_le(len(t), len(s)));
+            else if (u.str.is_in_re(e, s, t)) {
+                unsigned n = u.re.min_length(t);
+                r = implies(n == 0 ? nullptr : a.mk_ge(len(s), a.mk_int(n)));
+            }
+            else
+                r = implies(nullptr);
+            return save(m_cache, e, r);
+        }
+    };
+}
+
+/**
+   \brief check the length abstraction of the asserted formulas once per search.
+   Return true if the abstraction is unsatisfiable and a conflict was added.
+*/
+bool theory_seq::check_length_abstraction() {
+    if (!get_fparams().m_seq_length_first || m_length_abstraction_checked || m.proofs_enabled())
+        return false;
+    m_length_abstraction_checked = true;
+    ++m_stats.m_length_abstraction;
+
+    ptr_vector<expr> fmls;
+    ctx.get_asserted_formulas(fmls);
+    len_abstraction abs(m, m_util, m_autil);
+    expr_ref_vector abs_fmls(m);
+    for (expr* f : fmls)
+        abs_fmls.push_back(abs.abstract(f));
+    abs_fmls.append(abs.axioms());
+
+    smt_params fp;
+    fp.m_max_conflicts = 10000;
+    // the nested solver also gets theory_seq, which must not check the abstraction again.
+    fp.m_seq_length_first = false;
+    kernel k(m, fp);
+    for (expr* f : abs_fmls)
+        k.assert_expr(f);
+    lbool r = k.check();
+    TRACE("seq", tout << "length abstraction: " << r << "\n" << abs_fmls << "\n";);
+    if (r != l_false)
+        return false;
+    ++m_stats.m_length_abstraction_unsat;
+    ctx.mk_th_axiom(get_id(), 0, nullptr);
+    return true;
+}
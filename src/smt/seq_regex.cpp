@@ -18,13 +18,15 @@ Author:
 #include "smt/seq_regex.h"
 #include "smt/theory_seq.h"
 #include "ast/expr_abstract.h"
+#include "ast/rewriter/var_subst.h"
 
 namespace smt {
 
     seq_regex::seq_regex(theory_seq& th):
         th(th),
         ctx(th.get_context()),
-        m(th.get_manager())
+        m(th.get_manager()),
+        m_cache_trail(m)
     {}
 
     seq_util& seq_regex::u() { return th.m_util; }
@@ -176,6 +178,11 @@ namespace smt {
         if (block_unfolding(lit, idx))
             return true;
 
+        if (is_dead(r)) {
+            th.add_axiom(~lit);
+            return true;
+        }
+
         // s in R & len(s) <= i => nullable(R)
         literal len_s_le_i = th.m_ax.mk_le(th.mk_len(s), idx);
         switch (ctx.get_assignment(len_s_le_i)) {
@@ -197,7 +204,7 @@ namespace smt {
 
         // (accept s i R) & len(s) > i => (accept s (+ i 1) D(nth(s, i), R)) or conds
         expr_ref head = th.mk_nth(s, i);        
-        d = seq_rw().derivative(head, d);
+        d = derivative(head, d);
         if (!d) 
             throw default_exception("unable to expand derivative");
 
@@ -317,9 +324,13 @@ namespace smt {
         rewrite(is_nullable);
         if (m.is_true(is_nullable))
             return;
+        if (is_dead(r)) {
+            th.add_axiom(~lit);
+            return;
+        }
         literal null_lit = th.mk_literal(is_nullable);
         expr_ref hd = mk_first(r);
-        expr_ref d = seq_rw().derivative(hd, r);
+        expr_ref d = derivative(hd, r);
         if (!d)
             throw default_exception("derivative was not defined");
         literal_vector lits;
@@ -361,8 +372,10 @@ namespace smt {
             return;
         }
         th.add_axiom(~lit, ~th.mk_literal(is_nullable));
+        if (is_dead(r))
+            return;
         expr_ref hd = mk_first(r);
-        expr_ref d = seq_rw().derivative(hd, r);
+        expr_ref d = derivative(hd, r);
         if (!d)
             throw default_exception("derivative was not defined");
         literal_vector lits;
@@ -390,6 +403,96 @@ namespace smt {
         }        
     }
 
+    /**
+     * Derivative of r with respect to the free variable 0 of the element sort.
+     * The derivative is simplified, so that equivalent states tend to share 
+     * the same representation. Returns nullptr if the derivative is not defined.
+     */
+    expr* seq_regex::derivative(expr* r) {
+        expr* d = nullptr;
+        if (m_derivative_cache.find(r, d))
+            return d;
+        sort* seq_sort = nullptr, *elem_sort = nullptr;
+        VERIFY(u().is_re(r, seq_sort));
+        VERIFY(u().is_seq(seq_sort, elem_sort));
+        expr_ref v(m.mk_var(0, elem_sort), m);
+        expr_ref dr = seq_rw().derivative(v, r);
+        if (!dr)
+            return nullptr;
+        rewrite(dr);
+        m_cache_trail.push_back(r);
+        m_cache_trail.push_back(dr);
+        m_derivative_cache.insert(r, dr);
+        return dr;
+    }
+
+    expr_ref seq_regex::derivative(expr* hd, expr* r) {
+        expr* d = derivative(r);
+        if (!d) 
+            return expr_ref(m);
+        var_subst subst(m, false);
+        return subst(d, 1, &hd);
+    }
+
+    /**
+     * r is dead if no nullable regex is reachable from r by derivatives.
+     * Conditions on characters are ignored, so more states are explored than 
+     * are reachable. The search is bounded, and r is not dead if the bound is 
+     * exceeded or nullability of a state cannot be decided.
+     */
+    bool seq_regex::is_dead(expr* r) {
+        bool dead = false;
+        if (m_dead_cache.find(r, dead))
+            return dead;
+        unsigned const max_states = 64;
+        ptr_vector<expr> todo;
+        obj_hashtable<expr> seen;
+        todo.push_back(r);
+        seen.insert(r);
+        for (unsigned i = 0; i < todo.size(); ++i) {
+            expr* s = todo[i];
+            if (m_dead_cache.find(s, dead)) {
+                if (dead) 
+                    continue;
+                break;
+            }
+            expr_ref is_nullable = seq_rw().is_nullable(s);
+            rewrite(is_nullable);
+            expr* d = m.is_false(is_nullable) ? derivative(s) : nullptr;
+            if (!d) {
+                dead = false;
+                break;
+            }
+            expr_ref_pair_vector cofactors(m);
+            seq_rw().get_cofactors(d, cofactors);
+            dead = true;
+            for (auto const& p : cofactors) {
+                if (seen.contains(p.second)) 
+                    continue;
+                if (!is_ground(p.second) || todo.size() >= max_states) {
+                    dead = false;
+                    break;
+                }
+                seen.insert(p.second);
+                todo.push_back(p.second);
+            }
+            if (!dead)
+                break;
+        }
+        if (dead) {
+            TRACE("seq", tout << "dead state " << mk_pp(r, m) << "\n";);
+            for (expr* s : todo) {
+                m_cache_trail.push_back(s);
+                m_dead_cache.insert(s, true);
+            }
+        }
+        else {
+            m_cache_trail.push_back(r);
+            m_dead_cache.insert(r, false);
+        }
+        return dead;
+    }
+
     expr_ref seq_regex::mk_first(expr* r) {
         sort* elem_sort = nullptr, *seq_sort = nullptr;
         VERIFY(u().is_re(r, seq_sort));
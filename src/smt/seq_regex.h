@@ -41,6 +41,11 @@ namespace smt {
         ast_manager&     m;
         vector<s_in_re> m_s_in_re;
         scoped_vector<literal> m_to_propagate;
+        // The caches persist across scopes. Derivatives are stored for the
+        // free variable 0 of the element sort and instantiated on lookup.
+        obj_map<expr, expr*> m_derivative_cache;
+        obj_map<expr, bool>  m_dead_cache;
+        expr_ref_vector      m_cache_trail;
 
         seq_util& u();
         class seq_util::re& re();
@@ -69,6 +74,12 @@ namespace smt {
 
         expr_ref symmetric_diff(expr* r1, expr* r2);
 
+        expr* derivative(expr* r);
+
+        expr_ref derivative(expr* hd, expr* r);
+
+        bool is_dead(expr* r);
+
     public:
 
         seq_regex(theory_seq& th);
@@ -1247,6 +1247,148 @@ namespace {
 
         ~theory_aware_branching_queue() override {};
     };
+
+    /**
+       \brief Case split queue based on the conflict history of variables (CHB).
+       
+       When a variable is assigned it receives the reward m / (c - c(v) + 1), where
+       c is the number of conflicts, c(v) the number of conflicts when v last
+       participated in conflict resolution, and m is 1 if propagation lead to a
+       conflict and 0.9 otherwise. The score of v is an exponential moving
+       average of its rewards with a step size that decreases from 0.4 to 0.06.
+       The rewards of the assigned variables are collected at the next conflict
+       or case split.
+    */
+    class chb_case_split_queue : public case_split_queue {
+        context &          m_context;
+        smt_params &       m_params;
+        svector<double>    m_score;
+        unsigned_vector    m_last_conflict;
+        bool_var_act_queue m_queue;
+        bool_var_vector    m_assigned;  // variables assigned since the last update
+        unsigned           m_conflicts; // number of conflicts at the last update
+        double             m_step;
+
+        void set_score(bool_var v, double score) {
+            double old = m_score[v];
+            m_score[v] = score;
+            if (!m_queue.contains(v))
+                return;
+            if (score > old)
+                m_queue.decreased(v);
+            else if (score < old)
+                m_queue.increased(v);
+        }
+
+        void update() {
+            unsigned c = m_context.get_num_conflicts();
+            double multiplier = c != m_conflicts ? 1.0 : 0.9;
+            for (bool_var v : m_assigned) {
+                unsigned age = c >= m_last_conflict[v] ? c - m_last_conflict[v] : 0;
+                double reward = multiplier / (age + 1);
+                set_score(v, (1.0 - m_step) * m_score[v] + m_step * reward);
+            }
+            m_assigned.reset();
+            if (c != m_conflicts) {
+                m_step = std::max(0.06, m_step - 1e-6 * (c > m_conflicts ? c - m_conflicts : 1));
+                m_conflicts = c;
+            }
+        }
+
+    public:
+        chb_case_split_queue(context & ctx, smt_params & p):
+            m_context(ctx),
+            m_params(p),
+            m_queue(1024, bool_var_act_lt(m_score)),
+            m_conflicts(0),
+            m_step(0.4) {
+        }
+
+        void activity_increased_eh(bool_var v) override {
+            // v participates in the resolution of the current conflict.
+            if (m_conflicts != m_context.get_num_conflicts())
+                update();
+            m_last_conflict[v] = m_conflicts;
+        }
+
+        void activity_decreased_eh(bool_var v) override {}
+
+        void mk_var_eh(bool_var v) override {
+            m_score.reserve(v+1, 0.0);
+            m_last_conflict.reserve(v+1, 0);
+            m_score[v] = 0.0;
+            m_last_conflict[v] = m_context.get_num_conflicts();
+            m_queue.reserve(v+1);
+            SASSERT(!m_queue.contains(v));
+            m_queue.insert(v);
+        }
+
+        void del_var_eh(bool_var v) override {
+            if (m_queue.contains(v))
+                m_queue.erase(v);
+        }
+
+        void assign_lit_eh(literal l) override {
+            m_assigned.push_back(l.var());
+        }
+
+        void unassign_var_eh(bool_var v) override {
+            if (!m_queue.contains(v))
+                m_queue.insert(v);
+        }
+
+        void relevant_eh(expr * n) override {}
+
+        void init_search_eh() override {
+            m_assigned.reset();
+            m_conflicts = m_context.get_num_conflicts();
+        }
+
+        void end_search_eh() override {}
+
+        void reset() override {
+            m_queue.reset();
+            m_assigned.reset();
+        }
+
+        void push_scope() override {}
+
+        void pop_scope(unsigned num_scopes) override {}
+
+        void next_case_split(bool_var & next, lbool & phase) override {
+            phase = l_undef;
+            update();
+
+            if (m_context.get_random_value() < static_cast<int>(m_params.m_random_var_freq * random_gen::max_value())) {
+                next = m_context.get_random_value() % m_context.get_num_b_internalized(); 
+                if (m_context.get_assignment(next) == l_undef)
+                    return;
+            }
+            
+            while (!m_queue.empty()) {
+                next = m_queue.erase_min();
+                if (m_context.get_assignment(next) == l_undef)
+                    return;
+            }
+            
+            next = null_bool_var;
+        }
+
+        void display(std::ostream & out) override {
+            bool first = true;
+            for (bool_var v : m_queue) {
+                if (m_context.get_assignment(v) == l_undef) {
+                    if (first) {
+                        out << "remaining case-splits:\n";
+                        first = false;
+                    }
+                    out << "#" << m_context.bool_var2expr(v)->get_id() << ":" << m_score[v] << " ";
+                }
+            }
+            if (!first)
+                out << "\n";
+        }
+    };
 }
 
 namespace smt {
@@ -1274,6 +1416,8 @@ namespace smt {
             return alloc(rel_goal_case_split_queue, ctx, p);
         case CS_ACTIVITY_THEORY_AWARE_BRANCHING:
             return alloc(theory_aware_branching_queue, ctx, p);
+        case CS_CHB:
+            return alloc(chb_case_split_queue, ctx, p);
         default:
             return alloc(act_case_split_queue, ctx, p);
         }
@@ -0,0 +1,289 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    smt_components.cpp
+
+Abstract:
+
+    Solve groups of assertions that share no uninterpreted
+    symbols in separate contexts and combine their models.
+
+    Two formulas belong to the same group if they share a subterm,
+    a function or constant that is considered uninterpreted, or an
+    uninterpreted sort. Groups are distributed over at most
+    smt.threads workers, each worker has its own ast_manager and
+    solves its groups one after another.
+
+Author:
+
+    nbjorner 2020-06-05
+
+--*/
+
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
+#include "util/union_find.h"
+#include "ast/ast_translation.h"
+#include "model/model.h"
+#include "smt/smt_components.h"
+
+#ifdef SINGLE_THREAD
+
+namespace smt {
+
+    bool components::operator()(lbool& result) {
+        return false;
+    }
+}
+
+#else
+
+#include <thread>
+#include <mutex>
+
+namespace smt {
+
+    /**
+       \brief add the interpretations of src that are not already in dst.
+    */
+    static void add_model(model& dst, model const& src) {
+        for (unsigned k = 0; k < src.get_num_uninterpreted_sorts(); ++k) {
+            sort* s = src.get_uninterpreted_sort(k);
+            ptr_vector<expr> const& u = src.get_universe(s);
+            if (!dst.has_uninterpreted_sort(s))
+                dst.register_usort(s, u.size(), u.c_ptr());
+        }
+        for (unsigned k = 0; k < src.get_num_constants(); ++k) {
+            func_decl* f = src.get_constant(k);
+            if (!dst.has_interpretation(f))
+                dst.register_decl(f, src.get_const_interp(f));
+        }
+        for (unsigned k = 0; k < src.get_num_functions(); ++k) {
+            func_decl* f = src.get_function(k);
+            if (!dst.has_interpretation(f))
+                dst.register_decl(f, src.get_func_interp(f)->copy());
+        }
+    }
+
+    void components::mk_components(vector<unsigned_vector>& comps) {
+        ast_manager& m = ctx.m;
+        asserted_formulas& af = ctx.m_asserted_formulas;
+        unsigned sz = af.get_num_formulas();
+        basic_union_find uf;
+        for (unsigned i = 0; i < sz; ++i) 
+            uf.mk_var();
+        obj_map<expr, unsigned> owner;
+        obj_map<ast, unsigned> sym_owner;
+        ptr_vector<expr> todo;
+        auto add_sym = [&](ast* s, unsigned i) {
+            unsigned j;
+            if (sym_owner.find(s, j))
+                uf.merge(i, j);
+            else
+                sym_owner.insert(s, i);
+        };
+        auto add_sort = [&](sort* s, unsigned i) {
+            if (s->get_family_id() == null_family_id)
+                add_sym(s, i);
+        };
+        for (unsigned i = 0; i < sz; ++i) {
+            todo.push_back(af.get_formula(i));
+            while (!todo.empty()) {
+                expr* e = todo.back();
+                todo.pop_back();
+                unsigned j;
+                if (owner.find(e, j)) {
+                    uf.merge(i, j);
+                    continue;
+                }
+                owner.insert(e, i);
+                add_sort(m.get_sort(e), i);
+                if (is_app(e)) {
+                    app* a = to_app(e);
+                    if (m.is_considered_uninterpreted(a->get_decl()))
+                        add_sym(a->get_decl(), i);
+                    for (expr* arg : *a)
+                        todo.push_back(arg);
+                }
+                else if (is_quantifier(e)) {
+                    quantifier* q = to_quantifier(e);
+                    for (unsigned k = 0; k < q->get_num_decls(); ++k)
+                        add_sort(q->get_decl_sort(k), i);
+                    todo.push_back(q->get_expr());
+                }
+            }
+        }
+        unsigned_vector root2comp(sz, UINT_MAX);
+        for (unsigned i = 0; i < sz; ++i) {
+            unsigned r = uf.find(i);
+            if (root2comp[r] == UINT_MAX) {
+                root2comp[r] = comps.size();
+                comps.push_back(unsigned_vector());
+            }
+            comps[root2comp[r]].push_back(i);
+        }
+    }
+
+    bool components::operator()(lbool& result) {
+        ast_manager& m = ctx.m;
+        asserted_formulas& af = ctx.m_asserted_formulas;
+        if (af.get_qhead() > 0 || af.get_macro_manager().get_num_macros() > 0)
+            return false;
+        ctx.reduce_assertions();
+        if (af.inconsistent() || af.get_qhead() > 0 || 
+            af.get_macro_manager().get_num_macros() > 0 || ctx.get_cancel_flag())
+            return false;
+
+        vector<unsigned_vector> comps;
+        mk_components(comps);
+        if (comps.size() <= 1) 
+            return false;
+
+        unsigned num_threads = std::min((unsigned) std::thread::hardware_concurrency(), ctx.get_fparams().m_threads);
+        num_threads = std::max(1u, std::min(num_threads, comps.size()));
+        IF_VERBOSE(2, verbose_stream() << "(smt.components :components " << comps.size() << " :threads " << num_threads << ")\n";);
+
+        // larger components first, worker i solves the components i, i + num_threads, ...
+        std::sort(comps.begin(), comps.end(), 
+                  [](unsigned_vector const& a, unsigned_vector const& b) { return a.size() > b.size(); });
+
+        vector<smt_params> params;
+        scoped_ptr_vector<ast_manager> pms;
+        scoped_limits sl(m.limit());
+        for (unsigned i = 0; i < num_threads; ++i) {
+            params.push_back(ctx.get_fparams());
+            params.back().m_threads = 1;
+            params.back().m_solve_components = false;
+        }
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_manager* new_m = alloc(ast_manager, m, true);
+            pms.push_back(new_m);
+            sl.push_child(&(new_m->limit()));
+        }
+        vector<expr_ref_vector> fmls;
+        for (unsigned i = 0; i < num_threads; ++i) 
+            fmls.push_back(expr_ref_vector(*pms[i]));
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_translation tr(m, *pms[i]);
+            for (unsigned c = i; c < comps.size(); c += num_threads) 
+                for (unsigned idx : comps[c])
+                    fmls[i].push_back(tr(af.get_formula(idx)));
+        }
+
+        enum par_exception_kind {
+            DEFAULT_EX,
+            ERROR_EX
+        };
+
+        std::mutex mux;
+        lbool r = l_true;
+        std::string unknown;
+        std::string ex_msg;
+        par_exception_kind ex_kind = DEFAULT_EX;
+        unsigned error_code = 0;
+        bool has_exception = false;
+        vector<model_ref> models;
+        models.resize(num_threads);
+
+        auto cancel_others = [&](unsigned i) {
+            for (unsigned j = 0; j < num_threads; ++j)
+                if (j != i) pms[j]->limit().cancel();
+        };
+
+        auto worker_thread = [&](unsigned i) {
+            ast_manager& pm = *pms[i];
+            model_ref mdl = alloc(model, pm);
+            unsigned offset = 0;
+            try {
+                for (unsigned c = i; c < comps.size(); c += num_threads) {
+                    scoped_ptr<context> pctx;
+                    {
+                        // ctx is shared between the workers
+                        std::lock_guard<std::mutex> lock(mux);
+                        pctx = alloc(context, pm, params[i], ctx.get_params());
+                        pctx->set_logic(ctx.m_setup.get_logic());
+                        pctx->copy_plugins(ctx, *pctx);
+                    }
+                    for (unsigned k = 0; k < comps[c].size(); ++k) 
+                        pctx->assert_expr(fmls[i].get(offset + k));
+                    offset += comps[c].size();
+                    lbool lr = pctx->setup_and_check();
+                    {
+                        std::lock_guard<std::mutex> lock(mux);
+                        pctx->collect_statistics(ctx.m_aux_stats);
+                    }
+                    if (lr == l_true) {
+                        model_ref cmdl;
+                        pctx->get_model(cmdl);
+                        if (cmdl) 
+                            add_model(*mdl, *cmdl);
+                        continue;
+                    }
+                    std::lock_guard<std::mutex> lock(mux);
+                    if (r == l_false)
+                        return;
+                    if (lr == l_false || r == l_true) {
+                        r = lr;
+                        unknown = pctx->last_failure_as_string();
+                    }
+                    if (lr == l_false) 
+                        cancel_others(i);
+                    return;
+                }
+                models[i] = mdl;
+            }
+            catch (z3_error & err) {
+                std::lock_guard<std::mutex> lock(mux);
+                has_exception = true;
+                error_code = err.error_code();
+                ex_kind = ERROR_EX;
+                cancel_others(i);
+            }
+            catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                has_exception = true;
+                ex_msg = ex.msg();
+                ex_kind = DEFAULT_EX;
+                cancel_others(i);
+            }
+        };
+
+        thread_pool::run(num_threads, worker_thread);
+
+        if (has_exception && r != l_false) {
+            switch (ex_kind) {
+            case ERROR_EX: throw z3_error(error_code);
+            default: throw default_exception(std::move(ex_msg));
+            }
+        }
+
+        ctx.reset_model();
+        ctx.m_unsat_core.reset();
+        result = r;
+        switch (r) {
+        case l_true: {
+            model_ref mdl = alloc(model, m);
+            for (unsigned i = 0; i < num_threads; ++i) {
+                ast_translation tr(*pms[i], m);
+                model_ref tmdl = models[i]->translate(tr);
+                add_model(*mdl, *tmdl);
+            }
+            ctx.set_model(mdl.get());
+            ctx.m_last_search_failure = OK;
+            break;
+        }
+        case l_false:
+            ctx.m_last_search_failure = OK;
+            break;
+        default:
+            ctx.m_last_search_failure = UNKNOWN;
+            ctx.set_reason_unknown(unknown.c_str());
+            break;
+        }
+        return true;
+    }
+
+}
+#endif
@@ -0,0 +1,43 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    smt_components.h
+
+Abstract:
+
+    Solve groups of assertions that share no uninterpreted
+    symbols in separate contexts and combine their models.
+
+Author:
+
+    nbjorner 2020-06-05
+
+Revision History:
+
+--*/
+#pragma once
+
+#include "smt/smt_context.h"
+
+namespace smt {
+
+    class components {
+        context& ctx;
+
+        void mk_components(vector<unsigned_vector>& comps);
+
+    public:
+        components(context& ctx): ctx(ctx) {}
+
+        /**
+           \brief Check the asserted formulas of ctx by component.
+           Returns false, without changing ctx, if the formulas form
+           a single component or cannot be split.
+        */
+        bool operator()(lbool& result);
+
+    };
+
+}
@@ -43,6 +43,7 @@ namespace smt {
         m_dyn_ack_manager(dyn_ack_manager),
         m_assigned_literals(assigned_literals),
         m_lemma_atoms(m),
+        m_lemma_glue(0),
         m_todo_js_qhead(0),
         m_antecedents(nullptr),
         m_watches(watches),
@@ -201,6 +202,7 @@ namespace smt {
             while (m_todo_js_qhead < sz) {
                 justification * js = m_todo_js[m_todo_js_qhead];
                 m_todo_js_qhead++;
+                phase_timer::scoped _pt(m_ctx.get_phase_timer(), m_ctx.get_explain_phase(js->get_from_theory()));
                 js->get_antecedents(*this);
             }
             while (!m_todo_eqs.empty()) {
@@ -445,8 +447,11 @@ namespace smt {
 
         TRACE("conflict_verbose",m_ctx.display_literals_verbose(tout << "before minimization:\n", m_lemma) << "\n";);
 
-        if (m_params.m_minimize_lemmas)
+        if (m_params.m_minimize_lemmas) {
             minimize_lemma();
+            if (!m.proofs_enabled())
+                minimize_lemma_binres();
+        }
 
         TRACE("conflict", m_ctx.display_literals(tout << "after minimization:\n", m_lemma) << "\n";);
         TRACE("conflict_verbose", m_ctx.display_literals_verbose(tout << "after minimization:\n", m_lemma) << "\n";);
@@ -475,6 +480,8 @@ namespace smt {
               tout << "new scope level:     " << m_new_scope_lvl << "\n";
               tout << "intern. scope level: " << m_lemma_iscope_lvl << "\n";);
 
+        m_lemma_glue = compute_lemma_glue();
+
         if (m.proofs_enabled())
             mk_conflict_proof(conflict, not_l);
     }
@@ -762,6 +769,67 @@ namespace smt {
         m_ctx.m_stats.m_num_minimized_lits += sz - j;
     }
 
+    /**
+       \brief Remove the literals l of m_lemma such that (m_lemma[0] or ~l) is a
+       binary clause. Resolving the lemma with the binary clause removes l.
+       The lemma literals are assumed to be marked, see minimize_lemma.
+    */
+    void conflict_resolution::minimize_lemma_binres() {
+        unsigned sz = m_lemma.size();
+        literal l0  = m_lemma[0];
+        if (sz <= 1 || l0 == null_literal || m_lemma.contains(null_literal))
+            return;
+        m_lit_marks.reserve(2 * m_ctx.get_num_bool_vars(), false);
+        for (unsigned i = 1; i < sz; i++)
+            m_lit_marks[m_lemma[i].index()] = true;
+
+        // literals l2 of binary clauses (l0 or l2) are stored in the watch list of ~l0.
+        unsigned num_removed = 0;
+        watch_list const & wl = m_watches[(~l0).index()];
+        for (literal const * it = wl.begin_literals(), * end = wl.end_literals(); it != end; ++it) {
+            literal l = ~(*it);
+            if (m_lit_marks[l.index()]) {
+                m_lit_marks[l.index()] = false;
+                num_removed++;
+            }
+        }
+
+        unsigned j = 1;
+        for (unsigned i = 1; i < sz; i++) {
+            literal l = m_lemma[i];
+            if (m_lit_marks[l.index()] || num_removed == 0) {
+                m_lit_marks[l.index()] = false;
+                if (j != i) {
+                    m_lemma[j]       = m_lemma[i];
+                    m_lemma_atoms.set(j, m_lemma_atoms.get(i));
+                }
+                j++;
+            }
+            else {
+                m_ctx.unset_mark(l.var());
+            }
+        }
+        m_lemma      .shrink(j);
+        m_lemma_atoms.shrink(j);
+        m_ctx.m_stats.m_num_minimized_lits += sz - j;
+    }
+
+    /**
+       \brief Return the number of distinct assignment levels of the lemma literals (LBD).
+    */
+    unsigned conflict_resolution::compute_lemma_glue() {
+        m_glue_lvls.reset();
+        for (literal l : m_lemma)
+            if (l != null_literal)
+                m_glue_lvls.push_back(m_ctx.get_assign_level(l));
+        std::sort(m_glue_lvls.begin(), m_glue_lvls.end());
+        unsigned glue = 0;
+        for (unsigned i = 0; i < m_glue_lvls.size(); ++i)
+            if (i == 0 || m_glue_lvls[i] != m_glue_lvls[i-1])
+                ++glue;
+        return glue;
+    }
+
     /**
        \brief Return the proof object associated with the equality (= n1 n2)
        if it already exists. Otherwise, return 0 and add p to the todo-list.
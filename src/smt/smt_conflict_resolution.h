@@ -57,6 +57,7 @@ namespace smt {
         expr_ref_vector                m_lemma_atoms;
         unsigned                       m_new_scope_lvl;
         unsigned                       m_lemma_iscope_lvl;
+        unsigned                       m_lemma_glue;  //!< number of distinct assignment levels in the lemma
         
         justification_vector           m_todo_js;
         unsigned                       m_todo_js_qhead;
@@ -191,6 +192,11 @@ namespace smt {
         bool implied_by_marked(literal lit);
         void minimize_lemma();
 
+        svector<char>   m_lit_marks;
+        unsigned_vector m_glue_lvls;
+        void minimize_lemma_binres();
+        unsigned compute_lemma_glue();
+
         void structural_minimization();
 
         void process_antecedent_for_unsat_core(literal antecedent);
@@ -229,6 +235,10 @@ namespace smt {
             return m_lemma_iscope_lvl;
         }
 
+        unsigned get_lemma_glue() const {
+            return m_lemma_glue;
+        }
+
         unsigned get_lemma_num_literals() const {
             return m_lemma.size();
         }
@@ -21,6 +21,7 @@ Revision History:
 #include "util/warning.h"
 #include "util/timeit.h"
 #include "util/union_find.h"
+#include "util/event_trace.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_smt2_pp.h"
@@ -39,6 +40,7 @@ Revision History:
 #include "smt/smt_model_checker.h"
 #include "smt/smt_model_finder.h"
 #include "smt/smt_parallel.h"
+#include "smt/smt_components.h"
 
 namespace smt {
 
@@ -77,6 +79,12 @@ namespace smt {
         m_phase_cache_on(true),
         m_phase_counter(0),
         m_phase_default(false),
+        m_saved_phase_exprs(m),
+        m_saving_phases(false),
+        m_target_assigned(0),
+        m_best_assigned(0),
+        m_rephase_count(0),
+        m_rephase_lim(0),
         m_conflict(null_b_justification),
         m_not_l(null_literal),
         m_conflict_resolution(mk_conflict_resolution(m, *this, m_dyn_ack_manager, p, m_assigned_literals, m_watches)),
@@ -102,6 +110,14 @@ namespace smt {
         m_case_split_queue = mk_case_split_queue(*this, p);
         m_rewriter.updt_params(m_asserted_formulas.get_params());
 
+        m_phase_preprocess  = m_phase_timer.mk_phase("preprocess");
+        m_phase_internalize = m_phase_timer.mk_phase("internalize");
+        m_phase_propagate   = m_phase_timer.mk_phase("propagate");
+        m_phase_conflict    = m_phase_timer.mk_phase("conflict");
+        m_phase_ematching   = m_phase_timer.mk_phase("ematching");
+        m_phase_final_check = m_phase_timer.mk_phase("final_check");
+        m_phase_model       = m_phase_timer.mk_phase("model");
+
         init();
 
         if (!relevancy())
@@ -131,6 +147,8 @@ namespace smt {
         return std::min(m_relevancy_lvl, m_fparams.m_relevancy_lvl);
     }
 
+#define SMT_MAX_COPIED_LEMMA_SIZE 3
+
     void context::copy(context& src_ctx, context& dst_ctx, bool override_base) {
         ast_manager& dst_m = dst_ctx.get_manager();
         ast_manager& src_m = src_ctx.get_manager();
@@ -150,6 +168,9 @@ namespace smt {
         asserted_formulas& dst_af = dst_ctx.m_asserted_formulas;
 
         // Copy asserted formulas.
+        // The formulas that were internalized by the source are already
+        // simplified and the copy does not simplify them again.
+        bool reduce = !dst_af.empty() || src_af.inconsistent();
         for (unsigned i = 0; i < src_af.get_num_formulas(); ++i) {
             expr_ref fml(dst_m);
             proof_ref pr(dst_m);
@@ -158,7 +179,10 @@ namespace smt {
             if (pr_src) {
                 pr = tr(pr_src);
             }
-            dst_af.assert_expr(fml, pr);
+            if (!reduce && i < src_af.get_qhead()) 
+                dst_af.assert_reduced(fml, pr);
+            else
+                dst_af.assert_expr(fml, pr);
         }
 
         src_af.get_macro_manager().copy_to(dst_af.get_macro_manager());
@@ -179,6 +203,29 @@ namespace smt {
             dst_ctx.assert_expr(fml1);
         }
 
+        // Copy short learned clauses. They are consequences of the asserted formulas
+        // and save the copy from re-learning them.
+        expr_ref_vector lits(src_m);
+        for (unsigned i = 0; !src_m.proofs_enabled() && i < src_ctx.m_lemmas.size(); ++i) {
+            clause const& cls = *src_ctx.m_lemmas[i];
+            if (cls.get_num_literals() > SMT_MAX_COPIED_LEMMA_SIZE) 
+                continue;
+            lits.reset();
+            for (literal lit : cls) {
+                bool_var_data const & d = src_ctx.get_bdata(lit.var());
+                if (d.is_theory_atom() && !src_ctx.m_theories.get_plugin(d.get_theory())->is_safe_to_copy(lit.var())) 
+                    break;
+                expr_ref e(src_m);
+                src_ctx.literal2expr(lit, e);
+                lits.push_back(e);
+            }
+            if (lits.size() != cls.get_num_literals())
+                continue;
+            expr_ref fml0 = mk_or(lits);
+            expr_ref fml1(tr(fml0.get()), dst_m);
+            dst_ctx.assert_expr(fml1);
+        }
+
         dst_ctx.setup_context(dst_ctx.m_fparams.m_auto_config);
         dst_ctx.internalize_assertions();
 
@@ -452,6 +499,7 @@ namespace smt {
     */
     void context::add_eq(enode * n1, enode * n2, eq_justification js) {
         unsigned old_trail_size = m_trail_stack.size();
+        unsigned old_cg_parents_size = m_cg_parents.size();
         scoped_suspend_rlimit _suspend_cancel(m.limit());
 
         try {
@@ -538,7 +586,7 @@ namespace smt {
             while(curr != r1);
 
             SASSERT(r1->get_root() == r2);
-            reinsert_parents_into_cg_table(r1, r2, n1, n2, js);
+            reinsert_parents_into_cg_table(old_cg_parents_size, r2, n1, n2, js);
 
             if (n2->is_bool())
                 propagate_bool_enode_assignment(r1, r2, n1, n2);
@@ -556,6 +604,7 @@ namespace smt {
             // If the add_eq_trail remains on the trail stack, then Z3 may crash when the destructor is invoked.
             TRACE("add_eq", tout << "add_eq interrupted. This is unsafe " << m.limit().get_cancel_flag() << "\n";);
             m_trail_stack.shrink(old_trail_size);
+            m_cg_parents.shrink(old_cg_parents_size);
             throw;
         }
     }
@@ -563,6 +612,8 @@ namespace smt {
     /**
        \brief When merging to equivalence classes, the parents of the smallest one (that are congruence roots),
        must be removed from the congruence table since their hash code will change.
+       The removed parents are collected in m_cg_parents, so that reinsert_parents_into_cg_table
+       does not have to traverse the parents that remain congruent to other enodes a second time.
     */
     void context::remove_parents_from_cg_table(enode * r1) {
         // Remove parents from the congruence table
@@ -584,6 +635,7 @@ namespace smt {
             if (!parent->is_marked() && parent->is_cgr() && !parent->is_true_eq()) {
                 SASSERT(!parent->is_cgc_enabled() || m_cg_table.contains_ptr(parent));
                 parent->set_mark();
+                m_cg_parents.push_back(parent);
                 if (parent->is_cgc_enabled()) {
                     m_cg_table.erase(parent);
                     SASSERT(!m_cg_table.contains_ptr(parent));
@@ -594,7 +646,8 @@ namespace smt {
 
     /**
        \brief Reinsert the parents of r1 that were removed from the
-       cg_table at remove_parents_from_cg_table. Some of these parents will
+       cg_table at remove_parents_from_cg_table, they are stored in m_cg_parents
+       starting at position lim. Some of these parents will
        become congruent to other enodes, and a new equality will be propagated.
        Moreover, this method is also used for doing equality propagation.
 
@@ -605,11 +658,11 @@ namespace smt {
        js is a justification for n1 and n2 being equal, and the equality n1 = n2 is
        the one that implied r1 = r2.
     */
-    void context::reinsert_parents_into_cg_table(enode * r1, enode * r2, enode * n1, enode * n2, eq_justification js) {
+    void context::reinsert_parents_into_cg_table(unsigned lim, enode * r2, enode * n1, enode * n2, eq_justification js) {
         enode_vector & r2_parents  = r2->m_parents;
-        for (enode * parent : enode::parents(r1)) {
-            if (!parent->is_marked())
-                continue;
+        for (unsigned i = lim; i < m_cg_parents.size(); ++i) {
+            enode * parent = m_cg_parents[i];
+            SASSERT(parent->is_marked());
             parent->unset_mark();
             if (parent->is_eq()) {
                 SASSERT(parent->get_num_args() == 2);
@@ -656,6 +709,7 @@ namespace smt {
                 r2_parents.push_back(parent);
             }
         }
+        m_cg_parents.shrink(lim);
     }
 
     /**
@@ -1597,6 +1651,7 @@ namespace smt {
 
     bool context::propagate_theories() {
         for (theory * t : m_theory_set) {
+            phase_timer::scoped _pt(m_phase_timer, m_theory_phases[t->get_family_id()].m_propagate);
             t->propagate();
             if (inconsistent())
                 return false;
@@ -1673,6 +1728,7 @@ namespace smt {
      */
     bool context::propagate() {
         TRACE("propagate", tout << "propagating... " << m_qhead << ":" << m_assigned_literals.size() << "\n";);
+        phase_timer::scoped _pt(m_phase_timer, m_phase_propagate);
         while (true) {
             if (inconsistent())
                 return false;
@@ -1700,6 +1756,7 @@ namespace smt {
             }
             if (!get_cancel_flag()) {
                 scoped_suspend_rlimit _suspend_cancel(m.limit(), at_base_level());
+                phase_timer::scoped _pt(m_phase_timer, m_phase_ematching);
                 m_qmanager->propagate();
             }
             if (inconsistent())
@@ -1858,6 +1915,14 @@ namespace smt {
                     is_pos = m_lit_occs[l.index()] > m_lit_occs[(~l).index()];
                     break;
                 }
+                case PS_TARGET:
+                    if (var < static_cast<bool_var>(m_target_phase.size()) && m_target_phase[var] != l_undef) 
+                        is_pos = m_target_phase[var] == l_true;
+                    else if (d.m_phase_available) 
+                        is_pos = d.m_phase;
+                    else 
+                        is_pos = m_phase_default;
+                    break;
                 default:
                     is_pos = false;
                     UNREACHABLE();
@@ -1894,6 +1959,62 @@ namespace smt {
         }
     }
 
+    /**
+       \brief Record the phases of the current assignment when it is the largest 
+       assignment reached since the last rephase, or overall.
+       It is invoked before backjumping from a conflict.
+    */
+    void context::update_target_phase() {
+        unsigned sz = m_assigned_literals.size();
+        m_target_phase.reserve(get_num_bool_vars(), l_undef);
+        m_best_phase.reserve(get_num_bool_vars(), l_undef);
+        if (sz > m_target_assigned) {
+            m_target_assigned = sz;
+            for (literal lit : m_assigned_literals) 
+                m_target_phase[lit.var()] = lit.sign() ? l_false : l_true;
+        }
+        if (sz > m_best_assigned) {
+            m_best_assigned = sz;
+            for (literal lit : m_assigned_literals) 
+                m_best_phase[lit.var()] = lit.sign() ? l_false : l_true;
+        }
+    }
+
+    /**
+       \brief Reset the cached phases following a schedule similar to sat::solver::do_rephase.
+       The cached phases are alternately replaced by the best phases, flipped, 
+       replaced by the best phases again and left as is. The target phases 
+       are reset and the interval to the next rephase grows linearly.
+    */
+    void context::rephase() {
+        unsigned num_vars = get_num_bool_vars();
+        m_target_phase.reserve(num_vars, l_undef);
+        m_best_phase.reserve(num_vars, l_undef);
+        switch (m_rephase_count % 4) {
+        case 0:
+        case 2:
+            for (bool_var v = 0; v < num_vars; ++v) {
+                if (m_best_phase[v] != l_undef) {
+                    m_bdata[v].m_phase_available = true;
+                    m_bdata[v].m_phase = m_best_phase[v] == l_true;
+                }
+            }
+            break;
+        case 1:
+            for (bool_var v = 0; v < num_vars; ++v) 
+                m_bdata[v].m_phase = !m_bdata[v].m_phase;
+            break;
+        default:
+            break;
+        }
+        for (bool_var v = 0; v < num_vars; ++v) 
+            m_target_phase[v] = l_undef;
+        m_target_assigned = 0;
+        ++m_rephase_count;
+        m_rephase_lim = m_stats.m_num_conflicts + m_fparams.m_rephase_base * (m_rephase_count + 1);
+        IF_VERBOSE(10, verbose_stream() << "(smt.rephase " << m_rephase_count << ")\n";);
+    }
+
     /**
        \brief Create an internal backtracking point
     */
@@ -2446,6 +2567,43 @@ namespace smt {
         SASSERT(m_scope_lvl == m_base_lvl);
     }
 
+    /**
+       \brief Pop to the base level and remember the phase and activity of the 
+       atoms whose boolean variables are removed. They are restored when the 
+       atoms are internalized again in a later check.
+    */
+    void context::pop_to_base_lvl_saving_phases() {
+        flet<bool> _saving(m_saving_phases, m_fparams.m_phase_persist);
+        pop_to_base_lvl();
+    }
+
+    void context::save_phase(bool_var v, expr * n) {
+        bool_var_data const & d = m_bdata[v];
+        if (!d.m_phase_available && m_activity[v] <= 0)
+            return;
+        if (m_saved_phase_exprs.size() >= std::max(100000u, 2 * get_num_bool_vars())) {
+            m_saved_phases.reset();
+            m_saved_phase_exprs.reset();
+        }
+        saved_phase sp;
+        sp.m_phase_available = d.m_phase_available;
+        sp.m_phase           = d.m_phase;
+        sp.m_activity        = m_activity[v] / m_bvar_inc;
+        if (!m_saved_phases.contains(n))
+            m_saved_phase_exprs.push_back(n);
+        m_saved_phases.insert(n, sp);
+    }
+
+    void context::restore_phase(bool_var v, expr * n) {
+        saved_phase sp;
+        if (!m_saved_phases.find(n, sp))
+            return;
+        bool_var_data & d   = m_bdata[v];
+        d.m_phase_available = sp.m_phase_available;
+        d.m_phase           = sp.m_phase;
+        m_activity[v]       = sp.m_activity * m_bvar_inc;
+    }
+
     void context::pop_to_search_lvl() {
         if (m_scope_lvl > get_search_level()) {
             pop_scope(m_scope_lvl - get_search_level());
@@ -2662,16 +2820,47 @@ namespace smt {
         bool operator()(clause * cls1, clause * cls2) const { return cls1->get_activity() > cls2->get_activity(); }
     };
 
+    /**
+       \brief Return true if a lemma that would be deleted is kept because of its glue.
+       Lemmas in the core tier are always kept, lemmas in the second tier are
+       kept once and then move to the last tier.
+    */
+    bool context::keep_lemma_by_glue(clause * cls) {
+        unsigned glue = cls->get_glue();
+        if (glue <= m_fparams.m_lemma_gc_core_glue)
+            return true;
+        if (glue <= m_fparams.m_lemma_gc_tier2_glue) {
+            cls->set_glue(m_fparams.m_lemma_gc_tier2_glue + 1);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+       \brief Return true if lemma gc should run because the allocated memory exceeds smt.lemma_gc.max_memory.
+       The memory is checked every 100 conflicts and gc is not run more often than every 1000 conflicts.
+    */
+    bool context::lemma_gc_memory_exceeded() const {
+        return
+            m_fparams.m_lemma_gc_max_memory > 0 &&
+            m_num_conflicts_since_lemma_gc > 1000 &&
+            m_num_conflicts_since_lemma_gc % 100 == 0 &&
+            memory::get_allocation_size() > (static_cast<unsigned long long>(m_fparams.m_lemma_gc_max_memory) << 20);
+    }
+
     /**
        \brief Delete low activity lemmas
     */
     inline void context::del_inactive_lemmas() {
+        unsigned num_lemmas = m_lemmas.size();
         if (m_fparams.m_lemma_gc_strategy == LGC_NONE)
             return;
         else if (m_fparams.m_lemma_gc_half)
             del_inactive_lemmas1();
         else
             del_inactive_lemmas2();
+        if (event_trace::enabled())
+            event_trace::event("smt.gc")("conflicts", m_stats.m_num_conflicts)("deleted", num_lemmas - m_lemmas.size())("learned", m_lemmas.size());
 
         m_num_conflicts_since_lemma_gc = 0;
         if (m_fparams.m_lemma_gc_strategy == LGC_GEOMETRIC)
@@ -2700,7 +2889,7 @@ namespace smt {
               << ", start_del_at: " << start_del_at << "\n";);
         for (; i < end_at; i++) {
             clause * cls = m_lemmas[i];
-            if (can_delete(cls)) {
+            if (can_delete(cls) && !keep_lemma_by_glue(cls)) {
                 TRACE("del_inactive_lemmas", tout << "deleting: "; display_clause(tout, cls); tout << ", activity: " <<
                       cls->get_activity() << "\n";);
                 del_clause(true, cls);
@@ -2767,7 +2956,7 @@ namespace smt {
                     (m_fparams.m_old_clause_activity - m_fparams.m_new_clause_activity) * ((i - start_at) / real_sz);
                 if (cls->get_activity() < act_threshold) {
                     unsigned rel_threshold = (i >= new_first_idx ? m_fparams.m_new_clause_relevancy : m_fparams.m_old_clause_relevancy);
-                    if (more_than_k_unassigned_literals(cls, rel_threshold)) {
+                    if (more_than_k_unassigned_literals(cls, rel_threshold) && !keep_lemma_by_glue(cls)) {
                         del_clause(true, cls);
                         num_del_cls++;
                         continue;
@@ -2835,6 +3024,15 @@ namespace smt {
         m_theories.register_plugin(th);
         th->init();
         m_theory_set.push_back(th);
+        theory_phases ph;
+        std::string name(th->get_name());
+        ph.m_propagate   = m_phase_timer.mk_phase(("propagate." + name).c_str());
+        ph.m_final_check = m_phase_timer.mk_phase(("final_check." + name).c_str());
+        ph.m_internalize = m_phase_timer.mk_phase(("internalize." + name).c_str());
+        ph.m_explain     = m_phase_timer.mk_phase(("conflict.explain." + name).c_str());
+        theory_phases none = { UINT_MAX, UINT_MAX, UINT_MAX, UINT_MAX };
+        m_theory_phases.reserve(th->get_family_id() + 1, none);
+        m_theory_phases[th->get_family_id()] = ph;
         {
 #ifdef Z3DEBUG
             // It is unsafe to invoke push_trail from the method push_scope_eh.
@@ -2871,6 +3069,7 @@ namespace smt {
     void context::pop(unsigned num_scopes) {
         SASSERT (num_scopes > 0);
         if (num_scopes > m_scope_lvl) return;
+        flet<bool> _saving(m_saving_phases, m_fparams.m_phase_persist);
         pop_to_base_lvl();
         pop_scope(num_scopes);
     }
@@ -3083,7 +3282,24 @@ namespace smt {
         if (get_cancel_flag()) return;
         TRACE("internalize_assertions", tout << "internalize_assertions()...\n";);
         timeit tt(get_verbosity_level() >= 100, "smt.preprocessing");
-        reduce_assertions();
+        if (!m_asserted_formulas.inconsistent()) {
+            unsigned qhead = m_asserted_formulas.get_qhead();
+            unsigned lim   = m_asserted_formulas.get_reduced_lim();
+            // formulas copied from a context that simplified them already.
+            for (; qhead < lim; ++qhead) {
+                if (get_cancel_flag()) {
+                    m_asserted_formulas.commit(qhead);
+                    return;
+                }
+                internalize_assertion(m_asserted_formulas.get_formula(qhead), m_asserted_formulas.get_formula_proof(qhead), 0);
+            }
+            if (qhead > m_asserted_formulas.get_qhead()) 
+                m_asserted_formulas.commit(qhead);
+        }
+        {
+            phase_timer::scoped _pt(m_phase_timer, m_phase_preprocess);
+            reduce_assertions();
+        }
         if (!m_asserted_formulas.inconsistent()) {
             unsigned sz    = m_asserted_formulas.get_num_formulas();
             unsigned qhead = m_asserted_formulas.get_qhead();
@@ -3313,7 +3529,12 @@ namespace smt {
         reset_tmp_clauses();
         m_unsat_core.reset();
         m_stats.m_num_checks++;
-        pop_to_base_lvl();      
+        m_phase_timer.set_enabled(m_fparams.m_phase_timing);
+        pop_to_base_lvl_saving_phases();
+        // Assumptions are decisions above the base level, so learned clauses and 
+        // theory lemmas never depend on them. The lemmas that survived the previous 
+        // checks are carried over to this one.
+        m_stats.m_num_retained_lemmas += m_lemmas.size();
         m_conflict_resolution->reset();
         return true;
     }
@@ -3421,6 +3642,12 @@ namespace smt {
         SASSERT(!m_setup.already_configured());
         setup_context(m_fparams.m_auto_config);
 
+        lbool r;
+        if (m_fparams.m_solve_components && !m.proofs_enabled() && !m.has_trace_stream() && 
+            m_base_lvl == 0 && components(*this)(r)) {
+            return r;
+        }
+
         if (m_fparams.m_threads > 1 && !m.has_trace_stream()) {
             parallel p(*this);
             expr_ref_vector asms(m);
@@ -3461,6 +3688,7 @@ namespace smt {
     void context::setup_components() {
         m_asserted_formulas.setup();
         m_random.set_seed(m_fparams.m_random_seed);
+        m_fingerprints.set_max_size(m_fparams.m_qi_max_fingerprints);
         m_dyn_ack_manager.setup();
         m_conflict_resolution->setup();
 
@@ -3482,12 +3710,16 @@ namespace smt {
         if (!check_preamble(reset_cancel)) return l_undef;
         SASSERT(at_base_level());
         setup_context(false);
+        lbool r;
+        if (m_fparams.m_solve_components && num_assumptions == 0 && !m.proofs_enabled() && 
+            !m.has_trace_stream() && m_base_lvl == 0 && components(*this)(r)) {
+            return r;
+        }
         if (m_fparams.m_threads > 1 && !m.has_trace_stream()) {            
             expr_ref_vector asms(m, num_assumptions, assumptions);
             parallel p(*this);
             return p(asms);
         }
-        lbool r;
         do {
             pop_to_base_lvl();
             expr_ref_vector asms(m, num_assumptions, assumptions);
@@ -3539,6 +3771,9 @@ namespace smt {
         m_restart_threshold            = m_fparams.m_restart_initial;
         m_restart_outer_threshold      = m_fparams.m_restart_initial;
         m_agility                      = 0.0;
+        m_fast_glue_avg                = ema(3e-2);
+        m_slow_glue_avg                = ema(1e-5);
+        m_trail_avg                    = ema(1e-4);
         m_luby_idx                     = 1;
         m_lemma_gc_threshold           = m_fparams.m_lemma_gc_initial;
         m_last_search_failure          = OK;
@@ -3547,6 +3782,8 @@ namespace smt {
         m_dyn_ack_manager              .init_search_eh();
         m_final_check_idx              = 0;
         m_phase_default                = false;
+        m_target_assigned              = 0;
+        m_rephase_lim                  = m_stats.m_num_conflicts + m_fparams.m_rephase_base;
         m_case_split_queue             ->init_search_eh();
         m_next_progress_sample         = 0;
         TRACE("literal_occ", display_literal_num_occs(tout););
@@ -3578,6 +3815,9 @@ namespace smt {
             case RS_ARITHMETIC:
                 m_restart_threshold = static_cast<unsigned>(m_restart_threshold + m_fparams.m_restart_factor);
                 break;
+            case RS_EMA:
+                // the threshold is the minimal number of conflicts between restarts.
+                break;
             default:
                 break;
             }
@@ -3586,6 +3826,36 @@ namespace smt {
     }
 
 
+    bool context::should_restart() const {
+        if (m_num_conflicts_since_restart <= m_restart_threshold || m_scope_lvl - m_base_lvl <= 2)
+            return false;
+        if (m_fparams.m_restart_strategy != RS_EMA)
+            return true;
+        return 
+            m_fast_glue_avg + m_base_lvl <= m_scope_lvl &&
+            m_fparams.m_restart_margin * m_slow_glue_avg <= m_fast_glue_avg;
+    }
+
+    /**
+       \brief update the moving averages of the glue (number of distinct levels)
+       of the conflict clause and of the number of assigned literals.
+       A conflict with many more assigned literals than average may be close
+       to a model, so the next restart is postponed (blocked).
+    */
+    void context::update_glue_avg(unsigned glue) {
+        m_fast_glue_avg.update(glue);
+        m_slow_glue_avg.update(glue);
+
+        double trail = static_cast<double>(m_assigned_literals.size());
+        if (m_stats.m_num_conflicts > 10000 && 
+            m_num_conflicts_since_restart > m_restart_threshold &&
+            trail > m_fparams.m_restart_blocking * m_trail_avg) {
+            m_num_conflicts_since_restart = 0;
+            m_stats.m_num_blocked_restarts++;
+        }
+        m_trail_avg.update(trail);
+    }
+
     lbool context::search() {
         if (m_asserted_formulas.inconsistent()) {
             asserted_inconsistent();
@@ -3666,7 +3936,8 @@ namespace smt {
             }
         }
         inc_limits();
-        if (status == l_true || !m_fparams.m_restart_adaptive || m_agility < m_fparams.m_restart_agility_threshold) {
+        if (status == l_true || !m_fparams.m_restart_adaptive || m_fparams.m_restart_strategy == RS_EMA || 
+            m_agility < m_fparams.m_restart_agility_threshold) {
             SASSERT(!inconsistent());
             IF_VERBOSE(2, verbose_stream() << "(smt.restarting :propagations " << m_stats.m_num_propagations
                        << " :decisions " << m_stats.m_num_decisions
@@ -3681,6 +3952,10 @@ namespace smt {
             // execute the restart
             m_stats.m_num_restarts++;
             m_num_restarts++;
+            if (event_trace::enabled())
+                event_trace::event("smt.restart")("restarts", m_stats.m_num_restarts)("conflicts", m_stats.m_num_conflicts)("decisions", m_stats.m_num_decisions)("level", m_scope_lvl);
+            if (m_fparams.m_phase_selection == PS_TARGET && m_stats.m_num_conflicts >= m_rephase_lim) 
+                rephase();
             if (m_scope_lvl > curr_lvl) {
                 pop_scope(m_scope_lvl - curr_lvl);
                 SASSERT(at_search_level());
@@ -3707,6 +3982,13 @@ namespace smt {
             simplify_clauses();
         if (m_fparams.m_lemma_gc_strategy == LGC_AT_RESTART)
             del_inactive_lemmas();
+        if (memory::above_high_watermark()) {
+            unsigned num_caches = memory::shrink_caches();
+            if (m_fparams.m_lemma_gc_strategy != LGC_AT_RESTART)
+                del_inactive_lemmas();
+            IF_VERBOSE(2, verbose_stream() << "(smt.memory-pressure :caches " << num_caches
+                       << " :memory " << (memory::get_allocation_size() >> 20) << "MB)\n";);
+        }
 
         status = l_undef;
         return true;
@@ -3755,7 +4037,7 @@ namespace smt {
                     if (get_cancel_flag())
                         return l_undef;
 
-                    if (m_num_conflicts_since_restart > m_restart_threshold && m_scope_lvl - m_base_lvl > 2) {
+                    if (should_restart()) {
                         TRACE("search_bug", tout << "bounded-search return undef, inconsistent: " << inconsistent() << "\n";);
                         return l_undef; // restart
                     }
@@ -3767,7 +4049,7 @@ namespace smt {
                     }
                 }
 
-                if (m_num_conflicts_since_lemma_gc > m_lemma_gc_threshold &&
+                if ((m_num_conflicts_since_lemma_gc > m_lemma_gc_threshold || lemma_gc_memory_exceeded()) &&
                     (m_fparams.m_lemma_gc_strategy == LGC_FIXED || m_fparams.m_lemma_gc_strategy == LGC_GEOMETRIC)) {
                     del_inactive_lemmas();
                 }
@@ -3843,6 +4125,7 @@ namespace smt {
 
     final_check_status context::final_check() {
         TRACE("final_check", tout << "final_check inconsistent: " << inconsistent() << "\n"; display(tout); display_normalized_enodes(tout););
+        phase_timer::scoped _pt(m_phase_timer, m_phase_final_check);
         CASSERT("relevancy", check_relevancy());
         
         if (m_fparams.m_model_on_final_check) {
@@ -3873,6 +4156,7 @@ namespace smt {
             if (m_final_check_idx < num_th) {
                 theory * th = m_theory_set[m_final_check_idx];
                 IF_VERBOSE(100, verbose_stream() << "(smt.final-check \"" << th->get_name() << "\")\n";);
+                phase_timer::scoped _pt(m_phase_timer, m_theory_phases[th->get_family_id()].m_final_check);
                 ok = th->final_check_eh();
                 TRACE("final_check_step", tout << "final check '" << th->get_name() << " ok: " << ok << " inconsistent " << inconsistent() << "\n";);
                 if (ok == FC_GIVEUP) {
@@ -3935,6 +4219,7 @@ namespace smt {
     }
 
     bool context::resolve_conflict() {
+        phase_timer::scoped _pt(m_phase_timer, m_phase_conflict);
         m_stats.m_num_conflicts++;
         m_num_conflicts ++;
         m_num_conflicts_since_restart ++;
@@ -3951,6 +4236,8 @@ namespace smt {
             m_fparams.m_phase_selection == PS_CACHING_CONSERVATIVE || 
             m_fparams.m_phase_selection == PS_CACHING_CONSERVATIVE2)
             forget_phase_of_vars_in_current_level();
+        if (m_fparams.m_phase_selection == PS_TARGET)
+            update_target_phase();
         m_atom_propagation_queue.reset();
         m_eq_propagation_queue.reset();
         m_th_eq_propagation_queue.reset();
@@ -3963,6 +4250,10 @@ namespace smt {
             SASSERT(num_lits > 0);
             unsigned conflict_lvl = get_assign_level(lits[0]);
             SASSERT(conflict_lvl <= m_scope_lvl);
+            if (m_fparams.m_restart_strategy == RS_EMA)
+                update_glue_avg(m_conflict_resolution->get_lemma_glue());
+            if (event_trace::enabled())
+                event_trace::event("smt.conflict")("conflicts", m_stats.m_num_conflicts)("size", num_lits)("level", conflict_lvl)("backjump", new_lvl);
 
             // When num_lits == 1, then the default behavior is to go
             // to base-level. If the problem has quantifiers, it may be
@@ -4116,7 +4407,9 @@ namespace smt {
                 }
             }
 #endif
-            mk_clause(num_lits, lits, js, CLS_LEARNED);
+            clause * cls = mk_clause(num_lits, lits, js, CLS_LEARNED);
+            if (cls)
+                cls->set_glue(m_conflict_resolution->get_lemma_glue());
             if (delay_forced_restart) {
                 SASSERT(num_lits == 1);
                 expr * unit     = bool_var2expr(lits[0].var());
@@ -4443,6 +4736,7 @@ namespace smt {
 
     void context::mk_proto_model() {
         if (m_model || m_proto_model || has_case_splits()) return;
+        phase_timer::scoped _pt(m_phase_timer, m_phase_model);
         TRACE("get_model",
               display(tout);
               display_normalized_enodes(tout);
@@ -49,7 +49,9 @@ Revision History:
 #include "smt/proto_model/proto_model.h"
 #include "model/model.h"
 #include "util/timer.h"
+#include "util/ema.h"
 #include "util/statistics.h"
+#include "util/phase_timer.h"
 #include "solver/progress_callback.h"
 #include <tuple>
 
@@ -71,6 +73,7 @@ namespace smt {
         friend class model_generator;
         friend class lookahead;
         friend class parallel;
+        friend class components;
     public:
         statistics                  m_stats;
 
@@ -131,6 +134,7 @@ namespace smt {
         vector<enode_vector>        m_decl2enodes;  // decl -> enode (for decls with arity > 0)
         enode_vector                m_empty_vector;
         cg_table                    m_cg_table;
+        enode_vector                m_cg_parents;   // parents removed from m_cg_table during add_eq
         struct new_eq {
             enode *                 m_lhs;
             enode *                 m_rhs;
@@ -192,6 +196,36 @@ namespace smt {
         bool                        m_phase_cache_on;
         unsigned                    m_phase_counter; //!< auxiliary variable used to decide when to turn on/off phase caching
         bool                        m_phase_default; //!< default phase when using phase caching
+        struct saved_phase {
+            bool   m_phase_available;
+            bool   m_phase;
+            double m_activity;      //!< activity relative to m_bvar_inc
+        };
+        obj_map<expr, saved_phase>  m_saved_phases;   //!< phase and activity of atoms removed when popping to the base level
+        expr_ref_vector             m_saved_phase_exprs;
+        bool                        m_saving_phases;
+        svector<lbool>              m_target_phase;    //!< phases of the largest conflict-free assignment since the last rephase
+        svector<lbool>              m_best_phase;      //!< phases of the largest conflict-free assignment so far
+        unsigned                    m_target_assigned;
+        unsigned                    m_best_assigned;
+        unsigned                    m_rephase_count;
+        unsigned                    m_rephase_lim;
+
+        phase_timer                 m_phase_timer;     //!< time and allocations of the phases below, when phase_timing is set
+        unsigned                    m_phase_preprocess;
+        unsigned                    m_phase_internalize;
+        unsigned                    m_phase_propagate;
+        unsigned                    m_phase_conflict;
+        unsigned                    m_phase_ematching;
+        unsigned                    m_phase_final_check;
+        unsigned                    m_phase_model;
+        struct theory_phases {
+            unsigned m_propagate;
+            unsigned m_final_check;
+            unsigned m_internalize;
+            unsigned m_explain;     //!< computing the antecedents of theory justifications in conflict resolution
+        };
+        svector<theory_phases>      m_theory_phases;   //!< phases of each theory, indexed by family id
 
         // A conflict is usually a single justification. That is, a justification
         // for false. If m_not_l is not null_literal, then m_conflict is a
@@ -262,6 +296,17 @@ namespace smt {
             return m_params;
         }
 
+        phase_timer & get_phase_timer() {
+            return m_phase_timer;
+        }
+
+        /**
+           \brief phase for explaining justifications of theory th, UINT_MAX if th is not a theory.
+        */
+        unsigned get_explain_phase(theory_id th) const {
+            return 0 <= th && static_cast<unsigned>(th) < m_theory_phases.size() ? m_theory_phases[th].m_explain : UINT_MAX;
+        }
+
         void updt_params(params_ref const& p);
 
         bool get_cancel_flag();
@@ -783,6 +828,12 @@ namespace smt {
         mk_bool_var_trail   m_mk_bool_var_trail;
         void undo_mk_bool_var();
 
+        void save_phase(bool_var v, expr * n);
+
+        void restore_phase(bool_var v, expr * n);
+
+        void pop_to_base_lvl_saving_phases();
+
         friend class mk_enode_trail;
         class mk_enode_trail : public trail<context> {
         public:
@@ -947,8 +998,14 @@ namespace smt {
         unsigned           m_restart_outer_threshold;
         unsigned           m_luby_idx;
         double             m_agility;
+        ema                m_fast_glue_avg;   // for RS_EMA
+        ema                m_slow_glue_avg;
+        ema                m_trail_avg;
         unsigned           m_lemma_gc_threshold;
 
+        void update_glue_avg(unsigned glue);
+        bool should_restart() const;
+
         void assign_core(literal l, b_justification j, bool decision = false);
         void trace_assign(literal l, b_justification j, bool decision) const;
 
@@ -1024,7 +1081,7 @@ namespace smt {
 
         void remove_parents_from_cg_table(enode * r1);
 
-        void reinsert_parents_into_cg_table(enode * r1, enode * r2, enode * n1, enode * n2, eq_justification js);
+        void reinsert_parents_into_cg_table(unsigned lim, enode * r2, enode * n1, enode * n2, eq_justification js);
 
         void invert_trans(enode * n);
 
@@ -1095,6 +1152,10 @@ namespace smt {
 
         void update_phase_cache_counter();
 
+        void update_target_phase();
+
+        void rephase();
+
 #define ACTIVITY_LIMIT 1e100
 #define INV_ACTIVITY_LIMIT 1e-100
 
@@ -1141,6 +1202,10 @@ namespace smt {
             return !is_justifying(cls);
         }
 
+        bool keep_lemma_by_glue(clause * cls);
+
+        bool lemma_gc_memory_exceeded() const;
+
         void del_inactive_lemmas();
 
         void del_inactive_lemmas1();
@@ -383,6 +383,8 @@ namespace smt {
         st.update("propagations", m_stats.m_num_propagations + m_stats.m_num_bin_propagations);
         st.update("binary propagations", m_stats.m_num_bin_propagations);
         st.update("restarts", m_stats.m_num_restarts);
+        if (m_stats.m_num_blocked_restarts > 0)
+            st.update("blocked restarts", m_stats.m_num_blocked_restarts);
         st.update("final checks", m_stats.m_num_final_checks);
         st.update("added eqs", m_stats.m_num_add_eq);
         st.update("mk clause", m_stats.m_num_mk_clause);
@@ -392,7 +394,10 @@ namespace smt {
         st.update("max generation", m_stats.m_max_generation);
         st.update("minimized lits", m_stats.m_num_minimized_lits);
         st.update("num checks", m_stats.m_num_checks);
+        st.update("retained lemmas", m_stats.m_num_retained_lemmas);
         st.update("mk bool var", m_stats.m_num_mk_bool_var);
+        if (m_fingerprints.size() > 0)
+            st.update("fingerprints", m_fingerprints.size());
 
 #if 0
         // missing?
@@ -406,6 +411,7 @@ namespace smt {
         st.update("backwd subs res", m_stats.m_num_bsr);
         st.update("frwrd subs res", m_stats.m_num_fsr);
 #endif
+        m_phase_timer.collect_statistics(st);
         m_qmanager->collect_statistics(st);
         m_asserted_formulas.collect_statistics(st);
         for (theory* th : m_theory_set) {
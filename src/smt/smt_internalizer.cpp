@@ -212,6 +212,7 @@ namespace smt {
         TRACE("internalize_assertion_ll", tout << mk_ll_pp(n, m) << "\n";); 
         TRACE("generation", tout << "generation: " << m_generation << "\n";);
         TRACE("incompleteness_bug", tout << "[internalize-assertion]: #" << n->get_id() << "\n";);
+        phase_timer::scoped _pt(m_phase_timer, m_phase_internalize);
         flet<unsigned> l(m_generation, generation);
         m_stats.m_max_generation = std::max(m_generation, m_stats.m_max_generation);
         internalize_deep(n);
@@ -316,6 +317,7 @@ namespace smt {
     }
 
     void context::internalize(expr * n, bool gate_ctx, unsigned generation) {
+        phase_timer::scoped _pt(m_phase_timer, m_phase_internalize);
         flet<unsigned> l(m_generation, generation);
         m_stats.m_max_generation = std::max(m_generation, m_stats.m_max_generation);
         internalize_rec(n, gate_ctx);
@@ -333,6 +335,7 @@ namespace smt {
        - gate_ctx is true if the expression is in the context of a logical gate.
     */
     void context::internalize(expr * n, bool gate_ctx) {
+        phase_timer::scoped _pt(m_phase_timer, m_phase_internalize);
         internalize_deep(n);
         internalize_rec(n, gate_ctx);
     }
@@ -467,7 +470,10 @@ namespace smt {
         SASSERT(!b_internalized(n));
         theory * th  = m_theories.get_plugin(n->get_family_id());
         TRACE("datatype_bug", tout << "internalizing theory atom:\n" << mk_pp(n, m) << "\n";);
-        if (!th || !th->internalize_atom(n, gate_ctx))
+        if (!th)
+            return false;
+        phase_timer::scoped _pt(m_phase_timer, m_theory_phases[th->get_family_id()].m_internalize);
+        if (!th->internalize_atom(n, gate_ctx))
             return false;
         TRACE("datatype_bug", tout << "internalization succeeded\n" << mk_pp(n, m) << "\n";);
         SASSERT(b_internalized(n));
@@ -842,9 +848,10 @@ namespace smt {
     */
     bool context::internalize_theory_term(app * n) {
         theory * th  = m_theories.get_plugin(n->get_family_id());
-        if (!th || !th->internalize_term(n))
+        if (!th)
             return false;
-        return true;
+        phase_timer::scoped _pt(m_phase_timer, m_theory_phases[th->get_family_id()].m_internalize);
+        return th->internalize_term(n);
     }
 
     /**
@@ -900,6 +907,14 @@ namespace smt {
             m_activity[v]      = -((m_random() % 1000) / 1000.0); 
         else
             m_activity[v]      = 0.0;
+        if (m_fparams.m_phase_selection == PS_TARGET) {
+            m_target_phase.reserve(v+1, l_undef);
+            m_best_phase.reserve(v+1, l_undef);
+            m_target_phase[v] = l_undef;
+            m_best_phase[v]   = l_undef;
+        }
+        if (!m_saved_phases.empty())
+            restore_phase(v, n);
         m_case_split_queue->mk_var_eh(v);
         m_b_internalized_stack.push_back(n);
         m_trail_stack.push_back(&m_mk_bool_var_trail);
@@ -919,6 +934,8 @@ namespace smt {
               << " m_assignment.size: " << m_assignment.size() << "\n";);
         TRACE("mk_var_bug", tout << "undo_mk_bool: " << v << "\n";);
         // bool_var_data & d     = m_bdata[v];
+        if (m_saving_phases)
+            save_phase(v, n);
         m_case_split_queue->del_var_eh(v);
         if (is_quantifier(n))
             m_qmanager->del(to_quantifier(n));
@@ -49,6 +49,7 @@ namespace smt {
         m_iteration_idx(0),
         m_curr_model(nullptr),
         m_fresh_exprs(m),
+        m_satisfied_pinned(m),
         m_pinned_exprs(m) {
     }
 
@@ -158,18 +159,16 @@ namespace smt {
 
     /**
        \brief Assert the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
+       body is the body of q under m_curr_model.
 
        The variables are replaced by skolem constants. These constants are stored in sks.
     */
 
-    void model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
-        expr_ref tmp(m);
+    void model_checker::assert_neg_q_m(quantifier * q, expr * body, expr_ref_vector & sks) {
+        expr_ref tmp(body, m);
         
         TRACE("model_checker", tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
 
-        if (!m_curr_model->eval(q->get_expr(), tmp, true)) {
-            return;
-        }
         TRACE("model_checker", tout << "q after applying interpretation:\n" << mk_ismt2_pp(tmp, m) << "\n";);
         ptr_buffer<expr> subst_args;
         unsigned num_decls = q->get_num_decls();
@@ -321,25 +320,54 @@ namespace smt {
         ~scoped_ctx_push() { c->pop(1); }
     };
 
+    /**
+       \brief The check of q depends only on the body of q under the
+       current model, unless the skolem constants are restricted to the
+       universe of a finite sort.
+    */
+    bool model_checker::is_cacheable(quantifier * q) const {
+        for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+            if (m_curr_model->is_finite(q->get_decl_sort(i)))
+                return false;
+        }
+        return true;
+    }
+
     /**
        \brief Return true if q is satisfied by m_curr_model.
+
+       Bodies that were found valid are remembered, so quantifiers whose
+       model instance did not change since a previous round are not
+       checked again.
     */
 
     bool model_checker::check(quantifier * q) {
         SASSERT(!m_aux_context->relevancy());
-        scoped_ctx_push _push(m_aux_context.get());
 
         quantifier * flat_q = get_flat_quantifier(q);
         TRACE("model_checker", tout << "model checking:\n" << expr_ref(flat_q->get_expr(), m) << "\n";);
         expr_ref_vector sks(m);
+        expr_ref body(m);
+        bool has_body = m_curr_model->eval(flat_q->get_expr(), body, true);
+        bool cacheable = has_body && is_cacheable(flat_q);
+        if (cacheable && m_satisfied.contains(body)) {
+            TRACE("model_checker", tout << "cached: " << body << "\n";);
+            return true;
+        }
 
-        assert_neg_q_m(flat_q, sks);
+        scoped_ctx_push _push(m_aux_context.get());
+        if (has_body)
+            assert_neg_q_m(flat_q, body, sks);
         TRACE("model_checker", tout << "skolems:\n" << sks << "\n";);
 
         flet<bool> l(m_aux_context->get_fparams().m_array_fake_support, true);
         lbool r = m_aux_context->check();
         TRACE("model_checker", tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
         if (r != l_true) {
+            if (r == l_false && cacheable) {
+                m_satisfied.insert(body);
+                m_satisfied_pinned.push_back(body);
+            }
             return r == l_false; // quantifier is satisfied by m_curr_model
         }
 
@@ -494,6 +522,8 @@ namespace smt {
     void model_checker::init_search_eh() {
         m_max_cexs = m_params.m_mbqi_max_cexs;
         m_iteration_idx = 0;
+        m_satisfied.reset();
+        m_satisfied_pinned.reset();
     }
 
     void model_checker::restart_eh() {
@@ -54,6 +54,8 @@ namespace smt {
         proto_model *                               m_curr_model;
         obj_map<expr, expr *>                       m_value2expr;
         expr_ref_vector                             m_fresh_exprs;
+        obj_hashtable<expr>                         m_satisfied;   // model instances of bodies known to be valid
+        expr_ref_vector                             m_satisfied_pinned;
 
         friend class instantiation_set;
 
@@ -63,7 +65,8 @@ namespace smt {
         expr * get_type_compatible_term(expr * val);
         expr_ref replace_value_from_ctx(expr * e);
         void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe);
-        void assert_neg_q_m(quantifier * q, expr_ref_vector & sks);
+        void assert_neg_q_m(quantifier * q, expr * body, expr_ref_vector & sks);
+        bool is_cacheable(quantifier * q) const;
         bool add_blocking_clause(model * cex, expr_ref_vector & sks);
         bool check(quantifier * q);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
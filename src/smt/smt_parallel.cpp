@@ -17,6 +17,7 @@ Author:
 
 
 #include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
 #include "ast/ast_util.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_translation.h"
@@ -35,6 +36,7 @@ namespace smt {
 #else
 
 #include <thread>
+#include <atomic>
 
 namespace smt {
     
@@ -70,8 +72,6 @@ namespace smt {
         std::string        ex_msg;
         par_exception_kind ex_kind = DEFAULT_EX;
         unsigned error_code = 0;
-        bool done = false;
-        unsigned num_rounds = 0;
         if (m.has_trace_stream())
             throw default_exception("trace streams have to be off in parallel mode");
 
@@ -91,77 +91,113 @@ namespace smt {
             sl.push_child(&(new_m->limit()));
         }
 
+        // with threads.int_split, branch on a fractional integer variable 
+        // of the last LP solution before falling back to lookahead.
         auto cube = [](context& ctx, expr_ref_vector& lasms, expr_ref& c) {
-            lookahead lh(ctx);
-            c = lh.choose();
+            c = nullptr;
+            if (ctx.get_fparams().m_threads_int_split) {
+                for (theory* th : ctx.theories()) {
+                    c = th->mk_split_atom();
+                    if (c) break;
+                }
+                // alternate the branch between rounds
+                if (c && (ctx.get_random_value() & 1))
+                    c = ctx.m.mk_not(c);
+            }
+            if (!c) {
+                lookahead lh(ctx);
+                c = lh.choose();
+            }
             if (c) lasms.push_back(c);
         };
 
         obj_hashtable<expr> unit_set;
         expr_ref_vector unit_trail(ctx.m);
-        unsigned_vector unit_lim;
+        unsigned_vector unit_lim, local_lim;
         for (unsigned i = 0; i < num_threads; ++i) unit_lim.push_back(0);
+        for (unsigned i = 0; i < num_threads; ++i) local_lim.push_back(0);
 
-        std::function<void(void)> collect_units = [&,this]() {
-            for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
-                pctx.pop_to_base_lvl();
-                ast_translation tr(pctx.m, ctx.m);
-                unsigned sz = pctx.assigned_literals().size();
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
-                    literal lit = pctx.assigned_literals()[j];
-                    expr_ref e(pctx.bool_var2expr(lit.var()), pctx.m);
-                    if (lit.sign()) e = pctx.m.mk_not(e);
-                    expr_ref ce(tr(e.get()), ctx.m);
-                    if (!unit_set.contains(ce)) {
-                        unit_set.insert(ce);
-                        unit_trail.push_back(ce);
-                    }
-                }
-            }
+        std::mutex mux;
 
-            unsigned sz = unit_trail.size();
-            for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
-                ast_translation tr(ctx.m, pctx.m);
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
-                    expr_ref src(ctx.m), dst(pctx.m);
-                    dst = tr(unit_trail.get(j));
-                    pctx.assert_expr(dst);
+        // 
+        // exchange units between thread i and the shared unit trail.
+        // Only thread i touches pctxs[i] and pms[i], the main manager 
+        // and the shared trail are protected by mux.
+        // 
+        std::function<void(unsigned)> share_units = [&,this](unsigned i) {
+            context& pctx = *pctxs[i];
+            pctx.pop_to_base_lvl();
+            std::lock_guard<std::mutex> lock(mux);
+            ast_translation tr(pctx.m, ctx.m);
+            unsigned sz = pctx.assigned_literals().size();
+            for (unsigned j = local_lim[i]; j < sz; ++j) {
+                literal lit = pctx.assigned_literals()[j];
+                expr_ref e(pctx.bool_var2expr(lit.var()), pctx.m);
+                if (lit.sign()) e = pctx.m.mk_not(e);
+                expr_ref ce(tr(e.get()), ctx.m);
+                if (!unit_set.contains(ce)) {
+                    unit_set.insert(ce);
+                    unit_trail.push_back(ce);
                 }
-                unit_lim[i] = sz;
             }
+            ast_translation tr2(ctx.m, pctx.m);
+            for (unsigned j = unit_lim[i]; j < unit_trail.size(); ++j) {
+                expr_ref dst(pctx.m);
+                dst = tr2(unit_trail.get(j));
+                pctx.assert_expr(dst);
+            }
+            unit_lim[i] = unit_trail.size();
+            local_lim[i] = pctx.assigned_literals().size();
         };
 
-        std::mutex mux;
+        std::atomic<bool> done(false);
 
+        // 
+        // Each thread runs its own sequence of rounds with increasing conflict budgets.
+        // Between rounds it exchanges units and picks a new cube without waiting
+        // for the other threads.
+        // 
         auto worker_thread = [&](int i) {
             try {
                 context& pctx = *pctxs[i];
                 ast_manager& pm = *pms[i];
-                expr_ref_vector lasms(pasms[i]);
-                expr_ref c(pm);
-
-                pctx.get_fparams().m_max_conflicts = std::min(thread_max_conflicts, max_conflicts);
-                if (num_rounds > 0) {
-                    cube(pctx, lasms, c);
-                }
-                IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i; 
-                           if (num_rounds > 0) verbose_stream() << " :round " << num_rounds;
-                           if (c) verbose_stream() << " :cube: " << mk_pp(c, pm);
-                           verbose_stream() << ")\n";);
-                lbool r = pctx.check(lasms.size(), lasms.c_ptr());
-                
-                if (r == l_undef && pctx.m_num_conflicts >= max_conflicts) {
-                    // no-op
+                unsigned num_rounds = 0;
+                unsigned thread_max_c = thread_max_conflicts;
+                unsigned max_c = max_conflicts;
+                lbool r = l_undef;
+                while (!done) {
+                    expr_ref_vector lasms(pasms[i]);
+                    expr_ref c(pm);
+
+                    pctx.get_fparams().m_max_conflicts = std::min(thread_max_c, max_c);
+                    if (num_rounds > 0) {
+                        cube(pctx, lasms, c);
+                    }
+                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i; 
+                               if (num_rounds > 0) verbose_stream() << " :round " << num_rounds;
+                               if (c) verbose_stream() << " :cube: " << mk_pp(c, pm);
+                               verbose_stream() << ")\n";);
+                    r = pctx.check(lasms.size(), lasms.c_ptr());
+
+                    if (r == l_undef && pctx.m_num_conflicts >= max_c) {
+                        break;
+                    }
+                    else if (r == l_undef && pctx.m_num_conflicts >= thread_max_c) {
+                        // continue with next round
+                    }
+                    else if (r == l_false && pctx.unsat_core().contains(c)) {
+                        pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
+                    }
+                    else {
+                        break;
+                    }
+                    share_units(i);
+                    ++num_rounds;
+                    max_c = (max_c < thread_max_c) ? 0 : (max_c - thread_max_c);
+                    thread_max_c *= 2;
                 }
-                else if (r == l_undef && pctx.m_num_conflicts >= thread_max_conflicts) {
-                    return;
-                }                
-                else if (r == l_false && pctx.unsat_core().contains(c)) {
-                    pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
-                    return;
-                } 
+                IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :rounds " << num_rounds 
+                           << " :conflicts " << pctx.m_num_conflicts << " :result " << r << ")\n";);
 
                 bool first = false;
                 {
@@ -198,21 +234,7 @@ namespace smt {
 
         // for debugging:  num_threads = 1;
 
-        while (true) {
-            vector<std::thread> threads(num_threads);
-            for (unsigned i = 0; i < num_threads; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
-            for (auto & th : threads) {
-                th.join();
-            }
-            if (done) break;
-
-            collect_units();
-            ++num_rounds;
-            max_conflicts = (max_conflicts < thread_max_conflicts) ? 0 : (max_conflicts - thread_max_conflicts);
-            thread_max_conflicts *= 2;            
-        }
+        thread_pool::run(num_threads, worker_thread);
 
         for (context* c : pctxs) {
             c->collect_statistics(ctx.m_aux_stats);
@@ -226,6 +226,7 @@ namespace {
             if (!m_minimizing_core && smt_params_helper(get_params()).core_minimize()) {
                 scoped_minimize_core scm(*this);
                 mus mus(*this);
+                mus.set_quickxplain(smt_params_helper(get_params()).core_minimize_quickxplain());
                 mus.add_soft(r.size(), r.c_ptr());
                 expr_ref_vector r2(m);
                 if (l_true == mus.get_mus(r2)) {
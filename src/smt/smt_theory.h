@@ -558,6 +558,12 @@ namespace smt {
 
         virtual char const * get_name() const { return "unknown"; }
 
+        /**
+           \brief Return an atom that splits the search space of the theory, or null
+           if the theory has no useful split. Used by the parallel solver to create cubes.
+        */
+        virtual expr_ref mk_split_atom() { return expr_ref(get_manager()); }
+
         // -----------------------------------
         //
         // Return a fresh new instance of the given theory.
@@ -389,6 +389,8 @@ namespace smt {
                     r = assert_delayed_axioms();
             }
         }
+        if (r == FC_DONE)
+            r = assert_lazy_axioms();
         bool should_giveup = m_found_unsupported_op || has_propagate_up_trail();
         if (r == FC_DONE && should_giveup && !ctx.get_fparams().m_array_fake_support) 
             r = FC_GIVEUP;
@@ -409,6 +411,20 @@ namespace smt {
         return r;
     }
 
+    final_check_status theory_array::assert_lazy_axioms() {
+        final_check_status r = FC_DONE;
+        for (auto const& p : m_axiom2_lazy) {
+            if (is_store_axiom2_satisfied(p.first, p.second)) {
+                m_stats.m_num_lazy_axiom2_filtered++;
+                continue;
+            }
+            m_stats.m_num_lazy_axiom2++;
+            assert_store_axiom2_core(p.first, p.second);
+            r = FC_CONTINUE;
+        }
+        return r;
+    }
+
     final_check_status theory_array::mk_interface_eqs_at_final_check() {
         unsigned n = mk_interface_eqs();
         m_stats.m_num_eq_splits += n;
@@ -469,6 +485,8 @@ namespace smt {
         st.update("array exp ax2", m_stats.m_num_axiom2b);
         st.update("array ext ax", m_stats.m_num_extensionality);
         st.update("array splits", m_stats.m_num_eq_splits);
+        st.update("array lazy ax2", m_stats.m_num_lazy_axiom2);
+        st.update("array lazy ax2 filtered", m_stats.m_num_lazy_axiom2_filtered);
     }
 
 };
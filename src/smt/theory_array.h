@@ -30,6 +30,7 @@ namespace smt {
         unsigned   m_num_map_axiom, m_num_default_map_axiom;
         unsigned   m_num_select_const_axiom, m_num_default_store_axiom, m_num_default_const_axiom, m_num_default_as_array_axiom;
         unsigned   m_num_select_as_array_axiom;
+        unsigned   m_num_lazy_axiom2, m_num_lazy_axiom2_filtered;
         void reset() { memset(this, 0, sizeof(theory_array_stats)); }
         theory_array_stats() { reset(); }
     };
@@ -92,6 +93,7 @@ namespace smt {
         
         virtual final_check_status assert_delayed_axioms();
         final_check_status mk_interface_eqs_at_final_check();
+        final_check_status assert_lazy_axioms();
 
         static void display_ids(std::ostream & out, unsigned n, enode * const * v);
     public:
@@ -207,6 +207,12 @@ namespace smt {
         if (i == num_args)
             return false;
         if (ctx.add_fingerprint(store, store->get_owner_id(), select->get_num_args() - 1, select->get_args() + 1)) {
+            if (ctx.get_fparams().m_array_lazy_axioms) {
+                TRACE("array", tout << "delaying axiom2\n";);
+                ctx.push_trail(push_back_vector<context, enode_pair_vector>(m_axiom2_lazy));
+                m_axiom2_lazy.push_back(std::make_pair(store, select));
+                return false;
+            }
             TRACE("array", tout << "adding axiom2 to todo queue\n";);
             m_axiom2_todo.push_back(std::make_pair(store, select)); 
             return true;
@@ -215,6 +221,27 @@ namespace smt {
         return false;
     }
 
+    /**
+       \brief check whether the current congruence closure satisfies axiom 2 for store and select:
+       either the indices are equal or select(store, j) and select(a, j) are congruent.
+    */
+    bool theory_array_base::is_store_axiom2_satisfied(enode * store, enode * select) {
+        unsigned num_args = select->get_num_args();
+        unsigned        i = 1;
+        for (; i < num_args; i++) 
+            if (store->get_arg(i)->get_root() != select->get_arg(i)->get_root())
+                break;
+        if (i == num_args)
+            return true;
+        ptr_buffer<enode> args;
+        args.push_back(store);
+        args.append(num_args - 1, select->get_args() + 1);
+        enode * sel1 = ctx.get_enode_eq_to(select->get_decl(), args.size(), args.c_ptr());
+        args[0] = store->get_arg(0);
+        enode * sel2 = ctx.get_enode_eq_to(select->get_decl(), args.size(), args.c_ptr());
+        return sel1 && sel2 && sel1->get_root() == sel2->get_root();
+    }
+
  
 
 
@@ -71,6 +71,7 @@ namespace smt {
         
         ptr_vector<enode>                   m_axiom1_todo;
         enode_pair_vector                   m_axiom2_todo;
+        enode_pair_vector                   m_axiom2_lazy;      // select-over-store pairs delayed by array.lazy_axioms
         enode_pair_vector                   m_extensionality_todo;
         enode_pair_vector                   m_congruent_todo;
         scoped_ptr<theory_array_bapa>       m_bapa;
@@ -82,6 +83,7 @@ namespace smt {
         void assert_store_axiom2_core(enode * store, enode * select);
         void assert_store_axiom1(enode * n) { m_axiom1_todo.push_back(n); }
         bool assert_store_axiom2(enode * store, enode * select);
+        bool is_store_axiom2_satisfied(enode * store, enode * select);
 
         void assert_extensionality_core(enode * a1, enode * a2);
         bool assert_extensionality(enode * a1, enode * a2);
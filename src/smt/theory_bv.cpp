@@ -688,6 +688,33 @@ namespace smt {
     }
 
 
+    /**
+       \brief Retrieve the bits of n if n was bit-blasted before with the same argument bits.
+    */
+    bool theory_bv::find_blast_cache(app * n, expr_ref_vector const & arg_bits, expr_ref_vector & bits) {
+        unsigned offset = 0;
+        if (!m_blast_cache.find(n, offset))
+            return false;
+        for (unsigned i = 0; i < arg_bits.size(); ++i)
+            if (m_blast_cache_bits.get(offset + i) != arg_bits.get(i))
+                return false;
+        bits.append(get_bv_size(n), m_blast_cache_bits.c_ptr() + offset + arg_bits.size());
+        ++m_stats.m_num_blast_cache_hits;
+        return true;
+    }
+
+    void theory_bv::save_blast_cache(app * n, expr_ref_vector const & arg_bits, expr_ref_vector const & bits) {
+        if (m_blast_cache_bits.size() >= std::max(100000u, 2 * ctx.get_num_bool_vars())) {
+            m_blast_cache.reset();
+            m_blast_cache_bits.reset();
+            m_blast_cache_terms.reset();
+        }
+        m_blast_cache.insert(n, m_blast_cache_bits.size());
+        m_blast_cache_terms.push_back(n);
+        m_blast_cache_bits.append(arg_bits);
+        m_blast_cache_bits.append(bits);
+    }
+
 #define MK_UNARY(NAME, BLAST_OP)                                        \
     void theory_bv::NAME(app * n) {                                     \
         SASSERT(!ctx.e_internalized(n));                      \
@@ -710,7 +737,12 @@ namespace smt {
         get_arg_bits(e, 0, arg1_bits);                                                  \
         get_arg_bits(e, 1, arg2_bits);                                                  \
         SASSERT(arg1_bits.size() == arg2_bits.size());                                  \
-        m_bb.BLAST_OP(arg1_bits.size(), arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits);    \
+        expr_ref_vector arg_bits(arg1_bits);                                            \
+        arg_bits.append(arg2_bits);                                                     \
+        if (!find_blast_cache(n, arg_bits, bits)) {                                     \
+            m_bb.BLAST_OP(arg1_bits.size(), arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits); \
+            save_blast_cache(n, arg_bits, bits);                                        \
+        }                                                                               \
         init_bits(e, bits);                                                             \
     }
 
@@ -724,20 +756,24 @@ namespace smt {
         expr_ref_vector arg_bits(m);                                                            \
         expr_ref_vector bits(m);                                                                \
         expr_ref_vector new_bits(m);                                                            \
+        unsigned sz = get_bv_size(n);                                                           \
         unsigned i = n->get_num_args();                                                         \
-        --i;                                                                                    \
-        get_arg_bits(e, i, bits);                                                               \
-        while (i > 0) {                                                                         \
+        for (unsigned j = 0; j < i; ++j)                                                        \
+            get_arg_bits(e, j, arg_bits);                                                       \
+        SASSERT(arg_bits.size() == i * sz);                                                     \
+        if (!find_blast_cache(n, arg_bits, bits)) {                                             \
             --i;                                                                                \
-            arg_bits.reset();                                                                   \
-            get_arg_bits(e, i, arg_bits);                                                       \
-            SASSERT(arg_bits.size() == bits.size());                                            \
-            new_bits.reset();                                                                   \
-            m_bb.BLAST_OP(arg_bits.size(), arg_bits.c_ptr(), bits.c_ptr(), new_bits);           \
-            bits.swap(new_bits);                                                                \
+            bits.append(sz, arg_bits.c_ptr() + i * sz);                                         \
+            while (i > 0) {                                                                     \
+                --i;                                                                            \
+                new_bits.reset();                                                               \
+                m_bb.BLAST_OP(sz, arg_bits.c_ptr() + i * sz, bits.c_ptr(), new_bits);           \
+                bits.swap(new_bits);                                                            \
+            }                                                                                   \
+            save_blast_cache(n, arg_bits, bits);                                                \
         }                                                                                       \
         init_bits(e, bits);                                                                     \
-        TRACE("bv_verbose", tout << arg_bits << " " << bits << " " << new_bits << "\n";); \
+        TRACE("bv_verbose", tout << arg_bits << " " << bits << "\n";);                         \
     }
 
 
@@ -857,6 +893,9 @@ namespace smt {
         if (approximate_term(term)) {
             return false;
         }
+        if (internalize_lazy(term)) {
+            return true;
+        }
         switch (term->get_decl_kind()) {
         case OP_BV_NUM:         internalize_num(term); return true;
         case OP_BADD:           internalize_add(term); return true;
@@ -1404,8 +1443,169 @@ namespace smt {
                                    << num_scopes << " = " << (ctx.get_scope_level() - num_scopes) << "\n"););
     }
 
+    /**
+       \brief Multipliers, dividers and shifters of width at least bv.lazy_blast_size
+       get fresh bits when they are internalized. Their circuit is added by
+       check_lazy_terms only if the final assignment violates the operation.
+    */
+    bool theory_bv::internalize_lazy(app * n) {
+        unsigned min_sz = params().m_bv_lazy_blast_size;
+        if (min_sz == 0 || get_bv_size(n) < min_sz)
+            return false;
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:
+        case OP_BUDIV_I:
+        case OP_BUREM_I:
+        case OP_BSHL:
+        case OP_BLSHR:
+        case OP_BASHR:
+            break;
+        default:
+            return false;
+        }
+        process_args(n);
+        enode * e = mk_enode(n);
+        theory_var v = e->get_th_var(get_id());
+        mk_bits(v);
+        find_wpos(v);
+        m_lazy_terms.push_back(n);
+        m_trail_stack.push(push_back_trail<theory_bv, app*, false>(m_lazy_terms));
+        TRACE("bv", tout << "lazy: " << mk_bounded_pp(n, m) << "\n";);
+        return true;
+    }
+
+    /**
+       \brief evaluate n on the values of its arguments. 
+       Return false if some bit of an argument is unassigned.
+    */
+    bool theory_bv::eval_lazy(app * n, numeral & result) const {
+        unsigned sz = get_bv_size(n);
+        numeral p2 = m_bb.power(sz);
+        numeral a, b;
+        if (!get_fixed_value(to_app(n->get_arg(0)), a))
+            return false;
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:
+            result = a;
+            for (unsigned i = 1; i < n->get_num_args(); ++i) {
+                if (!get_fixed_value(to_app(n->get_arg(i)), b))
+                    return false;
+                result = mod(result * b, p2);
+            }
+            return true;
+        default:
+            break;
+        }
+        if (!get_fixed_value(to_app(n->get_arg(1)), b))
+            return false;
+        unsigned shift = b < numeral(sz) ? b.get_unsigned() : sz;
+        switch (n->get_decl_kind()) {
+        case OP_BUDIV_I:
+            // same as the circuit produced by mk_udiv_urem on a zero divisor.
+            result = b.is_zero() ? p2 - numeral(1) : div(a, b);
+            break;
+        case OP_BUREM_I:
+            result = b.is_zero() ? a : mod(a, b);
+            break;
+        case OP_BSHL:
+            result = mod(a * m_bb.power(shift), p2);
+            break;
+        case OP_BLSHR:
+            result = div(a, m_bb.power(shift));
+            break;
+        case OP_BASHR:
+            if (a >= m_bb.power(sz - 1)) {
+                numeral max = p2 - numeral(1);
+                result = max - div(max - a, m_bb.power(shift));
+            }
+            else {
+                result = div(a, m_bb.power(shift));
+            }
+            break;
+        default:
+            UNREACHABLE();
+            return false;
+        }
+        return true;
+    }
+
+    void theory_bv::blast_lazy(app * n) {
+        enode * e = ctx.get_enode(n);
+        theory_var v = e->get_th_var(get_id());
+        expr_ref_vector arg_bits(m), bits(m), new_bits(m);
+        unsigned sz = get_bv_size(n);
+        unsigned i = n->get_num_args();
+        for (unsigned j = 0; j < i; ++j)
+            get_arg_bits(e, j, arg_bits);
+        SASSERT(arg_bits.size() == i * sz);
+        if (!find_blast_cache(n, arg_bits, bits)) {
+            --i;
+            bits.append(sz, arg_bits.c_ptr() + i * sz);
+            if (n->get_decl_kind() == OP_BMUL) {
+                while (i > 0) {
+                    --i;
+                    new_bits.reset();
+                    m_bb.mk_multiplier(sz, arg_bits.c_ptr() + i * sz, bits.c_ptr(), new_bits);
+                    bits.swap(new_bits);
+                }
+            }
+            else {
+                expr * const * arg0_bits = arg_bits.c_ptr();
+                switch (n->get_decl_kind()) {
+                case OP_BUDIV_I: m_bb.mk_udiv(sz, arg0_bits, bits.c_ptr(), new_bits); break;
+                case OP_BUREM_I: m_bb.mk_urem(sz, arg0_bits, bits.c_ptr(), new_bits); break;
+                case OP_BSHL:    m_bb.mk_shl(sz, arg0_bits, bits.c_ptr(), new_bits); break;
+                case OP_BLSHR:   m_bb.mk_lshr(sz, arg0_bits, bits.c_ptr(), new_bits); break;
+                case OP_BASHR:   m_bb.mk_ashr(sz, arg0_bits, bits.c_ptr(), new_bits); break;
+                default: UNREACHABLE(); break;
+                }
+                bits.swap(new_bits);
+            }
+            save_blast_cache(n, arg_bits, bits);
+        }
+        literal_vector const & lbits = m_bits[v];
+        SASSERT(bits.size() == lbits.size());
+        for (unsigned j = 0; j < bits.size(); ++j) {
+            expr_ref s_bit(m);
+            simplify_bit(bits.get(j), s_bit);
+            ctx.internalize(s_bit, true);
+            literal l = ctx.get_literal(s_bit);
+            ctx.mark_as_relevant(l);
+            ctx.mk_th_axiom(get_id(), l, ~lbits[j]);
+            ctx.mk_th_axiom(get_id(), ~l, lbits[j]);
+        }
+        m_lazy_blasted.insert(n);
+        m_trail_stack.push(insert_obj_trail<theory_bv, app>(m_lazy_blasted, n));
+        ++m_stats.m_num_lazy_blasts;
+    }
+
+    /**
+       \brief add the circuits of lazy terms whose value differs from the 
+       value obtained from their arguments. Return true if some circuit was added.
+    */
+    bool theory_bv::check_lazy_terms() {
+        bool blasted = false;
+        numeral expected, val;
+        for (unsigned i = 0; i < m_lazy_terms.size(); ++i) {
+            app * n = m_lazy_terms[i];
+            if (m_lazy_blasted.contains(n) || !ctx.is_relevant(n))
+                continue;
+            if (!get_fixed_value(n, val) || !eval_lazy(n, expected))
+                continue;
+            if (val == expected) 
+                continue;
+            TRACE("bv", tout << "blast " << mk_bounded_pp(n, m) << " " << val << " != " << expected << "\n";);
+            blast_lazy(n);
+            blasted = true;
+        }
+        return blasted;
+    }
+
     final_check_status theory_bv::final_check_eh() {
         SASSERT(check_invariant());
+        if (check_lazy_terms()) {
+            return FC_CONTINUE;
+        }
         if (m_approximates_large_bvs) {
             return FC_GIVEUP;
         }
@@ -1445,7 +1645,9 @@ namespace smt {
         m_bb(ctx.get_manager(), ctx.get_fparams()),
         m_trail_stack(*this),
         m_find(*this),
-        m_approximates_large_bvs(false) {
+        m_approximates_large_bvs(false),
+        m_blast_cache_bits(ctx.get_manager()),
+        m_blast_cache_terms(ctx.get_manager()) {
         memset(m_eq_activity, 0, sizeof(m_eq_activity));
         memset(m_diseq_activity, 0, sizeof(m_diseq_activity));
     }
@@ -1741,6 +1943,8 @@ namespace smt {
         st.update("bv bit2core", m_stats.m_num_bit2core);
         st.update("bv->core eq", m_stats.m_num_th2core_eq);
         st.update("bv dynamic eqs", m_stats.m_num_eq_dynamic);
+        st.update("bv lazy blasts", m_stats.m_num_lazy_blasts);
+        st.update("bv blast cache hits", m_stats.m_num_blast_cache_hits);
     }
 
     bool theory_bv::check_assignment(theory_var v) {
@@ -31,7 +31,7 @@ namespace smt {
     
     struct theory_bv_stats {
         unsigned   m_num_diseq_static, m_num_diseq_dynamic, m_num_bit2core, m_num_th2core_eq, m_num_conflicts;
-        unsigned   m_num_eq_dynamic;
+        unsigned   m_num_eq_dynamic, m_num_lazy_blasts, m_num_blast_cache_hits;
         void reset() { memset(this, 0, sizeof(theory_bv_stats)); }
         theory_bv_stats() { reset(); }
     };
@@ -133,6 +133,16 @@ namespace smt {
         literal_vector           m_tmp_literals;
         svector<var_pos>         m_prop_queue;
         bool                     m_approximates_large_bvs;
+        ptr_vector<app>          m_lazy_terms;    // terms whose circuit is added on demand.
+        obj_hashtable<app>       m_lazy_blasted;  // lazy terms whose circuit was added.
+
+        // circuits of terms are kept when the terms are popped, so they are not
+        // bit-blasted again when they are internalized in a later scope.
+        obj_map<app, unsigned>   m_blast_cache;       // term -> offset of its entry in m_blast_cache_bits
+        expr_ref_vector          m_blast_cache_bits;  // per entry, the bits of the arguments followed by the bits of the term
+        app_ref_vector           m_blast_cache_terms;
+        bool find_blast_cache(app * n, expr_ref_vector const & arg_bits, expr_ref_vector & bits);
+        void save_blast_cache(app * n, expr_ref_vector const & arg_bits, expr_ref_vector const & bits);
 
         theory_var find(theory_var v) const { return m_find.find(v); }
         theory_var next(theory_var v) const { return m_find.next(v); }
@@ -173,6 +183,10 @@ namespace smt {
         void add_fixed_eq(theory_var v1, theory_var v2);
         bool get_fixed_value(theory_var v, numeral & result) const;
         bool internalize_term_core(app * term);
+        bool internalize_lazy(app * n);
+        bool eval_lazy(app * n, numeral & result) const;
+        void blast_lazy(app * n);
+        bool check_lazy_terms();
         void internalize_num(app * n);
         void internalize_add(app * n);
         void internalize_sub(app * n);
@@ -73,6 +73,33 @@ namespace smt {
         m_stack.push_back(std::make_pair(ENTER, n));
     }
 
+    /**
+       \brief record that the constructor or the argument classes of n changed.
+       A cycle that is created by the change passes through n.
+    */
+    void theory_datatype::oc_mark_dirty(enode * n) {
+        m_trail_stack.push(push_back_vector<theory_datatype, ptr_vector<enode>>(m_oc_dirty));
+        m_oc_dirty.push_back(n);
+    }
+
+    /**
+       \brief run the occurs check from the classes that changed since the last
+       successful check. The graph was acyclic then, so a new cycle passes through
+       one of these classes. Return true if a conflict was found.
+    */
+    bool theory_datatype::oc_check_dirty() {
+        for (unsigned i = m_oc_head; i < m_oc_dirty.size(); ++i) {
+            enode * n = m_oc_dirty[i]->get_root();
+            if (!oc_cycle_free(n) && occurs_check(n)) 
+                return true;
+        }
+        if (m_oc_head < m_oc_dirty.size()) {
+            m_trail_stack.push(value_trail<theory_datatype, unsigned>(m_oc_head));
+            m_oc_head = m_oc_dirty.size();
+        }
+        return false;
+    }
+
 
     theory* theory_datatype::mk_fresh(context* new_ctx) { 
         return alloc(theory_datatype, *new_ctx);
@@ -268,6 +295,7 @@ namespace smt {
         ctx.attach_th_var(n, this, r);
         if (is_constructor(n)) {
             d->m_constructor = n;
+            oc_mark_dirty(n);
             assert_accessor_axioms(n);
         }
         else if (is_update_field(n)) {
@@ -470,10 +498,15 @@ namespace smt {
         int num_vars = get_num_vars();
         final_check_status r = FC_DONE;
         final_check_st _guard(this); 
+        // cycles through arrays are created by array equalities that are not tracked,
+        // so the occurs check starts from every class when there are nested arrays.
+        bool incremental = !m_util.has_nested_arrays();
+        if (incremental && oc_check_dirty()) 
+            return FC_CONTINUE;
         for (int v = 0; v < num_vars; v++) {
             if (v == static_cast<int>(m_find.find(v))) {
                 enode * node = get_enode(v);
-                if (!oc_cycle_free(node) && occurs_check(node)) {
+                if (!incremental && !oc_cycle_free(node) && occurs_check(node)) {
                     // conflict was detected... 
                     // return...
                     return FC_CONTINUE;
@@ -667,6 +700,8 @@ namespace smt {
         
     void theory_datatype::reset_eh() {
         m_trail_stack.reset();
+        m_oc_dirty.reset();
+        m_oc_head = 0;
         std::for_each(m_var_data.begin(), m_var_data.end(), delete_proc<var_data>());
         m_var_data.reset();
         theory::reset_eh();
@@ -691,7 +726,8 @@ namespace smt {
         m_util(m),
         m_autil(m),
         m_find(*this),
-        m_trail_stack(*this) {
+        m_trail_stack(*this),
+        m_oc_head(0) {
     }
 
     theory_datatype::~theory_datatype() {
@@ -776,6 +812,7 @@ namespace smt {
         SASSERT(v1 == static_cast<int>(m_find.find(v1)));
         var_data * d1 = m_var_data[v1];
         var_data * d2 = m_var_data[v2];
+        oc_mark_dirty(get_enode(v1));
         if (d2->m_constructor != nullptr) {
             if (d1->m_constructor != nullptr && d1->m_constructor->get_decl() != d2->m_constructor->get_decl()) {
                 region & r    = ctx.get_region();
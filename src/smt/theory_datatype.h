@@ -81,6 +81,8 @@ namespace smt {
         enode_pair_vector     m_used_eqs; // conflict, if any
         parent_tbl            m_parent; // parent explanation for occurs_check
         svector<stack_entry>  m_stack; // stack for DFS for occurs_check
+        ptr_vector<enode>     m_oc_dirty; // classes whose constructor or arguments changed
+        unsigned              m_oc_head;  // m_oc_dirty[0..m_oc_head) were found cycle free
 
         void clear_mark();
 
@@ -91,6 +93,8 @@ namespace smt {
         bool oc_cycle_free(enode * n) const { return n->get_root()->is_marked2(); }
 
         void oc_push_stack(enode * n);
+        void oc_mark_dirty(enode * n);
+        bool oc_check_dirty();
         ptr_vector<enode> m_array_args;
         ptr_vector<enode> const& get_array_args(enode* n);
 
@@ -195,6 +195,7 @@ namespace smt {
         arith_factory *                m_factory;
         rational                       m_delta;
         nc_functor                     m_nc_functor;   
+        svector<edge_id>               m_subsumed;     // implied edges, used in propagate_implied
 
         // For optimization purpose
         typedef vector <std::pair<theory_var, rational> > objective_term;
@@ -336,6 +337,8 @@ namespace smt {
 
         bool propagate_atom(atom* a);
 
+        void propagate_implied(edge_id id);
+
         theory_var mk_term(app* n);
 
         theory_var mk_num(app* n, rational const& r);
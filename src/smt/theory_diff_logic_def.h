@@ -590,9 +590,44 @@ bool theory_diff_logic<Ext>::propagate_atom(atom* a) {
         
         return false;
     }
+    if (m_params.m_arith_dl_implied_budget > 0) {
+        propagate_implied(edge_id);
+    }
     return true;
 }
 
+/**
+   \brief assign the literals of the disabled edges that are implied by 
+   a path through the newly enabled edge id. The search for implied edges
+   is bounded by arith.dl_implied_budget.
+*/
+template<typename Ext>
+void theory_diff_logic<Ext>::propagate_implied(edge_id id) {
+    m_subsumed.reset();
+    m_graph.find_subsumed(id, m_subsumed, m_params.m_arith_dl_implied_budget);
+    for (edge_id e : m_subsumed) {
+        literal l = m_graph.get_explanation(e);
+        if (l == null_literal || ctx.get_assignment(l) != l_undef) {
+            continue;
+        }
+        m_nc_functor.reset();
+        m_graph.explain_subsumed_lazy(id, e, m_nc_functor);
+        literal_vector const& lits = m_nc_functor.get_lits();
+        TRACE("arith", tout << "implied: "; ctx.display_literal_info(tout, l); tout << " by " << lits << "\n";);
+        vector<parameter> params;
+        if (m.proofs_enabled()) {
+            params.push_back(parameter(symbol("farkas")));
+            for (unsigned i = 0; i <= lits.size(); ++i) {
+                params.push_back(parameter(rational(1)));
+            }
+        } 
+        ctx.assign(l, ctx.mk_justification(
+                       ext_theory_propagation_justification(
+                           get_id(), ctx.get_region(), 
+                           lits.size(), lits.c_ptr(), 0, nullptr, l, params.size(), params.c_ptr())));
+    }
+}
+
 template<typename Ext>
 void theory_diff_logic<Ext>::new_edge(dl_var src, dl_var dst, unsigned num_edges, edge_id const* edges) {
 
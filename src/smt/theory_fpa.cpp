@@ -84,6 +84,18 @@ namespace smt {
         }
     }
 
+#define FPA_LAZY_OP(OP)                                                 \
+    void theory_fpa::fpa2bv_converter_wrapped::OP(func_decl * f, unsigned num, expr * const * args, expr_ref & result) { \
+        if (!m_th.mk_abstraction(f, num, args, result))                 \
+            fpa2bv_converter::OP(f, num, args, result);                 \
+    }
+
+    FPA_LAZY_OP(mk_mul)
+    FPA_LAZY_OP(mk_div)
+    FPA_LAZY_OP(mk_rem)
+    FPA_LAZY_OP(mk_fma)
+    FPA_LAZY_OP(mk_sqrt)
+
     theory_fpa::theory_fpa(context& ctx) :
         theory(ctx, ctx.get_manager().mk_family_id("fpa")),
         m_converter(ctx.get_manager(), this),
@@ -93,7 +105,9 @@ namespace smt {
         m_fpa_util(m_converter.fu()),
         m_bv_util(m_converter.bu()),
         m_arith_util(m_converter.au()),
-        m_is_initialized(true)
+        m_is_initialized(true),
+        m_abs_decls(ctx.get_manager()),
+        m_refining(false)
     {
         params_ref p;
         p.set_bool("arith_lhs", true);
@@ -683,15 +697,150 @@ namespace smt {
         }
         dec_ref_map_key_values(m, m_conversions);
         dec_ref_collection_values(m, m_is_added_to_model);
+        m_op2abs.reset();
+        m_abs2op.reset();
+        m_abs_decls.reset();
+        m_refined.reset();
         theory::reset_eh();
     }
 
     final_check_status theory_fpa::final_check_eh() {
         TRACE("t_fpa", tout << "final_check_eh\n";);
         SASSERT(m_converter.m_extra_assertions.empty());
+        if (refine_abstractions())
+            return FC_CONTINUE;
         return FC_DONE;
     }
 
+    /**
+       \brief abstract f(args) by abs_f(bv(args)), where abs_f is an
+       uninterpreted function over the bit-vector encodings of the arguments
+       of f. The encoding of f is added by refine_abstraction when the
+       assignment of an application of abs_f does not agree with f.
+    */
+    bool theory_fpa::mk_abstraction(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        if (!ctx.get_fparams().m_fp_lazy_encoding || m_refining)
+            return false;
+        func_decl * g = nullptr;
+        if (!m_op2abs.find(f, g)) {
+            ptr_vector<sort> domain;
+            for (unsigned i = 0; i < num; ++i) {
+                sort * s = f->get_domain(i);
+                unsigned sz = m_fpa_util.is_rm(s) ? 3 : m_fpa_util.get_ebits(s) + m_fpa_util.get_sbits(s);
+                domain.push_back(m_bv_util.mk_sort(sz));
+            }
+            sort * s = f->get_range();
+            sort * range = m_bv_util.mk_sort(m_fpa_util.get_ebits(s) + m_fpa_util.get_sbits(s));
+            g = m.mk_fresh_func_decl(f->get_name(), symbol("abs"), num, domain.c_ptr(), range);
+            m_abs_decls.push_back(f);
+            m_abs_decls.push_back(g);
+            m_op2abs.insert(f, g);
+            m_abs2op.insert(g, f);
+        }
+        expr_ref_vector bv_args(m);
+        for (unsigned i = 0; i < num; ++i) {
+            if (m_fpa_util.is_bv2rm(args[i]))
+                bv_args.push_back(to_app(args[i])->get_arg(0));
+            else {
+                expr_ref sgn(m), exp(m), sig(m);
+                m_converter.split_fp(args[i], sgn, exp, sig);
+                bv_args.push_back(m_bv_util.mk_concat(m_bv_util.mk_concat(sgn, exp), sig));
+            }
+        }
+        ++m_stats.m_num_abstractions;
+        result = unwrap(m.mk_app(g, bv_args.size(), bv_args.c_ptr()), f->get_range());
+        return true;
+    }
+
+    /**
+       \brief the floating-point terms that correspond to the bit-vector
+       arguments of the abstraction a.
+    */
+    void theory_fpa::abstraction_args(app * a, expr_ref_vector & args) {
+        func_decl * f = m_abs2op[a->get_decl()];
+        for (unsigned i = 0; i < a->get_num_args(); ++i) {
+            expr * arg = a->get_arg(i);
+            sort * s = f->get_domain(i);
+            if (m_fpa_util.is_rm(s))
+                args.push_back(m_fpa_util.mk_bv2rm(arg));
+            else
+                args.push_back(unwrap(arg, s));
+        }
+    }
+
+    /**
+       \brief check that the values of the bit-vector arguments and result of a
+       agree with the floating-point operation it abstracts.
+    */
+    bool theory_fpa::check_abstraction(app * a) {
+        theory_bv * th_bv = dynamic_cast<theory_bv*>(ctx.get_theory(m_bv_util.get_family_id()));
+        if (!th_bv)
+            return false;
+        rational val;
+        expr_ref_vector vals(m);
+        for (expr * arg : *a) {
+            if (!is_app(arg) || !th_bv->get_fixed_value(to_app(arg), val))
+                return false;
+            vals.push_back(m_bv_util.mk_numeral(val, m.get_sort(arg)));
+        }
+        if (!th_bv->get_fixed_value(a, val))
+            return false;
+        func_decl * f = m_abs2op[a->get_decl()];
+        expr_ref_vector args(m);
+        app_ref v(m.mk_app(a->get_decl(), vals.size(), vals.c_ptr()), m);
+        abstraction_args(v, args);
+        expr_ref expected(m.mk_app(f, args.size(), args.c_ptr()), m);
+        expr_ref actual(unwrap(m_bv_util.mk_numeral(val, m.get_sort(a)), f->get_range()), m);
+        m_th_rw(expected);
+        m_th_rw(actual);
+        TRACE("t_fpa", tout << mk_pp(a, m) << "\n" << expected << " == " << actual << "\n";);
+        return m_fpa_util.is_numeral(expected) && expected == actual;
+    }
+
+    /**
+       \brief add the bit-vector encoding of the operation abstracted by a.
+    */
+    void theory_fpa::refine_abstraction(app * a) {
+        func_decl * f = m_abs2op[a->get_decl()];
+        expr_ref_vector args(m), cargs(m);
+        abstraction_args(a, args);
+        for (expr * arg : args)
+            cargs.push_back(convert(arg));
+        flet<bool> _refining(m_refining, true);
+        expr_ref r(m), sgn(m), exp(m), sig(m);
+        switch (f->get_decl_kind()) {
+        case OP_FPA_MUL:  m_converter.mk_mul(f, cargs.size(), cargs.c_ptr(), r); break;
+        case OP_FPA_DIV:  m_converter.mk_div(f, cargs.size(), cargs.c_ptr(), r); break;
+        case OP_FPA_REM:  m_converter.mk_rem(f, cargs.size(), cargs.c_ptr(), r); break;
+        case OP_FPA_FMA:  m_converter.mk_fma(f, cargs.size(), cargs.c_ptr(), r); break;
+        case OP_FPA_SQRT: m_converter.mk_sqrt(f, cargs.size(), cargs.c_ptr(), r); break;
+        default: UNREACHABLE();
+        }
+        m_converter.split_fp(r, sgn, exp, sig);
+        expr_ref cnstr(m.mk_eq(a, m_bv_util.mk_concat(m_bv_util.mk_concat(sgn, exp), sig)), m);
+        cnstr = m.mk_and(cnstr, mk_side_conditions());
+        m_th_rw(cnstr);
+        ++m_stats.m_num_refinements;
+        m_refined.insert(a);
+        m_trail_stack.push(insert_obj_trail<theory_fpa, app>(m_refined, a));
+        assert_cnstr(cnstr);
+    }
+
+    bool theory_fpa::refine_abstractions() {
+        if (m_abs2op.empty())
+            return false;
+        ptr_vector<app> to_refine;
+        for (enode * n : ctx.enodes()) {
+            app * a = n->get_owner();
+            if (m_abs2op.contains(a->get_decl()) && ctx.is_relevant(n) &&
+                !m_refined.contains(a) && !check_abstraction(a))
+                to_refine.push_back(a);
+        }
+        for (app * a : to_refine)
+            refine_abstraction(a);
+        return !to_refine.empty();
+    }
+
     void theory_fpa::init_model(model_generator & mg) {
         TRACE("t_fpa", tout << "initializing model" << std::endl; display(tout););
         m_factory = alloc(fpa_value_factory, m, get_family_id());
@@ -818,6 +967,8 @@ namespace smt {
              it != seen.end();
              it++)
             mdl.unregister_decl(*it);
+        for (auto const& kv : m_abs2op)
+            mdl.unregister_decl(kv.m_key);
 
         for (unsigned i = 0; i < new_model.get_num_constants(); i++) {
             func_decl * f = new_model.get_constant(i);
@@ -831,6 +982,11 @@ namespace smt {
         }
     }
 
+    void theory_fpa::collect_statistics(::statistics & st) const {
+        st.update("fpa abstractions", m_stats.m_num_abstractions);
+        st.update("fpa refinements", m_stats.m_num_refinements);
+    }
+
     void theory_fpa::display(std::ostream & out) const
     {
 
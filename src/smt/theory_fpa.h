@@ -95,6 +95,17 @@ namespace smt {
             virtual ~fpa2bv_converter_wrapped() {}
             void mk_const(func_decl * f, expr_ref & result) override;
             void mk_rm_const(func_decl * f, expr_ref & result) override;
+            void mk_mul(func_decl * f, unsigned num, expr * const * args, expr_ref & result) override;
+            void mk_div(func_decl * f, unsigned num, expr * const * args, expr_ref & result) override;
+            void mk_rem(func_decl * f, unsigned num, expr * const * args, expr_ref & result) override;
+            void mk_fma(func_decl * f, unsigned num, expr * const * args, expr_ref & result) override;
+            void mk_sqrt(func_decl * f, unsigned num, expr * const * args, expr_ref & result) override;
+        };
+
+        struct stats {
+            unsigned m_num_abstractions, m_num_refinements;
+            void reset() { memset(this, 0, sizeof(stats)); }
+            stats() { reset(); }
         };
 
         class fpa_value_proc : public model_value_proc {
@@ -156,6 +167,15 @@ namespace smt {
         obj_map<expr, expr*>      m_conversions;
         bool                      m_is_initialized;
         obj_hashtable<func_decl>  m_is_added_to_model;
+        stats                     m_stats;
+
+        // lazy encoding: expensive operations are abstracted by uninterpreted
+        // functions over the bit-vector encodings of their arguments.
+        obj_map<func_decl, func_decl*> m_op2abs;
+        obj_map<func_decl, func_decl*> m_abs2op;
+        func_decl_ref_vector      m_abs_decls;
+        obj_hashtable<app>        m_refined;
+        bool                      m_refining;
 
         final_check_status final_check_eh() override;
         bool internalize_atom(app * atom, bool gate_ctx) override;
@@ -175,6 +195,7 @@ namespace smt {
         void relevant_eh(app * n) override;
         void init_model(model_generator & m) override;
         void finalize_model(model_generator & mg) override;
+        void collect_statistics(::statistics & st) const override;
 
     public:
         theory_fpa(context& ctx);
@@ -192,6 +213,12 @@ namespace smt {
         void attach_new_th_var(enode * n);
         void assert_cnstr(expr * e);
 
+        bool mk_abstraction(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+        void abstraction_args(app * a, expr_ref_vector & args);
+        bool check_abstraction(app * a);
+        void refine_abstraction(app * a);
+        bool refine_abstractions();
+
         app_ref wrap(expr * e);
         app_ref unwrap(expr * e, sort * s);
 
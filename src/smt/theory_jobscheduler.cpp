@@ -176,6 +176,12 @@ namespace smt {
                 return FC_CONTINUE;
             }
         }
+        for (unsigned r = 0; r < m_resources.size(); ++r) {
+            if (propagate_timetable(r)) {
+                blocked = true;
+            }
+        }
+        if (blocked) return FC_CONTINUE;
         for (unsigned r = 0; r < m_resources.size(); ++r) {
             if (constrain_resource_energy(r)) {
                 blocked = true;
@@ -422,6 +428,108 @@ namespace smt {
         return blocked;
     }
 
+    /**
+     *  Profile of the compulsory parts [lst(j), ect(j)] of the jobs on resource r.
+     *  Segments are ordered by start time, and only segments with positive load are kept.
+     */
+    void theory_jobscheduler::mk_profile(unsigned r, unsigned_vector const& jobs, vector<profile_segment>& profile) {
+        profile.reset();
+        // the load changes by delta at time t for each (t, delta).
+        svector<std::pair<time_t, int>> events;
+        for (unsigned j : jobs) {
+            time_t s = lst(j), e = ect(j);
+            if (s <= e && e < std::numeric_limits<time_t>::max()) {
+                int load = get_job_resource(j, r).m_loadpct;
+                events.push_back(std::make_pair(s, load));
+                events.push_back(std::make_pair(e + 1, -load));
+            }
+        }
+        std::sort(events.begin(), events.end());
+        int load = 0;
+        for (unsigned i = 0; i < events.size(); ) {
+            time_t t = events[i].first;
+            for (; i < events.size() && events[i].first == t; ++i) {
+                load += events[i].second;
+            }
+            if (load > 0 && i < events.size()) {
+                profile.push_back(profile_segment(t, events[i].first - 1, load));
+            }
+        }
+    }
+
+    /**
+     *  Timetabling: a job k on r cannot start within a segment [a, b] of 
+     *  the profile of compulsory parts if the load of the segment without k 
+     *  and the load of k exceed the capacity. With est(k) in [a, b]:
+     * 
+     *  r = resource(k) & start(k) >= a & 
+     *  /\_j (r = resource(j) & start(j) <= lst(j) & end(j) >= ect(j)) => start(k) >= b + 1
+     *
+     *  where the jobs j are jobs other than k whose compulsory parts cover [a, b].
+     */
+    bool theory_jobscheduler::propagate_timetable(unsigned r) {
+        res_info const& ri = m_resources[r];
+        unsigned_vector jobs;
+        for (unsigned j : ri.m_jobs) {
+            if (resource(j) == r) {
+                jobs.push_back(j);
+            }
+        }
+        vector<profile_segment> profile;
+        mk_profile(r, jobs, profile);
+        if (profile.empty()) {
+            return false;
+        }
+        bool propagated = false;
+        for (unsigned k : jobs) {
+            time_t s = est(k);
+            // find the last segment starting at or before s.
+            unsigned lo = 0, hi = profile.size();
+            while (lo < hi) {
+                unsigned mid = (lo + hi) / 2;
+                if (profile[mid].m_start <= s) lo = mid + 1; else hi = mid;
+            }
+            if (lo == 0) continue;
+            profile_segment const& seg = profile[lo - 1];
+            if (seg.m_end < s) continue;
+            unsigned load_k = get_job_resource(k, r).m_loadpct;
+            unsigned load = seg.m_loadpct;
+            time_t lst_k = lst(k), ect_k = ect(k);
+            if (lst_k <= seg.m_start && seg.m_end <= ect_k) {
+                load -= load_k; // the compulsory part of k covers the segment
+            }
+            if (load + load_k <= 100) continue;
+
+            literal_vector lits;
+            lits.push_back(~mk_eq_lit(m_jobs[k].m_job2resource, ri.m_resource));
+            lits.push_back(~mk_ge(m_jobs[k].m_start, seg.m_start));
+            unsigned sum = load_k;
+            for (unsigned j : jobs) {
+                if (sum > 100) break;
+                if (j == k) continue;
+                time_t lst_j = lst(j), ect_j = ect(j);
+                if (lst_j > seg.m_start || ect_j < seg.m_end) continue;
+                sum += get_job_resource(j, r).m_loadpct;
+                lits.push_back(~mk_eq_lit(m_jobs[j].m_job2resource, ri.m_resource));
+                lits.push_back(~mk_le(m_jobs[j].m_start, lst_j));
+                lits.push_back(~mk_ge(m_jobs[j].m_end, ect_j));
+            }
+            SASSERT(sum > 100);
+            literal concl = mk_ge(m_jobs[k].m_start, seg.m_end + 1);
+            lits.push_back(concl);
+            bool is_sat = false;
+            for (literal lit : lits) {
+                is_sat |= ctx.get_assignment(lit) == l_true;
+            }
+            if (is_sat) continue;
+            TRACE("csp", tout << "timetable job: " << k << " resource: " << r << " [" << seg.m_start << ":" << seg.m_end << "] " << seg.m_loadpct << "\n";);
+            ++m_stats.m_num_timetable_lemmas;
+            ctx.mk_clause(lits.size(), lits.c_ptr(), nullptr, CLS_TH_LEMMA, nullptr);
+            propagated = true;
+        }
+        return propagated;
+    }
+
     void theory_jobscheduler::block_job_overlap(unsigned r, uint_set const& jobs, unsigned last_job) {
         //
         // block the following case:
@@ -545,7 +653,7 @@ namespace smt {
     }
         
     void theory_jobscheduler::collect_statistics(::statistics & st) const {
-
+        st.update("jobs timetable lemmas", m_stats.m_num_timetable_lemmas);
     }
 
     bool theory_jobscheduler::include_func_interp(func_decl* f) {
@@ -86,6 +86,14 @@ namespace smt {
             };
         };
 
+        // segment [m_start, m_end] of the profile of compulsory parts on a resource
+        struct profile_segment {
+            time_t   m_start;
+            time_t   m_end;
+            unsigned m_loadpct;
+            profile_segment(time_t s, time_t e, unsigned l): m_start(s), m_end(e), m_loadpct(l) {}
+        };
+
         struct res_info {
             unsigned_vector       m_jobs;      // jobs allocated to run on resource
             vector<res_available> m_available; // time intervals where resource is available
@@ -106,6 +114,12 @@ namespace smt {
             unsigned m_bound_qhead;
         };
         svector<scope> m_scopes;
+        struct stats {
+            unsigned m_num_timetable_lemmas;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+        stats          m_stats;
         
     protected:
 
@@ -200,6 +214,8 @@ namespace smt {
         // final check constraints
         bool constrain_end_time_interval(unsigned j, unsigned r);
         bool constrain_resource_energy(unsigned r);
+        bool propagate_timetable(unsigned r);
+        void mk_profile(unsigned r, unsigned_vector const& jobs, vector<profile_segment>& profile);
         bool split_job2resource(unsigned j);
 
         void assert_last_end_time(unsigned j, unsigned r, job_resource const& jr, literal eq);
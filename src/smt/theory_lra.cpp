@@ -337,19 +337,17 @@ class theory_lra::imp {
         reset_variable_values();
         m_solver = alloc(lp::lar_solver); 
 
-        // initialize 0, 1 variables:
-        get_one(true);
-        get_one(false);
-        get_zero(true);
-        get_zero(false);
-
         smt_params_helper lpar(ctx().get_params());
         lp().settings().set_resource_limit(m_resource_limit);
         lp().settings().simplex_strategy() = static_cast<lp::simplex_strategy_enum>(lpar.arith_simplex_strategy());
+        if (lpar.arith_presolve_with_doubles()) 
+            lp().settings().simplex_strategy() = lp::simplex_strategy_enum::lu;
         lp().settings().bound_propagation() = BP_NONE != propagation_mode();
         lp().settings().m_enable_hnf = lpar.arith_enable_hnf();
         lp().settings().m_print_external_var_name = lpar.arith_print_ext_var_names();
         lp().set_track_pivoted_rows(lpar.arith_bprop_on_pivoted_rows());
+        lp().settings().bound_propagation_threads = lpar.arith_bprop_threads();
+        lp().settings().m_int_cut_pool_size = lpar.arith_cut_pool_size();
         lp().settings().report_frequency = lpar.arith_rep_freq();
         lp().settings().print_statistics = lpar.arith_print_stats();
 
@@ -360,6 +358,8 @@ class theory_lra::imp {
         lp().settings().m_int_run_gcd_test = ctx().get_fparams().m_arith_gcd_test;
         lp().settings().set_random_seed(ctx().get_fparams().m_random_seed);
         m_lia = alloc(lp::int_solver, *m_solver.get());
+        // the 0, 1 variables are created once the simplex strategy is set,
+        // because the LU strategy also adds their columns to the double matrix.
         get_one(true);
         get_zero(true);
         get_one(false);
@@ -405,6 +405,7 @@ class theory_lra::imp {
             m_nla->settings().horner_row_length_limit() =     prms.arith_nl_horner_row_length_limit();
             m_nla->settings().run_grobner() =                 prms.arith_nl_grobner();
             m_nla->settings().run_nra()  =                    prms.arith_nl_nra();
+            m_nla->settings().nra_incremental() =             prms.arith_nl_nra_incremental();
             m_nla->settings().grobner_subs_fixed() =          prms.arith_nl_grobner_subs_fixed();
             m_nla->settings().grobner_eqs_growth() =          prms.arith_nl_grobner_eqs_growth();
             m_nla->settings().grobner_expr_size_growth() =    prms.arith_nl_grobner_expr_size_growth();
@@ -413,6 +414,7 @@ class theory_lra::imp {
             m_nla->settings().grobner_number_of_conflicts_to_report() = prms.arith_nl_grobner_cnfl_to_report();
             m_nla->settings().grobner_quota() =               prms.arith_nl_gr_q();
             m_nla->settings().grobner_frequency() =           prms.arith_nl_grobner_frequency();
+            m_nla->settings().grobner_threads() =             prms.arith_nl_grobner_threads();
             m_nla->settings().propagate_bounds()  =           prms.arith_nl_bp();
         }
     }
@@ -975,19 +977,17 @@ public:
         reset_variable_values();
         m_solver = alloc(lp::lar_solver); 
 
-        // initialize 0, 1 variables:
-        get_one(true);
-        get_one(false);
-        get_zero(true);
-        get_zero(false);
-
         smt_params_helper lpar(ctx().get_params());
         lp().settings().set_resource_limit(m_resource_limit);
         lp().settings().simplex_strategy() = static_cast<lp::simplex_strategy_enum>(lpar.arith_simplex_strategy());
+        if (lpar.arith_presolve_with_doubles()) 
+            lp().settings().simplex_strategy() = lp::simplex_strategy_enum::lu;
         lp().settings().bound_propagation() = BP_NONE != propagation_mode();
         lp().settings().m_enable_hnf = lpar.arith_enable_hnf();
         lp().settings().m_print_external_var_name = lpar.arith_print_ext_var_names();
         lp().set_track_pivoted_rows(lpar.arith_bprop_on_pivoted_rows());
+        lp().settings().bound_propagation_threads = lpar.arith_bprop_threads();
+        lp().settings().m_int_cut_pool_size = lpar.arith_cut_pool_size();
         lp().settings().report_frequency = lpar.arith_rep_freq();
         lp().settings().print_statistics = lpar.arith_print_stats();
 
@@ -998,6 +998,8 @@ public:
         lp().settings().m_int_run_gcd_test = ctx().get_fparams().m_arith_gcd_test;
         lp().settings().set_random_seed(ctx().get_fparams().m_random_seed);
         m_lia = alloc(lp::int_solver, *m_solver.get());
+        // the 0, 1 variables are created once the simplex strategy is set,
+        // because the LU strategy also adds their columns to the double matrix.
         get_one(true);
         get_zero(true);
         get_one(false);
@@ -3490,6 +3492,38 @@ public:
         return false;
     }
 
+    /**
+       \brief Branch on the integer variable whose value in the current LP solution
+       is the most fractional: return x <= floor(value).
+    */
+    expr_ref mk_split_atom() {
+        expr_ref result(m);
+        if (!m_solver || !lp().has_int_var())
+            return result;
+        theory_var best = null_theory_var;
+        rational best_frac, best_floor;
+        theory_var sz = static_cast<theory_var>(th.get_num_vars());
+        for (theory_var v = 0; v < sz; ++v) {
+            if (!is_int(v) || !can_get_ivalue(v))
+                continue;
+            lp::impq const val = get_ivalue(v);
+            if (val.is_int())
+                continue;
+            rational fl = floor(val.x);
+            rational frac = val.x - fl;
+            // distance to 1/2
+            rational dist = abs(frac - rational(1, 2));
+            if (best == null_theory_var || dist < best_frac) {
+                best = v;
+                best_frac = dist;
+                best_floor = fl;
+            }
+        }
+        if (best != null_theory_var)
+            result = a.mk_le(get_owner(best), a.mk_numeral(best_floor, true));
+        return result;
+    }
+
     // Auxiliary verification utilities.
 
     struct scoped_arith_mode {
@@ -3846,6 +3880,7 @@ public:
         st.update("arith-propagations", m_stats.m_bounds_propagations);
         st.update("arith-iterations", m_stats.m_num_iterations);
         st.update("arith-factorizations", lp().settings().stats().m_num_factorizations);
+        st.update("arith-reused-factorizations", lp().settings().stats().m_reused_factorizations);
         st.update("arith-pivots", m_stats.m_need_to_solve_inf);
         st.update("arith-plateau-iterations", m_stats.m_num_iterations_with_no_progress);
         st.update("arith-fixed-eqs", m_stats.m_fixed_eqs);
@@ -3868,6 +3903,7 @@ public:
         st.update("arith-horner-cross-nested-forms", lp().settings().stats().m_cross_nested_forms);
         st.update("arith-grobner-calls", lp().settings().stats().m_grobner_calls);
         st.update("arith-grobner-conflicts", lp().settings().stats().m_grobner_conflicts);
+        st.update("arith-cut-pool-reuses", lp().settings().stats().m_cut_pool_reuses);
         if (m_nla) m_nla->collect_statistics(st);
         st.update("arith-gomory-cuts", m_stats.m_gomory_cuts);
         st.update("arith-assume-eqs", m_stats.m_assume_eqs);
@@ -3978,6 +4014,9 @@ bool theory_lra::get_lower(enode* n, rational& r, bool& is_strict) {
 bool theory_lra::get_upper(enode* n, rational& r, bool& is_strict) {
     return m_imp->get_upper(n, r, is_strict);
 }
+expr_ref theory_lra::mk_split_atom() {
+    return m_imp->mk_split_atom();
+}
 void theory_lra::display(std::ostream & out) const {
     m_imp->display(out);
 }
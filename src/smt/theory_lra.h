@@ -88,6 +88,7 @@ namespace smt {
         bool get_upper(enode* n, expr_ref& r);
         bool get_lower(enode* n, rational& r, bool& is_strict);
         bool get_upper(enode* n, rational& r, bool& is_strict);
+        expr_ref mk_split_atom() override;
                 
         void display(std::ostream & out) const override;
         
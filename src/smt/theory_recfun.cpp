@@ -35,6 +35,7 @@ namespace smt {
           m_enabled_guards(m),
           m_preds(m),
           m_num_rounds(0),
+          m_apply_trail(m),
           m_q_case_expand(), 
           m_q_body_expand() {
         m_num_rounds = 0;
@@ -115,6 +116,9 @@ namespace smt {
             dealloc(kv.m_value);
         }
         m_guard2pending.reset();
+        m_fun_rounds.reset();
+        m_apply_cache.reset();
+        m_apply_trail.reset();
     }
 
     /*
@@ -274,18 +278,36 @@ namespace smt {
         }
     }
 
-     // replace `vars` by `args` in `e`
+    /**
+     * replace `vars` by `args` in `e`, where `args` are the arguments of `t`.
+     *
+     * The result only depends on `t` and `e`. It is cached so that terms that
+     * are expanded again after backtracking or after the depth bound was
+     * increased are not substituted and simplified again. Depths are never
+     * retracted, so the depths of the subterms were set when the result was
+     * first computed.
+     */
     expr_ref theory_recfun::apply_args(
         unsigned depth,
         recfun::vars const & vars,
+        app * t,
         ptr_vector<expr> const & args,
         expr * e) {
         SASSERT(is_standard_order(vars));
+        expr* r = nullptr;
+        if (m_apply_cache.find(t, e, r)) {
+            ++m_stats.m_apply_cache_hits;
+            return expr_ref(r, m);
+        }
         var_subst subst(m, true);
         expr_ref new_body(m);
         new_body = subst(e, args.size(), args.c_ptr());
         ctx.get_rewriter()(new_body); // simplify
         set_depth_rec(depth + 1, new_body);
+        m_apply_trail.push_back(t);
+        m_apply_trail.push_back(e);
+        m_apply_trail.push_back(new_body);
+        m_apply_cache.insert(t, e, new_body);
         return new_body;
     }
         
@@ -327,7 +349,7 @@ namespace smt {
         auto & vars = e.m_def->get_vars();
         expr_ref lhs(e.m_lhs, m);
         unsigned depth = get_depth(e.m_lhs);
-        expr_ref rhs(apply_args(depth, vars, e.m_args, e.m_def->get_rhs()), m);
+        expr_ref rhs(apply_args(depth, vars, e.m_lhs, e.m_args, e.m_def->get_rhs()), m);
         literal lit = mk_eq_lit(lhs, rhs);
         std::function<literal(void)> fn = [&]() { return lit; };
         scoped_trace_stream _tr(*this, fn);
@@ -363,7 +385,7 @@ namespace smt {
             set_depth(depth, pred_applied);
             expr_ref_vector guards(m);
             for (auto & g : c.get_guards()) {
-                guards.push_back(apply_args(depth, vars, e.m_args, g));
+                guards.push_back(apply_args(depth, vars, e.m_lhs, e.m_args, g));
             }
             if (c.is_immediate()) {
                 body_expansion be(pred_applied, c, e.m_args);
@@ -424,10 +446,10 @@ namespace smt {
         SASSERT(is_standard_order(vars));
         unsigned depth = get_depth(e.m_pred);
         expr_ref lhs(u().mk_fun_defined(d, args), m);
-        expr_ref rhs = apply_args(depth, vars, args, e.m_cdef->get_rhs());
+        expr_ref rhs = apply_args(depth, vars, e.m_pred, args, e.m_cdef->get_rhs());
         literal_vector clause;
         for (auto & g : e.m_cdef->get_guards()) {
-            expr_ref guard = apply_args(depth, vars, args, g);
+            expr_ref guard = apply_args(depth, vars, e.m_pred, args, g);
             clause.push_back(~mk_literal(guard));
             if (clause.back() == true_literal) {
                 TRACEFN("body " << pp_body_expansion(e,m) << "\n" << clause << "\n" << guard);
@@ -463,42 +485,64 @@ namespace smt {
         }
     }
 
+    /**
+     * number of guards of `f` that are enabled in one research round.
+     * Functions whose guards keep occurring in unsat cores are unfolded
+     * with an exponentially growing number of guards per round.
+     */
+    unsigned theory_recfun::guard_budget(func_decl * f) const {
+        unsigned n = 0;
+        m_fun_rounds.find(f, n);
+        return 1u << std::min(n, 6u);
+    }
+
     // if `dlimit` or a disabled guard occurs in unsat core, return 'true'
     bool theory_recfun::should_research(expr_ref_vector & unsat_core) {
         bool found = false;
-        expr* to_delete = nullptr;
-        unsigned n = 0;
-        unsigned current_depth = UINT_MAX;
+        // disabled guards of the core, shuffled to break ties among equal depths
+        ptr_vector<expr> core_guards;
         for (auto & e : unsat_core) {
             if (is_disabled_guard(e)) {
                 found = true;
-                expr* ne = nullptr;
-                VERIFY(m.is_not(e, ne)); 
-                unsigned depth = get_depth(ne);
-                if (depth < current_depth)
-                    n = 0;
-                if (depth <= current_depth && (ctx.get_random_value() % (++n)) == 0) {
-                    to_delete = e;
-                    current_depth = depth;
-                }
+                core_guards.push_back(e);
+                unsigned j = ctx.get_random_value() % core_guards.size();
+                std::swap(core_guards[j], core_guards.back());
             }
             else if (u().is_num_rounds(e)) {
                 found = true;
             }
         }
-        if (found) {
-            m_num_rounds++;
-            if (to_delete) {
-                m_disabled_guards.erase(to_delete);
-                m_enabled_guards.push_back(to_delete);
-                m_q_guards.push_back(to_delete);
-                IF_VERBOSE(1, verbose_stream() << "(smt.recfun :enable-guard " << mk_pp(to_delete, m) << ")\n");
-            }
-            else {
-                IF_VERBOSE(1, verbose_stream() << "(smt.recfun :increment-round)\n");
-            }
+        if (!found)
+            return false;
+        m_num_rounds++;
+        auto depth_of = [&](expr* g) { expr* ng = nullptr; VERIFY(m.is_not(g, ng)); return get_depth(ng); };
+        auto fun_of = [&](expr* g) { expr* ng = nullptr; VERIFY(m.is_not(g, ng)); return u().get_case_def(to_app(ng)).get_def()->get_decl(); };
+        std::stable_sort(core_guards.begin(), core_guards.end(),
+                         [&](expr* a, expr* b) { return depth_of(a) < depth_of(b); });
+        // enable the shallowest guards of each function up to its budget
+        obj_map<func_decl, unsigned> enabled;
+        for (expr* g : core_guards) {
+            func_decl* f = fun_of(g);
+            unsigned n = 0;
+            enabled.find(f, n);
+            if (n >= guard_budget(f))
+                continue;
+            enabled.insert(f, n + 1);
+            m_disabled_guards.erase(g);
+            m_enabled_guards.push_back(g);
+            m_q_guards.push_back(g);
+            ++m_stats.m_enabled_guards;
+            IF_VERBOSE(1, verbose_stream() << "(smt.recfun :enable-guard " << mk_pp(g, m) << ")\n");
+        }
+        for (auto const& kv : enabled) {
+            unsigned n = 0;
+            m_fun_rounds.find(kv.m_key, n);
+            m_fun_rounds.insert(kv.m_key, n + 1);
         }
-        return found;
+        if (enabled.empty()) {
+            IF_VERBOSE(1, verbose_stream() << "(smt.recfun :increment-round)\n");
+        }
+        return true;
     }
 
     void theory_recfun::display(std::ostream & out) const {
@@ -510,6 +554,8 @@ namespace smt {
         st.update("recfun macro expansion", m_stats.m_macro_expansions);
         st.update("recfun case expansion", m_stats.m_case_expansions);
         st.update("recfun body expansion", m_stats.m_body_expansions);
+        st.update("recfun enabled guards", m_stats.m_enabled_guards);
+        st.update("recfun apply cache hits", m_stats.m_apply_cache_hits);
     }
 
     std::ostream& operator<<(std::ostream & out, theory_recfun::pp_case_expansion const & e) {
@@ -22,6 +22,7 @@ Revision History:
 #include "smt/smt_theory.h"
 #include "smt/smt_context.h"
 #include "ast/ast_pp.h"
+#include "util/obj_pair_hashtable.h"
 #include "ast/recfun_decl_plugin.h"
 
 namespace smt {
@@ -29,6 +30,7 @@ namespace smt {
     class theory_recfun : public theory {
         struct stats {
             unsigned m_case_expansions, m_body_expansions, m_macro_expansions;
+            unsigned m_enabled_guards, m_apply_cache_hits;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -101,6 +103,11 @@ namespace smt {
         expr_ref_vector          m_preds;
         unsigned_vector          m_preds_lim;
         unsigned                 m_num_rounds;
+        obj_map<func_decl, unsigned> m_fun_rounds;     // number of research rounds that enabled guards of a function
+
+        // substitutions of definitions by arguments, kept across depth rounds
+        obj_pair_map<expr, expr, expr*> m_apply_cache;
+        expr_ref_vector          m_apply_trail;
 
         ptr_vector<case_expansion> m_q_case_expand;
         ptr_vector<body_expansion> m_q_body_expand;
@@ -120,7 +127,8 @@ namespace smt {
         void activate_guard(expr* guard, expr_ref_vector const& guards);
 
         void reset_queues();
-        expr_ref apply_args(unsigned depth, recfun::vars const & vars, ptr_vector<expr> const & args, expr * e); //!< substitute variables by args
+        expr_ref apply_args(unsigned depth, recfun::vars const & vars, app * t, ptr_vector<expr> const & args, expr * e); //!< substitute variables by args of t
+        unsigned guard_budget(func_decl * f) const;
         void assert_macro_axiom(case_expansion & e);
         void assert_case_axioms(case_expansion & e);
         void assert_body_axiom(body_expansion & e);
@@ -278,6 +278,7 @@ theory_seq::theory_seq(context& ctx):
     theory(ctx, ctx.get_manager().mk_family_id("seq")),
     m_rep(m, m_dm),
     m_lts_checked(false),
+    m_length_abstraction_checked(false),
     m_eq_id(0),
     m_find(*this),
     m_offset_eq(*this, m),
@@ -354,6 +355,10 @@ final_check_status theory_seq::final_check_eh() {
     TRACE("seq", display(tout << "level: " << ctx.get_scope_level() << "\n"););
     TRACE("seq_verbose", ctx.display(tout););
 
+    if (check_length_abstraction()) {
+        TRACEFIN("length_abstraction");
+        return FC_CONTINUE;
+    }
     if (simplify_and_solve_eqs()) {
         ++m_stats.m_solve_eqs;
         TRACEFIN("solve_eqs");
@@ -1826,12 +1831,15 @@ void theory_seq::collect_statistics(::statistics & st) const {
     st.update("seq fixed length", m_stats.m_fixed_length);
     st.update("seq int.to.str", m_stats.m_int_string);
     st.update("seq automata", m_stats.m_propagate_automata);
+    st.update("seq length abstraction", m_stats.m_length_abstraction);
+    st.update("seq length abstraction unsat", m_stats.m_length_abstraction_unsat);
 }
 
 void theory_seq::init_search_eh() {
     m_re2aut.reset();
     m_res.reset();
     m_automata.reset();
+    m_length_abstraction_checked = false;
     auto as = get_fparams().m_arith_mode;
     if (m_has_seq && as != AS_OLD_ARITH && as != AS_NEW_ARITH) {
         throw default_exception("illegal arithmetic solver used with string solver");
@@ -368,6 +368,8 @@ namespace smt {
             unsigned m_fixed_length;
             unsigned m_propagate_contains;
             unsigned m_int_string;
+            unsigned m_length_abstraction;
+            unsigned m_length_abstraction_unsat;
         };
         typedef hashtable<rational, rational::hash_proc, rational::eq_proc> rational_set;
 
@@ -378,6 +380,7 @@ namespace smt {
         scoped_vector<nc>          m_ncs;        // set of non-contains constraints.
         scoped_vector<expr*>       m_lts;        // set of asserted str.<, str.<= literals
         bool                       m_lts_checked; 
+        bool                       m_length_abstraction_checked;
         unsigned                   m_eq_id;
         th_union_find              m_find;
         seq_offset_eq              m_offset_eq;
@@ -510,6 +513,7 @@ namespace smt {
         bool check_extensionality();
         bool check_contains();
         bool check_lts();
+        bool check_length_abstraction();
         bool solve_eqs(unsigned start);
         bool solve_eq(unsigned idx);
         bool simplify_eq(expr_ref_vector& l, expr_ref_vector& r, dependency* dep);
@@ -0,0 +1,353 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    cached_solver.cpp
+
+Abstract:
+
+    Solver that remembers the results of previous checks.
+
+--*/
+
+#include <algorithm>
+#include "util/obj_hashtable.h"
+#include "ast/expr_abstract.h"
+#include "ast/for_each_expr.h"
+#include "model/model.h"
+#include "solver/cached_solver.h"
+#include "solver/solver_params.hpp"
+
+class cached_solver : public solver {
+
+    struct entry {
+        expr_ref_vector m_key;       // abstracted assertions followed by the abstracted assumptions
+        unsigned        m_num_fmls;  // number of assertions in the key
+        expr_ref_vector m_consts;    // the constants replaced by variables
+        lbool           m_result;
+        model_ref       m_model;
+        unsigned_vector m_core;      // positions of the core in the sorted assumptions
+        entry(ast_manager& m): m_key(m), m_num_fmls(0), m_consts(m), m_result(l_undef) {}
+    };
+
+    ast_manager&        m;
+    ref<solver>         m_solver;
+    ptr_vector<entry>   m_cache;       // most recently used entry is last
+    unsigned            m_max_size;
+    unsigned            m_num_hits;
+
+    // result of the last check if it was found in the cache
+    bool                m_hit;
+    model_ref           m_model;
+    expr_ref_vector     m_core;
+
+    // key of the last check
+    expr_ref_vector     m_key;
+    unsigned            m_num_fmls;
+    expr_ref_vector     m_consts;
+    expr_ref_vector     m_sorted_asms;
+
+    u_map<unsigned>     m_hash;
+
+    unsigned get_hash(expr* e) {
+        unsigned h = 0;
+        if (m_hash.find(e->get_id(), h))
+            return h;
+        ptr_buffer<expr> todo;
+        todo.push_back(e);
+        while (!todo.empty()) {
+            expr* t = todo.back();
+            if (m_hash.contains(t->get_id())) {
+                todo.pop_back();
+                continue;
+            }
+            if (is_uninterp_const(t))
+                h = hash_u_u(17, m.get_sort(t)->get_id());
+            else if (is_var(t))
+                h = hash_u_u(7, to_var(t)->get_idx());
+            else if (is_quantifier(t)) {
+                expr* body = to_quantifier(t)->get_expr();
+                if (!m_hash.find(body->get_id(), h)) {
+                    todo.push_back(body);
+                    continue;
+                }
+                h = combine_hash(h, to_quantifier(t)->get_num_decls());
+            }
+            else {
+                app* a = to_app(t);
+                bool visited = true;
+                h = a->get_decl()->get_id();
+                for (expr* arg : *a) {
+                    unsigned ha = 0;
+                    if (!m_hash.find(arg->get_id(), ha)) {
+                        todo.push_back(arg);
+                        visited = false;
+                    }
+                    h = combine_hash(h, ha);
+                }
+                if (!visited)
+                    continue;
+            }
+            m_hash.insert(t->get_id(), h);
+            todo.pop_back();
+        }
+        return m_hash[e->get_id()];
+    }
+
+    void sort_by_hash(expr_ref_vector& es) {
+        svector<std::pair<unsigned, unsigned>> hs;
+        for (unsigned i = 0; i < es.size(); ++i)
+            hs.push_back(std::make_pair(get_hash(es.get(i)), i));
+        std::sort(hs.begin(), hs.end());
+        expr_ref_vector r(m);
+        for (auto const& p : hs)
+            r.push_back(es.get(p.second));
+        es.swap(r);
+    }
+
+    void collect_consts(expr_ref_vector const& es, expr_mark& visited) {
+        ptr_buffer<expr> todo;
+        for (unsigned i = es.size(); i-- > 0; )
+            todo.push_back(es.get(i));
+        while (!todo.empty()) {
+            expr* e = todo.back();
+            todo.pop_back();
+            if (visited.is_marked(e))
+                continue;
+            visited.mark(e, true);
+            if (is_uninterp_const(e))
+                m_consts.push_back(e);
+            else if (is_app(e)) {
+                for (unsigned i = to_app(e)->get_num_args(); i-- > 0; )
+                    todo.push_back(to_app(e)->get_arg(i));
+            }
+            else if (is_quantifier(e))
+                todo.push_back(to_quantifier(e)->get_expr());
+        }
+    }
+
+    void mk_key(unsigned num_assumptions, expr * const * assumptions) {
+        m_hash.reset();
+        m_key.reset();
+        m_consts.reset();
+        expr_ref_vector fmls(m);
+        for (unsigned i = 0; i < m_solver->get_num_assertions(); ++i)
+            fmls.push_back(m_solver->get_assertion(i));
+        m_sorted_asms.reset();
+        m_sorted_asms.append(num_assumptions, assumptions);
+        sort_by_hash(fmls);
+        sort_by_hash(m_sorted_asms);
+        expr_mark visited;
+        collect_consts(fmls, visited);
+        collect_consts(m_sorted_asms, visited);
+        for (expr* f : fmls)
+            m_key.push_back(expr_abstract(m_consts, f));
+        m_num_fmls = m_key.size();
+        for (expr* a : m_sorted_asms)
+            m_key.push_back(expr_abstract(m_consts, a));
+    }
+
+    unsigned find_entry() const {
+        for (unsigned i = m_cache.size(); i-- > 0; ) {
+            entry const& e = *m_cache[i];
+            if (e.m_key.size() == m_key.size() && e.m_num_fmls == m_num_fmls && e.m_consts.size() == m_consts.size() &&
+                std::equal(e.m_key.c_ptr(), e.m_key.c_ptr() + m_key.size(), m_key.c_ptr()))
+                return i;
+        }
+        return UINT_MAX;
+    }
+
+    /**
+       \brief model of the current constants, from the model of the constants of the entry.
+    */
+    model * translate_model(entry const& e) {
+        model* mdl = alloc(model, m);
+        model const& old = *e.m_model;
+        obj_map<func_decl, func_decl*> rename;
+        obj_hashtable<func_decl> renamed;
+        for (unsigned i = 0; i < m_consts.size(); ++i) {
+            func_decl* f = to_app(e.m_consts.get(i))->get_decl();
+            func_decl* g = to_app(m_consts.get(i))->get_decl();
+            rename.insert(f, g);
+            renamed.insert(g);
+        }
+        for (unsigned i = 0; i < old.get_num_uninterpreted_sorts(); ++i) {
+            sort* s = old.get_uninterpreted_sort(i);
+            ptr_vector<expr> const& u = old.get_universe(s);
+            mdl->register_usort(s, u.size(), u.c_ptr());
+        }
+        for (unsigned i = 0; i < old.get_num_constants(); ++i) {
+            func_decl* f = old.get_constant(i);
+            func_decl* g = nullptr;
+            if (rename.find(f, g))
+                mdl->register_decl(g, old.get_const_interp(f));
+            else if (!renamed.contains(f))
+                mdl->register_decl(f, old.get_const_interp(f));
+        }
+        for (unsigned i = 0; i < old.get_num_functions(); ++i) {
+            func_decl* f = old.get_function(i);
+            mdl->register_decl(f, old.get_func_interp(f)->copy());
+        }
+        return mdl;
+    }
+
+    bool use_cache() const {
+        return m_max_size > 0 && !m.proofs_enabled() && m_solver->get_num_assumptions() == 0;
+    }
+
+    void save_entry(lbool r) {
+        entry* e = alloc(entry, m);
+        e->m_key.append(m_key);
+        e->m_num_fmls = m_num_fmls;
+        e->m_consts.append(m_consts);
+        e->m_result = r;
+        if (r == l_true) {
+            m_solver->get_model(e->m_model);
+        }
+        else {
+            expr_ref_vector core(m);
+            m_solver->get_unsat_core(core);
+            for (expr* c : core) {
+                unsigned i = 0;
+                for (; i < m_sorted_asms.size() && m_sorted_asms.get(i) != c; ++i)
+                    ;
+                if (i == m_sorted_asms.size()) {
+                    // the core is not a subset of the assumptions
+                    dealloc(e);
+                    return;
+                }
+                e->m_core.push_back(i);
+            }
+        }
+        if (r == l_true && !e->m_model) {
+            dealloc(e);
+            return;
+        }
+        if (m_cache.size() >= m_max_size)
+            del_entry(0);
+        m_cache.push_back(e);
+    }
+
+    void updt_local_params(params_ref const& p) {
+        solver_params sp(p);
+        m_max_size = sp.cache() ? sp.cache_size() : 0;
+        while (m_cache.size() > m_max_size)
+            del_entry(0);
+    }
+
+    void del_entry(unsigned i) {
+        dealloc(m_cache[i]);
+        m_cache.erase(m_cache.begin() + i);
+    }
+
+public:
+    cached_solver(solver* s, params_ref const& p):
+        m(s->get_manager()),
+        m_solver(s),
+        m_max_size(0),
+        m_num_hits(0),
+        m_hit(false),
+        m_core(m),
+        m_key(m),
+        m_num_fmls(0),
+        m_consts(m),
+        m_sorted_asms(m) {
+        updt_local_params(p);
+    }
+
+    ~cached_solver() override {
+        for (entry* e : m_cache)
+            dealloc(e);
+    }
+
+    ast_manager& get_manager() const override { return m; }
+
+    solver* translate(ast_manager& dst, params_ref const& p) override {
+        return alloc(cached_solver, m_solver->translate(dst, p), p);
+    }
+
+    void updt_params(params_ref const & p) override {
+        solver::updt_params(p);
+        m_solver->updt_params(p);
+        updt_local_params(p);
+    }
+
+    void collect_param_descrs(param_descrs & r) override { m_solver->collect_param_descrs(r); }
+    void set_produce_models(bool f) override { m_solver->set_produce_models(f); }
+    void assert_expr_core(expr * t) override { m_solver->assert_expr(t); }
+    void assert_expr_core2(expr * t, expr * a) override { m_solver->assert_expr(t, a); }
+    void push() override { m_solver->push(); }
+    void pop(unsigned n) override { m_solver->pop(n); }
+    unsigned get_scope_level() const override { return m_solver->get_scope_level(); }
+    unsigned get_num_assertions() const override { return m_solver->get_num_assertions(); }
+    expr * get_assertion(unsigned idx) const override { return m_solver->get_assertion(idx); }
+    unsigned get_num_assumptions() const override { return m_solver->get_num_assumptions(); }
+    expr * get_assumption(unsigned idx) const override { return m_solver->get_assumption(idx); }
+    void set_progress_callback(progress_callback * callback) override { m_solver->set_progress_callback(callback); }
+    expr_ref_vector cube(expr_ref_vector& vars, unsigned backtrack_level) override { return m_solver->cube(vars, backtrack_level); }
+    std::ostream& display(std::ostream & out, unsigned n, expr* const* es) const override { return m_solver->display(out, n, es); }
+    model_converter_ref get_model_converter() const override { return m_solver->get_model_converter(); }
+    void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) override { m_solver->get_levels(vars, depth); }
+    expr_ref_vector get_trail() override { return m_solver->get_trail(); }
+    void set_reason_unknown(char const* msg) override { m_solver->set_reason_unknown(msg); }
+    void get_labels(svector<symbol> & r) override { if (!m_hit) m_solver->get_labels(r); }
+    std::string reason_unknown() const override { return m_solver->reason_unknown(); }
+    proof * get_proof() override { return m_hit ? nullptr : m_solver->get_proof(); }
+
+    lbool get_consequences_core(expr_ref_vector const& asms, expr_ref_vector const& vars, expr_ref_vector& consequences) override {
+        m_hit = false;
+        return m_solver->get_consequences(asms, vars, consequences);
+    }
+
+    lbool check_sat_core(unsigned num_assumptions, expr * const * assumptions) override {
+        m_hit = false;
+        m_model = nullptr;
+        m_core.reset();
+        if (!use_cache())
+            return m_solver->check_sat(num_assumptions, assumptions);
+        mk_key(num_assumptions, assumptions);
+        unsigned i = find_entry();
+        if (i != UINT_MAX) {
+            entry& e = *m_cache[i];
+            m_hit = true;
+            ++m_num_hits;
+            if (e.m_result == l_true)
+                m_model = translate_model(e);
+            else
+                for (unsigned j : e.m_core)
+                    m_core.push_back(m_sorted_asms.get(j));
+            // move the entry to the end of the queue
+            for (; i + 1 < m_cache.size(); ++i)
+                std::swap(m_cache[i], m_cache[i + 1]);
+            return e.m_result;
+        }
+        lbool r = m_solver->check_sat(num_assumptions, assumptions);
+        if (r != l_undef)
+            save_entry(r);
+        return r;
+    }
+
+    void collect_statistics(statistics & st) const override {
+        m_solver->collect_statistics(st);
+        st.update("solver cache hits", m_num_hits);
+    }
+
+    void get_unsat_core(expr_ref_vector & r) override {
+        if (m_hit)
+            r.append(m_core);
+        else
+            m_solver->get_unsat_core(r);
+    }
+
+    void get_model_core(model_ref & mdl) override {
+        if (m_hit)
+            mdl = m_model;
+        else
+            m_solver->get_model(mdl);
+    }
+};
+
+solver * mk_cached_solver(solver * s, params_ref const & p) {
+    return alloc(cached_solver, s, p);
+}
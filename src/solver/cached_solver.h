@@ -0,0 +1,29 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    cached_solver.h
+
+Abstract:
+
+    Solver that remembers the results of previous checks.
+
+    The key of a check is the set of assertions and assumptions where the
+    uninterpreted constants are replaced by variables. The assertions and
+    the assumptions are each sorted by a hash that does not depend on the
+    names of the constants, and the constants are numbered in the order in
+    which they occur. So the key does not depend on the order of the
+    assertions or on the names of the constants in most cases.
+
+    Satisfiable and unsatisfiable results are kept with their models and
+    cores in a cache of solver.cache.size entries, the least recently used
+    entry is replaced first. Checks with named assertions, or with proofs,
+    are not cached.
+
+--*/
+#pragma once
+
+#include "solver/solver.h"
+
+solver * mk_cached_solver(solver * s, params_ref const & p);
@@ -38,9 +38,10 @@ struct mus::imp {
     expr_ref_vector          m_soft;
     vector<rational>         m_weights;
     rational                 m_weight;
+    bool                     m_quickxplain;
 
     imp(solver& s): 
-        m_solver(s), m(s.get_manager()), m_lit2expr(m),  m_assumptions(m), m_soft(m)
+        m_solver(s), m(s.get_manager()), m_lit2expr(m),  m_assumptions(m), m_soft(m), m_quickxplain(false)
     {}
 
     void reset() {
@@ -74,9 +75,52 @@ struct mus::imp {
             mus.push_back(m_lit2expr.back());
             return l_true;
         }
+        if (m_quickxplain) 
+            return get_mus_qx(mus);
         return get_mus1(mus);
     }
 
+    // QuickXplain: split the candidates in halves and minimize the second half
+    // relative to the first, then the first half relative to the result.
+    // It uses O(k log(n/k)) checks for a minimal core of size k out of n candidates.
+    lbool get_mus_qx(expr_ref_vector& mus) {
+        ptr_vector<expr> candidates(m_lit2expr.size(), m_lit2expr.c_ptr());
+        expr_ref_vector background(m_assumptions);
+        return qx(background, false, candidates, mus);
+    }
+
+    lbool qx(expr_ref_vector& background, bool has_delta, ptr_vector<expr> const& candidates, expr_ref_vector& mus) {
+        if (has_delta) {
+            switch (m_solver.check_sat(background)) {
+            case l_false: 
+                return l_true;
+            case l_undef: 
+                return l_undef;
+            default:
+                update_model();
+                break;
+            }
+        }
+        if (candidates.size() == 1) {
+            mus.push_back(candidates[0]);
+            return l_true;
+        }
+        unsigned half = candidates.size() / 2;
+        ptr_vector<expr> first(half, candidates.c_ptr());
+        ptr_vector<expr> second(candidates.size() - half, candidates.c_ptr() + half);
+        unsigned sz = mus.size();
+        lbool is_sat;
+        {
+            scoped_append _sa(*this, background, first);
+            is_sat = qx(background, true, second, mus);
+        }
+        if (is_sat != l_true) 
+            return is_sat;
+        ptr_vector<expr> delta(mus.size() - sz, mus.c_ptr() + sz);
+        scoped_append _sa(*this, background, delta);
+        return qx(background, !delta.empty(), first, mus);
+    }
+
     lbool get_mus1(expr_ref_vector& mus) {
         ptr_vector<expr> unknown(m_lit2expr.size(), m_lit2expr.c_ptr());
         expr_ref_vector core_exprs(m);
@@ -314,6 +358,10 @@ struct mus::imp {
         out << "\n";
     }
 
+    void set_quickxplain(bool f) {
+        m_quickxplain = f;
+    }
+
     void set_soft(unsigned sz, expr* const* soft, rational const* weights) {
         m_model.reset();
         m_weight.reset();
@@ -373,6 +421,10 @@ void mus::reset() {
     m_imp->reset();
 }
 
+void mus::set_quickxplain(bool f) {
+    m_imp->set_quickxplain(f);
+}
+
 void mus::set_soft(unsigned sz, expr* const* soft, rational const* weights) {
     m_imp->set_soft(sz, soft, weights);
 }
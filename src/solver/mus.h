@@ -48,6 +48,13 @@ class mus {
     void add_assumption(expr* lit);
 
     lbool get_mus(expr_ref_vector& mus);
+
+    /**
+       Use divide-and-conquer (QuickXplain) instead of removing one 
+       soft constraint at a time. It takes fewer checks when the 
+       minimal core is small compared to the set of soft constraints.
+    */
+    void set_quickxplain(bool f);
     
     void reset();
     
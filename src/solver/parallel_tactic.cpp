@@ -29,6 +29,7 @@ Notes:
 --*/
 
 #include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 #include "ast/ast_translation.h"
@@ -48,6 +49,8 @@ tactic * mk_parallel_tactic(solver* s, params_ref const& p) {
 #else
 
 #include <thread>
+#include <fstream>
+#include <sstream>
 #include <mutex>
 #include <cmath>
 #include <condition_variable>
@@ -195,6 +198,7 @@ class parallel_tactic : public tactic {
         ref<solver>     m_solver;                 // solver state
         unsigned        m_depth;                  // number of nested calls to cubing
         double          m_width;                  // estimate of fraction of problem handled by state
+        unsigned        m_config;                 // index of portfolio configuration used for conquer
         bool            m_giveup;
 
     public:
@@ -206,6 +210,7 @@ class parallel_tactic : public tactic {
             m_solver(s),
             m_depth(0),
             m_width(1.0),
+            m_config(0),
             m_giveup(false)
         {
         }
@@ -265,6 +270,8 @@ class parallel_tactic : public tactic {
         
         double get_width() const { return m_width; }
 
+        void set_config(unsigned c) { m_config = c; }
+
         unsigned get_depth() const { return m_depth; }
 
         lbool simplify() {
@@ -310,9 +317,28 @@ class parallel_tactic : public tactic {
             p.set_bool("lookahead_simplify", false);
             p.set_uint("restart.max", pp.conquer_restart_max());
             p.set_uint("inprocess.max", UINT_MAX);    // base bounds on restart.max
+            set_portfolio_params(pp.conquer_portfolio(), p);
             s.updt_params(p);
         }
 
+        /**
+           \brief diversify the conquer solvers of different states by
+           cycling through combinations of phase selection, restart strategy
+           and branching heuristic. Each configuration also gets its own seed.
+        */
+        void set_portfolio_params(unsigned n, params_ref& p) {
+            if (n == 0) 
+                return;
+            static char const* phases[3]    = { "caching", "always_false", "random" };
+            static char const* restarts[3]  = { "ema", "luby", "geometric" };
+            static char const* branching[2] = { "vsids", "chb" };
+            unsigned k = m_config % n;
+            p.set_sym("phase", symbol(phases[k % 3]));
+            p.set_sym("restart", symbol(restarts[(k / 3) % 3]));
+            p.set_sym("branching.heuristic", symbol(branching[(k / 9) % 2]));
+            p.set_uint("random_seed", p.get_uint("random_seed", 0) + k);
+        }
+
         void set_simplify_params(bool retain_blocked) {
             parallel_params pp(m_params);
             params_ref p;
@@ -359,6 +385,10 @@ private:
     bool          m_allsat;
     unsigned      m_num_unsat;
     unsigned      m_last_depth;
+    unsigned      m_num_states;
+    std::string   m_export_dir;
+    unsigned      m_export_depth;
+    unsigned      m_num_exported;
     int           m_exn_code;
     std::string   m_exn_msg;
 
@@ -371,6 +401,10 @@ private:
         m_branches = 0;    
         m_num_unsat = 0;
         m_last_depth = 0;
+        m_num_states = 0;
+        m_export_dir = pp.export_dir();
+        m_export_depth = pp.export_depth();
+        m_num_exported = 0;
         m_backtrack_frequency = pp.conquer_backtrack_frequency();
         m_conquer_delay = pp.conquer_delay();
         m_exn_code = 0;
@@ -462,6 +496,33 @@ private:
         close_branch(s, l_undef);
     }
 
+    /**
+       \brief write the state as a stand-alone SMT-LIB benchmark to the export 
+       directory once it reaches the export depth. The asserted cubes are part 
+       of the assertions of the solver, so each file can be solved by an 
+       independent process. The branch is closed as unknown locally.       
+    */
+    bool export_cube(solver_state& s) {
+        if (m_export_dir.empty() || s.has_assumptions() || s.get_depth() < m_export_depth) 
+            return false;
+        unsigned id;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            id = m_num_exported++;
+        }
+        std::stringstream strm;
+        strm << m_export_dir << "/cube-" << id << ".smt2";
+        std::ofstream out(strm.str());
+        if (!out) 
+            throw default_exception("could not open file '" + strm.str() + "' for exporting cube");
+        s.get_solver().display(out);
+        out << "(check-sat)\n";
+        out.close();
+        IF_VERBOSE(1, verbose_stream() << "(tactic.parallel :export " << strm.str() << ")\n";);
+        report_undef(s);
+        return true;
+    }
+
     void cube_and_conquer(solver_state& s) {
         ast_manager& m = s.m();
         vector<cube_var> cube, hard_cubes, cubes;
@@ -494,6 +555,7 @@ private:
         }
         if (canceled(s)) return;
         if (s.giveup()) { report_undef(s); return; }
+        if (export_cube(s)) return;
         
         if (memory_pressure()) {
             goto simplify_again;
@@ -585,6 +647,10 @@ private:
         s.set_cubes(cubes);
         solver_state* s1 = s.clone();
         s1->inc_width(width);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            s1->set_config(++m_num_states);
+        }
         m_queue.add_task(s1);
     }
 
@@ -674,11 +740,7 @@ private:
 
     lbool solve(model_ref& mdl) {        
         add_branches(1);
-        vector<std::thread> threads;
-        for (unsigned i = 0; i < m_num_threads; ++i) 
-            threads.push_back(std::thread([this]() { run_solver(); }));
-        for (std::thread& t : threads) 
-            t.join();
+        thread_pool::run(m_num_threads, [this](unsigned) { run_solver(); });
         m_manager.limit().reset_cancel();
         if (m_exn_code == -1) 
             throw default_exception(std::move(m_exn_msg));
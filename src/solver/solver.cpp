@@ -185,6 +185,143 @@ lbool solver::preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>
     return check_sat(0, nullptr);
 }
 
+lbool solver::enumerate(expr_ref_vector const& vars, unsigned max_models, vector<expr_ref_vector>& models) {
+    ast_manager& m = vars.get_manager();
+    // the literals of the prefixes are kept alive by lits.
+    expr_ref_vector lits(m), cube(m);
+    vector<ptr_vector<expr>> todo;
+    todo.push_back(ptr_vector<expr>());
+    bool found = false;
+    while (!todo.empty()) {
+        ptr_vector<expr> prefix(todo.back());
+        todo.pop_back();
+        lbool r = check_sat(prefix.size(), prefix.c_ptr());
+        if (r == l_undef) 
+            return l_undef;
+        if (r == l_false) 
+            continue;
+        found = true;
+        model_ref mdl;
+        get_model(mdl);
+        if (!mdl) 
+            return l_undef;
+        model::scoped_model_completion _scm(*mdl, true);
+        cube.reset();
+        cube.append(prefix.size(), prefix.c_ptr());
+        for (unsigned i = prefix.size(); i < vars.size(); ++i) {
+            expr* v = vars.get(i);
+            expr* lit = mdl->is_false(v) ? mk_not(m, v) : v;
+            lits.push_back(lit);
+            cube.push_back(lit);
+        }
+        models.push_back(cube);
+        if (models.size() == max_models) 
+            break;
+        // the other models that extend the prefix first differ from cube at some position i.
+        for (unsigned i = vars.size(); i-- > prefix.size(); ) {
+            ptr_vector<expr> next(i, cube.c_ptr());
+            expr* lit = mk_not(m, cube.get(i));
+            lits.push_back(lit);
+            next.push_back(lit);
+            todo.push_back(next);
+        }
+    }
+    return found ? l_true : l_false;
+}
+
+lbool solver::approx_count(expr_ref_vector const& vars, unsigned threshold, unsigned iterations, rational& count) {
+    ast_manager& m = vars.get_manager();
+    vector<expr_ref_vector> models;
+    count.reset();
+    threshold = std::max(threshold, 1u);
+    lbool r = enumerate(vars, threshold + 1, models);
+    if (r != l_true) 
+        return r;
+    if (models.size() <= threshold) {
+        count = rational(models.size());
+        return l_true;
+    }
+    random_gen rand;
+    vector<rational> estimates;
+    for (unsigned i = 0; i < std::max(iterations, 1u); ++i) {
+        for (unsigned k = 1; k <= vars.size(); ++k) {
+            // add k random parity constraints to select one of 2^k cells.
+            scoped_push _push(*this);
+            for (unsigned j = 0; j < k; ++j) {
+                expr_ref x(rand(2) ? m.mk_true() : m.mk_false(), m);
+                for (expr* v : vars) 
+                    if (rand(2)) 
+                        x = m.mk_xor(x, v);
+                assert_expr(x);
+            }
+            models.reset();
+            r = enumerate(vars, threshold + 1, models);
+            if (r == l_undef) 
+                return l_undef;
+            if (models.size() <= threshold) {
+                estimates.push_back(rational(models.size()) * rational::power_of_two(k));
+                break;
+            }
+        }
+    }
+    if (estimates.empty()) {
+        count = rational::power_of_two(vars.size());
+        return l_true;
+    }
+    std::sort(estimates.begin(), estimates.end());
+    count = estimates[estimates.size() / 2];
+    return l_true;
+}
+
+lbool solver::get_backbone(expr_ref_vector const& vars, unsigned chunk_size, expr_ref_vector& backbone) {
+    ast_manager& m = vars.get_manager();
+    lbool r = check_sat(0, nullptr);
+    if (r != l_true) 
+        return r;
+    model_ref mdl;
+    get_model(mdl);
+    if (!mdl) 
+        return l_undef;
+    expr_ref_vector candidates(m), chunk(m);
+    {
+        model::scoped_model_completion _scm(*mdl, true);
+        for (expr* v : vars) 
+            candidates.push_back(mdl->is_false(v) ? mk_not(m, v) : v);
+    }
+    unsigned max_chunk = std::max(chunk_size, 1u);
+    unsigned sz = max_chunk;
+    while (!candidates.empty()) {
+        chunk.reset();
+        unsigned n = std::min(sz, candidates.size());
+        for (unsigned i = candidates.size() - n; i < candidates.size(); ++i) 
+            chunk.push_back(mk_not(m, candidates.get(i)));
+        {
+            scoped_push _push(*this);
+            assert_expr(mk_or(chunk));
+            r = check_sat(0, nullptr);
+            if (r == l_true) 
+                get_model(mdl);
+        }
+        if (r == l_undef || !mdl) 
+            return l_undef;
+        if (r == l_false) {
+            for (unsigned i = 0; i < n; ++i) 
+                backbone.push_back(candidates.back()), candidates.pop_back();
+            sz = std::min(2 * sz, max_chunk);
+            continue;
+        }
+        // the model falsifies at least one literal of the chunk.
+        model::scoped_model_completion _scm(*mdl, true);
+        unsigned j = 0;
+        for (expr* c : candidates) 
+            if (mdl->is_true(c)) 
+                candidates.set(j++, c);
+        candidates.shrink(j);
+        sz = std::max(1u, sz / 2);
+    }
+    return l_true;
+}
+
 
 static bool is_m_atom(ast_manager& m, expr* f) {
     if (!is_app(f)) return true;
@@ -221,6 +221,34 @@ public:
      */
     virtual lbool preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>& cores);
 
+    /**
+       \brief Enumerate the assignments to the Boolean expressions vars that extend to models
+       of the assertions. Each assignment is added to models as a vector of literals over vars.
+       At most max_models assignments are produced, all of them if max_models is 0.
+
+       No blocking clauses are added: every check assumes a prefix of an assignment that was
+       already found, with its last literal flipped, so the subtrees that are searched are disjoint.
+       Returns l_false if there are no models, l_undef if a check is undecided and l_true otherwise.
+     */
+    virtual lbool enumerate(expr_ref_vector const& vars, unsigned max_models, vector<expr_ref_vector>& models);
+
+    /**
+       \brief Estimate the number of assignments to the Boolean expressions vars that extend to models
+       of the assertions. The count is exact if it is at most threshold. Otherwise the models are
+       split into cells by random XOR constraints over vars, until a cell has at most threshold
+       assignments, and the estimate is the size of the cell times the number of cells.
+       The median of iterations estimates is returned in count.
+     */
+    virtual lbool approx_count(expr_ref_vector const& vars, unsigned threshold, unsigned iterations, rational& count);
+
+    /**
+       \brief Retrieve the literals over the Boolean expressions vars that hold in every model of the assertions.
+       The candidates are the literals of a first model. Candidates are tested in chunks of up to chunk_size
+       literals by checking the negation of their conjunction: if it is unsatisfiable the chunk is part of the
+       backbone, otherwise every candidate that the new model falsifies is dropped and the chunk is halved.
+     */
+    virtual lbool get_backbone(expr_ref_vector const& vars, unsigned chunk_size, expr_ref_vector& backbone);
+
     /**
        \brief extract a lookahead candidates for branching.
     */
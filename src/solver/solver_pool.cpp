@@ -27,6 +27,7 @@ class pool_solver : public solver_na2as {
     app_ref            m_pred;
     proof_ref          m_proof;
     ref<solver>        m_base;
+    unsigned           m_base_idx;
     expr_ref_vector    m_assertions;
     unsigned           m_head;
     expr_ref_vector    m_flat;
@@ -39,12 +40,13 @@ class pool_solver : public solver_na2as {
 
     bool is_virtual() const { return !m.is_true(m_pred); }
 public:
-    pool_solver(solver* b, solver_pool& pool, app_ref& pred):
+    pool_solver(solver* b, unsigned idx, solver_pool& pool, app_ref& pred):
         solver_na2as(pred.get_manager()),
         m_pool(pool),
         m_pred(pred),
         m_proof(m),
         m_base(b),
+        m_base_idx(idx),
         m_assertions(m),
         m_head(0),
         m_flat(m),
@@ -69,6 +71,8 @@ public:
 
     solver* base_solver() { return m_base.get(); }
 
+    unsigned base_idx() const { return m_base_idx; }
+
     solver* translate(ast_manager& m, params_ref const& p) override { UNREACHABLE(); return nullptr; }
     void updt_params(params_ref const& p) override {
         solver::updt_params(p); m_base->updt_params(p);
@@ -132,6 +136,7 @@ public:
         m_proof.reset();
         scoped_watch _t_(m_pool.m_check_watch);
         m_pool.m_stats.m_num_checks++;
+        m_pool.m_base_checks[m_base_idx]++;
 
         stopwatch sw;
         sw.start();
@@ -166,6 +171,7 @@ public:
         m_proof.reset();
         scoped_watch _t_(m_pool.m_check_watch);
         m_pool.m_stats.m_num_checks++;
+        m_pool.m_base_checks[m_base_idx]++;
 
         stopwatch sw;
         sw.start();
@@ -337,11 +343,8 @@ solver_pool::solver_pool(solver* base_solver, unsigned num_pools):
 
 ptr_vector<solver> solver_pool::get_base_solvers() const {
     ptr_vector<solver> solvers;
-    for (solver* s0 : m_solvers) {
-        pool_solver* s = dynamic_cast<pool_solver*>(s0);
-        if (!solvers.contains(s->base_solver())) {
-            solvers.push_back(s->base_solver());
-        }
+    for (solver* s : m_base_solvers) {
+        solvers.push_back(s);
     }
     return solvers;
 }
@@ -379,24 +382,30 @@ void solver_pool::reset_statistics() {
 /**
    \brief Create a fresh solver instance.
    The first num_pools solvers are independent and
-   use a fresh instance of the base solver.
-   Subsequent solvers reuse the first num_polls base solvers, rotating
-   among the first num_pools.
+   use a fresh instance of the base solver, which is created
+   on demand by translation.
+   Subsequent solvers share one of the first num_pools base solvers.
+   They are attached to the base solver that has served the fewest 
+   checks, so that frequently queried solvers do not all end up 
+   in the same context.
 */
 solver* solver_pool::mk_solver() {
-    ref<solver> base_solver;
     ast_manager& m = m_base_solver->get_manager();
-    if (m_solvers.size() < m_num_pools) {
-        base_solver = m_base_solver->translate(m, m_base_solver->get_params());
+    unsigned idx = m_base_solvers.size();
+    if (idx < m_num_pools) {
+        m_base_solvers.push_back(m_base_solver->translate(m, m_base_solver->get_params()));
+        m_base_checks.push_back(0);
     }
     else {
-        solver* s = m_solvers[(m_current_pool++) % m_num_pools];
-        base_solver = dynamic_cast<pool_solver*>(s)->base_solver();
+        idx = (m_current_pool++) % m_num_pools;
+        for (unsigned i = 0; i < m_num_pools; ++i) 
+            if (m_base_checks[i] < m_base_checks[idx]) 
+                idx = i;
     }
     std::stringstream name;
     name << "vsolver#" << m_solvers.size();
     app_ref pred(m.mk_const(symbol(name.str().c_str()), m.mk_bool_sort()), m);
-    pool_solver* solver = alloc(pool_solver, base_solver.get(), *this, pred);
+    pool_solver* solver = alloc(pool_solver, m_base_solvers.get(idx), idx, *this, pred);
     m_solvers.push_back(solver);
     return solver;
 }
@@ -410,6 +419,12 @@ void solver_pool::reset_solver(solver* s) {
 void solver_pool::refresh(solver* base_solver) {
     ast_manager& m = m_base_solver->get_manager();
     ref<solver> new_base = m_base_solver->translate(m, m_base_solver->get_params());
+    for (unsigned i = 0; i < m_base_solvers.size(); ++i) {
+        if (m_base_solvers.get(i) == base_solver) {
+            m_base_solvers.set(i, new_base.get());
+            m_base_checks[i] = 0;
+        }
+    }
     for (solver* s0 : m_solvers) {
         pool_solver* s = dynamic_cast<pool_solver*>(s0);
         if (base_solver == s->base_solver()) {
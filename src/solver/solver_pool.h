@@ -46,6 +46,8 @@ class solver_pool {
     unsigned            m_num_pools;
     unsigned            m_current_pool;
     sref_vector<solver> m_solvers;
+    sref_vector<solver> m_base_solvers;  // the base solvers shared by the pool solvers
+    unsigned_vector     m_base_checks;   // number of checks served by each base solver
     stats               m_stats;
 
     stopwatch m_check_watch;
@@ -150,6 +150,10 @@ struct ctx_simplify_tactic::imp {
         cache_cell():m_from(nullptr), m_result(nullptr) {}
     };
 
+    typedef std::pair<unsigned, unsigned> u_pair;
+    typedef map<u_pair, unsigned, pair_hash<unsigned_hash, unsigned_hash>, default_eq<u_pair> > u_pair2u;
+    typedef map<u_pair, expr*, pair_hash<unsigned_hash, unsigned_hash>, default_eq<u_pair> > u_pair2expr;
+
     ast_manager &               m;
     simplifier*                 m_simp;
     small_object_allocator      m_allocator;
@@ -164,12 +168,29 @@ struct ctx_simplify_tactic::imp {
     unsigned                    m_max_steps;
     bool                        m_bail_on_blowup;
 
+    // Context signatures: 
+    // m_ctx_sig[lvl] identifies the sequence of assertions that created the scopes up to lvl. 
+    // Signatures are hash-consed from the signature of the parent scope and the asserted literal,
+    // so a context that is recreated after a pop gets the same signature again.
+    // m_ctx_cache maps a signature and a shared expression to its simplification in that context,
+    // it survives pops.
+    bool                        m_context_cache;
+    unsigned                    m_max_context_cache;
+    unsigned_vector             m_ctx_sig;
+    u_pair2u                    m_ctx_sigs;
+    u_pair2expr                 m_ctx_cache;
+    expr_ref_vector             m_ctx_pinned;
+    unsigned                    m_num_ctx_hits;
+
     imp(ast_manager & _m, simplifier* simp, params_ref const & p):
         m(_m),
         m_simp(simp),
         m_allocator("context-simplifier"),
         m_occs(m, true, true),
-        m_mk_app(m, p) {
+        m_mk_app(m, p),
+        m_ctx_pinned(m),
+        m_num_ctx_hits(0) {
+        m_ctx_sig.push_back(0);
         updt_params(p);
         m_simp->set_occs(m_occs);
     }
@@ -197,6 +218,8 @@ struct ctx_simplify_tactic::imp {
         m_max_steps    = p.get_uint("max_steps", UINT_MAX);
         m_max_depth    = p.get_uint("max_depth", 1024);
         m_bail_on_blowup = p.get_bool("bail_on_blowup", false);
+        m_context_cache = p.get_bool("context_cache", true);
+        m_max_context_cache = p.get_uint("max_context_cache", 1000000);
         m_simp->updt_params(p);
     }
 
@@ -249,8 +272,45 @@ struct ctx_simplify_tactic::imp {
     }
 
     void cache(expr * from, expr * to) {
-        if (shared(from))
+        if (shared(from)) {
             cache_core(from, to);
+            ctx_cache_core(from, to);
+        }
+    }
+
+    void reset_ctx_cache() {
+        m_ctx_sigs.reset();
+        m_ctx_cache.reset();
+        m_ctx_pinned.reset();
+        // signatures of open scopes are forgotten.
+        m_ctx_sig.reset();
+        m_ctx_sig.resize(scope_level() + 1, UINT_MAX);
+        m_ctx_sig[0] = 0;
+    }
+
+    unsigned ctx_sig() const {
+        return m_ctx_sig[scope_level()];
+    }
+
+    void ctx_cache_core(expr * from, expr * to) {
+        if (m_context_cache && m_ctx_cache.size() >= m_max_context_cache) 
+            reset_ctx_cache();
+        if (!m_context_cache || ctx_sig() == UINT_MAX)
+            return;
+        m_ctx_pinned.push_back(from);
+        m_ctx_pinned.push_back(to);
+        m_ctx_cache.insert(u_pair(ctx_sig(), from->get_id()), to);
+    }
+
+    bool is_ctx_cached(expr * t, expr_ref & r) {
+        expr * to = nullptr;
+        if (!m_context_cache || ctx_sig() == UINT_MAX || !m_ctx_cache.find(u_pair(ctx_sig(), t->get_id()), to))
+            return false;
+        m_num_ctx_hits++;
+        r = to;
+        // make the result available at the current scope.
+        cache_core(t, to);
+        return true;
     }
 
     unsigned scope_level() const {
@@ -294,6 +354,7 @@ struct ctx_simplify_tactic::imp {
 
         unsigned lvl = scope_level();
         m_simp->pop(num_scopes);
+        m_ctx_sig.shrink(scope_level() + 1);
 
         // restore cache
         for (unsigned i = 0; i < num_scopes; i++) {
@@ -304,7 +365,24 @@ struct ctx_simplify_tactic::imp {
     }
 
     bool assert_expr(expr * t, bool sign) {
-        return m_simp->assert_expr(t, sign);
+        if (m_context_cache && m_ctx_sigs.size() >= m_max_context_cache)
+            reset_ctx_cache();
+        unsigned old_lvl = scope_level();
+        bool r = m_simp->assert_expr(t, sign);
+        if (scope_level() > old_lvl) {
+            unsigned sig = UINT_MAX;
+            unsigned parent = m_ctx_sig[old_lvl];
+            if (m_context_cache && parent != UINT_MAX) {
+                u_pair key(parent, 2 * t->get_id() + (sign ? 1 : 0));
+                if (!m_ctx_sigs.find(key, sig)) {
+                    sig = m_ctx_sigs.size() + 1;
+                    m_ctx_sigs.insert(key, sig);
+                    m_ctx_pinned.push_back(t);
+                }
+            }
+            m_ctx_sig.resize(scope_level() + 1, sig);
+        }
+        return r;
     }
 
     bool is_cached(expr * t, expr_ref & r) {
@@ -330,7 +408,7 @@ struct ctx_simplify_tactic::imp {
         }
         checkpoint();
         TRACE("ctx_simplify_tactic_detail", tout << "processing: " << mk_bounded_pp(t, m) << "\n";);
-        if (is_cached(t, r) || m_simp->simplify(t, r)) {
+        if (is_cached(t, r) || is_ctx_cached(t, r) || m_simp->simplify(t, r)) {
             SASSERT(r.get() != 0);
             return;
         }
@@ -536,6 +614,8 @@ struct ctx_simplify_tactic::imp {
         pop(scope_level() - old_lvl);
 
         m_occs(g);
+        // the simplifiers depend on the shared occurrences.
+        reset_ctx_cache();
 
         // go backwards
         sz = g.size();
@@ -570,6 +650,7 @@ struct ctx_simplify_tactic::imp {
     void operator()(goal & g) {
         m_occs.reset();
         m_occs(g);
+        reset_ctx_cache();
         m_num_steps = 0;
         unsigned sz = g.size();
         tactic_report report("ctx-simplify", g);
@@ -586,7 +667,8 @@ struct ctx_simplify_tactic::imp {
         else {
             process_goal(g);
         }
-        IF_VERBOSE(TACTIC_VERBOSITY_LVL, verbose_stream() << "(ctx-simplify :num-steps " << m_num_steps << ")\n";);
+        IF_VERBOSE(TACTIC_VERBOSITY_LVL, verbose_stream() << "(ctx-simplify :num-steps " << m_num_steps << " :context-cache-hits " << m_num_ctx_hits << ")\n";);
+        reset_ctx_cache();
     }
 
 };
@@ -614,6 +696,8 @@ void ctx_simplify_tactic::get_param_descrs(param_descrs & r) {
     insert_max_steps(r);
     r.insert("max_depth", CPK_UINT, "(default: 1024) maximum term depth.");
     r.insert("propagate_eq", CPK_BOOL, "(default: false) enable equality propagation from bounds.");
+    r.insert("context_cache", CPK_BOOL, "(default: true) reuse simplifications of shared terms when the same context is recreated.");
+    r.insert("max_context_cache", CPK_UINT, "(default: 1000000) maximum number of entries kept for context-cache.");
 }
 
 void ctx_simplify_tactic::operator()(goal_ref const & in,
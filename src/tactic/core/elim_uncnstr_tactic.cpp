@@ -23,7 +23,6 @@ Notes:
 #include "ast/bv_decl_plugin.h"
 #include "ast/array_decl_plugin.h"
 #include "ast/datatype_decl_plugin.h"
-#include "tactic/core/collect_occs.h"
 #include "ast/ast_smt2_pp.h"
 #include "ast/ast_ll_pp.h"
 
@@ -758,6 +757,9 @@ class elim_uncnstr_tactic : public tactic {
     ast_manager &                    m_manager;
     ref<mc>                          m_mc;
     obj_hashtable<expr>              m_vars;
+    obj_map<expr, unsigned>          m_num_occs;
+    obj_hashtable<expr>              m_touched;
+    ptr_vector<expr>                 m_todo;
     scoped_ptr<rw>                   m_rw;
     unsigned                         m_num_elim_apps = 0;
     unsigned long long               m_max_memory;
@@ -776,20 +778,134 @@ class elim_uncnstr_tactic : public tactic {
         m_rw = alloc(rw, m(), produce_proofs, m_vars, m_mc.get(), m_max_memory, m_max_steps);            
     }
 
+    // number of occurrences of each sub-term in the DAG of the goal, 
+    // that is, the number of distinct parents (and formulas) containing it.
+    // An uninterpreted constant is unconstrained if it occurs once.
+    void inc_occs(expr * t) {
+        m_todo.push_back(t);
+        while (!m_todo.empty()) {
+            expr * e = m_todo.back();
+            m_todo.pop_back();
+            if (is_var(e) || (is_app(e) && to_app(e)->get_num_args() == 0 && !is_uninterp_const(e)))
+                continue;
+            unsigned & n = m_num_occs.insert_if_not_there(e, 0);
+            ++n;
+            if (is_uninterp_const(e)) 
+                m_touched.insert(e);
+            else if (n == 1) 
+                push_children(e);
+        }
+    }
+
+    void dec_occs(expr * t) {
+        m_todo.push_back(t);
+        while (!m_todo.empty()) {
+            expr * e = m_todo.back();
+            m_todo.pop_back();
+            if (is_var(e) || (is_app(e) && to_app(e)->get_num_args() == 0 && !is_uninterp_const(e)))
+                continue;
+            auto * entry = m_num_occs.find_core(e);
+            SASSERT(entry && entry->get_data().m_value > 0);
+            unsigned n = --entry->get_data().m_value;
+            if (is_uninterp_const(e))
+                m_touched.insert(e);
+            if (n == 0) {
+                m_num_occs.erase(e);
+                push_children(e);
+            }
+        }
+    }
+
+    void push_children(expr * e) {
+        if (is_app(e)) 
+            m_todo.append(to_app(e)->get_num_args(), to_app(e)->get_args());
+        else if (is_quantifier(e)) 
+            // don't need to visit patterns
+            m_todo.push_back(to_quantifier(e)->get_expr());
+    }
+
+    /**
+       \brief update m_vars for the constants whose number of occurrences changed,
+       and collect in new_vars the constants that became unconstrained.
+    */
+    void update_vars(ptr_vector<expr> & new_vars) {
+        for (expr * v : m_touched) {
+            unsigned n = 0;
+            m_num_occs.find(v, n);
+            if (n == 1) {
+                if (!m_vars.contains(v)) {
+                    m_vars.insert(v);
+                    new_vars.push_back(v);
+                }
+            }
+            else {
+                m_vars.remove(v);
+            }
+        }
+        m_touched.reset();
+    }
+
+    /**
+       \brief collect the indices of formulas that contain one of vars.
+    */
+    void collect_formulas_with(goal const & g, ptr_vector<expr> const & vars, bool_vector const & skip, unsigned_vector & result) {
+        expr_mark visited, has_var;
+        for (expr * v : vars) {
+            visited.mark(v, true);
+            has_var.mark(v, true);
+        }
+        ptr_vector<expr> & todo = m_todo;
+        for (unsigned idx = 0; idx < g.size(); ++idx) {
+            if (skip[idx])
+                continue;
+            todo.push_back(g.form(idx));
+            while (!todo.empty()) {
+                expr * e = todo.back();
+                if (visited.is_marked(e)) {
+                    todo.pop_back();
+                    continue;
+                }
+                unsigned sz = todo.size();
+                push_children(e);
+                bool has = false;
+                for (unsigned i = sz; i < todo.size(); ++i) {
+                    expr * c = todo[i];
+                    if (!visited.is_marked(c)) 
+                        todo[sz++] = c;
+                    else if (has_var.is_marked(c))
+                        has = true;
+                }
+                todo.shrink(sz);
+                if (todo.back() != e) 
+                    continue;
+                todo.pop_back();
+                visited.mark(e, true);
+                if (has)
+                    has_var.mark(e, true);
+            }
+            if (has_var.is_marked(g.form(idx)))
+                result.push_back(idx);
+        }
+    }
+
     void run(goal_ref const & g, goal_ref_buffer & result) {
         bool produce_proofs = g->proofs_enabled();
         
         TRACE("goal", g->display(tout););
         tactic_report report("elim-uncnstr", *g);
         m_vars.reset();
-        collect_occs p;
-        p(*g, m_vars);
+        m_num_occs.reset();
+        m_touched.reset();
+        for (unsigned idx = 0; idx < g->size(); ++idx)
+            inc_occs(g->form(idx));
+        ptr_vector<expr> new_vars;
+        update_vars(new_vars);
         if (m_vars.empty()) {
+            m_num_occs.reset();
             result.push_back(g.get());
             // did not increase depth since it didn't do anything.
             return;
         }
-        bool modified = true;
         TRACE("elim_uncnstr", tout << "unconstrained variables...\n";
                 for (expr * v : m_vars) tout << mk_ismt2_pp(v, m()) << " "; 
                 tout << "\n";);
@@ -799,22 +915,29 @@ class elim_uncnstr_tactic : public tactic {
         expr_ref   new_f(m());
         proof_ref  new_pr(m());
         unsigned round = 0;
-        unsigned size  = g->size();
-        unsigned idx   = 0;
+        bool_vector     in_todo;
+        unsigned_vector todo, modified;
+        for (unsigned idx = 0; idx < g->size(); ++idx)
+            todo.push_back(idx);
+        // Only the formulas that were rewritten in the previous round, or that contain
+        // constants that became unconstrained, are rewritten again.
         while (true) {
-            for (; idx < size; idx++) {
+            modified.reset();
+            for (unsigned idx : todo) {
                 expr * f = g->form(idx);
                 m_rw->operator()(f, new_f, new_pr);
                 if (f == new_f)
                     continue;
-                modified = true;
+                modified.push_back(idx);
                 if (produce_proofs) {
                     proof * pr = g->pr(idx);
                     new_pr     = m().mk_modus_ponens(pr, new_pr);
                 }
+                inc_occs(new_f);
+                dec_occs(f);
                 g->update(idx, new_f, new_pr, g->dep(idx));
             }
-            if (!modified) {
+            if (modified.empty()) {
                 if (round == 0) {                        
                 }
                 else {
@@ -824,24 +947,28 @@ class elim_uncnstr_tactic : public tactic {
                 TRACE("elim_uncnstr", if (m_mc) m_mc->display(tout); else tout << "no mc\n";);
                 m_mc = nullptr;
                 m_rw = nullptr;                    
+                m_num_occs.reset();
+                m_touched.reset();
                 result.push_back(g.get());
                 g->inc_depth();
                 TRACE("goal", g->display(tout););
                 return;
             }
-            modified = false;
             round ++;
-            size       = g->size();
             m_rw->reset(); // reset cache
-            m_vars.reset(); 
-            {
-                collect_occs p;
-                p(*g, m_vars);
-            }
+            new_vars.reset();
+            update_vars(new_vars);
+            todo.reset();
             if (m_vars.empty()) 
-                idx = size; // force to finish 
-            else
-                idx = 0;
+                continue; // force to finish 
+            todo.append(modified);
+            if (!new_vars.empty()) {
+                in_todo.reset();
+                in_todo.resize(g->size(), false);
+                for (unsigned idx : modified)
+                    in_todo[idx] = true;
+                collect_formulas_with(*g, new_vars, in_todo, todo);
+            }
         }
     }
     
@@ -877,6 +1004,8 @@ public:
         m_mc = nullptr;
         m_rw = nullptr;
         m_vars.reset();
+        m_num_occs.reset();
+        m_touched.reset();
     }
 
     void collect_statistics(statistics & st) const override {
@@ -37,6 +37,15 @@ class propagate_values_tactic : public tactic {
     unsigned                      m_max_rounds;
     bool                          m_modified;
     params_ref                    m_params;
+    // Index from shared terms to the formulas that contain them.
+    // A formula that was already rewritten is rewritten again in a pass
+    // only if it contains a term that is in the current substitution (m_dirty).
+    bool                          m_use_index;
+    obj_map<expr, unsigned>       m_term2slot;
+    vector<unsigned_vector>       m_slot2forms;
+    bool_vector                   m_rewritten;
+    bool_vector                   m_dirty;
+    unsigned                      m_num_skipped;
 
     void updt_params_core(params_ref const & p) {
         tactic_params tp(p);
@@ -72,6 +81,51 @@ class propagate_values_tactic : public tactic {
         return false;
     }
 
+    void build_index() {
+        m_term2slot.reset();
+        m_slot2forms.reset();
+        m_dirty.reset();
+        m_dirty.resize(m_goal->size(), false);
+        if (!m_use_index)
+            return;
+        expr_fast_mark1 visited;
+        ptr_buffer<expr, 128> todo;
+        unsigned sz = m_goal->size();
+        for (unsigned idx = 0; idx < sz; ++idx) {
+            if (!m_rewritten.get(idx, false))
+                continue;
+            todo.push_back(m_goal->form(idx));
+            while (!todo.empty()) {
+                expr * e = todo.back();
+                todo.pop_back();
+                if (visited.is_marked(e))
+                    continue;
+                visited.mark(e, true);
+                if (is_shared(e)) {
+                    unsigned slot = m_slot2forms.size();
+                    if (!m_term2slot.find(e, slot)) {
+                        m_term2slot.insert(e, slot);
+                        m_slot2forms.push_back(unsigned_vector());
+                    }
+                    m_slot2forms[slot].push_back(idx);
+                }
+                if (is_app(e))
+                    todo.append(to_app(e)->get_num_args(), to_app(e)->get_args());
+                else if (is_quantifier(e))
+                    todo.push_back(to_quantifier(e)->get_expr());
+            }
+            visited.reset();
+        }
+    }
+
+    void insert_subst(expr * lhs, expr * rhs, proof * pr, expr_dependency * d) {
+        m_subst->insert(lhs, rhs, pr, d);
+        unsigned slot;
+        if (m_use_index && m_term2slot.find(lhs, slot)) 
+            for (unsigned idx : m_slot2forms[slot])
+                m_dirty[idx] = true;
+    }
+
     void push_result(expr * new_curr, proof * new_pr) {
         if (m_goal->proofs_enabled()) {
             proof * pr = m_goal->pr(m_idx);            
@@ -91,18 +145,18 @@ class propagate_values_tactic : public tactic {
         m_goal->update(m_idx, new_curr, new_pr, new_d);
 
         if (is_shared(new_curr)) {
-            m_subst->insert(new_curr, m.mk_true(), m.mk_iff_true(new_pr), new_d);
+            insert_subst(new_curr, m.mk_true(), m.mk_iff_true(new_pr), new_d);
         }
         expr * atom;
         if (is_shared_neg(new_curr, atom)) {
-            m_subst->insert(atom, m.mk_false(), m.mk_iff_false(new_pr), new_d);
+            insert_subst(atom, m.mk_false(), m.mk_iff_false(new_pr), new_d);
         }
         expr * lhs, * value;
         bool inverted = false;
         if (is_shared_eq(new_curr, lhs, value, inverted)) {
             TRACE("shallow_context_simplifier_bug", tout << "found eq:\n" << mk_ismt2_pp(new_curr, m) << "\n" << mk_ismt2_pp(new_pr, m) << "\n";);
             if (inverted && new_pr) new_pr = m.mk_symmetry(new_pr);
-            m_subst->insert(lhs, value, new_pr, new_d);
+            insert_subst(lhs, value, new_pr, new_d);
         }
     }
 
@@ -111,8 +165,15 @@ class propagate_values_tactic : public tactic {
         expr_ref   new_curr(m);
         proof_ref  new_pr(m);
         
-        if (!m_subst->empty()) {
+        if (m_use_index && m_rewritten.get(m_idx, false) && !m_dirty[m_idx]) {
+            // curr is a result of m_r and contains no term of m_subst
+            new_curr = curr;
+            ++m_num_skipped;
+        }
+        else if (!m_subst->empty()) {
             m_r(curr, new_curr, new_pr);
+            if (m_use_index)
+                m_rewritten.setx(m_idx, true, false);
         }
         else {
             new_curr = curr;
@@ -137,6 +198,7 @@ class propagate_values_tactic : public tactic {
         unsigned size  = m_goal->size();
         m_idx          = 0;
         m_modified     = false;
+        m_num_skipped  = 0;
         unsigned round = 0;
 
 
@@ -149,6 +211,9 @@ class propagate_values_tactic : public tactic {
         m_subst = alloc(expr_substitution, m, g->unsat_core_enabled(), g->proofs_enabled());
         m_r.set_substitution(m_subst.get());
         m_occs(*m_goal);
+        m_use_index = !g->proofs_enabled();
+        m_rewritten.reset();
+        build_index();
 
         while (true) {
             TRACE("propagate_values", tout << "while(true) loop\n"; m_goal->display_with_dependencies(tout););
@@ -165,6 +230,7 @@ class propagate_values_tactic : public tactic {
                 forward      = false;
                 m_subst->reset();
                 m_r.set_substitution(m_subst.get()); // reset, but keep substitution
+                build_index();
             }
             else {
                 while (m_idx > 0) {
@@ -182,6 +248,7 @@ class propagate_values_tactic : public tactic {
                 m_idx        = 0;
                 size         = m_goal->size();
                 forward      = true;
+                build_index();
             }
             round++;
             if (round >= m_max_rounds)
@@ -190,6 +257,11 @@ class propagate_values_tactic : public tactic {
             TRACE("propagate_values", tout << "round finished\n"; m_goal->display(tout); tout << "\n";);
         }
     end:
+        IF_VERBOSE(10, if (m_num_skipped > 0) verbose_stream() << "(propagate-values :skipped " << m_num_skipped << ")\n";);
+        m_term2slot.reset();
+        m_slot2forms.reset();
+        m_rewritten.reset();
+        m_dirty.reset();
         m_goal->elim_redundancies();
         m_goal->inc_depth();
         result.push_back(m_goal);
@@ -205,7 +277,9 @@ public:
         m_r(m, p),
         m_goal(nullptr),
         m_occs(m, true /* track atoms */),
-        m_params(p) {
+        m_params(p),
+        m_use_index(false),
+        m_num_skipped(0) {
         updt_params_core(p);
     }
 
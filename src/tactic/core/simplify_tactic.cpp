@@ -18,19 +18,37 @@ Notes:
 --*/
 #include "tactic/core/simplify_tactic.h"
 #include "ast/rewriter/th_rewriter.h"
+#include "ast/rewriter/rewriter_params.hpp"
 #include "ast/ast_pp.h"
 
 struct simplify_tactic::imp {
     ast_manager &   m_manager;
     th_rewriter     m_r;
+    params_ref      m_params;
     unsigned        m_num_steps;
 
     imp(ast_manager & m, params_ref const & p):
         m_manager(m),
         m_r(m, p),
+        m_params(p),
         m_num_steps(0) {
     }
 
+    void updt_params(params_ref const & p) {
+        m_params = p;
+        m_r.updt_params(p);
+    }
+
+    void parallel_simplify(goal & g, unsigned num_threads) {
+        expr_ref_vector fmls(m());
+        for (unsigned idx = 0; idx < g.size(); idx++)
+            fmls.push_back(g.form(idx));
+        rewriter_params rp(m_params);
+        m_num_steps = parallel_rewrite(m(), m_params, num_threads, rp.parallel_grain(), fmls);
+        for (unsigned idx = 0; idx < fmls.size() && !g.inconsistent(); idx++)
+            g.update(idx, fmls.get(idx), nullptr, g.dep(idx));
+    }
+
     ~imp() {
     }
 
@@ -47,6 +65,12 @@ struct simplify_tactic::imp {
         m_num_steps = 0;
         if (g.inconsistent())
             return;
+        unsigned num_threads = rewriter_params(m_params).threads();
+        if (num_threads > 1 && !g.proofs_enabled() && g.size() > 1) {
+            parallel_simplify(g, num_threads);
+            g.elim_redundancies();
+            return;
+        }
         expr_ref   new_curr(m());
         proof_ref  new_pr(m());
         unsigned size = g.size();
@@ -81,7 +105,7 @@ simplify_tactic::~simplify_tactic() {
 
 void simplify_tactic::updt_params(params_ref const & p) {
     m_params = p;
-    m_imp->m_r.updt_params(p);
+    m_imp->updt_params(p);
 }
 
 void simplify_tactic::get_param_descrs(param_descrs & r) {
@@ -53,6 +53,11 @@ class solve_eqs_tactic : public tactic {
         ptr_vector<app>               m_vars;
         expr_sparse_mark              m_nonzero;
         ptr_vector<app>               m_ordered_vars;
+        // formulas that were not solved in the previous round, 
+        // they are not analyzed again unless they are rewritten.
+        expr_ref_vector               m_unsolved;
+        obj_hashtable<expr>           m_unsolved_set;
+        bool                          m_cycle_removed;
         bool                          m_produce_proofs;
         bool                          m_produce_unsat_cores;
         bool                          m_produce_models;
@@ -64,7 +69,9 @@ class solve_eqs_tactic : public tactic {
             m_a_util(m),
             m_num_steps(0),
             m_num_eliminated_vars(0),
-            m_marked_candidates(m) {
+            m_marked_candidates(m),
+            m_unsolved(m),
+            m_cycle_removed(false) {
             updt_params(p);
             if (m_r == nullptr)
                 m_r = mk_default_expr_replacer(m, true);
@@ -418,9 +425,11 @@ class solve_eqs_tactic : public tactic {
         }
         
         /**
-           \brief Start collecting candidates
+           \brief Start collecting candidates.
+           If skip_unsolved is true, then formulas that were not solved in the previous
+           round, and were not rewritten since, are not analyzed again.
         */
-        void collect(goal const & g) {
+        void collect(goal const & g, bool skip_unsolved) {
             m_subst->reset();
             m_norm_subst->reset();
             m_r->set_substitution(nullptr);
@@ -437,15 +446,27 @@ class solve_eqs_tactic : public tactic {
             for (unsigned idx = 0; idx < size; idx++) {
                 add_pos(g.form(idx));
             }
+            expr_ref_vector unsolved(m());
             for (unsigned idx = 0; idx < size; idx++) {
                 checkpoint();
                 expr * f = g.form(idx);
+                if (skip_unsolved && m_unsolved_set.contains(f)) {
+                    unsolved.push_back(f);
+                    continue;
+                }
                 pr = nullptr;
                 if (solve(f, var, def, pr)) {
                     insert_solution(g, idx, f, var, def, pr);
                 }
+                else {
+                    unsolved.push_back(f);
+                }
                 m_num_steps++;
             }
+            m_unsolved_set.reset();
+            for (expr* f : unsolved) 
+                m_unsolved_set.insert(f);
+            m_unsolved.swap(unsolved);
             
             TRACE("solve_eqs", 
                   tout << "candidate vars:\n";
@@ -704,6 +725,7 @@ class solve_eqs_tactic : public tactic {
             SASSERT(m_candidates.size() == m_vars.size());
             TRACE("solve_eqs_bug", tout << "sorting vars...\n";);
             m_ordered_vars.reset();
+            m_cycle_removed = false;
             
 
             // The variables (and its definitions) in m_subst must remain alive until the end of this procedure.
@@ -760,6 +782,7 @@ class solve_eqs_tactic : public tactic {
                                 if (m_candidate_vars.is_marked(t)) {
                                     if (visiting.is_marked(t)) {
                                         // cycle detected: remove t
+                                        m_cycle_removed = true;
                                         visiting.reset_mark(t);
                                         m_candidate_vars.mark(t, false);
                                         SASSERT(!m_candidate_vars.is_marked(t));
@@ -992,11 +1015,12 @@ class solve_eqs_tactic : public tactic {
         }
         
         //
-        // TBD: rewrite the tactic to first apply a topological sorting that
-        // approximates the dependencies between variables. Then apply 
-        // simplification on top of this sorting, so that it can apply sub-quadratic
-        // equality and unit propagation.
-        //
+        // Each round collects the solved equations, sorts the variables topologically 
+        // (sort_vars), and applies a single substitution to the goal. 
+        // Formulas that could not be solved in a round and that are not rewritten by 
+        // the substitution are not analyzed again in the next round, unless a variable 
+        // was removed to break a cycle, or occurrences are bounded.
+        // 
         void operator()(goal_ref const & g, goal_ref_buffer & result) {
             model_converter_ref mc;
             tactic_report report("solve_eqs", *g);
@@ -1008,6 +1032,9 @@ class solve_eqs_tactic : public tactic {
             if (!g->inconsistent()) {
                 m_subst      = alloc(expr_substitution, m(), m_produce_unsat_cores, m_produce_proofs);
                 m_norm_subst = alloc(expr_substitution, m(), m_produce_unsat_cores, m_produce_proofs);
+                m_unsolved.reset();
+                m_unsolved_set.reset();
+                m_cycle_removed = false;
                 unsigned rounds = 0;
                 while (rounds < 20) {
                     ++rounds;
@@ -1015,7 +1042,7 @@ class solve_eqs_tactic : public tactic {
                         distribute_and_or(*(g.get()));
                     }
                     collect_num_occs(*g);
-                    collect(*g);
+                    collect(*g, rounds > 1 && !m_cycle_removed && m_max_occs == UINT_MAX);
                     if (!m_produce_proofs && m_context_solve && rounds < 3) {
                         collect_hoist(*g);
                     }
@@ -1036,6 +1063,8 @@ class solve_eqs_tactic : public tactic {
                     if (rounds > 10 && m_ordered_vars.size() == 1)
                         break;
                 }
+                m_unsolved.reset();
+                m_unsolved_set.reset();
             }
             g->inc_depth();
             g->add(mc.get());
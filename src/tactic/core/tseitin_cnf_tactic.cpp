@@ -19,6 +19,11 @@ Abstract:
     - Efficient encoding is used for chains of if-then-elses 
 
     - Distributivity is applied to non-shared nodes if the blowup is acceptable.
+
+    - Optionally, the polarity of subformulas is used to produce only the
+    clauses needed for equisatisfiability (Plaisted-Greenbaum encoding):
+    an auxiliary variable of a subformula that only occurs positively
+    implies the subformula, and one that only occurs negatively is implied by it.
     
     - The features above can be disabled/enabled using parameters.
 
@@ -102,8 +107,18 @@ class tseitin_cnf_tactic : public tactic {
         unsigned             m_distributivity_blowup;
         bool                 m_ite_chains;
         bool                 m_ite_extra;
+        bool                 m_polarity;
         unsigned long long   m_max_memory;
 
+        // polarity of subformulas, used when m_polarity is set.
+        expr_mark            m_pos;
+        expr_mark            m_neg;
+        // auxiliary variable of the subformula being encoded.
+        app *                m_gate;
+        app_ref              m_ngate;
+        bool                 m_gate_pos;
+        bool                 m_gate_neg;
+
         unsigned             m_num_aux_vars;
 
         imp(ast_manager & _m, params_ref const & p):
@@ -114,6 +129,10 @@ class tseitin_cnf_tactic : public tactic {
             m_clauses(_m),
             m_deps(_m),
             m_rw(_m),
+            m_gate(nullptr),
+            m_ngate(_m),
+            m_gate_pos(true),
+            m_gate_neg(true),
             m_num_aux_vars(0) {
             updt_params(p);
             m_rw.set_flat(false);
@@ -125,6 +144,7 @@ class tseitin_cnf_tactic : public tactic {
             m_distributivity_blowup = p.get_uint("distributivity_blowup", 32);
             m_ite_chains      = p.get_bool("ite_chains", true);
             m_ite_extra       = p.get_bool("ite_extra", true);
+            m_polarity        = p.get_bool("polarity", false);
             m_max_memory      = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         }
         
@@ -312,6 +332,14 @@ class tseitin_cnf_tactic : public tactic {
         }
         
         void mk_clause(unsigned num, expr * const * ls) {
+            if (m_gate) {
+                for (unsigned i = 0; i < num; ++i) {
+                    if (!m_gate_neg && ls[i] == m_gate)
+                        return; // subformula does not occur negatively
+                    if (!m_gate_pos && ls[i] == m_ngate)
+                        return; // subformula does not occur positively
+                }
+            }
             expr_ref cls(m);
             m_rw.mk_or(num, ls, cls);
             m_clauses.push_back(cls);
@@ -338,6 +366,69 @@ class tseitin_cnf_tactic : public tactic {
             mk_clause(4, ls);
         }
         
+        void reset_gate() {
+            m_gate = nullptr;
+            m_ngate = nullptr;
+        }
+
+        /**
+           \brief Register v as the auxiliary variable of t for filtering 
+           the clauses in mk_clause.
+        */
+        void set_gate(app * t, app * v) {
+            if (!m_polarity)
+                return;
+            m_gate = v;
+            m_ngate = m.mk_not(v);
+            m_gate_pos = m_pos.is_marked(t);
+            m_gate_neg = m_neg.is_marked(t);
+        }
+
+        /**
+           \brief Compute the polarities of the subformulas of the goal.
+        */
+        void collect_polarities(goal const & g) {
+            m_pos.reset();
+            m_neg.reset();
+            if (!m_polarity)
+                return;
+            svector<std::pair<expr*, bool>> todo;
+            for (unsigned i = 0; i < g.size(); ++i) 
+                todo.push_back(std::make_pair(g.form(i), true));
+            while (!todo.empty()) {
+                expr * e = todo.back().first;
+                bool pos = todo.back().second;
+                todo.pop_back();
+                expr_mark & mark = pos ? m_pos : m_neg;
+                if (mark.is_marked(e))
+                    continue;
+                mark.mark(e, true);
+                if (!is_app(e) || to_app(e)->get_family_id() != m.get_basic_family_id())
+                    continue;
+                app * a = to_app(e);
+                expr * x, * y;
+                if (m.is_not(a, x)) {
+                    todo.push_back(std::make_pair(x, !pos));
+                }
+                else if (m.is_or(a) || m.is_and(a)) {
+                    for (expr * arg : *a)
+                        todo.push_back(std::make_pair(arg, pos));
+                }
+                else if (m.is_ite(a) && m.is_bool(a)) {
+                    todo.push_back(std::make_pair(a->get_arg(0), true));
+                    todo.push_back(std::make_pair(a->get_arg(0), false));
+                    todo.push_back(std::make_pair(a->get_arg(1), pos));
+                    todo.push_back(std::make_pair(a->get_arg(2), pos));
+                }
+                else if (is_iff(m, a, x, y) || m.is_xor(a, x, y)) {
+                    todo.push_back(std::make_pair(x, true));
+                    todo.push_back(std::make_pair(x, false));
+                    todo.push_back(std::make_pair(y, true));
+                    todo.push_back(std::make_pair(y, false));
+                }
+            }
+        }
+
         app * mk_fresh() {
             m_num_aux_vars++;
             app * v = m.mk_fresh_const(nullptr, m.mk_bool_sort());
@@ -403,6 +494,7 @@ class tseitin_cnf_tactic : public tactic {
                 else {
                     app_ref k(m), nk(m);
                     k  = mk_fresh();
+                    set_gate(t, k);
                     nk = m.mk_not(k);
                     mk_clause(nk, nla, nlb);
                     mk_clause(nk, nla, nlc);
@@ -451,6 +543,7 @@ class tseitin_cnf_tactic : public tactic {
                 else {
                     app_ref k(m), nk(m);
                     k  = mk_fresh();
+                    set_gate(t, k);
                     nk = m.mk_not(k);
                     mk_clause(nk, la,   lb,  lc);
                     mk_clause(nk, la,  nlb, nlc);
@@ -522,6 +615,7 @@ class tseitin_cnf_tactic : public tactic {
                 else {
                     app_ref k(m), nk(m);
                     k  = mk_fresh();
+                    set_gate(t, k);
                     nk = m.mk_not(k);
                     
                     mk_clause(nk, la,  nlb);
@@ -569,6 +663,7 @@ class tseitin_cnf_tactic : public tactic {
             app_ref k(m), nk(m);
             if (!root) {
                 k = mk_fresh();
+                set_gate(t, k);
                 nk = m.mk_not(k);
                 cache_result(t, k);
             }
@@ -681,6 +776,7 @@ class tseitin_cnf_tactic : public tactic {
             app_ref k(m), nk(m);
             if (!root) {
                 k = mk_fresh();
+                set_gate(t, k);
                 nk = m.mk_not(k);
                 cache_result(t, k);
             }
@@ -780,6 +876,7 @@ class tseitin_cnf_tactic : public tactic {
         }
         
 #define TRY(_MATCHER_)                                          \
+    reset_gate();                                               \
     r = _MATCHER_(t, first, t == root);                         \
     if (r == CONT) goto loop;                                   \
     if (r == DONE) { m_frame_stack.pop_back(); continue; }
@@ -793,6 +890,7 @@ class tseitin_cnf_tactic : public tactic {
 
         void process(expr * n, expr_dependency * dep) {
             m_curr_dep = dep;
+            reset_gate();
             bool visited = true;
             visit(n, visited, true);
             if (visited) {
@@ -837,6 +935,7 @@ class tseitin_cnf_tactic : public tactic {
             TRACE("tseitin_cnf", g->display(tout););
 
             m_occs(*g);
+            collect_polarities(*g);
             reset_cache();
             m_deps.reset();
             m_fresh_vars.reset();
@@ -870,6 +969,9 @@ class tseitin_cnf_tactic : public tactic {
             }
             if (m_produce_models && !m_fresh_vars.empty()) 
                 g->add(m_mc.get());
+            reset_gate();
+            m_pos.reset();
+            m_neg.reset();
             g->inc_depth();
             result.push_back(g.get());
         }
@@ -903,6 +1005,7 @@ public:
         r.insert("distributivity_blowup", CPK_UINT, "(default: 32) maximum overhead for applying distributivity during CNF encoding");
         r.insert("ite_chaing", CPK_BOOL, "(default: true) minimize the number of auxiliary variables during CNF encoding by identifing if-then-else chains");                                                       
         r.insert("ite_extra", CPK_BOOL, "(default: true) add redundant clauses (that improve unit propagation) when encoding if-then-else formulas");
+        r.insert("polarity", CPK_BOOL, "(default: false) use the polarity of subformulas to produce only the clauses needed for equisatisfiability (Plaisted-Greenbaum encoding)");
     }
     
     void operator()(goal_ref const & in, goal_ref_buffer & result) override {
@@ -387,12 +387,19 @@ namespace smtfd {
         th_rewriter     m_rewriter;
         ptr_vector<theory_plugin> m_plugins;
         model_ref       m_model;
+        obj_map<expr, expr*> m_eval_cache;     // values of abstractions of terms in m_model
+        expr_ref_vector m_eval_trail;
+        unsigned        m_num_eval_hits;
+
+        void reset_eval_cache() { m_eval_cache.reset(); m_eval_trail.reset(); }
     public:
         plugin_context(smtfd_abs& a, ast_manager& m):
             m(m),
             m_abs(a),
             m_lemmas(m), 
-            m_rewriter(m)
+            m_rewriter(m),
+            m_eval_trail(m),
+            m_num_eval_hits(0)
         {
         }
 
@@ -412,6 +419,15 @@ namespace smtfd {
 
         model& get_model() { return *m_model; }
 
+        /**
+         * \brief value of the abstraction of t in the current model.
+         * Values are cached until the model is reset, so terms that are 
+         * shared by plugins and rounds are evaluated once per model.
+         */
+        expr_ref eval_abs(expr* t);
+
+        unsigned num_eval_hits() const { return m_num_eval_hits; }
+
         expr_ref_vector::iterator begin() { return m_lemmas.begin(); }
         expr_ref_vector::iterator end() { return m_lemmas.end(); }
         unsigned size() const { return m_lemmas.size(); }
@@ -524,8 +540,8 @@ namespace smtfd {
 
         ast_manager& get_manager() { return m; }
 
-        expr_ref eval_abs(expr* t) { return m_context.get_model()(m_abs.abs(t)); }
-        bool is_true_abs(expr* t) { return m_context.get_model().is_true(m_abs.abs(t)); }
+        expr_ref eval_abs(expr* t) { return m_context.eval_abs(t); }
+        bool is_true_abs(expr* t) { return m.is_true(m_context.eval_abs(t)); }
         
         expr* value_of(f_app const& f) const { return m_values[f.m_val_offset + f.m_t->get_num_args()]; }
 
@@ -649,8 +665,22 @@ namespace smtfd {
         return r;
     }
 
+    expr_ref plugin_context::eval_abs(expr* t) {
+        expr* v = nullptr;
+        if (m_eval_cache.find(t, v)) {
+            ++m_num_eval_hits;
+            return expr_ref(v, m);
+        }
+        expr_ref r = (*m_model)(m_abs.abs(t));
+        m_eval_trail.push_back(t);
+        m_eval_trail.push_back(r);
+        m_eval_cache.insert(t, r);
+        return r;
+    }
+
     void plugin_context::reset(model_ref& mdl) {
         m_lemmas.reset();
+        reset_eval_cache();
         m_model = mdl;
         for (theory_plugin* p : m_plugins) {
             p->reset();
@@ -679,6 +709,7 @@ namespace smtfd {
     }
 
     void plugin_context::populate_model(model_ref& mdl, expr_ref_vector const& terms) {
+        reset_eval_cache();
         for (theory_plugin* p : m_plugins) {
             p->populate_model(mdl, terms);
         }
@@ -2057,6 +2088,7 @@ namespace smtfd {
             st.update("smtfd-num-rounds", m_stats.m_num_rounds);
             st.update("smtfd-num-mbqi",   m_stats.m_num_mbqi);
             st.update("smtfd-num-fresh-bool", m_stats.m_num_fresh_bool);
+            st.update("smtfd-num-eval-hits", m_context.num_eval_hits());
         }
         void get_unsat_core(expr_ref_vector & r) override { 
             m_fd_sat_solver->get_unsat_core(r);
@@ -287,6 +287,11 @@ void goal::get_formulas(expr_ref_vector & result) const {
 void goal::update(unsigned i, expr * f, proof * pr, expr_dependency * d) {
     if (m_inconsistent)
         return;
+    if (f == form(i) && pr == this->pr(i) && d == dep(i)) {
+        // nothing changes: avoid creating a new version of the arrays
+        // (they may be shared with copies of this goal).
+        return;
+    }
     if (pr) {
         SASSERT(f == m().get_fact(pr));
         expr_ref out_f(m());
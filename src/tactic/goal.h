@@ -124,6 +124,8 @@ public:
     proof * pr(unsigned i) const { return m().size(m_proofs) > i ? static_cast<proof*>(m().get(m_proofs, i)) : nullptr; }
     expr_dependency * dep(unsigned i) const { return unsat_core_enabled() ? m().get(m_dependencies, i) : nullptr; }
 
+    // Updating a formula with itself, with the same proof and dependency, does not change the goal.
+    // In particular, it does not create a new version of arrays shared with copies of the goal.
     void update(unsigned i, expr * f, proof * pr = nullptr, expr_dependency * dep = nullptr);
 
     void get_formulas(ptr_vector<expr> & result) const;
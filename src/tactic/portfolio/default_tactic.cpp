@@ -32,8 +32,13 @@ Notes:
 #include "tactic/smtlogics/qfaufbv_tactic.h"
 #include "tactic/smtlogics/qfauflia_tactic.h"
 #include "tactic/fd_solver/fd_solver.h"
+#include "tactic/portfolio/strategy_selector_tactic.h"
+#include "tactic/tactic_params.hpp"
 
 tactic * mk_default_tactic(ast_manager & m, params_ref const & p) {
+    tactic_params tp(p);
+    if (tp.strategy_selector())
+        return mk_strategy_selector_tactic(m, p);
     tactic * st = using_params(and_then(mk_simplify_tactic(m),
                                         cond(mk_and(mk_is_propositional_probe(), mk_not(mk_produce_proofs_probe())), mk_fd_tactic(m, p),
                                         cond(mk_is_qfbv_probe(), mk_qfbv_tactic(m),
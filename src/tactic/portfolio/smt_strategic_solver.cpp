@@ -18,7 +18,9 @@ Notes:
 
 --*/
 #include "cmd_context/cmd_context.h"
+#include "solver/cached_solver.h"
 #include "solver/combined_solver.h"
+#include "solver/solver_params.hpp"
 #include "solver/tactic2solver.h"
 #include "tactic/smtlogics/qfbv_tactic.h"
 #include "tactic/smtlogics/qflia_tactic.h"
@@ -123,6 +125,11 @@ static solver* mk_solver_for_logic(ast_manager & m, params_ref const & p, symbol
     return s;
 }
 
+static solver* mk_cached_solver_if_enabled(solver* s, params_ref const& p) {
+    solver_params sp(p);
+    return sp.cache() ? mk_cached_solver(s, p) : s;
+}
+
 class smt_strategic_solver_factory : public solver_factory {
     symbol m_logic;
 public:
@@ -153,14 +160,15 @@ public:
 
         if (!t) {
             solver* s = mk_special_solver_for_logic(m, p, l);
-            if (s) return s;
+            if (s) return mk_cached_solver_if_enabled(s, p);
         }
         if (!t) {
             t = mk_tactic_for_logic(m, p, l);
         }
-        return mk_combined_solver(mk_tactic2solver(m, t.get(), p, proofs_enabled, models_enabled, unsat_core_enabled, l),
-                                  mk_solver_for_logic(m, p, l), 
-                                  p);
+        solver* s = mk_combined_solver(mk_tactic2solver(m, t.get(), p, proofs_enabled, models_enabled, unsat_core_enabled, l),
+                                       mk_solver_for_logic(m, p, l), 
+                                       p);
+        return mk_cached_solver_if_enabled(s, p);
     }
 };
 
@@ -0,0 +1,327 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    strategy_selector_tactic.cpp
+
+Abstract:
+
+    Tactic that selects a portfolio of tactics from features of the goal.
+
+--*/
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include "ast/static_features.h"
+#include "tactic/tactical.h"
+#include "tactic/probe.h"
+#include "tactic/tactic_params.hpp"
+#include "tactic/arith/probe_arith.h"
+#include "tactic/portfolio/default_tactic.h"
+#include "tactic/portfolio/strategy_selector_tactic.h"
+#include "tactic/smtlogics/qfbv_tactic.h"
+#include "tactic/smtlogics/qfaufbv_tactic.h"
+#include "tactic/smtlogics/qflia_tactic.h"
+#include "tactic/smtlogics/qfauflia_tactic.h"
+#include "tactic/smtlogics/qflra_tactic.h"
+#include "tactic/smtlogics/qfnia_tactic.h"
+#include "tactic/smtlogics/qfnra_tactic.h"
+#include "tactic/smtlogics/nra_tactic.h"
+#include "tactic/smtlogics/quant_tactics.h"
+#include "tactic/fpa/qffp_tactic.h"
+#include "tactic/fd_solver/fd_solver.h"
+#include "smt/tactic/smt_tactic.h"
+
+class strategy_selector_tactic : public tactic {
+
+    enum portfolio_kind {
+        PF_DEFAULT,
+        PF_SMT,
+        PF_FD,
+        PF_QFBV,
+        PF_QFAUFBV,
+        PF_QFLIA,
+        PF_QFAUFLIA,
+        PF_QFLRA,
+        PF_QFNIA,
+        PF_QFNRA,
+        PF_LIRA,
+        PF_NRA,
+        PF_QFFP,
+        PF_NUM_PORTFOLIOS
+    };
+
+    static char const * portfolio_name(unsigned i) {
+        static char const * names[PF_NUM_PORTFOLIOS] = {
+            "default", "smt", "fd", "qfbv", "qfaufbv", "qflia", "qfauflia", "qflra", "qfnia", "qfnra", "lira", "nra", "qffp"
+        };
+        return names[i];
+    }
+
+    ast_manager &       m;
+    params_ref          m_params;
+    bool                m_model_loaded;
+    bool                m_has_model;
+    vector<svector<double>> m_weights;       // portfolio -> feature -> weight
+    svector<symbol>     m_feature_names;
+    svector<double>     m_features;
+    tactic_ref          m_tactic;            // tactic used for the last goal
+
+    void add_feature(char const * name, double value) {
+        if (m_feature_names.size() == m_features.size())
+            m_feature_names.push_back(symbol(name));
+        m_features.push_back(value);
+    }
+
+    void add_count(char const * name, unsigned n) {
+        add_feature(name, std::log2(1.0 + n));
+    }
+
+    void add_probe(char const * name, probe * p, goal const & g) {
+        probe_ref _p(p);
+        add_feature(name, (*p)(g).get_value());
+    }
+
+    void collect_features(goal const & g) {
+        m_features.reset();
+        static_features sf(m);
+        ptr_vector<expr> fmls;
+        g.get_formulas(fmls);
+        sf.collect(fmls.size(), fmls.c_ptr());
+        add_feature("bias", 1.0);
+        add_count("exprs", sf.m_num_exprs);
+        add_count("roots", sf.m_num_roots);
+        add_count("depth", sf.m_max_depth);
+        add_count("quantifiers", sf.m_num_quantifiers);
+        add_count("clauses", sf.m_num_clauses);
+        add_count("bin_clauses", sf.m_num_bin_clauses);
+        add_count("bool_constants", sf.m_num_bool_constants);
+        add_count("ite_terms", sf.m_num_ite_terms);
+        add_count("uninterpreted_constants", sf.m_num_uninterpreted_constants);
+        add_count("uninterpreted_functions", sf.m_num_uninterpreted_functions);
+        add_count("eqs", sf.m_num_eqs);
+        add_count("arith_terms", sf.m_num_arith_terms);
+        add_count("arith_eqs", sf.m_num_arith_eqs);
+        add_count("arith_ineqs", sf.m_num_arith_ineqs);
+        add_count("diff_terms", sf.m_num_diff_terms);
+        add_count("non_linear", sf.m_num_non_linear);
+        add_count("aliens", sf.m_num_aliens);
+        add_count("theories", sf.m_num_theories);
+        add_feature("cnf", sf.m_cnf);
+        add_feature("has_int", sf.m_has_int);
+        add_feature("has_real", sf.m_has_real);
+        add_feature("has_bv", sf.m_has_bv);
+        add_feature("has_fpa", sf.m_has_fpa);
+        add_feature("has_arrays", sf.m_has_arrays);
+        add_feature("has_str", sf.m_has_str);
+        add_probe("arith_max_degree", mk_arith_max_degree_probe(), g);
+        add_probe("arith_avg_bw", mk_arith_avg_bw_probe(), g);
+        add_probe("is_propositional", mk_is_propositional_probe(), g);
+        add_probe("is_qfbv", mk_is_qfbv_probe(), g);
+        add_probe("is_qfaufbv", mk_is_qfaufbv_probe(), g);
+        add_probe("is_qflia", mk_is_qflia_probe(), g);
+        add_probe("is_qfauflia", mk_is_qfauflia_probe(), g);
+        add_probe("is_qflra", mk_is_qflra_probe(), g);
+        add_probe("is_qfnia", mk_is_qfnia_probe(), g);
+        add_probe("is_qfnra", mk_is_qfnra_probe(), g);
+        add_probe("is_lira", mk_is_lira_probe(), g);
+        add_probe("is_nra", mk_is_nra_probe(), g);
+        add_probe("is_qffp", mk_is_qffp_probe(), g);
+        SASSERT(m_features.size() == m_feature_names.size());
+    }
+
+    double feature(char const * name) const {
+        symbol s(name);
+        for (unsigned i = 0; i < m_features.size(); ++i)
+            if (m_feature_names[i] == s)
+                return m_features[i];
+        UNREACHABLE();
+        return 0;
+    }
+
+    bool is_applicable(unsigned i, goal const & g) const {
+        switch (i) {
+        case PF_DEFAULT:  return true;
+        case PF_SMT:      return true;
+        case PF_FD:       return feature("is_propositional") != 0 && !g.proofs_enabled();
+        case PF_QFBV:     return feature("is_qfbv") != 0;
+        case PF_QFAUFBV:  return feature("is_qfaufbv") != 0;
+        case PF_QFLIA:    return feature("is_qflia") != 0;
+        case PF_QFAUFLIA: return feature("is_qfauflia") != 0;
+        case PF_QFLRA:    return feature("is_qflra") != 0;
+        case PF_QFNIA:    return feature("is_qfnia") != 0;
+        case PF_QFNRA:    return feature("is_qfnra") != 0;
+        case PF_LIRA:     return feature("is_lira") != 0;
+        case PF_NRA:      return feature("is_nra") != 0;
+        case PF_QFFP:     return feature("is_qffp") != 0;
+        default:          UNREACHABLE(); return false;
+        }
+    }
+
+    tactic * mk_portfolio(unsigned i) {
+        params_ref const & p = m_params;
+        switch (i) {
+        case PF_DEFAULT: {
+            params_ref q(p);
+            q.set_bool("strategy_selector", false);
+            return mk_default_tactic(m, q);
+        }
+        case PF_SMT:      return and_then(mk_preamble_tactic(m), mk_smt_tactic(m, p));
+        case PF_FD:       return mk_fd_tactic(m, p);
+        case PF_QFBV:     return mk_qfbv_tactic(m, p);
+        case PF_QFAUFBV:  return mk_qfaufbv_tactic(m, p);
+        case PF_QFLIA:    return mk_qflia_tactic(m, p);
+        case PF_QFAUFLIA: return mk_qfauflia_tactic(m, p);
+        case PF_QFLRA:    return mk_qflra_tactic(m, p);
+        case PF_QFNIA:    return mk_qfnia_tactic(m, p);
+        case PF_QFNRA:    return mk_qfnra_tactic(m, p);
+        case PF_LIRA:     return mk_lira_tactic(m, p);
+        case PF_NRA:      return mk_nra_tactic(m, p);
+        case PF_QFFP:     return mk_qffp_tactic(m, p);
+        default:          UNREACHABLE(); return nullptr;
+        }
+    }
+
+    unsigned find_portfolio(symbol const & name) const {
+        for (unsigned i = 0; i < PF_NUM_PORTFOLIOS; ++i)
+            if (name == portfolio_name(i))
+                return i;
+        return UINT_MAX;
+    }
+
+    unsigned find_feature(symbol const & name) const {
+        for (unsigned i = 0; i < m_feature_names.size(); ++i)
+            if (m_feature_names[i] == name)
+                return i;
+        return UINT_MAX;
+    }
+
+    /**
+       \brief load the weights of the model. The feature names are known after
+       the features of the first goal are collected.
+    */
+    void load_model() {
+        m_model_loaded = true;
+        m_has_model = false;
+        tactic_params tp(m_params);
+        symbol file_name = tp.strategy_selector_model();
+        if (file_name == symbol::null || !file_name.bare_str() || !file_name.bare_str()[0])
+            return;
+        std::ifstream in(file_name.bare_str());
+        if (!in) {
+            IF_VERBOSE(1, verbose_stream() << "(strategy-selector :error \"could not open " << file_name << "\")\n";);
+            return;
+        }
+        m_weights.reset();
+        m_weights.resize(PF_NUM_PORTFOLIOS);
+        for (auto & w : m_weights)
+            w.resize(m_feature_names.size(), 0.0);
+        std::string line;
+        unsigned line_no = 0;
+        while (std::getline(in, line)) {
+            ++line_no;
+            std::istringstream is(line);
+            std::string pf, f;
+            double w;
+            if (!(is >> pf) || pf[0] == ';' || pf[0] == '#')
+                continue;
+            if (!(is >> f >> w)) {
+                IF_VERBOSE(1, verbose_stream() << "(strategy-selector :error \"" << file_name << ":" << line_no << ": expected <portfolio> <feature> <weight>\")\n";);
+                return;
+            }
+            unsigned i = find_portfolio(symbol(pf.c_str()));
+            unsigned j = find_feature(symbol(f.c_str()));
+            if (i == UINT_MAX || j == UINT_MAX) {
+                IF_VERBOSE(1, verbose_stream() << "(strategy-selector :warning \"" << file_name << ":" << line_no << ": unknown portfolio or feature\")\n";);
+                continue;
+            }
+            m_weights[i][j] = w;
+        }
+        m_has_model = true;
+    }
+
+    tactic * mk_model_tactic(goal const & g) {
+        unsigned best = PF_DEFAULT;
+        double best_score = 0;
+        for (unsigned i = 0; i < PF_NUM_PORTFOLIOS; ++i) {
+            if (!is_applicable(i, g))
+                continue;
+            double score = 0;
+            for (unsigned j = 0; j < m_features.size(); ++j)
+                score += m_weights[i][j] * m_features[j];
+            if (i == PF_DEFAULT || score > best_score) {
+                best = i;
+                best_score = score;
+            }
+        }
+        IF_VERBOSE(2, verbose_stream() << "(strategy-selector :portfolio " << portfolio_name(best) << " :score " << best_score << ")\n";);
+        if (best == PF_DEFAULT)
+            return mk_portfolio(PF_DEFAULT);
+        return or_else(mk_portfolio(best), mk_portfolio(PF_DEFAULT));
+    }
+
+    /**
+       \brief run every applicable portfolio for a time slice, the default tactic is last and has no limit.
+    */
+    tactic * mk_time_slice_tactic(goal const & g) {
+        tactic_params tp(m_params);
+        unsigned slice = tp.strategy_selector_slice();
+        tactic_ref_vector ts;
+        for (unsigned i = 0; i < PF_NUM_PORTFOLIOS; ++i)
+            if (i != PF_DEFAULT && is_applicable(i, g))
+                ts.push_back(try_for(mk_portfolio(i), slice));
+        ts.push_back(mk_portfolio(PF_DEFAULT));
+        if (ts.size() == 1)
+            return ts.get(0);
+        return or_else(ts.size(), ts.c_ptr());
+    }
+
+public:
+    strategy_selector_tactic(ast_manager & m, params_ref const & p):
+        m(m),
+        m_params(p),
+        m_model_loaded(false),
+        m_has_model(false) {
+    }
+
+    tactic * translate(ast_manager & m) override {
+        return alloc(strategy_selector_tactic, m, m_params);
+    }
+
+    void updt_params(params_ref const & p) override {
+        m_params = p;
+        m_model_loaded = false;
+    }
+
+    void collect_param_descrs(param_descrs & r) override {}
+
+    void operator()(goal_ref const & g, goal_ref_buffer & result) override {
+        tactic_report report("strategy-selector", *g);
+        collect_features(*g);
+        if (!m_model_loaded)
+            load_model();
+        m_tactic = m_has_model ? mk_model_tactic(*g) : mk_time_slice_tactic(*g);
+        m_tactic->updt_params(m_params);
+        (*m_tactic)(g, result);
+    }
+
+    void collect_statistics(statistics & st) const override {
+        if (m_tactic)
+            m_tactic->collect_statistics(st);
+    }
+
+    void reset_statistics() override {
+        if (m_tactic)
+            m_tactic->reset_statistics();
+    }
+
+    void cleanup() override {
+        if (m_tactic)
+            m_tactic->cleanup();
+    }
+};
+
+tactic * mk_strategy_selector_tactic(ast_manager & m, params_ref const & p) {
+    return clean(alloc(strategy_selector_tactic, m, p));
+}
@@ -0,0 +1,36 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    strategy_selector_tactic.h
+
+Abstract:
+
+    Tactic that selects a portfolio of tactics from features of the goal.
+
+    The features are computed by static_features and by the logic probes.
+    The selection is based on a linear model trained offline, which is
+    loaded from the file given by tactic.strategy_selector.model. The file
+    has lines of the form
+
+        <portfolio> <feature> <weight>
+
+    and the score of a portfolio is the sum of its weights times the
+    values of the features. The applicable portfolio with the largest
+    score is used. Without a model, the applicable portfolios are run in
+    time slices of tactic.strategy_selector.slice milliseconds before the
+    default tactic is run without a time limit.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+class ast_manager;
+class tactic;
+
+tactic * mk_strategy_selector_tactic(ast_manager & m, params_ref const & p = params_ref());
+
+/*
+ADD_TACTIC("strategy-selector", "select a portfolio of tactics using features of the goal.", "mk_strategy_selector_tactic(m, p)")
+*/
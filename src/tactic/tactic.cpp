@@ -51,6 +51,7 @@ struct tactic_report::imp {
                    << " :time " << std::fixed << std::setprecision(2) << m_watch.get_seconds()
                    << " :before-memory " << std::fixed << std::setprecision(2) << m_start_memory
                    << " :after-memory " << std::fixed << std::setprecision(2) << end_memory
+                   << " :max-memory " << std::fixed << std::setprecision(2) << static_cast<double>(memory::get_max_used_memory())/static_cast<double>(1024*1024)
                    << ")" << std::endl);
         SASSERT(m_goal.is_well_formed());
     }
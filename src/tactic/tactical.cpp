@@ -19,7 +19,12 @@ Notes:
 #include "util/scoped_timer.h"
 #include "util/cancel_eh.h"
 #include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
+#include "util/union_find.h"
+#include "util/event_trace.h"
+#include "util/stopwatch.h"
 #include "tactic/tactical.h"
+#include "tactic/tactic_params.hpp"
 #ifndef SINGLE_THREAD
 #include <thread>
 #endif
@@ -113,6 +118,8 @@ public:
         m_t1->operator()(in, r1);
         unsigned r1_size = r1.size();                                                                       
         SASSERT(r1_size > 0);  
+        if (memory::above_high_watermark())
+            memory::shrink_caches();
         if (r1_size == 1) {                                                                                 
             if (r1[0]->is_decided()) {
                 result.push_back(r1[0]);
@@ -363,6 +370,12 @@ tactic * or_else(tactic * t1, tactic * t2, tactic * t3, tactic * t4, tactic * t5
     return or_else(10, ts);
 }
 
+enum par_exception_kind {
+    TACTIC_EX,
+    DEFAULT_EX,
+    ERROR_EX
+};
+
 #ifdef SINGLE_THREAD
 
 tactic * par(unsigned num, tactic * const * ts) {
@@ -371,25 +384,91 @@ tactic * par(unsigned num, tactic * const * ts) {
 
 #else
 
-enum par_exception_kind {
-    TACTIC_EX,
-    DEFAULT_EX,
-    ERROR_EX
-};
-
 class par_tactical : public or_else_tactical {
 
 	std::string        ex_msg;
 	unsigned           error_code;
 
+    /**
+       \brief decided results of previous goals, used when tactic.par_cache is set.
+       Goals with proofs or unsat cores are not cached.
+    */
+    struct cache_entry {
+        goal_ref        m_in;      // the goal
+        goal_ref        m_out;     // the goal after the winning tactic was applied to it
+        goal_ref        m_result;  // the decided subgoal
+    };
+    bool               m_use_cache;
+    vector<cache_entry> m_cache;
+    unsigned           m_cache_head;
+    static const unsigned max_cache_size = 16;
+
+    static bool same_goal(goal const & g1, goal const & g2) {
+        if (&g1.m() != &g2.m() || g1.size() != g2.size() || g1.inconsistent() != g2.inconsistent() ||
+            g1.models_enabled() != g2.models_enabled())
+            return false;
+        for (unsigned i = 0; i < g1.size(); ++i)
+            if (g1.form(i) != g2.form(i))
+                return false;
+        return true;
+    }
+
+    bool find_cache(goal_ref const & in, goal_ref_buffer & result) {
+        if (!m_use_cache)
+            return false;
+        for (cache_entry const & e : m_cache) {
+            if (same_goal(*e.m_in, *in)) {
+                result.push_back(alloc(goal, *e.m_result));
+                in->copy_from(*e.m_out);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void save_cache(goal const & in, goal const & out, goal_ref_buffer const & result) {
+        if (!m_use_cache || in.proofs_enabled() || in.unsat_core_enabled() || !is_decided(result))
+            return;
+        cache_entry e;
+        e.m_in = alloc(goal, in);
+        e.m_out = alloc(goal, out);
+        e.m_result = alloc(goal, *result[0]);
+        if (m_cache.size() < max_cache_size)
+            m_cache.push_back(e);
+        else {
+            m_cache[m_cache_head] = e;
+            m_cache_head = (m_cache_head + 1) % max_cache_size;
+        }
+    }
+
 public:
     par_tactical(unsigned num, tactic * const * ts):or_else_tactical(num, ts) {
 		error_code = 0;
+        m_use_cache = false;
+        m_cache_head = 0;
 	}
     ~par_tactical() override {}
 
-    
+    void updt_params(params_ref const & p) override {
+        tactic_params tp(p);
+        m_use_cache = tp.par_cache();
+        if (!m_use_cache)
+            m_cache.reset();
+        or_else_tactical::updt_params(p);
+    }
 
+    void cleanup() override {
+        m_cache.reset();
+        m_cache_head = 0;
+        or_else_tactical::cleanup();
+    }
+
+    /**
+       The first tactic runs on the goal in the manager of the goal, the other tactics
+       run on translated goals in their own managers. The tactic that finishes first
+       cancels the others through their resource limits, and its result is translated
+       back after all threads are joined.
+    */
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
         bool use_seq;
         use_seq = false;
@@ -404,12 +483,19 @@ public:
         if (m.has_trace_stream())
             throw default_exception("threads and trace are incompatible");
 
+        if (find_cache(in, result))
+            return;
+
+        goal_ref in0(alloc(goal, *in));
         scoped_ptr_vector<ast_manager> managers;
         scoped_limits scl(m.limit());
         goal_ref_vector                in_copies;
         tactic_ref_vector              ts;
         unsigned sz = m_ts.size();
-        for (unsigned i = 0; i < sz; i++) {
+        managers.push_back(nullptr);
+        in_copies.push_back(in.get());
+        ts.push_back(m_ts.get(0));
+        for (unsigned i = 1; i < sz; i++) {
             ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
             managers.push_back(new_m);
             ast_translation translator(m, *new_m);
@@ -420,16 +506,18 @@ public:
 
         unsigned finished_id       = UINT_MAX;
         par_exception_kind ex_kind = DEFAULT_EX;
+        bool cancel_main           = false;
+        vector<goal_ref_buffer> results;
+        results.resize(sz);
 
         std::mutex         mux;
 
         auto worker_thread = [&](unsigned i) {
-            goal_ref_buffer     _result;                        
             goal_ref in_copy = in_copies[i];
             tactic & t = *(ts.get(i));
             
             try {
-                t(in_copy, _result);
+                t(in_copy, results[i]);
                 bool first = false;
                 {
                     std::lock_guard<std::mutex> lock(mux);
@@ -439,18 +527,16 @@ public:
                     }
                 }                
                 if (first) {
-                    for (unsigned j = 0; j < sz; j++) {
+                    for (unsigned j = 1; j < sz; j++) {
                         if (i != j) {
                             managers[j]->limit().cancel();
                         }
                     }
-                    
-                    ast_translation translator(*(managers[i]), m, false);
-                    for (goal* g : _result) {
-                        result.push_back(g->translate(translator));
+                    if (i != 0) {
+                        // the first tactic runs in m, it is cancelled until the threads are joined.
+                        cancel_main = true;
+                        m.limit().inc_cancel();
                     }
-                    goal_ref in2(in_copy->translate(translator));
-                    in->copy_from(*(in2.get()));
                 }
             }
             catch (tactic_exception & ex) {
@@ -473,14 +559,10 @@ public:
             }
         };
 
-        vector<std::thread> threads(sz);
+        thread_pool::run(sz, worker_thread);
 
-        for (unsigned i = 0; i < sz; ++i) {
-            threads[i] = std::thread([&, i]() { worker_thread(i); });
-        }
-        for (unsigned i = 0; i < sz; ++i) {
-            threads[i].join();
-        }
+        if (cancel_main)
+            m.limit().dec_cancel();
         
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
@@ -490,6 +572,19 @@ public:
                 throw default_exception(std::move(ex_msg));
             }
         }
+
+        if (finished_id == 0) {
+            result.append(results[0]);
+        }
+        else {
+            ast_translation translator(*(managers[finished_id]), m, false);
+            for (goal* g : results[finished_id]) {
+                result.push_back(g->translate(translator));
+            }
+            goal_ref in2(in_copies[finished_id]->translate(translator));
+            in->copy_from(*(in2.get()));
+        }
+        save_cache(*in0, *in, result);
     }    
 
     tactic * translate(ast_manager & m) override { return translate_core<par_tactical>(m); }
@@ -686,13 +781,7 @@ public:
             if (m.has_trace_stream())
                 throw default_exception("threads and trace are incompatible");
 
-            vector<std::thread> threads(r1_size);
-            for (unsigned i = 0; i < r1_size; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
-            for (unsigned i = 0; i < r1_size; ++i) {
-                threads[i].join();
-            }
+            thread_pool::run(r1_size, worker_thread);
             
             if (failed) {
                 switch (ex_kind) {
@@ -929,6 +1018,211 @@ tactic * fail_if_branching(tactic * t, unsigned threshold) {
     return alloc(fail_if_branching_tactical, t, threshold);
 }
 
+/**
+   \brief Split the goal into groups of formulas that share no
+   uninterpreted constant or function, apply \c m_t to the groups in
+   parallel, and conjoin the results.
+
+   Each group is processed in its own ast_manager. The combinator falls
+   back to applying \c m_t to the whole goal when proofs or unsat cores
+   are enabled, when the goal has a single group, or when \c m_t splits
+   some group into several subgoals.
+*/
+class par_components_tactical : public unary_tactical {
+
+    /**
+       \brief Partition the formulas of g into connected components.
+       Formulas are connected if they share a subterm or an uninterpreted
+       symbol. The result contains the formula indices of each component.
+    */
+    void mk_components(goal const & g, vector<unsigned_vector> & components) {
+        unsigned sz = g.size();
+        basic_union_find uf;
+        for (unsigned i = 0; i < sz; i++)
+            uf.mk_var();
+        obj_map<expr, unsigned> owner;
+        obj_map<func_decl, unsigned> decl_owner;
+        ptr_vector<expr> todo;
+        for (unsigned i = 0; i < sz; i++) {
+            todo.push_back(g.form(i));
+            while (!todo.empty()) {
+                expr * e = todo.back();
+                todo.pop_back();
+                unsigned j;
+                if (owner.find(e, j)) {
+                    uf.merge(i, j);
+                    continue;
+                }
+                owner.insert(e, i);
+                if (is_app(e)) {
+                    app * a = to_app(e);
+                    func_decl * f = a->get_decl();
+                    if (f->get_family_id() == null_family_id) {
+                        if (decl_owner.find(f, j))
+                            uf.merge(i, j);
+                        else
+                            decl_owner.insert(f, i);
+                    }
+                    for (expr * arg : *a)
+                        todo.push_back(arg);
+                }
+                else if (is_quantifier(e)) {
+                    todo.push_back(to_quantifier(e)->get_expr());
+                }
+            }
+        }
+        unsigned_vector root2comp(sz, UINT_MAX);
+        for (unsigned i = 0; i < sz; i++) {
+            unsigned r = uf.find(i);
+            if (root2comp[r] == UINT_MAX) {
+                root2comp[r] = components.size();
+                components.push_back(unsigned_vector());
+            }
+            components[root2comp[r]].push_back(i);
+        }
+    }
+
+    /**
+       \brief Distribute components over at most num_buckets buckets,
+       largest component first into the least loaded bucket.
+    */
+    void mk_buckets(vector<unsigned_vector> & components, unsigned num_buckets, vector<unsigned_vector> & buckets) {
+        std::sort(components.begin(), components.end(), 
+                  [](unsigned_vector const & a, unsigned_vector const & b) { return a.size() > b.size(); });
+        buckets.resize(std::min(num_buckets, components.size()));
+        for (unsigned_vector const & c : components) {
+            unsigned best = 0;
+            for (unsigned i = 1; i < buckets.size(); i++) 
+                if (buckets[i].size() < buckets[best].size())
+                    best = i;
+            buckets[best].append(c);
+        }
+    }
+
+public:
+    par_components_tactical(tactic * t):unary_tactical(t) {}
+
+    void operator()(goal_ref const & in, goal_ref_buffer& result) override {
+        ast_manager & m = in->m();
+        unsigned num_threads = 1;
+#ifndef SINGLE_THREAD
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+#endif
+        if (num_threads == 1 || in->proofs_enabled() || in->unsat_core_enabled() || 
+            in->inconsistent() || m.has_trace_stream()) {
+            m_t->operator()(in, result);
+            return;
+        }
+        vector<unsigned_vector> components, buckets;
+        mk_components(*(in.get()), components);
+        mk_buckets(components, num_threads, buckets);
+        unsigned sz = buckets.size();
+        if (sz <= 1) {
+            m_t->operator()(in, result);
+            return;
+        }
+        IF_VERBOSE(10, verbose_stream() << "(par-components :components " << components.size() << " :buckets " << sz << ")\n";);
+
+        bool models_enabled = in->models_enabled();
+        scoped_ptr_vector<ast_manager> managers;
+        scoped_limits scl(m.limit());
+        goal_ref_vector                in_copies;
+        tactic_ref_vector              ts;
+        for (unsigned i = 0; i < sz; i++) {
+            ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
+            managers.push_back(new_m);
+            ast_translation translator(m, *new_m);
+            goal * g = alloc(goal, *new_m, false, models_enabled, false);
+            for (unsigned idx : buckets[i]) 
+                g->assert_expr(translator(in->form(idx)));
+            in_copies.push_back(g);
+            ts.push_back(m_t->translate(*new_m));
+            scl.push_child(&new_m->limit());
+        }
+
+        vector<goal_ref_buffer> results;
+        results.resize(sz);
+        svector<par_exception_kind> ex_kinds(sz, DEFAULT_EX);
+        svector<bool> failed(sz, false);
+        vector<std::string> ex_msgs;
+        ex_msgs.resize(sz);
+        unsigned_vector error_codes(sz, 0u);
+
+        auto worker_thread = [&](unsigned i) {
+            try {
+                (*(ts.get(i)))(in_copies[i], results[i]);
+                return;
+            }
+            catch (tactic_exception & ex) {
+                ex_kinds[i] = TACTIC_EX;
+                ex_msgs[i] = ex.msg();
+            }
+            catch (z3_error & err) {
+                ex_kinds[i] = ERROR_EX;
+                error_codes[i] = err.error_code();
+            }
+            catch (z3_exception & z3_ex) {
+                ex_kinds[i] = DEFAULT_EX;
+                ex_msgs[i] = z3_ex.msg();
+            }
+            failed[i] = true;
+            for (unsigned j = 0; j < sz; j++) 
+                if (i != j) 
+                    managers[j]->limit().cancel();
+        };
+
+        thread_pool::run(sz, worker_thread);
+
+        for (unsigned i = 0; i < sz; i++) {
+            if (!failed[i]) 
+                continue;
+            switch (ex_kinds[i]) {
+            case ERROR_EX: throw z3_error(error_codes[i]);
+            case TACTIC_EX: throw tactic_exception(std::move(ex_msgs[i]));
+            default:
+                throw default_exception(std::move(ex_msgs[i]));
+            }
+        }
+
+        for (unsigned i = 0; i < sz; i++) {
+            if (results[i].size() > 1) {
+                // the sub-tactic is branching: subgoals of different 
+                // components cannot be combined into a single goal.
+                IF_VERBOSE(10, verbose_stream() << "(par-components :branching)\n";);
+                results.reset();
+                m_t->operator()(in, result);
+                return;
+            }
+        }
+
+        in->reset();
+        for (unsigned i = 0; i < sz; i++) {
+            ast_translation translator(*(managers[i]), m, false);
+            for (goal * r : results[i]) {
+                goal_ref g = r->translate(translator);
+                if (g->inconsistent()) {
+                    in->assert_expr(m.mk_false());
+                }
+                else {
+                    for (unsigned j = 0; j < g->size(); j++) 
+                        in->assert_expr(g->form(j));
+                }
+                in->add(g->mc());
+                in->updt_prec(g->prec());
+            }
+            results[i].reset();
+        }
+        in->inc_depth();
+        result.push_back(in.get());
+    }
+
+    tactic * translate(ast_manager & m) override { return translate_core<par_components_tactical>(m); }
+};
+
+tactic * par_components(tactic * t) {
+    return alloc(par_components_tactical, t);
+}
+
 class cleanup_tactical : public unary_tactical {
 public:
     cleanup_tactical(tactic * t):unary_tactical(t) {}
@@ -1008,11 +1302,20 @@ class annotate_tactical : public unary_tactical {
     std::string m_name;
     struct scope {
         std::string m_name;
-        scope(std::string const& name) : m_name(name) {
+        stopwatch   m_watch;
+        scope(std::string const& name, goal const& g) : m_name(name) {
             IF_VERBOSE(TACTIC_VERBOSITY_LVL, verbose_stream() << "(" << m_name << " start)\n";);
+            if (event_trace::enabled()) {
+                event_trace::event("tactic.start")("name", m_name.c_str())("size", g.size());
+                m_watch.start();
+            }
         }
         ~scope() {
             IF_VERBOSE(TACTIC_VERBOSITY_LVL, verbose_stream() << "(" << m_name << " done)\n";);
+            if (event_trace::enabled()) {
+                m_watch.stop();
+                event_trace::event("tactic.end")("name", m_name.c_str())("time", m_watch.get_seconds());
+            }
         }
     };
 public:
@@ -1020,7 +1323,7 @@ public:
         unary_tactical(t), m_name(name) {}
     
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
-        scope _scope(m_name);
+        scope _scope(m_name, *in);
         m_t->operator()(in, result);
     }
 
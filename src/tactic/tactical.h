@@ -52,6 +52,14 @@ tactic * repeat(tactic * t, unsigned max = UINT_MAX);
 */
 tactic * fail_if_branching(tactic * t, unsigned threshold = 1);
 
+/**
+   \brief Apply \c t in parallel to the groups of formulas that share
+   no uninterpreted symbols, and conjoin the resulting goals.
+   Behaves like \c t when proofs or unsat cores are enabled, or when
+   \c t produces more than one subgoal for some group.
+*/
+tactic * par_components(tactic * t);
+
 tactic * par(unsigned num, tactic * const * ts);
 tactic * par(tactic * t1, tactic * t2);
 tactic * par(tactic * t1, tactic * t2, tactic * t3);
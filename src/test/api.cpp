@@ -107,10 +107,196 @@ static void test_mk_distinct() {
     
 }
 
+static void test_solver_template() {
+    // a solver with a background theory is copied within the same context.
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_solver s = Z3_mk_simple_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_sort int_sort = Z3_mk_int_sort(ctx);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), int_sort);
+    Z3_ast y = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "y"), int_sort);
+    Z3_ast one = Z3_mk_int(ctx, 1, int_sort);
+    Z3_ast args[2] = { x, one };
+    Z3_solver_assert(ctx, s, Z3_mk_gt(ctx, x, Z3_mk_int(ctx, 0, int_sort)));
+    Z3_solver_assert(ctx, s, Z3_mk_eq(ctx, y, Z3_mk_add(ctx, 2, args)));
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+
+    Z3_solver s1 = Z3_solver_translate(ctx, s, ctx);
+    Z3_solver_inc_ref(ctx, s1);
+    Z3_solver_assert(ctx, s1, Z3_mk_le(ctx, y, one));
+    ENSURE(Z3_solver_check(ctx, s1) == Z3_L_FALSE);
+
+    Z3_solver s2 = Z3_solver_translate(ctx, s, ctx);
+    Z3_solver_inc_ref(ctx, s2);
+    Z3_solver_assert(ctx, s2, Z3_mk_eq(ctx, y, Z3_mk_int(ctx, 3, int_sort)));
+    ENSURE(Z3_solver_check(ctx, s2) == Z3_L_TRUE);
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+
+    Z3_solver_dec_ref(ctx, s2);
+    Z3_solver_dec_ref(ctx, s1);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_config(cfg);
+    Z3_del_context(ctx);
+}
+
+static void test_solver_enumerate() {
+    // (a or b) and (not a or c) has 4 models over a, b, c; 3 of them agree on a, b.
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_sort bool_sort = Z3_mk_bool_sort(ctx);
+    Z3_ast a = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "a"), bool_sort);
+    Z3_ast b = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "b"), bool_sort);
+    Z3_ast c = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "c"), bool_sort);
+    Z3_ast ab[2] = { a, b };
+    Z3_ast ac[2] = { Z3_mk_not(ctx, a), c };
+    Z3_solver_assert(ctx, s, Z3_mk_or(ctx, 2, ab));
+    Z3_solver_assert(ctx, s, Z3_mk_or(ctx, 2, ac));
+    Z3_ast_vector vars = Z3_mk_ast_vector(ctx);
+    Z3_ast_vector_inc_ref(ctx, vars);
+    Z3_ast_vector_push(ctx, vars, a);
+    Z3_ast_vector_push(ctx, vars, b);
+    Z3_ast_vector models = Z3_mk_ast_vector(ctx);
+    Z3_ast_vector_inc_ref(ctx, models);
+    ENSURE(Z3_solver_enumerate(ctx, s, vars, 0, models) == Z3_L_TRUE);
+    ENSURE(Z3_ast_vector_size(ctx, models) == 3);
+    // the models are distinct and each of them is a model.
+    for (unsigned i = 0; i < 3; ++i) {
+        Z3_solver_push(ctx, s);
+        Z3_solver_assert(ctx, s, Z3_ast_vector_get(ctx, models, i));
+        for (unsigned j = 0; j < i; ++j) {
+            Z3_solver_assert(ctx, s, Z3_mk_not(ctx, Z3_ast_vector_get(ctx, models, j)));
+        }
+        ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+        Z3_solver_pop(ctx, s, 1);
+    }
+    // no clauses were added to the solver.
+    ENSURE(Z3_solver_enumerate(ctx, s, vars, 2, models) == Z3_L_TRUE);
+    ENSURE(Z3_ast_vector_size(ctx, models) == 5);
+    Z3_solver_assert(ctx, s, Z3_mk_not(ctx, a));
+    Z3_solver_assert(ctx, s, Z3_mk_not(ctx, b));
+    ENSURE(Z3_solver_enumerate(ctx, s, vars, 0, models) == Z3_L_FALSE);
+
+    Z3_ast_vector_dec_ref(ctx, models);
+    Z3_ast_vector_dec_ref(ctx, vars);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_config(cfg);
+    Z3_del_context(ctx);
+}
+
+static void test_solver_approx_count() {
+    // (x0 or x1) over x0, .., x7 has 3 * 2^6 models.
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_sort bool_sort = Z3_mk_bool_sort(ctx);
+    Z3_ast_vector vars = Z3_mk_ast_vector(ctx);
+    Z3_ast_vector_inc_ref(ctx, vars);
+    for (int i = 0; i < 8; ++i) {
+        Z3_ast_vector_push(ctx, vars, Z3_mk_const(ctx, Z3_mk_int_symbol(ctx, i), bool_sort));
+    }
+    Z3_ast x01[2] = { Z3_ast_vector_get(ctx, vars, 0), Z3_ast_vector_get(ctx, vars, 1) };
+    Z3_solver_assert(ctx, s, Z3_mk_or(ctx, 2, x01));
+    Z3_ast count = nullptr;
+    int64_t n = 0;
+    ENSURE(Z3_solver_approx_count(ctx, s, vars, 200, 1, &count) == Z3_L_TRUE);
+    ENSURE(Z3_get_numeral_int64(ctx, count, &n) && n == 192);
+    ENSURE(Z3_solver_approx_count(ctx, s, vars, 16, 5, &count) == Z3_L_TRUE);
+    ENSURE(Z3_get_numeral_int64(ctx, count, &n) && 48 <= n && n <= 768);
+    Z3_solver_assert(ctx, s, Z3_mk_not(ctx, x01[0]));
+    Z3_solver_assert(ctx, s, Z3_mk_not(ctx, x01[1]));
+    ENSURE(Z3_solver_approx_count(ctx, s, vars, 16, 5, &count) == Z3_L_FALSE);
+
+    Z3_ast_vector_dec_ref(ctx, vars);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_config(cfg);
+    Z3_del_context(ctx);
+}
+
+static void test_solver_get_backbone() {
+    // x0 and (not x0 or not x1) and (x2 or x3) fixes x0 and x1, and nothing else.
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_sort bool_sort = Z3_mk_bool_sort(ctx);
+    Z3_ast x[4];
+    Z3_ast_vector vars = Z3_mk_ast_vector(ctx);
+    Z3_ast_vector_inc_ref(ctx, vars);
+    for (int i = 0; i < 4; ++i) {
+        x[i] = Z3_mk_const(ctx, Z3_mk_int_symbol(ctx, i), bool_sort);
+        Z3_ast_vector_push(ctx, vars, x[i]);
+    }
+    Z3_ast c1[2] = { Z3_mk_not(ctx, x[0]), Z3_mk_not(ctx, x[1]) };
+    Z3_ast c2[2] = { x[2], x[3] };
+    Z3_solver_assert(ctx, s, x[0]);
+    Z3_solver_assert(ctx, s, Z3_mk_or(ctx, 2, c1));
+    Z3_solver_assert(ctx, s, Z3_mk_or(ctx, 2, c2));
+    Z3_ast_vector backbone = Z3_mk_ast_vector(ctx);
+    Z3_ast_vector_inc_ref(ctx, backbone);
+    ENSURE(Z3_solver_get_backbone(ctx, s, vars, backbone) == Z3_L_TRUE);
+    ENSURE(Z3_ast_vector_size(ctx, backbone) == 2);
+    Z3_ast b0 = Z3_ast_vector_get(ctx, backbone, 0);
+    Z3_ast b1 = Z3_ast_vector_get(ctx, backbone, 1);
+    ENSURE((Z3_is_eq_ast(ctx, b0, x[0]) && Z3_is_eq_ast(ctx, b1, c1[1])) ||
+           (Z3_is_eq_ast(ctx, b1, x[0]) && Z3_is_eq_ast(ctx, b0, c1[1])));
+    ENSURE(Z3_solver_get_num_scopes(ctx, s) == 0);
+
+    Z3_ast_vector_dec_ref(ctx, backbone);
+    Z3_ast_vector_dec_ref(ctx, vars);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_config(cfg);
+    Z3_del_context(ctx);
+}
+
+static void test_core_quickxplain() {
+    // a0 and a9 are inconsistent, the other assumptions are irrelevant.
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_solver s = Z3_mk_simple_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_params p = Z3_mk_params(ctx);
+    Z3_params_inc_ref(ctx, p);
+    Z3_params_set_bool(ctx, p, Z3_mk_string_symbol(ctx, "core.minimize"), true);
+    Z3_params_set_bool(ctx, p, Z3_mk_string_symbol(ctx, "core.minimize.quickxplain"), true);
+    Z3_solver_set_params(ctx, s, p);
+    Z3_sort bool_sort = Z3_mk_bool_sort(ctx);
+    Z3_ast a[10];
+    for (int i = 0; i < 10; ++i) {
+        a[i] = Z3_mk_const(ctx, Z3_mk_int_symbol(ctx, i), bool_sort);
+    }
+    Z3_ast b = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "b"), bool_sort);
+    Z3_ast ors[3] = { Z3_mk_not(ctx, a[0]), b, Z3_mk_not(ctx, a[9]) };
+    Z3_solver_assert(ctx, s, Z3_mk_or(ctx, 3, ors));
+    Z3_solver_assert(ctx, s, Z3_mk_not(ctx, b));
+    ENSURE(Z3_solver_check_assumptions(ctx, s, 10, a) == Z3_L_FALSE);
+    Z3_ast_vector core = Z3_solver_get_unsat_core(ctx, s);
+    Z3_ast_vector_inc_ref(ctx, core);
+    ENSURE(Z3_ast_vector_size(ctx, core) == 2);
+    for (unsigned i = 0; i < 2; ++i) {
+        Z3_ast c = Z3_ast_vector_get(ctx, core, i);
+        ENSURE(Z3_is_eq_ast(ctx, c, a[0]) || Z3_is_eq_ast(ctx, c, a[9]));
+    }
+
+    Z3_ast_vector_dec_ref(ctx, core);
+    Z3_params_dec_ref(ctx, p);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_config(cfg);
+    Z3_del_context(ctx);
+}
+
 void tst_api() {
     test_apps();
     test_bvneg();
     test_mk_distinct();
+    test_solver_template();
+    test_solver_enumerate();
+    test_solver_approx_count();
+    test_solver_get_backbone();
+    test_core_quickxplain();
 }
 #else
 void tst_api() {
@@ -34,7 +34,31 @@ static char const* example1 = "(<= (+ (* 1.3 x y) (* 2.3 y y) (* (- 1.1 x x))) 2
 static char const* example2 = "(= (+ 4 3 (- (* 3 x x) (* 5 y)) y) 0)";
 
 
+// rewriting chunks in separate managers gives the results of the sequential rewriter
+static void tst_parallel_rewrite() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util au(m);
+    expr_ref_vector fmls(m), copy(m);
+    for (unsigned i = 0; i < 200; ++i) {
+        expr_ref p(m.mk_const(symbol(i), m.mk_bool_sort()), m);
+        expr_ref t(au.mk_le(au.mk_add(au.mk_int(i), au.mk_int(2)), au.mk_mul(au.mk_int(2), au.mk_int(i))), m);
+        fmls.push_back(m.mk_or(t, m.mk_and(m.mk_true(), m.mk_not(p))));
+    }
+    copy.append(fmls);
+    th_rewriter rw(m);
+    for (unsigned i = 0; i < copy.size(); ++i) {
+        expr_ref r(copy.get(i), m);
+        rw(r);
+        copy.set(i, r);
+    }
+    ENSURE(parallel_rewrite(m, params_ref(), 4, 50, fmls) > 0);
+    for (unsigned i = 0; i < fmls.size(); ++i)
+        ENSURE(fmls.get(i) == copy.get(i));
+}
+
 void tst_arith_rewriter() {
+    tst_parallel_rewrite();
     ast_manager m;
     reg_decl_plugins(m);
     arith_rewriter ar(m);
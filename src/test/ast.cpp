@@ -17,6 +17,11 @@ Revision History:
 
 --*/
 #include "ast/ast.h"
+#include "ast/ast_binary.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include <sstream>
+#include <thread>
 
 static void tst1() {
     ast_manager m;
@@ -131,6 +136,103 @@ static void tst5() {
     m.del(arr3);
 }
 
+static void tst6() {
+    // arena mode keeps unreferenced nodes alive.
+    ast_manager m;
+    m.enable_arena_mode();
+    sort * b = m.mk_bool_sort();
+    app * a = m.mk_const(symbol("a"), b);
+    app * c = m.mk_const(symbol("c"), b);
+    app * n1 = nullptr;
+    {
+        expr_ref r(m.mk_and(a, c), m);
+        n1 = to_app(r.get());
+    }
+    ENSURE(m.mk_and(a, c) == n1);
+}
+
+static void tst7() {
+    // terms can be built concurrently in concurrent mode.
+    ast_manager m;
+    m.enable_concurrent_mode();
+    ENSURE(m.arena_mode());
+    sort * b = m.mk_bool_sort();
+    const unsigned num_threads = 4, num_terms = 200;
+    ptr_vector<app> results[num_threads];
+    std::thread threads[num_threads];
+    for (unsigned t = 0; t < num_threads; ++t) {
+        threads[t] = std::thread([&, t]() {
+            for (unsigned i = 0; i < num_terms; ++i) {
+                app * x = m.mk_const(symbol(i), b);
+                app * y = m.mk_const(symbol(i + 1), b);
+                results[t].push_back(m.mk_or(x, m.mk_not(y)));
+            }
+        });
+    }
+    for (auto & th : threads) 
+        th.join();
+    for (unsigned t = 1; t < num_threads; ++t) 
+        for (unsigned i = 0; i < num_terms; ++i) 
+            ENSURE(results[t][i] == results[0][i]);
+}
+
+static void tst8() {
+    // binary serialization round trip.
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort * s = m.mk_uninterpreted_sort(symbol("S"));
+    sort * i = a.mk_int();
+    func_decl * f = m.mk_func_decl(symbol("f"), s, i);
+    app * x = m.mk_const(symbol("x"), s);
+    expr * fx = m.mk_app(f, x);
+    expr_ref body(a.mk_le(m.mk_app(f, m.mk_var(0, s)), a.mk_numeral(rational(-7, 3), false)), m);
+    ast_ref_vector roots(m);
+    roots.push_back(a.mk_lt(a.mk_add(fx, fx, a.mk_int(5)), a.mk_int(-2)));
+    symbol y("y");
+    roots.push_back(m.mk_forall(1, &s, &y, body));
+    roots.push_back(f);
+
+    std::stringstream strm1;
+    ast_to_binary(strm1, m, roots);
+    ast_ref_vector result(m);
+    binary_to_ast(strm1, m, result);
+    ENSURE(result.size() == roots.size());
+    for (unsigned j = 0; j < roots.size(); ++j)
+        ENSURE(result.get(j) == roots.get(j));
+
+    // reading into a different manager yields the same encoding.
+    ast_manager m2;
+    reg_decl_plugins(m2);
+    std::stringstream strm2(strm1.str()), strm3;
+    ast_ref_vector result2(m2);
+    binary_to_ast(strm2, m2, result2);
+    ast_to_binary(strm3, m2, result2);
+    ENSURE(strm1.str() == strm3.str());
+}
+
+static void tst9() {
+    // plugins are created on first use and survive translation.
+    ast_manager m;
+    reg_decl_plugins(m);
+    family_id seq_fid = m.mk_family_id("seq");
+    family_id arith_fid = m.mk_family_id("arith");
+    ENSURE(m.has_plugin(seq_fid));
+    ENSURE(m.has_plugin(symbol("pb")));
+    arith_util a(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    ENSURE(m.get_plugin(arith_fid) != nullptr);
+    ast_manager m2(m, false);
+    ENSURE(m2.has_plugin(seq_fid));
+    ENSURE(m2.get_plugin(seq_fid) != nullptr);
+    ENSURE(m2.get_plugin(seq_fid)->get_family_id() == seq_fid);
+    ENSURE(m2.get_plugin(arith_fid) != nullptr);
+    ENSURE(m.get_plugin(m.mk_family_id("array")) != nullptr);
+    // registering again keeps the existing plugins.
+    decl_plugin * p = m.get_plugin(arith_fid);
+    reg_decl_plugins(m);
+    ENSURE(m.get_plugin(arith_fid) == p);
+}
 
 struct foo {
     unsigned       m_id; 
@@ -153,5 +255,11 @@ void tst_ast() {
     tst3();
     tst4();
     tst5();
+    tst6();
+    tst8();
+    tst9();
+#ifndef SINGLE_THREAD
+    tst7();
+#endif
 }
 
@@ -1,4 +1,5 @@
 #include "math/dd/dd_bdd.h"
+#include <cstring>
 
 namespace dd {
     static void test1() {
@@ -73,6 +74,32 @@ namespace dd {
         std::cout << c1 << "\n";
         std::cout << c1.bdd_size() << "\n";
     }
+
+    static unsigned cache_hits(bdd_manager const& m) {
+        statistics st;
+        m.collect_statistics(st);
+        for (unsigned i = 0; i < st.size(); ++i)
+            if (0 == strcmp(st.get_key(i), "bdd cache hits"))
+                return st.get_uint_value(i);
+        return 0;
+    }
+
+    static void test5() {
+        bdd_manager m(20);
+        bdd v0 = m.mk_var(0);
+        bdd v1 = m.mk_var(1);
+        bdd v2 = m.mk_var(2);
+        bdd c1 = (v0 && v1) || (v1 && !v2);
+        unsigned hits = cache_hits(m);
+        bdd c2 = (v0 && v1) || (v1 && !v2);
+        SASSERT(c1 == c2);
+        SASSERT(cache_hits(m) > hits);
+        // operands in swapped positions are not confused with the cached entry
+        SASSERT((v0 && !v1) != (v1 && !v0));
+        statistics st;
+        m.collect_statistics(st);
+        st.display(std::cout);
+    }
 }
 
 void tst_bdd() {
@@ -80,4 +107,5 @@ void tst_bdd() {
     dd::test2();
     dd::test3();
     dd::test4();
+    dd::test5();
 }
@@ -0,0 +1,50 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    bench.h
+
+Abstract:
+
+    Micro-benchmark harness.
+
+    A benchmark is a function that repeats its body while
+    keep_running() holds:
+
+        void bench_vector_push_back(bench_state& s) {
+            while (s.keep_running()) {
+                unsigned_vector v;
+                for (unsigned i = 0; i < s.size(); ++i)
+                    v.push_back(i);
+                s.consume(v.size());
+            }
+        }
+
+    The harness increases the number of iterations until a run takes
+    long enough to be measured, and reports the time and the number
+    of allocations per iteration. size() is the number of elements a
+    benchmark works on, set with /n:<size>.
+
+--*/
+#pragma once
+
+class bench_state {
+    unsigned          m_iterations;
+    unsigned          m_count;
+    unsigned          m_size;
+    volatile unsigned m_sink;
+public:
+    bench_state(unsigned iterations, unsigned size):
+        m_iterations(iterations), m_count(0), m_size(size), m_sink(0) {}
+
+    bool keep_running() { return m_count++ < m_iterations; }
+
+    unsigned size() const { return m_size; }
+
+    /**
+       \brief use a value computed by the benchmark, so the computation
+       is not optimized away.
+    */
+    void consume(unsigned v) { m_sink = m_sink + v; }
+};
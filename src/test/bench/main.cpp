@@ -0,0 +1,123 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    main.cpp
+
+Abstract:
+
+    Micro-benchmarks of the data structures and numerals in src/util.
+
+    Usage: bench-z3 [/n:size] [/t:seconds] [/a] [benchmark names]
+
+--*/
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include "util/memory_manager.h"
+#include "util/rational.h"
+#include "test/bench/bench.h"
+
+void gparams_register_modules() {}
+void mem_initialize() {}
+void mem_finalize() {}
+
+static unsigned g_size     = 1000;
+static double   g_min_time = 0.5;
+
+static void run_bench(char const* name, void (*f)(bench_state&)) {
+    unsigned iterations = 1;
+    while (true) {
+        bench_state s(iterations, g_size);
+        unsigned long long allocs = memory::get_thread_allocation_count();
+        auto start = std::chrono::steady_clock::now();
+        f(s);
+        std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+        allocs = memory::get_thread_allocation_count() - allocs;
+        if (d.count() >= g_min_time || iterations >= (1u << 30)) {
+            std::cout << std::left << std::setw(32) << name << std::right
+                      << std::setw(12) << iterations << " iterations "
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(14) << 1e9 * d.count() / iterations << " ns/iter "
+                      << std::setw(10) << static_cast<double>(allocs) / iterations << " allocs/iter\n";
+            std::cout.flush();
+            return;
+        }
+        // aim for the minimal time based on the last run
+        double scale = d.count() > 0 ? 1.4 * g_min_time / d.count() : 100;
+        if (scale > 100)
+            scale = 100;
+        if (scale < 2)
+            scale = 2;
+        iterations = static_cast<unsigned>(iterations * scale);
+    }
+}
+
+#define BENCH(NAME) {                                           \
+        void bench_##NAME(bench_state& s);                      \
+        if (display_usage)                                      \
+            std::cout << "    " << #NAME << "\n";               \
+        else                                                    \
+            for (int i = 1; i < argc; i++)                      \
+                if (run_all || strcmp(argv[i], #NAME) == 0)  {  \
+                    run_bench(#NAME, bench_##NAME);             \
+                    break;                                      \
+                }                                               \
+    }
+
+int main(int argc, char ** argv) {
+    bool display_usage = argc == 1;
+    bool run_all = false;
+    for (int i = 1; i < argc; i++) {
+        char const* arg = argv[i];
+        if (arg[0] != '/' && arg[0] != '-')
+            continue;
+        if (strcmp(arg + 1, "a") == 0)
+            run_all = true;
+        else if (strncmp(arg + 1, "n:", 2) == 0)
+            g_size = static_cast<unsigned>(strtoul(arg + 3, nullptr, 10));
+        else if (strncmp(arg + 1, "t:", 2) == 0)
+            g_min_time = strtod(arg + 3, nullptr);
+        else
+            display_usage = true;
+    }
+    if (display_usage) {
+        std::cout << "Z3 micro-benchmarks.\n";
+        std::cout << "Usage: bench-z3 [options] [benchmark names]\n";
+        std::cout << "  /a          run all benchmarks.\n";
+        std::cout << "  /n:size     number of elements used by the benchmarks (default 1000).\n";
+        std::cout << "  /t:seconds  minimal time of a measurement (default 0.5).\n";
+        std::cout << "\nBenchmark names:\n";
+    }
+    rational::initialize();
+    BENCH(vector_push_back);
+    BENCH(vector_iterate);
+    BENCH(hashtable_insert);
+    BENCH(hashtable_lookup);
+    BENCH(hashtable_erase);
+    BENCH(hashtable_iterate);
+    BENCH(chashtable_insert);
+    BENCH(chashtable_lookup);
+    BENCH(chashtable_erase);
+    BENCH(obj_map_insert);
+    BENCH(obj_map_lookup);
+    BENCH(obj_map_erase);
+    BENCH(swiss_map_insert);
+    BENCH(swiss_map_lookup);
+    BENCH(swiss_map_erase);
+    BENCH(swiss_map_iterate);
+    BENCH(heap_insert_erase_min);
+    BENCH(heap_decreased);
+    BENCH(region_allocate);
+    BENCH(small_object_allocator_churn);
+    BENCH(mpz_mul_add);
+    BENCH(mpz_gcd);
+    BENCH(mpq_add_mul);
+    BENCH(mpff_add_mul);
+    rational::finalize();
+    memory::finalize();
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    num_bench.cpp
+
+Abstract:
+
+    Micro-benchmarks of mpz, mpq and mpff arithmetic.
+
+    The operands mix small numerals, which mpz stores inline, with
+    numerals that grow beyond a machine word.
+
+--*/
+#include "util/mpz.h"
+#include "util/mpq.h"
+#include "util/mpff.h"
+#include "util/vector.h"
+#include "test/bench/bench.h"
+
+void bench_mpz_mul_add(bench_state& s) {
+    unsynch_mpz_manager m;
+    scoped_mpz acc(m), x(m), y(m);
+    while (s.keep_running()) {
+        m.set(acc, 1);
+        for (unsigned i = 0; i < s.size(); ++i) {
+            m.set(x, static_cast<int>(i % 1000) + 1);
+            m.mul(acc, x, y);
+            m.add(y, x, acc);
+            if (i % 64 == 63)
+                m.set(acc, 1);
+        }
+        s.consume(m.is_small(acc));
+    }
+}
+
+void bench_mpz_gcd(bench_state& s) {
+    unsynch_mpz_manager m;
+    scoped_mpz a(m), b(m), g(m), t(m);
+    m.set(a, 1);
+    m.set(b, 1);
+    for (unsigned i = 0; i < 40; ++i) {
+        m.set(t, 1000003);
+        m.mul(a, t, a);
+        m.set(t, 999983 + 2 * i);
+        m.mul(b, t, b);
+        m.add(a, t, a);
+    }
+    while (s.keep_running()) {
+        for (unsigned i = 0; i < s.size(); i += 100) 
+            m.gcd(a, b, g);
+        s.consume(m.is_one(g));
+    }
+}
+
+void bench_mpq_add_mul(bench_state& s) {
+    unsynch_mpq_manager m;
+    scoped_mpq acc(m), x(m), y(m);
+    while (s.keep_running()) {
+        m.set(acc, 0);
+        for (unsigned i = 0; i < s.size(); ++i) {
+            m.set(x, static_cast<int>(i % 7) + 1, static_cast<int>(i % 11) + 2);
+            m.add(acc, x, acc);
+            if (i % 3 == 0) {
+                m.mul(acc, x, y);
+                m.swap(acc, y);
+            }
+            if (i % 32 == 31)
+                m.set(acc, 0);
+        }
+        s.consume(m.is_zero(acc));
+    }
+}
+
+void bench_mpff_add_mul(bench_state& s) {
+    mpff_manager m;
+    scoped_mpff acc(m), x(m), y(m);
+    while (s.keep_running()) {
+        m.set(acc, 1);
+        for (unsigned i = 0; i < s.size(); ++i) {
+            m.set(x, static_cast<int>(i % 13) + 1);
+            m.mul(acc, x, y);
+            m.div(y, x, acc);
+            m.add(acc, x, acc);
+        }
+        s.consume(m.is_zero(acc));
+    }
+}
@@ -0,0 +1,343 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    util_bench.cpp
+
+Abstract:
+
+    Micro-benchmarks of containers and allocators.
+
+    Keys are a pseudo-random permutation of 0..size-1, so the tables
+    see the same keys in every run.
+
+--*/
+#include "util/vector.h"
+#include "util/hashtable.h"
+#include "util/chashtable.h"
+#include "util/obj_hashtable.h"
+#include "util/swiss_table.h"
+#include "util/heap.h"
+#include "util/region.h"
+#include "util/small_object_allocator.h"
+#include "test/bench/bench.h"
+
+typedef int_hashtable<int_hash, default_eq<int> > int_set;
+typedef chashtable<int, int_hash, default_eq<int> > int_ctable;
+
+static void mk_keys(unsigned n, svector<int>& keys) {
+    keys.reset();
+    for (unsigned i = 0; i < n; ++i)
+        keys.push_back(i);
+    unsigned seed = 17;
+    for (unsigned i = n; i-- > 1; ) {
+        seed = seed * 1103515245 + 12345;
+        std::swap(keys[i], keys[(seed >> 8) % (i + 1)]);
+    }
+}
+
+void bench_vector_push_back(bench_state& s) {
+    while (s.keep_running()) {
+        unsigned_vector v;
+        for (unsigned i = 0; i < s.size(); ++i)
+            v.push_back(i);
+        s.consume(v.size());
+    }
+}
+
+void bench_vector_iterate(bench_state& s) {
+    unsigned_vector v;
+    for (unsigned i = 0; i < s.size(); ++i)
+        v.push_back(i);
+    while (s.keep_running()) {
+        unsigned sum = 0;
+        for (unsigned x : v)
+            sum += x;
+        s.consume(sum);
+    }
+}
+
+void bench_hashtable_insert(bench_state& s) {
+    svector<int> keys;
+    mk_keys(s.size(), keys);
+    while (s.keep_running()) {
+        int_set t;
+        for (int k : keys)
+            t.insert(k);
+        s.consume(t.size());
+    }
+}
+
+void bench_hashtable_lookup(bench_state& s) {
+    svector<int> keys;
+    mk_keys(s.size(), keys);
+    int_set t;
+    for (unsigned i = 0; i < keys.size(); i += 2)
+        t.insert(keys[i]);
+    while (s.keep_running()) {
+        unsigned found = 0;
+        for (int k : keys)
+            found += t.contains(k);
+        s.consume(found);
+    }
+}
+
+void bench_hashtable_erase(bench_state& s) {
+    svector<int> keys;
+    mk_keys(s.size(), keys);
+    int_set t;
+    while (s.keep_running()) {
+        for (int k : keys)
+            t.insert(k);
+        for (int k : keys)
+            t.erase(k);
+        s.consume(t.size());
+    }
+}
+
+void bench_hashtable_iterate(bench_state& s) {
+    svector<int> keys;
+    mk_keys(s.size(), keys);
+    int_set t;
+    for (int k : keys)
+        t.insert(k);
+    while (s.keep_running()) {
+        unsigned sum = 0;
+        for (int k : t)
+            sum += k;
+        s.consume(sum);
+    }
+}
+
+void bench_chashtable_insert(bench_state& s) {
+    svector<int> keys;
+    mk_keys(s.size(), keys);
+    while (s.keep_running()) {
+        int_ctable t;
+        for (int k : keys)
+            t.insert(k);
+        s.consume(t.size());
+    }
+}
+
+void bench_chashtable_lookup(bench_state& s) {
+    svector<int> keys;
+    mk_keys(s.size(), keys);
+    int_ctable t;
+    for (unsigned i = 0; i < keys.size(); i += 2)
+        t.insert(keys[i]);
+    while (s.keep_running()) {
+        unsigned found = 0;
+        for (int k : keys)
+            found += t.contains(k);
+        s.consume(found);
+    }
+}
+
+void bench_chashtable_erase(bench_state& s) {
+    svector<int> keys;
+    mk_keys(s.size(), keys);
+    int_ctable t;
+    while (s.keep_running()) {
+        for (int k : keys)
+            t.insert(k);
+        for (int k : keys)
+            t.erase(k);
+        s.consume(t.size());
+    }
+}
+
+namespace {
+    struct node {
+        unsigned m_id;
+        unsigned hash() const { return m_id; }
+    };
+};
+
+static void mk_nodes(unsigned n, svector<node>& nodes, ptr_vector<node>& ptrs) {
+    svector<int> keys;
+    mk_keys(n, keys);
+    nodes.reset();
+    ptrs.reset();
+    for (int k : keys)
+        nodes.push_back({ static_cast<unsigned>(k) * 2654435761u });
+    for (node& n : nodes)
+        ptrs.push_back(&n);
+}
+
+void bench_obj_map_insert(bench_state& s) {
+    svector<node> nodes;
+    ptr_vector<node> ptrs;
+    mk_nodes(s.size(), nodes, ptrs);
+    while (s.keep_running()) {
+        obj_map<node, unsigned> m;
+        unsigned i = 0;
+        for (node* n : ptrs)
+            m.insert(n, i++);
+        s.consume(m.size());
+    }
+}
+
+void bench_obj_map_lookup(bench_state& s) {
+    svector<node> nodes;
+    ptr_vector<node> ptrs;
+    mk_nodes(s.size(), nodes, ptrs);
+    obj_map<node, unsigned> m;
+    for (unsigned i = 0; i < ptrs.size(); i += 2)
+        m.insert(ptrs[i], i);
+    while (s.keep_running()) {
+        unsigned sum = 0, v = 0;
+        for (node* n : ptrs)
+            if (m.find(n, v))
+                sum += v;
+        s.consume(sum);
+    }
+}
+
+void bench_obj_map_erase(bench_state& s) {
+    svector<node> nodes;
+    ptr_vector<node> ptrs;
+    mk_nodes(s.size(), nodes, ptrs);
+    obj_map<node, unsigned> m;
+    while (s.keep_running()) {
+        for (node* n : ptrs)
+            m.insert(n, 0);
+        for (node* n : ptrs)
+            m.erase(n);
+        s.consume(m.size());
+    }
+}
+
+void bench_swiss_map_insert(bench_state& s) {
+    svector<node> nodes;
+    ptr_vector<node> ptrs;
+    mk_nodes(s.size(), nodes, ptrs);
+    while (s.keep_running()) {
+        obj_swiss_map<node, unsigned> m;
+        unsigned i = 0;
+        for (node* n : ptrs)
+            m.insert(n, i++);
+        s.consume(m.size());
+    }
+}
+
+void bench_swiss_map_lookup(bench_state& s) {
+    svector<node> nodes;
+    ptr_vector<node> ptrs;
+    mk_nodes(s.size(), nodes, ptrs);
+    obj_swiss_map<node, unsigned> m;
+    for (unsigned i = 0; i < ptrs.size(); i += 2)
+        m.insert(ptrs[i], i);
+    while (s.keep_running()) {
+        unsigned sum = 0, v = 0;
+        for (node* n : ptrs)
+            if (m.find(n, v))
+                sum += v;
+        s.consume(sum);
+    }
+}
+
+void bench_swiss_map_erase(bench_state& s) {
+    svector<node> nodes;
+    ptr_vector<node> ptrs;
+    mk_nodes(s.size(), nodes, ptrs);
+    obj_swiss_map<node, unsigned> m;
+    while (s.keep_running()) {
+        for (node* n : ptrs)
+            m.insert(n, 0);
+        for (node* n : ptrs)
+            m.erase(n);
+        s.consume(m.size());
+    }
+}
+
+void bench_swiss_map_iterate(bench_state& s) {
+    svector<node> nodes;
+    ptr_vector<node> ptrs;
+    mk_nodes(s.size(), nodes, ptrs);
+    obj_swiss_map<node, unsigned> m;
+    for (node* n : ptrs)
+        m.insert(n, 1);
+    while (s.keep_running()) {
+        unsigned sum = 0;
+        for (auto const& kv : m)
+            sum += kv.m_value;
+        s.consume(sum);
+    }
+}
+
+namespace {
+    // order by decreasing activity, as in variable selection
+    struct lt_proc {
+        svector<double> const& m_activity;
+        lt_proc(svector<double> const& a): m_activity(a) {}
+        bool operator()(int a, int b) const { return m_activity[a] > m_activity[b]; }
+    };
+};
+
+static void mk_activity(unsigned n, svector<int>& perm, svector<double>& activity) {
+    mk_keys(n, perm);
+    activity.reset();
+    for (int k : perm)
+        activity.push_back(k);
+}
+
+void bench_heap_insert_erase_min(bench_state& s) {
+    svector<int> perm;
+    svector<double> activity;
+    mk_activity(s.size(), perm, activity);
+    heap<lt_proc> h(s.size(), lt_proc(activity));
+    while (s.keep_running()) {
+        for (unsigned i = 0; i < s.size(); ++i)
+            h.insert(i);
+        unsigned sum = 0;
+        while (!h.empty())
+            sum += h.erase_min();
+        s.consume(sum);
+    }
+}
+
+void bench_heap_decreased(bench_state& s) {
+    svector<int> perm;
+    svector<double> activity;
+    mk_activity(s.size(), perm, activity);
+    heap<lt_proc> h(s.size(), lt_proc(activity));
+    for (unsigned i = 0; i < s.size(); ++i)
+        h.insert(i);
+    unsigned j = 0;
+    while (s.keep_running()) {
+        for (int k : perm) {
+            activity[k] += 1 + (j++ & 3);
+            h.decreased(k);
+        }
+        s.consume(h.min_value());
+    }
+}
+
+void bench_region_allocate(bench_state& s) {
+    region r;
+    while (s.keep_running()) {
+        r.push_scope();
+        for (unsigned i = 0; i < s.size(); ++i)
+            static_cast<unsigned*>(r.allocate(sizeof(unsigned) * (1 + i % 8)))[0] = i;
+        r.pop_scope();
+    }
+}
+
+void bench_small_object_allocator_churn(bench_state& s) {
+    small_object_allocator a("bench");
+    ptr_vector<void> objs;
+    while (s.keep_running()) {
+        for (unsigned i = 0; i < s.size(); ++i)
+            objs.push_back(a.allocate(8 * (1 + i % 16)));
+        // release every other object, then reuse the freed slots
+        for (unsigned i = 0; i < s.size(); i += 2)
+            a.deallocate(8 * (1 + i % 16), objs[i]);
+        for (unsigned i = 0; i < s.size(); i += 2)
+            objs[i] = a.allocate(8 * (1 + i % 16));
+        for (unsigned i = 0; i < s.size(); ++i)
+            a.deallocate(8 * (1 + i % 16), objs[i]);
+        objs.reset();
+    }
+}
@@ -0,0 +1,49 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    char_set.cpp
+
+Abstract:
+
+    Test interval sets of characters.
+
+--*/
+#include "util/char_set.h"
+#include "util/debug.h"
+
+static void tst_ops() {
+    char_set a(10, 20), b(15, 30), c(40, 50);
+    char_set ab = a | b;
+    ENSURE(ab == char_set(10, 30));
+    ENSURE((a & b) == char_set(15, 20));
+    ENSURE((a & c).empty());
+    char_set ac = a | c;
+    ENSURE(ac.num_ranges() == 2);
+    ENSURE(ac.contains(10) && ac.contains(45) && !ac.contains(30) && !ac.contains(51));
+    // adjacent intervals are merged
+    ENSURE((char_set(0, 9) | char_set(10, 20)) == char_set(0, 20));
+    ENSURE((ac | char_set(21, 39)) == char_set(10, 50));
+    std::cout << ac << "\n";
+}
+
+static void tst_complement() {
+    unsigned max_char = 255;
+    char_set a(10, 20);
+    char_set na = a.complement(max_char);
+    ENSURE(na.num_ranges() == 2);
+    ENSURE(na[0] == char_set::range(0, 9) && na[1] == char_set::range(21, 255));
+    ENSURE(na.complement(max_char) == a);
+    ENSURE((a | na).is_full(max_char));
+    ENSURE((a & na).empty());
+    ENSURE(char_set().complement(max_char).is_full(max_char));
+    ENSURE(char_set(0, max_char).complement(max_char).empty());
+    unsigned ch = 0;
+    ENSURE(char_set(0, 254).complement(max_char).is_char(ch) && ch == 255);
+}
+
+void tst_char_set() {
+    tst_ops();
+    tst_complement();
+}
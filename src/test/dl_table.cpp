@@ -95,6 +95,161 @@ void test_dl_bitvector_table() {
     test_table(mk_bv_table);
 }
 
+static void fill_random(random_gen& r, datalog::table_base& t1, datalog::table_base& t2, unsigned n) {
+    datalog::table_fact f;
+    for (unsigned i = 0; i < n; ++i) {
+        f.reset();
+        for (unsigned j = 0; j < t1.num_columns(); ++j) {
+            f.push_back(r(5));
+        }
+        t1.add_fact(f);
+        t2.add_fact(f);
+    }
+}
+
+static unsigned num_rows(datalog::table_base const& t) {
+    unsigned n = 0;
+    for (auto it = t.begin(), end = t.end(); it != end; ++it) {
+        ++n;
+    }
+    return n;
+}
+
+// same_rows(t1, t2) holds if the tables contain the same facts
+static bool same_rows(datalog::table_base const& t1, datalog::table_base const& t2) {
+    datalog::table_fact f;
+    for (auto it = t1.begin(), end = t1.end(); it != end; ++it) {
+        it->get_fact(f);
+        if (!t2.contains_fact(f)) 
+            return false;
+    }
+    return num_rows(t1) == num_rows(t2);
+}
+
+// compare a table plugin against the hashtable table
+static void test_dl_table_plugin(char const* name) {
+    smt_params params;
+    ast_manager ast_m;
+    reg_decl_plugins(ast_m);
+    datalog::register_engine re;
+    datalog::context ctx(ast_m, re, params);    
+    datalog::relation_manager & m = ctx.get_rel_context()->get_rmanager();
+    datalog::table_plugin * col = m.get_table_plugin(symbol(name));
+    datalog::table_plugin * ht = m.get_table_plugin(symbol("hashtable"));
+    ENSURE(col && ht);
+    random_gen r(0);
+    datalog::table_signature sig;
+    sig.push_back(5);
+    sig.push_back(5);
+    sig.push_back(5);
+    for (unsigned round = 0; round < 20; ++round) {
+        datalog::table_base* c1 = col->mk_empty(sig), *h1 = ht->mk_empty(sig);
+        datalog::table_base* c2 = col->mk_empty(sig), *h2 = ht->mk_empty(sig);
+        fill_random(r, *c1, *h1, 30);
+        fill_random(r, *c2, *h2, 30);
+        ENSURE(same_rows(*c1, *h1));
+
+        datalog::table_fact f;
+        f.push_back(r(5)); f.push_back(r(5)); f.push_back(r(5));
+        ENSURE(c1->contains_fact(f) == h1->contains_fact(f));
+        c1->remove_fact(f);
+        h1->remove_fact(f);
+        ENSURE(!c1->contains_fact(f));
+        ENSURE(same_rows(*c1, *h1));
+
+        unsigned cols1[2] = { 0, 2 };
+        unsigned cols2[2] = { 1, 0 };
+        scoped_ptr<datalog::table_join_fn> jc = m.mk_join_fn(*c1, *c2, 2, cols1, cols2);
+        scoped_ptr<datalog::table_join_fn> jh = m.mk_join_fn(*h1, *h2, 2, cols1, cols2);
+        datalog::table_base* cj = (*jc)(*c1, *c2), *hj = (*jh)(*h1, *h2);
+        ENSURE(same_rows(*cj, *hj));
+
+        unsigned removed[2] = { 1, 4 };
+        scoped_ptr<datalog::table_transformer_fn> pc = m.mk_project_fn(*cj, 2, removed);
+        scoped_ptr<datalog::table_transformer_fn> ph = m.mk_project_fn(*hj, 2, removed);
+        datalog::table_base* cp = (*pc)(*cj), *hp = (*ph)(*hj);
+        ENSURE(same_rows(*cp, *hp));
+
+        datalog::table_base* cd = col->mk_empty(sig), *hd = ht->mk_empty(sig);
+        scoped_ptr<datalog::table_union_fn> uc = m.mk_union_fn(*c1, *c2, cd);
+        scoped_ptr<datalog::table_union_fn> uh = m.mk_union_fn(*h1, *h2, hd);
+        (*uc)(*c1, *c2, cd);
+        (*uh)(*h1, *h2, hd);
+        ENSURE(same_rows(*c1, *h1));
+        ENSURE(same_rows(*cd, *hd));
+
+        unsigned cycle[3] = { 0, 2, 1 };
+        scoped_ptr<datalog::table_transformer_fn> rc = m.mk_rename_fn(*c1, 3, cycle);
+        scoped_ptr<datalog::table_transformer_fn> rh = m.mk_rename_fn(*h1, 3, cycle);
+        datalog::table_base* cr = (*rc)(*c1), *hr = (*rh)(*h1);
+        ENSURE(same_rows(*cr, *hr));
+        cr->deallocate();
+        hr->deallocate();
+
+        for (datalog::table_base* t : { c1, h1, c2, h2, cj, hj, cp, hp, cd, hd }) {
+            t->deallocate();
+        }
+    }
+}
+
+// a join on several threads produces the same rows as a sequential join
+void test_dl_column_table_parallel_join() {
+    smt_params params;
+    ast_manager ast_m;
+    reg_decl_plugins(ast_m);
+    datalog::register_engine re;
+    datalog::context ctx(ast_m, re, params);    
+    datalog::relation_manager & m = ctx.get_rel_context()->get_rmanager();
+    datalog::table_plugin * col = m.get_table_plugin(symbol("column"));
+    datalog::table_signature sig;
+    sig.push_back(2);
+    sig.push_back(1000);
+    datalog::table_base* t1 = col->mk_empty(sig), *t2 = col->mk_empty(sig);
+    datalog::table_fact f;
+    for (unsigned i = 0; i < 600; ++i) {
+        f.reset();
+        f.push_back(i % 2);
+        f.push_back(i);
+        t1->add_fact(f);
+        f[1] = 999 - i;
+        t2->add_fact(f);
+    }
+    unsigned cols[1] = { 0 };
+    params_ref p;
+    p.set_uint("datalog.join_threads", 1);
+    ctx.updt_params(p);
+    scoped_ptr<datalog::table_join_fn> j1 = m.mk_join_fn(*t1, *t2, 1, cols, cols);
+    p.set_uint("datalog.join_threads", 4);
+    ctx.updt_params(p);
+    scoped_ptr<datalog::table_join_fn> j4 = m.mk_join_fn(*t1, *t2, 1, cols, cols);
+    datalog::table_base* r1 = (*j1)(*t1, *t2), *r4 = (*j4)(*t1, *t2);
+    ENSURE(num_rows(*r1) == 2 * 300 * 300);
+    datalog::table_fact f1, f4;
+    auto it1 = r1->begin(), end1 = r1->end();
+    auto it4 = r4->begin(), end4 = r4->end();
+    for (; it1 != end1; ++it1, ++it4) {
+        ENSURE(it4 != end4);
+        it1->get_fact(f1);
+        it4->get_fact(f4);
+        ENSURE(f1 == f4);
+    }
+    ENSURE(it4 == end4);
+    for (datalog::table_base* t : { t1, t2, r1, r4 }) {
+        t->deallocate();
+    }
+}
+
+void test_dl_column_table() {
+    test_dl_table_plugin("column");
+}
+
+void test_dl_bdd_table() {
+    test_dl_table_plugin("bdd");
+}
+
 void tst_dl_table() {
     test_dl_bitvector_table();
+    test_dl_column_table();
+    test_dl_bdd_table();
+    test_dl_column_table_parallel_join();
 }
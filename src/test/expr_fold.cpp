@@ -0,0 +1,104 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    expr_fold.cpp
+
+Abstract:
+
+    Test bottom-up evaluation of expressions.
+
+--*/
+#include "ast/ast.h"
+#include "ast/expr_fold.h"
+#include "ast/reg_decl_plugins.h"
+
+// number of nodes of the expression as a tree, modulo 2^32
+struct tree_size_proc {
+    unsigned m_calls;
+    tree_size_proc(): m_calls(0) {}
+    unsigned operator()(expr * e, unsigned n, unsigned const * children) {
+        ++m_calls;
+        unsigned r = 1;
+        for (unsigned i = 0; i < n; ++i)
+            r += children[i];
+        return r;
+    }
+};
+
+// the same without side effects, for parallel evaluation
+struct pure_size_proc {
+    unsigned operator()(expr * e, unsigned n, unsigned const * children) const {
+        unsigned r = 1;
+        for (unsigned i = 0; i < n; ++i)
+            r += children[i];
+        return r;
+    }
+};
+
+static void tst_deep() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    // a chain of depth 1M does not overflow the stack
+    expr_ref e(m.mk_const(symbol("p"), m.mk_bool_sort()), m);
+    unsigned depth = 1000000;
+    for (unsigned i = 0; i < depth; ++i)
+        e = m.mk_not(e);
+    tree_size_proc p;
+    expr_fold<unsigned, tree_size_proc> f(p);
+    ENSURE(f(e) == depth + 1);
+    ENSURE(p.m_calls == depth + 1);
+    // cached
+    ENSURE(f(e) == depth + 1);
+    ENSURE(p.m_calls == depth + 1);
+    f.reset();
+    ENSURE(f(e) == depth + 1);
+    ENSURE(p.m_calls == 2 * (depth + 1));
+}
+
+static void tst_shared() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    // a DAG where every node has two references to its child
+    expr_ref e(m.mk_const(symbol("p"), m.mk_bool_sort()), m);
+    for (unsigned i = 0; i < 20; ++i)
+        e = m.mk_and(e, e);
+    tree_size_proc p;
+    expr_fold<unsigned, tree_size_proc> f(p);
+    ENSURE(f(e) == (1u << 21) - 1);
+    ENSURE(p.m_calls == 21);
+}
+
+static void tst_parallel() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    sort_ref b(m.mk_bool_sort(), m);
+    expr_ref_vector leaves(m), roots(m);
+    for (unsigned i = 0; i < 5000; ++i)
+        leaves.push_back(m.mk_const(symbol(i), b));
+    for (unsigned i = 0; i < 3000; ++i) {
+        expr_ref r(leaves.get(i), m);
+        for (unsigned j = 1; j < 8; ++j)
+            r = m.mk_or(r, m.mk_not(leaves.get((i * 7 + j * 13) % leaves.size())));
+        roots.push_back(r);
+    }
+    roots.push_back(m.mk_and(roots.size(), roots.c_ptr()));
+    tree_size_proc p1;
+    pure_size_proc p2;
+    expr_fold<unsigned, tree_size_proc> seq(p1);
+    expr_fold<unsigned, pure_size_proc> par(p2);
+    vector<unsigned> result;
+    // evaluate some expressions first so that the parallel evaluation mixes cached values
+    par(roots.get(7));
+    par.fold_parallel(roots.size(), roots.c_ptr(), result, 4);
+    ENSURE(result.size() == roots.size());
+    for (unsigned i = 0; i < roots.size(); ++i)
+        ENSURE(result[i] == seq(roots.get(i)));
+}
+
+void tst_expr_fold() {
+    tst_deep();
+    tst_shared();
+    tst_parallel();
+}
@@ -134,6 +134,38 @@ static void tst2() {
     ENSURE(h.check_invariant());
 }
 
+typedef heap<lt_proc2, 4> int_heap4;
+
+static void tst3() {
+    // 4-ary heap with batches of decreased keys.
+    int_heap4 h(N);
+    int_vector vals;
+    for (int i = 0; i < N; i++) {
+        if (heap_rand() % 2 == 0) 
+            h.insert(i);
+    }
+    ENSURE(h.check_invariant());
+    for (unsigned round = 0; round < 20; ++round) {
+        vals.reset();
+        unsigned n = round % 2 == 0 ? 5 : N / 4;
+        for (unsigned j = 0; j < n; ++j) {
+            int val = heap_rand() % N;
+            if (h.contains(val) && !vals.contains(val)) {
+                g_value[val] -= heap_rand();
+                vals.push_back(val);
+            }
+        }
+        h.decreased(vals.size(), vals.c_ptr());
+        ENSURE(h.check_invariant());
+    }
+    int prev = INT_MIN;
+    while (!h.empty()) {
+        int v = h.erase_min();
+        ENSURE(prev <= g_value[v]);
+        prev = g_value[v];
+    }
+}
+
 void tst_heap() {
     // enable_debug("heap");
     enable_trace("heap");
@@ -144,6 +176,8 @@ void tst_heap() {
         tst1();
         init_values();
         tst2();
+        init_values();
+        tst3();
     }
 }
 
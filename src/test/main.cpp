@@ -196,17 +196,23 @@ int main(int argc, char ** argv) {
     TST(escaped);
     TST(buffer);
     TST(chashtable);
+    TST(swiss_table);
+    TST(obj_dense_map);
     TST(ex);
     TST(nlarith_util);
     TST(api_bug);
     TST(arith_rewriter);
     TST(check_assumptions);
     TST(smt_context);
+    TST(smt_congruence);
+    TST(smt_ematching);
+    TST(smt_parallel_ematching);
     TST(theory_dl);
     TST(model_retrieval);
     TST(model_based_opt);
     TST(factor_rewriter);
     TST(smt2print_parse);
+    TST(smt2parse_throughput);
     TST(substitution);
     TST(polynomial);
     TST(upolynomial);
@@ -242,10 +248,12 @@ int main(int argc, char ** argv) {
     TST(polynorm);
     TST(qe_arith);
     TST(expr_substitution);
+    TST(expr_fold);
     TST(sorting_network);
     TST(theory_pb);
     TST(simplex);
     TST(sat_user_scope);
+    TST(sat_symmetry);
     TST_ARGV(ddnf);
     TST(ddnf1);
     TST(model_evaluator);
@@ -258,6 +266,9 @@ int main(int argc, char ** argv) {
     TST(pdd);
     TST(pdd_solver);
     TST(solver_pool);
+    TST(term_graph);
     //TST_ARGV(hs);
     TST(finder);
+    TST(zstring);
+    TST(char_set);
 }
@@ -1,6 +1,7 @@
 #include "math/simplex/model_based_opt.h"
 #include "util/util.h"
 #include "util/uint_set.h"
+#include <sstream>
 
 typedef opt::model_based_opt::var var;
 
@@ -391,6 +392,42 @@ static void test11() {
 
 }
 
+// projections on a reset instance agree with projections on fresh instances
+static void test12() {
+    random_gen r(3);
+    opt::model_based_opt reused;
+    for (unsigned k = 0; k < 100; ++k) {
+        unsigned num_vars = 4 + k % 3, num_ineqs = 3 + k % 5;
+        svector<int> values;
+        for (unsigned i = 0; i < num_vars; ++i) {
+            values.push_back(r(6));
+        }
+        opt::model_based_opt fresh;
+        reused.reset();
+        for (opt::model_based_opt* mbo : { &fresh, &reused }) {
+            for (int v : values) {
+                mbo->add_var(rational(v));
+            }
+        }
+        unsigned seed = r();
+        random_gen r1(seed), r2(seed);
+        for (unsigned i = 0; i < num_ineqs; ++i) {
+            add_random_ineq(fresh, r1, values, 3, 6);
+            add_random_ineq(reused, r2, values, 3, 6);
+        }
+        unsigned xs[2] = { 0, 1 };
+        fresh.project(2, xs, false);
+        reused.project(2, xs, false);
+        vector<opt::model_based_opt::row> rows1, rows2;
+        fresh.get_live_rows(rows1);
+        reused.get_live_rows(rows2);
+        std::ostringstream out1, out2;
+        for (auto const& row : rows1) opt::model_based_opt::display(out1, row);
+        for (auto const& row : rows2) opt::model_based_opt::display(out2, row);
+        ENSURE(out1.str() == out2.str());
+    }
+}
+
 // test with mix of upper and lower bounds
 
 void tst_model_based_opt() {
@@ -406,4 +443,5 @@ void tst_model_based_opt() {
     test8();
     test9();
     test11();
+    test12();
 }
@@ -1,7 +1,9 @@
 #include "model/model.h"
 #include "model/model_evaluator.h"
+#include "model/model_compiled_evaluator.h"
 #include "model/model_pp.h"
 #include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
 #include "ast/reg_decl_plugins.h"
 #include "ast/ast_pp.h"
 
@@ -68,4 +70,74 @@ void tst_model_evaluator() {
         std::cout << e << " " << v << "\n";
     }
     
+
+    {
+        // compiled evaluation agrees with model_evaluator on bit-vectors
+        bv_util bv(m);
+        app_ref x(m.mk_const(symbol("x"), bv.mk_sort(8)), m);
+        app_ref y(m.mk_const(symbol("y"), bv.mk_sort(8)), m);
+        app_ref p(m.mk_const(symbol("p"), m.mk_bool_sort()), m);
+        expr_ref t(m);
+        t = m.mk_ite(m.mk_or(p, bv.mk_ule(x, y)), 
+                     bv.mk_bv_add(x, bv.mk_bv_mul(y, bv.mk_numeral(3, 8))), 
+                     bv.mk_concat(bv.mk_extract(3, 0, x), bv.mk_extract(7, 4, bv.mk_bv_sub(y, x))));
+        t = bv.mk_bv_ashr(t, bv.mk_extract(7, 0, bv.mk_concat(y, bv.mk_numeral(1, 8))));
+        e = m.mk_and(bv.mk_sle(t, x), m.mk_not(m.mk_eq(t, y)));
+        compiled_model_evaluator cev(m);
+        ENSURE(cev.compile(t));
+        compiled_model_evaluator cev2(m);
+        ENSURE(cev2.compile(e));
+        for (unsigned i = 0; i < 256; ++i) {
+            model mdl2(m);
+            mdl2.register_decl(x->get_decl(), bv.mk_numeral(i, 8));
+            mdl2.register_decl(y->get_decl(), bv.mk_numeral((i * 37) % 256, 8));
+            mdl2.register_decl(p->get_decl(), i % 3 == 0 ? m.mk_true() : m.mk_false());
+            model_evaluator ev(mdl2);
+            ev.set_model_completion(true);
+            ENSURE(cev(mdl2) == ev(t));
+            ENSURE(cev2(mdl2) == ev(e));
+        }
+    }
+
+    {
+        // entries of large function graphs are found through the index.
+        func_interp fg(m, 2);
+        for (unsigned i = 0; i < 200; ++i) {
+            expr * args[2] = { a.mk_int(i), i % 2 == 0 ? m.mk_true() : m.mk_false() };
+            ENSURE(fg.get_entry(args) == nullptr);
+            fg.insert_new_entry(args, a.mk_int(i % 7));
+        }
+        for (unsigned i = 0; i < 200; ++i) {
+            expr * args[2] = { a.mk_int(i), i % 2 == 0 ? m.mk_true() : m.mk_false() };
+            ENSURE(fg.get_entry(args) && fg.get_entry(args)->get_result() == a.mk_int(i % 7));
+            expr * other[2] = { a.mk_int(i), i % 2 == 0 ? m.mk_false() : m.mk_true() };
+            ENSURE(fg.get_entry(other) == nullptr);
+        }
+        fg.set_else(a.mk_int(0));
+        fg.compress();
+        ENSURE(fg.num_entries() < 200);
+        for (unsigned i = 0; i < 200; ++i) {
+            expr * args[2] = { a.mk_int(i), i % 2 == 0 ? m.mk_true() : m.mk_false() };
+            func_entry * fe = fg.get_entry(args);
+            ENSURE((fe == nullptr) == (i % 7 == 0));
+        }
+    }
+
+    {
+        // applications to unique values without an entry evaluate to the else value.
+        model mdl3(m);
+        func_decl_ref k(m.mk_func_decl(symbol("k"), sI, sI), m);
+        func_interp * ki = alloc(func_interp, m, 1);
+        for (unsigned i = 0; i < 100; ++i) {
+            expr * arg = a.mk_int(i);
+            ki->insert_new_entry(&arg, a.mk_int(i + 1));
+        }
+        ki->set_else(a.mk_int(-1));
+        ENSURE(ki->args_are_unique_values());
+        mdl3.register_decl(k, ki);
+        model_evaluator ev(mdl3);
+        ENSURE(ev(m.mk_app(k, a.mk_int(42))) == a.mk_int(43));
+        ENSURE(ev(m.mk_app(k, a.mk_int(420))) == a.mk_int(-1));
+        ENSURE(ev(m.mk_app(k, a.mk_add(a.mk_int(400), a.mk_int(20)))) == a.mk_int(-1));
+    }
 }
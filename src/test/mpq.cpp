@@ -159,7 +159,41 @@ static void tst_prev_power_2() {
     tst_prev_power_2((1ll << 60), 3, 58);
 }
 
+static void tst_small_fractions() {
+    unsynch_mpq_manager m;
+    scoped_mpq a(m), b(m), c(m), d(m);
+    m.set(a, 1, 2);
+    m.add(a, a, c);
+    ENSURE(m.is_one(c));
+    m.set(a, 5, 6);
+    m.set(b, -7, 10);
+    m.add(a, b, c);
+    ENSURE(m.eq(c, m.mk_q(2, 15)));
+    m.sub(c, b, c);
+    ENSURE(m.eq(c, a));
+    m.mul(a, b, c);
+    ENSURE(m.eq(c, m.mk_q(-7, 12)));
+    m.sub(a, a, c);
+    ENSURE(m.is_zero(c) && m.is_int(c));
+    // results leaving the small range
+    m.set(a, INT_MIN, INT_MAX);
+    m.mul(a, a, c);
+    m.set(d, "4611686018427387904/4611686014132420609");
+    ENSURE(m.eq(c, d));
+    m.set(a, INT_MIN, 1);
+    m.set(b, INT_MAX, 1);
+    m.sub(a, b, c);
+    m.set(d, "-4294967295");
+    ENSURE(m.eq(c, d));
+    m.set(a, INT_MAX, INT_MAX - 1);
+    m.set(b, INT_MIN, INT_MAX);
+    m.add(a, b, c);
+    m.set(d, "1/4611686011984936962");
+    ENSURE(m.eq(c, d));
+}
+
 void tst_mpq() {
+    tst_small_fractions();
     tst_prev_power_2();
     set_str_bug();
     bug2();
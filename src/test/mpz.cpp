@@ -494,6 +494,40 @@ static void tst5() {
     std::cout << "INT_MAX/4 -> " << m.log2(a) << "\n";
 }
 
+static void mk_random_digits(unsynch_mpz_manager & m, unsigned num_digits, mpz & r) {
+    m.set(r, rand());
+    for (unsigned i = 1; i < num_digits; i++) {
+        m.mul2k(r, 32);
+        m.add(r, mpz(rand()), r);
+    }
+}
+
+static void tst_big_mul() {
+    // large products, including unbalanced ones, agree with division and squaring.
+    unsynch_mpz_manager m;
+    scoped_mpz a(m), b(m), p(m), q(m), r(m), s(m), t(m);
+    unsigned sizes[] = { 1, 17, 31, 32, 33, 63, 64, 100, 257, 600 };
+    for (unsigned sa : sizes) {
+        for (unsigned sb : sizes) {
+            mk_random_digits(m, sa, a);
+            mk_random_digits(m, sb, b);
+            m.mul(a, b, p);
+            m.machine_div_rem(p, b, q, r);
+            ENSURE(m.eq(q, a));
+            ENSURE(m.is_zero(r));
+            // (a + b)^2 = a^2 + 2ab + b^2
+            m.add(a, b, s);
+            m.mul(s, s, s);
+            m.mul(a, a, t);
+            m.add(t, p, t);
+            m.add(t, p, t);
+            m.mul(b, b, q);
+            m.add(t, q, t);
+            ENSURE(m.eq(s, t));
+        }
+    }
+}
+
 static void tst_pw2() {
     unsynch_mpz_manager m;
     scoped_mpz a(m);
@@ -507,6 +541,7 @@ void tst_mpz() {
     disable_trace("mpz");
     enable_trace("mpz_2k");
     tst_pw2();
+    tst_big_mul();
     tst5();
     tst_div2k_bug();
     rand_tst_gcd(50, 3, 2);
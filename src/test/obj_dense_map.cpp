@@ -0,0 +1,81 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    obj_dense_map.cpp
+
+Abstract:
+
+    Test id indexed maps.
+
+--*/
+#include "util/obj_dense_map.h"
+#include "util/map.h"
+#include "util/util.h"
+#include "util/vector.h"
+
+struct dense_obj {
+    unsigned m_id;
+    unsigned get_id() const { return m_id; }
+};
+
+typedef obj_dense_map<dense_obj, unsigned> dense_map;
+
+static void tst1() {
+    dense_obj a = { 1 }, b = { 7 }, c = { 100000 };
+    dense_map m;
+    ENSURE(m.empty());
+    m.insert(&a, 10);
+    m.insert(&b, 20);
+    m.insert(&c, 30);
+    ENSURE(m.size() == 3);
+    unsigned v = 0;
+    ENSURE(m.find(&b, v) && v == 20);
+    ENSURE(m.find(&c) == 30);
+    m.insert_if_not_there(&a, 0)++;
+    ENSURE(m.find(&a) == 11);
+    ENSURE(m.size() == 3);
+    m.reset();
+    ENSURE(m.empty());
+    ENSURE(!m.contains(&a) && !m.contains(&c));
+    ENSURE(m.get(&b, 5) == 5);
+    m.insert(&b, 1);
+    ENSURE(m.contains(&b) && !m.contains(&a));
+    ENSURE(m.keys().size() == 1 && m.keys()[0] == &b);
+}
+
+static void tst2(unsigned n, unsigned max_id) {
+    svector<dense_obj> objs;
+    for (unsigned i = 0; i < max_id; ++i)
+        objs.push_back(dense_obj { i });
+    unsigned_vector ids;
+    for (unsigned i = 0; i < n; ++i)
+        ids.push_back(rand() % max_id);
+    dense_map m;
+    u_map<unsigned> ref;
+    for (unsigned round = 0; round < 5; ++round) {
+        for (unsigned i = 0; i < n; ++i) {
+            unsigned id = ids[(i * 7 + round) % n];
+            m.insert_if_not_there(&objs[id], 0) += i;
+            ref.insert_if_not_there(id, 0) += i;
+            ENSURE(m.size() == ref.size());
+        }
+        for (unsigned id = 0; id < max_id; ++id) {
+            unsigned v = 0;
+            ENSURE(m.find(&objs[id], v) == ref.find(id, v));
+            ENSURE(!ref.contains(id) || m.find(&objs[id]) == ref.find(id));
+        }
+        for (dense_obj* o : m.keys())
+            ENSURE(ref.contains(o->get_id()));
+        m.reset();
+        ref.reset();
+    }
+}
+
+void tst_obj_dense_map() {
+    tst1();
+    tst2(100, 100);
+    tst2(100, 100000);
+    tst2(5000, 20000);
+}
@@ -170,6 +170,12 @@ namespace dd {
             pdd v3 = p.mk_var(id2var[b->get_id()]);
             q = v1 - (v2 ^ v3);
         }
+        else if (m.is_true(e)) {
+            q = v1 - 1;
+        }
+        else if (m.is_false(e)) {
+            q = v1;
+        }
         else if (is_uninterp_const(e)) {
             return;
         }
@@ -252,9 +258,41 @@ namespace dd {
         test_simplify(fmls, false);
         
     }
+
+    static void saturate_eqs(pdd_manager& m, unsigned threads, vector<pdd>& result) {
+        reslimit lim;
+        solver gb(lim, m);
+        solver::config cfg;
+        cfg.m_max_steps = 10;
+        cfg.m_threads = threads;
+        gb.set(cfg);
+        for (unsigned i = 0; i < 64; ++i) {
+            pdd x = m.mk_var(i), y = m.mk_var((2 * i + 1) % 64), z = m.mk_var((3 * i + 2) % 64);
+            gb.add(x * y + z);
+        }
+        gb.adjust_cfg();
+        gb.saturate();
+        for (solver::equation* e : gb.equations())
+            result.push_back(e->poly());
+    }
+
+    /**
+       parallel reduction of the equations to simplify gives the same basis.
+    */
+    void test3() {
+        pdd_manager m(64, pdd_manager::mod2_e);
+        vector<pdd> seq, par;
+        saturate_eqs(m, 1, seq);
+        saturate_eqs(m, 4, par);
+        std::cout << "equations: " << seq.size() << "\n";
+        VERIFY(seq.size() == par.size());
+        for (unsigned i = 0; i < seq.size(); ++i)
+            VERIFY(seq[i] == par[i]);
+    }
 }
 
 void tst_pdd_solver() {
     dd::test1();
     dd::test2();
+    dd::test3();
 }
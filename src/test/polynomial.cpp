@@ -1421,6 +1421,47 @@ static void tst_mk_unique() {
     ENSURE(p.get() == q.get());
 }
 
+static unsigned get_stat(polynomial::cache const & c, char const * key) {
+    statistics st;
+    c.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); i++)
+        if (strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static void tst_psc_cache() {
+    std::cout << "\n----- psc chain cache -------\n";
+    reslimit rl;
+    polynomial::numeral_manager nm;
+    polynomial::manager m(rl, nm);
+    polynomial_ref x0(m);
+    polynomial_ref x1(m);
+    x0 = m.mk_polynomial(m.mk_var());
+    x1 = m.mk_polynomial(m.mk_var());
+    polynomial::cache c(m);
+    c.set_max_entries(1);
+    polynomial_ref p(m), q(m), r(m);
+    p = (x1^2) + x0*x1 - 1;
+    q = derivative(p, 1);
+    r = (x1^3) - x0;
+    polynomial_ref_vector S1(m), S2(m);
+    c.psc_chain(p, q, 1, S1);
+    q = derivative(p, 1);
+    c.psc_chain(p, q, 1, S2);
+    ENSURE(get_stat(c, "polynomial psc chain cache hits") == 1);
+    ENSURE(S1.size() == S2.size());
+    for (unsigned i = 0; i < S1.size(); i++)
+        ENSURE(m.eq(S1.get(i), S2.get(i)));
+    // the bound drops the first chain
+    c.psc_chain(p, r, 1, S2);
+    c.psc_chain(p, q, 1, S2);
+    ENSURE(get_stat(c, "polynomial psc chain cache hits") == 1);
+    ENSURE(get_stat(c, "polynomial psc chain cache misses") == 3);
+    for (unsigned i = 0; i < S1.size(); i++)
+        ENSURE(m.eq(S1.get(i), S2.get(i)));
+}
+
 struct dummy_del_eh : public polynomial::manager::del_eh {
     unsigned m_counter;
     dummy_del_eh():m_counter(0) {}
@@ -1822,6 +1863,7 @@ void tst_polynomial() {
     // enable_trace("eval_bug");
     // enable_trace("mgcd");
     tst_psc();
+    tst_psc_cache();
     return;
     tst_eval();
     tst_divides();
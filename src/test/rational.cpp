@@ -454,6 +454,19 @@ static void tst11(bool use_ints) {
 }
 
 
+static void tst12() {
+    // get_bit agrees with division by powers of two.
+    rational vals[] = { rational(0), rational(1), rational(5), rational(INT_MAX), rational("4294967296"),
+                        rational("340282366920938463463374607431768211455"), rational("1234567890123456789012345678901234567890") };
+    for (rational const & v : vals) {
+        rational aux = v;
+        for (unsigned i = 0; i < 200; ++i) {
+            ENSURE(v.get_bit(i) == !(aux % rational(2)).is_zero());
+            aux = div(aux, rational(2));
+        }
+    }
+}
+
 void tst_rational() {
     TRACE("rational", tout << "starting rational test...\n";);
     std::cout << "sizeof(rational): " << sizeof(rational) << "\n";
@@ -478,4 +491,5 @@ void tst_rational() {
     tst11(true);
     tst10(true);
     tst10(false);
+    tst12();
 }
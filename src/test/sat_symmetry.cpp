@@ -0,0 +1,83 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "util/statistics.h"
+#include "util/util.h"
+
+static sat::literal lit(int v) {
+    return sat::literal(v < 0 ? -v : v, v < 0);
+}
+
+static void add_clause(sat::solver& s, int l1, int l2, int l3 = 0) {
+    sat::literal_vector c;
+    c.push_back(lit(l1));
+    c.push_back(lit(l2));
+    if (l3 != 0) c.push_back(lit(l3));
+    s.mk_clause(c.size(), c.c_ptr());
+}
+
+static unsigned num_breakers(sat::solver& s) {
+    statistics st;
+    s.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i) {
+        if (strcmp(st.get_key(i), "sat symmetry breakers") == 0)
+            return st.get_uint_value(i);
+    }
+    return 0;
+}
+
+// exactly one of x1, x2, x3, and optionally at least two of them.
+static void tst_exactly_one(bool at_least_two) {
+    params_ref p;
+    p.set_bool("symmetry", true);
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i <= 3; ++i) s.mk_var();
+    add_clause(s, 1, 2, 3);
+    add_clause(s, -1, -2);
+    add_clause(s, -1, -3);
+    add_clause(s, -2, -3);
+    if (at_least_two) {
+        add_clause(s, 1, 2);
+        add_clause(s, 1, 3);
+        add_clause(s, 2, 3);
+    }
+    lbool r = s.check();
+    std::cout << r << " breakers: " << num_breakers(s) << "\n";
+    ENSURE(num_breakers(s) == 2);
+    if (at_least_two) {
+        ENSURE(r == l_false);
+        return;
+    }
+    ENSURE(r == l_true);
+    // x1 <= x2 <= x3
+    ENSURE(s.get_model()[1] == l_false);
+    ENSURE(s.get_model()[2] == l_false);
+    ENSURE(s.get_model()[3] == l_true);
+}
+
+// x1 and x2 are interchangeable, x3 is not.
+static void tst_asymmetric() {
+    params_ref p;
+    p.set_bool("symmetry", true);
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i <= 4; ++i) s.mk_var();
+    add_clause(s, 1, 2, 3);
+    add_clause(s, -1, 4);
+    add_clause(s, -2, 4);
+    add_clause(s, -3, -4);
+    lbool r = s.check();
+    std::cout << r << " breakers: " << num_breakers(s) << "\n";
+    ENSURE(r == l_true);
+    ENSURE(num_breakers(s) == 1);
+}
+
+void tst_sat_symmetry() {
+    tst_exactly_one(false);
+    tst_exactly_one(true);
+    tst_asymmetric();
+}
@@ -8,7 +8,10 @@ Copyright (c) 2015 Microsoft Corporation
 // for SMT-LIB2.
 
 #include "api/z3.h"
+#include "util/stopwatch.h"
 #include <iostream>
+#include <sstream>
+#include <string>
 
 void test_print(Z3_context ctx, Z3_ast_vector av) {
     Z3_set_ast_print_mode(ctx, Z3_PRINT_SMTLIB2_COMPLIANT);
@@ -129,3 +132,33 @@ void tst_smt2print_parse() {
     // Test ?     
 
 }
+
+// Measure parsing throughput on a generated benchmark with many
+// repeated identifiers.
+void tst_smt2parse_throughput() {
+    unsigned const num_vars = 1000;
+    unsigned const num_asserts = 20000;
+    std::stringstream strm;
+    for (unsigned i = 0; i < num_vars; ++i) 
+        strm << "(declare-const x" << i << " Int)\n";
+    for (unsigned i = 0; i < num_asserts; ++i) {
+        unsigned a = i % num_vars, b = (7*i + 3) % num_vars, c = (13*i + 5) % num_vars;
+        strm << "(assert (or (< (+ x" << a << " x" << b << ") " << i << ") (= x" << c << " (* 2 x" << a << "))))\n";
+    }
+    std::string spec = strm.str();
+
+    Z3_context ctx = Z3_mk_context(nullptr);
+    stopwatch sw;
+    sw.start();
+    Z3_ast_vector av = Z3_parse_smtlib2_string(ctx, spec.c_str(), 0, nullptr, nullptr, 0, nullptr, nullptr);
+    Z3_ast_vector_inc_ref(ctx, av);
+    sw.stop();
+    ENSURE(Z3_ast_vector_size(ctx, av) == num_asserts);
+    double mb = spec.size() / (1024.0 * 1024.0);
+    std::cout << "parsed " << mb << " MB in " << sw.get_seconds() << " secs";
+    if (sw.get_seconds() > 0)
+        std::cout << " (" << mb / sw.get_seconds() << " MB/s)";
+    std::cout << "\n";
+    Z3_ast_vector_dec_ref(ctx, av);
+    Z3_del_context(ctx);
+}
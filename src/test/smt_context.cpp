@@ -6,6 +6,7 @@ Copyright (c) 2015 Microsoft Corporation
 
 #include "smt/smt_context.h"
 #include "ast/reg_decl_plugins.h"
+#include "util/stopwatch.h"
 
 void tst_smt_context()
 {
@@ -33,3 +34,127 @@ void tst_smt_context()
 
     ctx.check();
 }
+
+// Large equivalence classes with many congruent parents.
+void tst_smt_congruence()
+{
+    smt_params params;
+    params.m_model = false;
+
+    ast_manager m;
+    reg_decl_plugins(m);
+
+    unsigned const n = 2000;
+    sort_ref s(m.mk_uninterpreted_sort(symbol("S")), m);
+    sort * ss[2] = { s.get(), s.get() };
+    func_decl_ref f(m.mk_func_decl(symbol("f"), s, s), m);
+    func_decl_ref g(m.mk_func_decl(symbol("g"), 2, ss, s), m);
+    expr_ref_vector xs(m), fs(m);
+    for (unsigned i = 0; i < n; ++i) {
+        xs.push_back(m.mk_fresh_const("x", s));
+        fs.push_back(m.mk_app(f, xs.get(i)));
+    }
+
+    smt::context ctx(m, params);
+    for (unsigned i = 0; i < n; ++i) {
+        for (unsigned k = 1; k <= 4; ++k) {
+            expr * y = xs.get((i * k + 7) % n);
+            ctx.assert_expr(m.mk_not(m.mk_eq(m.mk_app(g, xs.get(i), y), m.mk_app(g, y, fs.get(i)))));
+        }
+    }
+    for (unsigned i = 0; i + 1 < n; ++i) 
+        ctx.assert_expr(m.mk_or(m.mk_eq(xs.get(i), xs.get(i + 1)), m.mk_eq(fs.get(i), fs.get(i + 1))));
+    ctx.assert_expr(m.mk_not(m.mk_eq(fs.get(0), fs.get(n - 1))));
+
+    stopwatch sw;
+    sw.start();
+    lbool r = ctx.check();
+    sw.stop();
+    std::cout << "congruence: " << r << " in " << sw.get_seconds() << " secs, " << ctx.m_stats.m_num_add_eq << " merges\n";
+    ENSURE(r == l_false);
+}
+
+// E-matching of a single pattern against many ground terms.
+void tst_smt_ematching()
+{
+    smt_params params;
+    params.m_model = false;
+
+    ast_manager m;
+    reg_decl_plugins(m);
+
+    unsigned const n = 2000;
+    sort_ref s(m.mk_uninterpreted_sort(symbol("S")), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), s, s), m);
+    func_decl_ref g(m.mk_func_decl(symbol("g"), s, s), m);
+
+    // forall x. f(g(x)) = x with pattern g(x)
+    expr_ref x(m.mk_var(0, s), m);
+    app_ref gx(m.mk_app(g, x.get()), m);
+    expr_ref body(m.mk_eq(m.mk_app(f, gx.get()), x), m);
+    app_ref pat(m.mk_pattern(gx), m);
+    expr * pats[1] = { pat.get() };
+    sort * ss[1] = { s.get() };
+    symbol names[1] = { symbol("x") };
+    expr_ref q(m.mk_forall(1, ss, names, body, 0, symbol("inj"), symbol::null, 1, pats), m);
+
+    expr_ref_vector cs(m);
+    for (unsigned i = 0; i < n; ++i) 
+        cs.push_back(m.mk_fresh_const("c", s));
+
+    smt::context ctx(m, params);
+    ctx.assert_expr(q);
+    for (unsigned i = 0; i + 1 < n; ++i) 
+        ctx.assert_expr(m.mk_eq(m.mk_app(g, cs.get(i)), m.mk_app(g, cs.get(i + 1))));
+    ctx.assert_expr(m.mk_not(m.mk_eq(cs.get(0), cs.get(n - 1))));
+
+    stopwatch sw;
+    sw.start();
+    lbool r = ctx.check();
+    sw.stop();
+    std::cout << "ematching: " << r << " in " << sw.get_seconds() << " secs\n";
+    ENSURE(r == l_false);
+}
+
+static lbool check_two_patterns(unsigned num_threads, unsigned n) {
+    smt_params params;
+    params.m_model = false;
+    params.m_qi_match_threads = num_threads;
+
+    ast_manager m;
+    reg_decl_plugins(m);
+
+    sort_ref s(m.mk_uninterpreted_sort(symbol("S")), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), s, s), m);
+    func_decl_ref g(m.mk_func_decl(symbol("g"), s, s), m);
+    func_decl_ref h(m.mk_func_decl(symbol("h"), s, s), m);
+    expr_ref x(m.mk_var(0, s), m);
+    sort * ss[1] = { s.get() };
+    symbol names[1] = { symbol("x") };
+
+    // forall x. f(g(x)) = x and forall x. f(h(x)) = x
+    smt::context ctx(m, params);
+    func_decl * fns[2] = { g.get(), h.get() };
+    for (func_decl * fn : fns) {
+        app_ref t(m.mk_app(fn, x.get()), m);
+        app_ref pat(m.mk_pattern(t), m);
+        expr * pats[1] = { pat.get() };
+        expr_ref body(m.mk_eq(m.mk_app(f, t.get()), x), m);
+        ctx.assert_expr(m.mk_forall(1, ss, names, body, 0, fn->get_name(), symbol::null, 1, pats));
+    }
+
+    expr_ref_vector cs(m);
+    for (unsigned i = 0; i < n; ++i)
+        cs.push_back(m.mk_fresh_const("c", s));
+    for (unsigned i = 0; i + 1 < n; ++i) {
+        ctx.assert_expr(m.mk_eq(m.mk_app(g, cs.get(i)), m.mk_app(h, cs.get(i + 1))));
+    }
+    ctx.assert_expr(m.mk_not(m.mk_eq(cs.get(0), cs.get(n - 1))));
+    return ctx.check();
+}
+
+void tst_smt_parallel_ematching()
+{
+    ENSURE(check_two_patterns(1, 1000) == l_false);
+    ENSURE(check_two_patterns(4, 1000) == l_false);
+}
@@ -0,0 +1,128 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    swiss_table.cpp
+
+Abstract:
+
+    Test open addressing hashtable with control bytes.
+
+--*/
+#include "util/swiss_table.h"
+#include "util/hashtable.h"
+#include "util/map.h"
+#include "util/util.h"
+
+typedef u_swiss_map<unsigned> u_table;
+
+static void tst1() {
+    u_table t;
+    ENSURE(t.empty());
+    t.insert(10, 1);
+    t.insert(20, 2);
+    t.insert(30, 3);
+    ENSURE(t.size() == 3);
+    unsigned v = 0;
+    ENSURE(t.find(20, v) && v == 2);
+    t.insert(20, 4);
+    ENSURE(t.size() == 3);
+    ENSURE(t.find(20, v) && v == 4);
+    t.erase(20);
+    ENSURE(!t.contains(20));
+    ENSURE(t.size() == 2);
+    ENSURE(t.get(20, 7) == 7);
+    t[20] = 5;
+    ENSURE(t.find(20) == 5);
+    unsigned sum = 0;
+    for (auto const& kv : t)
+        sum += kv.m_value;
+    ENSURE(sum == 9);
+}
+
+// all keys collide, so probes run over several groups
+struct collide_hash {
+    unsigned operator()(unsigned v) const { return v % 3; }
+};
+
+// compare with u_map on random inserts and erasures
+template<typename HashProc>
+static void tst2(unsigned num_ops, unsigned max_key) {
+    swiss_map<unsigned, unsigned, HashProc, u_eq> t;
+    u_map<unsigned> ref;
+    random_gen r(0);
+    for (unsigned i = 0; i < num_ops; ++i) {
+        unsigned k = r() % max_key;
+        switch (r() % 4) {
+        case 0:
+        case 1:
+            t.insert(k, i);
+            ref.insert(k, i);
+            break;
+        case 2:
+            t.erase(k);
+            ref.erase(k);
+            break;
+        default: {
+            unsigned v1 = 0, v2 = 0;
+            bool f1 = t.find(k, v1);
+            bool f2 = ref.find(k, v2);
+            ENSURE(f1 == f2);
+            ENSURE(!f1 || v1 == v2);
+            break;
+        }
+        }
+        ENSURE(t.size() == ref.size());
+    }
+    unsigned n = 0;
+    for (auto const& kv : t) {
+        unsigned v = 0;
+        ENSURE(ref.find(kv.m_key, v) && v == kv.m_value);
+        ++n;
+    }
+    ENSURE(n == ref.size());
+    swiss_map<unsigned, unsigned, HashProc, u_eq> copy;
+    copy = t;
+    ENSURE(copy.size() == t.size());
+    t.reset();
+    ENSURE(t.empty() && t.begin() == t.end());
+    for (auto const& kv : ref)
+        ENSURE(copy.contains(kv.m_key));
+}
+
+namespace {
+    struct node {
+        unsigned m_id;
+        unsigned hash() const { return m_id; }
+    };
+};
+
+static void tst3() {
+    svector<node> nodes;
+    for (unsigned i = 0; i < 1000; ++i)
+        nodes.push_back({ i });
+    obj_swiss_map<node, unsigned> m;
+    for (unsigned i = 0; i < nodes.size(); ++i)
+        m.insert(&nodes[i], i);
+    for (unsigned i = 0; i < nodes.size(); i += 2)
+        m.remove(&nodes[i]);
+    ENSURE(m.size() == 500);
+    for (unsigned i = 0; i < nodes.size(); ++i) {
+        auto * e = m.find_core(&nodes[i]);
+        ENSURE((e != nullptr) == (i % 2 == 1));
+        ENSURE(!e || e->get_data().m_value == i);
+    }
+    auto& e = m.insert_if_not_there(&nodes[1], 0);
+    ENSURE(e.m_value == 1);
+    m.finalize();
+    ENSURE(m.empty() && m.capacity() == 0);
+}
+
+void tst_swiss_table() {
+    tst1();
+    tst2<u_hash>(100000, 1000);
+    tst2<u_hash>(100000, 100000);
+    tst2<collide_hash>(20000, 200);
+    tst3();
+}
@@ -0,0 +1,61 @@
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/ast_pp.h"
+#include "qe/qe_term_graph.h"
+
+static expr_ref to_expr_scoped(qe::term_graph& tg) {
+    tg.push();
+    expr_ref r = tg.to_expr();
+    tg.pop(1);
+    return r;
+}
+
+void tst_term_graph() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort* I = a.mk_int();
+    func_decl_ref f(m.mk_func_decl(symbol("f"), I, I), m);
+    expr_ref x(m.mk_const(symbol("x"), I), m);
+    expr_ref y(m.mk_const(symbol("y"), I), m);
+    expr_ref u(m.mk_const(symbol("u"), I), m);
+    expr_ref v(m.mk_const(symbol("v"), I), m);
+    expr_ref fx(m.mk_app(f, x.get()), m);
+    expr_ref fy(m.mk_app(f, y.get()), m);
+    expr_ref fu(m.mk_app(f, u.get()), m);
+
+    expr_ref_vector base(m);
+    base.push_back(m.mk_eq(fx, u));
+    base.push_back(m.mk_eq(fy, v));
+
+    qe::term_graph fresh(m);
+    fresh.add_lits(base);
+    expr_ref expected = to_expr_scoped(fresh);
+
+    qe::term_graph tg(m);
+    tg.add_lits(base);
+    for (unsigned i = 0; i < 3; ++i) {
+        tg.push();
+        tg.add_eq(x, y);
+        tg.add_lit(m.mk_eq(fu, x));
+        expr_ref r = tg.to_expr();
+        std::cout << r << "\n";
+        tg.pop(1);
+        ENSURE(tg.get_num_scopes() == 0);
+        expr_ref after = to_expr_scoped(tg);
+        std::cout << after << "\n";
+        ENSURE(after == expected);
+    }
+
+    // nested scopes
+    tg.push();
+    tg.add_eq(x, y);
+    expr_ref level1 = to_expr_scoped(tg);
+    tg.push();
+    tg.add_eq(u, x);
+    tg.add_lit(m.mk_eq(fu, v));
+    tg.pop(1);
+    ENSURE(to_expr_scoped(tg) == level1);
+    tg.pop(1);
+    ENSURE(to_expr_scoped(tg) == expected);
+}
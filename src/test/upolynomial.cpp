@@ -355,6 +355,73 @@ static void tst_gcd() {
 
 }
 
+static void tst_mod_gcd(polynomial_ref const & p, polynomial_ref const & q, polynomial_ref const & expected, upolynomial::manager & um) {
+    upolynomial::scoped_numeral_vector _p(um), _q(um), _r(um), _e(um);
+    um.to_numeral_vector(p, _p);
+    um.to_numeral_vector(q, _q);
+    um.to_numeral_vector(expected, _e);
+    um.gcd(_p.size(), _p.c_ptr(), _q.size(), _q.c_ptr(), _r);
+    std::cout << "gcd: "; um.display(std::cout, _r); std::cout << "\n";
+    ENSURE(um.eq(_r, _e));
+    um.euclid_gcd(_p.size(), _p.c_ptr(), _q.size(), _q.c_ptr(), _r);
+    ENSURE(um.eq(_r, _e));
+}
+
+static void tst_eval_sign_at_bq() {
+    std::cout << "\n\nTesting eval_sign_at\n";
+    reslimit rl;
+    polynomial::numeral_manager nm;
+    polynomial::manager m(rl, nm);
+    polynomial_ref x(m);
+    x = m.mk_polynomial(m.mk_var());
+    polynomial_ref p(m);
+    upolynomial::manager um(rl, nm);
+    upolynomial::scoped_numeral_vector _p(um);
+    mpbq_manager bqm(nm);
+    scoped_mpbq b(bqm);
+
+    p = ((1024*x - 1)^3)*((x^2) - 2);
+    um.to_numeral_vector(p, _p);
+    // points far from the roots are decided using floating point arithmetic
+    for (int i = -2000; i <= 2000; i++) {
+        bqm.set(b, i, 10);
+        ENSURE(um.eval_sign_at(_p.size(), _p.c_ptr(), b) == um.eval_sign_at_exact(_p.size(), _p.c_ptr(), b));
+    }
+    // points close to the root 1/1024
+    for (int64_t d = -64; d <= 64; d++) {
+        bqm.set(b, (static_cast<int64_t>(1) << 40) + d, 50);
+        ::sign s = um.eval_sign_at(_p.size(), _p.c_ptr(), b);
+        ENSURE(s == (d < 0 ? sign_pos : d == 0 ? sign_zero : sign_neg));
+    }
+}
+
+static void tst_mod_gcd() {
+    std::cout << "\n\nTesting modular GCD\n";
+    reslimit rl;
+    polynomial::numeral_manager nm;
+    polynomial::manager m(rl, nm);
+    polynomial_ref x(m);
+    x = m.mk_polynomial(m.mk_var());
+    polynomial_ref g(m), p(m), q(m);
+    upolynomial::manager um(rl, nm);
+
+    g = ((x^2) + 1)*(3*(x^3) - 2*x + 5);
+    p = g*((x - 7)^20)*(2*x + 3);
+    q = 6*g*((x + 7)^15)*((x^4) - 11);
+    tst_mod_gcd(p, q, g, um);
+
+    // large coefficients, reconstructed from several primes
+    g = 123456789*(x^5) - 987654321*(x^2) + 1000000007;
+    p = g*((3*x - 100000)^6);
+    q = g*((x^7) - 2*(x^3) + 99999989);
+    tst_mod_gcd(p, q, g, um);
+
+    p = (x^9) + 2*x - 1;
+    q = (x^8) - 3;
+    g = m.mk_const(rational(1));
+    tst_mod_gcd(p, q, g, um);
+}
+
 static void tst_zp() {
     std::cout << "\n\nTesting Z_p\n";
     reslimit rl;
@@ -1066,6 +1133,8 @@ void tst_upolynomial() {
     // enable_trace("mpzp_inv_bug");
     // enable_trace("mpz");
     tst_gcd();
+    tst_mod_gcd();
+    tst_eval_sign_at_bq();
     tst_lower_bound();
     tst_fact();
     tst_rem();
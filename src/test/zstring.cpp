@@ -0,0 +1,57 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    zstring.cpp
+
+Abstract:
+
+    Test strings with narrow and wide characters.
+
+--*/
+#include "ast/seq_decl_plugin.h"
+#include "util/debug.h"
+
+static void tst_narrow() {
+    zstring a("hello"), b(" world");
+    zstring c = a + b;
+    ENSURE(c.length() == 11);
+    ENSURE(c == zstring("hello world"));
+    ENSURE(c.extract(6, 5) == zstring("world"));
+    ENSURE(c.extract(6, 100) == zstring("world"));
+    ENSURE(c.extract(20, 2).empty());
+    ENSURE(a.prefixof(c));
+    ENSURE(b.suffixof(c));
+    ENSURE(c.contains(zstring("o w")));
+    ENSURE(c.indexofu(zstring("o"), 5) == 7);
+    ENSURE(c.last_indexof(zstring("o")) == 7);
+    ENSURE(c.replace(zstring("o"), zstring("0")) == zstring("hell0 world"));
+    a += 'x';
+    ENSURE(a == zstring("hellox"));
+}
+
+static void tst_wide() {
+    unsigned chs[3] = { 'a', 1000, 'b' };
+    zstring w(3, chs);
+    ENSURE(w.length() == 3);
+    ENSURE(w[1] == 1000);
+    zstring a("a");
+    ENSURE(a.prefixof(w));
+    // appending a wide string to a narrow string and back
+    zstring c = zstring("xy") + w;
+    ENSURE(c.length() == 5);
+    ENSURE(c[0] == 'x' && c[3] == 1000);
+    ENSURE(c.extract(2, 3) == w);
+    ENSURE(c != zstring("xyaab"));
+    c += zstring("zz");
+    ENSURE(c.length() == 7 && c[6] == 'z');
+    ENSURE(c.encode() == "xya\\u{3e8}bzz");
+    zstring d = w.replace(zstring(1000u), zstring("--"));
+    ENSURE(d == zstring("a--b"));
+}
+
+void tst_zstring() {
+    tst_narrow();
+    tst_wide();
+}
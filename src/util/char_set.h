@@ -0,0 +1,134 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    char_set.h
+
+Abstract:
+
+    Sets of characters represented by intervals.
+
+    A set is a sorted vector of disjoint intervals [lo, hi] where
+    consecutive intervals are separated by at least one character, so
+    every set has exactly one representation and equality is a
+    comparison of the vectors. Union and intersection are linear merges,
+    complement is taken with respect to [0, max_char].
+
+--*/
+#pragma once
+
+#include <iostream>
+#include "util/vector.h"
+
+class char_set {
+public:
+    typedef std::pair<unsigned, unsigned> range;
+private:
+    svector<range> m_ranges;
+
+    void push(unsigned lo, unsigned hi) {
+        if (!m_ranges.empty() && m_ranges.back().second + 1 >= lo)
+            m_ranges.back().second = std::max(m_ranges.back().second, hi);
+        else
+            m_ranges.push_back(range(lo, hi));
+    }
+
+public:
+    char_set() {}
+
+    char_set(unsigned lo, unsigned hi) { if (lo <= hi) m_ranges.push_back(range(lo, hi)); }
+
+    bool empty() const { return m_ranges.empty(); }
+
+    bool is_full(unsigned max_char) const {
+        return m_ranges.size() == 1 && m_ranges[0].first == 0 && m_ranges[0].second >= max_char;
+    }
+
+    /**
+       \brief the set is the singleton {ch}.
+    */
+    bool is_char(unsigned& ch) const {
+        if (m_ranges.size() != 1 || m_ranges[0].first != m_ranges[0].second)
+            return false;
+        ch = m_ranges[0].first;
+        return true;
+    }
+
+    bool contains(unsigned ch) const {
+        unsigned lo = 0, hi = m_ranges.size();
+        while (lo < hi) {
+            unsigned mid = lo + (hi - lo) / 2;
+            if (m_ranges[mid].second < ch)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo < m_ranges.size() && m_ranges[lo].first <= ch;
+    }
+
+    unsigned num_ranges() const { return m_ranges.size(); }
+    range const& operator[](unsigned i) const { return m_ranges[i]; }
+    range const* begin() const { return m_ranges.begin(); }
+    range const* end() const { return m_ranges.end(); }
+
+    char_set operator|(char_set const& other) const {
+        char_set result;
+        unsigned i = 0, j = 0;
+        while (i < m_ranges.size() || j < other.m_ranges.size()) {
+            range const& r = (j == other.m_ranges.size() || (i < m_ranges.size() && m_ranges[i].first <= other.m_ranges[j].first)) ?
+                m_ranges[i++] : other.m_ranges[j++];
+            result.push(r.first, r.second);
+        }
+        return result;
+    }
+
+    char_set operator&(char_set const& other) const {
+        char_set result;
+        unsigned i = 0, j = 0;
+        while (i < m_ranges.size() && j < other.m_ranges.size()) {
+            unsigned lo = std::max(m_ranges[i].first, other.m_ranges[j].first);
+            unsigned hi = std::min(m_ranges[i].second, other.m_ranges[j].second);
+            if (lo <= hi)
+                result.m_ranges.push_back(range(lo, hi));
+            if (m_ranges[i].second < other.m_ranges[j].second)
+                ++i;
+            else
+                ++j;
+        }
+        return result;
+    }
+
+    char_set complement(unsigned max_char) const {
+        char_set result;
+        unsigned lo = 0;
+        for (range const& r : m_ranges) {
+            if (r.first > max_char)
+                break;
+            if (lo < r.first)
+                result.m_ranges.push_back(range(lo, r.first - 1));
+            if (r.second >= max_char)
+                return result;
+            lo = r.second + 1;
+        }
+        result.m_ranges.push_back(range(lo, max_char));
+        return result;
+    }
+
+    bool operator==(char_set const& other) const { return m_ranges == other.m_ranges; }
+    bool operator!=(char_set const& other) const { return !(*this == other); }
+
+    std::ostream& display(std::ostream& out) const {
+        out << "{";
+        for (range const& r : m_ranges) {
+            if (&r != m_ranges.begin())
+                out << " ";
+            out << r.first;
+            if (r.first != r.second)
+                out << "-" << r.second;
+        }
+        return out << "}";
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& out, char_set const& s) { return s.display(out); }
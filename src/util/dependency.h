@@ -21,6 +21,7 @@ Revision History:
 
 #include "util/vector.h"
 #include "util/region.h"
+#include "util/hashtable.h"
 
 template<typename C>
 class dependency_manager {
@@ -68,9 +69,29 @@ private:
     static join * to_join(dependency * d) { SASSERT(!d->is_leaf()); return static_cast<join*>(d); }
     static leaf * to_leaf(dependency * d) { SASSERT(d->is_leaf()); return static_cast<leaf*>(d); }
 
+    struct join_hash_proc {
+        unsigned operator()(join const * j) const {
+            return hash_u_u(get_ptr_hash(j->m_children[0]), get_ptr_hash(j->m_children[1]));
+        }
+    };
+
+    struct join_eq_proc {
+        bool operator()(join const * j1, join const * j2) const {
+            return j1->m_children[0] == j2->m_children[0] && j1->m_children[1] == j2->m_children[1];
+        }
+    };
+
+    typedef ptr_hashtable<join, join_hash_proc, join_eq_proc> join_table;
+
     value_manager &         m_vmanager;
     allocator  &            m_allocator;
     ptr_vector<dependency>  m_todo;
+    // When C::hash_cons is set, joins are shared: a join of the same two
+    // dependencies is created only once, and the result of the last
+    // linearization is kept until its dependency is deleted.
+    join_table              m_joins;
+    dependency *            m_lin_dep;
+    vector<value, false>    m_lin_values;
 
     void inc_ref(value const & v) {
         if (C::ref_count)
@@ -88,12 +109,18 @@ private:
         while (!m_todo.empty()) {
             d = m_todo.back();
             m_todo.pop_back();
+            if (d == m_lin_dep) {
+                m_lin_dep = nullptr;
+                m_lin_values.reset();
+            }
             if (d->is_leaf()) {
                 dec_ref(to_leaf(d)->m_value);
                 to_leaf(d)->~leaf();
                 m_allocator.deallocate(sizeof(leaf), to_leaf(d));
             }
             else {
+                if (C::hash_cons)
+                    m_joins.remove(to_join(d));
                 for (unsigned i = 0; i < 2; i++) {
                     dependency * c = to_join(d)->m_children[i];
                     SASSERT(c->m_ref_count > 0);
@@ -120,7 +147,8 @@ public:
     
     dependency_manager(value_manager & m, allocator & a):
         m_vmanager(m),
-        m_allocator(a) {
+        m_allocator(a),
+        m_lin_dep(nullptr) {
     }
 
     void inc_ref(dependency * d) {
@@ -157,6 +185,17 @@ public:
         else if (d1 == d2) {
             return d1;
         }
+        else if (C::hash_cons) {
+            join key(d1, d2);
+            join * j = nullptr;
+            if (m_joins.find(&key, j))
+                return j;
+            void * mem = m_allocator.allocate(sizeof(join));
+            inc_ref(d1); inc_ref(d2);
+            j = new (mem) join(d1, d2);
+            m_joins.insert(j);
+            return j;
+        }
         else {
             void * mem = m_allocator.allocate(sizeof(join));
             inc_ref(d1); inc_ref(d2);
@@ -195,6 +234,12 @@ public:
     }
 
     void linearize(dependency * d, vector<value, false> & vs) {
+        if (C::hash_cons && d && d == m_lin_dep) {
+            vs.append(m_lin_values);
+            return;
+        }
+        dependency * root = d;
+        unsigned old_sz = vs.size();
         if (d) {
             m_todo.reset();
             d->mark();
@@ -217,6 +262,11 @@ public:
                 }
             }
             unmark_todo();
+            if (C::hash_cons && !root->is_leaf()) {
+                m_lin_dep = root;
+                m_lin_values.reset();
+                m_lin_values.append(vs.size() - old_sz, vs.c_ptr() + old_sz);
+            }
         }
     }
 };
@@ -234,6 +284,7 @@ class scoped_dependency_manager {
     class config {
     public:
         static const bool ref_count        = true;
+        static const bool hash_cons        = false;
 
         typedef Value value;
 
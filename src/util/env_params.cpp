@@ -21,6 +21,8 @@ Notes:
 #include "util/gparams.h"
 #include "util/util.h"
 #include "util/memory_manager.h"
+#include "util/thread_pool.h"
+#include "util/event_trace.h"
 
 void env_params::updt_params() {
     params_ref const& p = gparams::get_ref();
@@ -28,7 +30,9 @@ void env_params::updt_params() {
     enable_warning_messages(p.get_bool("warning", true));
     memory::set_max_size(megabytes_to_bytes(p.get_uint("memory_max_size", 0)));
     memory::set_max_alloc_count(p.get_uint("memory_max_alloc_count", 0));
-    memory::set_high_watermark(p.get_uint("memory_high_watermark", 0));
+    memory::set_high_watermark(megabytes_to_bytes(p.get_uint("memory_high_watermark", 0)));
+    thread_pool::set_max_workers(p.get_uint("thread_pool_size", 0));
+    event_trace::open(p.get_str("event_trace", ""));
 }
 
 void env_params::collect_param_descrs(param_descrs & d) {
@@ -36,5 +40,7 @@ void env_params::collect_param_descrs(param_descrs & d) {
     d.insert("warning", CPK_BOOL, "enable/disable warning messages", "true");
     d.insert("memory_max_size", CPK_UINT, "set hard upper limit for memory consumption (in megabytes), if 0 then there is no limit", "0");
     d.insert("memory_max_alloc_count", CPK_UINT, "set hard upper limit for memory allocations, if 0 then there is no limit", "0");
-    d.insert("memory_high_watermark", CPK_UINT, "set high watermark for memory consumption (in megabytes), if 0 then there is no limit", "0");
+    d.insert("memory_high_watermark", CPK_UINT, "set high watermark for memory consumption (in megabytes), above the watermark solvers release caches and inactive lemmas, if 0 then there is no limit", "0");
+    d.insert("event_trace", CPK_STRING, "file to which solver events (conflicts, restarts, clause deletion, tactics, quantifier instances) are written in JSON lines format, empty for none", "");
+    d.insert("thread_pool_size", CPK_UINT, "maximal number of worker threads kept alive for parallel solving, if 0 then the number of hardware threads is used", "0");
 }
@@ -0,0 +1,94 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    event_trace.cpp
+
+Abstract:
+
+    Process-wide stream of solver events in JSON lines format.
+
+--*/
+
+#include <chrono>
+#include <fstream>
+#include "util/event_trace.h"
+#include "util/mutex.h"
+#include "util/memory_manager.h"
+#include "util/warning.h"
+
+bool event_trace::s_enabled = false;
+
+static DECLARE_MUTEX(g_event_mux);
+static std::ofstream*                        g_event_out = nullptr;
+static std::string*                          g_event_file = nullptr;
+static std::chrono::steady_clock::time_point g_event_start;
+
+void event_trace::open(char const* file) {
+    lock_guard lock(*g_event_mux);
+    if (g_event_file && *g_event_file == file)
+        return;
+    s_enabled = false;
+    dealloc(g_event_out);
+    dealloc(g_event_file);
+    g_event_out = nullptr;
+    g_event_file = nullptr;
+    if (!file || !*file)
+        return;
+    g_event_out = alloc(std::ofstream, file);
+    if (g_event_out->fail()) {
+        dealloc(g_event_out);
+        g_event_out = nullptr;
+        warning_msg("could not open event trace file '%s'", file);
+        return;
+    }
+    g_event_file = alloc(std::string, file);
+    g_event_start = std::chrono::steady_clock::now();
+    s_enabled = true;
+}
+
+void event_trace::close() {
+    open("");
+}
+
+void event_trace::write(std::string const& line) {
+    lock_guard lock(*g_event_mux);
+    if (g_event_out)
+        *g_event_out << line;
+}
+
+event_trace::event::event(char const* name) {
+    auto d = std::chrono::steady_clock::now() - g_event_start;
+    m_out << "{\"ts\":" << std::chrono::duration_cast<std::chrono::microseconds>(d).count() << ",\"ev\":\"" << name << "\"";
+}
+
+event_trace::event::~event() {
+    m_out << "}\n";
+    write(m_out.str());
+}
+
+event_trace::event& event_trace::event::operator()(char const* k, char const* v) {
+    key(k);
+    m_out << "\"";
+    for (; *v; ++v) {
+        char c = *v;
+        if (c == '"' || c == '\\')
+            m_out << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            m_out << ' ';
+        else
+            m_out << c;
+    }
+    m_out << "\"";
+    return *this;
+}
+
+void initialize_event_trace() {
+    ALLOC_MUTEX(g_event_mux);
+}
+
+void finalize_event_trace() {
+    event_trace::close();
+    DEALLOC_MUTEX(g_event_mux);
+}
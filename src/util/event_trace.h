@@ -0,0 +1,60 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    event_trace.h
+
+Abstract:
+
+    Process-wide stream of solver events in JSON lines format.
+
+    The stream is enabled by setting the global parameter event_trace
+    to a file name. Each event is written as one JSON object holding a
+    timestamp "ts" in microseconds since the stream was opened, the
+    event name "ev" and the fields added by the caller:
+
+        if (event_trace::enabled())
+            event_trace::event("sat.restart")("conflicts", n);
+
+    Events are formatted by the caller and written under a lock, so
+    they can be emitted from several threads.
+
+--*/
+#pragma once
+
+#include <sstream>
+#include <string>
+
+class event_trace {
+    static bool s_enabled;
+    static void write(std::string const& line);
+public:
+    static bool enabled() { return s_enabled; }
+
+    /**
+       \brief write events to the given file, close the stream if file is empty.
+    */
+    static void open(char const* file);
+    static void close();
+
+    class event {
+        std::ostringstream m_out;
+        void key(char const* k) { m_out << ",\"" << k << "\":"; }
+    public:
+        event(char const* name);
+        ~event();
+        event& operator()(char const* k, unsigned v) { key(k); m_out << v; return *this; }
+        event& operator()(char const* k, int v) { key(k); m_out << v; return *this; }
+        event& operator()(char const* k, unsigned long long v) { key(k); m_out << v; return *this; }
+        event& operator()(char const* k, double v) { key(k); m_out << v; return *this; }
+        event& operator()(char const* k, char const* v);
+    };
+};
+
+void initialize_event_trace();
+void finalize_event_trace();
+/*
+  ADD_INITIALIZER('initialize_event_trace();')
+  ADD_FINALIZER('finalize_event_trace();')
+*/
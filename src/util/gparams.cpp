@@ -22,6 +22,7 @@ Notes:
 #include "util/mutex.h"
 #include "util/region.h"
 #include "util/map.h"
+#include <atomic>
 
 static DECLARE_MUTEX(gparams_mux);
 
@@ -135,6 +136,7 @@ struct gparams::imp {
     smap<char const *>   m_module_descrs;
     param_descrs         m_param_descrs;
     smap<params_ref* >   m_module_params;
+    std::atomic<bool>    m_has_module_params;
     params_ref           m_params;
     region               m_region;
 
@@ -170,7 +172,8 @@ struct gparams::imp {
 
 public:
     imp():
-        m_modules_registered(false) {
+        m_modules_registered(false),
+        m_has_module_params(false) {
     }
 
     ~imp() {
@@ -187,6 +190,7 @@ public:
             dealloc(kv.m_value);
         }
         m_module_params.reset();        
+        m_has_module_params = false;
         m_region.reset();
     }
 
@@ -263,6 +267,7 @@ public:
             if (!m_module_params.find(mod_name.c_str(), p)) {
                 p = alloc(params_ref);
                 m_module_params.insert(cpy(mod_name.c_str()), p);                
+                m_has_module_params = true;
             }
             SASSERT(p);
             return *p;
@@ -460,16 +465,18 @@ public:
         throw exception(strm.str());
     }
 
-    // unfortunately, params_ref is not thread safe
-    // so better create a local copy of the parameters.
+    // The parameters of a module are shared with the caller instead of copied.
+    // This is safe because params_ref is copy-on-write with atomic reference
+    // counts: updates by set() or by the caller copy the shared parameters first.
+    // Modules are looked up without the lock until some module parameter is set.
     params_ref get_module(char const* module_name) {
         params_ref result;
+        if (!m_has_module_params)
+            return result;
         params_ref * ps = nullptr;
-        {
-            lock_guard lock(*gparams_mux);
-            if (m_module_params.find(module_name, ps)) {
-                result.copy(*ps);
-            }
+        lock_guard lock(*gparams_mux);
+        if (m_module_params.find(module_name, ps)) {
+            result = *ps;
         }
         return result;
     }
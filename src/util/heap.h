@@ -9,6 +9,10 @@ Abstract:
 
     A heap of integers.
 
+    The heap is D-ary, binary by default. A 4-ary heap has half the 
+    depth of a binary heap and the children of a node share a cache 
+    line, at the cost of more comparisons when moving down.
+
 Author:
 
     Leonardo de Moura (leonardo) 2006-09-14.
@@ -20,31 +24,31 @@ Revision History:
 #define HEAP_H_
 
 #include "util/vector.h"
+#include "util/util.h"
 #include "util/debug.h"
 
-template<typename LT>
+template<typename LT, unsigned D = 2>
 class heap : private LT {
+    static_assert(D >= 2, "heap arity must be at least 2");
     int_vector    m_values;
     int_vector    m_value2indices;
 
-    static int left(int i) { 
-        return i << 1; 
-    }
-
-    static int right(int i) { 
-        return (i << 1) + 1; 
+    // The values are stored from position 1, and the children of position i
+    // are at positions first_child(i), ..., first_child(i) + D - 1.
+    static int first_child(int i) { 
+        return D * (i - 1) + 2; 
     }
 
     static int parent(int i) { 
-        return i >> 1; 
+        return i < 2 ? 0 : (i - 2) / static_cast<int>(D) + 1; 
     }
 
     void display(std::ostream& out, unsigned indent, int idx) const {
         if (idx < static_cast<int>(m_values.size())) {
             for (unsigned i = 0; i < indent; ++i) out << " ";
             out << m_values[idx] << "\n";
-            display(out, indent + 1, left(idx));
-            display(out, indent + 1, right(idx));
+            for (unsigned k = 0; k < D; ++k) 
+                display(out, indent + 1, first_child(idx) + k);
         }
     }
 
@@ -58,8 +62,9 @@ class heap : private LT {
         if (idx < static_cast<int>(m_values.size())) {
             SASSERT(m_value2indices[m_values[idx]] == idx);
             SASSERT(parent(idx) == 0 || !less_than(m_values[idx], m_values[parent(idx)]));
-            SASSERT(check_invariant_core(left(idx)));
-            SASSERT(check_invariant_core(right(idx)));
+            for (unsigned k = 0; k < D; ++k) {
+                SASSERT(check_invariant_core(first_child(idx) + k));
+            }
         }
         return true;
     }
@@ -89,15 +94,25 @@ private:
     }
 
     void move_down(int idx) {
+        move_down_core(idx);
+        CASSERT("heap", check_invariant());
+    }
+
+    void move_down_core(int idx) {
         int val = m_values[idx];
         int sz  = static_cast<int>(m_values.size());
         while (true) {
-            int left_idx  = left(idx);
-            if (left_idx >= sz) {
+            int child_idx = first_child(idx);
+            if (child_idx >= sz) {
                 break;
             }
-            int right_idx = right(idx);
-            int min_idx   = right_idx < sz && less_than(m_values[right_idx], m_values[left_idx]) ? right_idx : left_idx;
+            int min_idx = child_idx;
+            int end_idx = std::min(child_idx + static_cast<int>(D), sz);
+            for (++child_idx; child_idx < end_idx; ++child_idx) {
+                if (less_than(m_values[child_idx], m_values[min_idx])) {
+                    min_idx = child_idx;
+                }
+            }
             SASSERT(parent(min_idx) == idx);
             int min_value = m_values[min_idx];
             if (!less_than(min_value, val)) {
@@ -109,7 +124,6 @@ private:
         }
         m_values[idx]        = val;
         m_value2indices[val] = idx;
-        CASSERT("heap", check_invariant());
     }
 
 public:
@@ -227,6 +241,32 @@ public:
         move_down(m_value2indices[val]); 
     }
 
+    /**
+       \brief restore the heap property after the keys of n values have decreased.
+       Large batches rebuild the heap in linear time instead of moving up each value.
+     */
+    void decreased(unsigned n, int const* vals) {
+        unsigned sz = m_values.size() - 1;
+        if (n > 8 && n * log2(sz) > sz) {
+            rebuild();
+            return;
+        }
+        for (unsigned i = 0; i < n; ++i) {
+            decreased(vals[i]);
+        }
+    }
+
+    /**
+       \brief restore the heap property after arbitrary changes of the keys.
+     */
+    void rebuild() {
+        int sz = static_cast<int>(m_values.size());
+        for (int idx = parent(sz - 1); idx > 0; --idx) {
+            move_down_core(idx);
+        }
+        CASSERT("heap", check_invariant());
+    }
+
     void insert(int val) {
         CASSERT("heap", check_invariant());
         CASSERT("heap", !contains(val));
@@ -278,8 +318,8 @@ public:
             if (index < static_cast<int>(m_values.size()) &&
                 !less_than(val, m_values[index])) {
                 result.push_back(m_values[index]);
-                todo.push_back(left(index));
-                todo.push_back(right(index));
+                for (unsigned k = 0; k < D; ++k) 
+                    todo.push_back(first_child(index) + k);
             }
         }
     }
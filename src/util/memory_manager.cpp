@@ -117,6 +117,49 @@ bool memory::above_high_watermark() {
     return g_memory_watermark < g_memory_alloc_size;
 }
 
+static DECLARE_INIT_MUTEX(g_memory_cache_mux);
+static memory_cache * g_memory_caches = nullptr;
+
+#ifdef SINGLE_THREAD
+static void * current_thread_tag() { return nullptr; }
+#else
+static thread_local char g_thread_tag;
+static void * current_thread_tag() { return &g_thread_tag; }
+#endif
+
+memory_cache::memory_cache():
+    m_prev(nullptr),
+    m_owner(current_thread_tag()) {
+    lock_guard lock(*g_memory_cache_mux);
+    m_next = g_memory_caches;
+    if (m_next)
+        m_next->m_prev = this;
+    g_memory_caches = this;
+}
+
+memory_cache::~memory_cache() {
+    lock_guard lock(*g_memory_cache_mux);
+    if (m_prev)
+        m_prev->m_next = m_next;
+    else
+        g_memory_caches = m_next;
+    if (m_next)
+        m_next->m_prev = m_prev;
+}
+
+unsigned memory::shrink_caches() {
+    void * owner = current_thread_tag();
+    unsigned n = 0;
+    lock_guard lock(*g_memory_cache_mux);
+    for (memory_cache * c = g_memory_caches; c; c = c->m_next) {
+        if (c->m_owner == owner) {
+            c->shrink();
+            ++n;
+        }
+    }
+    return n;
+}
+
 // The following methods are only safe to invoke at 
 // initialization time, that is, before threads are created.
 
@@ -129,11 +172,13 @@ void memory::set_max_alloc_count(size_t max_count) {
 }
 
 static bool g_finalizing = false;
+static void finalize_thread_caches();
 
 void memory::finalize() {
     if (g_memory_initialized) {
         g_finalizing = true;
         mem_finalize();
+        finalize_thread_caches();
         // we leak the mutex since we need it to be always live since memory may
         // be reinitialized again
         //delete g_memory_mux;
@@ -225,6 +270,186 @@ void * memory::allocate(char const* file, int line, char const* obj, size_t s) {
 thread_local long long g_memory_thread_alloc_size    = 0;
 thread_local long long g_memory_thread_alloc_count   = 0;
 
+#ifndef Z3DEBUG
+// Debug builds use malloc and free directly, which is Valgrind friendly.
+#define THREAD_CACHE
+#endif
+
+#ifdef THREAD_CACHE
+// Thread caches of freed blocks.
+//
+// Blocks of at most THREAD_CACHE_MAX_SIZE bytes, including the size field,
+// are rounded up to a size class. Every thread keeps two magazines of freed
+// blocks per size class. When both are full, the older magazine is moved to
+// a global depot, and a thread whose magazines are empty takes a magazine
+// from the depot before falling back to malloc. Blocks freed by a thread
+// other than the one that allocated them therefore return to the other
+// threads through the depot. Moving a magazine is a constant time operation,
+// so the depot lock is taken at most once per magazine.
+
+#define THREAD_CACHE_SMALL_ALIGN   16
+#define THREAD_CACHE_SMALL_MAX     512
+#define THREAD_CACHE_LARGE_ALIGN   512
+#define THREAD_CACHE_MAX_SIZE      16384
+#define THREAD_CACHE_NUM_SMALL     (THREAD_CACHE_SMALL_MAX / THREAD_CACHE_SMALL_ALIGN)
+#define THREAD_CACHE_NUM_CLASSES   (THREAD_CACHE_NUM_SMALL + (THREAD_CACHE_MAX_SIZE - THREAD_CACHE_SMALL_MAX) / THREAD_CACHE_LARGE_ALIGN)
+#define MAGAZINE_MAX_BYTES         32768
+#define MAGAZINE_MAX_BLOCKS        128
+#define DEPOT_MAX_MAGAZINES        32
+#define DEPOT_MAX_BYTES            (16 * 1024 * 1024)
+
+struct free_block {
+    free_block * m_next;
+};
+
+struct magazine {
+    free_block * m_head;
+    unsigned     m_size;
+};
+
+// s is the size of the block including the size field.
+static inline unsigned size_class(size_t s) {
+    if (s <= THREAD_CACHE_SMALL_MAX)
+        return static_cast<unsigned>((s - 1) / THREAD_CACHE_SMALL_ALIGN);
+    return THREAD_CACHE_NUM_SMALL - 1 + static_cast<unsigned>((s - 1) / THREAD_CACHE_LARGE_ALIGN);
+}
+
+static inline size_t class_size(unsigned c) {
+    if (c < THREAD_CACHE_NUM_SMALL)
+        return (c + 1) * THREAD_CACHE_SMALL_ALIGN;
+    return (c + 2 - THREAD_CACHE_NUM_SMALL) * THREAD_CACHE_LARGE_ALIGN;
+}
+
+static inline bool is_full(unsigned c, magazine const & m) {
+    return m.m_size >= MAGAZINE_MAX_BLOCKS || m.m_size * class_size(c) >= MAGAZINE_MAX_BYTES;
+}
+
+static DECLARE_INIT_MUTEX(g_depot_mux);
+static magazine  g_depot[THREAD_CACHE_NUM_CLASSES][DEPOT_MAX_MAGAZINES];
+static unsigned  g_depot_size[THREAD_CACHE_NUM_CLASSES];
+static long long g_depot_bytes = 0;
+
+static void free_magazine(magazine & m) {
+    free_block * b = m.m_head;
+    while (b) {
+        free_block * next = b->m_next;
+        free(b);
+        b = next;
+    }
+    m.m_head = nullptr;
+    m.m_size = 0;
+}
+
+static void put_magazine(unsigned c, magazine & m) {
+    long long bytes = static_cast<long long>(m.m_size * class_size(c));
+    {
+        lock_guard lock(*g_depot_mux);
+        if (g_depot_size[c] < DEPOT_MAX_MAGAZINES && g_depot_bytes + bytes <= DEPOT_MAX_BYTES) {
+            g_depot_bytes += bytes;
+            g_depot[c][g_depot_size[c]++] = m;
+            m.m_head = nullptr;
+            m.m_size = 0;
+            return;
+        }
+    }
+    free_magazine(m);
+}
+
+static bool get_magazine(unsigned c, magazine & m) {
+    lock_guard lock(*g_depot_mux);
+    if (g_depot_size[c] == 0)
+        return false;
+    m = g_depot[c][--g_depot_size[c]];
+    g_depot_bytes -= static_cast<long long>(m.m_size * class_size(c));
+    return true;
+}
+
+struct thread_cache {
+    magazine m_loaded[THREAD_CACHE_NUM_CLASSES];
+    magazine m_previous[THREAD_CACHE_NUM_CLASSES];
+    bool     m_finalized;
+
+    void * allocate(unsigned c) {
+        magazine & m = m_loaded[c];
+        if (m.m_size == 0) {
+            if (m_previous[c].m_size > 0)
+                std::swap(m, m_previous[c]);
+            else if (m_finalized || !get_magazine(c, m))
+                return nullptr;
+        }
+        free_block * b = m.m_head;
+        m.m_head = b->m_next;
+        m.m_size--;
+        return b;
+    }
+
+    void deallocate(unsigned c, void * p) {
+        if (m_finalized) {
+            free(p);
+            return;
+        }
+        magazine & m = m_loaded[c];
+        if (is_full(c, m)) {
+            if (m_previous[c].m_size > 0)
+                put_magazine(c, m_previous[c]);
+            std::swap(m, m_previous[c]);
+        }
+        free_block * b = static_cast<free_block*>(p);
+        b->m_next = m.m_head;
+        m.m_head = b;
+        m.m_size++;
+    }
+
+    void flush() {
+        for (unsigned c = 0; c < THREAD_CACHE_NUM_CLASSES; ++c) {
+            if (m_loaded[c].m_size > 0)
+                put_magazine(c, m_loaded[c]);
+            if (m_previous[c].m_size > 0)
+                put_magazine(c, m_previous[c]);
+        }
+    }
+
+    ~thread_cache() {
+        flush();
+        m_finalized = true;
+    }
+};
+
+static thread_local thread_cache g_thread_cache;
+
+static void finalize_thread_caches() {
+    for (unsigned c = 0; c < THREAD_CACHE_NUM_CLASSES; ++c) {
+        free_magazine(g_thread_cache.m_loaded[c]);
+        free_magazine(g_thread_cache.m_previous[c]);
+    }
+    lock_guard lock(*g_depot_mux);
+    for (unsigned c = 0; c < THREAD_CACHE_NUM_CLASSES; ++c) {
+        while (g_depot_size[c] > 0)
+            free_magazine(g_depot[c][--g_depot_size[c]]);
+    }
+    g_depot_bytes = 0;
+}
+
+static inline void * malloc_block(size_t & s) {
+    if (s > THREAD_CACHE_MAX_SIZE)
+        return malloc(s);
+    unsigned c = size_class(s);
+    s = class_size(c);
+    void * r = g_thread_cache.allocate(c);
+    return r ? r : malloc(s);
+}
+
+static inline void free_block_of_size(void * p, size_t s) {
+    if (s > THREAD_CACHE_MAX_SIZE)
+        free(p);
+    else
+        g_thread_cache.deallocate(size_class(s), p);
+}
+
+#else
+static void finalize_thread_caches() {}
+#endif
+
 static void synchronize_counters(bool allocating) {
 #ifdef PROFILE_MEMORY
     g_synch_counter++;
@@ -252,12 +477,20 @@ static void synchronize_counters(bool allocating) {
     }
 }
 
+unsigned long long memory::get_thread_allocation_count() {
+    return g_memory_thread_alloc_count;
+}
+
 void memory::deallocate(void * p) {
     size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
     size_t sz      = *sz_p;
     void * real_p  = reinterpret_cast<void*>(sz_p);
     g_memory_thread_alloc_size -= sz;
+#ifdef THREAD_CACHE
+    free_block_of_size(real_p, sz);
+#else
     free(real_p);
+#endif
     if (g_memory_thread_alloc_size < -SYNCH_THRESHOLD) {
         synchronize_counters(false);
     }
@@ -265,7 +498,11 @@ void memory::deallocate(void * p) {
 
 void * memory::allocate(size_t s) {
     s = s + sizeof(size_t); // we allocate an extra field!
+#ifdef THREAD_CACHE
+    void * r = malloc_block(s);
+#else
     void * r = malloc(s);
+#endif
     if (r == 0) {
         throw_out_of_memory();
         return nullptr;
@@ -285,6 +522,11 @@ void* memory::reallocate(void *p, size_t s) {
     size_t sz = *sz_p;
     void *real_p = reinterpret_cast<void*>(sz_p);
     s = s + sizeof(size_t); // we allocate an extra field!
+#ifdef THREAD_CACHE
+    // keep the size of blocks that may return to a thread cache a class size
+    if (s <= THREAD_CACHE_MAX_SIZE)
+        s = class_size(size_class(s));
+#endif
 
     g_memory_thread_alloc_size += s - sz;
     g_memory_thread_alloc_count += 1;
@@ -309,6 +551,12 @@ void* memory::reallocate(void *p, size_t s) {
 // ==================================
 // allocate & deallocate without using thread local storage
 
+static void finalize_thread_caches() {}
+
+unsigned long long memory::get_thread_allocation_count() {
+    return g_memory_alloc_count;
+}
+
 void memory::deallocate(void * p) {
     size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
     size_t sz      = *sz_p;
@@ -47,12 +47,35 @@ public:
     out_of_memory_error();
 };
 
+/**
+   \brief Cache that releases its memory when the allocated memory is
+   above the high watermark (memory_high_watermark). The cache is
+   registered while it is alive and shrink() is invoked by
+   memory::shrink_caches() on the thread that created the cache, at
+   points where the cache is not in use. shrink() must not create or
+   destroy caches.
+*/
+class memory_cache {
+    memory_cache * m_prev;
+    memory_cache * m_next;
+    void *         m_owner;
+    friend class memory;
+public:
+    memory_cache();
+    memory_cache(memory_cache const &): memory_cache() {}
+    memory_cache & operator=(memory_cache const &) { return *this; }
+    virtual ~memory_cache();
+    virtual void shrink() = 0;
+};
+
 class memory {
 public:
     static bool is_out_of_memory();
     static void initialize(size_t max_size);
     static void set_high_watermark(size_t watermak);
     static bool above_high_watermark();
+    // shrink the caches of the calling thread, return the number of caches
+    static unsigned shrink_caches();
     static void set_max_size(size_t max_size);
     static void set_max_alloc_count(size_t max_count);
     static void finalize();
@@ -68,6 +91,8 @@ public:
     static unsigned long long get_allocation_size();
     static unsigned long long get_max_used_memory();
     static unsigned long long get_allocation_count();
+    // number of allocations performed by the calling thread, or by the process if counters are not thread local
+    static unsigned long long get_thread_allocation_count();
     static unsigned long long get_max_memory_size();
     // temporary hack to avoid out-of-memory crash in z3.exe
     static void exit_when_out_of_memory(bool flag, char const * msg);
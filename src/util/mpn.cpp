@@ -102,18 +102,53 @@ bool mpn_manager::sub(mpn_digit const * a, size_t const lnga,
     return true; // return k != 0?
 }
 
-bool mpn_manager::mul(mpn_digit const * a, size_t const lnga,
-                      mpn_digit const * b, size_t const lngb,
-                      mpn_digit * c) const {
-    trace(a, lnga, b, lngb, "*");
-    // Essentially Knuth's Algorithm M. 
-    // Perhaps implement a more efficient version, see e.g., Knuth, Section 4.3.3.    
-    size_t i;
-    mpn_digit k;
-
 #define DIGIT_BITS (sizeof(mpn_digit)*8)
 #define HALF_BITS (sizeof(mpn_digit)*4)
 
+// Operands with fewer digits are multiplied by the schoolbook method.
+static const size_t KARATSUBA_THRESHOLD = 32;
+
+// c[0, lc) += b[0, lb) with lc >= lb; returns the carry out of c[lc-1].
+static mpn_digit add_in_place(mpn_digit * c, size_t lc, mpn_digit const * b, size_t lb) {
+    mpn_double_digit k = 0;
+    size_t j = 0;
+    for (; j < lb; j++) {
+        k += (mpn_double_digit)c[j] + (mpn_double_digit)b[j];
+        c[j] = (mpn_digit)k;
+        k >>= DIGIT_BITS;
+    }
+    for (; k != 0 && j < lc; j++) {
+        k += (mpn_double_digit)c[j];
+        c[j] = (mpn_digit)k;
+        k >>= DIGIT_BITS;
+    }
+    return (mpn_digit)k;
+}
+
+// c[0, lc) -= b[0, lb) with lc >= lb and c >= b.
+static void sub_in_place(mpn_digit * c, size_t lc, mpn_digit const * b, size_t lb) {
+    mpn_digit k = 0;
+    size_t j = 0;
+    for (; j < lb; j++) {
+        mpn_digit r = c[j] - b[j];
+        bool c1 = r > c[j];
+        c[j] = r - k;
+        k = c1 | (c[j] > r);
+    }
+    for (; k != 0 && j < lc; j++) {
+        k = c[j] == 0;
+        c[j]--;
+    }
+    SASSERT(k == 0);
+}
+
+// c[0, la + lb) = a[0, la) * b[0, lb); Knuth's Algorithm M.
+static void mul_school(mpn_digit const * a, size_t lnga,
+                       mpn_digit const * b, size_t lngb,
+                       mpn_digit * c) {
+    size_t i;
+    mpn_digit k;
+
     for (unsigned i = 0; i < lnga; i++)
         c[i] = 0;
 
@@ -137,7 +172,63 @@ bool mpn_manager::mul(mpn_digit const * a, size_t const lnga,
             c[j+lnga] = k;
         }        
     }
-    
+}
+
+/**
+   \brief c[0, 2n) = a[0, n) * b[0, n) by Karatsuba's method, see Knuth, Section 4.3.3.
+   With a = a1*B^m + a0 and b = b1*B^m + b0, the middle term a0*b1 + a1*b0 is
+   (a0 + a1)*(b0 + b1) - a0*b0 - a1*b1, so three half size products suffice.
+*/
+static void mul_karatsuba(mpn_digit const * a, mpn_digit const * b, size_t n, mpn_digit * c) {
+    if (n < KARATSUBA_THRESHOLD) {
+        mul_school(a, n, b, n, c);
+        return;
+    }
+    size_t m = n / 2, h = n - m;
+    // c[0, 2m) = a0*b0 and c[2m, 2n) = a1*b1
+    mul_karatsuba(a, b, m, c);
+    mul_karatsuba(a + m, b + m, h, c + 2*m);
+    sbuffer<mpn_digit> sa(static_cast<unsigned>(h + 1), 0), sb(static_cast<unsigned>(h + 1), 0), z1(static_cast<unsigned>(2*h + 2), 0);
+    for (size_t i = 0; i < h; i++) {
+        sa[static_cast<unsigned>(i)] = a[m + i];
+        sb[static_cast<unsigned>(i)] = b[m + i];
+    }
+    sa[static_cast<unsigned>(h)] = add_in_place(sa.c_ptr(), h, a, m);
+    sb[static_cast<unsigned>(h)] = add_in_place(sb.c_ptr(), h, b, m);
+    mul_karatsuba(sa.c_ptr(), sb.c_ptr(), h + 1, z1.c_ptr());
+    sub_in_place(z1.c_ptr(), 2*h + 2, c, 2*m);
+    sub_in_place(z1.c_ptr(), 2*h + 2, c + 2*m, 2*h);
+    // z1 < B^(2h+1) and c[m, 2n) has room for it.
+    size_t lz = 2*h + 2;
+    while (lz > 0 && z1[static_cast<unsigned>(lz - 1)] == 0) --lz;
+    SASSERT(m + lz <= 2*n);
+    VERIFY(add_in_place(c + m, 2*n - m, z1.c_ptr(), lz) == 0);
+}
+
+bool mpn_manager::mul(mpn_digit const * a, size_t const lnga,
+                      mpn_digit const * b, size_t const lngb,
+                      mpn_digit * c) const {
+    trace(a, lnga, b, lngb, "*");
+    if (lnga < lngb) {
+        return mul(b, lngb, a, lnga, c);
+    }
+    if (lngb < KARATSUBA_THRESHOLD) {
+        mul_school(a, lnga, b, lngb, c);
+    }
+    else if (lnga == lngb) {
+        mul_karatsuba(a, b, lnga, c);
+    }
+    else {
+        // multiply b by slices of a with lngb digits.
+        sbuffer<mpn_digit> t(static_cast<unsigned>(2*lngb), 0);
+        for (size_t i = 0; i < lnga + lngb; i++)
+            c[i] = 0;
+        for (size_t i = 0; i < lnga; i += lngb) {
+            size_t sz = std::min(lngb, lnga - i);
+            mul(a + i, sz, b, lngb, t.c_ptr());
+            VERIFY(add_in_place(c + i, lnga + lngb - i, t.c_ptr(), sz + lngb) == 0);
+        }
+    }
     trace_nl(c, lnga+lngb);
     return true;
 }
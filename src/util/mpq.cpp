@@ -323,6 +323,13 @@ unsigned mpq_manager<SYNCH>::prev_power_of_two(mpq const & a) {
 template<bool SYNCH>
 template<bool SUB>
 void mpq_manager<SYNCH>::lin_arith_op(mpq const& a, mpq const& b, mpq& c, mpz& g, mpz& tmp1, mpz& tmp2, mpz& tmp3) {
+    if (is_small_fraction(a) && is_small_fraction(b)) {
+        // |num * den| < 2^62, so neither the products nor their sum overflow.
+        int64_t n1 = static_cast<int64_t>(a.m_num.m_val) * static_cast<int64_t>(b.m_den.m_val);
+        int64_t n2 = static_cast<int64_t>(b.m_num.m_val) * static_cast<int64_t>(a.m_den.m_val);
+        set_small_fraction(c, SUB ? n1 - n2 : n1 + n2, static_cast<uint64_t>(static_cast<int64_t>(a.m_den.m_val) * static_cast<int64_t>(b.m_den.m_val)));
+        return;
+    }
     gcd(a.m_den, b.m_den, g);                   
     if (is_one(g)) {                            
        mul(a.m_num, b.m_den, tmp1);             
@@ -350,6 +357,10 @@ void mpq_manager<SYNCH>::lin_arith_op(mpq const& a, mpq const& b, mpq& c, mpz& g
 
 template<bool SYNCH>
 void mpq_manager<SYNCH>::rat_mul(mpq const & a, mpq const & b, mpq & c, mpz& g1, mpz& g2, mpz& tmp1, mpz& tmp2) {
+    if (is_small_fraction(a) && is_small_fraction(b)) {
+        set_small_fraction(c, static_cast<int64_t>(a.m_num.m_val) * static_cast<int64_t>(b.m_num.m_val), static_cast<uint64_t>(static_cast<int64_t>(a.m_den.m_val) * static_cast<int64_t>(b.m_den.m_val)));
+        return;
+    }
 #if 1
     gcd(a.m_den, b.m_num, g1);
     gcd(a.m_num, b.m_den, g2);
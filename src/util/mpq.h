@@ -103,6 +103,20 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     bool rat_lt(mpq const & a, mpq const & b);
 
+    // numerator and denominator are small, so products of them fit in 64 bits.
+    static bool is_small_fraction(mpq const & a) { return a.m_num.m_kind == mpz_small && a.m_den.m_kind == mpz_small; }
+
+    // set c to n/d in normal form, where d > 0.
+    void set_small_fraction(mpq & c, int64_t n, uint64_t d) {
+        uint64_t g = u64_gcd(n < 0 ? 0 - static_cast<uint64_t>(n) : static_cast<uint64_t>(n), d);
+        if (g > 1) {
+            n /= static_cast<int64_t>(g);
+            d /= g;
+        }
+        mpz_manager<SYNCH>::set(c.m_num, n);
+        mpz_manager<SYNCH>::set(c.m_den, static_cast<int64_t>(d));
+    }
+
     template<bool SUB>
     void lin_arith_op(mpq const& a, mpq const& b, mpq& c, mpz& g, mpz& tmp1, mpz& tmp2, mpz& tmp3);
 
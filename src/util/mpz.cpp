@@ -318,11 +318,10 @@ void mpz_manager<SYNCH>::set_big_i64(mpz & c, int64_t v) {
         _v   = v;
     }
     mpz_set_ui(*c.m_ptr, static_cast<unsigned>(_v));
-    MPZ_BEGIN_CRITICAL();
-    mpz_set_ui(m_tmp,    static_cast<unsigned>(_v >> 32));
-    mpz_mul(m_tmp, m_tmp, m_two32);
-    mpz_add(*c.m_ptr, *c.m_ptr, m_tmp);
-    MPZ_END_CRITICAL();
+    scoped_tmp t(*this);
+    mpz_set_ui(t.tmp(),    static_cast<unsigned>(_v >> 32));
+    mpz_mul(t.tmp(), t.tmp(), m_two32);
+    mpz_add(*c.m_ptr, *c.m_ptr, t.tmp());
     if (sign)
         mpz_neg(*c.m_ptr, *c.m_ptr);
 #endif
@@ -359,11 +358,10 @@ void mpz_manager<SYNCH>::set_big_ui64(mpz & c, uint64_t v) {
     }
     c.m_kind = mpz_large;
     mpz_set_ui(*c.m_ptr, static_cast<unsigned>(v));
-    MPZ_BEGIN_CRITICAL();
-    mpz_set_ui(m_tmp,    static_cast<unsigned>(v >> 32));
-    mpz_mul(m_tmp, m_tmp, m_two32);
-    mpz_add(*c.m_ptr, *c.m_ptr, m_tmp);
-    MPZ_END_CRITICAL();
+    scoped_tmp t(*this);
+    mpz_set_ui(t.tmp(),    static_cast<unsigned>(v >> 32));
+    mpz_mul(t.tmp(), t.tmp(), m_two32);
+    mpz_add(*c.m_ptr, *c.m_ptr, t.tmp());
 #endif
 }
 
@@ -486,14 +484,13 @@ void mpz_manager<SYNCH>::set_digits(mpz & target, unsigned sz, digit_t const * d
         mpz_set_ui(*target.m_ptr, digits[sz - 1]);
         SASSERT(sz > 0);
         unsigned i = sz - 1;
-        MPZ_BEGIN_CRITICAL();
+        scoped_tmp t(*this);
         while (i > 0) {
             --i;
             mpz_mul_2exp(*target.m_ptr, *target.m_ptr, 32);
-            mpz_set_ui(m_tmp, digits[i]);
-            mpz_add(*target.m_ptr, *target.m_ptr, m_tmp);
+            mpz_set_ui(t.tmp(), digits[i]);
+            mpz_add(*target.m_ptr, *target.m_ptr, t.tmp());
         }
-        MPZ_END_CRITICAL();
 #endif        
     }
 }
@@ -1623,15 +1620,13 @@ uint64_t mpz_manager<SYNCH>::get_uint64(mpz const & a) const {
         return mpz_get_ui(*a.m_ptr);
     }
     else {
-        MPZ_BEGIN_CRITICAL();
-        mpz_manager * _this = const_cast<mpz_manager*>(this);
-        mpz_set(_this->m_tmp, *a.m_ptr);
-        mpz_mod(_this->m_tmp, m_tmp, m_two32);
-        uint64_t r = static_cast<uint64_t>(mpz_get_ui(m_tmp));
-        mpz_set(_this->m_tmp, *a.m_ptr);
-        mpz_div(_this->m_tmp, m_tmp, m_two32);
-        r += static_cast<uint64_t>(mpz_get_ui(m_tmp)) << static_cast<uint64_t>(32);
-        MPZ_END_CRITICAL();
+        scoped_tmp t(*this);
+        mpz_set(t.tmp(), *a.m_ptr);
+        mpz_mod(t.tmp(), t.tmp(), m_two32);
+        uint64_t r = static_cast<uint64_t>(mpz_get_ui(t.tmp()));
+        mpz_set(t.tmp(), *a.m_ptr);
+        mpz_div(t.tmp(), t.tmp(), m_two32);
+        r += static_cast<uint64_t>(mpz_get_ui(t.tmp())) << static_cast<uint64_t>(32);
         return r;
     }
 #endif
@@ -1656,13 +1651,11 @@ int64_t mpz_manager<SYNCH>::get_int64(mpz const & a) const {
         return mpz_get_si(*a.m_ptr);
     }
     else {
-        MPZ_BEGIN_CRITICAL();
-        mpz_manager * _this = const_cast<mpz_manager*>(this);
-        mpz_mod(_this->m_tmp, *a.m_ptr, m_two32);
-        int64_t r = static_cast<int64_t>(mpz_get_ui(m_tmp));
-        mpz_div(_this->m_tmp, *a.m_ptr, m_two32);
-        r += static_cast<int64_t>(mpz_get_si(m_tmp)) << static_cast<int64_t>(32);
-        MPZ_END_CRITICAL();
+        scoped_tmp t(*this);
+        mpz_mod(t.tmp(), *a.m_ptr, m_two32);
+        int64_t r = static_cast<int64_t>(mpz_get_ui(t.tmp()));
+        mpz_div(t.tmp(), *a.m_ptr, m_two32);
+        r += static_cast<int64_t>(mpz_get_si(t.tmp())) << static_cast<int64_t>(32);
         return r;
     }
 #endif
@@ -2095,11 +2088,10 @@ void mpz_manager<SYNCH>::machine_div2k(mpz & a, unsigned k) {
     normalize(a);
 #else
     ensure_mpz_t a1(a);
-    MPZ_BEGIN_CRITICAL();
-    mpz_tdiv_q_2exp(m_tmp, a1(), k);
+    scoped_tmp t(*this);
+    mpz_tdiv_q_2exp(t.tmp(), a1(), k);
     mk_big(a);
-    mpz_swap(*a.m_ptr, m_tmp);
-    MPZ_END_CRITICAL();
+    mpz_swap(*a.m_ptr, t.tmp());
 #endif    
 }
 
@@ -2264,10 +2256,9 @@ unsigned mpz_manager<SYNCH>::mlog2(mpz const & a) {
     else
         return (sz - 1)*32 + ::log2(static_cast<unsigned>(ds[sz-1]));
 #else
-    MPZ_BEGIN_CRITICAL();
-    mpz_neg(m_tmp, *a.m_ptr);
-    unsigned r = mpz_sizeinbase(m_tmp, 2);
-    MPZ_END_CRITICAL();
+    scoped_tmp t(*this);
+    mpz_neg(t.tmp(), *a.m_ptr);
+    unsigned r = mpz_sizeinbase(t.tmp(), 2);
     SASSERT(r > 0);
     return r - 1;
 #endif
@@ -2451,21 +2442,35 @@ bool mpz_manager<SYNCH>::decompose(mpz const & a, svector<digit_t> & digits) {
         return a.m_val < 0;
 #else
     bool r = is_neg(a);
-    MPZ_BEGIN_CRITICAL();
-    mpz_set(m_tmp, *a.m_ptr);
-    mpz_abs(m_tmp, m_tmp);
-    while (mpz_sgn(m_tmp) != 0) {
-      mpz_tdiv_r_2exp(m_tmp2, m_tmp, 32);
-      unsigned v = mpz_get_ui(m_tmp2);
+    scoped_tmp t(*this);
+    mpz_set(t.tmp(), *a.m_ptr);
+    mpz_abs(t.tmp(), t.tmp());
+    while (mpz_sgn(t.tmp()) != 0) {
+      mpz_tdiv_r_2exp(t.tmp2(), t.tmp(), 32);
+      unsigned v = mpz_get_ui(t.tmp2());
       digits.push_back(v);
-      mpz_tdiv_q_2exp(m_tmp, m_tmp, 32);
+      mpz_tdiv_q_2exp(t.tmp(), t.tmp(), 32);
     }
-    MPZ_END_CRITICAL();
     return r;
 #endif
     }
 }
 
+template<bool SYNCH>
+bool mpz_manager<SYNCH>::get_bit(mpz const & a, unsigned index) const {
+    SASSERT(!is_neg(a));
+    if (is_small(a)) {
+        return index < 31 && ((a.m_val >> index) & 1) != 0;
+    }
+#ifndef _MP_GMP
+    const unsigned digit_bits = sizeof(digit_t) * 8;
+    unsigned i = index / digit_bits;
+    return i < size(a) && ((digits(a)[i] >> (index % digit_bits)) & 1) != 0;
+#else
+    return mpz_tstbit(*a.m_ptr, index) != 0;
+#endif
+}
+
 template<bool SYNCH>
 bool mpz_manager<SYNCH>::divides(mpz const & a, mpz const & b) {
     _scoped_numeral<mpz_manager<SYNCH> > tmp(*this);
@@ -135,14 +135,6 @@ inline void swap(mpz & m1, mpz & m2) { m1.swap(m2); }
 template<bool SYNCH = true>
 class mpz_manager {
     mutable small_object_allocator  m_allocator;
-#ifndef SINGLE_THREAD
-    mutable std::recursive_mutex    m_lock;
-#define MPZ_BEGIN_CRITICAL() if (SYNCH) m_lock.lock()
-#define MPZ_END_CRITICAL()   if (SYNCH) m_lock.unlock()
-#else
-#define MPZ_BEGIN_CRITICAL() {}
-#define MPZ_END_CRITICAL()   {}
-#endif
     mutable mpn_manager             m_mpn_manager;
 
 #ifndef _MP_GMP
@@ -195,6 +187,37 @@ class mpz_manager {
     mutable mpz_t     m_int64_max;
     mutable mpz_t     m_int64_min;
 
+    /**
+       \brief Scratch numbers for the GMP code.
+       A synchronized manager uses numbers on the stack instead of m_tmp and m_tmp2,
+       so that threads sharing the manager do not serialize on a lock.
+    */
+    class scoped_tmp {
+        mpz_t   m_local[2];
+        mpz_t * m_tmp[2];
+    public:
+        scoped_tmp(mpz_manager const & m) {
+            if (SYNCH) {
+                mpz_init(m_local[0]);
+                mpz_init(m_local[1]);
+                m_tmp[0] = &m_local[0];
+                m_tmp[1] = &m_local[1];
+            }
+            else {
+                m_tmp[0] = &m.m_tmp;
+                m_tmp[1] = &m.m_tmp2;
+            }
+        }
+        ~scoped_tmp() {
+            if (SYNCH) {
+                mpz_clear(m_local[0]);
+                mpz_clear(m_local[1]);
+            }
+        }
+        mpz_t & tmp() { return *m_tmp[0]; }
+        mpz_t & tmp2() { return *m_tmp[1]; }
+    };
+
     mpz_t * allocate() {        
         mpz_t * cell;
 #ifdef SINGLE_THREAD
@@ -722,6 +745,9 @@ public:
     
     // Store the digits of n into digits, and return the sign.
     bool decompose(mpz const & n, svector<digit_t> & digits);
+
+    // Return the bit at position index of a non-negative number.
+    bool get_bit(mpz const & n, unsigned index) const;
 };
 
 #ifndef SINGLE_THREAD
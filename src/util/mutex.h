@@ -18,6 +18,7 @@ template<typename T> using atomic = T;
 
 struct mutex {
   void lock() {}
+  bool try_lock() { return true; }
   void unlock() {}
 };
 
@@ -25,6 +26,11 @@ struct lock_guard {
   lock_guard(mutex &) {}
 };
 
+struct recursive_mutex {
+  void lock() {}
+  void unlock() {}
+};
+
 #define DECLARE_MUTEX(name) mutex *name = nullptr
 #define DECLARE_INIT_MUTEX(name) mutex *name = nullptr
 #define ALLOC_MUTEX(name) (void)0
@@ -37,6 +43,7 @@ struct lock_guard {
 template<typename T> using atomic = std::atomic<T>;
 typedef std::mutex mutex;
 typedef std::lock_guard<std::mutex> lock_guard;
+typedef std::recursive_mutex recursive_mutex;
 
 #define DECLARE_MUTEX(name) mutex *name = nullptr
 #define DECLARE_INIT_MUTEX(name) mutex *name = new mutex
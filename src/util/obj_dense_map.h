@@ -0,0 +1,142 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    obj_dense_map.h
+
+Abstract:
+
+    A mapping from objects to values indexed by the ids of the objects.
+
+    Entries are stored in a vector indexed by get_id() and are valid
+    when their stamp is the current generation, so reset() does not
+    touch the vector. Ids that are far above the number of entries are
+    stored in a sparse u_map instead, so that a few large ids do not
+    allocate a large vector.
+
+    Values of entries that are reset are only overwritten when the id
+    is inserted again, so Value should not own resources.
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include "util/map.h"
+
+template<typename T, typename Value>
+class obj_dense_map {
+    static const unsigned DENSE_MIN = 1024;
+    vector<Value>    m_values;
+    unsigned_vector  m_stamps;
+    unsigned         m_generation;
+    ptr_vector<T>    m_keys;
+    u_map<Value>     m_sparse;
+
+    bool in_dense(unsigned id) const { return id < m_stamps.size(); }
+
+    bool is_dense(unsigned id) const { return in_dense(id) && m_stamps[id] == m_generation; }
+
+    void grow(unsigned id) {
+        unsigned sz = std::max(id + 1, 2 * m_stamps.size());
+        m_stamps.resize(sz, 0);
+        m_values.resize(sz);
+        if (m_sparse.empty())
+            return;
+        u_map<Value> rest;
+        for (auto const& kv : m_sparse) {
+            if (kv.m_key < sz) {
+                m_stamps[kv.m_key] = m_generation;
+                m_values[kv.m_key] = kv.m_value;
+            }
+            else {
+                rest.insert(kv.m_key, kv.m_value);
+            }
+        }
+        m_sparse.swap(rest);
+    }
+
+public:
+    obj_dense_map(): m_generation(1) {}
+
+    unsigned size() const { return m_keys.size(); }
+
+    bool empty() const { return m_keys.empty(); }
+
+    /**
+       \brief keys of the entries, in insertion order.
+    */
+    ptr_vector<T> const& keys() const { return m_keys; }
+
+    bool contains(T const* k) const {
+        unsigned id = k->get_id();
+        return is_dense(id) || (!m_sparse.empty() && m_sparse.contains(id));
+    }
+
+    Value const* find_core(T const* k) const {
+        unsigned id = k->get_id();
+        if (is_dense(id))
+            return &m_values[id];
+        if (m_sparse.empty())
+            return nullptr;
+        auto* e = m_sparse.find_core(id);
+        return e ? &e->get_data().m_value : nullptr;
+    }
+
+    bool find(T const* k, Value& v) const {
+        Value const* r = find_core(k);
+        if (r)
+            v = *r;
+        return r != nullptr;
+    }
+
+    Value const& find(T const* k) const {
+        Value const* r = find_core(k);
+        SASSERT(r);
+        return *r;
+    }
+
+    Value const& get(T const* k, Value const& default_value) const {
+        Value const* r = find_core(k);
+        return r ? *r : default_value;
+    }
+
+    Value& insert_if_not_there(T* k, Value const& v) {
+        unsigned id = k->get_id();
+        if (is_dense(id))
+            return m_values[id];
+        if (!in_dense(id) && id < 2 * m_keys.size() + DENSE_MIN)
+            grow(id);
+        if (in_dense(id)) {
+            m_stamps[id] = m_generation;
+            m_keys.push_back(k);
+            m_values[id] = v;
+            return m_values[id];
+        }
+        if (!m_sparse.contains(id))
+            m_keys.push_back(k);
+        return m_sparse.insert_if_not_there(id, v);
+    }
+
+    void insert(T* k, Value const& v) {
+        insert_if_not_there(k, v) = v;
+    }
+
+    void reset() {
+        ++m_generation;
+        if (m_generation == 0) {
+            m_stamps.fill(0);
+            m_generation = 1;
+        }
+        m_keys.reset();
+        m_sparse.reset();
+    }
+
+    void finalize() {
+        m_values.finalize();
+        m_stamps.finalize();
+        m_keys.finalize();
+        m_sparse.finalize();
+        m_generation = 1;
+    }
+};
@@ -20,12 +20,34 @@ Revision History:
 #define OBJ_MARK_H_
 
 #include "util/bit_vector.h"
+#include "util/vector.h"
 
 template<typename T>
 struct default_t2uint {
     unsigned operator()(T const & obj) const { return obj.get_id(); }
 };
 
+/**
+   \brief Booleans with constant time reset, for marks that are reset often.
+   A position is true if its stamp is the current epoch.
+*/
+class stamp_vector {
+    unsigned_vector m_stamps;
+    unsigned        m_epoch;
+public:
+    stamp_vector():m_epoch(1) {}
+    unsigned size() const { return m_stamps.size(); }
+    bool get(unsigned i) const { return m_stamps[i] == m_epoch; }
+    void set(unsigned i, bool flag) { m_stamps[i] = flag ? m_epoch : 0; }
+    void resize(unsigned sz, bool val) { m_stamps.resize(sz, val ? m_epoch : 0); }
+    void reset() {
+        if (++m_epoch == 0) {
+            m_stamps.fill(0);
+            m_epoch = 1;
+        }
+    }
+};
+
 template<typename T, typename BV = bit_vector, typename T2UInt = default_t2uint<T> >
 class obj_mark {
     T2UInt     m_proc;
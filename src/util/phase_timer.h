@@ -0,0 +1,114 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    phase_timer.h
+
+Abstract:
+
+    Wall time and allocation counts accumulated by the phases of a solver.
+
+    Phases are registered once and entered using phase_timer::scoped.
+    The names of nested phases are separated by '.', for instance
+    "propagate.arith", and the time of a nested phase is also accounted
+    in the enclosing phase. Re-entering a phase that is active is not
+    counted again. When the timer is disabled entering a phase is
+    a test of a flag.
+
+    The statistics are reported as "time.<phase>", "calls.<phase>"
+    and "allocs.<phase>".
+
+--*/
+#pragma once
+
+#include <chrono>
+#include <string>
+#include "util/vector.h"
+#include "util/symbol.h"
+#include "util/statistics.h"
+#include "util/memory_manager.h"
+
+class phase_timer {
+    struct phase {
+        symbol             m_time_key;
+        symbol             m_calls_key;
+        symbol             m_allocs_key;
+        double             m_seconds;
+        unsigned           m_calls;
+        unsigned long long m_allocs;
+        bool               m_active;
+    };
+    vector<phase> m_phases;
+    bool          m_enabled;
+
+public:
+    phase_timer(): m_enabled(false) {}
+
+    void set_enabled(bool f) { m_enabled = f; }
+    bool enabled() const { return m_enabled; }
+
+    unsigned mk_phase(char const* name) {
+        phase p;
+        p.m_time_key   = symbol((std::string("time.") + name).c_str());
+        p.m_calls_key  = symbol((std::string("calls.") + name).c_str());
+        p.m_allocs_key = symbol((std::string("allocs.") + name).c_str());
+        p.m_seconds    = 0;
+        p.m_calls      = 0;
+        p.m_allocs     = 0;
+        p.m_active     = false;
+        m_phases.push_back(p);
+        return m_phases.size() - 1;
+    }
+
+    void reset() {
+        for (phase& p : m_phases) {
+            p.m_seconds = 0;
+            p.m_calls   = 0;
+            p.m_allocs  = 0;
+        }
+    }
+
+    void collect_statistics(statistics& st) const {
+        if (!m_enabled)
+            return;
+        for (phase const& p : m_phases) {
+            // keys are interned, so they outlive the timer
+            if (p.m_calls == 0)
+                continue;
+            st.update(p.m_time_key.bare_str(), p.m_seconds);
+            st.update(p.m_calls_key.bare_str(), p.m_calls);
+            st.update(p.m_allocs_key.bare_str(), static_cast<unsigned>(p.m_allocs));
+        }
+    }
+
+    /**
+       \brief account the lifetime of the object in phase id.
+       UINT_MAX stands for no phase.
+    */
+    class scoped {
+        phase_timer&                          m_timer;
+        unsigned                              m_id;
+        std::chrono::steady_clock::time_point m_start;
+        unsigned long long                    m_allocs;
+    public:
+        scoped(phase_timer& t, unsigned id): m_timer(t), m_id(UINT_MAX) {
+            if (!t.m_enabled || id == UINT_MAX || t.m_phases[id].m_active)
+                return;
+            m_id = id;
+            t.m_phases[id].m_active = true;
+            m_allocs = memory::get_thread_allocation_count();
+            m_start = std::chrono::steady_clock::now();
+        }
+        ~scoped() {
+            if (m_id == UINT_MAX)
+                return;
+            std::chrono::duration<double> d = std::chrono::steady_clock::now() - m_start;
+            phase& p = m_timer.m_phases[m_id];
+            p.m_seconds += d.count();
+            p.m_calls++;
+            p.m_allocs += memory::get_thread_allocation_count() - m_allocs;
+            p.m_active = false;
+        }
+    };
+};
@@ -69,6 +69,9 @@ public:
 
     unsigned bitsize() const { return m().bitsize(m_val); }
 
+    // Return the bit at position index of a non-negative integer.
+    bool get_bit(unsigned index) const { SASSERT(is_int() && !is_neg()); return m().get_bit(m_val.numerator(), index); }
+
     unsigned storage_size() const { return m().storage_size(m_val); }
     
     void reset() { m().reset(m_val); }
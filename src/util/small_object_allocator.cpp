@@ -94,6 +94,14 @@ void small_object_allocator::deallocate(size_t size, void * p) {
 }
 
 
+bool small_object_allocator::is_chunk_allocated(size_t size) {
+#if defined(Z3DEBUG) && !defined(_WINDOWS)
+    return false;
+#else
+    return 0 < size && size < SMALL_OBJ_SIZE - (1 << PTR_ALIGNMENT);
+#endif
+}
+
 void * small_object_allocator::allocate(size_t size) {
     if (size == 0) return nullptr;
 
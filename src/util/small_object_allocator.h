@@ -24,7 +24,8 @@ Revision History:
 #include "util/debug.h"
 
 class small_object_allocator {
-    static const unsigned CHUNK_SIZE     = (8192 - sizeof(void*)*2);
+    // a chunk and the size field added by memory::allocate fit in 8K
+    static const unsigned CHUNK_SIZE     = (8192 - sizeof(void*)*3);
     static const unsigned SMALL_OBJ_SIZE = 256;
     static const unsigned NUM_SLOTS      = (SMALL_OBJ_SIZE >> PTR_ALIGNMENT);
     struct chunk {
@@ -49,6 +50,12 @@ public:
     size_t get_wasted_size() const;
     size_t get_num_free_objs() const;
     void consolidate();
+    /**
+       \brief Return true if objects of the given size are carved out of chunks
+       owned by the allocator. Such objects are released in bulk when the
+       allocator is reset or destroyed.
+    */
+    static bool is_chunk_allocated(size_t size);
 };
 
 inline void * operator new(size_t s, small_object_allocator & r) { return r.allocate(s); }
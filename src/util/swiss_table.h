@@ -0,0 +1,492 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    swiss_table.h
+
+Abstract:
+
+    Open addressing hashtable with control bytes.
+
+    Every slot has a control byte that is either empty, deleted, or
+    holds 7 bits of the hash code of the element stored in the slot.
+    Lookups probe groups of 16 consecutive control bytes: the
+    candidates of a group are the slots whose control byte matches the
+    hash code, and the probe stops at the first group that has an
+    empty slot. With SSE2 a group is matched using two instructions,
+    so most lookups compare keys only once.
+
+    The first 16 control bytes are replicated after the last one, so a
+    group can start at any slot. The table is grown when 7/8 of the
+    slots are used or deleted.
+
+    swiss_table is a set of entries similar to core_hashtable.
+    swiss_map, obj_swiss_map and u_swiss_map are drop-in alternatives
+    of map, obj_map and u_map for their common operations.
+
+--*/
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "util/memory_manager.h"
+#include "util/util.h"
+#include "util/debug.h"
+#include "util/map.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWISS_TABLE_SSE2
+#endif
+
+namespace swiss {
+    static const unsigned GROUP_SIZE   = 16;
+    static const int8_t   CTRL_EMPTY   = -128;
+    static const int8_t   CTRL_DELETED = -2;
+
+    /**
+       \brief bit i of the result is set if control byte i of the group equals h.
+    */
+    inline unsigned match(int8_t const* g, int8_t h) {
+#ifdef SWISS_TABLE_SSE2
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<__m128i const*>(g));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), ctrl)));
+#else
+        unsigned r = 0;
+        for (unsigned i = 0; i < GROUP_SIZE; ++i)
+            r |= static_cast<unsigned>(g[i] == h) << i;
+        return r;
+#endif
+    }
+
+    /**
+       \brief bit i of the result is set if slot i of the group is empty or deleted.
+    */
+    inline unsigned match_free(int8_t const* g) {
+#ifdef SWISS_TABLE_SSE2
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(g))));
+#else
+        unsigned r = 0;
+        for (unsigned i = 0; i < GROUP_SIZE; ++i)
+            r |= static_cast<unsigned>(g[i] < 0) << i;
+        return r;
+#endif
+    }
+
+    inline unsigned lowest_bit(unsigned m) {
+        SASSERT(m != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(m));
+#else
+        unsigned i = 0;
+        while ((m & 1) == 0) {
+            m >>= 1;
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+    inline unsigned highest_bit(unsigned m) {
+        SASSERT(m != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return 31 - static_cast<unsigned>(__builtin_clz(m));
+#else
+        unsigned i = 0;
+        while (m >>= 1)
+            ++i;
+        return i;
+#endif
+    }
+
+    // z3 hash codes are often small consecutive integers. They are used
+    // unchanged for the position, which keeps neighbouring ids in the same
+    // group, and mixed for the control byte so they do not all match.
+    inline unsigned mix_hash(unsigned h) {
+        h ^= h >> 16;
+        h *= 0x85ebca6b;
+        h ^= h >> 13;
+        return h;
+    }
+};
+
+template<typename T, typename HashProc, typename EqProc>
+class swiss_table : private HashProc, private EqProc {
+    int8_t * m_ctrl;
+    T *      m_slots;
+    unsigned m_capacity;     // power of two, or 0
+    unsigned m_size;
+    unsigned m_growth_left;  // number of empty slots that can be used before growing
+
+    static unsigned max_load(unsigned capacity) { return capacity - capacity / 8; }
+
+    unsigned hash_of(T const& e) const { return HashProc::operator()(e); }
+    static int8_t h2(unsigned h) { return static_cast<int8_t>(swiss::mix_hash(h) >> 25); }
+
+    void set_ctrl(unsigned i, int8_t c) {
+        m_ctrl[i] = c;
+        if (i < swiss::GROUP_SIZE)
+            m_ctrl[m_capacity + i] = c;
+    }
+
+    void alloc_table(unsigned capacity) {
+        SASSERT(capacity >= swiss::GROUP_SIZE && (capacity & (capacity - 1)) == 0);
+        m_capacity    = capacity;
+        m_ctrl        = static_cast<int8_t*>(memory::allocate(capacity + swiss::GROUP_SIZE));
+        memset(m_ctrl, swiss::CTRL_EMPTY, capacity + swiss::GROUP_SIZE);
+        m_slots       = alloc_vect<T>(capacity);
+        m_growth_left = max_load(capacity) - m_size;
+    }
+
+    void free_table() {
+        if (m_capacity == 0)
+            return;
+        memory::deallocate(m_ctrl);
+        dealloc_vect(m_slots, m_capacity);
+        m_ctrl     = nullptr;
+        m_slots    = nullptr;
+        m_capacity = 0;
+    }
+
+    /**
+       \brief return the index of the slot holding an element equal to e, or UINT_MAX.
+    */
+    unsigned find_index(T const& e, unsigned h) const {
+        if (m_capacity == 0)
+            return UINT_MAX;
+        unsigned mask = m_capacity - 1;
+        unsigned pos  = h & mask;
+        int8_t   c    = h2(h);
+        for (unsigned step = swiss::GROUP_SIZE; ; step += swiss::GROUP_SIZE) {
+            int8_t const* g = m_ctrl + pos;
+            for (unsigned m = swiss::match(g, c); m != 0; m &= m - 1) {
+                unsigned i = (pos + swiss::lowest_bit(m)) & mask;
+                if (EqProc::operator()(m_slots[i], e))
+                    return i;
+            }
+            if (swiss::match(g, swiss::CTRL_EMPTY) != 0)
+                return UINT_MAX;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    /**
+       \brief return the first empty or deleted slot of the probe sequence of h.
+    */
+    unsigned find_free(unsigned h) const {
+        unsigned mask = m_capacity - 1;
+        unsigned pos  = h & mask;
+        for (unsigned step = swiss::GROUP_SIZE; ; step += swiss::GROUP_SIZE) {
+            unsigned m = swiss::match_free(m_ctrl + pos);
+            if (m != 0)
+                return (pos + swiss::lowest_bit(m)) & mask;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    void rehash(unsigned capacity) {
+        int8_t * old_ctrl  = m_ctrl;
+        T *      old_slots = m_slots;
+        unsigned old_cap   = m_capacity;
+        alloc_table(capacity);
+        for (unsigned i = 0; i < old_cap; ++i) {
+            if (old_ctrl[i] >= 0) {
+                unsigned h = hash_of(old_slots[i]);
+                unsigned j = find_free(h);
+                set_ctrl(j, h2(h));
+                m_slots[j] = std::move(old_slots[i]);
+            }
+        }
+        if (old_cap > 0) {
+            memory::deallocate(old_ctrl);
+            dealloc_vect(old_slots, old_cap);
+        }
+    }
+
+    void reserve_one() {
+        if (m_growth_left > 0)
+            return;
+        if (m_capacity == 0)
+            rehash(swiss::GROUP_SIZE);
+        else if (m_size * 2 <= max_load(m_capacity))
+            rehash(m_capacity);     // mostly deleted slots, clean them up
+        else
+            rehash(m_capacity * 2);
+    }
+
+    unsigned insert_new(unsigned h) {
+        reserve_one();
+        unsigned i = find_free(h);
+        if (m_ctrl[i] == swiss::CTRL_EMPTY)
+            m_growth_left--;
+        set_ctrl(i, h2(h));
+        m_size++;
+        return i;
+    }
+
+public:
+    typedef T data;
+
+    swiss_table(HashProc const& h = HashProc(), EqProc const& e = EqProc()):
+        HashProc(h), EqProc(e),
+        m_ctrl(nullptr), m_slots(nullptr), m_capacity(0), m_size(0), m_growth_left(0) {}
+
+    swiss_table(swiss_table const& other):
+        HashProc(other), EqProc(other),
+        m_ctrl(nullptr), m_slots(nullptr), m_capacity(0), m_size(0), m_growth_left(0) {
+        for (T const& e : other)
+            insert(e);
+    }
+
+    ~swiss_table() { free_table(); }
+
+    unsigned size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    unsigned capacity() const { return m_capacity; }
+
+    void reset() {
+        if (m_size == 0 && m_growth_left == max_load(m_capacity))
+            return;
+        for (unsigned i = 0; i < m_capacity; ++i)
+            if (m_ctrl[i] >= 0)
+                m_slots[i] = T();
+        if (m_capacity > 0)
+            memset(m_ctrl, swiss::CTRL_EMPTY, m_capacity + swiss::GROUP_SIZE);
+        m_size        = 0;
+        m_growth_left = m_capacity == 0 ? 0 : max_load(m_capacity);
+    }
+
+    void finalize() {
+        free_table();
+        m_size        = 0;
+        m_growth_left = 0;
+    }
+
+    void swap(swiss_table& other) {
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growth_left, other.m_growth_left);
+    }
+
+    T * find_core(T const& e) const {
+        unsigned i = find_index(e, hash_of(e));
+        return i == UINT_MAX ? nullptr : m_slots + i;
+    }
+
+    bool contains(T const& e) const { return find_core(e) != nullptr; }
+
+    bool find(T const& e, T& r) const {
+        T * s = find_core(e);
+        if (!s)
+            return false;
+        r = *s;
+        return true;
+    }
+
+    /**
+       \brief insert e, replacing an equal element.
+    */
+    void insert(T const& e) {
+        unsigned h = hash_of(e);
+        unsigned i = find_index(e, h);
+        if (i == UINT_MAX)
+            i = insert_new(h);
+        m_slots[i] = e;
+    }
+
+    void insert(T&& e) {
+        unsigned h = hash_of(e);
+        unsigned i = find_index(e, h);
+        if (i == UINT_MAX)
+            i = insert_new(h);
+        m_slots[i] = std::move(e);
+    }
+
+    /**
+       \brief return the element equal to e, inserting e if there is none.
+    */
+    T& insert_if_not_there(T const& e) {
+        unsigned h = hash_of(e);
+        unsigned i = find_index(e, h);
+        if (i == UINT_MAX) {
+            i = insert_new(h);
+            m_slots[i] = e;
+        }
+        return m_slots[i];
+    }
+
+    void remove(T const& e) {
+        unsigned i = find_index(e, hash_of(e));
+        if (i == UINT_MAX)
+            return;
+        // A probe stops at a group with an empty slot. If every group
+        // containing slot i has an empty slot, no probe has passed slot i
+        // and it can be marked as empty instead of deleted.
+        unsigned mask   = m_capacity - 1;
+        unsigned before = swiss::match(m_ctrl + ((i - swiss::GROUP_SIZE) & mask), swiss::CTRL_EMPTY);
+        unsigned after  = swiss::match(m_ctrl + i, swiss::CTRL_EMPTY);
+        if (before != 0 && after != 0 &&
+            swiss::lowest_bit(after) + (swiss::GROUP_SIZE - 1 - swiss::highest_bit(before)) < swiss::GROUP_SIZE) {
+            set_ctrl(i, swiss::CTRL_EMPTY);
+            m_growth_left++;
+        }
+        else {
+            set_ctrl(i, swiss::CTRL_DELETED);
+        }
+        m_slots[i] = T();
+        m_size--;
+    }
+
+    void erase(T const& e) { remove(e); }
+
+    template<typename Slot>
+    class iterator_core {
+        int8_t const* m_ctrl;
+        Slot *        m_curr;
+        Slot *        m_end;
+        void move_to_used() {
+            while (m_curr != m_end && *m_ctrl < 0) {
+                ++m_ctrl;
+                ++m_curr;
+            }
+        }
+    public:
+        iterator_core(int8_t const* ctrl, Slot * curr, Slot * end): m_ctrl(ctrl), m_curr(curr), m_end(end) {
+            move_to_used();
+        }
+        Slot & operator*() const { return *m_curr; }
+        Slot * operator->() const { return m_curr; }
+        iterator_core & operator++() { ++m_ctrl; ++m_curr; move_to_used(); return *this; }
+        iterator_core operator++(int) { iterator_core tmp = *this; ++*this; return tmp; }
+        bool operator==(iterator_core const& it) const { return m_curr == it.m_curr; }
+        bool operator!=(iterator_core const& it) const { return m_curr != it.m_curr; }
+    };
+
+    typedef iterator_core<T> iterator;
+    typedef iterator_core<T const> const_iterator;
+
+    iterator begin() { return iterator(m_ctrl, m_slots, m_slots + m_capacity); }
+    iterator end() { return iterator(m_ctrl + m_capacity, m_slots + m_capacity, m_slots + m_capacity); }
+    const_iterator begin() const { return const_iterator(m_ctrl, m_slots, m_slots + m_capacity); }
+    const_iterator end() const { return const_iterator(m_ctrl + m_capacity, m_slots + m_capacity, m_slots + m_capacity); }
+
+    swiss_table& operator=(swiss_table const& other) {
+        if (this == &other)
+            return *this;
+        reset();
+        for (T const& e : other)
+            insert(e);
+        return *this;
+    }
+};
+
+/**
+   \brief map on top of swiss_table. The interface follows map and obj_map.
+*/
+template<typename Key, typename Value, typename HashProc, typename EqProc>
+class swiss_map {
+public:
+    struct key_data {
+        Key   m_key;
+        Value m_value;
+        key_data(): m_key(), m_value() {}
+        key_data(Key const& k): m_key(k), m_value() {}
+        key_data(Key const& k, Value const& v): m_key(k), m_value(v) {}
+        key_data(Key const& k, Value&& v): m_key(k), m_value(std::move(v)) {}
+        Key const& get_key() const { return m_key; }
+        Value const& get_value() const { return m_value; }
+        // entries are their own data, as obj_map_entry::get_data
+        key_data& get_data() { return *this; }
+        key_data const& get_data() const { return *this; }
+    };
+    typedef key_data key_value;
+    typedef key_data entry;
+    typedef key_data obj_map_entry;
+    typedef Key      key;
+    typedef Value    value;
+    typedef key_data data;
+
+private:
+    struct entry_hash : private HashProc {
+        entry_hash(HashProc const& h): HashProc(h) {}
+        unsigned operator()(key_data const& e) const { return HashProc::operator()(e.m_key); }
+    };
+    struct entry_eq : private EqProc {
+        entry_eq(EqProc const& e): EqProc(e) {}
+        bool operator()(key_data const& a, key_data const& b) const { return EqProc::operator()(a.m_key, b.m_key); }
+    };
+    typedef swiss_table<key_data, entry_hash, entry_eq> table;
+    table m_table;
+
+public:
+    typedef typename table::iterator iterator;
+    typedef typename table::const_iterator const_iterator;
+
+    swiss_map(HashProc const& h = HashProc(), EqProc const& e = EqProc()):
+        m_table(entry_hash(h), entry_eq(e)) {}
+
+    unsigned size() const { return m_table.size(); }
+    bool empty() const { return m_table.empty(); }
+    unsigned capacity() const { return m_table.capacity(); }
+    void reset() { m_table.reset(); }
+    void finalize() { m_table.finalize(); }
+    void swap(swiss_map& other) { m_table.swap(other.m_table); }
+
+    iterator begin() { return m_table.begin(); }
+    iterator end() { return m_table.end(); }
+    const_iterator begin() const { return m_table.begin(); }
+    const_iterator end() const { return m_table.end(); }
+
+    void insert(Key const& k, Value const& v) { m_table.insert(key_data(k, v)); }
+    void insert(Key const& k, Value&& v) { m_table.insert(key_data(k, std::move(v))); }
+
+    key_data& insert_if_not_there(Key const& k, Value const& v) {
+        return m_table.insert_if_not_there(key_data(k, v));
+    }
+
+    key_data * find_core(Key const& k) const { return m_table.find_core(key_data(k)); }
+
+    bool find(Key const& k, Value& v) const {
+        key_data * e = find_core(k);
+        if (!e)
+            return false;
+        v = e->m_value;
+        return true;
+    }
+
+    Value const& find(Key const& k) const {
+        key_data * e = find_core(k);
+        SASSERT(e);
+        return e->m_value;
+    }
+
+    Value const& get(Key const& k, Value const& default_value) const {
+        key_data * e = find_core(k);
+        return e ? e->m_value : default_value;
+    }
+
+    Value& operator[](Key const& k) {
+        return m_table.insert_if_not_there(key_data(k)).m_value;
+    }
+
+    bool contains(Key const& k) const { return find_core(k) != nullptr; }
+
+    void remove(Key const& k) { m_table.remove(key_data(k)); }
+    void erase(Key const& k) { remove(k); }
+};
+
+template<typename T>
+struct swiss_obj_hash {
+    unsigned operator()(T const* p) const { return p->hash(); }
+};
+
+template<typename Key, typename Value>
+class obj_swiss_map : public swiss_map<Key*, Value, swiss_obj_hash<Key>, ptr_eq<Key> > {};
+
+template<typename Value>
+class u_swiss_map : public swiss_map<unsigned, Value, u_hash, u_eq> {};
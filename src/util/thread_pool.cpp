@@ -0,0 +1,202 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    thread_pool.cpp
+
+Abstract:
+
+    Process-wide pool of worker threads used by the parallel engines.
+
+--*/
+
+#include "util/thread_pool.h"
+#include "util/vector.h"
+
+#ifdef SINGLE_THREAD
+
+void initialize_thread_pool() {}
+void finalize_thread_pool() {}
+
+void thread_pool::run(unsigned n, std::function<void(unsigned)> const& f) {
+    for (unsigned i = 0; i < n; ++i) 
+        f(i);
+}
+
+void thread_pool::submit(std::function<void()> const& f) {
+    f();
+}
+
+void thread_pool::set_max_workers(unsigned n) {}
+
+#else
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+    class pool_worker;
+
+    struct pool_state {
+        std::mutex               m_mux;
+        ptr_vector<pool_worker>  m_idle;
+        std::deque<std::function<void()>> m_queue;   // submitted tasks waiting for a worker
+        unsigned                 m_num_workers;
+        unsigned                 m_max_workers;
+        pool_state(): m_num_workers(0), m_max_workers(0) {}
+    };
+
+    static pool_state* g_pool = nullptr;
+
+    class pool_worker {
+        std::thread             m_thread;
+        std::mutex              m_mux;
+        std::condition_variable m_cv;
+        std::function<void()>   m_task;
+        bool                    m_stop;
+
+        void loop() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mux);
+                    m_cv.wait(lock, [&]() { return m_stop || m_task; });
+                    if (!m_task) 
+                        return;
+                    task.swap(m_task);
+                }
+                task();
+                while (true) {
+                    {
+                        std::lock_guard<std::mutex> lock(g_pool->m_mux);
+                        if (g_pool->m_queue.empty()) {
+                            g_pool->m_idle.push_back(this);
+                            break;
+                        }
+                        task = std::move(g_pool->m_queue.front());
+                        g_pool->m_queue.pop_front();
+                    }
+                    task();
+                }
+            }
+        }
+
+    public:
+        pool_worker(): m_stop(false) {
+            m_thread = std::thread([this]() { loop(); });
+        }
+
+        ~pool_worker() {
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_stop = true;
+            }
+            m_cv.notify_one();
+            m_thread.join();
+        }
+
+        void submit(std::function<void()> const& task) {
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_task = task;
+            }
+            m_cv.notify_one();
+        }
+    };
+
+    /**
+       \brief obtain an idle worker, create one if the pool is not full.
+       Return nullptr if the pool is exhausted.
+       The caller holds the lock on the pool.
+    */
+    pool_worker* acquire_worker_core() {
+        if (!g_pool->m_idle.empty()) {
+            pool_worker* w = g_pool->m_idle.back();
+            g_pool->m_idle.pop_back();
+            return w;
+        }
+        unsigned max_workers = g_pool->m_max_workers;
+        if (max_workers == 0) 
+            max_workers = std::thread::hardware_concurrency();
+        if (g_pool->m_num_workers >= max_workers) 
+            return nullptr;
+        ++g_pool->m_num_workers;
+        return alloc(pool_worker);
+    }
+
+    pool_worker* acquire_worker() {
+        std::lock_guard<std::mutex> lock(g_pool->m_mux);
+        return acquire_worker_core();
+    }
+}
+
+void initialize_thread_pool() {
+    g_pool = alloc(pool_state);
+}
+
+void finalize_thread_pool() {
+    if (!g_pool) 
+        return;
+    for (pool_worker* w : g_pool->m_idle) 
+        dealloc(w);
+    dealloc(g_pool);
+    g_pool = nullptr;
+}
+
+void thread_pool::run(unsigned n, std::function<void(unsigned)> const& f) {
+    std::mutex              mux;
+    std::condition_variable cv;
+    unsigned                num_running = n;
+    vector<std::thread>     extra;
+
+    auto task = [&](unsigned i) {
+        f(i);
+        std::lock_guard<std::mutex> lock(mux);
+        if (--num_running == 0) 
+            cv.notify_all();
+    };
+
+    for (unsigned i = 0; i < n; ++i) {
+        pool_worker* w = g_pool ? acquire_worker() : nullptr;
+        if (w) 
+            w->submit([&task, i]() { task(i); });
+        else 
+            extra.push_back(std::thread([&task, i]() { task(i); }));
+    }
+    for (auto& th : extra) 
+        th.join();
+    std::unique_lock<std::mutex> lock(mux);
+    cv.wait(lock, [&]() { return num_running == 0; });
+}
+
+void thread_pool::submit(std::function<void()> const& f) {
+    if (!g_pool) {
+        std::thread(f).detach();
+        return;
+    }
+    pool_worker* w = nullptr;
+    {
+        // queue under the same lock as the workers use to become idle,
+        // so that a queued task is never left behind by an idle pool.
+        std::lock_guard<std::mutex> lock(g_pool->m_mux);
+        w = acquire_worker_core();
+        if (!w) {
+            g_pool->m_queue.push_back(f);
+            return;
+        }
+    }
+    w->submit(f);
+}
+
+void thread_pool::set_max_workers(unsigned n) {
+    if (!g_pool) 
+        return;
+    std::lock_guard<std::mutex> lock(g_pool->m_mux);
+    g_pool->m_max_workers = n;
+}
+
+#endif
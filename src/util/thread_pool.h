@@ -0,0 +1,54 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    thread_pool.h
+
+Abstract:
+
+    Process-wide pool of worker threads used by the parallel engines.
+    Threads are kept alive between calls so that short parallel 
+    queries do not pay for thread creation every time.
+
+    Tasks submitted in one batch always run concurrently: 
+    when the pool has no idle worker for a task it either grows
+    or falls back to a temporary thread. This is required because
+    portfolio workers cancel each other and would deadlock if they
+    were serialized.
+
+    Tasks submitted individually are queued instead, when all
+    workers are busy.
+
+--*/
+#pragma once
+
+#include <functional>
+
+void initialize_thread_pool();
+void finalize_thread_pool();
+/*
+  ADD_INITIALIZER('initialize_thread_pool();')
+  ADD_FINALIZER('finalize_thread_pool();')
+*/
+
+class thread_pool {
+public:
+    /**
+       \brief run f(0), ..., f(n-1) concurrently and wait until all have finished.
+    */
+    static void run(unsigned n, std::function<void(unsigned)> const& f);
+
+    /**
+       \brief run f on a worker of the pool without waiting for it.
+       When all workers are busy, f is queued and run by the next worker
+       that becomes idle, so the number of threads stays bounded.
+    */
+    static void submit(std::function<void()> const& f);
+
+    /**
+       \brief set the maximal number of worker threads kept by the pool.
+       0 means use the number of hardware threads.
+    */
+    static void set_max_workers(unsigned n);
+};